@@ -0,0 +1,54 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace benchmarks: Future::then chains
+ * @file: bench/bench_future.cpp
+*******************************************************************************/
+#include "benchmark.hpp"
+
+#include <solace/future.hpp>
+
+
+using namespace Solace;
+
+
+SOLACE_BENCHMARK(future_then_chain_of_3) {
+    for (uint64 i = 0; i < iterations; ++i) {
+        Promise<int> promise;
+
+        int observed = 0;
+        promise.getFuture()
+                .then([](int x) { return x + 1; })
+                .then([](int x) { return x * 2; })
+                .then([&observed](int x) { observed = x; });
+
+        promise.setValue(static_cast<int>(i));
+        bench::doNotOptimize(observed);
+    }
+}
+
+
+SOLACE_BENCHMARK(future_resolve_after_then) {
+    for (uint64 i = 0; i < iterations; ++i) {
+        Promise<int> promise;
+
+        int observed = 0;
+        promise.getFuture().then([&observed](int x) { observed = x; });
+
+        promise.setValue(static_cast<int>(i));
+        bench::doNotOptimize(observed);
+    }
+}
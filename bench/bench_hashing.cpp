@@ -0,0 +1,101 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace benchmarks: the hash family over a 64KB message
+ * @file: bench/bench_hashing.cpp
+*******************************************************************************/
+#include "benchmark.hpp"
+
+#include <solace/hashing/md5.hpp>
+#include <solace/hashing/sha1.hpp>
+#include <solace/hashing/sha2.hpp>
+#include <solace/hashing/sha3.hpp>
+#include <solace/hashing/crc32c.hpp>
+#include <solace/hashing/murmur3.hpp>
+#include <solace/hashing/wyhash.hpp>
+
+#include <vector>
+
+
+using namespace Solace;
+using namespace Solace::hashing;
+
+
+namespace {
+
+std::vector<byte> makeMessage() {
+    std::vector<byte> message(64 * 1024);
+    for (std::size_t i = 0; i < message.size(); ++i) {
+        message[i] = static_cast<byte>(i * 131 + 17);
+    }
+
+    return message;
+}
+
+const std::vector<byte> messageBytes = makeMessage();
+
+ImmutableMemoryView message() {
+    return wrapMemory(messageBytes.data(), messageBytes.size());
+}
+
+template <typename Algorithm>
+void digestMessage(uint64 iterations) {
+    const auto view = message();
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        Algorithm algorithm;
+        algorithm.update(view);
+        bench::doNotOptimize(algorithm.digest());
+    }
+}
+
+}  // namespace
+
+
+SOLACE_BENCHMARK(hashing_md5_64k)    { digestMessage<MD5>(iterations); }
+
+SOLACE_BENCHMARK(hashing_sha1_64k)   { digestMessage<Sha1>(iterations); }
+
+SOLACE_BENCHMARK(hashing_sha256_64k) { digestMessage<Sha256>(iterations); }
+
+SOLACE_BENCHMARK(hashing_sha3_64k)   { digestMessage<Sha3>(iterations); }
+
+
+SOLACE_BENCHMARK(hashing_crc32c_64k) {
+    const auto view = message();
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(crc32c(view));
+    }
+}
+
+
+SOLACE_BENCHMARK(hashing_murmur3_128_64k) {
+    const auto view = message();
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(murmur3_128(view));
+    }
+}
+
+
+SOLACE_BENCHMARK(hashing_wyhash64_64k) {
+    const auto view = message();
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(wyhash64(view));
+    }
+}
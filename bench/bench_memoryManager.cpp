@@ -0,0 +1,45 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace benchmarks: MemoryManager alloc/free
+ * @file: bench/bench_memoryManager.cpp
+*******************************************************************************/
+#include "benchmark.hpp"
+
+#include <solace/memoryManager.hpp>
+
+
+using namespace Solace;
+
+
+SOLACE_BENCHMARK(memoryManager_allocFree_64b) {
+    MemoryManager manager(16 * 1024 * 1024);
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        auto buffer = manager.create(64);
+        bench::doNotOptimize(buffer.size());
+    }
+}
+
+
+SOLACE_BENCHMARK(memoryManager_allocFree_4k) {
+    MemoryManager manager(16 * 1024 * 1024);
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        auto buffer = manager.create(4096);
+        bench::doNotOptimize(buffer.size());
+    }
+}
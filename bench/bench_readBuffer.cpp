@@ -0,0 +1,78 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace benchmarks: ReadBuffer decode
+ * @file: bench/bench_readBuffer.cpp
+*******************************************************************************/
+#include "benchmark.hpp"
+
+#include <solace/readBuffer.hpp>
+
+#include <vector>
+
+
+using namespace Solace;
+
+
+namespace {
+
+const std::vector<byte> payload(64 * 1024, 0x5A);
+
+}  // namespace
+
+
+SOLACE_BENCHMARK(readBuffer_decode_uint64_stream) {
+    ReadBuffer buffer(wrapMemory(payload.data(), payload.size()));
+
+    uint64 accumulator = 0;
+    for (uint64 i = 0; i < iterations; ++i) {
+        if (buffer.remaining() < sizeof(uint64)) {
+            buffer.rewind();
+        }
+
+        uint64 value = 0;
+        bench::doNotOptimize(buffer.read(&value).isOk());
+        accumulator += value;
+    }
+
+    bench::doNotOptimize(accumulator);
+}
+
+
+SOLACE_BENCHMARK(readBuffer_decode_mixed_record) {
+    ReadBuffer buffer(wrapMemory(payload.data(), payload.size()));
+
+    uint64 accumulator = 0;
+    for (uint64 i = 0; i < iterations; ++i) {
+        // A typical wire record: tag, length, two fixed-width fields.
+        if (buffer.remaining() < 16) {
+            buffer.rewind();
+        }
+
+        uint8 tag = 0;
+        uint16 length = 0;
+        uint32 fieldA = 0;
+        uint64 fieldB = 0;
+        bench::doNotOptimize(buffer.read(&tag).isOk());
+        bench::doNotOptimize(buffer.read(&length).isOk());
+        bench::doNotOptimize(buffer.read(&fieldA).isOk());
+        bench::doNotOptimize(buffer.read(&fieldB).isOk());
+
+        accumulator += tag + length + fieldA + fieldB;
+    }
+
+    bench::doNotOptimize(accumulator);
+}
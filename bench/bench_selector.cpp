@@ -0,0 +1,60 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace benchmarks: Selector::poll wakeup
+ * @file: bench/bench_selector.cpp
+*******************************************************************************/
+#include "benchmark.hpp"
+
+#include <solace/io/selector.hpp>
+#include <solace/io/pipe.hpp>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+SOLACE_BENCHMARK(selector_poll_wakeup_pipe) {
+    Pipe pipe;
+    auto selector = Selector::createPoll(4);
+    selector.add(&pipe.getReadEnd(), Selector::Read);
+
+    byte token = 1;
+    auto tokenView = wrapMemory(&token, 1);
+    byte sink = 0;
+    auto sinkView = wrapMemory(&sink, 1);
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(pipe.write(tokenView).isOk());
+
+        auto events = selector.poll(-1);
+        bench::doNotOptimize(events);
+
+        bench::doNotOptimize(pipe.read(sinkView).isOk());
+    }
+}
+
+
+SOLACE_BENCHMARK(selector_poll_empty_timeout0) {
+    Pipe pipe;
+    auto selector = Selector::createPoll(4);
+    selector.add(&pipe.getReadEnd(), Selector::Read);
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        auto events = selector.poll(0);
+        bench::doNotOptimize(events);
+    }
+}
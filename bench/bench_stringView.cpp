@@ -0,0 +1,91 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace benchmarks: StringView search
+ * @file: bench/bench_stringView.cpp
+*******************************************************************************/
+#include "benchmark.hpp"
+
+#include <solace/stringView.hpp>
+
+#include <vector>
+
+
+using namespace Solace;
+
+
+namespace {
+
+// A ~4KB haystack with the needle placed at the very end:
+std::vector<char> makeHaystack() {
+    std::vector<char> text;
+    text.reserve(4096);
+
+    const char filler[] = "lorem ipsum dolor sit amet consectetur ";
+    while (text.size() + sizeof(filler) < 4090) {
+        text.insert(text.end(), filler, filler + sizeof(filler) - 1);
+    }
+
+    const char needle[] = "edge42";
+    text.insert(text.end(), needle, needle + sizeof(needle) - 1);
+
+    return text;
+}
+
+const std::vector<char> haystackText = makeHaystack();
+
+StringView haystack() {
+    return StringView{haystackText.data(), static_cast<StringView::size_type>(haystackText.size())};
+}
+
+}  // namespace
+
+
+SOLACE_BENCHMARK(stringView_indexOf_substring) {
+    const auto text = haystack();
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(text.indexOf(StringView{"edge42"}));
+    }
+}
+
+
+SOLACE_BENCHMARK(stringView_indexOf_char) {
+    const auto text = haystack();
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(text.indexOf('4'));
+    }
+}
+
+
+SOLACE_BENCHMARK(stringView_hashCode_4k) {
+    const auto text = haystack();
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(text.hashCode());
+    }
+}
+
+
+SOLACE_BENCHMARK(stringView_startsWith) {
+    const auto text = haystack();
+    const StringView prefix{"lorem ipsum"};
+
+    for (uint64 i = 0; i < iterations; ++i) {
+        bench::doNotOptimize(text.startsWith(prefix));
+    }
+}
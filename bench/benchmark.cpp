@@ -0,0 +1,94 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace benchmarks: harness implementation
+ * @file: bench/benchmark.cpp
+*******************************************************************************/
+#include "benchmark.hpp"
+
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+
+
+using Solace::uint64;
+
+
+namespace bench {
+
+std::vector<Entry>& registry() {
+    static std::vector<Entry> entries;
+
+    return entries;
+}
+
+
+Registrar::Registrar(const char* name, BodyFn body) {
+    registry().push_back(Entry{name, body});
+}
+
+
+namespace {
+
+/// Minimum wall time a measurement must cover to be trusted.
+const double kMinMeasureSeconds = 0.25;
+
+/// Hard cap on iterations, to bound the run time of no-op-cheap bodies.
+const uint64 kMaxIterations = uint64(1) << 30;
+
+
+double timeBody(BodyFn body, uint64 iterations) {
+    const auto started = std::chrono::steady_clock::now();
+    body(iterations);
+    const auto stopped = std::chrono::steady_clock::now();
+
+    return std::chrono::duration<double>(stopped - started).count();
+}
+
+}  // namespace
+
+
+int runAll(int argc, const char* argv[]) {
+    const char* filter = (argc > 1) ? argv[1] : nullptr;
+
+    printf("%-40s %15s %15s\n", "benchmark", "iterations", "ns/op");
+
+    for (const auto& entry : registry()) {
+        if (filter && !strstr(entry.name, filter)) {
+            continue;
+        }
+
+        entry.body(1);      // Warm-up pass; also surfaces setup cost early.
+
+        // Double the iteration count until the body runs long enough:
+        uint64 iterations = 1;
+        double elapsed = timeBody(entry.body, iterations);
+        while (elapsed < kMinMeasureSeconds && iterations < kMaxIterations) {
+            iterations *= 2;
+            elapsed = timeBody(entry.body, iterations);
+        }
+
+        const double nsPerOp = (elapsed * 1e9) / static_cast<double>(iterations);
+        printf("%-40s %15llu %15.2f\n",
+               entry.name,
+               static_cast<unsigned long long>(iterations),
+               nsPerOp);
+    }
+
+    return 0;
+}
+
+}  // namespace bench
@@ -0,0 +1,90 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace benchmarks: minimal built-in harness
+ * @file: bench/benchmark.hpp
+ *
+ * A benchmark is a function body run for a number of iterations chosen by
+ * the harness: each body is re-run with a doubling iteration count until it
+ * has run long enough to time reliably, and the per-iteration cost is
+ * reported in nanoseconds. No external dependency is required.
+ *
+ * Usage:
+ * \code{.cpp}
+ *   SOLACE_BENCHMARK(stringView_indexOf) {
+ *       for (uint64 i = 0; i < iterations; ++i) {
+ *           bench::doNotOptimize(haystack.indexOf(needle));
+ *       }
+ *   }
+ * \endcode
+*******************************************************************************/
+#pragma once
+#ifndef SOLACE_BENCH_BENCHMARK_HPP
+#define SOLACE_BENCH_BENCHMARK_HPP
+
+#include <solace/types.hpp>
+
+#include <vector>
+
+
+namespace bench {
+
+/// A benchmark body: runs the measured operation `iterations` times.
+using BodyFn = void (*)(Solace::uint64 iterations);
+
+struct Entry {
+    const char* name;
+    BodyFn      body;
+};
+
+/// All registered benchmarks, in registration order.
+std::vector<Entry>& registry();
+
+/// Registers a benchmark at static-initialization time. @see SOLACE_BENCHMARK
+struct Registrar {
+    Registrar(const char* name, BodyFn body);
+};
+
+
+/** Force the compiler to consider a value used, without emitting code. */
+template <typename T>
+inline void doNotOptimize(T const& value) {
+    asm volatile("" : : "r,m"(value) : "memory");
+}
+
+/** Force pending writes to be considered observable. */
+inline void clobberMemory() {
+    asm volatile("" : : : "memory");
+}
+
+
+/**
+ * Run every registered benchmark whose name contains the optional filter
+ * given as the first command line argument, printing one line per result.
+ * @return Process exit code.
+ */
+int runAll(int argc, const char* argv[]);
+
+}  // namespace bench
+
+
+/** Define and register a benchmark body. The body receives `iterations`. */
+#define SOLACE_BENCHMARK(Name) \
+    static void benchBody_##Name(Solace::uint64 iterations); \
+    static const ::bench::Registrar benchRegistrar_##Name(#Name, &benchBody_##Name); \
+    static void benchBody_##Name(Solace::uint64 iterations)
+
+#endif  // SOLACE_BENCH_BENCHMARK_HPP
@@ -0,0 +1,28 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace benchmarks: entry point
+ * @file: bench/main.cpp
+ *
+ * Runs every registered benchmark; an optional first argument filters by
+ * substring of the benchmark name.
+*******************************************************************************/
+#include "benchmark.hpp"
+
+
+int main(int argc, const char* argv[]) {
+    return bench::runAll(argc, argv);
+}
@@ -35,8 +35,8 @@
 // TODO(abbyssoul): Remove std dependencies!
 #include <vector>       // TODO(abbyssoul): Remove! No dynamic reallocation is needed!
 
-// TODO(abbyssoul): Allocate memory via memory manager
 #include "solace/memoryManager.hpp"
+#include "solace/stlAllocator.hpp"
 
 
 
@@ -53,7 +53,7 @@ template<typename T>
 class Array {
 public:
     typedef T                                   value_type;
-    typedef std::vector<T> Storage;
+    typedef std::vector<T, StlAllocator<T>>     Storage;
     typedef uint32                              size_type;
 
     typedef typename Storage::iterator          Iterator;
@@ -92,6 +92,46 @@ public:
     Array(size_type len, const T* carray): _storage(carray, carray + len) {
     }
 
+    /** Construct an array of a given size with storage drawn from a memory manager.
+     * The backing memory is accounted against the manager and returned to it
+     * when the array is destroyed, so long-lived arrays can live entirely in
+     * a pre-reserved pool.
+     *
+     * @param initialSize Number of elements to construct.
+     * @param manager A memory manager to allocate storage through. Must outlive the array.
+     */
+    Array(size_type initialSize, MemoryManager& manager): _storage(initialSize, StlAllocator<T>(manager)) {
+    }
+
+    /** Construct an array of a given size with storage drawn from an arena.
+     * Allocation is a pointer bump and deallocation is a no-op: the memory is
+     * reclaimed wholesale when the arena is reset. Suited for transient arrays
+     * with a scoped life time.
+     *
+     * @param initialSize Number of elements to construct.
+     * @param arena An arena to allocate storage from. Must outlive the array.
+     */
+    Array(size_type initialSize, MemoryArena& arena): _storage(initialSize, StlAllocator<T>(arena)) {
+    }
+
+    /** Construct an array of a given size with elements built in place.
+     * The generator is called once per index and its result goes directly
+     * into the array's storage, so no element is default-constructed first
+     * and then overwritten by a copy.
+     *
+     * @param initialSize Number of elements to construct.
+     * @param f A generator invoked as f(index) to produce each element.
+     */
+    template<typename F,
+             typename = typename std::enable_if<isCallable<F, size_type>::value>::type>
+    Array(size_type initialSize, F&& f): _storage() {
+        _storage.reserve(initialSize);
+
+        for (size_type i = 0; i < initialSize; ++i) {
+            _storage.emplace_back(f(i));
+        }
+    }
+
     /** */
     Array(const Storage& list): _storage(list) {
     }
@@ -113,6 +153,44 @@ public:
     Array(const std::initializer_list<T>& list): _storage(list) {
     }
 
+    /** Construct a new array as a copy of the elements a view points at.
+     * For trivially-copyable T the storage's range construction lowers to
+     * a single bulk copy, the fast path of snapshot fan-out. */
+    explicit Array(const ArrayView<T>& view): _storage(view.begin(), view.end()) {
+    }
+
+
+public:
+
+    /**
+     * Create an array of the given size with elements left uninitialized.
+     *
+     * Array(size) value-initializes every element, which for a multi-GB
+     * staging buffer is a full zeroing pass over memory that is about to be
+     * overwritten anyway. This factory skips that pass: the storage is
+     * allocated and the size set, but element bytes hold whatever the
+     * allocator returned.
+     *
+     * Contract: every element MUST be written before it is read. Only
+     * offered for trivially default-constructible types, where skipping
+     * initialization is well-defined.
+     *
+     * @param size Number of elements the array holds.
+     * @return An array of the given size over uninitialized storage.
+     */
+    static Array<T> uninitialized(size_type size) {
+        return fromDeferredInit(StlAllocator<T>(), size);
+    }
+
+    /** @see uninitialized(size), with storage drawn from a memory manager. */
+    static Array<T> uninitialized(size_type size, MemoryManager& manager) {
+        return fromDeferredInit(StlAllocator<T>(manager), size);
+    }
+
+    /** @see uninitialized(size), with storage drawn from an arena. */
+    static Array<T> uninitialized(size_type size, MemoryArena& arena) {
+        return fromDeferredInit(StlAllocator<T>(arena), size);
+    }
 
 public:
 
@@ -178,18 +256,29 @@ public:
         return _storage.size();
     }
 
-    const_reference operator[] (size_type index) const {
+    const_reference operator[] (size_type index) const& {
         index = assertIndexInRange(index, 0, size());
 
         return _storage[index];
     }
 
-    reference operator[] (size_type index) {
+    reference operator[] (size_type index) & {
         index = assertIndexInRange(index, 0, size());
 
         return _storage[index];
     }
 
+    /** Indexing a temporary array moves the element out, so pipelines like
+     * makeArray()[0] extract a fat element without copying it. */
+    T&& operator[] (size_type index) && {
+        index = assertIndexInRange(index, 0, size());
+
+        return std::move(_storage[index]);
+    }
+
+    // A const temporary could only be copied from; make the copy visible at the call site.
+    const_reference operator[] (size_type index) const&& = delete;
+
     /**
      * Return iterator to beginning of the collection
      * @return iterator to beginning of the collection
@@ -218,10 +307,18 @@ public:
 
     const_reference last() const { return _storage.back(); }
 
-    // TODO(abbyssoul): Implement once we got read of stl::vector
-//    Array<T> slice(size_type from, size_type to) const {
-//        return { _storage };
-//    }
+    /**
+     * Materialize a copy of the [from, to) elements as a new owning array.
+     * Unlike ArrayView::slice this copies, so `to` may equal size() and the
+     * result outlives this array. Trivially-copyable elements land in one
+     * bulk copy.
+     */
+    Array<T> slice(size_type from, size_type to) const {
+        from = assertIndexInRange(from, 0, size() + 1, "Array::slice()");
+        to   = assertIndexInRange(to, from, size() + 1, "Array::slice()");
+
+        return Array<T>(to - from, _storage.data() + from);
+    }
 
     pointer_type data() noexcept {
         return _storage.data();
@@ -319,6 +416,16 @@ public:
 
 private:
 
+    static Array<T> fromDeferredInit(StlAllocator<T> allocator, size_type size) {
+        static_assert(std::is_trivially_default_constructible<T>::value,
+                      "Array::uninitialized is only for trivially default-constructible types");
+
+        Storage storage(allocator.deferInitialization());
+        storage.resize(size);
+
+        return Array<T>(std::move(storage));
+    }
+
     Storage _storage;
 };
 
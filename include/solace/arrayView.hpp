@@ -30,6 +30,8 @@
 
 #include <initializer_list>
 #include <algorithm>    // std::swap, std::find
+#include <cstring>      // memmove
+#include <functional>   // std::less_equal
 
 
 namespace Solace {
@@ -63,13 +65,13 @@ public:
     constexpr ArrayView(decltype(nullptr)) noexcept
     {}
 
-    /** Construct an array from C-style array with the given size */
+    /** Construct an array from C-style array with the given number of elements */
     constexpr ArrayView(T* ptr, size_type arraySize) noexcept :
-        _memory(wrapMemory(ptr, arraySize))
+        _memory(wrapMemory(ptr, arraySize * sizeof(T)))
     {}
 
     constexpr ArrayView(T* beginSeq, T* endSeq) noexcept :
-        _memory(wrapMemory(beginSeq, endSeq - beginSeq))
+        _memory(wrapMemory(beginSeq, (endSeq - beginSeq) * sizeof(T)))
     {}
 
     template <size_t size>
@@ -214,6 +216,21 @@ public:
         return ArrayView<T>(begin() + from, to - from);
     }
 
+    /**
+     * Copy the elements of this view into the given destination.
+     *
+     * Trivially-copyable elements go as one bulk memmove; anything else is
+     * assigned element by element, walking in whichever direction keeps an
+     * overlapping copy correct - memmove semantics, for objects too.
+     *
+     * @param dest The view to copy into. Must hold at least size() elements.
+     */
+    void copyTo(ArrayView<typename std::remove_const<T>::type> dest) const {
+        assertIndexInRange(size(), 0, dest.size() + 1, "ArrayView::copyTo()");
+
+        copyTo(dest, std::is_trivially_copyable<T>());
+    }
+
     ImmutableMemoryView view() const noexcept {
         return _memory;
     }
@@ -241,7 +258,7 @@ public:
     }
 
     ArrayView<const T> asConst() const noexcept {
-      return ArrayView<const T>(_memory);
+      return ArrayView<const T>(MemoryView(_memory));
     }
 
     operator ArrayView<const T>() const noexcept {
@@ -287,6 +304,22 @@ public:
 
 private:
 
+    void copyTo(ArrayView<typename std::remove_const<T>::type> dest, std::true_type) const {
+        if (empty()) {
+            return;
+        }
+
+        memmove(dest.view().dataAddress(), _memory.dataAddress(), size() * sizeof(T));
+    }
+
+    void copyTo(ArrayView<typename std::remove_const<T>::type> dest, std::false_type) const {
+        if (std::less_equal<const void*>()(dest.begin(), begin())) {
+            std::copy(begin(), end(), dest.begin());
+        } else {
+            std::copy_backward(begin(), end(), dest.begin() + size());
+        }
+    }
+
     /// Memory where the array data is stored.
     MemoryView _memory;
 };
@@ -29,9 +29,13 @@
 
 namespace Solace {
 
+namespace IO { class TraceRing; }
+
+
 /**
  * Throw an error of invalidState
  */
+SOLACE_COLD
 void raiseInvalidStateError();
 
 /**
@@ -40,6 +44,7 @@ void raiseInvalidStateError();
  *
  * @param message Error message to describe invalid state of an object.
  */
+SOLACE_COLD
 void raiseInvalidStateError(const char* message);
 
 /**
@@ -63,6 +68,70 @@ T* assertNotNull(T* value) {
     return value;
 }
 
+/**
+ * Throw an IndexOutOfRangeException. The out-of-line cold half of
+ * assertIndexInRange, kept out of the callers' instruction stream.
+ */
+[[noreturn]]
+void raiseIndexOutOfRange(uint64 index, uint64 from, uint64 to);
+
+/**
+ * Throw an IndexOutOfRangeException with a message identifying the location.
+ * The out-of-line cold half of assertIndexInRange.
+ */
+[[noreturn]]
+void raiseIndexOutOfRange(uint64 index, uint64 from, uint64 to, const char* message);
+
+
+/*
+ * Bounds checking policy:
+ * By default range assertions compile to an inline comparison with the
+ * failure path hinted cold and the throw kept out of line, so the optimizer
+ * can see through the check, fold duplicates and keep vectorizing.
+ * Compiling with -DSOLACE_DISABLE_BOUNDS_CHECKS removes the checks entirely
+ * for audited hot builds; the functions stay as no-ops returning the index.
+ * Compiling with -DSOLACE_ASSERT_COUNT_VIOLATIONS instead keeps the checks
+ * but replaces the throw with a wait-free violation counter and an optional
+ * trace-ring record - cheap always-on invariant monitoring for builds that
+ * cannot afford (or cannot use) exceptions. Like the disabled mode it does
+ * NOT stop the offending access; it only makes the violation visible.
+ */
+
+/** Violation totals observed by the counting mode. @see assertViolations() */
+struct AssertStats {
+    uint64 indexViolations;     //!< assertIndexInRange checks that failed.
+    uint64 nullViolations;      //!< assertNotNull checks that failed.
+};
+
+/**
+ * Totals of assertion violations noted so far, summed over all threads.
+ * Only the counting mode notes violations; other modes leave these at zero.
+ */
+AssertStats assertViolations() noexcept;
+
+/** Event ids the counting mode records violations under in the trace ring. */
+struct AssertTraceEvents {
+    static constexpr uint64 kIndexOutOfRange = 0xA55E0001;  //!< arg0 = index, arg1 = upper bound.
+    static constexpr uint64 kNullPointer = 0xA55E0002;
+};
+
+/**
+ * Install a trace ring for the counting mode to record violations into,
+ * in addition to the counters. Pass nullptr to detach. The ring must
+ * outlive its installation; one sink serves the whole process.
+ */
+void setAssertTraceSink(IO::TraceRing* sink) noexcept;
+
+/** Count an out-of-range index and trace it if a sink is installed.
+ * The out-of-line cold half of the counting mode; never throws. */
+SOLACE_COLD
+void noteIndexOutOfRange(uint64 index, uint64 from, uint64 to) noexcept;
+
+/** Count a null pointer violation and trace it if a sink is installed.
+ * The out-of-line cold half of the counting mode; never throws. */
+SOLACE_COLD
+void noteNullPointer() noexcept;
+
 /**
  * Assert that the give index is within the give range. Throw if it is not.
  *
@@ -71,7 +140,22 @@ T* assertNotNull(T* value) {
  * @param to Upper value bound (exclusive)
  * @return Index value if the index is in range. Throws otherwise.
  */
-uint16 assertIndexInRange(uint16 index, uint16 from, uint16 to);
+inline uint16 assertIndexInRange(uint16 index, uint16 from, uint16 to) {
+#if defined(SOLACE_ASSERT_COUNT_VIOLATIONS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        noteIndexOutOfRange(index, from, to);
+    }
+#elif !defined(SOLACE_DISABLE_BOUNDS_CHECKS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        raiseIndexOutOfRange(index, from, to);
+    }
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+#endif
+
+    return index;
+}
 
 /**
  * Assert that the give index is within the give range. Throw if it is not.
@@ -81,7 +165,22 @@ uint16 assertIndexInRange(uint16 index, uint16 from, uint16 to);
  * @param to Upper value bound (exclusive)
  * @return Index value if the index is in range. Throws otherwise.
  */
-uint32 assertIndexInRange(uint32 index, uint32 from, uint32 to);
+inline uint32 assertIndexInRange(uint32 index, uint32 from, uint32 to) {
+#if defined(SOLACE_ASSERT_COUNT_VIOLATIONS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        noteIndexOutOfRange(index, from, to);
+    }
+#elif !defined(SOLACE_DISABLE_BOUNDS_CHECKS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        raiseIndexOutOfRange(index, from, to);
+    }
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+#endif
+
+    return index;
+}
 
 /**
  * Assert that the give index is within the give range. Throw if it is not.
@@ -91,7 +190,22 @@ uint32 assertIndexInRange(uint32 index, uint32 from, uint32 to);
  * @param to Upper value bound (exclusive)
  * @return Index value if the index is in range. Throws otherwise.
  */
-uint64 assertIndexInRange(uint64 index, uint64 from, uint64 to);
+inline uint64 assertIndexInRange(uint64 index, uint64 from, uint64 to) {
+#if defined(SOLACE_ASSERT_COUNT_VIOLATIONS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        noteIndexOutOfRange(index, from, to);
+    }
+#elif !defined(SOLACE_DISABLE_BOUNDS_CHECKS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        raiseIndexOutOfRange(index, from, to);
+    }
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+#endif
+
+    return index;
+}
 
 
 /**
@@ -103,7 +217,24 @@ uint64 assertIndexInRange(uint64 index, uint64 from, uint64 to);
  *
  * @return Index value if the index is in range. Throws otherwise.
  */
-uint16 assertIndexInRange(uint16 index, uint16 from, uint16 to, const char* message);
+inline uint16 assertIndexInRange(uint16 index, uint16 from, uint16 to, const char* message) {
+#if defined(SOLACE_ASSERT_COUNT_VIOLATIONS)
+    static_cast<void>(message);
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        noteIndexOutOfRange(index, from, to);
+    }
+#elif !defined(SOLACE_DISABLE_BOUNDS_CHECKS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        raiseIndexOutOfRange(index, from, to, message);
+    }
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+    static_cast<void>(message);
+#endif
+
+    return index;
+}
 
 
 /**
@@ -115,7 +246,24 @@ uint16 assertIndexInRange(uint16 index, uint16 from, uint16 to, const char* mess
  *
  * @return Index value if the index is in range. Throws otherwise.
  */
-uint32 assertIndexInRange(uint32 index, uint32 from, uint32 to, const char* message);
+inline uint32 assertIndexInRange(uint32 index, uint32 from, uint32 to, const char* message) {
+#if defined(SOLACE_ASSERT_COUNT_VIOLATIONS)
+    static_cast<void>(message);
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        noteIndexOutOfRange(index, from, to);
+    }
+#elif !defined(SOLACE_DISABLE_BOUNDS_CHECKS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        raiseIndexOutOfRange(index, from, to, message);
+    }
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+    static_cast<void>(message);
+#endif
+
+    return index;
+}
 
 
 /**
@@ -127,7 +275,24 @@ uint32 assertIndexInRange(uint32 index, uint32 from, uint32 to, const char* mess
  *
  * @return Index value if the index is in range. Throws otherwise.
  */
-uint64 assertIndexInRange(uint64 index, uint64 from, uint64 to, const char* message);
+inline uint64 assertIndexInRange(uint64 index, uint64 from, uint64 to, const char* message) {
+#if defined(SOLACE_ASSERT_COUNT_VIOLATIONS)
+    static_cast<void>(message);
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        noteIndexOutOfRange(index, from, to);
+    }
+#elif !defined(SOLACE_DISABLE_BOUNDS_CHECKS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        raiseIndexOutOfRange(index, from, to, message);
+    }
+#else
+    static_cast<void>(from);
+    static_cast<void>(to);
+    static_cast<void>(message);
+#endif
+
+    return index;
+}
 
 }  // End of namespace Solace
 #endif  // SOLACE_ASSERT_HPP
@@ -0,0 +1,83 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Atomically swappable shared snapshot
+ *	@file		solace/atomicShared.hpp
+ *	@brief		Atomic publication point for immutable snapshots
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_ATOMICSHARED_HPP
+#define SOLACE_ATOMICSHARED_HPP
+
+#include <memory>
+
+
+namespace Solace {
+
+/**
+ * The publication point for immutable snapshots shared across threads -
+ * the root swap in RCU-style usage of PersistentMap / PersistentVector:
+ *
+ * @code
+ *   AtomicShared<PersistentMap<String, String>> config;
+ *   ...
+ *   auto snapshot = config.load();            // reader: one atomic ref bump
+ *   auto v = snapshot->find(key);             // then plain reads, no locks
+ *   ...
+ *   config.store(snapshot->set(key, value));  // writer: derive and publish
+ * @endcode
+ *
+ * load() hands out a shared_ptr to the current snapshot; the snapshot a
+ * reader holds stays valid - and unchanged, being immutable - for as long
+ * as the reader keeps the pointer, no matter how many versions writers
+ * publish meanwhile. Retired versions free themselves when their last
+ * reader lets go. Concurrent writers each publish atomically, but
+ * last-writer-wins: read-modify-write sequences need external ordering.
+ */
+template<typename T>
+class AtomicShared {
+public:
+
+    AtomicShared() :
+        _current(std::make_shared<T const>())
+    {}
+
+    AtomicShared(T value) :
+        _current(std::make_shared<T const>(std::move(value)))
+    {}
+
+    AtomicShared(AtomicShared const&) = delete;
+    AtomicShared& operator= (AtomicShared const&) = delete;
+
+    /** Get the current snapshot: a single acquire load and reference bump. */
+    std::shared_ptr<T const> load() const noexcept {
+        return std::atomic_load_explicit(&_current, std::memory_order_acquire);
+    }
+
+    /** Publish a new snapshot for subsequent load() calls to observe. */
+    void store(T value) {
+        std::atomic_store_explicit(&_current,
+                                   std::shared_ptr<T const>(std::make_shared<T const>(std::move(value))),
+                                   std::memory_order_release);
+    }
+
+private:
+
+    std::shared_ptr<T const> _current;
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_ATOMICSHARED_HPP
@@ -151,5 +151,72 @@ Base16Decoded_Iterator base16Decode_end(ImmutableMemoryView src) {
     return {src.end(), src.end()};
 }
 
+
+/**
+ * Encode a block of bytes as lowercase hex directly into a destination view.
+ *
+ * The fast-path companion of Base16Encoder for callers that already hold the
+ * destination memory: no WriteBuffer, no per-byte result objects, the inner
+ * loop emits 16 bytes of input per iteration.
+ *
+ * @param src Bytes to encode.
+ * @param dest Destination view; needs 2 * src.size() bytes.
+ * @return Number of characters written, or an error if dest is too small.
+ */
+Result<MemoryView::size_type, Error>
+base16Encode(ImmutableMemoryView src, MemoryView dest);
+
+/**
+ * Decode a block of hex characters directly into a destination view.
+ *
+ * Validation is folded into conversion: table lookups accumulate a poison
+ * value across each 16-character block and a single check per block rejects
+ * input with any character outside the alphabet. Upper- and lowercase digits
+ * are both accepted.
+ *
+ * @param src Hex characters to decode; must be of even length.
+ * @param dest Destination view; needs src.size() / 2 bytes.
+ * @return Number of bytes written, or an error on invalid input or if dest is too small.
+ */
+Result<MemoryView::size_type, Error>
+base16Decode(ImmutableMemoryView src, MemoryView dest);
+
+
+/**
+ * Incremental Base16 decoder.
+ *
+ * Base16 encoding needs no state between chunks - Base16Encoder already
+ * handles arbitrary chunking - but decoding does: a byte's two hex digits can
+ * arrive in different chunks. The stream decoder carries the odd digit across
+ * encode() calls, so a stream can be fed in whatever pieces it arrives in.
+ */
+class Base16StreamDecoder : public Encoder {
+public:
+    using Encoder::size_type;
+
+public:
+
+    Base16StreamDecoder(WriteBuffer& dest) :
+        Encoder(dest),
+        _hasCarry(false),
+        _carry(0)
+    {}
+
+    size_type encodedSize(ImmutableMemoryView const& data) const override {
+        return (data.size() + (_hasCarry ? 1 : 0)) / 2;
+    }
+
+    using Encoder::encode;
+
+    Result<void, Error>
+    encode(ImmutableMemoryView const& src) override;
+
+private:
+
+    bool    _hasCarry;
+    byte    _carry;     //!< High nibble awaiting its other half.
+};
+
+
 }  // End of namespace Solace
 #endif  // SOLACE_BASE16_HPP
@@ -122,5 +122,103 @@ public:
 };
 
 
+/**
+ * Incremental Base64 encoder.
+ *
+ * Unlike Base64Encoder, which needs the whole input in one view, the stream
+ * encoder accepts input in arbitrary chunks: up to two unconsumed bytes are
+ * carried across encode() calls and the final group with its padding is
+ * emitted by finalize(). The bulk of every chunk goes through a shuffle-based
+ * SIMD kernel on x86 - AVX2 or SSSE3, picked once at runtime - with the
+ * table-driven loop covering the tail and other architectures.
+ */
+class Base64StreamEncoder : public Encoder {
+public:
+    using Encoder::size_type;
+
+public:
+
+    Base64StreamEncoder(WriteBuffer& dest) :
+        Encoder(dest),
+        _carrySize(0)
+    {}
+
+    size_type encodedSize(ImmutableMemoryView const& data) const override {
+        return Base64Encoder::encodedSize(data.size() + _carrySize);
+    }
+
+    using Encoder::encode;
+
+    Result<void, Error>
+    encode(ImmutableMemoryView const& src) override;
+
+    /**
+     * Emit the final group and padding after the last chunk.
+     * The encoder is reset and can be reused for another stream.
+     */
+    Result<void, Error> finalize();
+
+private:
+
+    byte        _carry[3];
+    size_type   _carrySize;
+};
+
+
+/**
+ * Incremental Base64 decoder.
+ *
+ * Accepts encoded input in arbitrary chunks - carrying a partial group of up
+ * to three characters across encode() calls - and writes decoded bytes as
+ * soon as a group completes. Padding characters are skipped wherever they
+ * appear; any other character outside the alphabet fails the call, unless
+ * the decoder was constructed with Whitespace::Skip, in which case spaces,
+ * tabs and line breaks are ignored too - so MIME-style input wrapped at 76
+ * columns decodes in one pass with no sanitization copy. On x86 clean runs
+ * of input decode through a SIMD kernel; a block with whitespace in it just
+ * falls back to the per-character loop. Call finalize() after the last
+ * chunk to flush an unpadded trailing group.
+ */
+class Base64StreamDecoder : public Encoder {
+public:
+    using Encoder::size_type;
+
+    /** How the decoder treats whitespace in the input. */
+    enum class Whitespace : byte {
+        Reject,     //!< Whitespace fails the call, like any other character outside the alphabet.
+        Skip        //!< Spaces, tabs and line breaks between characters are ignored.
+    };
+
+public:
+
+    Base64StreamDecoder(WriteBuffer& dest, Whitespace whitespace = Whitespace::Reject) :
+        Encoder(dest),
+        _whitespace(whitespace),
+        _carrySize(0)
+    {}
+
+    size_type encodedSize(ImmutableMemoryView const& data) const override {
+        return ((data.size() + _carrySize) / 4) * 3 + 3;
+    }
+
+    using Encoder::encode;
+
+    Result<void, Error>
+    encode(ImmutableMemoryView const& src) override;
+
+    /**
+     * Decode a trailing group that arrived without padding.
+     * The decoder is reset and can be reused for another stream.
+     */
+    Result<void, Error> finalize();
+
+private:
+
+    Whitespace  _whitespace;    //!< Whether whitespace is skipped or rejected.
+    byte        _carry[4];      //!< Decoded sextets of the current partial group.
+    size_type   _carrySize;
+};
+
+
 }  // End of namespace Solace
 #endif  // SOLACE_BASE64_HPP
@@ -0,0 +1,214 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Bitmap view over raw memory
+ *	@file		solace/bitmapView.hpp
+ *	@brief		Word-at-a-time bit operations over a MemoryView
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_BITMAPVIEW_HPP
+#define SOLACE_BITMAPVIEW_HPP
+
+#include "solace/memoryView.hpp"
+#include "solace/optional.hpp"
+#include "solace/assert.hpp"
+#include "solace/exception.hpp"
+
+#include <algorithm>    // std::min
+#include <cstring>      // memcpy, memset
+
+
+namespace Solace {
+
+/** A view of raw memory as a sequence of bits aka BitmapView.
+ * Non-owning, like the MemoryView it wraps: point it at a feature-flag word,
+ * a presence mask in a slab, or a filter mask column and operate in place.
+ * The view covers size() = 8 * bytes bits.
+ *
+ * All operations work a 64-bit word at a time: count() is a popcount sweep,
+ * the scans skip zero words eight bytes per step, and the bulk combiners
+ * AND/OR/XOR whole words - over a few million rows of filter mask that is a
+ * handful of instructions per cache line, which vectorizes further under -O2.
+ * Words are assembled with memcpy, so the underlying bytes need no alignment;
+ * the compiler lowers this to plain word loads.
+ *
+ * Bit i lives in word i / 64, bit i % 64, independent of byte order.
+ */
+class BitmapView {
+public:
+    using size_type = uint64;
+
+    static constexpr size_type kBitsPerWord = 64;
+
+public:
+
+    /** Wrap the given memory. Every byte of the view belongs to the bitmap. */
+    explicit BitmapView(MemoryView view) noexcept :
+        _view(std::move(view))
+    {}
+
+    bool empty() const noexcept {
+        return (_view.size() == 0);
+    }
+
+    /** Number of bits covered by this view. */
+    size_type size() const noexcept {
+        return 8 * static_cast<size_type>(_view.size());
+    }
+
+
+    /** Read the bit at the given position. */
+    bool test(size_type bit) const {
+        assertIndexInRange(bit, 0, size(), "BitmapView::test()");
+
+        return (loadWord(bit / kBitsPerWord) >> (bit % kBitsPerWord)) & 1u;
+    }
+
+    /** Set the bit at the given position to 1. */
+    void set(size_type bit) {
+        assertIndexInRange(bit, 0, size(), "BitmapView::set()");
+
+        const auto word = bit / kBitsPerWord;
+        storeWord(word, loadWord(word) | (static_cast<uint64>(1) << (bit % kBitsPerWord)));
+    }
+
+    /** Set the bit at the given position to 0. */
+    void clear(size_type bit) {
+        assertIndexInRange(bit, 0, size(), "BitmapView::clear()");
+
+        const auto word = bit / kBitsPerWord;
+        storeWord(word, loadWord(word) & ~(static_cast<uint64>(1) << (bit % kBitsPerWord)));
+    }
+
+    /** Set every bit to 1. */
+    void setAll() noexcept {
+        memset(_view.dataAddress(), 0xFF, _view.size());
+    }
+
+    /** Set every bit to 0. */
+    void clearAll() noexcept {
+        memset(_view.dataAddress(), 0, _view.size());
+    }
+
+
+    /** Number of bits set to 1, by word-wide popcount. */
+    size_type count() const noexcept {
+        size_type total = 0;
+
+        const auto nbWords = wordCount();
+        for (size_type w = 0; w < nbWords; ++w) {
+            total += static_cast<size_type>(__builtin_popcountll(loadWord(w)));
+        }
+
+        return total;
+    }
+
+    /**
+     * Position of the first bit set to 1 at or after the given position.
+     * Zero words are skipped eight bytes at a time.
+     * @return The bit position, or none when no set bit remains.
+     */
+    Optional<size_type> findFirstSet(size_type fromBit = 0) const noexcept {
+        const auto nbWords = wordCount();
+
+        for (auto w = fromBit / kBitsPerWord; w < nbWords; ++w) {
+            auto word = loadWord(w);
+            if (w == fromBit / kBitsPerWord) {
+                word &= ~static_cast<uint64>(0) << (fromBit % kBitsPerWord);
+            }
+
+            if (word != 0) {
+                return Optional<size_type>(w * kBitsPerWord
+                                           + static_cast<size_type>(__builtin_ctzll(word)));
+            }
+        }
+
+        return none;
+    }
+
+    /**
+     * Apply a function to the position of every set bit, in ascending order.
+     * The scan clears the lowest set bit of a word copy per step, so sparse
+     * masks cost popcount-many iterations, not size()-many.
+     */
+    template<typename F>
+    void forEachSet(F&& f) const {
+        const auto nbWords = wordCount();
+
+        for (size_type w = 0; w < nbWords; ++w) {
+            for (auto word = loadWord(w); word != 0; word &= word - 1) {
+                f(w * kBitsPerWord + static_cast<size_type>(__builtin_ctzll(word)));
+            }
+        }
+    }
+
+
+    /** In-place intersection: this &= other. Views must be the same size. */
+    void andWith(BitmapView const& other) {
+        combineWith(other, [](uint64 a, uint64 b) { return a & b; });
+    }
+
+    /** In-place union: this |= other. Views must be the same size. */
+    void orWith(BitmapView const& other) {
+        combineWith(other, [](uint64 a, uint64 b) { return a | b; });
+    }
+
+    /** In-place symmetric difference: this ^= other. Views must be the same size. */
+    void xorWith(BitmapView const& other) {
+        combineWith(other, [](uint64 a, uint64 b) { return a ^ b; });
+    }
+
+private:
+
+    size_type wordCount() const noexcept {
+        return (static_cast<size_type>(_view.size()) + sizeof(uint64) - 1) / sizeof(uint64);
+    }
+
+    /** Bytes covered by the given word index; the last word may be partial. */
+    uint32 wordBytes(size_type word) const noexcept {
+        const auto offset = word * sizeof(uint64);
+
+        return static_cast<uint32>(std::min<size_type>(sizeof(uint64), _view.size() - offset));
+    }
+
+    uint64 loadWord(size_type word) const noexcept {
+        uint64 value = 0;
+        memcpy(&value, _view.dataAddress() + word * sizeof(uint64), wordBytes(word));
+
+        return value;
+    }
+
+    void storeWord(size_type word, uint64 value) noexcept {
+        memcpy(_view.dataAddress() + word * sizeof(uint64), &value, wordBytes(word));
+    }
+
+    template<typename Op>
+    void combineWith(BitmapView const& other, Op op) {
+        if (other._view.size() != _view.size()) {
+            raise<IllegalArgumentException>("other");
+        }
+
+        const auto nbWords = wordCount();
+        for (size_type w = 0; w < nbWords; ++w) {
+            storeWord(w, op(loadWord(w), other.loadWord(w)));
+        }
+    }
+
+    MemoryView  _view;
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_BITMAPVIEW_HPP
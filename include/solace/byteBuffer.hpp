@@ -26,6 +26,11 @@
 #define SOLACE_BYTEBUFFER_HPP
 
 #include "solace/readBuffer.hpp"
+#include "solace/optional.hpp"
+#include "solace/stringView.hpp"
+
+#include <string>
+#include <vector>
 
 
 namespace Solace {
@@ -81,7 +86,11 @@ public:
 
 
     ByteBuffer& swap(ByteBuffer& rhs) noexcept {
+        using std::swap;
+
         ReadBuffer::swap(rhs);
+        swap(_consumed, rhs._consumed);
+        swap(_marks, rhs._marks);
 
         return *this;
     }
@@ -93,20 +102,26 @@ public:
 
     /**
      * Set the limit to the capacity and the position to zero.
+     * The consumed watermark and all named marks are dropped.
      */
     ByteBuffer& clear() noexcept {
         _position = 0;
         _limit = capacity();
+        _consumed = 0;
+        _marks.clear();
 
         return *this;
     }
 
     /**
      * Set the limit to the current position and then sets the position to zero.
+     * The consumed watermark and all named marks are dropped.
      */
     ByteBuffer& flip() noexcept {
         _limit = _position;
         _position = 0;
+        _consumed = 0;
+        _marks.clear();
 
         return *this;
     }
@@ -120,6 +135,66 @@ public:
         return *this;
     }
 
+    /**
+     * Checkpoint the current position under a name, overwriting the mark
+     * if the name is already taken.
+     *
+     * An incremental parser drops a mark at each decoded field boundary;
+     * when input runs out mid-message it keeps the buffer as is and on the
+     * next wakeup restores the innermost mark instead of re-parsing the
+     * whole message prefix from scratch.
+     *
+     * @param name Name of the checkpoint. Copied; a temporary is fine.
+     * @return Refernce to this for fluency.
+     */
+    ByteBuffer& mark(StringView name);
+
+    /**
+     * Set the position back to the named checkpoint.
+     *
+     * @param name Name of a checkpoint placed by mark().
+     * @return Nothing if successfull, or an error if no such mark exists or
+     *  the marked bytes have been consumed since.
+     */
+    Result<void, Error> restore(StringView name);
+
+    /**
+     * Get the position saved under the given name, if any.
+     * @note This operation does not move the current position.
+     */
+    Optional<size_type> markPosition(StringView name) const noexcept;
+
+    /**
+     * Remove the named checkpoint.
+     * @return True if a mark with that name existed.
+     */
+    bool dropMark(StringView name) noexcept;
+
+    /**
+     * Get the consumed watermark: the prefix of the buffer holding fully
+     * processed messages, as opposed to position() which is how far the
+     * parser has read ahead into a possibly incomplete one.
+     */
+    size_type consumed() const noexcept { return _consumed; }
+
+    /** Number of bytes read ahead of the watermark: the incomplete suffix. */
+    size_type unconsumed() const noexcept { return position() - _consumed; }
+
+    /**
+     * Advance the consumed watermark, typically to the end of a message
+     * that parsed completely. Marks and the read position are unaffected.
+     *
+     * @param count Number of bytes consumed.
+     * @return Nothing if successfull, or an error on an attempt to consume
+     *  past the current position.
+     */
+    Result<void, Error> consume(size_type count);
+
+    /** View the bytes between the consumed watermark and the position. */
+    ImmutableMemoryView viewUnconsumed() const {
+        return _storage.view().slice(consumed(), position());
+    }
+
     /**
      * Write given raw bytes into this buffer.
      * @param data Raw bytes data to write.
@@ -127,7 +202,7 @@ public:
      * @note Exception is thrown if given data exceed buffer capacity.
      */
     ByteBuffer& write(ImmutableMemoryView const& data) {
-        return write(data.dataAddress(), data.size());
+        return write(data, data.size());
     }
 
     /**
@@ -182,6 +257,16 @@ protected:
 
     ByteBuffer& write(void const* bytes, size_type count);
 
+private:
+
+    /** One named checkpoint. A handful at most, so a flat list beats a map. */
+    struct Mark {
+        std::string     name;
+        size_type       savedPosition;
+    };
+
+    size_type           _consumed{};    //!< Watermark below which messages are fully processed.
+    std::vector<Mark>   _marks;         //!< Named checkpoints, unordered.
 };
 
 
@@ -110,6 +110,32 @@ public:
         return (getValue() >= rhs.getValue());
     }
 
+    /** Character class bits backing the classification predicates.
+     * Every byte has its classes pre-computed in a 256-entry table, so a
+     * classification is a single load and mask test - no branches, no locale
+     * machinery. Values combine with bitwise-or to test several classes at
+     * once. @see categoryOf()
+     */
+    enum Category : uint16 {
+        Control     = 1 << 0,   //!< Control characters: 0x00-0x1f and 0x7f.
+        Whitespace  = 1 << 1,   //!< Space and '\t'..'\r'.
+        UpperCase   = 1 << 2,   //!< 'A'..'Z'.
+        LowerCase   = 1 << 3,   //!< 'a'..'z'.
+        Digit       = 1 << 4,   //!< '0'..'9'.
+        HexDigit    = 1 << 5,   //!< Digits plus 'a'..'f' / 'A'..'F'.
+        Punctuation = 1 << 6,   //!< Graphical and not a letter or digit.
+        Graphical   = 1 << 7,   //!< Has a glyph: printable except space.
+        Printable   = 1 << 8,   //!< Graphical or space.
+        SymbolStart = 1 << 9,   //!< A letter or '_': can open an identifier.
+        Symbol      = 1 << 10,  //!< A letter, digit or '_': identifier tail.
+
+        Letter          = UpperCase | LowerCase,
+        LetterOrDigit   = Letter | Digit
+    };
+
+    //!< Class bits of the given byte: one table load. @see Category
+    static uint16 categoryOf(byte c) noexcept;
+
     //!< True is given character is a digit.
     bool isDigit() const;
 
@@ -0,0 +1,125 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Checked integer arithmetic
+ *	@file		solace/checked.hpp
+ *	@brief		Overflow-safe add/sub/mul and narrowing over the type vocabulary
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_CHECKED_HPP
+#define SOLACE_CHECKED_HPP
+
+#include "solace/types.hpp"
+#include "solace/optional.hpp"
+
+#include <type_traits>
+
+
+namespace Solace {
+
+/*
+ * Overflow-safe arithmetic primitives for size computations.
+ *
+ * Each maps to a single compiler overflow intrinsic - one instruction plus a
+ * flags test - with the failure path hinted unlikely, so the optimizer treats
+ * the check as straight-line code instead of the compare-branch chains that
+ * hand-rolled guards (a + b < a and friends) produce. Lives next to, not in,
+ * types.hpp: Optional sits above the type vocabulary in the include order.
+ */
+
+/**
+ * Add two integers, detecting overflow.
+ *
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return The sum, or none if it does not fit the type.
+ */
+template<typename T>
+Optional<T> checkedAdd(T a, T b) noexcept {
+    static_assert(std::is_integral<T>::value, "checkedAdd is for integral types");
+
+    T result;
+    if (SOLACE_UNLIKELY(__builtin_add_overflow(a, b, &result))) {
+        return none;
+    }
+
+    return Optional<T>(result);
+}
+
+/**
+ * Subtract two integers, detecting overflow - for unsigned types that is
+ * any b greater than a.
+ *
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return The difference, or none if it does not fit the type.
+ */
+template<typename T>
+Optional<T> checkedSub(T a, T b) noexcept {
+    static_assert(std::is_integral<T>::value, "checkedSub is for integral types");
+
+    T result;
+    if (SOLACE_UNLIKELY(__builtin_sub_overflow(a, b, &result))) {
+        return none;
+    }
+
+    return Optional<T>(result);
+}
+
+/**
+ * Multiply two integers, detecting overflow.
+ *
+ * @param a Left operand.
+ * @param b Right operand.
+ * @return The product, or none if it does not fit the type.
+ */
+template<typename T>
+Optional<T> checkedMul(T a, T b) noexcept {
+    static_assert(std::is_integral<T>::value, "checkedMul is for integral types");
+
+    T result;
+    if (SOLACE_UNLIKELY(__builtin_mul_overflow(a, b, &result))) {
+        return none;
+    }
+
+    return Optional<T>(result);
+}
+
+/**
+ * Convert an integer to a narrower (or differently signed) type, detecting
+ * loss: the replacement for static_cast at the seams where a 64-bit size
+ * meets a 32-bit field.
+ *
+ * @tparam T Destination type - always spelled out at the call site.
+ * @param value The value to convert.
+ * @return The value as a T, or none if T cannot represent it exactly.
+ */
+template<typename T, typename F>
+Optional<T> narrow(F value) noexcept {
+    static_assert(std::is_integral<T>::value && std::is_integral<F>::value,
+                  "narrow is for integral types");
+
+    // The overflow intrinsic range-checks across mixed types for free:
+    T result;
+    if (SOLACE_UNLIKELY(__builtin_add_overflow(value, T{0}, &result))) {
+        return none;
+    }
+
+    return Optional<T>(result);
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_CHECKED_HPP
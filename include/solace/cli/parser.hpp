@@ -149,6 +149,7 @@ public:
                OptionArgument expectsArgument,
                F&& f) :
             _names(names),
+            _nameHashes(hashNames(_names)),
             _description(std::move(description)),
             _expectsArgument(expectsArgument),
             _callback(std::forward<F>(f))
@@ -171,6 +172,7 @@ public:
         Option& swap(Option& rhs) noexcept {
             using std::swap;
             swap(_names, rhs._names);
+            swap(_nameHashes, rhs._nameHashes);
             swap(_description, rhs._description);
             swap(_callback, rhs._callback);
             swap(_expectsArgument, rhs._expectsArgument);
@@ -180,6 +182,13 @@ public:
 
         bool isMatch(StringView argName) const noexcept;
 
+        /** Match against a name whose hash the caller has already computed.
+         * The parser hashes each token once and dispatches over the hashes
+         * precomputed at option construction, so a non-matching option is
+         * rejected on an integer compare without touching string data.
+         */
+        bool isMatch(StringView argName, uint64 argHash) const noexcept;
+
         Optional<Error> match(Optional<StringView> const& value, Context const& c) const;
 
         const Array<StringLiteral>& names() const noexcept      { return _names; }
@@ -187,10 +196,17 @@ public:
 
         OptionArgument getArgumentExpectations() const noexcept { return _expectsArgument; }
 
+    private:
+
+        static Array<uint64> hashNames(Array<StringLiteral> const& names);
+
     private:
         //!< Long name of the option, Maybe empty if not specified.
         Array<StringLiteral>                _names;
 
+        //!< Hashes of the names above, precomputed for dispatch.
+        Array<uint64>                       _nameHashes;
+
         //!< Human-readable description of the option.
         StringLiteral                       _description;
 
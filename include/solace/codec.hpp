@@ -0,0 +1,272 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Compile-time wire-format codec
+ *	@file		solace/codec.hpp
+ *	@brief		Declarative struct codec over ReadBuffer / WriteBuffer
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_CODEC_HPP
+#define SOLACE_CODEC_HPP
+
+#include "solace/readBuffer.hpp"
+#include "solace/writeBuffer.hpp"
+
+
+namespace Solace {
+
+/**
+ * Field descriptors for Codec. A message layout is spelled once as a list
+ * of these and the codec generates the fused decode / encode at compile time.
+ */
+
+/** A fixed-width integer, little-endian on the wire. */
+template<typename T>
+struct FixedLE {
+    static_assert(std::is_integral<T>::value, "FixedLE fields must be of an integral type");
+
+    using value_type = T;
+};
+
+/** A fixed-width integer, big-endian on the wire. */
+template<typename T>
+struct FixedBE {
+    static_assert(std::is_integral<T>::value, "FixedBE fields must be of an integral type");
+
+    using value_type = T;
+};
+
+/** A base-128 varint (LEB128; zig-zag for the signed types). */
+template<typename T>
+struct Varint {
+    static_assert(std::is_integral<T>::value && sizeof(T) >= sizeof(uint32),
+                  "Varint fields must be of a 32 or 64 bit integral type");
+
+    using value_type = T;
+};
+
+
+/**
+ * Buffer access for one field descriptor.
+ * Specializations are befriended by ReadBuffer / WriteBuffer so fixed fields
+ * inside an already bounds-checked run decode with no per-field check.
+ */
+template<typename F>
+struct WireFieldOps;
+
+template<typename T>
+struct WireFieldOps<FixedLE<T>> {
+    static constexpr bool isFixed = true;
+
+    static void get(ReadBuffer& src, T& value) noexcept {
+        auto const raw = src.template getUnchecked<T>();
+        value = isBigendian() ? byteSwap(raw) : raw;
+    }
+
+    static void put(WriteBuffer& dest, T value) noexcept {
+        dest.putUnchecked(isBigendian() ? byteSwap(value) : value);
+    }
+
+    static Result<void, Error> writeChecked(WriteBuffer& dest, T value) {
+        return dest.writeLE(value);
+    }
+};
+
+template<typename T>
+struct WireFieldOps<FixedBE<T>> {
+    static constexpr bool isFixed = true;
+
+    static void get(ReadBuffer& src, T& value) noexcept {
+        auto const raw = src.template getUnchecked<T>();
+        value = isBigendian() ? raw : byteSwap(raw);
+    }
+
+    static void put(WriteBuffer& dest, T value) noexcept {
+        dest.putUnchecked(isBigendian() ? value : byteSwap(value));
+    }
+
+    static Result<void, Error> writeChecked(WriteBuffer& dest, T value) {
+        return dest.writeBE(value);
+    }
+};
+
+template<typename T>
+struct WireFieldOps<Varint<T>> {
+    static constexpr bool isFixed = false;
+
+    static Result<void, Error> read(ReadBuffer& src, T& value) {
+        return src.readVarint(value);
+    }
+
+    static Result<void, Error> write(WriteBuffer& dest, T value) {
+        return dest.writeVarint(value);
+    }
+};
+
+
+/**
+ * Number of wire bytes in the leading run of fixed-width fields -
+ * the span the codec bounds checks as one unit. A varint ends the run.
+ */
+template<typename... Fields>
+struct FixedRunSize;
+
+template<>
+struct FixedRunSize<> : std::integral_constant<ReadBuffer::size_type, 0> {};
+
+template<typename T, typename... Rest>
+struct FixedRunSize<FixedLE<T>, Rest...>
+        : std::integral_constant<ReadBuffer::size_type, sizeof(T) + FixedRunSize<Rest...>::value> {};
+
+template<typename T, typename... Rest>
+struct FixedRunSize<FixedBE<T>, Rest...>
+        : std::integral_constant<ReadBuffer::size_type, sizeof(T) + FixedRunSize<Rest...>::value> {};
+
+template<typename T, typename... Rest>
+struct FixedRunSize<Varint<T>, Rest...>
+        : std::integral_constant<ReadBuffer::size_type, 0> {};
+
+
+/**
+ * A compile-time codec for a fixed sequence of wire-format fields.
+ *
+ * Describe the message once as a list of field descriptors and read / write
+ * it as one call, instead of hand-maintaining matched runs of readLE() /
+ * writeLE() per message type:
+ * @code
+ *      using FrameHeader = Codec<FixedBE<uint16>,   // message kind
+ *                                FixedBE<uint32>,   // stream id
+ *                                Varint<uint64>>;   // payload length
+ *
+ *      uint16 kind; uint32 stream; uint64 length;
+ *      auto parsed = FrameHeader::decode(reader, kind, stream, length);
+ * @endcode
+ *
+ * Every run of fixed-width fields is bounds checked as a single unit and
+ * decoded with unchecked loads, so a multi-field header costs one limit
+ * check - the hand-fused form, generated. Varints bound themselves and
+ * start a new run. Mixed endianness is free: each field says its own.
+ *
+ * Errors mirror the underlying buffers: decode fails on underflow without
+ * consuming the current run; encode fails on overflow, or spills when the
+ * destination has an overflow handler installed.
+ */
+template<typename... Fields>
+class Codec {
+public:
+
+    using size_type = ReadBuffer::size_type;
+
+    /** Wire size of the leading fixed-width run, checked as one unit. */
+    static constexpr size_type fixedPrefixSize() noexcept {
+        return FixedRunSize<Fields...>::value;
+    }
+
+    /**
+     * Decode every field of the message from the buffer, in order.
+     * @param src Buffer positioned at the start of the message.
+     * @param values One destination per field, in field order.
+     * @return Nothing if successfull or an error.
+     */
+    static Result<void, Error>
+    decode(ReadBuffer& src, typename Fields::value_type&... values) {
+        return decodeSeq<Fields...>(src, 0, values...);
+    }
+
+    /**
+     * Encode every field of the message into the buffer, in order.
+     * @param dest Buffer to encode the message into.
+     * @param values One value per field, in field order.
+     * @return Nothing if successfull or an error.
+     */
+    static Result<void, Error>
+    encode(WriteBuffer& dest, typename Fields::value_type... values) {
+        return encodeSeq<Fields...>(dest, 0, values...);
+    }
+
+private:
+
+    template<typename... Done>
+    static std::enable_if_t<sizeof...(Done) == 0, Result<void, Error>>
+    decodeSeq(ReadBuffer&, size_type) { return Ok(); }
+
+    /* budget is the number of bytes ahead of the position already covered by
+     * a run check; a field inside the budget decodes with no check at all. */
+    template<typename F, typename... Rest, typename... Vs>
+    static std::enable_if_t<WireFieldOps<F>::isFixed, Result<void, Error>>
+    decodeSeq(ReadBuffer& src, size_type budget, typename F::value_type& value, Vs&... rest) {
+        if (budget < sizeof(typename F::value_type)) {
+            budget = FixedRunSize<F, Rest...>::value;
+            if (src.remaining() < budget) {
+                return Err<Error>(StringView("UnderflowError: decode(): not enough data in the buffer"));
+            }
+        }
+
+        WireFieldOps<F>::get(src, value);
+
+        return decodeSeq<Rest...>(src, budget - sizeof(typename F::value_type), rest...);
+    }
+
+    template<typename F, typename... Rest, typename... Vs>
+    static std::enable_if_t<!WireFieldOps<F>::isFixed, Result<void, Error>>
+    decodeSeq(ReadBuffer& src, size_type, typename F::value_type& value, Vs&... rest) {
+        auto result = WireFieldOps<F>::read(src, value);
+        if (!result) {
+            return result;
+        }
+
+        return decodeSeq<Rest...>(src, 0, rest...);
+    }
+
+    template<typename... Done>
+    static std::enable_if_t<sizeof...(Done) == 0, Result<void, Error>>
+    encodeSeq(WriteBuffer&, size_type) { return Ok(); }
+
+    template<typename F, typename... Rest, typename... Vs>
+    static std::enable_if_t<WireFieldOps<F>::isFixed, Result<void, Error>>
+    encodeSeq(WriteBuffer& dest, size_type budget, typename F::value_type value, Vs... rest) {
+        if (budget < sizeof(typename F::value_type)) {
+            budget = FixedRunSize<F, Rest...>::value;
+            if (dest.remaining() < budget) {
+                // Overflow: take the checked write, which fails or spills as configured.
+                auto result = WireFieldOps<F>::writeChecked(dest, value);
+                if (!result) {
+                    return result;
+                }
+
+                return encodeSeq<Rest...>(dest, 0, rest...);
+            }
+        }
+
+        WireFieldOps<F>::put(dest, value);
+
+        return encodeSeq<Rest...>(dest, budget - sizeof(typename F::value_type), rest...);
+    }
+
+    template<typename F, typename... Rest, typename... Vs>
+    static std::enable_if_t<!WireFieldOps<F>::isFixed, Result<void, Error>>
+    encodeSeq(WriteBuffer& dest, size_type, typename F::value_type value, Vs... rest) {
+        auto result = WireFieldOps<F>::write(dest, value);
+        if (!result) {
+            return result;
+        }
+
+        return encodeSeq<Rest...>(dest, 0, rest...);
+    }
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_CODEC_HPP
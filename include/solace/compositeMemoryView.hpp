@@ -0,0 +1,123 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: CompositeMemoryView
+ *	@file		solace/compositeMemoryView.hpp
+ *	@brief		A scatter/gather list of memory segments
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_COMPOSITEMEMORYVIEW_HPP
+#define SOLACE_COMPOSITEMEMORYVIEW_HPP
+
+#include "solace/immutableMemoryView.hpp"
+#include "solace/writeBuffer.hpp"
+
+
+namespace Solace {
+
+/**
+ * An ordered list of memory segments to be treated as one logical buffer.
+ *
+ * A composite view is the gather half of scatter/gather IO: a message made of
+ * a header, a payload and a trailer is described by three segments instead of
+ * being copied into one contiguous buffer. None of the segments are owned or
+ * copied - like any view, a composite is only valid while the memory behind
+ * its segments is.
+ *
+ * Writing a composite out in one system call is supported by IO objects that
+ * take it directly, e.g. File::write(CompositeMemoryView const&) maps the
+ * segment list straight onto writev.
+ */
+class CompositeMemoryView {
+public:
+    using size_type = size_t;
+
+    /** Maximum number of segments a composite view can hold. */
+    static constexpr uint32 MaxSegments = 16;
+
+public:
+
+    /** Construct an empty composite view with no segments. */
+    CompositeMemoryView() noexcept = default;
+
+    /**
+     * Append a memory segment to the end of the logical buffer.
+     * Empty segments are accepted and simply contribute nothing.
+     *
+     * @param segment A memory segment to append. Not copied; must stay alive.
+     * @return A reference to self for a fluent interface.
+     * @throw IndexOutOfRangeException If the view already holds MaxSegments segments.
+     */
+    CompositeMemoryView& append(ImmutableMemoryView segment) {
+        assertIndexInRange(_count, 0, MaxSegments, "CompositeMemoryView::append()");
+
+        _segments[_count++] = std::move(segment);
+
+        return *this;
+    }
+
+    /**
+     * Append the written-so-far contents of a write buffer as a segment.
+     *
+     * @param buffer A buffer whose written content to append. Not copied.
+     * @return A reference to self for a fluent interface.
+     * @throw IndexOutOfRangeException If the view already holds MaxSegments segments.
+     */
+    CompositeMemoryView& append(WriteBuffer const& buffer) {
+        return append(buffer.viewWritten());
+    }
+
+    /** Get the number of segments in the composite.
+     * @return Number of segments appended so far.
+     */
+    uint32 count() const noexcept {
+        return _count;
+    }
+
+    /** Get a segment of the composite by its index.
+     * @param index An index of the segment to get.
+     * @return The memory segment at the given index.
+     */
+    ImmutableMemoryView const& segment(uint32 index) const {
+        assertIndexInRange(index, 0, _count, "CompositeMemoryView::segment()");
+
+        return _segments[index];
+    }
+
+    /** Get the total number of bytes the composite describes.
+     * @return Sum of the sizes of all segments.
+     */
+    size_type size() const noexcept {
+        size_type total = 0;
+        for (uint32 i = 0; i < _count; ++i) {
+            total += _segments[i].size();
+        }
+
+        return total;
+    }
+
+    bool empty() const noexcept {
+        return (size() == 0);
+    }
+
+private:
+
+    ImmutableMemoryView _segments[MaxSegments];
+    uint32              _count{0};
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_COMPOSITEMEMORYVIEW_HPP
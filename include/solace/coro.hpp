@@ -0,0 +1,232 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Coroutine adapter for Future
+ *	@file		solace/coro.hpp
+ *	@brief		co_await on Future<T> and a Task<T> coroutine type
+ *
+ * This header is opt-in: the library itself builds as C++14 and none of its
+ * translation units include it. Consumers compiling with C++20 coroutine
+ * support can include it to await futures directly, so a linear async flow
+ * compiles down to one resumable frame instead of a nested then() chain with
+ * a type-erased callback per stage.
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_CORO_HPP
+#define SOLACE_CORO_HPP
+
+#if defined(__has_include)
+#if __has_include(<version>)
+#include <version>
+#endif
+#endif
+
+#if !(defined(__cpp_impl_coroutine) && defined(__cpp_lib_coroutine))
+#error "solace/coro.hpp requires a compiler and standard library with C++20 coroutine support"
+#endif
+
+#include "solace/future.hpp"
+#include "solace/exception.hpp"
+
+#include <coroutine>
+
+
+namespace Solace {
+
+namespace details {
+
+/**
+ * Awaiter bridging a Future to a suspended coroutine.
+ * Attaching the resume hook goes through the core's callback storage directly -
+ * a single small callback, constructed inline in the core - rather than a
+ * then().onError() pair with its own chained cores.
+ */
+template<typename T>
+struct FutureAwaiter {
+
+    struct ResumeCB final : public CallbackBase<T> {
+        FutureAwaiter* awaiter;
+        std::coroutine_handle<> handle;
+
+        ResumeCB(FutureAwaiter* a, std::coroutine_handle<> h) : awaiter(a), handle(h)
+        {}
+
+        void operator() (Result<T, Error>&& result) override {
+            awaiter->payload = std::move(result);
+            awaiter->handle.resume();
+        }
+    };
+
+    explicit FutureAwaiter(std::shared_ptr<Core<T>> core) : _core(std::move(core))
+    {}
+
+    static FutureAwaiter from(Future<T>& future) {
+        return FutureAwaiter(future._core);
+    }
+
+    bool await_ready() const noexcept {
+        return false;
+    }
+
+    void await_suspend(std::coroutine_handle<> h) {
+        handle = h;
+        _core->template setCallback<ResumeCB>(this, h);
+    }
+
+    T await_resume() {
+        auto result = payload.move();
+        if (result.isError()) {
+            const auto message = result.getError().toString();
+            raise<Exception>(std::string(message.data(), message.size()));
+        }
+
+        return result.moveResult();
+    }
+
+    std::shared_ptr<Core<T>>    _core;
+    std::coroutine_handle<>     handle;
+    Optional<Result<T, Error>>  payload;
+};
+
+
+template<>
+inline void FutureAwaiter<void>::await_resume() {
+    auto result = payload.move();
+    if (result.isError()) {
+        const auto message = result.getError().toString();
+        raise<Exception>(std::string(message.data(), message.size()));
+    }
+}
+
+}  // namespace details
+
+
+template<typename T>
+details::FutureAwaiter<T> operator co_await(Future<T>&& future) {
+    return details::FutureAwaiter<T>::from(future);
+}
+
+
+/**
+ * An eagerly-started coroutine whose result is delivered through a Promise,
+ * making it composable with the rest of the future machinery:
+ *
+ * \code{.cpp}
+ * Task<int> compute() {
+ *     auto a = co_await fetchA();
+ *     auto b = co_await fetchB(a);
+ *     co_return a + b;
+ * }
+ *
+ * compute().getFuture().then([](int sum) { ... });
+ * \endcode
+ *
+ * Exceptions escaping the coroutine body resolve the promise with an error.
+ */
+template<typename T>
+class Task {
+public:
+
+    struct promise_type {
+        Promise<T> pm;
+
+        Task get_return_object() {
+            return Task(pm.getFuture());
+        }
+
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+
+        void return_value(T value) {
+            pm.setValue(std::move(value));
+        }
+
+        void unhandled_exception() {
+            try {
+                throw;
+            } catch (const std::exception& e) {
+                pm.setError(Error(e.what()));
+            } catch (...) {
+                pm.setError(Error("Unhandled exception in coroutine"));
+            }
+        }
+    };
+
+    explicit Task(Future<T>&& future) : _future(std::move(future))
+    {}
+
+    /** Take the future delivering this task's result. Meant to be called once. */
+    Future<T> getFuture() {
+        return std::move(_future);
+    }
+
+    auto operator co_await() && {
+        return details::FutureAwaiter<T>::from(_future);
+    }
+
+private:
+
+    Future<T> _future;
+};
+
+
+template<>
+class Task<void> {
+public:
+
+    struct promise_type {
+        Promise<void> pm;
+
+        Task get_return_object() {
+            return Task(pm.getFuture());
+        }
+
+        std::suspend_never initial_suspend() const noexcept { return {}; }
+        std::suspend_never final_suspend() const noexcept { return {}; }
+
+        void return_void() {
+            pm.setValue();
+        }
+
+        void unhandled_exception() {
+            try {
+                throw;
+            } catch (const std::exception& e) {
+                pm.setError(Error(e.what()));
+            } catch (...) {
+                pm.setError(Error("Unhandled exception in coroutine"));
+            }
+        }
+    };
+
+    explicit Task(Future<void>&& future) : _future(std::move(future))
+    {}
+
+    Future<void> getFuture() {
+        return std::move(_future);
+    }
+
+    auto operator co_await() && {
+        return details::FutureAwaiter<void>::from(_future);
+    }
+
+private:
+
+    Future<void> _future;
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_CORO_HPP
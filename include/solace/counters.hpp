@@ -0,0 +1,170 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Wait-free statistics counters
+ *	@file		solace/counters.hpp
+ *	@brief		Sharded counters and log-scale histograms for service metrics
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_COUNTERS_HPP
+#define SOLACE_COUNTERS_HPP
+
+#include "solace/types.hpp"
+
+#include <atomic>
+
+
+namespace Solace {
+
+namespace details {
+
+/** The shard of this thread: a small ordinal assigned on first use,
+ * folded onto the shard count by the callers. Threads spread across
+ * shards round-robin by creation order. */
+uint32 counterShard() noexcept;
+
+}  // namespace details
+
+
+/**
+ * A wait-free event counter for service metrics.
+ *
+ * A single std::atomic shared by every worker turns a one-instruction
+ * increment into a cache-line tug-of-war. This counter keeps a small set of
+ * cache-line-padded shards instead: each thread increments its own shard
+ * with a relaxed add - wait-free, no line bouncing between workers that
+ * landed on different shards - and value() sums the shards on the reader's
+ * side, where the cost belongs.
+ *
+ * Totals are monotone but a concurrent read may miss in-flight increments;
+ * that is the usual and intended trade for uncontended recording. Writers
+ * never synchronize with each other or with readers.
+ */
+class StatsCounter {
+public:
+
+    /** Shards per counter; a power of two. More threads than shards is fine -
+     * they share, round-robin - it only returns some of the contention. */
+    static constexpr uint32 kNbShards = 8;
+
+public:
+
+    StatsCounter() noexcept = default;
+
+    StatsCounter(StatsCounter const&) = delete;
+    StatsCounter& operator= (StatsCounter const&) = delete;
+
+    /** Count delta events, wait-free. */
+    void add(uint64 delta = 1) noexcept {
+        _shards[details::counterShard() & (kNbShards - 1)]
+                .value.fetch_add(delta, std::memory_order_relaxed);
+    }
+
+    /** Sum the shards.
+     * @return Total of every add() that completed before this call.
+     */
+    uint64 value() const noexcept {
+        uint64 total = 0;
+        for (const auto& shard : _shards) {
+            total += shard.value.load(std::memory_order_relaxed);
+        }
+
+        return total;
+    }
+
+private:
+
+    struct alignas(64) Shard {
+        std::atomic<uint64> value {0};
+    };
+
+    Shard _shards[kNbShards];
+};
+
+
+/**
+ * A fixed-bucket log-scale histogram, sharded like StatsCounter.
+ *
+ * Bucket i counts recorded values in [2^i, 2^(i+1)); zero lands in bucket 0.
+ * Sixty-four power-of-two buckets cover the full uint64 range, so latencies
+ * in nanoseconds and sizes in bytes both fit without configuration, at the
+ * cost of bucket-width resolution - the right trade for dashboards that ask
+ * "which decade" rather than "which microsecond".
+ *
+ * record() touches only the calling thread's shard with relaxed adds;
+ * snapshot() merges the shards into plain totals for reporting. Like the
+ * counter, snapshots may miss in-flight records and writers never contend
+ * across shards.
+ */
+class StatsHistogram {
+public:
+
+    static constexpr uint32 kNbBuckets = 64;
+
+    /** Merged totals of one histogram at a point in time. */
+    struct Snapshot {
+        uint64 count;               //!< Values recorded.
+        uint64 sum;                 //!< Sum of the recorded values.
+        uint64 buckets[kNbBuckets];
+
+        /**
+         * Approximate the q-th quantile from the buckets.
+         * @param q A quantile in [0, 1], e.g. 0.99.
+         * @return Upper bound of the bucket the quantile falls in, or 0
+         *  when nothing has been recorded.
+         */
+        uint64 quantile(float64 q) const noexcept;
+    };
+
+public:
+
+    StatsHistogram() noexcept = default;
+
+    StatsHistogram(StatsHistogram const&) = delete;
+    StatsHistogram& operator= (StatsHistogram const&) = delete;
+
+    /** Record one value, wait-free. */
+    void record(uint64 value) noexcept {
+        auto& shard = _shards[details::counterShard() & (StatsCounter::kNbShards - 1)];
+
+        shard.count.fetch_add(1, std::memory_order_relaxed);
+        shard.sum.fetch_add(value, std::memory_order_relaxed);
+        shard.buckets[bucketOf(value)].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    /** Merge the shards into plain totals.
+     * @return Aggregated count, sum and buckets.
+     */
+    Snapshot snapshot() const noexcept;
+
+    /** The bucket a value falls into: the position of its highest set bit. */
+    static uint32 bucketOf(uint64 value) noexcept {
+        return 63u - static_cast<uint32>(__builtin_clzll(value | 1));
+    }
+
+private:
+
+    struct alignas(64) Shard {
+        std::atomic<uint64> count {0};
+        std::atomic<uint64> sum {0};
+        std::atomic<uint64> buckets[kNbBuckets] {};
+    };
+
+    Shard _shards[StatsCounter::kNbShards];
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_COUNTERS_HPP
@@ -0,0 +1,79 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Runtime CPU feature detection
+ *	@file		solace/cpuFeatures.hpp
+ *	@brief		Instruction-set extensions of the CPU the process runs on
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_CPUFEATURES_HPP
+#define SOLACE_CPUFEATURES_HPP
+
+
+namespace Solace {
+
+/**
+ * Instruction-set extensions detected on the running CPU.
+ *
+ * One binary of this library serves machines of very different vintages, so
+ * hot kernels ship several code paths - a baseline one and variants compiled
+ * for wider instruction sets via the target function attribute - and pick
+ * between them at run time. This struct is what they pick on: every flag is
+ * true only when the running CPU (and, where it matters, the OS) supports
+ * the extension, regardless of what the library was compiled for.
+ *
+ * A kernel registers its variants by resolving once into a function pointer:
+ *
+ *      static const Kernel kernel = cpuFeatures().avx2 ? kernel_avx2
+ *                                                      : kernel_baseline;
+ *
+ * Fields for the other architecture are present but always false, so the
+ * resolver code needs no preprocessor guards of its own.
+ *
+ * Setting the SOLACE_CPU_BASELINE environment variable reports every
+ * extension as absent, forcing all kernels onto their baseline paths - for
+ * benchmarking variants against each other and for exercising fallback code
+ * on hardware that would never take it.
+ */
+struct CpuFeatures {
+
+    // x86-64
+    bool    ssse3   {false};
+    bool    sse41   {false};
+    bool    sse42   {false};
+    bool    avx     {false};
+    bool    avx2    {false};
+    bool    avx512bw {false};
+    bool    sha     {false};        //!< SHA-NI extensions.
+
+    // AArch64
+    bool    neon    {false};        //!< Advanced SIMD.
+    bool    crc32   {false};        //!< CRC32 instructions.
+    bool    sha2    {false};        //!< SHA-256 crypto extensions.
+    bool    aes     {false};        //!< AES crypto extensions.
+};
+
+
+/**
+ * Get the extensions of the CPU this process is running on.
+ * Detection runs once, on first use; the call is a table lookup thereafter.
+ *
+ * @return The detected feature set.
+ */
+CpuFeatures const& cpuFeatures() noexcept;
+
+}  // End of namespace Solace
+#endif  // SOLACE_CPUFEATURES_HPP
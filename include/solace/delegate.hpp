@@ -24,6 +24,8 @@
 #ifndef SOLACE_DELEGATE_HPP
 #define SOLACE_DELEGATE_HPP
 
+#include <cstddef>      // max_align_t
+#include <cstring>      // memcpy for trivially-copyable storage moves
 #include <memory>
 #include <type_traits>
 #include <utility>
@@ -309,6 +311,268 @@ private:
 };
 
 
+
+template <typename T, std::size_t StorageSize = 4 * sizeof(void*)>
+class inplace_delegate;
+
+
+/**
+ * A delegate with guaranteed inline storage and no heap path.
+ *
+ * delegate<> above falls back to allocation when a capture does not fit;
+ * for dispatchers invoking millions of callbacks a second that is both a
+ * latency hazard and a cache miss per call. inplace_delegate keeps the
+ * callable inside the object - a capture larger than StorageSize is a
+ * compile error, never an allocation - and the from<>() factories bake a
+ * free function or member pointer into the trampoline itself, so such
+ * calls dispatch directly with nothing loaded from the store.
+ *
+ * Move-only, like the closures it is meant to carry.
+ */
+template <class R, std::size_t StorageSize, class ...A>
+class inplace_delegate<R(A...), StorageSize> {
+public:
+
+    ~inplace_delegate() {
+        if (manage_) {
+            manage_(StorageOp::Destroy, storage_, nullptr);
+        }
+    }
+
+    inplace_delegate() = default;
+
+    inplace_delegate(::std::nullptr_t const) noexcept : inplace_delegate() { }
+
+    inplace_delegate(inplace_delegate&& rhs) noexcept :
+        stub_(rhs.stub_),
+        manage_(rhs.manage_)
+    {
+        if (manage_) {
+            manage_(StorageOp::Move, storage_, rhs.storage_);
+        }
+
+        rhs.stub_ = nullptr;
+        rhs.manage_ = nullptr;
+    }
+
+    inplace_delegate(inplace_delegate const&) = delete;
+    inplace_delegate& operator= (inplace_delegate const&) = delete;
+
+    /** Bind a free function, dispatched through the stored pointer. */
+    inplace_delegate(R (* const function_ptr)(A...)) {
+        assign(function_ptr);
+    }
+
+    /** Bind an object and a method on it. Only the pair is stored. */
+    template <class C>
+    inplace_delegate(C* const object_ptr, R (C::* const method_ptr)(A...)) {
+        assign(method_binding<C>{object_ptr, method_ptr});
+    }
+
+    template <class C>
+    inplace_delegate(C const* const object_ptr, R (C::* const method_ptr)(A...) const) {
+        assign(const_method_binding<C>{object_ptr, method_ptr});
+    }
+
+    /** Bind a callable. It must fit the inline storage - this never allocates. */
+    template <typename T,
+              typename = std::enable_if_t<!std::is_same<inplace_delegate, std::decay_t<T>>{}>
+              >
+    inplace_delegate(T&& f) {
+        assign(::std::forward<T>(f));
+    }
+
+    inplace_delegate& operator= (inplace_delegate&& rhs) noexcept {
+        if (this != &rhs) {
+            reset();
+
+            stub_ = rhs.stub_;
+            manage_ = rhs.manage_;
+            if (manage_) {
+                manage_(StorageOp::Move, storage_, rhs.storage_);
+            }
+
+            rhs.stub_ = nullptr;
+            rhs.manage_ = nullptr;
+        }
+
+        return *this;
+    }
+
+    template <typename T,
+              typename = std::enable_if_t<!std::is_same<inplace_delegate, std::decay_t<T>>{}>
+              >
+    inplace_delegate& operator= (T&& f) {
+        reset();
+        assign(::std::forward<T>(f));
+
+        return *this;
+    }
+
+    /**
+     * Bind a free function known at compile time.
+     * The call goes straight to the function - nothing is read from the
+     * store and the trampoline is a plain tail call.
+     */
+    template <R (* const function_ptr)(A...)>
+    static inplace_delegate from() noexcept {
+        inplace_delegate d;
+        d.stub_ = function_stub<function_ptr>;
+
+        return d;
+    }
+
+    /**
+     * Bind a method known at compile time to an object.
+     * Only the object pointer is stored; the member-pointer dispatch is
+     * resolved when the trampoline is instantiated.
+     */
+    template <class C, R (C::* const method_ptr)(A...)>
+    static inplace_delegate from(C* const object_ptr) noexcept {
+        inplace_delegate d;
+        d.store(object_ptr);
+        d.stub_ = method_stub<C, method_ptr>;
+
+        return d;
+    }
+
+    template <class C, R (C::* const method_ptr)(A...) const>
+    static inplace_delegate from(C const* const object_ptr) noexcept {
+        inplace_delegate d;
+        d.store(object_ptr);
+        d.stub_ = const_method_stub<C, method_ptr>;
+
+        return d;
+    }
+
+    void reset() {
+        if (manage_) {
+            manage_(StorageOp::Destroy, storage_, nullptr);
+        }
+
+        stub_ = nullptr;
+        manage_ = nullptr;
+    }
+
+    inplace_delegate& swap(inplace_delegate& other) noexcept {
+        inplace_delegate tmp(::std::move(other));
+        other = ::std::move(*this);
+        *this = ::std::move(tmp);
+
+        return *this;
+    }
+
+    bool operator== (::std::nullptr_t const) const noexcept { return !stub_; }
+
+    bool operator!= (::std::nullptr_t const) const noexcept { return stub_; }
+
+    explicit operator bool() const noexcept { return stub_; }
+
+    R operator()(A... args) const {
+        return stub_(storage_, ::std::forward<A>(args)...);
+    }
+
+private:
+
+    enum class StorageOp {
+        Destroy,
+        Move
+    };
+
+    using stub_ptr_type = R (*)(void*, A&&...);
+    using manager_type = void (*)(StorageOp, void*, void*);
+
+    template <class C>
+    struct method_binding {
+        C* object;
+        R (C::* method)(A...);
+
+        R operator() (A... args) {
+            return (object->*method)(::std::forward<A>(args)...);
+        }
+    };
+
+    template <class C>
+    struct const_method_binding {
+        C const* object;
+        R (C::* method)(A...) const;
+
+        R operator() (A... args) {
+            return (object->*method)(::std::forward<A>(args)...);
+        }
+    };
+
+    template <typename T>
+    void assign(T&& f) {
+        using functor_type = std::decay_t<T>;
+
+        static_assert(sizeof(functor_type) <= StorageSize,
+                      "Callable does not fit inplace_delegate storage: increase StorageSize");
+        static_assert(alignof(functor_type) <= alignof(::std::max_align_t),
+                      "Callable is over-aligned for inplace_delegate storage");
+
+        new (static_cast<void*>(storage_)) functor_type(::std::forward<T>(f));
+        stub_ = functor_stub<functor_type>;
+        manage_ = std::is_trivially_copyable<functor_type>::value
+                ? &trivial_manager
+                : &functor_manager<functor_type>;
+    }
+
+    /** Drop a trivially-copyable value into the store, with no call stub. */
+    template <typename T>
+    void store(T const& value) noexcept {
+        static_assert(sizeof(T) <= StorageSize,
+                      "Value does not fit inplace_delegate storage: increase StorageSize");
+
+        memcpy(storage_, &value, sizeof(T));
+        manage_ = &trivial_manager;
+    }
+
+    template <typename T>
+    static R functor_stub(void* const p, A&&... args) {
+        return (*static_cast<T*>(p))(::std::forward<A>(args)...);
+    }
+
+    template <R (* function_ptr)(A...)>
+    static R function_stub(void* const, A&&... args) {
+        return function_ptr(::std::forward<A>(args)...);
+    }
+
+    template <class C, R (C::* method_ptr)(A...)>
+    static R method_stub(void* const p, A&&... args) {
+        return ((*static_cast<C**>(p))->*method_ptr)(::std::forward<A>(args)...);
+    }
+
+    template <class C, R (C::* method_ptr)(A...) const>
+    static R const_method_stub(void* const p, A&&... args) {
+        return ((*static_cast<C const**>(p))->*method_ptr)(::std::forward<A>(args)...);
+    }
+
+    static void trivial_manager(StorageOp op, void* const self, void* const other) {
+        if (op == StorageOp::Move) {
+            memcpy(self, other, StorageSize);
+        }
+    }
+
+    template <typename T>
+    static void functor_manager(StorageOp op, void* const self, void* const other) {
+        switch (op) {
+        case StorageOp::Destroy:
+            static_cast<T*>(self)->~T();
+            break;
+
+        case StorageOp::Move:
+            new (self) T(::std::move(*static_cast<T*>(other)));
+            static_cast<T*>(other)->~T();
+            break;
+        }
+    }
+
+    alignas(::std::max_align_t) mutable unsigned char storage_[StorageSize];
+    stub_ptr_type stub_ {nullptr};
+    manager_type manage_ {nullptr};
+};
+
 }  // End of namespace Solace
 
 namespace std {
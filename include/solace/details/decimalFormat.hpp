@@ -0,0 +1,100 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Shared decimal text formatting kernels
+ *	@file		solace/details/decimalFormat.hpp
+ *	@brief		Digit-pair integer and shortest round-trip float formatting
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_DETAILS_DECIMALFORMAT_HPP
+#define SOLACE_DETAILS_DECIMALFORMAT_HPP
+
+#include "solace/types.hpp"
+
+#include <cstdio>   // snprintf
+#include <cstdlib>  // strtod
+#include <cstring>  // memcmp
+
+
+namespace Solace { namespace details {
+
+/// Longest decimal representation of an uint64 is 20 digits.
+constexpr size_t kMaxDecimalDigits = 20;
+
+/** Format the value as decimal digits into the tail of the given scratch
+ * buffer two digits at a time. The scratch must hold at least
+ * kMaxDecimalDigits bytes.
+ *
+ * @return Offset of the first digit within the scratch buffer.
+ */
+inline size_t formatDecimal(uint64 value, char* scratch) noexcept {
+    static const char kDigitPairs[] =
+            "00010203040506070809"
+            "10111213141516171819"
+            "20212223242526272829"
+            "30313233343536373839"
+            "40414243444546474849"
+            "50515253545556575859"
+            "60616263646566676869"
+            "70717273747576777879"
+            "80818283848586878889"
+            "90919293949596979899";
+
+    size_t pos = kMaxDecimalDigits;
+
+    while (value >= 100) {
+        const auto pair = (value % 100) * 2;
+        value /= 100;
+
+        pos -= 2;
+        scratch[pos] = kDigitPairs[pair];
+        scratch[pos + 1] = kDigitPairs[pair + 1];
+    }
+
+    if (value >= 10) {
+        pos -= 2;
+        scratch[pos] = kDigitPairs[value * 2];
+        scratch[pos + 1] = kDigitPairs[value * 2 + 1];
+    } else {
+        scratch[--pos] = static_cast<char>('0' + value);
+    }
+
+    return pos;
+}
+
+
+/** Format a float64 as the shortest decimal text that still parses back to
+ * the identical bit pattern, a-la Grisu fallback: try %.15g through %.17g.
+ *
+ * @return Number of characters written into the scratch buffer.
+ */
+inline int formatShortestFloat(float64 value, char (&scratch)[32]) noexcept {
+    int len = 0;
+    for (int precision = 15; precision <= 17; ++precision) {
+        len = snprintf(scratch, sizeof(scratch), "%.*g", precision, value);
+
+        const float64 parsed = strtod(scratch, nullptr);
+        if (memcmp(&parsed, &value, sizeof(value)) == 0) {
+            break;
+        }
+    }
+
+    return len;
+}
+
+}  // End of namespace details
+}  // End of namespace Solace
+#endif  // SOLACE_DETAILS_DECIMALFORMAT_HPP
@@ -25,6 +25,8 @@
 #define SOLACE_DEATILS_FUTURE_COMPOSITION_HPP
 
 #include "solace/future.hpp"
+#include "solace/array.hpp"
+#include "solace/arrayView.hpp"
 
 #include <atomic>
 
@@ -49,7 +51,7 @@ struct CollectContext {
     ~CollectContext() {
         if (!threw.exchange(true)) {
             // map Optional<T> -> T
-            std::vector<T> finalResult;
+            typename Array<T>::Storage finalResult;
             finalResult.reserve(result.size());
 
             std::transform(result.begin(), result.end(), std::back_inserter(finalResult),
@@ -111,9 +113,347 @@ private:
     std::atomic<bool> threw {false};
 };
 
+/**
+ * Shared state for whenAll.
+ * Per-future callbacks and result slots live side by side in one preallocated
+ * array and completion is tracked by a single atomic countdown, so a 50-way
+ * fan-out costs a fixed number of allocations - not a then/onError chain with
+ * its own promise core per future. Callbacks are handed to each future's core
+ * as aliasing shared_ptr into this block, so no per-future heap nodes either.
+ */
+template <typename T>
+struct WhenAllContext {
+    using size_type = std::size_t;
+
+    struct EntryCB final : public CallbackBase<T> {
+        WhenAllContext* ctx {nullptr};
+        size_type index {0};
+        std::shared_ptr<void> owner;
+
+        void operator() (Result<T, Error>&& result) override {
+            ctx->onResult(index, std::move(result));
+        }
+
+    protected:
+        // Entries live inside the context block: dropping the last reference
+        // releases the context instead of deleting in place.
+        void dispose() noexcept override {
+            owner.reset();
+        }
+    };
+
+    struct Entry {
+        EntryCB cb;
+        Optional<T> slot;
+    };
+
+    explicit WhenAllContext(size_type n) :
+        entries(new Entry[n]),
+        nbFutures(n),
+        pending(n)
+    {
+        for (size_type i = 0; i < n; ++i) {
+            entries[i].cb.ctx = this;
+            entries[i].cb.index = i;
+        }
+    }
+
+    void onResult(size_type index, Result<T, Error>&& result) {
+        if (result.isError()) {
+            if (!failed.exchange(true)) {
+                firstError = result.moveError();
+            }
+        } else {
+            entries[index].slot = result.moveResult();
+        }
+
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (failed.load()) {
+                p.setError(std::move(firstError));
+            } else {
+                typename Array<T>::Storage values;
+                values.reserve(nbFutures);
+                for (size_type i = 0; i < nbFutures; ++i) {
+                    values.emplace_back(entries[i].slot.move());
+                }
+
+                p.setValue(Array<T>(std::move(values)));
+            }
+        }
+    }
+
+    Future<Array<T>> getFuture() {
+        return p.getFuture();
+    }
+
+    Promise<Array<T>>           p;
+    std::unique_ptr<Entry[]>    entries;
+    size_type                   nbFutures;
+    Error                       firstError {""};
+    std::atomic<bool>           failed {false};
+    std::atomic<size_type>      pending;
+};
+
+
+template <>
+struct WhenAllContext<void> {
+    using size_type = std::size_t;
+
+    struct EntryCB final : public CallbackBase<void> {
+        WhenAllContext* ctx {nullptr};
+        std::shared_ptr<void> owner;
+
+        void operator() (Result<void, Error>&& result) override {
+            ctx->onResult(std::move(result));
+        }
+
+    protected:
+        void dispose() noexcept override {
+            owner.reset();
+        }
+    };
+
+    explicit WhenAllContext(size_type n) :
+        entries(new EntryCB[n]),
+        pending(n)
+    {
+        for (size_type i = 0; i < n; ++i) {
+            entries[i].ctx = this;
+        }
+    }
+
+    void onResult(Result<void, Error>&& result) {
+        if (result.isError()) {
+            if (!failed.exchange(true)) {
+                firstError = result.moveError();
+            }
+        }
+
+        if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            if (failed.load()) {
+                p.setError(std::move(firstError));
+            } else {
+                p.setValue();
+            }
+        }
+    }
+
+    Future<void> getFuture() {
+        return p.getFuture();
+    }
+
+    Promise<void>               p;
+    std::unique_ptr<EntryCB[]>  entries;
+    Error                       firstError {""};
+    std::atomic<bool>           failed {false};
+    std::atomic<size_type>      pending;
+};
+
+
+/**
+ * Shared state for whenAny. Same single-block layout as WhenAllContext:
+ * the first future to produce a value wins, failures only count down so the
+ * last one can report an error when no future succeeds at all.
+ */
+template <typename T>
+struct WhenAnyContext {
+    using size_type = std::size_t;
+
+    struct EntryCB final : public CallbackBase<T> {
+        WhenAnyContext* ctx {nullptr};
+        std::shared_ptr<void> owner;
+
+        void operator() (Result<T, Error>&& result) override {
+            ctx->onResult(std::move(result));
+        }
+
+    protected:
+        void dispose() noexcept override {
+            owner.reset();
+        }
+    };
+
+    explicit WhenAnyContext(size_type n) :
+        entries(new EntryCB[n]),
+        pending(n)
+    {
+        for (size_type i = 0; i < n; ++i) {
+            entries[i].ctx = this;
+        }
+    }
+
+    void onResult(Result<T, Error>&& result) {
+        if (result.isError()) {
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1 && !done.exchange(true)) {
+                p.setError(result.moveError());
+            }
+        } else {
+            if (!done.exchange(true)) {
+                p.setValue(result.moveResult());
+            }
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    Future<T> getFuture() {
+        return p.getFuture();
+    }
+
+    Promise<T>                  p;
+    std::unique_ptr<EntryCB[]>  entries;
+    std::atomic<bool>           done {false};
+    std::atomic<size_type>      pending;
+};
+
+
+template <>
+struct WhenAnyContext<void> {
+    using size_type = std::size_t;
+
+    struct EntryCB final : public CallbackBase<void> {
+        WhenAnyContext* ctx {nullptr};
+        std::shared_ptr<void> owner;
+
+        void operator() (Result<void, Error>&& result) override {
+            ctx->onResult(std::move(result));
+        }
+
+    protected:
+        void dispose() noexcept override {
+            owner.reset();
+        }
+    };
+
+    explicit WhenAnyContext(size_type n) :
+        entries(new EntryCB[n]),
+        pending(n)
+    {
+        for (size_type i = 0; i < n; ++i) {
+            entries[i].ctx = this;
+        }
+    }
+
+    void onResult(Result<void, Error>&& result) {
+        if (result.isError()) {
+            if (pending.fetch_sub(1, std::memory_order_acq_rel) == 1 && !done.exchange(true)) {
+                p.setError(result.moveError());
+            }
+        } else {
+            if (!done.exchange(true)) {
+                p.setValue();
+            }
+            pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+    }
+
+    Future<void> getFuture() {
+        return p.getFuture();
+    }
+
+    Promise<void>               p;
+    std::unique_ptr<EntryCB[]>  entries;
+    std::atomic<bool>           done {false};
+    std::atomic<size_type>      pending;
+};
+
+
 }  // namespace details
 
 
+/**
+ * Create a future that resolves when all of the given futures resolve,
+ * yielding every value in input order. The first failure fails the composite
+ * once the remaining futures complete.
+ *
+ * @param futures Futures to join. Their results are consumed by the composite.
+ * @return A future of an array with one value per input future.
+ */
+template <typename T>
+Future<Array<T>> whenAll(ArrayView<Future<T>> futures) {
+    if (futures.empty()) {
+        Promise<Array<T>> p;
+        auto result = p.getFuture();
+        p.setValue(Array<T>());
+
+        return result;
+    }
+
+    auto ctx = std::make_shared<details::WhenAllContext<T>>(futures.size());
+    auto result = ctx->getFuture();
+
+    for (typename ArrayView<Future<T>>::size_type i = 0; i < futures.size(); ++i) {
+        if (!futures[i]._core || futures[i]._core->isDetached()) {
+            raiseInvalidStateError("Invalid Future without a Promise");
+        }
+
+        ctx->entries[i].cb.owner = ctx;
+        futures[i]._core->adoptCallback(&ctx->entries[i].cb);
+    }
+
+    return result;
+}
+
+
+inline
+Future<void> whenAll(ArrayView<Future<void>> futures) {
+    if (futures.empty()) {
+        Promise<void> p;
+        auto result = p.getFuture();
+        p.setValue();
+
+        return result;
+    }
+
+    auto ctx = std::make_shared<details::WhenAllContext<void>>(futures.size());
+    auto result = ctx->getFuture();
+
+    for (ArrayView<Future<void>>::size_type i = 0; i < futures.size(); ++i) {
+        if (!futures[i]._core || futures[i]._core->isDetached()) {
+            raiseInvalidStateError("Invalid Future without a Promise");
+        }
+
+        ctx->entries[i].owner = ctx;
+        futures[i]._core->adoptCallback(&ctx->entries[i]);
+    }
+
+    return result;
+}
+
+
+/**
+ * Create a future that resolves with the value of the first of the given
+ * futures to succeed. Failures are only reported when every future fails,
+ * in which case the last failure is propagated.
+ *
+ * @param futures Futures to race. Their results are consumed by the composite.
+ * @return A future of the first value produced.
+ */
+template <typename T>
+Future<T> whenAny(ArrayView<Future<T>> futures) {
+    if (futures.empty()) {
+        Promise<T> p;
+        auto result = p.getFuture();
+        p.setError(Error("whenAny of no futures"));
+
+        return result;
+    }
+
+    auto ctx = std::make_shared<details::WhenAnyContext<T>>(futures.size());
+    auto result = ctx->getFuture();
+
+    for (typename ArrayView<Future<T>>::size_type i = 0; i < futures.size(); ++i) {
+        if (!futures[i]._core || futures[i]._core->isDetached()) {
+            raiseInvalidStateError("Invalid Future without a Promise");
+        }
+
+        ctx->entries[i].owner = ctx;
+        futures[i]._core->adoptCallback(&ctx->entries[i]);
+    }
+
+    return result;
+}
+
+
 template <class InputIterator>
 Future<typename details::CollectContext<typename std::iterator_traits<InputIterator>::value_type::value_type>::Result>
 collect(InputIterator first, InputIterator last) {
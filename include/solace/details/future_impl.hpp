@@ -56,6 +56,35 @@ struct CB : public CallbackBase<FutureValueType> {
 };
 
 
+/**
+ * A callback decorator re-dispatching completion onto an executor.
+ * Wraps the real continuation callback so that it runs as a task submitted to the
+ * given executor rather than inline on the thread that resolved the promise.
+ */
+template<typename FutureValueType,
+         typename InnerCB>
+struct ViaCB : public CallbackBase<FutureValueType> {
+    typedef ViaCB<FutureValueType, InnerCB> CallbackType;
+
+    /// A reference escapes into the submitted task - keep this callback on the heap.
+    static constexpr bool kSelfReferential = true;
+
+    Executor& executor;
+    InnerCB inner;
+
+    ViaCB(Executor& ex, InnerCB&& continuation) :
+        executor(ex),
+        inner(std::move(continuation))
+    {}
+
+    void operator() (Result<FutureValueType, Error>&& result) override {
+        executor.submit([self = CallbackPtr<CallbackType>(this), res = std::move(result)] () mutable {
+            self->inner(std::move(res));
+        });
+    }
+};
+
+
 /**
  * Spacialization for Future<void> and continuation F returning R
  */
@@ -149,11 +178,11 @@ struct CB<T, Result<UnpuckedResultType, Error>, UnpuckedResultType, F> : public
             pm.setError(result.moveError());
         } else {
             cont(result.moveResult())
-                .then([self = this->shared_from_this()] (UnpuckedResultType&& rv){
-                    std::static_pointer_cast<CallbackType>(self)->pm.setValue(std::move(rv));
+                .then([self = CallbackPtr<CallbackType>(this)] (UnpuckedResultType&& rv){
+                    self->pm.setValue(std::move(rv));
                 })
-                .orElse([self = this->shared_from_this()] (Error&& er) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setError(std::move(er));
+                .orElse([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
+                    self->pm.setError(std::move(er));
                 });
         }
     }
@@ -179,11 +208,11 @@ struct CB<T, Result<void, Error>, void, F> : public CallbackBase<T> {
             pm.setError(result.moveError());
         } else {
             cont(result.moveResult())
-                .then([self = this->shared_from_this()] () {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setValue();
+                .then([self = CallbackPtr<CallbackType>(this)] () {
+                    self->pm.setValue();
                 })
-                .orElse([self = this->shared_from_this()] (Error&& er) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setError(std::move(er));
+                .orElse([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
+                    self->pm.setError(std::move(er));
                 });
         }
     }
@@ -210,11 +239,11 @@ struct CB<void, Result<UnpuckedResultType, Error>, UnpuckedResultType, F> : publ
             pm.setError(result.moveError());
         } else {
             cont()
-                .then([self = shared_from_this()] (UnpuckedResultType&& rv){
-                    std::static_pointer_cast<CallbackType>(self)->pm.setValue(std::move(rv));
+                .then([self = CallbackPtr<CallbackType>(this)] (UnpuckedResultType&& rv){
+                    self->pm.setValue(std::move(rv));
                 })
-                .orElse([self = shared_from_this()] (Error&& er) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setError(std::move(er));
+                .orElse([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
+                    self->pm.setError(std::move(er));
                 });
         }
     }
@@ -238,11 +267,11 @@ struct CB<void, Result<void, Error>, void, F> : public CallbackBase<void> {
             pm.setError(result.moveError());
         } else {
             cont()
-                .then([self = shared_from_this()] () {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setValue();
+                .then([self = CallbackPtr<CallbackType>(this)] () {
+                    self->pm.setValue();
                 })
-                .orElse([self = shared_from_this()] (Error&& er) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setError(std::move(er));
+                .orElse([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
+                    self->pm.setError(std::move(er));
                 });
         }
     }
@@ -262,6 +291,10 @@ template<typename T,
 struct CB<T, Future<UnpuckedResultType>, UnpuckedResultType, F> : public CallbackBase<T> {
     typedef CB<T, Future<UnpuckedResultType>, UnpuckedResultType, F> CallbackType;
 
+    /// References escape into the nested chain's continuations - keep this callback on the heap.
+    static constexpr bool kSelfReferential = true;
+
+
     Promise<UnpuckedResultType> pm;
     F cont;
 
@@ -273,11 +306,11 @@ struct CB<T, Future<UnpuckedResultType>, UnpuckedResultType, F> : public Callbac
             pm.setError(result.moveError());
         } else {
             cont(result.moveResult())
-                .then([self = this->shared_from_this()] (UnpuckedResultType&& rv) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setValue(std::move(rv));
+                .then([self = CallbackPtr<CallbackType>(this)] (UnpuckedResultType&& rv) {
+                    self->pm.setValue(std::move(rv));
                 })
-                .onError([self = this->shared_from_this()] (Error&& er) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setError(std::move(er));
+                .onError([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
+                    self->pm.setError(std::move(er));
                 });
         }
     }
@@ -291,6 +324,10 @@ template<typename T,
 struct CB<T, Future<void>, void, F> : public CallbackBase<T> {
     typedef CB<T, Future<void>, void, F> CallbackType;
 
+    /// References escape into the nested chain's continuations - keep this callback on the heap.
+    static constexpr bool kSelfReferential = true;
+
+
     Promise<void> pm;
     F cont;
 
@@ -302,11 +339,11 @@ struct CB<T, Future<void>, void, F> : public CallbackBase<T> {
             pm.setError(result.moveError());
         } else {
             cont(result.moveResult())
-                .then([self = this->shared_from_this()] () {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setValue();
+                .then([self = CallbackPtr<CallbackType>(this)] () {
+                    self->pm.setValue();
                 })
-                .onError([self = this->shared_from_this()] (Error&& er) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setError(std::move(er));
+                .onError([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
+                    self->pm.setError(std::move(er));
                 });
         }
     }
@@ -322,6 +359,10 @@ template<
 struct CB<void, Future<UnpuckedResultType>, UnpuckedResultType, F> : public CallbackBase<void> {
     typedef CB<void, Future<UnpuckedResultType>, UnpuckedResultType, F> CallbackType;
 
+    /// References escape into the nested chain's continuations - keep this callback on the heap.
+    static constexpr bool kSelfReferential = true;
+
+
     Promise<UnpuckedResultType> pm;
     F cont;
 
@@ -333,11 +374,11 @@ struct CB<void, Future<UnpuckedResultType>, UnpuckedResultType, F> : public Call
             pm.setError(result.moveError());
         } else {
             cont()
-                .then([self = this->shared_from_this()] (UnpuckedResultType&& rv){
-                    std::static_pointer_cast<CallbackType>(self)->pm.setValue(std::move(rv));
+                .then([self = CallbackPtr<CallbackType>(this)] (UnpuckedResultType&& rv){
+                    self->pm.setValue(std::move(rv));
                 })
-                .onError([self = this->shared_from_this()] (Error&& er) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setError(std::move(er));
+                .onError([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
+                    self->pm.setError(std::move(er));
                 });
         }
     }
@@ -351,6 +392,10 @@ template<typename F>
 struct CB<void, Future<void>, void, F> : public CallbackBase<void> {
     typedef CB<void, Future<void>, void, F> CallbackType;
 
+    /// References escape into the nested chain's continuations - keep this callback on the heap.
+    static constexpr bool kSelfReferential = true;
+
+
     Promise<void> pm;
     F cont;
 
@@ -362,11 +407,11 @@ struct CB<void, Future<void>, void, F> : public CallbackBase<void> {
             pm.setError(result.moveError());
         } else {
             cont()
-                .then([self = this->shared_from_this()] () {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setValue();
+                .then([self = CallbackPtr<CallbackType>(this)] () {
+                    self->pm.setValue();
                 })
-                .onError([self = this->shared_from_this()] (Error&& er) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setError(std::move(er));
+                .onError([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
+                    self->pm.setError(std::move(er));
                 });
         }
     }
@@ -489,11 +534,11 @@ struct ErrBack<FutureValueType, Result<UnpuckedResultType, Error>, UnpuckedResul
     void operator() (Result<FutureValueType, Error>&& result) override {
         if (result.isError()) {
             cont(result.moveError())
-                .then([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())]
+                .then([self = CallbackPtr<CallbackType>(this)]
                       (UnpuckedResultType&& rv) {
                     self->pm.setValue(std::move(rv));
                 })
-                .orElse([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] (Error&& er) {
+                .orElse([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
                     self->pm.setError(std::move(er));
                 });
         } else {
@@ -517,11 +562,11 @@ struct ErrBack<void, Result<UnpuckedResultType, Error>, UnpuckedResultType, F> :
     void operator() (Result<void, Error>&& result) override {
         if (result.isError()) {
             cont(result.moveError())
-                .then([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())]
+                .then([self = CallbackPtr<CallbackType>(this)]
                       (UnpuckedResultType&& rv) {
                     self->pm.setValue(std::move(rv));
                 })
-                .orElse([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] (Error&& er) {
+                .orElse([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
                     self->pm.setError(std::move(er));
                 });
         } else {
@@ -545,10 +590,10 @@ struct ErrBack<FutureValueType, Result<void, Error>, void, F> : public CallbackB
     void operator() (Result<FutureValueType, Error>&& result) override {
         if (result.isError()) {
             cont(result.moveError())
-                .then([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] () {
+                .then([self = CallbackPtr<CallbackType>(this)] () {
                     self->pm.setValue();
                 })
-                .orElse([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] (Error&& er) {
+                .orElse([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
                     self->pm.setError(std::move(er));
                 });
         } else {
@@ -572,11 +617,11 @@ struct ErrBack<void, Result<void, Error>, void, F> : public CallbackBase<void> {
     void operator() (Result<void, Error>&& result) override {
         if (result.isError()) {
             cont(result.moveError())
-                .then([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] () {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setValue();
+                .then([self = CallbackPtr<CallbackType>(this)] () {
+                    self->pm.setValue();
                 })
-                .orElse([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] (Error&& er) {
-                    std::static_pointer_cast<CallbackType>(self)->pm.setError(std::move(er));
+                .orElse([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
+                    self->pm.setError(std::move(er));
                 });
         } else {
             pm.setValue();
@@ -597,6 +642,10 @@ struct ErrBack<FutureValueType, Future<UnpuckedResultType>, UnpuckedResultType,
         public CallbackBase<FutureValueType> {
     using CallbackType = ErrBack<FutureValueType, Future<UnpuckedResultType>, UnpuckedResultType, F>;
 
+    /// References escape into the nested chain's continuations - keep this callback on the heap.
+    static constexpr bool kSelfReferential = true;
+
+
 
     Promise<UnpuckedResultType> pm;
     F cont;
@@ -607,11 +656,11 @@ struct ErrBack<FutureValueType, Future<UnpuckedResultType>, UnpuckedResultType,
     void operator() (Result<FutureValueType, Error>&& result) override {
         if (result.isError()) {
             cont(result.moveError())
-                .then([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())]
+                .then([self = CallbackPtr<CallbackType>(this)]
                       (UnpuckedResultType&& rv) {
                     self->pm.setValue(std::move(rv));
                 })
-                .onError([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] (Error&& er) {
+                .onError([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
                     self->pm.setError(std::move(er));
                 });
         } else {
@@ -626,6 +675,10 @@ template<
 struct ErrBack<void, Future<UnpuckedResultType>, UnpuckedResultType, F> : public CallbackBase<void> {
     using CallbackType = ErrBack<void, Future<UnpuckedResultType>, UnpuckedResultType, F>;
 
+    /// References escape into the nested chain's continuations - keep this callback on the heap.
+    static constexpr bool kSelfReferential = true;
+
+
     Promise<UnpuckedResultType> pm;
     F cont;
 
@@ -635,11 +688,11 @@ struct ErrBack<void, Future<UnpuckedResultType>, UnpuckedResultType, F> : public
     void operator() (Result<void, Error>&& result) override {
         if (result.isError()) {
             cont(result.moveError())
-                .then([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())]
+                .then([self = CallbackPtr<CallbackType>(this)]
                       (UnpuckedResultType&& rv) {
                     self->pm.setValue(std::move(rv));
                 })
-                .onError([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] (Error&& er) {
+                .onError([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
                     self->pm.setError(std::move(er));
                 });
         } else {
@@ -653,6 +706,10 @@ template<typename FutureValueType,
 struct ErrBack<FutureValueType, Future<void>, void, F> : public CallbackBase<FutureValueType> {
     using CallbackType = ErrBack<FutureValueType, Future<void>, void, F>;
 
+    /// References escape into the nested chain's continuations - keep this callback on the heap.
+    static constexpr bool kSelfReferential = true;
+
+
     Promise<void> pm;
     F cont;
 
@@ -662,10 +719,10 @@ struct ErrBack<FutureValueType, Future<void>, void, F> : public CallbackBase<Fut
     void operator() (Result<FutureValueType, Error>&& result) override {
         if (result.isError()) {
             cont(result.moveError())
-                .then([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] () {
+                .then([self = CallbackPtr<CallbackType>(this)] () {
                     self->pm.setValue();
                 })
-                .onError([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] (Error&& er) {
+                .onError([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
                     self->pm.setError(std::move(er));
                 });
         } else {
@@ -679,6 +736,10 @@ template<
 struct ErrBack<void, Future<void>, void, F> : public CallbackBase<void> {
     using CallbackType = ErrBack<void, Future<void>, void, F>;
 
+    /// References escape into the nested chain's continuations - keep this callback on the heap.
+    static constexpr bool kSelfReferential = true;
+
+
     Promise<void> pm;
     F cont;
 
@@ -688,10 +749,10 @@ struct ErrBack<void, Future<void>, void, F> : public CallbackBase<void> {
     void operator() (Result<void, Error>&& result) override {
         if (result.isError()) {
             cont(result.moveError())
-                .then([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] () {
+                .then([self = CallbackPtr<CallbackType>(this)] () {
                     self->pm.setValue();
                 })
-                .onError([self = std::static_pointer_cast<CallbackType>(this->shared_from_this())] (Error&& er) {
+                .onError([self = CallbackPtr<CallbackType>(this)] (Error&& er) {
                     self->pm.setError(std::move(er));
                 });
         } else {
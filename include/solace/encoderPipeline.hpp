@@ -0,0 +1,146 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Encoder stage pipeline
+ *	@file		solace/encoderPipeline.hpp
+ *	@brief		Chained Encoder stages with recycled intermediate buffers
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_ENCODERPIPELINE_HPP
+#define SOLACE_ENCODERPIPELINE_HPP
+
+#include "solace/encoder.hpp"
+#include "solace/memoryManager.hpp"
+
+#include <memory>   // std::unique_ptr
+#include <vector>
+
+
+namespace Solace {
+
+/**
+ * A pipeline of Encoder stages behind the Encoder contract itself.
+ *
+ * Composing transforms by hand - compress, then base64, then frame - means a
+ * full intermediate ByteBuffer per stage, sized for the whole payload. The
+ * pipeline instead propagates chunk at a time: a chunk of the source runs
+ * through every stage while it is still cache-hot, and each stage writes
+ * into a small intermediate buffer that is rewound and reused for the next
+ * chunk. Peak memory is stages x chunk-size instead of stages x payload;
+ * intermediates grow only if a stage's own worst case for one chunk demands
+ * it, and are drawn from the given memory manager, not the heap.
+ *
+ * Each chunk is transformed independently, so a chunk boundary is a unit
+ * boundary in the output of every stage: the matching decode must walk the
+ * same units back (frames, in the example above). Stages that pad partial
+ * groups - base64 - need a chunk size that is a multiple of their group for
+ * the concatenation to decode as one stream; the default chunk size divides
+ * by three for exactly that reason.
+ *
+ * @code{.cpp}
+ * EncoderPipeline pipeline(dest, memoryManager);
+ * pipeline.then<Lz4Encoder>()
+ *         .then<Base64Encoder>()
+ *         .then<FrameEncoder>();
+ * pipeline.encode(payload);
+ * @endcode
+ */
+class EncoderPipeline : public Encoder {
+public:
+    using Encoder::size_type;
+
+    /** Pipeline tuning knobs. */
+    struct Options {
+        //!< Source bytes fed through the stages per round. A multiple of 3
+        //!< so base64 stages emit no mid-stream padding.
+        size_type chunkSize {48 * 1024};
+    };
+
+public:
+
+    /**
+     * Construct an empty pipeline; add stages with then().
+     *
+     * @param dest Destination buffer the final stage's output lands in.
+     * @param allocator Memory manager intermediate buffers are drawn from.
+     *  Must outlive the pipeline.
+     * @param options Pipeline tuning knobs. @see Options
+     */
+    EncoderPipeline(WriteBuffer& dest, MemoryManager& allocator, Options options) :
+        Encoder(dest),
+        _allocator(&allocator),
+        _options(options)
+    {}
+
+    /** Construct an empty pipeline with default Options. */
+    EncoderPipeline(WriteBuffer& dest, MemoryManager& allocator) :
+        EncoderPipeline(dest, allocator, Options{})
+    {}
+
+    /**
+     * Append a transform stage, constructed bound to the pipeline's
+     * intermediate plumbing. Stages run in the order they are added.
+     *
+     * @param args Constructor arguments of the stage beyond its destination
+     *  buffer, which the pipeline supplies.
+     * @return Reference to this for chaining.
+     */
+    template<typename E, typename... Args>
+    EncoderPipeline& then(Args&&... args) {
+        auto out = std::make_unique<WriteBuffer>();
+        auto stage = std::make_unique<E>(*out, std::forward<Args>(args)...);
+
+        _stages.emplace_back(Stage{std::move(stage), std::move(out)});
+
+        return *this;
+    }
+
+    /** Number of stages added so far. */
+    size_type nbStages() const noexcept {
+        return _stages.size();
+    }
+
+    /** Worst-case output size for the given input across all stages. */
+    size_type encodedSize(ImmutableMemoryView const& data) const override;
+
+    using Encoder::encode;
+
+    /**
+     * Run the source through every stage, chunk at a time.
+     * An empty source still makes one round, so stages that frame their
+     * input emit their unit for it.
+     */
+    Result<void, Error>
+    encode(ImmutableMemoryView const& src) override;
+
+private:
+
+    /** One transform and the recycled buffer it writes into. */
+    struct Stage {
+        std::unique_ptr<Encoder>        encoder;
+        std::unique_ptr<WriteBuffer>    out;
+    };
+
+    /** Output size of one source chunk of the given length, all stages applied. */
+    size_type chunkEncodedSize(ImmutableMemoryView const& data, size_type chunkLen) const;
+
+    MemoryManager*      _allocator;
+    Options             _options;
+    std::vector<Stage>  _stages;
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_ENCODERPIPELINE_HPP
@@ -106,5 +106,104 @@ inline void swap(Error& lhs, Error& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+
+/**
+ * A domain of error codes: gives the codes of one subsystem their meaning.
+ *
+ * Domains are expected to be static singletons - an ErrorCode refers to its
+ * domain by pointer and never owns it. Rendering of a human-readable message
+ * lives here, so that errors which are only ever tested and discarded never
+ * pay for their description.
+ */
+class ErrorDomain {
+public:
+
+    virtual ~ErrorDomain();
+
+    ErrorDomain() noexcept = default;
+
+    ErrorDomain(ErrorDomain const&) = delete;
+    ErrorDomain& operator= (ErrorDomain const&) = delete;
+
+    /** Get a short name of this domain, eg. "system". */
+    virtual StringView name() const noexcept = 0;
+
+    /**
+     * Render the description of a code of this domain.
+     * Called only when an error is actually displayed.
+     */
+    virtual StringView message(int code) const noexcept = 0;
+};
+
+
+/**
+ * A lightweight error value for hot paths: a plain code plus a pointer to
+ * its (statically registered) domain.
+ *
+ * Unlike Error it carries no message string - copying one is two words and
+ * allocates nothing, so it suits the E of a Result returned millions of
+ * times a second with expected, would-block style failures. The message is
+ * rendered lazily by the domain when toString() is called; toError() bridges
+ * to the heavyweight Error where an interface requires one.
+ */
+class ErrorCode {
+public:
+
+    ~ErrorCode() noexcept = default;
+
+    /** Construct a non-error value of no domain. */
+    constexpr ErrorCode() noexcept = default;
+
+    constexpr ErrorCode(ErrorDomain const& domain, int code) noexcept :
+        _code(code),
+        _domain(&domain)
+    {}
+
+    ErrorCode(ErrorCode const& rhs) noexcept = default;
+    ErrorCode& operator= (ErrorCode const& rhs) noexcept = default;
+
+    int value() const noexcept {
+        return _code;
+    }
+
+    ErrorDomain const* domain() const noexcept {
+        return _domain;
+    }
+
+    bool operator== (ErrorCode const& rhs) const noexcept {
+        return (_domain == rhs._domain) && (_code == rhs._code);
+    }
+
+    bool operator!= (ErrorCode const& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+    explicit operator bool () const noexcept {
+        return (_code != 0);
+    }
+
+    //! Get message description of the error, rendered by its domain.
+    StringView toString() const noexcept {
+        return _domain ? _domain->message(_code) : StringView{};
+    }
+
+    //! Convert into a message-carrying Error for interfaces that need one.
+    Error toError() const {
+        return Error(toString(), _code);
+    }
+
+private:
+
+    int                 _code {0};
+    ErrorDomain const*  _domain {nullptr};
+};
+
+
+/** The domain of operating system errno values. */
+ErrorDomain const& systemErrorDomain() noexcept;
+
+/** Make an ErrorCode of the system domain from an errno value. */
+ErrorCode systemError(int errnoCode) noexcept;
+
 }  // End of namespace Solace
 #endif  // SOLACE_ERROR_HPP_
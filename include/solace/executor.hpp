@@ -0,0 +1,134 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Executor abstraction for scheduling units of work
+ *	@file		solace/executor.hpp
+ *	@brief		Where and when submitted tasks run: inline or on a thread pool
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_EXECUTOR_HPP
+#define SOLACE_EXECUTOR_HPP
+
+#include "solace/types.hpp"
+#include "solace/delegate.hpp"
+#include "solace/mpmcQueue.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Solace {
+
+/**
+ * A place where submitted units of work get executed.
+ * Consumers hand an executor to asynchronous APIs - most notably
+ * Future::then(executor, f) - to control which thread a continuation runs on,
+ * instead of having it run inline on whatever thread completed the promise.
+ */
+class Executor {
+public:
+    /** A unit of work. delegate handles move-only closures, unlike std::function. */
+    using Task = delegate<void()>;
+
+public:
+
+    virtual ~Executor();
+
+    /**
+     * Submit a unit of work for execution.
+     * When and on what thread it runs is up to the concrete executor.
+     *
+     * @param task A unit of work to execute.
+     */
+    virtual void submit(Task task) = 0;
+};
+
+
+/**
+ * An executor running every task immediately on the submitting thread.
+ * This is the behaviour of plain Future::then(f) given an executor shape,
+ * useful as a default and in tests.
+ */
+class InlineExecutor : public Executor {
+public:
+
+    void submit(Task task) override {
+        task();
+    }
+};
+
+
+/**
+ * An executor running tasks on a pool of worker threads.
+ * Each worker owns a bounded lock-free queue; submissions are spread over the
+ * queues round-robin and an idle worker steals from its siblings before going
+ * to sleep, so a burst of continuations fans out across cores instead of
+ * serializing behind one queue. If every queue is full the submitting thread
+ * runs the task itself, which bounds memory and provides natural backpressure.
+ *
+ * The pool drains all queued tasks before the destructor returns.
+ */
+class ThreadPoolExecutor : public Executor {
+public:
+
+    ~ThreadPoolExecutor() override;
+
+    ThreadPoolExecutor(const ThreadPoolExecutor&) = delete;
+    ThreadPoolExecutor& operator= (const ThreadPoolExecutor&) = delete;
+
+    /** Construct a pool with the given number of workers.
+     * @param nbWorkers Number of worker threads, 0 for the hardware thread count.
+     */
+    explicit ThreadPoolExecutor(uint32 nbWorkers = 0);
+
+    void submit(Task task) override;
+
+    /** Number of worker threads in the pool. */
+    uint32 workerCount() const noexcept {
+        return static_cast<uint32>(_threads.size());
+    }
+
+protected:
+
+    void workerLoop(uint32 home);
+
+    /** Run one task from the home queue or steal one from a sibling.
+     * @return True if a task was executed.
+     */
+    bool runOne(uint32 home);
+
+private:
+
+    /// Queued tasks per worker before submit falls back to running inline.
+    static constexpr MpmcQueue<Task>::size_type kQueueCapacity = 1024;
+
+    std::vector<std::unique_ptr<MpmcQueue<Task>>>   _queues;
+    std::vector<std::thread>                        _threads;
+
+    std::atomic<uint64> _submitIndex {0};
+    std::atomic<uint64> _pending {0};
+    std::atomic<bool>   _stopping {false};
+
+    std::mutex              _wakeLock;
+    std::condition_variable _wake;
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_EXECUTOR_HPP
@@ -0,0 +1,380 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Sorted inline small map
+ *	@file		solace/flatMap.hpp
+ *	@brief		Fixed capacity associative array with inline sorted storage
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_FLATMAP_HPP
+#define SOLACE_FLATMAP_HPP
+
+#include "solace/types.hpp"
+#include "solace/assert.hpp"
+
+#include <initializer_list>
+#include <new>          // placement new
+#include <type_traits>  // std::aligned_storage
+#include <utility>      // std::move, std::forward
+
+
+namespace Solace {
+
+namespace details {
+
+/** Key ordering for FlatMap preferring a member compareTo() when the key has
+ * one, so String keys order against a StringView probe without constructing
+ * a String per comparison. */
+template<typename K, typename L>
+constexpr auto keyLt(K const& key, L const& lookup, int) noexcept -> decltype(key.compareTo(lookup) < 0) {
+    return key.compareTo(lookup) < 0;
+}
+
+template<typename K, typename L>
+constexpr auto keyLt(K const& key, L const& lookup, long) noexcept -> decltype(key < lookup) {
+    return (key < lookup);
+}
+
+template<typename K, typename L>
+constexpr bool keyLess(K const& key, L const& lookup) noexcept {
+    return keyLt(key, lookup, 0);
+}
+
+}  // namespace details
+
+
+/** A sorted associative array of up to N entries stored inline aka FlatMap.
+ * The small-key companion of HashMap: for the dozen-entry maps of a CLI
+ * parser or a per-message header table, a sorted inline array beats any hash -
+ * no allocation to create or destroy the map, no hashing per probe, and every
+ * lookup walks contiguous keys. The capacity is part of the type and
+ * exceeding it is a usage error, as with StaticVector.
+ *
+ * The probe strategy is chosen by capacity at compile time: small maps scan
+ * the keys linearly, which the branch predictor likes, larger ones binary
+ * search. Keys are ordered through compareTo() when available and operator<
+ * otherwise, and lookups accept any probe type comparable with the key -
+ * e.g. a StringView probing String keys.
+ *
+ * Keys and values live in two parallel inline arrays, so probing only ever
+ * touches key storage.
+ *
+ * References and pointers into the map are invalidated by any mutating call.
+ */
+template<typename K, typename V, uint32 N>
+class FlatMap {
+public:
+    using key_type = K;
+    using value_type = V;
+    using size_type = uint32;
+
+    //!< Capacity up to which a linear scan beats binary search.
+    static constexpr size_type kLinearProbeLimit = 16;
+    static constexpr bool kLinearProbe = (N <= kLinearProbeLimit);
+
+public:
+
+    ~FlatMap() {
+        clear();
+    }
+
+    /** Construct an empty map. */
+    FlatMap() noexcept = default;
+
+    /** Construct a new map by moving entries out of a given one. */
+    FlatMap(FlatMap&& other) noexcept(std::is_nothrow_move_constructible<K>::value &&
+                                      std::is_nothrow_move_constructible<V>::value) {
+        for (size_type i = 0; i < other._size; ++i) {
+            new (keys() + i) K(std::move(other.keys()[i]));
+            new (values() + i) V(std::move(other.values()[i]));
+        }
+
+        _size = other._size;
+        other.clear();
+    }
+
+    /** Construct a new map to be a copy of a given one. */
+    FlatMap(const FlatMap& other) {
+        for (size_type i = 0; i < other._size; ++i) {
+            new (keys() + i) K(other.keys()[i]);
+            new (values() + i) V(other.values()[i]);
+        }
+
+        _size = other._size;
+    }
+
+    /** Construct a map from an initialized list of key-value pairs. */
+    FlatMap(std::initializer_list<std::pair<K, V>> list) {
+        for (auto& entry : list) {
+            put(entry.first, entry.second);
+        }
+    }
+
+    FlatMap& operator= (const FlatMap& rhs) {
+        if (&rhs != this) {
+            FlatMap tmp(rhs);
+            swapWith(tmp);
+        }
+
+        return *this;
+    }
+
+    FlatMap& operator= (FlatMap&& rhs) noexcept(std::is_nothrow_move_constructible<K>::value &&
+                                                std::is_nothrow_move_constructible<V>::value) {
+        if (&rhs != this) {
+            clear();
+            for (size_type i = 0; i < rhs._size; ++i) {
+                new (keys() + i) K(std::move(rhs.keys()[i]));
+                new (values() + i) V(std::move(rhs.values()[i]));
+            }
+
+            _size = rhs._size;
+            rhs.clear();
+        }
+
+        return *this;
+    }
+
+    /**
+     * Check if this map is empty.
+     * @return True is this is an empty map.
+     */
+    bool empty() const noexcept {
+        return (_size == 0);
+    }
+
+    /**
+     * Check if this map is filled to capacity.
+     * @return True if no more entries can be added.
+     */
+    bool full() const noexcept {
+        return (_size == N);
+    }
+
+    /**
+     * Get the number of entries in this map.
+     * @return Number of key-value associations.
+     */
+    size_type size() const noexcept {
+        return _size;
+    }
+
+    /**
+     * Get the maximum number of entries this map can hold.
+     * @return The fixed capacity baked into the type.
+     */
+    static constexpr size_type capacity() noexcept {
+        return N;
+    }
+
+    /**
+     * Associate a value with a key, replacing any previous association.
+     * @param key A key to store the value under.
+     * @param value A value to store.
+     * @return A reference to the stored value.
+     * @throws IndexOutOfRangeException if the key is new and the map is full.
+     */
+    V& put(K key, V value) {
+        const auto slot = lowerBound(key);
+        if (slot < _size && !details::keyLess(key, keys()[slot])) {
+            values()[slot] = std::move(value);
+
+            return values()[slot];
+        }
+
+        assertIndexInRange(_size, 0, N, "FlatMap::put()");
+
+        // Shift entries up one slot to keep the keys sorted:
+        for (size_type i = _size; i > slot; --i) {
+            new (keys() + i) K(std::move(keys()[i - 1]));
+            keys()[i - 1].~K();
+            new (values() + i) V(std::move(values()[i - 1]));
+            values()[i - 1].~V();
+        }
+
+        new (keys() + slot) K(std::move(key));
+        auto* stored = new (values() + slot) V(std::move(value));
+        _size += 1;
+
+        return *stored;
+    }
+
+    /**
+     * Find the value associated with a key.
+     * The probe may be any type ordered against the key type, such as a
+     * StringView probing a map keyed by String.
+     *
+     * @param key A key to look up.
+     * @return A pointer to the stored value or nullptr if the key is not in
+     * the map. The pointer is valid until the next mutating call.
+     */
+    template<typename Lookup>
+    V* find(Lookup const& key) noexcept {
+        const auto slot = lowerBound(key);
+
+        return (slot < _size && !details::keyLess(key, keys()[slot]))
+                ? values() + slot
+                : nullptr;
+    }
+
+    template<typename Lookup>
+    const V* find(Lookup const& key) const noexcept {
+        return const_cast<FlatMap*>(this)->find(key);
+    }
+
+    /**
+     * Check if a key is present in the map.
+     * @param key A key to look up.
+     * @return True if a value is associated with the key.
+     */
+    template<typename Lookup>
+    bool contains(Lookup const& key) const noexcept {
+        return (find(key) != nullptr);
+    }
+
+    /**
+     * Remove a key and its associated value from the map.
+     * @param key A key to remove.
+     * @return True if the key was present.
+     */
+    template<typename Lookup>
+    bool remove(Lookup const& key) noexcept {
+        const auto slot = lowerBound(key);
+        if (slot >= _size || details::keyLess(key, keys()[slot])) {
+            return false;
+        }
+
+        // Shift the tail down one slot over the removed entry:
+        for (size_type i = slot; i + 1 < _size; ++i) {
+            keys()[i] = std::move(keys()[i + 1]);
+            values()[i] = std::move(values()[i + 1]);
+        }
+
+        _size -= 1;
+        keys()[_size].~K();
+        values()[_size].~V();
+
+        return true;
+    }
+
+    /** Remove all entries. */
+    void clear() noexcept {
+        while (_size > 0) {
+            _size -= 1;
+            keys()[_size].~K();
+            values()[_size].~V();
+        }
+    }
+
+    /*
+     *--------------------------------------------------------------------------
+     * Functional methods that operates on the collection without changing it.
+     *--------------------------------------------------------------------------
+     */
+
+    /** Apply a function to every association in key order, invoked as f(key, value). */
+    template<typename F>
+    const FlatMap& forEach(F&& f) {
+        for (size_type i = 0; i < _size; ++i) {
+            f(static_cast<K const&>(keys()[i]), values()[i]);
+        }
+
+        return *this;
+    }
+
+    template<typename F>
+    const FlatMap& forEach(F&& f) const {
+        for (size_type i = 0; i < _size; ++i) {
+            f(static_cast<K const&>(keys()[i]), static_cast<V const&>(values()[i]));
+        }
+
+        return *this;
+    }
+
+protected:
+
+    /** Index of the first key not ordering before the probe, a-la std::lower_bound.
+     * Linear or binary, as baked in by kLinearProbe.
+     */
+    template<typename Lookup>
+    size_type lowerBound(Lookup const& key) const noexcept {
+        if (kLinearProbe) {
+            size_type i = 0;
+            while (i < _size && details::keyLess(keys()[i], key)) {
+                i += 1;
+            }
+
+            return i;
+        }
+
+        size_type lo = 0;
+        size_type hi = _size;
+        while (lo < hi) {
+            const auto mid = lo + (hi - lo) / 2;
+            if (details::keyLess(keys()[mid], key)) {
+                lo = mid + 1;
+            } else {
+                hi = mid;
+            }
+        }
+
+        return lo;
+    }
+
+    K* keys() noexcept {
+        return reinterpret_cast<K*>(_keys);
+    }
+
+    const K* keys() const noexcept {
+        return reinterpret_cast<const K*>(_keys);
+    }
+
+    V* values() noexcept {
+        return reinterpret_cast<V*>(_values);
+    }
+
+    const V* values() const noexcept {
+        return reinterpret_cast<const V*>(_values);
+    }
+
+    void swapWith(FlatMap& rhs) noexcept(std::is_nothrow_move_constructible<K>::value &&
+                                         std::is_nothrow_move_constructible<V>::value) {
+        FlatMap tmp(std::move(rhs));
+        rhs = std::move(*this);
+        *this = std::move(tmp);
+    }
+
+private:
+
+    /// Uninitialized inline storage: keys apart from values, so probing only
+    /// ever pulls key cache lines.
+    typename std::aligned_storage<sizeof(K), alignof(K)>::type _keys[N];
+    typename std::aligned_storage<sizeof(V), alignof(V)>::type _values[N];
+
+    size_type _size {0};
+};
+
+
+template<typename K, typename V, uint32 N>
+void swap(FlatMap<K, V, N>& lhs, FlatMap<K, V, N>& rhs) noexcept(std::is_nothrow_move_constructible<K>::value &&
+                                                                 std::is_nothrow_move_constructible<V>::value) {
+    FlatMap<K, V, N> tmp(std::move(rhs));
+    rhs = std::move(lhs);
+    lhs = std::move(tmp);
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_FLATMAP_HPP
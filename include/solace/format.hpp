@@ -0,0 +1,158 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Type-safe string formatting
+ *	@file		solace/format.hpp
+ *	@brief		'{}'-style formatting into a StringBuilder
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_FORMAT_HPP
+#define SOLACE_FORMAT_HPP
+
+#include "solace/stringBuilder.hpp"
+
+
+namespace Solace {
+
+namespace details {
+
+/**
+ * A type-erased reference to one format argument. Construction picks the
+ * rendering route at compile time - integers and floats go through the
+ * StringBuilder fast paths, strings are appended as-is - so the formatting
+ * core is a single non-template function shared by every call site.
+ */
+struct FormatArg {
+    enum class Tag : byte {
+        Int,        //!< Signed integers, rendered through append(int64).
+        UInt,       //!< Unsigned integers, rendered through append(uint64).
+        Float,      //!< float32/float64, shortest round-trip representation.
+        Bool,       //!< "true" / "false".
+        Character,  //!< A single char.
+        Str         //!< String-ish things, referenced - not copied.
+    };
+
+    constexpr FormatArg(bool v) noexcept       : tag(Tag::Bool), b(v) {}
+    constexpr FormatArg(char v) noexcept       : tag(Tag::Character), c(v) {}
+    constexpr FormatArg(int8 v) noexcept       : tag(Tag::Int), i(v) {}
+    constexpr FormatArg(int16 v) noexcept      : tag(Tag::Int), i(v) {}
+    constexpr FormatArg(int32 v) noexcept      : tag(Tag::Int), i(v) {}
+    constexpr FormatArg(int64 v) noexcept      : tag(Tag::Int), i(v) {}
+    constexpr FormatArg(uint8 v) noexcept      : tag(Tag::UInt), u(v) {}
+    constexpr FormatArg(uint16 v) noexcept     : tag(Tag::UInt), u(v) {}
+    constexpr FormatArg(uint32 v) noexcept     : tag(Tag::UInt), u(v) {}
+    constexpr FormatArg(uint64 v) noexcept     : tag(Tag::UInt), u(v) {}
+    constexpr FormatArg(float32 v) noexcept    : tag(Tag::Float), f(v) {}
+    constexpr FormatArg(float64 v) noexcept    : tag(Tag::Float), f(v) {}
+    constexpr FormatArg(StringView v) noexcept : tag(Tag::Str), i(0), s(v) {}
+    FormatArg(String const& v) noexcept        : tag(Tag::Str), s(v.view()) {}
+    FormatArg(const char* v) noexcept          : tag(Tag::Str), s(v) {}
+
+    Tag tag;
+    union {
+        int64       i;
+        uint64      u;
+        float64     f;
+        bool        b;
+        char        c;
+    };
+    StringView s;
+};
+
+
+/**
+ * The formatting core: appends fmt to dest with each '{}' replaced by the
+ * next argument. '{{' and '}}' are literal braces. Literal runs between
+ * placeholders are appended in one write each.
+ *
+ * @throws IllegalArgumentException when fmt is malformed or the number of
+ * placeholders does not match nbArgs.
+ */
+StringBuilder& formatTo(StringBuilder& dest, StringView fmt,
+                        FormatArg const* args, uint32 nbArgs);
+
+
+/**
+ * Count the '{}' placeholders in a format string, honouring '{{' / '}}'
+ * escapes. Constexpr so a literal format string is checked at compile time:
+ * @see SOLACE_ASSERT_FORMAT
+ *
+ * @return The number of placeholders, or -1 when the string is malformed -
+ * a stray or unbalanced brace.
+ */
+constexpr int32 formatArgCount(const char* fmt) noexcept {
+    int32 count = 0;
+    for (size_t i = 0; fmt[i] != '\0'; ++i) {
+        if (fmt[i] == '{') {
+            if (fmt[i + 1] == '{') {
+                ++i;
+            } else if (fmt[i + 1] == '}') {
+                ++count;
+                ++i;
+            } else {
+                return -1;
+            }
+        } else if (fmt[i] == '}') {
+            if (fmt[i + 1] != '}') {
+                return -1;
+            }
+            ++i;
+        }
+    }
+
+    return count;
+}
+
+}  // namespace details
+
+
+/**
+ * Statically check a literal format string against its argument count.
+ * Placed next to the format() call it turns a typo in the format string
+ * into a compile error instead of a runtime exception:
+ * @code
+ *   SOLACE_ASSERT_FORMAT("rate={} of {}", 2);
+ *   format(out, "rate={} of {}", seen, total);
+ * @endcode
+ */
+#define SOLACE_ASSERT_FORMAT(fmt, nbArgs) \
+    static_assert(Solace::details::formatArgCount(fmt) == (nbArgs), \
+                  "Format string does not match its arguments")
+
+
+/**
+ * Append the format string to dest with each '{}' replaced by the matching
+ * argument, rendered by type: integers and floats through the StringBuilder
+ * append() fast paths, strings in a single write, bool as "true"/"false".
+ * '{{' and '}}' produce literal braces.
+ *
+ * @return Reference to dest for fluency.
+ * @throws IllegalArgumentException when fmt is malformed or the number of
+ * placeholders does not match the number of arguments.
+ */
+template<typename... Args>
+StringBuilder& format(StringBuilder& dest, StringView fmt, Args&&... args) {
+    details::FormatArg const argv[] = {details::FormatArg(args)...};
+
+    return details::formatTo(dest, fmt, argv, sizeof...(Args));
+}
+
+inline StringBuilder& format(StringBuilder& dest, StringView fmt) {
+    return details::formatTo(dest, fmt, nullptr, 0);
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_FORMAT_HPP
@@ -42,8 +42,15 @@ public:
 
     virtual ~Application();
 
-    Application(const Version& version) : _version(version)
-    {}
+    /**
+     * Construct an application instance.
+     * Also fixes the process-wide hash seed (@see hashSeed()), so every
+     * seeded hash table built afterwards - during init() and beyond - is
+     * keyed before any untrusted input is seen.
+     *
+     * @param version Run-time version of the application.
+     */
+    Application(const Version& version);
 
 
     /**
@@ -0,0 +1,192 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Reactor event-loop driver
+ *	@file		solace/framework/eventLoop.hpp
+ *	@brief		Owns the Selector, timer wheel and cross-thread post queue
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_FRAMEWORK_EVENTLOOP_HPP
+#define SOLACE_FRAMEWORK_EVENTLOOP_HPP
+
+#include "solace/delegate.hpp"
+#include "solace/result.hpp"
+#include "solace/error.hpp"
+#include "solace/io/selector.hpp"
+#include "solace/io/timerWheel.hpp"
+#include "solace/io/eventFd.hpp"
+
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+namespace Solace { namespace Framework {
+
+/**
+ * The main loop every service has been hand-rolling around Selector::poll,
+ * written once: an EventLoop owns the Selector, a TimerWheel and an
+ * eventfd-backed cross-thread post queue, and run() drives them with the
+ * batched dispatch a reactor wants - one pollInto() per iteration, the
+ * whole event batch delivered through one delegate, timers drained in bulk.
+ *
+ * Deadline handling costs the loop nothing per iteration: the wheel's
+ * timerfd is registered with the Selector, so the kernel clamps the poll to
+ * the next tick with a pending timer and the loop itself never reads the
+ * clock. Timer expirations arrive through the same handler as fd readiness,
+ * as the synthetic events TimerWheel::expire() produces: the wheel's fd,
+ * the Read flag and the pointer given to schedule().
+ *
+ * Any thread hands work to the loop with post(); the closure runs on the
+ * loop thread before the next poll. An optional idle handler runs whenever
+ * a poll times out with nothing ready, bounded by Options::idlePollMs.
+ *
+ * @code{.cpp}
+ * EventLoop loop(Selector::createEPoll(128));
+ * loop.selector().add(&socket, Selector::Events::Read);
+ * loop.timers().schedule(30000, &connection);     // Idle timeout
+ * ...
+ * loop.run(EventLoop::EventHandler([&](Selector::Event const& event) {
+ *     if (event.fd == loop.timers().getSelectId()) {
+ *         static_cast<Connection*>(event.data)->onIdleTimeout();
+ *     } else {
+ *         dispatch(event);
+ *     }
+ * }));
+ * @endcode
+ *
+ * run() blocks the calling thread until stop() is called; both stop() and
+ * post() are safe from any thread, everything else belongs to the loop
+ * thread.
+ */
+class EventLoop {
+public:
+
+    using size_type = IO::Selector::size_type;
+
+    /** Invoked for every ready event, fd readiness and timer expiry alike. */
+    using EventHandler = delegate<void(IO::Selector::Event const&)>;
+
+    /** A closure handed to the loop thread. delegate handles move-only closures. */
+    using Task = delegate<void()>;
+
+    //!< Events dispatched per poll; timers are drained in batches of the same size.
+    static constexpr size_type kEventBatch = 64;
+
+    /** Loop configuration. */
+    struct Options {
+        //!< Granularity of the timer wheel, in milliseconds.
+        uint32      tickDurationMs {10};
+
+        //!< Longest a poll may block when an idle handler is set, in
+        //!< milliseconds. Without an idle handler polls block until an
+        //!< event or timer arrives.
+        int32       idlePollMs {100};
+    };
+
+public:
+
+    ~EventLoop() = default;
+
+    EventLoop(const EventLoop&) = delete;
+    EventLoop& operator= (const EventLoop&) = delete;
+
+    /**
+     * Construct a loop around the given selector.
+     * The wheel's timerfd and the post-queue eventfd are registered with
+     * the selector here; everything else the caller adds itself.
+     *
+     * @param selector Selector the loop polls. Consumed.
+     * @param options Loop configuration. @see Options
+     */
+    EventLoop(IO::Selector&& selector, Options options);
+
+    /** @see EventLoop(IO::Selector&&, Options) - with default configuration. */
+    explicit EventLoop(IO::Selector&& selector) :
+        EventLoop(std::move(selector), Options{})
+    {}
+
+    /** The selector the loop polls; register connections here. */
+    IO::Selector& selector() noexcept {
+        return _selector;
+    }
+
+    /** The loop's timer wheel; schedule deadlines here. */
+    IO::TimerWheel& timers() noexcept {
+        return _timers;
+    }
+
+    /**
+     * Hand a closure to the loop thread. Safe from any thread.
+     * The closure runs on the loop thread before its next poll, in post
+     * order. Posting to a stopped loop queues the task for the next run().
+     *
+     * @param task Closure to run on the loop thread.
+     */
+    void post(Task&& task);
+
+    /**
+     * Install the handler run when a poll times out with nothing ready.
+     * Belongs to the loop thread; intended for background maintenance that
+     * should never compete with traffic.
+     *
+     * @param onIdle Idle-work delegate, or an empty one to remove it.
+     */
+    void setIdleHandler(Task&& onIdle) {
+        _onIdle = std::move(onIdle);
+    }
+
+    /**
+     * Drive the loop until stop() is called. Blocks the calling thread.
+     *
+     * @param handler Delegate receiving every ready event.
+     * @return Ok once stopped, or an error if the loop is already running.
+     */
+    Result<void, Error> run(EventHandler&& handler);
+
+    /**
+     * Ask the loop to return from run(). Safe from any thread.
+     * Tasks already posted still run before run() returns.
+     */
+    void stop();
+
+    /** Check if run() is currently driving the loop. */
+    bool isRunning() const noexcept {
+        return _running.load(std::memory_order_relaxed);
+    }
+
+private:
+
+    void drainPosted();
+
+    IO::Selector        _selector;
+    IO::TimerWheel      _timers;
+    IO::EventFd         _wakeup;
+
+    Task                _onIdle;
+    Options             _options;
+
+    std::atomic<bool>   _running {false};
+    std::atomic<bool>   _keepRunning {false};
+
+    std::mutex          _postLock;
+    std::vector<Task>   _posted;
+    std::vector<Task>   _draining;  //!< Swapped with _posted so tasks run unlocked.
+};
+
+}  // End of namespace Framework
+}  // End of namespace Solace
+#endif  // SOLACE_FRAMEWORK_EVENTLOOP_HPP
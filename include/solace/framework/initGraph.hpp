@@ -0,0 +1,143 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Dependency-ordered subsystem initialization
+ *	@file		solace/framework/initGraph.hpp
+ *	@brief		Phased bring-up of application subsystems
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_FRAMEWORK_INITGRAPH_HPP
+#define SOLACE_FRAMEWORK_INITGRAPH_HPP
+
+#include "solace/stringView.hpp"
+#include "solace/result.hpp"
+#include "solace/error.hpp"
+#include "solace/optional.hpp"
+#include "solace/executor.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace Solace { namespace Framework {
+
+/**
+ * A dependency-ordered initialization plan for application subsystems.
+ *
+ * Application::init traditionally brings every subsystem up eagerly and in
+ * sequence. An InitGraph instead records each subsystem by name, together
+ * with the names of the subsystems it depends on and an action that brings
+ * it up. Nothing runs at registration time:
+ *
+ *  - start() lazily brings up a single subsystem and its dependency
+ *    closure, so a command that only touches a few subsystems pays only
+ *    for those;
+ *  - startAll() brings up everything in dependency phases, running the
+ *    independent members of each phase through an executor so they can
+ *    come up in parallel.
+ *
+ * Each action returns Result the same way Application::init does. The
+ * first failure stops the bring-up and is reported to the caller; a
+ * subsystem is marked started only when its action succeeds, and started
+ * subsystems are never started twice, so a lazy start() followed later by
+ * startAll() does no redundant work.
+ */
+class InitGraph {
+public:
+
+    using size_type = uint32;
+
+    /// A bring-up action of a single subsystem.
+    using InitAction = std::function<Result<void, Error>()>;
+
+public:
+
+    /**
+     * Register a subsystem with no dependencies.
+     * @param name Name the subsystem is referred to by its dependents.
+     * @param action Action that brings the subsystem up.
+     * @return Reference to this for fluent interface.
+     */
+    InitGraph& add(StringView name, InitAction action);
+
+    /**
+     * Register a subsystem along with the names of subsystems it requires.
+     * Dependencies may be registered in any order relative to their
+     * dependents; names are resolved when the bring-up runs.
+     *
+     * @param name Name the subsystem is referred to by its dependents.
+     * @param dependsOn Names of the subsystems that must be up first.
+     * @param action Action that brings the subsystem up.
+     * @return Reference to this for fluent interface.
+     */
+    InitGraph& add(StringView name, std::initializer_list<StringView> dependsOn, InitAction action);
+
+    /**
+     * Lazily bring up one subsystem: its dependency closure runs first,
+     * in dependency order, skipping anything already started.
+     *
+     * @param name Name of the subsystem to bring up.
+     * @return Ok if the subsystem and its dependencies are up, or the
+     * first error encountered - an unknown name, a dependency cycle or a
+     * failed action.
+     */
+    Result<void, Error> start(StringView name);
+
+    /**
+     * Bring up every registered subsystem, phase by phase, running the
+     * actions of each phase on the calling thread.
+     * @return Ok when everything is up, or the first error encountered.
+     */
+    Result<void, Error> startAll();
+
+    /**
+     * Bring up every registered subsystem in dependency phases. Members
+     * of a phase do not depend on each other, so they are submitted to
+     * the given executor together and may run in parallel; the next phase
+     * starts only when the whole phase has completed.
+     *
+     * @param executor Executor the members of a phase are submitted to.
+     * @return Ok when everything is up, or the first error encountered.
+     */
+    Result<void, Error> startAll(Executor& executor);
+
+    /** Check if a named subsystem has been successfully brought up. */
+    bool isStarted(StringView name) const noexcept;
+
+    /** Number of registered subsystems. */
+    size_type size() const noexcept { return static_cast<size_type>(_nodes.size()); }
+
+private:
+
+    struct Node {
+        StringView              name;
+        std::vector<StringView> dependsOn;
+        InitAction              action;
+        bool                    started;
+    };
+
+    Result<void, Error> startNode(size_type index, std::vector<byte>& visitState);
+
+    Optional<size_type> findNode(StringView name) const noexcept;
+
+private:
+
+    /// Registered subsystems, in registration order.
+    std::vector<Node> _nodes;
+};
+
+}  // End of namespace Framework
+}  // End of namespace Solace
+#endif  // SOLACE_FRAMEWORK_INITGRAPH_HPP
@@ -0,0 +1,217 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Work-stealing task scheduler
+ *	@file		solace/framework/taskScheduler.hpp
+ *	@brief		Bounded work-stealing compute scheduler for framework services
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_FRAMEWORK_TASKSCHEDULER_HPP
+#define SOLACE_FRAMEWORK_TASKSCHEDULER_HPP
+
+#include "solace/future.hpp"
+#include "solace/delegate.hpp"
+#include "solace/mpmcQueue.hpp"
+#include "solace/result.hpp"
+#include "solace/error.hpp"
+
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace Solace { namespace Framework {
+
+namespace details {
+
+template<typename R, typename F>
+typename std::enable_if<!std::is_void<R>::value>::type
+completePromise(Promise<R>& promise, F& f) {
+    promise.setValue(f());
+}
+
+template<typename R, typename F>
+typename std::enable_if<std::is_void<R>::value>::type
+completePromise(Promise<R>& promise, F& f) {
+    f();
+    promise.setValue();
+}
+
+}  // namespace details
+
+
+/**
+ * A bounded work-stealing scheduler for compute tasks, meant to be shared
+ * as a framework service instead of every subsystem embedding its own pool.
+ *
+ * The worker set is fixed: construction only records the configuration and
+ * start() - designed to run as an InitGraph action - spawns every worker
+ * once, so no thread is ever created after initialization. Each worker owns
+ * a Chase-Lev deque: tasks submitted from a worker go to the bottom of its
+ * own deque and run in LIFO order while idle workers steal from the top of
+ * their siblings', so nested submissions keep their cache locality and a
+ * skewed partition gets rebalanced by the thieves. Submissions from outside
+ * the worker set land in a shared injection queue that workers drain
+ * between local work and stealing.
+ *
+ * Every queue is bounded. When a submission finds no queue space - or the
+ * scheduler has not been started - the task runs on the submitting thread,
+ * which bounds memory and provides natural backpressure. submit() returns
+ * a Future completed with the task's result, or with an Error carrying the
+ * message of whatever exception the task threw.
+ *
+ * The scheduler drains all queued tasks before the destructor returns.
+ */
+class TaskScheduler {
+public:
+
+    /** A unit of work. delegate handles move-only closures, unlike std::function. */
+    using Task = delegate<void()>;
+
+public:
+
+    ~TaskScheduler();
+
+    TaskScheduler(const TaskScheduler&) = delete;
+    TaskScheduler& operator= (const TaskScheduler&) = delete;
+
+    /** Configure a scheduler without spawning any threads.
+     * @param nbWorkers Number of worker threads, 0 for the hardware thread count.
+     */
+    explicit TaskScheduler(uint32 nbWorkers = 0);
+
+    /**
+     * Spawn the worker set. To be called once, during application
+     * initialization - typically as an InitGraph action:
+     * graph.add("scheduler", [&s]() { return s.start(); });
+     *
+     * @return Ok when the workers are up, or an error if the scheduler
+     * has been started already.
+     */
+    Result<void, Error> start();
+
+    /** Check if the worker set has been spawned. */
+    bool isStarted() const noexcept {
+        return !_threads.empty();
+    }
+
+    /** Number of worker threads the scheduler runs once started. */
+    uint32 workerCount() const noexcept {
+        return _nbWorkers;
+    }
+
+    /**
+     * Submit a callable for execution and get a future of its result.
+     * The future is completed with the callable's return value, or with an
+     * error if the callable throws.
+     *
+     * @param f A callable taking no arguments.
+     * @return A future completed when the task has run.
+     */
+    template<typename F,
+             typename R = typename std::result_of<F()>::type>
+    Future<R> submit(F&& f) {
+        Promise<R> promise;
+        auto future = promise.getFuture();
+
+        schedule(Task([p = std::move(promise), fn = std::forward<F>(f)]() mutable {
+            try {
+                details::completePromise<R>(p, fn);
+            } catch (const std::exception& e) {
+                p.setError(Error(std::string(e.what())));
+            } catch (...) {
+                p.setError(Error("TaskScheduler: task failed with an unknown exception"));
+            }
+        }));
+
+        return future;
+    }
+
+    /**
+     * Submit a fire-and-forget unit of work.
+     * Called from a worker thread the task goes to that worker's own deque;
+     * from anywhere else it goes through the injection queue. Either queue
+     * being full runs the task on the submitting thread instead.
+     *
+     * @param task A unit of work to execute.
+     */
+    void schedule(Task task);
+
+private:
+
+    /** A fixed-capacity Chase-Lev deque.
+     * The owning worker pushes and pops the bottom; thieves claim the top
+     * element with a CAS. Entries are owning pointers: whoever dequeues a
+     * task runs and deletes it.
+     */
+    class StealQueue {
+    public:
+        explicit StealQueue(uint32 capacity);
+
+        //! Owner only. @return False if the deque is full.
+        bool push(Task* task) noexcept;
+
+        //! Owner only. @return The youngest task, or nullptr if empty.
+        Task* pop() noexcept;
+
+        //! Any thread. @return The oldest task, nullptr if empty or the race was lost.
+        Task* steal() noexcept;
+
+    private:
+        std::unique_ptr<std::atomic<Task*>[]>   _buffer;
+        uint64 const                            _mask;
+
+        std::atomic<int64>  _top {0};
+        /// Keeps the thieves' CAS on _top off the owner's _bottom cache line.
+        /// (explicit padding: C++14 heap allocation ignores extended alignas)
+        byte                _padding[64 - sizeof(std::atomic<int64>)];
+        std::atomic<int64>  _bottom {0};
+    };
+
+    void workerLoop(uint32 home);
+
+    /** Run one task from the home deque, the injection queue or a sibling.
+     * @return True if a task was executed.
+     */
+    bool runOne(uint32 home);
+
+    void runReclaiming(Task* task);
+
+private:
+
+    /// Queued tasks per worker deque.
+    static constexpr uint32 kDequeCapacity = 1024;
+    /// Queued external submissions before schedule falls back to running inline.
+    static constexpr MpmcQueue<Task*>::size_type kInjectionCapacity = 1024;
+
+    uint32 _nbWorkers;
+
+    std::vector<std::unique_ptr<StealQueue>>    _deques;
+    MpmcQueue<Task*>                            _injection;
+    std::vector<std::thread>                    _threads;
+
+    std::atomic<uint64> _pending {0};
+    std::atomic<bool>   _stopping {false};
+
+    std::mutex              _wakeLock;
+    std::condition_variable _wake;
+};
+
+}  // End of namespace Framework
+}  // End of namespace Solace
+#endif  // SOLACE_FRAMEWORK_TASKSCHEDULER_HPP
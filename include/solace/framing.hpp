@@ -0,0 +1,136 @@
+/*
+*  Copyright 2017 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Checksummed message framing over byte streams
+ *	@file		solace/framing.hpp
+ *	@brief		Length-prefixed CRC-trailed frame encoder and incremental decoder
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_FRAMING_HPP
+#define SOLACE_FRAMING_HPP
+
+#include "solace/encoder.hpp"
+#include "solace/optional.hpp"
+
+
+namespace Solace {
+
+/**
+ * The wire layout shared by FrameEncoder and FrameDecoder:
+ *
+ *   | magic u16 LE | length u32 LE | payload bytes | crc32c u32 LE |
+ *
+ * The CRC-32C trailer covers the length field and the payload, so a frame
+ * with a corrupted length never causes a bogus wait or a giant allocation -
+ * it fails the checksum and the decoder resynchronizes on the next magic
+ * marker instead. Every field is fixed-size and little endian; the total
+ * framing overhead is 10 bytes per message.
+ */
+struct Framing {
+    static constexpr uint16 kMagic = 0x5AA5;        // 0xA5 0x5A on the wire
+    static constexpr uint32 kHeaderSize = 6;
+    static constexpr uint32 kTrailerSize = 4;
+    static constexpr uint32 kOverhead = kHeaderSize + kTrailerSize;
+};
+
+
+/**
+ * Frame writer behind the Encoder contract.
+ * Each encode() call wraps the given payload into one frame - magic, length,
+ * payload and CRC-32C trailer written through the destination buffer in a
+ * single fused pass over the payload bytes.
+ */
+class FrameEncoder : public Encoder {
+public:
+    using Encoder::size_type;
+
+public:
+
+    FrameEncoder(WriteBuffer& dest) :
+        Encoder(dest)
+    {}
+
+    size_type encodedSize(ImmutableMemoryView const& data) const override {
+        return data.size() + Framing::kOverhead;
+    }
+
+    using Encoder::encode;
+
+    Result<void, Error>
+    encode(ImmutableMemoryView const& src) override;
+};
+
+
+/**
+ * Incremental frame reader for stream transports.
+ *
+ * Feed it the receive buffer as bytes arrive: decode() consumes at most one
+ * complete frame per call and leaves partial frames in place, so short reads
+ * need no special handling - call again when more bytes land. Corrupted
+ * input - a bad checksum, a missing marker, an insane length - is skipped
+ * by scanning forward to the next magic marker eight bytes per step, and the
+ * decoder keeps going; losses are visible in stats() rather than fatal.
+ */
+class FrameDecoder {
+public:
+    using size_type = ReadBuffer::size_type;
+
+    /** Running totals of what the decoder has seen. Plain counters. */
+    struct Stats {
+        uint64 framesDecoded;       //!< Frames delivered to the caller.
+        uint64 framesCorrupted;     //!< Frames dropped on checksum or length.
+        uint64 bytesSkipped;        //!< Garbage bytes stepped over during resync.
+    };
+
+public:
+
+    /**
+     * @param maxPayloadSize Larger declared lengths are treated as corruption.
+     */
+    explicit FrameDecoder(size_type maxPayloadSize = 16 * 1024 * 1024) noexcept :
+        _maxPayloadSize(maxPayloadSize)
+    {}
+
+    /**
+     * Try to extract the next frame from the given buffer.
+     *
+     * @param src Buffer positioned at the unconsumed part of the stream.
+     * @param dest Storage for the payload, at least maxPayloadSize bytes to
+     * fit any frame this decoder will accept.
+     * @return Number of payload bytes written to dest, none when the buffer
+     * holds no complete frame yet, or an error when dest cannot fit a
+     * well-formed frame that is present.
+     */
+    Result<Optional<size_type>, Error>
+    decode(ReadBuffer& src, MemoryView dest);
+
+    /** Decode totals so far. @see Stats */
+    Stats const& stats() const noexcept {
+        return _stats;
+    }
+
+private:
+
+    /** Advance src past the ruled-out byte at its position to the next
+     * possible marker, skipping garbage eight bytes per step. */
+    void resync(ReadBuffer& src, ImmutableMemoryView remaining);
+
+    size_type   _maxPayloadSize;
+    Stats       _stats {};
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_FRAMING_HPP
@@ -25,10 +25,25 @@
 #define SOLACE_FUTUE_HPP
 
 #include "solace/promise.hpp"
+#include "solace/executor.hpp"
 
 
 namespace Solace {
 
+template<typename T>
+class Array;
+
+template<typename T>
+class ArrayView;
+
+namespace details {
+
+// Defined in solace/coro.hpp for toolchains with coroutine support
+template<typename T>
+struct FutureAwaiter;
+
+}  // namespace details
+
 
 template <typename T>
 struct isFuture : std::false_type {
@@ -61,6 +76,11 @@ template<typename FutureValueType,
 struct ErrBack;
 
 
+template<typename FutureValueType,
+         typename InnerCB>
+struct ViaCB;
+
+
 template<typename T,
          typename ContinuationResult,
          typename UnpuckedResult, typename UnpackedErrorResultType,
@@ -71,10 +91,31 @@ Future<UnpuckedResult> thenImplementation(std::shared_ptr<Core<T>>& core, F&& f)
     }
 
     Promise<UnpuckedResult> promise;
+    promise.setDeadline(core->deadline());  // Continuations inherit the chain's deadline.
     auto chainedFuture = promise.getFuture();
 
-    core->setCallback(std::make_shared<CB<T, ContinuationResult, UnpuckedResult, F>>(std::forward<F>(f),
-                                                                                     std::move(promise)));
+    core->template setCallback<CB<T, ContinuationResult, UnpuckedResult, F>>(std::forward<F>(f),
+                                                                             std::move(promise));
+
+    return chainedFuture;
+}
+
+
+template<typename T,
+         typename ContinuationResult,
+         typename UnpuckedResult, typename UnpackedErrorResultType,
+         typename F>
+Future<UnpuckedResult> thenImplementation(std::shared_ptr<Core<T>>& core, Executor& executor, F&& f) {
+    if (!core || core->isDetached()) {
+        raiseInvalidStateError("Invalid Future without a Promise");
+    }
+
+    Promise<UnpuckedResult> promise;
+    promise.setDeadline(core->deadline());  // Continuations inherit the chain's deadline.
+    auto chainedFuture = promise.getFuture();
+
+    using InnerCB = CB<T, ContinuationResult, UnpuckedResult, F>;
+    core->template setCallback<ViaCB<T, InnerCB>>(executor, InnerCB(std::forward<F>(f), std::move(promise)));
 
     return chainedFuture;
 }
@@ -90,10 +131,11 @@ Future<UnpuckedResult> onErrorImplementation(std::shared_ptr<Core<T>>& core, F&&
     }
 
     Promise<UnpuckedResult> promise;
+    promise.setDeadline(core->deadline());  // Continuations inherit the chain's deadline.
     auto chainedFuture = promise.getFuture();
 
-    core->setCallback(std::make_shared<ErrBack<T, ContinuationResult, UnpuckedResult, F>>(std::forward<F>(f),
-                                                                                          std::move(promise)));
+    core->template setCallback<ErrBack<T, ContinuationResult, UnpuckedResult, F>>(std::forward<F>(f),
+                                                                                  std::move(promise));
 
     return chainedFuture;
 }
@@ -195,6 +237,42 @@ public:
     }
 
 
+    /**
+     * Attach completion handler/callback to this future to be run via the given executor.
+     * Unlike plain then() the handler does not run inline on whatever thread resolved the promise -
+     * it is submitted to the executor as a task once the value is available.
+     *
+     * @param executor An executor to run the completion handler on.
+     * @param f A completion handler to attach to this future.
+     */
+    template<typename F,
+             typename R = typename std::result_of<F(T)>::type
+             >
+    std::enable_if_t<isFuture<R>::value || isSomeResult<R>::value, Future<typename R::value_type> >
+    then(Executor& executor, F&& f) {
+        using UnpackedRT = typename R::value_type;
+        using UnpackedET = typename R::error_type;
+
+        return details::thenImplementation<T, R, UnpackedRT, UnpackedET>(_core, executor, std::forward<F>(f));
+    }
+
+
+    /**
+     * Attach completion handler/callback to this future to be run via the given executor.
+     *
+     * @param executor An executor to run the completion handler on.
+     * @param f A completion handler to attach to this future.
+     */
+    template<typename F,
+             typename R = typename std::result_of<F(T)>::type
+             >
+    std::enable_if_t<!isSomeResult<R>::value && !isFuture<R>::value, Future<R>>
+    then(Executor& executor, F&& f) {
+
+        return details::thenImplementation<T, R, R, error_type>(_core, executor, std::forward<F>(f));
+    }
+
+
     //------------------------------------------------------------------------------------------------------------------
     //------------------------------------------------------------------------------------------------------------------
 
@@ -229,9 +307,31 @@ public:
         return details::onErrorImplementation<T, R, UnpackedRT, UnpackedET>(_core, std::forward<F>(f));
     }
 
+
+    /**
+     * Attach a completion deadline to this chain from the consumer side.
+     * It covers this stage and is inherited by continuations chained after
+     * this call. @see Deadline, Promise::setDeadline()
+     */
+    Future& setDeadline(Deadline deadline) noexcept {
+        if (_core) {
+            _core->setDeadline(deadline);
+        }
+
+        return *this;
+    }
+
+    /** The deadline this chain carries; unset unless one was attached. */
+    Deadline deadline() const noexcept {
+        return _core ? _core->deadline() : Deadline{};
+    }
+
 protected:
     template <typename> friend class Promise;
     template <typename FT> friend Future<FT> makeFuture(FT&&);
+    template <typename FT> friend Future<Array<FT>> whenAll(ArrayView<Future<FT>> futures);
+    template <typename FT> friend Future<FT> whenAny(ArrayView<Future<FT>> futures);
+    template <typename FT> friend struct details::FutureAwaiter;
 
     Future(const std::shared_ptr<Core<T>>& core): _core{core}
     {}
@@ -312,6 +412,36 @@ public:
         return details::thenImplementation<void, R, R, Error>(_core, std::forward<F>(f));
     }
 
+
+    /**
+     * Attach completion handler/callback to this future to be run via the given executor.
+     * Unlike plain then() the handler does not run inline on whatever thread resolved the promise -
+     * it is submitted to the executor as a task once the future is resolved.
+     *
+     * @param executor An executor to run the completion handler on.
+     * @param f A completion handler to attach to this future.
+     */
+    template<typename F,
+             typename R = typename std::result_of<F(void)>::type
+             >
+    std::enable_if_t<isFuture<R>::value || isSomeResult<R>::value, Future<typename R::value_type> >
+    then(Executor& executor, F&& f) {
+        using UnpackedRT = typename R::value_type;
+        using UnpackedET = typename R::error_type;
+
+        return details::thenImplementation<void, R, UnpackedRT, UnpackedET>(_core, executor, std::forward<F>(f));
+    }
+
+
+    template<typename F,
+             typename R = typename std::result_of<F(void)>::type
+             >
+    std::enable_if_t<!isSomeResult<R>::value && !isFuture<R>::value, Future<R>>
+    then(Executor& executor, F&& f) {
+
+        return details::thenImplementation<void, R, R, Error>(_core, executor, std::forward<F>(f));
+    }
+
     //------------------------------------------------------------------------------------------------------------------
     //------------------------------------------------------------------------------------------------------------------
 
@@ -346,8 +476,30 @@ public:
     }
 
 
+    /**
+     * Attach a completion deadline to this chain from the consumer side.
+     * It covers this stage and is inherited by continuations chained after
+     * this call. @see Deadline, Promise::setDeadline()
+     */
+    Future& setDeadline(Deadline deadline) noexcept {
+        if (_core) {
+            _core->setDeadline(deadline);
+        }
+
+        return *this;
+    }
+
+    /** The deadline this chain carries; unset unless one was attached. */
+    Deadline deadline() const noexcept {
+        return _core ? _core->deadline() : Deadline{};
+    }
+
+
 protected:
     template <typename> friend class Promise;
+    friend Future<void> whenAll(ArrayView<Future<void>> futures);
+    template <typename FT> friend Future<FT> whenAny(ArrayView<Future<FT>> futures);
+    template <typename FT> friend struct details::FutureAwaiter;
 
     Future(const std::shared_ptr<Core<void>>& core): _core{core}
     { }
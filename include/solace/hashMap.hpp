@@ -0,0 +1,576 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Flat open-addressing hash map
+ *	@file		solace/hashMap.hpp
+ *	@brief		An associative container with contiguous storage and group probing
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_HASHMAP_HPP
+#define SOLACE_HASHMAP_HPP
+
+#include "solace/types.hpp"
+#include "solace/assert.hpp"
+
+#include <cstring>      // memcpy
+#include <new>          // placement new
+#include <type_traits>
+#include <utility>      // std::move, std::forward
+
+
+namespace Solace {
+
+/** The per-process hash seed.
+ *
+ * A table hashing attacker-supplied keys with a fixed public function can be
+ * collision-flooded into quadratic behaviour. The seed is drawn from system
+ * entropy once per process and mixed into every seeded hashCode(), making
+ * the collision structure unpredictable at no per-key cost.
+ *
+ * The first caller fixes the value for the process lifetime; Framework
+ * applications warm it in the Application constructor, before any
+ * request-keyed table is built.
+ *
+ * @return The process-wide random hash seed.
+ */
+uint64 hashSeed() noexcept;
+
+
+namespace details {
+
+/** Hashing for the hashOf() protocol preferring a seeded hashCode(seed) when
+ * the type has one, so string-keyed tables are collision-flood resistant by
+ * default; types with only the plain hashCode() keep their stable hash. */
+template<typename T>
+auto hashIt(T const& value, int) noexcept -> decltype(value.hashCode(uint64{})) {
+    return value.hashCode(hashSeed());
+}
+
+template<typename T>
+constexpr auto hashIt(T const& value, long) noexcept -> decltype(value.hashCode()) {
+    return value.hashCode();
+}
+
+}  // namespace details
+
+
+/**
+ * Hash protocol used by HashMap.
+ * Types following the library convention - String, StringView, StringAtom,
+ * UUID et al. - are hashed through their hashCode() member, preferring the
+ * seeded hashCode(seed) overload when the type offers one. Built-in integers
+ * get a dedicated overload that mixes the bits, as raw integer keys tend to
+ * be sequential and would otherwise cluster in an open-addressing table.
+ */
+template<typename T>
+constexpr auto hashOf(T const& value) noexcept -> decltype(details::hashIt(value, 0)) {
+    return details::hashIt(value, 0);
+}
+
+template<typename T>
+constexpr std::enable_if_t<std::is_integral<T>::value, uint64>
+hashOf(T value) noexcept {
+    // Finalizer of splitmix64: cheap and well distributed.
+    uint64 x = static_cast<uint64>(value) + 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+
+    return x ^ (x >> 31);
+}
+
+
+namespace details {
+
+/** Key comparison for HashMap preferring a member equals() when the key has one,
+ * so String keys compare against a StringView probe without constructing a String. */
+template<typename K, typename L>
+constexpr auto keyEq(K const& key, L const& lookup, int) noexcept -> decltype(key.equals(lookup)) {
+    return key.equals(lookup);
+}
+
+template<typename K, typename L>
+constexpr auto keyEq(K const& key, L const& lookup, long) noexcept -> decltype(key == lookup) {
+    return (key == lookup);
+}
+
+template<typename K, typename L>
+constexpr bool keyEquals(K const& key, L const& lookup) noexcept {
+    return keyEq(key, lookup, 0);
+}
+
+
+/** Byte-wise tag matching over 8 control bytes at a time.
+ * Returns a word with bit 7 of every byte that equals the given tag set.
+ * May set a spurious bit next to a true match; callers treat set bits as
+ * candidates to verify, so a false positive only costs one extra compare.
+ */
+constexpr uint64 matchTag(uint64 group, byte tag) noexcept {
+    return ((group ^ (0x0101010101010101ULL * tag)) - 0x0101010101010101ULL)
+            & ~(group ^ (0x0101010101010101ULL * tag))
+            & 0x8080808080808080ULL;
+}
+
+/** Bits 7 of every control byte that is empty or deleted (both have the high bit set). */
+constexpr uint64 matchFree(uint64 group) noexcept {
+    return group & 0x8080808080808080ULL;
+}
+
+inline uint32 firstMarkedByte(uint64 matches) noexcept {
+    return static_cast<uint32>(__builtin_ctzll(matches)) / 8;
+}
+
+}  // namespace details
+
+
+/** Flat open-addressing hash map aka HashMap.
+ * Keys and values live together in one contiguous slot array, and a separate
+ * byte of control metadata per slot holds 7 bits of the hash. Probing scans
+ * the control bytes in groups of 16 using word-wide tag matching, so most
+ * lookups touch one cache line of metadata and then compare a single key -
+ * no per-node allocation and no pointer chase.
+ *
+ * Keys are hashed through the hashOf() protocol and compared with equals()
+ * when available, so a HashMap<String, V> can be probed with a StringView
+ * without materializing a String per lookup.
+ *
+ * References and pointers into the map are invalidated by any mutating call.
+ */
+template<typename K, typename V>
+class HashMap {
+public:
+    using key_type = K;
+    using value_type = V;
+    using size_type = uint32;
+
+public:
+
+    ~HashMap() {
+        destroy();
+    }
+
+    /** Construct an empty map. Storage is allocated on first insertion. */
+    HashMap() noexcept = default;
+
+    /** Construct an empty map big enough to hold the given number of elements
+     * without rehashing.
+     * @param expectedSize Number of elements to reserve capacity for.
+     */
+    explicit HashMap(size_type expectedSize) {
+        reserve(expectedSize);
+    }
+
+    /** Construct a new map by moving content of a given map */
+    HashMap(HashMap&& other) noexcept :
+        _memory(std::exchange(other._memory, nullptr)),
+        _tags(std::exchange(other._tags, nullptr)),
+        _slots(std::exchange(other._slots, nullptr)),
+        _capacity(std::exchange(other._capacity, 0)),
+        _size(std::exchange(other._size, 0)),
+        _tombstones(std::exchange(other._tombstones, 0))
+    {}
+
+    /** Construct a new map to be a copy of a given */
+    HashMap(const HashMap& other) {
+        reserve(other._size);
+
+        other.forEach([this](K const& key, V const& value) {
+            put(key, value);
+        });
+    }
+
+    HashMap& operator= (HashMap&& rhs) noexcept {
+        return swap(rhs);
+    }
+
+    HashMap& operator= (const HashMap& rhs) {
+        HashMap(rhs).swap(*this);
+
+        return *this;
+    }
+
+public:
+
+    HashMap& swap(HashMap& rhs) noexcept {
+        using std::swap;
+        swap(_memory, rhs._memory);
+        swap(_tags, rhs._tags);
+        swap(_slots, rhs._slots);
+        swap(_capacity, rhs._capacity);
+        swap(_size, rhs._size);
+        swap(_tombstones, rhs._tombstones);
+
+        return (*this);
+    }
+
+    /**
+     * Check if this collection is empty.
+     * @return True is this is an empty collection.
+     */
+    bool empty() const noexcept {
+        return (_size == 0);
+    }
+
+    /**
+     * Get the number of elements in this map
+     * @return The number of key-value pairs stored.
+     */
+    size_type size() const noexcept {
+        return _size;
+    }
+
+    /** Number of slots currently allocated. */
+    size_type capacity() const noexcept {
+        return _capacity;
+    }
+
+    /**
+     * Make sure the map can hold the given number of elements without rehashing.
+     * @param expectedSize Number of elements to reserve capacity for.
+     */
+    void reserve(size_type expectedSize) {
+        // Keep the load factor under 7/8 after expectedSize insertions.
+        size_type required = kGroupSize;
+        while (required - required / 8 < expectedSize) {
+            required *= 2;
+        }
+
+        if (required > _capacity) {
+            rehash(required);
+        }
+    }
+
+    /**
+     * Associate a value with a key, overwriting any previous association.
+     * @param key A key to store the value under.
+     * @param value A value to store.
+     * @return A reference to the stored value, valid until the next mutating call.
+     */
+    V& put(K key, V value) {
+        const auto hash = hashOf(key);
+
+        if (_capacity != 0) {
+            const auto found = findSlot(key, hash);
+            if (found != kNotFound) {
+                _slots[found].value = std::move(value);
+
+                return _slots[found].value;
+            }
+        }
+
+        if ((_size + _tombstones + 1) * 8 > _capacity * 7) {
+            rehash((_capacity == 0) ? kGroupSize : _capacity * 2);
+        }
+
+        const auto slot = findInsertSlot(hash);
+        if (_tags[slot] == kDeletedTag) {
+            _tombstones -= 1;
+        }
+
+        _tags[slot] = tagOf(hash);
+        new (&_slots[slot].key) K(std::move(key));
+        new (&_slots[slot].value) V(std::move(value));
+        _size += 1;
+
+        return _slots[slot].value;
+    }
+
+    /**
+     * Find the value associated with a key.
+     * The probe may be any type hashable and comparable with the key type,
+     * such as a StringView probing a map keyed by String.
+     *
+     * @param key A key to look up.
+     * @return A pointer to the stored value or nullptr if the key is not in
+     * the map. The pointer is valid until the next mutating call.
+     */
+    template<typename Lookup>
+    V* find(Lookup const& key) noexcept {
+        if (_capacity == 0) {
+            return nullptr;
+        }
+
+        const auto slot = findSlot(key, hashOf(key));
+
+        return (slot == kNotFound) ? nullptr : &_slots[slot].value;
+    }
+
+    template<typename Lookup>
+    const V* find(Lookup const& key) const noexcept {
+        return const_cast<HashMap*>(this)->find(key);
+    }
+
+    /**
+     * Check if a key is present in the map.
+     * @param key A key to look up.
+     * @return True if a value is associated with the key.
+     */
+    template<typename Lookup>
+    bool contains(Lookup const& key) const noexcept {
+        return (find(key) != nullptr);
+    }
+
+    /**
+     * Remove a key and its associated value from the map.
+     * @param key A key to remove.
+     * @return True if the key was present.
+     */
+    template<typename Lookup>
+    bool remove(Lookup const& key) noexcept {
+        if (_capacity == 0) {
+            return false;
+        }
+
+        const auto slot = findSlot(key, hashOf(key));
+        if (slot == kNotFound) {
+            return false;
+        }
+
+        _slots[slot].key.~K();
+        _slots[slot].value.~V();
+        _tags[slot] = kDeletedTag;
+        _size -= 1;
+        _tombstones += 1;
+
+        return true;
+    }
+
+    /** Remove all elements, keeping the allocated capacity. */
+    void clear() noexcept {
+        for (size_type i = 0; i < _capacity; ++i) {
+            if (isFull(_tags[i])) {
+                _slots[i].key.~K();
+                _slots[i].value.~V();
+            }
+            _tags[i] = kEmptyTag;
+        }
+
+        _size = 0;
+        _tombstones = 0;
+    }
+
+    /*
+     *--------------------------------------------------------------------------
+     * Functional methods that operates on the collection without changing it.
+     *--------------------------------------------------------------------------
+     */
+
+    /** Apply a function to every association, invoked as f(key, value). */
+    template<typename F>
+    const HashMap& forEach(F&& f) {
+        for (size_type i = 0; i < _capacity; ++i) {
+            if (isFull(_tags[i])) {
+                f(static_cast<K const&>(_slots[i].key), _slots[i].value);
+            }
+        }
+
+        return *this;
+    }
+
+    template<typename F>
+    const HashMap& forEach(F&& f) const {
+        for (size_type i = 0; i < _capacity; ++i) {
+            if (isFull(_tags[i])) {
+                f(static_cast<K const&>(_slots[i].key), static_cast<V const&>(_slots[i].value));
+            }
+        }
+
+        return *this;
+    }
+
+protected:
+
+    struct Slot {
+        K key;
+        V value;
+    };
+
+    /// Number of control bytes scanned per probe step.
+    static constexpr size_type kGroupSize = 16;
+
+    static constexpr byte kEmptyTag = 0x80;
+    static constexpr byte kDeletedTag = 0xFE;
+
+    static constexpr size_type kNotFound = ~static_cast<size_type>(0);
+
+    static constexpr bool isFull(byte tag) noexcept {
+        return (tag & 0x80) == 0;
+    }
+
+    /// 7 bits of the hash stored in the control byte of a full slot.
+    static constexpr byte tagOf(uint64 hash) noexcept {
+        return static_cast<byte>(hash & 0x7F);
+    }
+
+    /** Probe the table for a key.
+     * @return Slot index of the key or kNotFound.
+     */
+    template<typename Lookup>
+    size_type findSlot(Lookup const& key, uint64 hash) const noexcept {
+        const auto groupCount = _capacity / kGroupSize;
+        const auto tag = tagOf(hash);
+
+        auto groupIndex = static_cast<size_type>(hash >> 7) & (groupCount - 1);
+        for (size_type probed = 0; probed < groupCount; ++probed) {
+            const byte* group = _tags + groupIndex * kGroupSize;
+
+            uint64 words[2];
+            memcpy(words, group, sizeof(words));
+
+            for (size_type w = 0; w < 2; ++w) {
+                auto candidates = details::matchTag(words[w], tag);
+                while (candidates != 0) {
+                    const auto slot = groupIndex * kGroupSize
+                                    + w * 8
+                                    + details::firstMarkedByte(candidates);
+                    if (isFull(_tags[slot]) && details::keyEquals(_slots[slot].key, key)) {
+                        return slot;
+                    }
+
+                    candidates &= (candidates - 1);
+                }
+            }
+
+            // An empty slot in the group means the key was never displaced past it.
+            if (details::matchTag(words[0], kEmptyTag) != 0 ||
+                details::matchTag(words[1], kEmptyTag) != 0) {
+                return kNotFound;
+            }
+
+            groupIndex = (groupIndex + 1) & (groupCount - 1);
+        }
+
+        return kNotFound;
+    }
+
+    /** Find the slot a new key with the given hash should go into,
+     * reusing the first tombstone on the probe path if there is one. */
+    size_type findInsertSlot(uint64 hash) const noexcept {
+        const auto groupCount = _capacity / kGroupSize;
+
+        auto firstDeleted = kNotFound;
+        auto groupIndex = static_cast<size_type>(hash >> 7) & (groupCount - 1);
+
+        for (;;) {
+            const byte* group = _tags + groupIndex * kGroupSize;
+
+            uint64 words[2];
+            memcpy(words, group, sizeof(words));
+
+            for (size_type w = 0; w < 2; ++w) {
+                auto free = details::matchFree(words[w]);
+                while (free != 0) {
+                    const auto slot = groupIndex * kGroupSize
+                                    + w * 8
+                                    + details::firstMarkedByte(free);
+                    if (_tags[slot] == kEmptyTag) {
+                        return (firstDeleted != kNotFound) ? firstDeleted : slot;
+                    }
+
+                    if (firstDeleted == kNotFound && _tags[slot] == kDeletedTag) {
+                        firstDeleted = slot;
+                    }
+
+                    free &= (free - 1);
+                }
+            }
+
+            groupIndex = (groupIndex + 1) & (groupCount - 1);
+        }
+    }
+
+    /** Move every element into a freshly allocated table of the given capacity. */
+    void rehash(size_type newCapacity) {
+        auto* oldTags = _tags;
+        auto* oldSlots = _slots;
+        auto* oldMemory = _memory;
+        const auto oldCapacity = _capacity;
+
+        allocate(newCapacity);
+
+        for (size_type i = 0; i < oldCapacity; ++i) {
+            if (!isFull(oldTags[i])) {
+                continue;
+            }
+
+            const auto hash = hashOf(oldSlots[i].key);
+            const auto slot = findInsertSlot(hash);
+
+            _tags[slot] = tagOf(hash);
+            new (&_slots[slot].key) K(std::move(oldSlots[i].key));
+            new (&_slots[slot].value) V(std::move(oldSlots[i].value));
+
+            oldSlots[i].key.~K();
+            oldSlots[i].value.~V();
+        }
+
+        _tombstones = 0;
+        delete[] oldMemory;
+    }
+
+    void allocate(size_type capacity) {
+        const size_t slotsOffset = alignSlotOffset(capacity);
+        const size_t total = slotsOffset + static_cast<size_t>(capacity) * sizeof(Slot);
+
+        _memory = new byte[total];
+        _tags = _memory;
+        _slots = reinterpret_cast<Slot*>(_memory + slotsOffset);
+        _capacity = capacity;
+
+        memset(_tags, kEmptyTag, capacity);
+    }
+
+    void destroy() noexcept {
+        for (size_type i = 0; i < _capacity; ++i) {
+            if (isFull(_tags[i])) {
+                _slots[i].key.~K();
+                _slots[i].value.~V();
+            }
+        }
+
+        delete[] _memory;
+        _memory = nullptr;
+        _tags = nullptr;
+        _slots = nullptr;
+        _capacity = 0;
+        _size = 0;
+        _tombstones = 0;
+    }
+
+    static constexpr size_t alignSlotOffset(size_type capacity) noexcept {
+        return (static_cast<size_t>(capacity) + alignof(Slot) - 1) & ~(alignof(Slot) - 1);
+    }
+
+private:
+
+    /// One allocation holding the control bytes followed by the slots.
+    byte*       _memory {nullptr};
+
+    byte*       _tags {nullptr};
+    Slot*       _slots {nullptr};
+
+    size_type   _capacity {0};
+    size_type   _size {0};
+    size_type   _tombstones {0};
+};
+
+
+template<typename K, typename V>
+void swap(HashMap<K, V>& lhs, HashMap<K, V>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_HASHMAP_HPP
@@ -0,0 +1,98 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: CRC-32C checksum
+ *	@file		solace/hashing/crc32c.hpp
+ *	@brief		Defines the CRC-32C (Castagnoli) checksum
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_HASHING_CRC32C_HPP
+#define SOLACE_HASHING_CRC32C_HPP
+
+#include "solace/hashing/digestAlgorithm.hpp"
+
+
+namespace Solace {
+namespace hashing {
+
+/**
+ * CRC-32C (Castagnoli) checksum behind the HashingAlgorithm interface.
+ *
+ * The Castagnoli polynomial is the one with direct hardware support: the
+ * SSE4.2 crc32 instruction on x86 and the ACLE crc32c instructions on ARMv8.
+ * Where the hardware has them the bulk path runs three interleaved streams to
+ * cover the instruction latency; elsewhere a slicing-by-eight table
+ * implementation is used. Unlike the digest algorithms this is an error
+ * detection code, not a hash to build tables on and certainly not crypto.
+ *
+ * update() accumulates, so a record can be checksummed in as many pieces as
+ * it arrives in.
+ */
+class Crc32c :
+        public HashingAlgorithm {
+public:
+    using HashingAlgorithm::size_type;
+
+public:
+
+    using HashingAlgorithm::update;
+
+    Crc32c();
+
+    /**
+     * Get a string name of the hashing algorithm.
+     * @return A string name of the hashing algorithm.
+     */
+    String getAlgorithm() const override;
+
+    /**
+     * Get a length of the digest in bytes.
+     * @return Length of the digest produced by this algorithm.
+     */
+    size_type getDigestLength() const override;
+
+    /**
+     * Update the checksum with the given input.
+     * @param input A memory view to read data from.
+     * @return A reference to self for a fluent interface.
+     */
+    HashingAlgorithm& update(ImmutableMemoryView input) override;
+
+    /*
+     * Completes the checksum computation.
+     * @return An array of bytes representing the checksum, big-endian.
+     */
+    MessageDigest digest() override;
+
+private:
+    uint32  _crc;
+};
+
+
+/** Compute the CRC-32C checksum of a block in one call.
+ * Produces the same value as Crc32c over the same bytes, with no object and
+ * no MessageDigest allocation - the form for per-record hot paths.
+ *
+ * @param data Bytes to checksum.
+ * @param crc Checksum of the preceding bytes when chaining, 0 to start.
+ * @return CRC-32C of the given bytes appended to a stream with the given crc.
+ */
+uint32 crc32c(ImmutableMemoryView data, uint32 crc = 0) noexcept;
+
+
+}  // End of namespace hashing
+}  // End of namespace Solace
+#endif  // SOLACE_HASHING_CRC32C_HPP
@@ -25,8 +25,12 @@
 
 #include "solace/hashing/messageDigest.hpp"
 #include "solace/readBuffer.hpp"
+#include "solace/arrayView.hpp"
 
 namespace Solace {
+
+namespace IO { class File; }
+
 namespace hashing {
 
 /**
@@ -74,6 +78,37 @@ public:
         return *this;
     }
 
+    /**
+     * Update the digest with every view of the given list, in order.
+     * A message scattered over multiple buffers is hashed in one call with no
+     * intermediate copy into a contiguous buffer.
+     * @param input Views to read data from, in order.
+     * @return A reference to self for a fluent interface.
+     */
+    virtual HashingAlgorithm& update(ArrayView<ImmutableMemoryView> input) {
+        for (auto const& view : input) {
+            update(view);
+        }
+
+        return *this;
+    }
+
+    /**
+     * Update the digest with a region of the given file.
+     *
+     * The region is consumed through a sequence of memory-mapped windows with
+     * a sequential read-ahead hint, so hashing a large file is bounded by the
+     * digest computation and the disk - not by per-buffer syscalls.
+     *
+     * @param file File to read the message from.
+     * @param offset Absolute offset in the file the region starts at.
+     * @param length Length of the region in bytes.
+     * @return A reference to self for a fluent interface.
+     *
+     * @throws IOException if mapping of the file region failed.
+     */
+    HashingAlgorithm& updateFrom(IO::File& file, uint64 offset, uint64 length);
+
     /*
      * Completes the hash computation by performing final operations such as padding.
      * @return An array of bytes representing message digest.
@@ -0,0 +1,110 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Keyed-hash message authentication code (HMAC)
+ *	@file		solace/hashing/hmac.hpp
+ *	@author		$LastChangedBy$
+ *	@date		$LastChangedDate$
+ *	@brief		HMAC construction over the hashing algorithms, RFC 2104
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_HASHING_HMAC_HPP
+#define SOLACE_HASHING_HMAC_HPP
+
+#include "solace/hashing/digestAlgorithm.hpp"
+
+#include <cstring>  // memcpy / memset
+
+
+namespace Solace {
+namespace hashing {
+
+/**
+ * HMAC construction (RFC 2104) over any of the hashing algorithms.
+ *
+ * The key schedule - the hash states primed with the key xored with the
+ * inner and outer pads - is computed once, when the Hmac is constructed.
+ * Each call to mac() clones those states, so authenticating a message
+ * costs only the message itself plus one extra compression for the outer
+ * hash, not a re-absorption of two key blocks.
+ *
+ * @tparam Algo Hashing algorithm to build the MAC on, e.g. Sha256.
+ * @tparam BlockSize Input block size of Algo in bytes. 64 fits the MD5,
+ *      SHA-1 and SHA-256 family; a SHA-3 based MAC would pass the rate.
+ */
+template <typename Algo, MessageDigest::size_type BlockSize = 64>
+class Hmac {
+public:
+
+    /**
+     * Construct a MAC engine for the given key.
+     * Keys longer than the block size are hashed first, per RFC 2104.
+     * @param key Secret key shared with the verifier.
+     */
+    Hmac(ImmutableMemoryView key) {
+        byte block[BlockSize];
+        memset(block, 0, sizeof(block));
+
+        if (key.size() > BlockSize) {
+            Algo keyHash;
+            keyHash.update(key);
+            auto const digest = keyHash.digest();
+            memcpy(block, digest.data(), digest.size());
+        } else {
+            memcpy(block, key.dataAddress(), key.size());
+        }
+
+        byte pad[BlockSize];
+        for (MessageDigest::size_type i = 0; i < BlockSize; ++i) {
+            pad[i] = static_cast<byte>(block[i] ^ 0x36);
+        }
+        _inner.update(wrapMemory(pad));
+
+        for (MessageDigest::size_type i = 0; i < BlockSize; ++i) {
+            pad[i] = static_cast<byte>(block[i] ^ 0x5c);
+        }
+        _outer.update(wrapMemory(pad));
+
+        memset(block, 0, sizeof(block));
+        memset(pad, 0, sizeof(pad));
+    }
+
+    /**
+     * Compute the authentication tag of a message.
+     * @param message A memory view of the message to authenticate.
+     * @return The HMAC tag, the same length as the underlying digest.
+     */
+    MessageDigest mac(ImmutableMemoryView message) const {
+        Algo inner(_inner);
+        inner.update(message);
+        auto const innerDigest = inner.digest();
+
+        Algo outer(_outer);
+        outer.update(innerDigest.view());
+
+        return outer.digest();
+    }
+
+private:
+
+    Algo _inner;    //!< Hash state primed with key ^ ipad.
+    Algo _outer;    //!< Hash state primed with key ^ opad.
+};
+
+
+}  // End of namespace hashing
+}  // End of namespace Solace
+#endif  // SOLACE_HASHING_HMAC_HPP
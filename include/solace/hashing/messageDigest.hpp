@@ -25,6 +25,7 @@
 
 #include "solace/types.hpp"
 #include "solace/string.hpp"
+#include "solace/writeBuffer.hpp"
 
 
 namespace Solace {
@@ -133,6 +134,52 @@ public:
 
     String toString() const;
 
+    /** Textual encodings formatInto() can emit. */
+    enum class Encoding {
+        Base16,     //!< Lowercase hex: two characters per digest byte.
+        Base64,     //!< Standard base64 with padding.
+    };
+
+    /**
+     * Render the digest as text straight into a caller-owned buffer.
+     *
+     * The zero-allocation companion of toString() for hot paths that turn
+     * digests into index keys: characters go directly from the digest bytes
+     * into dest via the bulk codec kernels, with no String or heap traffic.
+     *
+     * @param dest Buffer to write the characters to; its position advances
+     *  past what was written.
+     * @param encoding The textual encoding to emit. @see Encoding
+     * @return Number of characters written, or an error if dest is too small.
+     */
+    Result<size_type, Error> formatInto(WriteBuffer& dest, Encoding encoding = Encoding::Base16) const;
+
+    /** @see formatInto(WriteBuffer&, Encoding). Writes from the start of dest. */
+    Result<size_type, Error> formatInto(MemoryView dest, Encoding encoding = Encoding::Base16) const;
+
+    /**
+     * Compare this digest to another one in constant time.
+     *
+     * Unlike operator==, the comparison always examines every byte, so the
+     * running time does not reveal the position of the first mismatch. Use
+     * this whenever the digest being checked is an authentication tag.
+     *
+     * @param rhs A digest to compare with.
+     * @return True if both digests hold the same bytes.
+     */
+    bool isEqual(MessageDigest const& rhs) const noexcept {
+        if (size() != rhs.size()) {
+            return false;
+        }
+
+        byte acc = 0;
+        for (size_type i = 0; i < size(); ++i) {
+            acc |= static_cast<byte>(_storage[i] ^ rhs._storage[i]);
+        }
+
+        return (acc == 0);
+    }
+
     friend bool operator== (const MessageDigest& lhs, const MessageDigest& rhs);
 
 private:
@@ -122,6 +122,102 @@ private:
 };
 
 
+/**
+ * A 128-bit hash value, as produced by the one-shot Murmur3 functions.
+ * Plain value type: cheap to copy, compare and keep in bulk arrays.
+ */
+struct Hash128 {
+    uint64 low;
+    uint64 high;
+};
+
+inline bool operator== (Hash128 const& lhs, Hash128 const& rhs) noexcept {
+    return (lhs.low == rhs.low) && (lhs.high == rhs.high);
+}
+
+inline bool operator!= (Hash128 const& lhs, Hash128 const& rhs) noexcept {
+    return !(lhs == rhs);
+}
+
+
+/** Compute Murmur3 128-bit hash of a key in one call.
+ * Produces the same value as Murmur3_128 over the same bytes, but with no
+ * hasher object, no MessageDigest allocation and no per-key setup - the form
+ * to use when hashing keys in bulk.
+ *
+ * @param key Bytes to hash.
+ * @param seed A seed value for the hash.
+ * @return 128-bit hash of the given key.
+ */
+Hash128 murmur3_128(ImmutableMemoryView key, uint32 seed = 0) noexcept;
+
+
+/** Compute Murmur3 128-bit hashes of a batch of keys in one call.
+ *
+ * @param keys Keys to hash, each one an independent input.
+ * @param hashes Destination for one hash per key; must be at least keys.size() long.
+ * @param seed A seed value shared by all keys.
+ */
+void murmur3_128(ArrayView<ImmutableMemoryView> keys, ArrayView<Hash128> hashes, uint32 seed = 0);
+
+
+/** Compute Murmur3 32-bit hash of a string, usable at compile time.
+ * Produces exactly the same value as running Murmur3_32 over the same bytes,
+ * but being constexpr it can seed switch-on-string dispatch tables with no
+ * runtime hashing at all.
+ *
+ * @param key A string to hash.
+ * @param seed A seed value for the hash.
+ * @return 32-bit hash of the given string.
+ */
+constexpr uint32 murmur3_32(StringView key, uint32 seed = 0) noexcept {
+    const uint32 c1 = 0xcc9e2d51;
+    const uint32 c2 = 0x1b873593;
+
+    uint32 h = seed;
+    const auto len = key.size();
+
+    StringView::size_type i = 0;
+    for (; i + 4 <= len; i += 4) {
+        uint32 k = static_cast<uint8>(key[i])
+                | (static_cast<uint32>(static_cast<uint8>(key[i + 1])) << 8)
+                | (static_cast<uint32>(static_cast<uint8>(key[i + 2])) << 16)
+                | (static_cast<uint32>(static_cast<uint8>(key[i + 3])) << 24);
+
+        k *= c1;
+        k = (k << 15) | (k >> 17);
+        k *= c2;
+
+        h ^= k;
+        h = (h << 13) | (h >> 19);
+        h = h * 5 + 0xe6546b64;
+    }
+
+    // Tail bytes:
+    uint32 k = 0;
+    const auto tail = len & 3;
+    if (tail >= 3) { k ^= static_cast<uint32>(static_cast<uint8>(key[i + 2])) << 16; }
+    if (tail >= 2) { k ^= static_cast<uint32>(static_cast<uint8>(key[i + 1])) << 8; }
+    if (tail >= 1) {
+        k ^= static_cast<uint8>(key[i]);
+        k *= c1;
+        k = (k << 15) | (k >> 17);
+        k *= c2;
+        h ^= k;
+    }
+
+    // Finalization mix:
+    h ^= len;
+    h ^= h >> 16;
+    h *= 0x85ebca6b;
+    h ^= h >> 13;
+    h *= 0xc2b2ae35;
+    h ^= h >> 16;
+
+    return h;
+}
+
+
 }  // End of namespace hashing
 }  // End of namespace Solace
 #endif  // SOLACE_HASHING_MURMUR3_HPP
@@ -83,6 +83,23 @@ private:
 };
 
 
+/**
+ * Hash a batch of independent messages in one call.
+ *
+ * Messages are hashed eight at a time by an AVX2 kernel that keeps one
+ * interleaved Sha256 state per SIMD lane, so a batch of similar-sized
+ * messages - fixed-size blocks of a content-addressed store, say - runs at a
+ * multiple of single-stream throughput. Lanes that run out of full blocks
+ * before the rest of their group, and any trailing group smaller than eight,
+ * are finished by the regular single-stream code. Where AVX2 is not
+ * available the whole batch is hashed sequentially.
+ *
+ * @param messages Messages to hash, each one an independent input.
+ * @return A digest for every message, in order.
+ */
+Array<MessageDigest> sha256Batch(ArrayView<ImmutableMemoryView> messages);
+
+
 }  // End of namespace hashing
 }  // End of namespace Solace
 #endif  // SOLACE_HASHING_SHA2_HPP
@@ -32,8 +32,8 @@ namespace Solace {
 namespace hashing {
 
 /**
- * Implementation of Sha-2 cryptographic hashing algorithm.
- * This is SHA-256 with 256 bit digest.
+ * Implementation of the SHA-3 cryptographic hashing algorithm (FIPS 202).
+ * This is SHA3-256 with a 256 bit digest.
  */
 class Sha3 :
         public HashingAlgorithm {
@@ -41,9 +41,9 @@ public:
     using HashingAlgorithm::size_type;
 
     struct State {
-        uint32  total[2];
-        uint32  state[8];               /*!< intermediate digest state  */
-        byte    buffer[64];             /*!< data block being processed */
+        uint64  lanes[25];              /*!< Keccak-f[1600] sponge state */
+        uint32  rate;                   /*!< sponge rate, in bytes */
+        uint32  offset;                 /*!< bytes absorbed into the current block */
     };
 
 public:
@@ -83,6 +83,60 @@ private:
 };
 
 
+/**
+ * SHAKE extendable-output function (FIPS 202).
+ *
+ * A SHAKE instance absorbs a message through update() and then squeezes any
+ * amount of output through read() - the tool for deriving several per-session
+ * keys from one secret without hashing it once per key. The first read()
+ * finalizes the message; update() cannot be called after it.
+ */
+class Shake {
+public:
+    using size_type = ImmutableMemoryView::size_type;
+
+public:
+
+    /**
+     * Feed the next chunk of the message into the sponge.
+     * @param input A memory view to read message bytes from.
+     * @return A reference to self for a fluent interface.
+     */
+    Shake& update(ImmutableMemoryView input);
+
+    /**
+     * Squeeze the next dest.size() bytes of output.
+     * Consecutive reads continue the same output stream, so reading 2x16
+     * bytes produces the same bytes as one 32-byte read.
+     * @param dest A memory view to fill with output bytes.
+     */
+    void read(MemoryView dest);
+
+protected:
+
+    Shake(uint32 rateBytes);
+
+private:
+
+    Sha3::State _state;
+    bool        _squeezing;     //!< Message finalized, sponge producing output.
+};
+
+
+/** SHAKE128: 168-byte rate, 128-bit security level. */
+class Shake128 : public Shake {
+public:
+    Shake128();
+};
+
+
+/** SHAKE256: 136-byte rate, 256-bit security level. */
+class Shake256 : public Shake {
+public:
+    Shake256();
+};
+
+
 }  // End of namespace hashing
 }  // End of namespace Solace
 #endif  // SOLACE_HASHING_SHA3_HPP
@@ -0,0 +1,95 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: wyhash fast non-cryptographic hash
+ *	@file		solace/hashing/wyhash.hpp
+ *	@brief		Defines wyhash, a bandwidth-class non-cryptographic hash
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_HASHING_WYHASH_HPP
+#define SOLACE_HASHING_WYHASH_HPP
+
+#include "solace/hashing/digestAlgorithm.hpp"
+
+
+namespace Solace {
+namespace hashing {
+
+/**
+ * Implementation of the wyhash (final version 3) non-cryptographic hashing algorithm
+ * with a 64bit digest.
+ *
+ * Its 64x64->128 multiply core runs near memory bandwidth on large inputs -
+ * several times the throughput of Murmur3 - which makes it the algorithm of
+ * choice for checksumming bulk payloads for dedup and integrity purposes.
+ * It offers no cryptographic guarantees whatsoever.
+ */
+class Wyhash64 :
+        public HashingAlgorithm {
+public:
+    using HashingAlgorithm::size_type;
+
+public:
+
+    using HashingAlgorithm::update;
+
+    Wyhash64(uint64 seed = 0);
+
+    /**
+     * Get a string name of the hashing algorithm.
+     * @return A string name of the hashing algorithm.
+     */
+    String getAlgorithm() const override;
+
+    /**
+     * Get a length of the digest in bytes.
+     * @return Length of the digest produced by this algorithm.
+     */
+    size_type getDigestLength() const override;
+
+    /**
+     * Update the digest with the given input.
+     * @param input A memory view to read data from.
+     * @return A reference to self for a fluent interface.
+     */
+    HashingAlgorithm& update(ImmutableMemoryView input) override;
+
+    /*
+     * Completes the hash computation by performing final operations such as padding.
+     * @return An array of bytes representing message digest.
+     */
+    MessageDigest digest() override;
+
+private:
+    uint64  _seed;
+    uint64  _hash;
+};
+
+
+/** Compute the wyhash 64-bit hash of a key in one call.
+ * Produces the same value as Wyhash64 over the same bytes, with no hasher
+ * object and no MessageDigest allocation.
+ *
+ * @param key Bytes to hash.
+ * @param seed A seed value for the hash.
+ * @return 64-bit hash of the given key.
+ */
+uint64 wyhash64(ImmutableMemoryView key, uint64 seed = 0) noexcept;
+
+
+}  // End of namespace hashing
+}  // End of namespace Solace
+#endif  // SOLACE_HASHING_WYHASH_HPP
@@ -27,8 +27,13 @@
 
 #include "solace/types.hpp"
 #include "solace/assert.hpp"
+#include "solace/optional.hpp"
 #include "solace/utils.hpp"
 
+#include <cstdint>      // std::uintptr_t
+#include <cstring>      // memcmp
+#include <type_traits>  // std::make_unsigned
+
 namespace Solace {
 
 /**
@@ -38,6 +43,58 @@ namespace Solace {
 bool isBigendian() noexcept;
 
 
+/**
+ * Reverse the byte order of a fixed-width integer.
+ * Written as shifts so that compilers lower it to a single bswap instruction
+ * (or a shuffle when the loop around it is vectorized).
+ * @return The value with its bytes reversed.
+ */
+constexpr uint8 byteSwap(uint8 value) noexcept {
+    return value;
+}
+
+constexpr uint16 byteSwap(uint16 value) noexcept {
+    return static_cast<uint16>((value << 8) | (value >> 8));
+}
+
+constexpr uint32 byteSwap(uint32 value) noexcept {
+    return  ((value & 0x000000FFu) << 24) |
+            ((value & 0x0000FF00u) <<  8) |
+            ((value & 0x00FF0000u) >>  8) |
+            ((value & 0xFF000000u) >> 24);
+}
+
+constexpr uint64 byteSwap(uint64 value) noexcept {
+    return  ((value & 0x00000000000000FFu) << 56) |
+            ((value & 0x000000000000FF00u) << 40) |
+            ((value & 0x0000000000FF0000u) << 24) |
+            ((value & 0x00000000FF000000u) <<  8) |
+            ((value & 0x000000FF00000000u) >>  8) |
+            ((value & 0x0000FF0000000000u) >> 24) |
+            ((value & 0x00FF000000000000u) >> 40) |
+            ((value & 0xFF00000000000000u) >> 56);
+}
+
+/** Byte-order reversal for signed integers, via the unsigned representation. */
+template<typename T>
+constexpr T byteSwap(T value) noexcept {
+    using U = typename std::make_unsigned<T>::type;
+
+    return static_cast<T>(byteSwap(static_cast<U>(value)));
+}
+
+
+/** The head/body/tail decomposition produced by alignedSliceFor().
+ * @see ImmutableMemoryView::alignedSliceFor() for the contract.
+ */
+template<typename ViewType>
+struct AlignedSplit {
+    ViewType head;  //!< Unaligned prefix: process element-wise.
+    ViewType body;  //!< Aligned to alignof(T), a whole number of T: the vector loop.
+    ViewType tail;  //!< Remainder after the body: process element-wise.
+};
+
+
 /* Read-only view into a fixed-length raw memory buffer.
  * A very thin abstruction on top of raw memory address -
  * it remembers memory block address and size.
@@ -125,12 +182,8 @@ public:
             return false;
         }
 
-        for (size_type i = 0; i < _size; ++i) {
-            if (_dataAddress[i] != other._dataAddress[i])
-                return false;
-        }
-
-        return true;
+        // memcmp compares a word - or a vector register - at a time.
+        return (memcmp(_dataAddress, other._dataAddress, _size) == 0);
     }
 
     bool empty() const noexcept {
@@ -163,6 +216,16 @@ public:
     }
 
 
+    /** Find the first occurrence of the given byte value.
+     * Scanning runs at memory bandwidth rather than a byte per iteration,
+     * which matters when looking for frame boundaries in large capture buffers.
+     *
+     * @param value A byte value to search for.
+     * @param fromOffset An offset to start the search from.
+     * @return Optional offset of the first occurrence of the value.
+     */
+    Optional<size_type> findFirstOf(value_type value, size_type fromOffset = 0) const;
+
     value_type first() const noexcept { return _dataAddress[0]; }
     value_type last()  const noexcept { return _dataAddress[size() - 1]; }
 
@@ -184,6 +247,46 @@ public:
 
 
 
+    /** Alignment of the start address: the largest power of two dividing it.
+     *
+     * Vectorized consumers need this to pick between aligned and unaligned
+     * load paths; exposing it here keeps the pointer-cast arithmetic out of
+     * every kernel. @see alignedSliceFor() for the usual decomposition.
+     *
+     * @return The alignment of the start address in bytes, 0 for a null view.
+     */
+    size_type alignment() const noexcept {
+        auto const address = reinterpret_cast<std::uintptr_t>(_dataAddress);
+
+        return static_cast<size_type>(address & (~address + 1));
+    }
+
+    /** Carve this view into the standard head/body/tail shape of a vector kernel.
+     *
+     * The body starts at the first alignof(T)-aligned address and spans a
+     * whole number of T, so a SIMD loop can use aligned loads over it without
+     * any per-call pointer arithmetic; head and tail are the (possibly empty)
+     * scalar fringes. The three slices are adjacent and cover the view exactly.
+     *
+     * @return Head, aligned body and tail slices of this view.
+     */
+    template<typename T>
+    AlignedSplit<ImmutableMemoryView> alignedSliceFor() const {
+        auto const address = reinterpret_cast<std::uintptr_t>(_dataAddress);
+        auto const misfit = address % alignof(T);
+
+        auto const headSize = (misfit != 0) ? static_cast<size_type>(alignof(T) - misfit) : 0;
+        if (headSize >= _size) {
+            return { slice(0, _size), slice(_size, _size), slice(_size, _size) };
+        }
+
+        auto const bodySize = ((_size - headSize) / sizeof(T)) * sizeof(T);
+
+        return {    slice(0, headSize),
+                    slice(headSize, headSize + bodySize),
+                    slice(headSize + bodySize, _size) };
+    }
+
     /**  Create a slice/window view of this memory segment.
      *
      * @param from [in] Offset to begin the slice from.
@@ -208,6 +311,14 @@ private:
     byte const*                 _dataAddress{nullptr};
 };
 
+/** A view of no memory - the default state - backs a compact Optional. */
+template <>
+struct OptionalSentinel<ImmutableMemoryView> : std::true_type {
+    static ImmutableMemoryView makeNull() noexcept { return ImmutableMemoryView{}; }
+    static bool isNull(ImmutableMemoryView const& view) noexcept { return (view.dataAddress() == nullptr); }
+};
+
+
 
 /**
  * Wrap an memory pointer into a memory view object.
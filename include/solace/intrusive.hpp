@@ -0,0 +1,432 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Intrusive containers
+ *	@file		solace/intrusive.hpp
+ *	@brief		Member-hook list and hashtable that never allocate on insert
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_INTRUSIVE_HPP
+#define SOLACE_INTRUSIVE_HPP
+
+#include "solace/types.hpp"
+#include "solace/assert.hpp"
+#include "solace/hashMap.hpp"   // hashOf() / keyEquals() protocol
+
+
+namespace Solace {
+
+/**
+ * The link state a type embeds - one per list it can be on - to become
+ * storable in an IntrusiveList. The hook is the node: inserting an object
+ * wires its hook into the chain and allocates nothing, so objects carved
+ * out of a preallocated slab can move between lists at pointer-swap cost.
+ *
+ * A hook unlinks itself on destruction, so destroying a linked object is
+ * safe; the list it was on simply no longer contains it. It is the caller's
+ * job to ensure no other thread is traversing that list at the time -
+ * intrusive containers are as thread-safe as a raw pointer.
+ */
+class IntrusiveListHook {
+public:
+
+    ~IntrusiveListHook() {
+        unlink();
+    }
+
+    constexpr IntrusiveListHook() noexcept = default;
+
+    // A hook pins its object's identity inside a chain - it cannot be copied
+    // or moved; move the object between lists with unlink() / insert instead.
+    IntrusiveListHook(IntrusiveListHook const&) = delete;
+    IntrusiveListHook& operator= (IntrusiveListHook const&) = delete;
+
+    /** Is this hook currently wired into a list? */
+    constexpr bool isLinked() const noexcept {
+        return (_next != nullptr);
+    }
+
+    /** Remove this hook from whatever list it is on, in O(1).
+     * No-op when not linked. Prefer IntrusiveList::erase() when the list is
+     * at hand, as only the list can keep its size() honest; self-unlinking
+     * is a safety net for destructors, where it keeps the chain intact at
+     * the cost of an overstated count.
+     */
+    void unlink() noexcept {
+        if (!isLinked())
+            return;
+
+        _prev->_next = _next;
+        _next->_prev = _prev;
+        _next = nullptr;
+        _prev = nullptr;
+    }
+
+private:
+
+    template<typename T, IntrusiveListHook T::* HookMember>
+    friend class IntrusiveList;
+
+    void linkBetween(IntrusiveListHook* prev, IntrusiveListHook* next) noexcept {
+        _prev = prev;
+        _next = next;
+        prev->_next = this;
+        next->_prev = this;
+    }
+
+    IntrusiveListHook*  _prev {nullptr};
+    IntrusiveListHook*  _next {nullptr};
+};
+
+
+/** Intrusive doubly-linked list aka IntrusiveList.
+ * The container owns no storage at all: it is two pointers and a count, and
+ * the chain runs through IntrusiveListHook members embedded in the objects
+ * themselves. insert and erase are O(1) pointer splices with zero allocation,
+ * which is what makes it fit for tens of thousands of connection states in a
+ * slab - and moveToBack() gives the O(1) "touch" an LRU idle-timeout scan
+ * needs: keep the list ordered by last activity, touch on traffic, and expire
+ * from the front.
+ *
+ * The list does not own its elements; erase unlinks, it never destroys.
+ * An object may be on several lists at once through different hook members.
+ *
+ * Usage:
+ * @code
+ *  struct Connection {
+ *      IntrusiveListHook   idleHook;
+ *      ...
+ *  };
+ *
+ *  IntrusiveList<Connection, &Connection::idleHook> idleQueue;
+ *  idleQueue.pushBack(conn);           // conn is now the most recently used
+ *  idleQueue.moveToBack(conn);         // on activity
+ *  auto* oldest = idleQueue.front();   // expiry candidate
+ * @endcode
+ */
+template<typename T, IntrusiveListHook T::* HookMember>
+class IntrusiveList {
+public:
+    using value_type = T;
+    using size_type = uint32;
+
+public:
+
+    ~IntrusiveList() {
+        clear();
+    }
+
+    /** Construct an empty list. */
+    IntrusiveList() noexcept {
+        _head._next = &_head;
+        _head._prev = &_head;
+    }
+
+    IntrusiveList(IntrusiveList const&) = delete;
+    IntrusiveList& operator= (IntrusiveList const&) = delete;
+
+    /** Construct a new list taking over the chain of a given one. */
+    IntrusiveList(IntrusiveList&& rhs) noexcept : IntrusiveList() {
+        if (!rhs.empty()) {
+            adoptChainOf(rhs);
+        }
+    }
+
+    IntrusiveList& operator= (IntrusiveList&& rhs) noexcept {
+        clear();
+        if (!rhs.empty()) {
+            adoptChainOf(rhs);
+        }
+
+        return *this;
+    }
+
+
+    bool empty() const noexcept {
+        return (_head._next == &_head);
+    }
+
+    size_type size() const noexcept {
+        return _count;
+    }
+
+    /** Link the given object at the back of the list. The object must not be
+     * linked into any list through this hook already. */
+    void pushBack(T& item) noexcept {
+        hookOf(item).linkBetween(_head._prev, &_head);
+        ++_count;
+    }
+
+    /** Link the given object at the front of the list. The object must not be
+     * linked into any list through this hook already. */
+    void pushFront(T& item) noexcept {
+        hookOf(item).linkBetween(&_head, _head._next);
+        ++_count;
+    }
+
+    /** Unlink the given object from this list in O(1). */
+    void erase(T& item) noexcept {
+        if (hookOf(item).isLinked()) {
+            hookOf(item).unlink();
+            --_count;
+        }
+    }
+
+    /** Re-link an already linked object at the back, in O(1).
+     * This is the LRU touch: the back of the list is the most recently used
+     * end, so the front is always the expiry candidate. */
+    void moveToBack(T& item) noexcept {
+        auto& hook = hookOf(item);
+        hook.unlink();
+        hook.linkBetween(_head._prev, &_head);
+    }
+
+    /** The first object on the list, or nullptr when empty. */
+    T* front() noexcept {
+        return empty() ? nullptr : ownerOf(_head._next);
+    }
+
+    /** The last object on the list, or nullptr when empty. */
+    T* back() noexcept {
+        return empty() ? nullptr : ownerOf(_head._prev);
+    }
+
+    /** Unlink and return the first object, or nullptr when empty. */
+    T* popFront() noexcept {
+        if (empty())
+            return nullptr;
+
+        auto* first = _head._next;
+        first->unlink();
+        --_count;
+
+        return ownerOf(first);
+    }
+
+    /** Unlink every element. The elements themselves are not touched. */
+    void clear() noexcept {
+        while (_head._next != &_head) {
+            _head._next->unlink();
+        }
+
+        _count = 0;
+    }
+
+
+    class Iterator {
+    public:
+        Iterator(IntrusiveListHook* position) noexcept : _position(position) {}
+
+        T& operator* () const noexcept  { return *ownerOf(_position); }
+        T* operator-> () const noexcept { return ownerOf(_position); }
+
+        Iterator& operator++ () noexcept {
+            _position = _position->_next;
+            return *this;
+        }
+
+        bool operator== (Iterator const& rhs) const noexcept { return (_position == rhs._position); }
+        bool operator!= (Iterator const& rhs) const noexcept { return (_position != rhs._position); }
+
+    private:
+        IntrusiveListHook* _position;
+    };
+
+    Iterator begin() noexcept   { return Iterator(_head._next); }
+    Iterator end() noexcept     { return Iterator(&_head); }
+
+private:
+
+    static IntrusiveListHook& hookOf(T& item) noexcept {
+        return item.*HookMember;
+    }
+
+    /** Recover the owning object from a pointer to its embedded hook. */
+    static T* ownerOf(IntrusiveListHook* hook) noexcept {
+        // The classic container_of: the hook's offset inside T is fixed by
+        // the member pointer, so step back from the hook to the object.
+        const auto offset = reinterpret_cast<char*>(&(reinterpret_cast<T*>(0)->*HookMember))
+                          - reinterpret_cast<char*>(0);
+
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - offset);
+    }
+
+    void adoptChainOf(IntrusiveList& rhs) noexcept {
+        _head._next = rhs._head._next;
+        _head._prev = rhs._head._prev;
+        _head._next->_prev = &_head;
+        _head._prev->_next = &_head;
+        _count = rhs._count;
+
+        rhs._head._next = &rhs._head;
+        rhs._head._prev = &rhs._head;
+        rhs._count = 0;
+    }
+
+    IntrusiveListHook   _head;
+    size_type           _count {0};
+};
+
+
+/**
+ * The link state a type embeds to become storable in an IntrusiveHashtable.
+ * A single forward pointer: bucket chains are singly linked, so the table
+ * spends 8 bytes per object and per bucket head, nothing more.
+ */
+class IntrusiveHashHook {
+public:
+    constexpr IntrusiveHashHook() noexcept = default;
+
+    IntrusiveHashHook(IntrusiveHashHook const&) = delete;
+    IntrusiveHashHook& operator= (IntrusiveHashHook const&) = delete;
+
+private:
+
+    template<typename T, typename K, K T::* KeyMember, IntrusiveHashHook T::* HookMember, uint32 NBuckets>
+    friend class IntrusiveHashtable;
+
+    IntrusiveHashHook*  _next {nullptr};
+};
+
+
+/** Intrusive chained hashtable aka IntrusiveHashtable.
+ * The bucket head array is inline in the table object and the chains run
+ * through IntrusiveHashHook members of the stored objects, so insert, find
+ * and erase never allocate. The key is a member of the object itself, named
+ * by the KeyMember pointer; keys are hashed through the hashOf() protocol
+ * shared with HashMap.
+ *
+ * The bucket count is part of the type and must be a power of two. Unlike
+ * HashMap the table never rehashes - chains just grow - so size NBuckets
+ * for the expected population: with tens of thousands of connections keyed
+ * by fd, 64K buckets cost 512KiB once and keep chains at ~1 entry.
+ *
+ * The table does not own its elements and erase never destroys. An object
+ * can be in an IntrusiveHashtable and on any number of IntrusiveLists at
+ * the same time, which is exactly the connection-registry-plus-LRU shape.
+ */
+template<typename T, typename K, K T::* KeyMember, IntrusiveHashHook T::* HookMember, uint32 NBuckets>
+class IntrusiveHashtable {
+    static_assert((NBuckets != 0) && ((NBuckets & (NBuckets - 1)) == 0),
+                  "IntrusiveHashtable: bucket count must be a power of two");
+
+public:
+    using value_type = T;
+    using key_type = K;
+    using size_type = uint32;
+
+public:
+
+    /** Construct an empty table. All the storage there will ever be is inline. */
+    IntrusiveHashtable() noexcept = default;
+
+    IntrusiveHashtable(IntrusiveHashtable const&) = delete;
+    IntrusiveHashtable& operator= (IntrusiveHashtable const&) = delete;
+
+
+    bool empty() const noexcept {
+        return (_count == 0);
+    }
+
+    size_type size() const noexcept {
+        return _count;
+    }
+
+    /** Link the given object into its key's bucket. The object must not be in
+     * any table through this hook already; duplicate keys are not checked. */
+    void insert(T& item) noexcept {
+        auto& head = bucketFor(item.*KeyMember);
+        (item.*HookMember)._next = head;
+        head = &(item.*HookMember);
+        ++_count;
+    }
+
+    /** Find the object stored under the given key.
+     * @return A pointer to the object, or nullptr if no such key.
+     */
+    template<typename Lookup>
+    T* find(Lookup const& key) noexcept {
+        for (auto* hook = bucketFor(key); hook != nullptr; hook = hook->_next) {
+            auto* candidate = ownerOf(hook);
+            if (details::keyEquals(candidate->*KeyMember, key)) {
+                return candidate;
+            }
+        }
+
+        return nullptr;
+    }
+
+    template<typename Lookup>
+    const T* find(Lookup const& key) const noexcept {
+        return const_cast<IntrusiveHashtable*>(this)->find(key);
+    }
+
+    /** Unlink the given object from the table.
+     * @return True if the object was found in its bucket and removed.
+     */
+    bool erase(T& item) noexcept {
+        auto** indirect = &bucketFor(item.*KeyMember);
+        for (; *indirect != nullptr; indirect = &((*indirect)->_next)) {
+            if (*indirect == &(item.*HookMember)) {
+                *indirect = (item.*HookMember)._next;
+                (item.*HookMember)._next = nullptr;
+                --_count;
+
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /** Unlink every element. The elements themselves are not touched. */
+    void clear() noexcept {
+        for (auto& head : _buckets) {
+            while (head != nullptr) {
+                auto* next = head->_next;
+                head->_next = nullptr;
+                head = next;
+            }
+        }
+
+        _count = 0;
+    }
+
+private:
+
+    template<typename Lookup>
+    IntrusiveHashHook*& bucketFor(Lookup const& key) noexcept {
+        return _buckets[hashOf(key) & (NBuckets - 1)];
+    }
+
+    template<typename Lookup>
+    IntrusiveHashHook* bucketFor(Lookup const& key) const noexcept {
+        return _buckets[hashOf(key) & (NBuckets - 1)];
+    }
+
+    static T* ownerOf(IntrusiveHashHook* hook) noexcept {
+        const auto offset = reinterpret_cast<char*>(&(reinterpret_cast<T*>(0)->*HookMember))
+                          - reinterpret_cast<char*>(0);
+
+        return reinterpret_cast<T*>(reinterpret_cast<char*>(hook) - offset);
+    }
+
+    IntrusiveHashHook*  _buckets[NBuckets] = {};
+    size_type           _count {0};
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_INTRUSIVE_HPP
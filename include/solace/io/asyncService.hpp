@@ -0,0 +1,139 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Future-returning async read/write over a Selector
+ *	@file		solace/io/asyncService.hpp
+ *	@author		$LastChangedBy$
+ *	@date		$LastChangedDate$
+ *	ID:			$Id$
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_ASYNCSERVICE_HPP
+#define SOLACE_IO_ASYNCSERVICE_HPP
+
+#include "solace/future.hpp"
+#include "solace/promise.hpp"
+#include "solace/memoryView.hpp"
+#include "solace/io/file.hpp"
+#include "solace/io/selector.hpp"
+
+#include <deque>
+#include <unordered_map>
+#include <vector>
+
+
+namespace Solace { namespace IO {
+
+/**
+ * The glue between the Selector and Future: readiness-driven reads and
+ * writes that hand back a future instead of making every call site keep
+ * its own poll-loop state machine.
+ *
+ * asyncRead()/asyncWrite() queue the operation, arm the selector for the
+ * descriptor and return immediately. A thread - typically the reactor -
+ * pumps poll(); each wakeup the service drains the descriptor until the
+ * operation would block again, completing every queued promise it can on
+ * the spot, so one wakeup pays for a whole batch of pending operations.
+ *
+ * Semantics follow the underlying stream calls: a read completes with
+ * whatever one read() returned, including 0 at end of stream; a write is
+ * held until the whole buffer is on its way, surviving short writes.
+ *
+ * The descriptors handed in must be in non-blocking mode - a blocking
+ * descriptor would turn the drain loop into a stall. The service is not
+ * thread safe: submissions and poll() belong to the reactor thread.
+ *
+ * @note The caller keeps File and buffer alive until the future
+ * completes - the service works on views and does not take ownership.
+ */
+class AsyncService {
+public:
+
+    using size_type = MemoryView::size_type;
+
+public:
+
+    /**
+     * Construct the service over the given selector.
+     * @param selector Selector to arm; the service takes it over.
+     */
+    explicit AsyncService(Selector&& selector) :
+        _selector(std::move(selector))
+    {}
+
+    AsyncService(const AsyncService&) = delete;
+    AsyncService& operator= (const AsyncService&) = delete;
+
+    /**
+     * Read into the buffer once the file has data.
+     * @param file File to read from; must be non-blocking.
+     * @param buffer Destination; alive until the future completes.
+     * @return A future of the number of bytes read; 0 means end of stream.
+     */
+    Future<size_type> asyncRead(File& file, MemoryView buffer);
+
+    /**
+     * Write the whole buffer as the file accepts it.
+     * @param file File to write to; must be non-blocking.
+     * @param buffer Source data; alive until the future completes.
+     * @return A future of the number of bytes written - the buffer size,
+     *  unless the descriptor errors part way.
+     */
+    Future<size_type> asyncWrite(File& file, ImmutableMemoryView buffer);
+
+    /**
+     * Wait for readiness and complete every operation that can make
+     * progress. Each ready descriptor is drained until it would block.
+     *
+     * @param msec Maximum wait in milliseconds, -1 for infinite, 0 to
+     *  only collect what is already ready.
+     * @return Number of operations completed this round.
+     */
+    uint32 poll(int msec = -1);
+
+    /** Number of operations queued and not yet completed. */
+    size_t outstanding() const noexcept;
+
+private:
+
+    struct Operation {
+        bool                    writing;
+        MemoryView              readInto;
+        ImmutableMemoryView     writeFrom;
+        size_type               progress;
+        Promise<size_type>      completion;
+    };
+
+    /** Pending operations of one descriptor, serviced in submission order. */
+    struct FdQueue {
+        std::deque<Operation>   operations;
+        int                     armedEvents {0};
+    };
+
+    void enqueue(ISelectable::poll_id fd, Operation&& op);
+    void rearm(ISelectable::poll_id fd, FdQueue& queue);
+    uint32 drain(ISelectable::poll_id fd, FdQueue& queue, int readyEvents);
+
+    Selector                                        _selector;
+    std::unordered_map<ISelectable::poll_id, FdQueue>   _queues;
+
+    //!< Scratch list of descriptors serviced in the current poll round.
+    std::vector<ISelectable::poll_id>               _touched;
+};
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_ASYNCSERVICE_HPP
@@ -0,0 +1,169 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Write-behind buffering for journal-style writers
+ *	@file		solace/io/bufferedWriter.hpp
+ *	@brief		Coalesces small writes into large syscalls on a flusher thread
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_BUFFEREDWRITER_HPP
+#define SOLACE_IO_BUFFEREDWRITER_HPP
+
+#include "solace/future.hpp"
+#include "solace/memoryManager.hpp"
+#include "solace/io/file.hpp"
+#include "solace/io/syncService.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A write-behind writer: callers append records to an in-memory buffer and a
+ * dedicated flusher thread turns them into large File writes, so a journal
+ * producing thousands of 200-byte records pays one syscall per buffer-full
+ * instead of one per record.
+ *
+ * Flushes are triggered three ways: the buffered amount crossing the
+ * watermark, a periodic timer so trickle traffic is not parked in memory
+ * indefinitely, and an explicit barrier(). A barrier returns a Future<void>
+ * that completes once everything written before it has been handed to the
+ * file - and, when the writer is given a SyncService, once it has been
+ * committed to stable storage by the group fdatasync as well.
+ *
+ * Records are copied into two buffers from the caller's MemoryManager, used
+ * alternately: writers fill one while the flusher drains the other, so under
+ * steady load neither side waits for the other. A writer blocks only when it
+ * outruns the device and both buffers are full - which is the backpressure a
+ * journal wants.
+ *
+ * Writes are byte-ordered: records appear in the file in the order write()
+ * accepted them, whatever thread they came from.
+ *
+ * @note The caller must keep the File open until the writer is stopped.
+ */
+class BufferedWriter {
+public:
+
+    using size_type = MemoryView::size_type;
+
+    /** Flush-trigger configuration. */
+    struct Options {
+        //!< Wake the flusher once this much is buffered.
+        size_type   flushWatermark {64 * 1024};
+
+        //!< Flush cadence for partially filled buffers, in milliseconds.
+        //!< Zero or negative waits for the watermark or a barrier only.
+        int32       flushIntervalMs {10};
+
+        //!< When set, barriers also commit the file to stable storage
+        //!< through the sync-batching service before completing.
+        SyncService* syncService {nullptr};
+    };
+
+public:
+
+    ~BufferedWriter();
+
+    /**
+     * Construct a writer over the given file and start its flusher thread.
+     *
+     * @param file File to write to. Must stay open until stop() returns.
+     * @param allocator Memory manager to draw the two staging buffers from.
+     * @param bufferSize Size of each staging buffer. Together with the device
+     *  write latency this bounds how much a writer can buffer ahead.
+     * @param options Flush-trigger configuration. @see Options
+     */
+    BufferedWriter(File& file, MemoryManager& allocator, size_type bufferSize, Options options);
+
+    /** @see BufferedWriter(File&, MemoryManager&, size_type, Options) - with default triggers. */
+    BufferedWriter(File& file, MemoryManager& allocator, size_type bufferSize) :
+        BufferedWriter(file, allocator, bufferSize, Options{})
+    {}
+
+    BufferedWriter(BufferedWriter const&) = delete;
+    BufferedWriter& operator= (BufferedWriter const&) = delete;
+
+    /**
+     * Append a record to the write-behind buffer.
+     *
+     * Returns as soon as the bytes are staged; blocks only when both staging
+     * buffers are full. Records larger than the staging buffer are accepted
+     * and staged in pieces.
+     *
+     * @param data Bytes to append.
+     * @return Nothing on success, an error once the writer is stopped or the
+     *  flusher has hit a write error.
+     */
+    Result<void, Error> write(ImmutableMemoryView data);
+
+    /**
+     * Mark a durability point.
+     *
+     * @return A future completed once every byte accepted by write() before
+     *  this call is in the file - and on stable storage, when the writer was
+     *  constructed with a SyncService. Fails if flushing fails.
+     */
+    Future<void> barrier();
+
+    /**
+     * Flush everything accepted so far and stop the flusher thread.
+     * Further write() and barrier() calls fail. Called by the destructor.
+     */
+    void stop();
+
+private:
+
+    void flusherLoop();
+
+private:
+
+    // At flush time every staged-but-unwritten byte sits in the buffer about
+    // to be drained, so any pending barrier is covered by that very round -
+    // no sequence bookkeeping needed.
+    struct BarrierRequest {
+        Promise<void>   completion;
+    };
+
+    File*           _file;
+    Options         _options;
+
+    size_type       _bufferSize;
+    MemoryBuffer    _buffers[2];
+
+    std::mutex                  _guard;
+    std::condition_variable     _workPending;   //!< Flusher waits here for bytes/barriers.
+    std::condition_variable     _spaceFreed;    //!< Writers wait here for a drained buffer.
+
+    uint32          _active {0};        //!< Buffer currently accepting writes.
+    size_type       _fill {0};          //!< Bytes staged in the active buffer.
+    uint64          _accepted {0};      //!< Bytes ever accepted by write().
+    int             _writeFailure {0};  //!< errno of the first failed flush, sticky.
+    bool            _stopped {false};
+
+    std::vector<BarrierRequest> _barriers;
+
+    std::thread     _flusher;
+};
+
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_BUFFEREDWRITER_HPP
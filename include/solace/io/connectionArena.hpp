@@ -0,0 +1,131 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Per-connection message arena
+ *	@file		solace/io/connectionArena.hpp
+ *	@brief		Arena-backed working memory for one reactor connection
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_CONNECTIONARENA_HPP
+#define SOLACE_IO_CONNECTIONARENA_HPP
+
+#include "solace/memoryManager.hpp"
+#include "solace/readBuffer.hpp"
+#include "solace/writeBuffer.hpp"
+
+
+namespace Solace { namespace IO {
+
+/**
+ * The working memory of one Selector-driven connection.
+ *
+ * A reactor that draws receive storage, parse temporaries and response
+ * buffers from one shared heap interleaves every connection's allocations
+ * with every other's; by the time a message is parsed its pieces are
+ * scattered across the cache. A ConnectionArena gives each connection a
+ * bump-pointer arena instead: everything a message needs comes out of one
+ * contiguous region, and messageComplete() reclaims the lot by rewinding
+ * an offset - no per-allocation frees, and the next message reuses the
+ * same cache-warm bytes.
+ *
+ * The intended shape is one ConnectionArena embedded in each connection
+ * object, reachable through the pointer registered with Selector::add()
+ * (@see Selector::Event::data): the event handler allocates freely while
+ * handling the message and calls messageComplete() once it is fully
+ * processed and the response handed to the kernel.
+ *
+ * @note messageComplete() invalidates every buffer handed out since the
+ * last reset, exactly like MemoryArena::reset(). Anything that must
+ * outlive the message - a connection-lifetime parse table, a queued
+ * response under backpressure - belongs in storage of its own, not here.
+ */
+class ConnectionArena {
+public:
+
+    using size_type = MemoryArena::size_type;
+
+public:
+
+    /**
+     * Construct an arena for one connection's messages.
+     *
+     * @param allocator Memory manager the arena's region is drawn from.
+     * @param arenaSize Size of the region: the working-set budget of one
+     *  message, scratch and response included.
+     */
+    ConnectionArena(MemoryManager& allocator, size_type arenaSize) :
+        _arena(allocator.createArena(arenaSize))
+    {}
+
+    ConnectionArena(ConnectionArena&&) noexcept = default;
+    ConnectionArena& operator= (ConnectionArena&&) noexcept = default;
+
+    ConnectionArena(ConnectionArena const&) = delete;
+    ConnectionArena& operator= (ConnectionArena const&) = delete;
+
+    /**
+     * Allocate message-lifetime memory: receive storage, parse temporaries.
+     * @param dataSize The size of the segment to allocate.
+     * @return A segment valid until messageComplete().
+     */
+    MemoryBuffer allocate(size_type dataSize) {
+        return _arena.create(dataSize);
+    }
+
+    /**
+     * A ReadBuffer for parsing bytes already received into arena storage.
+     * @param data The received bytes, typically a slice of allocate()'d storage.
+     * @return A ReadBuffer positioned at the start of the data.
+     */
+    ReadBuffer parse(ImmutableMemoryView data) {
+        return ReadBuffer(data);
+    }
+
+    /**
+     * A WriteBuffer for composing this message's response, arena-backed.
+     * @param dataSize Capacity of the response buffer.
+     * @return A WriteBuffer valid until messageComplete().
+     */
+    WriteBuffer response(size_type dataSize) {
+        return WriteBuffer(_arena.create(dataSize));
+    }
+
+    /**
+     * The current message is done: reclaim everything allocated for it.
+     * Invalidates all buffers handed out since the previous reset.
+     */
+    void messageComplete() noexcept {
+        _arena.reset();
+    }
+
+    /** @return Bytes allocated for the message in flight. */
+    size_type size() const noexcept {
+        return _arena.size();
+    }
+
+    /** @return The connection's working-set budget, in bytes. */
+    size_type capacity() const noexcept {
+        return _arena.capacity();
+    }
+
+private:
+
+    MemoryArena     _arena;
+};
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_CONNECTIONARENA_HPP
@@ -101,6 +101,16 @@ public:
         return _out.write(buffer);
     }
 
+    // Direct no-throw paths through the file ends: a would-block failure
+    // costs one ErrorCode, not an exception caught by the base adapter.
+    IOObject::TryResult tryRead(MemoryView& buffer) override {
+        return _in.tryRead(buffer);
+    }
+
+    IOObject::TryResult tryWrite(const ImmutableMemoryView& buffer) override {
+        return _out.tryWrite(buffer);
+    }
+
     bool isOpened() const override {
         return (_in.isOpened() || _out.isOpened());
     }
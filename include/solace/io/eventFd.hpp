@@ -0,0 +1,121 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: User-triggered Selector events
+ *	@file		solace/io/eventFd.hpp
+ *	@brief		eventfd-based cross-thread reactor wakeup
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_EVENTFD_HPP
+#define SOLACE_IO_EVENTFD_HPP
+
+#include "solace/types.hpp"
+#include "solace/io/selectable.hpp"
+
+#include <utility>  // std::swap
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A user-triggered event on the poll loop.
+ *
+ * The classic way to wake a reactor from another thread is a self-pipe:
+ * two fds and a kernel pipe buffer spent on a doorbell. EventFd is the
+ * eventfd-based replacement - a single fd holding a 64-bit counter that
+ * any thread bumps with notify() and the reactor drains with take() when
+ * the Selector reports the fd readable.
+ *
+ * In the default mode the counter is a level doorbell: however many times
+ * notify() fired since the last take(), one take() clears them all. In
+ * Semaphore mode each take() consumes a single count, so the counter
+ * tracks discrete work items posted to the reactor.
+ */
+class EventFd : public ISelectable {
+public:
+
+    /** How pending notifications are consumed. */
+    enum class Mode {
+        Event,      //!< take() clears the whole pending count: a wakeup doorbell.
+        Semaphore   //!< take() consumes one count per call: counted work items.
+    };
+
+public:
+
+    /**
+     * Create a new event object.
+     *
+     * @param mode Consumption semantics, @see Mode.
+     * @param initialValue Initial value of the counter.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    static EventFd create(Mode mode = Mode::Event, uint64 initialValue = 0);
+
+    ~EventFd() override;
+
+    EventFd(EventFd&& rhs) noexcept : _fd(rhs._fd) {
+        rhs._fd = ISelectable::InvalidFd;
+    }
+
+    EventFd& operator= (EventFd&& rhs) noexcept {
+        std::swap(_fd, rhs._fd);
+
+        return *this;
+    }
+
+    EventFd(EventFd const&) = delete;
+    EventFd& operator= (EventFd const&) = delete;
+
+    /**
+     * Post notifications, making the fd readable on the poll loop.
+     * Safe to call from any thread.
+     *
+     * @param count Number of counts to add; 1 for a plain wakeup.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    void notify(uint64 count = 1);
+
+    /**
+     * Consume pending notifications, without blocking.
+     *
+     * @return Count consumed: the whole pending total in Event mode, at
+     * most 1 in Semaphore mode, 0 when nothing is pending.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    uint64 take();
+
+    /** Get fd to register with a Selector for Read events. */
+    poll_id getSelectId() const override {
+        return _fd;
+    }
+
+protected:
+
+    explicit EventFd(poll_id fd) noexcept : _fd(fd)
+    {}
+
+private:
+
+    poll_id     _fd;
+};
+
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_EVENTFD_HPP
@@ -26,6 +26,9 @@
 
 #include "solace/ioobject.hpp"
 #include "solace/path.hpp"
+#include "solace/arrayView.hpp"
+#include "solace/compositeMemoryView.hpp"
+#include "solace/memoryBuffer.hpp"
 
 
 #include "solace/io/selectable.hpp"
@@ -101,10 +104,38 @@ public:
 		End
 	};
 
+    /** Desired protection of a mapped region.
+     * It is either None for no protection or the bitwise OR of one or more of the flags.
+     */
+    struct MapProtection {
+        static const int None;   //!< Pages may not be accessed.
+        static const int Exec;   //!< Pages may be executed.
+        static const int Read;   //!< Pages may be read.
+        static const int Write;  //!< Pages may be written.
+    };
+
+    /** Sharing mode of a mapped region. */
+    enum class MapSharing {
+        Shared,     //!< Updates to the mapping are carried through to the underlying file.
+        Private     //!< Create a private copy-on-write mapping.
+    };
+
+    /** Expected access pattern of a mapped region, passed to the kernel as an madvise() hint. */
+    enum class MapAdvice {
+        Normal,     //!< No special treatment.
+        Sequential, //!< Expect sequential access: the kernel can read ahead aggressively.
+        Random,     //!< Expect random access: read ahead is likely useless.
+        WillNeed,   //!< Expect access in the near future: prefetch the pages.
+        DontNeed    //!< Do not expect access in the near future: pages can be dropped.
+    };
+
 
     using size_type = ssize_t;
 	using ISelectable::poll_id;
 
+    /** Maximum number of buffers a single vectored read/write call processes. */
+    static constexpr uint32 MaxIOSegments = 64;
+
 public:
 
 //    using IOObject::operator !;
@@ -196,6 +227,21 @@ public:
     IOResult read(MemoryView& buffer) override;
 
 
+    /** Read data from this file into every buffer of the given list, in order.
+     *
+     * The buffer list is mapped directly onto a readv() system call, so the
+     * data is scattered into the buffers without an intermediate copy.
+     * At most MaxIOSegments buffers are filled per call; fewer bytes than the
+     * total buffer space indicates a short read as with read().
+     *
+     * @param buffers Buffers to fill, in order.
+     * @return Number of bytes actually read across all buffers.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    IOResult read(ArrayView<MemoryView> buffers);
+
+
     /** Write data from the given byte buffer into this file object.
      *
      * @param data Bytes to write into this file object.
@@ -208,6 +254,113 @@ public:
     IOResult write(const ImmutableMemoryView& buffer) override;
 
 
+    /** Read data from the file reporting errors through the result, never thrown.
+     * A direct no-throw path: would-block and interrupted calls come back as a
+     * cheap system ErrorCode instead of an IOException.
+     * @see IOObject::tryRead() for the contract.
+     *
+     * @param buffer Byte buffer to read data into.
+     * @return Number of bytes actually read, or a system error code.
+     */
+    TryResult tryRead(MemoryView& buffer) override;
+
+
+    /** Write data into the file reporting errors through the result, never thrown.
+     * @see File::tryRead() and IOObject::tryWrite() for the contract.
+     *
+     * @param buffer Bytes to write into this file object.
+     * @return Number of bytes actually writen, or a system error code.
+     */
+    TryResult tryWrite(const ImmutableMemoryView& buffer) override;
+
+
+    /** Write all segments of a composite view into this file in one call.
+     *
+     * The segment list is mapped directly onto a writev() system call, so a
+     * multi-segment message goes out without being copied into a contiguous
+     * buffer first.
+     *
+     * @param buffer Segments to write, in order.
+     * @return Number of bytes actually writen across all segments.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    IOResult write(const CompositeMemoryView& buffer);
+
+
+    /** Read data from the given absolute offset without touching the file position.
+     *
+     * Maps onto pread(), so any number of threads can issue concurrent reads
+     * on one file descriptor with no seek serialization between them.
+     *
+     * @param offset Absolute offset in the file to read from.
+     * @param buffer Byte buffer to read data into.
+     * @return Number of bytes actually read.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    IOResult readAt(size_type offset, MemoryView& buffer);
+
+
+    /** Write data at the given absolute offset without touching the file position.
+     *
+     * Maps onto pwrite(). @see File::readAt()
+     *
+     * @param offset Absolute offset in the file to write at.
+     * @param buffer Bytes to write into this file object.
+     * @return Number of bytes actually writen.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    IOResult writeAt(size_type offset, const ImmutableMemoryView& buffer);
+
+
+    /** Transfer bytes from this file directly into another file descriptor.
+     *
+     * The transfer is performed in-kernel via sendfile(), falling back to
+     * splice() through a pipe intermediary where sendfile does not apply, so
+     * bulk replay of file content to a downstream consumer never copies the
+     * data through userspace. The file position advances by the number of
+     * bytes transfered, as with read().
+     *
+     * @param dest Destination to transfer the bytes into.
+     * @param bytesToTransfer Number of bytes to transfer.
+     * @return Number of bytes actually transfered, which can be less on EOF.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    IOResult transferTo(ISelectable& dest, size_type bytesToTransfer);
+
+
+    /** Map a region of this file into memory.
+     *
+     * Reading a large read-mostly file through a mapping avoids copying its
+     * content through heap buffers: pages come straight from the page cache.
+     * The returned buffer owns the mapping and unmaps it when destroyed.
+     *
+     * @param offset Offset in the file to map from. Must be a multiple of the page size.
+     * @param mapSize Number of bytes to map.
+     * @param sharing Whether updates propagate to the file. @see File::MapSharing
+     * @param protection Mapped page protection. @see File::MapProtection
+     * @return A memory buffer owning the mapped region.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    MemoryBuffer map(size_type offset, MemoryView::size_type mapSize,
+                     MapSharing sharing = MapSharing::Private,
+                     int protection = MapProtection::Read);
+
+
+    /** Advise the kernel about the expected access pattern of a mapped region.
+     *
+     * @param mapping A mapped region, e.g. the view of a buffer returned by map().
+     * @param advice Expected access pattern. @see File::MapAdvice
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    static void advise(const ImmutableMemoryView& mapping, MapAdvice advice);
+
+
 	/*
 	 * Attempt to move current position in the file stream
 	*/
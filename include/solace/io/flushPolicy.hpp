@@ -0,0 +1,177 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Nagle-style batching policy for buffered egress
+ *	@file		solace/io/flushPolicy.hpp
+ *	@brief		Flush-now-vs-coalesce decisions for a WriteBuffer
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_FLUSHPOLICY_HPP
+#define SOLACE_IO_FLUSHPOLICY_HPP
+
+#include "solace/delegate.hpp"
+#include "solace/writeBuffer.hpp"
+#include "solace/io/timerWheel.hpp"
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A Nagle-style batching policy for egress staged in a WriteBuffer: messages
+ * coalesce until the buffer fill, the batched message count or a max-delay
+ * deadline trips, and then the flush delegate runs once for the whole batch.
+ * The watermarks cap how much latency bulk traffic can accumulate, the
+ * deadline caps how long a lone message can sit - the usual scattered
+ * flush-here-maybe heuristics collapse into one tunable object.
+ *
+ * The deadline is a TimerWheel entry scheduled when the first message of a
+ * batch is staged, so an idle policy costs nothing. The wheel delivers the
+ * policy pointer as the event payload; the event loop routes it back:
+ *
+ * @code{.cpp}
+ * FlushPolicy policy(egress, timers, {64 * 1024, 64, 1},
+ *                    FlushPolicy::FlushHandler([&]() { drain(egress); }));
+ * ...
+ * egress.write(message);
+ * policy.onMessage();             // May invoke the flush delegate inline
+ * ...
+ * for (auto event : selector.poll()) {
+ *     if (event.fd == timers.getSelectId()) {
+ *         Selector::Event expired[16];
+ *         const auto count = timers.expire(arrayView(expired));
+ *         for (TimerWheel::size_type i = 0; i < count; ++i) {
+ *             static_cast<FlushPolicy*>(expired[i].data)->expired();
+ *         }
+ *     }
+ * }
+ * @endcode
+ *
+ * The policy is a single-threaded object: stage, expire and flush on the
+ * thread driving the wheel.
+ */
+class FlushPolicy {
+public:
+
+    using size_type = WriteBuffer::size_type;
+
+    /** Invoked to drain the buffer when any trigger fires. */
+    using FlushHandler = delegate<void()>;
+
+    /** Batching triggers. A flush fires when any one of them trips. */
+    struct Options {
+        //!< Flush once this much is staged in the buffer.
+        size_type   byteWatermark {64 * 1024};
+
+        //!< Flush once this many messages are batched.
+        uint32      messageWatermark {64};
+
+        //!< Flush this long after the first message of a batch, at the
+        //!< latest, in milliseconds. Zero disables the deadline and leaves
+        //!< the watermarks (or explicit flush() calls) as the only triggers.
+        uint64      maxDelayMs {1};
+    };
+
+public:
+
+    ~FlushPolicy() {
+        disarm();
+    }
+
+    FlushPolicy(const FlushPolicy&) = delete;
+    FlushPolicy& operator= (const FlushPolicy&) = delete;
+
+    /**
+     * Create a policy for the given egress buffer.
+     *
+     * @param buffer Buffer the messages are staged into.
+     * @param timers Timer wheel to schedule the max-delay deadline over.
+     * @param options Batching triggers. @see Options
+     * @param onFlush Delegate draining the buffer. Runs inline from
+     *  onMessage(), expired() or flush() whenever a trigger fires.
+     */
+    FlushPolicy(WriteBuffer& buffer, TimerWheel& timers, Options options, FlushHandler&& onFlush) :
+        _buffer(buffer),
+        _timers(timers),
+        _options(options),
+        _onFlush(std::move(onFlush))
+    {}
+
+    /**
+     * Account for one message staged into the buffer.
+     * Arms the deadline for the first message of a batch and invokes the
+     * flush delegate right away if a watermark trips.
+     */
+    void onMessage() {
+        _nbBatched += 1;
+        if (_nbBatched == 1 && _options.maxDelayMs > 0) {
+            _deadline = _timers.schedule(_options.maxDelayMs, this);
+            _armed = true;
+        }
+
+        if (_nbBatched >= _options.messageWatermark || _buffer.position() >= _options.byteWatermark) {
+            flush();
+        }
+    }
+
+    /**
+     * The max-delay deadline has passed: flush whatever has batched.
+     * To be called by the event loop for wheel events carrying this policy.
+     */
+    void expired() {
+        _armed = false;
+        flush();
+    }
+
+    /** Flush unconditionally - shutdown, barriers and the like. No-op when nothing is batched. */
+    void flush() {
+        if (_nbBatched == 0) {
+            return;
+        }
+
+        disarm();
+        _nbBatched = 0;
+        _onFlush();
+    }
+
+    /** Number of messages batched since the last flush. */
+    uint32 batched() const noexcept {
+        return _nbBatched;
+    }
+
+private:
+
+    void disarm() {
+        if (_armed) {
+            _timers.cancel(_deadline);
+            _armed = false;
+        }
+    }
+
+private:
+
+    WriteBuffer&    _buffer;
+    TimerWheel&     _timers;
+    Options         _options;
+    FlushHandler    _onFlush;
+
+    uint32                  _nbBatched {0};
+    TimerWheel::timer_id    _deadline {0};
+    bool                    _armed {false};
+};
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_FLUSHPOLICY_HPP
@@ -0,0 +1,136 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Cross-process wait/notify primitive
+ *	@file		solace/io/futexCell.hpp
+ *	@brief		Futex-backed waitable cell placed inside a shared mapping
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_FUTEXCELL_HPP
+#define SOLACE_IO_FUTEXCELL_HPP
+
+#include "solace/memoryView.hpp"
+
+#include <atomic>
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A waitable 32-bit cell for cross-process coordination over shared memory.
+ *
+ * The cell is a plain 4-byte value that lives *inside* a SharedMemory mapping
+ * - place one with FutexCell::at() on each side - and adds blocking on top:
+ * wait() puts the caller to sleep in the kernel while the cell still holds an
+ * expected value, and wakeOne()/wakeAll() rouse sleepers after a store. Built
+ * directly on the futex system call, so the uncontended path is a single
+ * atomic operation with no syscall at all, and a wakeup costs one syscall on
+ * each side - no pipe round-trip, no spinning.
+ *
+ * The load/store/exchange accessors are ordinary atomics on the shared word;
+ * the usual protocol is: producer stores a new value then wakes, consumer
+ * loads, and waits passing the value it saw. The futex compare in wait()
+ * closes the race - if the producer got in between the load and the wait,
+ * the wait returns immediately instead of sleeping through the update.
+ */
+class FutexCell {
+public:
+    using value_type = uint32;
+
+public:
+
+    /**
+     * Get a cell living at the start of the given memory view,
+     * typically a slice of a SharedMemory mapping.
+     *
+     * @param view Memory to place the cell over. Must hold at least 4 bytes
+     *  aligned to 4; the mapping itself is page aligned so any 4-byte-aligned
+     *  slice will do.
+     *
+     * @throws IllegalArgumentException if the view is too small or misaligned.
+     */
+    static FutexCell& at(MemoryView view);
+
+    FutexCell(FutexCell const&) = delete;
+    FutexCell& operator= (FutexCell const&) = delete;
+
+    /** Initialise the cell to the given value. Call once, on the creating side only. */
+    void initialize(value_type initialValue = 0) noexcept {
+        _value.store(initialValue, std::memory_order_release);
+    }
+
+    /** Read the current value. */
+    value_type load() const noexcept {
+        return _value.load(std::memory_order_acquire);
+    }
+
+    /** Store a new value. Does not wake waiters - follow with wakeOne()/wakeAll(). */
+    void store(value_type newValue) noexcept {
+        _value.store(newValue, std::memory_order_release);
+    }
+
+    /** Store a new value and return the previous one. */
+    value_type exchange(value_type newValue) noexcept {
+        return _value.exchange(newValue, std::memory_order_acq_rel);
+    }
+
+    /** Atomically add to the value and return the previous one. */
+    value_type fetchAdd(value_type increment) noexcept {
+        return _value.fetch_add(increment, std::memory_order_acq_rel);
+    }
+
+    /**
+     * Block while the cell holds the expected value.
+     *
+     * Returns when the value is (or becomes) different from expected, or on
+     * timeout. Spurious-wakeup safe: the kernel re-checks the value before
+     * sleeping, so a store between the caller's load and the wait is never
+     * missed.
+     *
+     * @param expected The value the caller last saw; sleep while it persists.
+     * @param timeoutMs Time to wait in milliseconds, or a negative value to wait forever.
+     * @return True if the value changed, false if the wait timed out.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    bool wait(value_type expected, int timeoutMs = -1);
+
+    /**
+     * Wake at most one process sleeping in wait() on this cell.
+     * @return Number of waiters woken, 0 or 1.
+     */
+    int wakeOne();
+
+    /**
+     * Wake every process sleeping in wait() on this cell.
+     * @return Number of waiters woken.
+     */
+    int wakeAll();
+
+private:
+
+    FutexCell() noexcept = default;
+
+    std::atomic<value_type> _value;
+};
+
+static_assert(sizeof(FutexCell) == sizeof(FutexCell::value_type),
+              "FutexCell must be exactly the futex word");
+
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_FUTEXCELL_HPP
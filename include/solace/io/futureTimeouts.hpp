@@ -0,0 +1,250 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Timeout combinator for futures, driven by a timer wheel
+ *	@file		solace/io/futureTimeouts.hpp
+ *	@brief		Deadline enforcement for Future via TimerWheel
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_FUTURETIMEOUTS_HPP
+#define SOLACE_IO_FUTURETIMEOUTS_HPP
+
+#include "solace/future.hpp"
+#include "solace/io/timerWheel.hpp"
+
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
+
+namespace Solace { namespace IO {
+
+/**
+ * Deadline enforcement for futures: within() wraps a future into one that is
+ * completed with the source's value - or its error, through the normal
+ * onError path - if the source resolves in time, and with a timeout Error
+ * otherwise. All deadlines of one adapter are multiplexed over a single
+ * TimerWheel, so a timeout costs an O(1) schedule and no extra fd.
+ *
+ * @code{.cpp}
+ * TimerWheel timers(10);
+ * FutureTimeouts timeouts(timers);
+ * selector.add(&timers, Selector::Read);
+ *
+ * timeouts.within(rpc.call(request), 3000)
+ *     .then([](Response response) { ... })
+ *     .onError([](Error&& e) { ... timed out or failed ... });
+ * ...
+ * for (auto event : selector.poll()) {
+ *     if (event.fd == timers.getSelectId()) {
+ *         timeouts.expire();
+ *     }
+ * }
+ * @endcode
+ *
+ * The adapter owns the per-deadline state and must be the one draining its
+ * wheel: expire() consumes every expiration the wheel has collected. Tests
+ * drive deadlines without real delays via TimerWheel::advance() followed by
+ * expire().
+ *
+ * When a deadline fires first the wrapped promise is failed and its storage
+ * is released immediately - the continuation left on the source core holds
+ * only a weak reference, so a source that never resolves does not pin the
+ * timed-out chain in memory. When the source wins the race the deadline
+ * state lingers, inert, until the wheel reclaims it at the deadline.
+ *
+ * Scheduling and expiration must happen on the thread driving the wheel;
+ * source futures may resolve on any thread.
+ */
+class FutureTimeouts {
+public:
+
+    using size_type = TimerWheel::size_type;
+
+    //!< Expirations drained from the wheel per batch.
+    static constexpr size_type kExpireBatch = 64;
+
+public:
+
+    ~FutureTimeouts() {
+        for (const auto& state : _outstanding) {
+            _timers.cancel(state->timer);
+        }
+    }
+
+    FutureTimeouts(const FutureTimeouts&) = delete;
+    FutureTimeouts& operator= (const FutureTimeouts&) = delete;
+
+    /**
+     * Create an adapter enforcing deadlines through the given wheel.
+     * @param timers Timer wheel to multiplex the deadlines over.
+     */
+    explicit FutureTimeouts(TimerWheel& timers) :
+        _timers(timers)
+    {}
+
+    /**
+     * Wrap a future with a deadline.
+     * @param future Future to bound. Consumed by the call.
+     * @param timeoutMs Deadline, rounded up to the wheel resolution.
+     * @return A future completed with the source's value or error if it
+     * resolves before the deadline, with a timeout Error otherwise.
+     */
+    template<typename T>
+    Future<T> within(Future<T>&& future, uint64 timeoutMs) {
+        auto state = std::make_shared<TimeoutStateOf<T>>();
+        auto result = state->promise.getFuture();
+
+        std::weak_ptr<TimeoutStateOf<T>> weak = state;
+        std::move(future)
+            .then([weak](T value) {
+                if (auto s = weak.lock()) {
+                    if (!s->completed.exchange(true)) {
+                        s->promise.setValue(std::move(value));
+                    }
+                }
+            })
+            .onError([weak](Error&& e) {
+                if (auto s = weak.lock()) {
+                    if (!s->completed.exchange(true)) {
+                        s->promise.setError(std::move(e));
+                    }
+                }
+            });
+
+        enroll(state, timeoutMs);
+
+        return result;
+    }
+
+    Future<void> within(Future<void>&& future, uint64 timeoutMs) {
+        auto state = std::make_shared<TimeoutStateOf<void>>();
+        auto result = state->promise.getFuture();
+
+        std::weak_ptr<TimeoutStateOf<void>> weak = state;
+        std::move(future)
+            .then([weak]() {
+                if (auto s = weak.lock()) {
+                    if (!s->completed.exchange(true)) {
+                        s->promise.setValue();
+                    }
+                }
+            })
+            .onError([weak](Error&& e) {
+                if (auto s = weak.lock()) {
+                    if (!s->completed.exchange(true)) {
+                        s->promise.setError(std::move(e));
+                    }
+                }
+            });
+
+        enroll(state, timeoutMs);
+
+        return result;
+    }
+
+    /**
+     * Drain the wheel and fail every future whose deadline has passed.
+     * To be called when the wheel's fd polls readable, or after a
+     * TimerWheel::advance() in tests.
+     *
+     * @return Number of deadlines reclaimed, fired and inert ones alike.
+     */
+    size_type expire() {
+        size_type reclaimed = 0;
+
+        Selector::Event events[kExpireBatch] = {};
+        for (auto count = _timers.expire(arrayView(events)); count != 0;
+                  count = _timers.expire(arrayView(events))) {
+            for (size_type i = 0; i < count; ++i) {
+                auto* state = static_cast<TimeoutState*>(events[i].data);
+                state->expire();
+                removeState(state->slot);
+            }
+
+            reclaimed += count;
+        }
+
+        return reclaimed;
+    }
+
+    /** Number of deadlines not yet reclaimed by the wheel. */
+    size_type size() const noexcept {
+        return static_cast<size_type>(_outstanding.size());
+    }
+
+    bool empty() const noexcept {
+        return _outstanding.empty();
+    }
+
+private:
+
+    /** Type-erased per-deadline state, shared between the wheel entry and
+     * the continuations attached to the source future. Whichever side runs
+     * first wins `completed` and settles the wrapped promise.
+     */
+    struct TimeoutState {
+        virtual ~TimeoutState() = default;
+
+        //!< Deadline passed: fail the wrapped promise unless the source won.
+        virtual void expire() = 0;
+
+        TimerWheel::timer_id    timer;
+        size_type               slot;       //!< Index in _outstanding, kept up to date on removal.
+        std::atomic<bool>       completed {false};
+    };
+
+    template<typename T>
+    struct TimeoutStateOf final : public TimeoutState {
+        Promise<T> promise;
+
+        void expire() override {
+            if (!completed.exchange(true)) {
+                promise.setError(Error("Future timed out"));
+            }
+        }
+    };
+
+    template<typename T>
+    void enroll(std::shared_ptr<TimeoutStateOf<T>>& state, uint64 timeoutMs) {
+        state->slot = size();
+        state->timer = _timers.schedule(timeoutMs, static_cast<TimeoutState*>(state.get()));
+
+        _outstanding.push_back(std::move(state));
+    }
+
+    void removeState(size_type slot) {
+        const auto last = size() - 1;
+        if (slot != last) {
+            std::swap(_outstanding[slot], _outstanding[last]);
+            _outstanding[slot]->slot = slot;
+        }
+
+        _outstanding.pop_back();
+    }
+
+private:
+
+    TimerWheel&                                 _timers;
+
+    //!< Strong references: dropping one releases the wrapped promise's core.
+    std::vector<std::shared_ptr<TimeoutState>>  _outstanding;
+};
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_FUTURETIMEOUTS_HPP
@@ -0,0 +1,129 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Message-oriented bridge over a duplex channel
+ *	@file		solace/io/messageChannel.hpp
+ *	@brief		Framed messages with pooled buffers and batched flush
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_MESSAGECHANNEL_HPP
+#define SOLACE_IO_MESSAGECHANNEL_HPP
+
+#include "solace/framing.hpp"
+#include "solace/memoryManager.hpp"
+#include "solace/readBuffer.hpp"
+#include "solace/io/duplex.hpp"
+
+
+namespace Solace { namespace IO {
+
+/**
+ * Message boundaries over a Duplex byte stream.
+ *
+ * Users of raw Duplex each invent their own framing and copy through
+ * intermediate ByteBuffers on both sides of every bridge. This class owns
+ * that instead: sendMessage() stages one framed message into an internal
+ * buffer drawn from the caller's MemoryManager, flushMessages() hands the
+ * whole batch to the channel in one write, and receiveMessage() yields
+ * exactly one message's bytes per call however the stream chopped them up.
+ *
+ * The wire format is the library frame (@see Framing): length-prefixed and
+ * CRC-trailed, so corrupted input resynchronizes on the next marker instead
+ * of desyncing the boundaries forever.
+ *
+ * I/O failures surface as IOException from the underlying File pair, like
+ * the rest of this namespace; the Result errors cover protocol conditions -
+ * an oversized message, a peer that closed the stream mid-frame.
+ *
+ * @note The view returned by receiveMessage() points into the channel's
+ * receive storage and stays valid until the next receiveMessage() call.
+ */
+class MessageChannel {
+public:
+
+    using size_type = MemoryView::size_type;
+
+public:
+
+    /**
+     * Construct a channel over the given duplex.
+     *
+     * @param channel Duplex to exchange messages over. Must outlive this object.
+     * @param allocator Memory manager the internal buffers are drawn from.
+     * @param maxMessageSize Largest message accepted or delivered; also sizes
+     *  the send batch.
+     */
+    MessageChannel(Duplex& channel, MemoryManager& allocator, size_type maxMessageSize = 64 * 1024);
+
+    MessageChannel(MessageChannel const&) = delete;
+    MessageChannel& operator= (MessageChannel const&) = delete;
+
+    /**
+     * Stage one message for sending, preserving its boundaries.
+     *
+     * Messages accumulate in the send buffer and go to the channel in one
+     * write when the batch fills or flushMessages() is called.
+     *
+     * @param message Message bytes to send. Copied; free to reuse on return.
+     * @return Nothing on success, an error for an oversized message.
+     */
+    Result<void, Error> sendMessage(ImmutableMemoryView message);
+
+    /**
+     * Write every staged message to the channel in a single batch.
+     * @return Nothing on success.
+     */
+    Result<void, Error> flushMessages();
+
+    /**
+     * Read the next complete message, blocking on the channel as needed.
+     *
+     * @return A view of the message bytes - valid until the next call - or
+     * an error once the peer has closed the stream.
+     */
+    Result<MemoryView, Error> receiveMessage();
+
+    /** Get the number of messages staged and not yet flushed. */
+    uint32 pendingMessages() const noexcept {
+        return _pendingMessages;
+    }
+
+    /** Decode totals of the receive side. @see FrameDecoder::Stats */
+    FrameDecoder::Stats const& stats() const noexcept {
+        return _decoder.stats();
+    }
+
+private:
+
+    Duplex*         _channel;
+    size_type       _maxMessageSize;
+
+    MemoryBuffer    _sendStorage;
+    WriteBuffer     _sendBuffer;        //!< Frames staged since the last flush.
+    uint32          _pendingMessages {0};
+
+    MemoryBuffer    _recvStorage;
+    size_type       _recvFill {0};      //!< Bytes of stream buffered in _recvStorage.
+    size_type       _recvPos {0};       //!< Bytes of those already consumed.
+
+    MemoryBuffer    _messageStorage;    //!< Backs the view handed out by receiveMessage().
+    FrameDecoder    _decoder;
+};
+
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_MESSAGECHANNEL_HPP
@@ -0,0 +1,241 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Bounded per-connection output queue
+ *	@file		solace/io/outputQueue.hpp
+ *	@brief		Fixed-slot egress queue with watermark backpressure
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_OUTPUTQUEUE_HPP
+#define SOLACE_IO_OUTPUTQUEUE_HPP
+
+#include "solace/delegate.hpp"
+#include "solace/memoryManager.hpp"
+#include "solace/ioobject.hpp"
+
+#include <cerrno>
+#include <vector>
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A bounded output queue for one Selector-driven connection.
+ *
+ * An unbounded egress buffer turns downstream slowness into memory growth:
+ * the producer keeps queueing, nothing pushes back, and the process OOMs
+ * long after the real problem started. An OutputQueue bounds the damage to
+ * a fixed number of slots - preallocated from the caller's MemoryManager
+ * at construction, so a stalled connection costs exactly its budget and
+ * enqueueing never allocates - and turns fill level into explicit flow
+ * control: crossing the high watermark runs the pause delegate, draining
+ * back to the low watermark runs the resume delegate. The gap between the
+ * two keeps the signals from flapping around a single threshold.
+ *
+ * Draining integrates with Selector writability: when the peer's socket
+ * signals Write, drain() copies queued messages into it through the
+ * no-throw tryWrite() surface, stopping cleanly at EAGAIN and resuming
+ * from the partial offset next time:
+ *
+ * @code{.cpp}
+ * OutputQueue egress(allocator, 64, 8 * 1024, {48, 16},
+ *                    OutputQueue::WatermarkHandler([&]() { source.pause(); }),
+ *                    OutputQueue::WatermarkHandler([&]() { source.resume(); }));
+ * ...
+ * if (event.events & Selector::Events::Write) {
+ *     egress.drain(socket);
+ *     if (egress.empty()) {
+ *         selector.remove(socket.getSelectId());   // Nothing left to flush
+ *     }
+ * }
+ * @endcode
+ *
+ * The queue is a single-threaded object: enqueue and drain on the thread
+ * driving the Selector.
+ */
+class OutputQueue {
+public:
+
+    using size_type = MemoryView::size_type;
+
+    /** Invoked when the fill level crosses a watermark. */
+    using WatermarkHandler = delegate<void()>;
+
+    /** Flow-control thresholds, in queued messages. */
+    struct Options {
+        //!< Run the pause delegate when the queue reaches this many messages.
+        uint32      highWatermark {48};
+
+        //!< Run the resume delegate when a paused queue drains down to this.
+        //!< Keep it below the high watermark or the signals will flap.
+        uint32      lowWatermark {16};
+    };
+
+public:
+
+    /**
+     * Construct a queue with its full slot budget preallocated.
+     *
+     * @param allocator Memory manager the slot storage is drawn from.
+     * @param slotCount Number of message slots: the queue's depth bound.
+     * @param slotSize Capacity of one slot: the largest accepted message.
+     * @param options Flow-control thresholds. @see Options
+     * @param onPause Delegate run when the high watermark is reached.
+     * @param onResume Delegate run when a paused queue drains to the
+     *  low watermark.
+     */
+    OutputQueue(MemoryManager& allocator, uint32 slotCount, size_type slotSize, Options options,
+                WatermarkHandler&& onPause, WatermarkHandler&& onResume) :
+        _storage(allocator.create(slotCount * slotSize)),
+        _slotSize(slotSize),
+        _options(options),
+        _onPause(std::move(onPause)),
+        _onResume(std::move(onResume)),
+        _slots(slotCount)
+    {}
+
+    OutputQueue(const OutputQueue&) = delete;
+    OutputQueue& operator= (const OutputQueue&) = delete;
+
+    /**
+     * Copy a message into the next free slot.
+     *
+     * Reaching the high watermark runs the pause delegate inline, once per
+     * pause/resume cycle; a producer that honours it should see no further
+     * failures. A full queue is a hard error and the message is dropped.
+     *
+     * @param message Bytes to queue. Must fit in one slot.
+     * @return Nothing on success, an error when the message does not fit
+     *  or every slot is taken.
+     */
+    Result<void, Error> enqueue(ImmutableMemoryView message) {
+        if (message.size() > _slotSize) {
+            return Err(Error("OutputQueue::enqueue(): message exceeds slot size"));
+        }
+
+        if (_nbQueued == _slots.size()) {
+            return Err(Error("OutputQueue::enqueue(): queue is full"));
+        }
+
+        const auto slot = (_head + _nbQueued) % _slots.size();
+        _storage.view().write(message, slot * _slotSize);
+        _slots[slot].length = message.size();
+        _slots[slot].offset = 0;
+
+        _nbQueued += 1;
+        if (!_paused && _nbQueued >= _options.highWatermark) {
+            _paused = true;
+            if (_onPause) {
+                _onPause();
+            }
+        }
+
+        return Ok();
+    }
+
+    /**
+     * Write queued messages into the destination until it would block.
+     *
+     * Intended to run on the connection's Selector Write event. A partial
+     * write leaves the slot at its offset for the next drain; EAGAIN and
+     * EINTR end the pass without being errors. Draining a paused queue to
+     * the low watermark runs the resume delegate inline.
+     *
+     * @param dest IO object to write into, typically the connection socket.
+     * @return Number of bytes handed to the destination in this pass, or
+     *  the system error code the destination failed with.
+     */
+    IOObject::TryResult drain(IOObject& dest) {
+        size_type totalWritten = 0;
+
+        while (_nbQueued > 0) {
+            auto& slot = _slots[_head];
+            const auto pending = _storage.view()
+                    .slice(_head * _slotSize + slot.offset, _head * _slotSize + slot.length)
+                    .viewImmutableShallow();
+
+            auto written = dest.tryWrite(pending);
+            if (!written.isOk()) {
+                const auto errorCode = written.getError().value();
+                if (errorCode == EAGAIN || errorCode == EWOULDBLOCK || errorCode == EINTR) {
+                    break;
+                }
+
+                return written;
+            }
+
+            totalWritten += written.unwrap();
+            slot.offset += written.unwrap();
+            if (slot.offset < slot.length) {
+                break;  // Destination took less than the slot: it is saturated.
+            }
+
+            _head = (_head + 1) % _slots.size();
+            _nbQueued -= 1;
+            if (_paused && _nbQueued <= _options.lowWatermark) {
+                _paused = false;
+                if (_onResume) {
+                    _onResume();
+                }
+            }
+        }
+
+        return Ok(totalWritten);
+    }
+
+    /** @return True if no messages are queued. */
+    bool empty() const noexcept {
+        return (_nbQueued == 0);
+    }
+
+    /** @return Number of messages currently queued. */
+    uint32 size() const noexcept {
+        return _nbQueued;
+    }
+
+    /** @return The queue's depth bound, in messages. */
+    uint32 capacity() const noexcept {
+        return static_cast<uint32>(_slots.size());
+    }
+
+    /** @return True while producers are asked to hold off. */
+    bool isPaused() const noexcept {
+        return _paused;
+    }
+
+private:
+
+    /** Bookkeeping of one queued message. */
+    struct Slot {
+        size_type   length {0};     //!< Bytes of the message in the slot.
+        size_type   offset {0};     //!< Bytes already handed to the destination.
+    };
+
+    MemoryBuffer        _storage;
+    size_type           _slotSize;
+    Options             _options;
+    WatermarkHandler    _onPause;
+    WatermarkHandler    _onResume;
+
+    std::vector<Slot>   _slots;
+    uint32              _head {0};
+    uint32              _nbQueued {0};
+    bool                _paused {false};
+};
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_OUTPUTQUEUE_HPP
@@ -36,6 +36,7 @@ class Pipe :
         public Duplex {
 public:
     using Duplex::poll_id;
+    using size_type = File::size_type;
 
 public:
 
@@ -52,6 +53,56 @@ public:
     Pipe(Duplex&& duplex);
     Pipe(Pipe&& duplex);
 
+    /** Get the capacity of the kernel buffer backing this pipe.
+     *
+     * @return Pipe buffer capacity in bytes.
+     * @throws IOException if underlaying system call failed
+     */
+    size_type capacity() const;
+
+    /** Resize the kernel buffer backing this pipe.
+     *
+     * A writer that regularly outpaces its reader stalls on the default
+     * capacity; growing the buffer trades kernel memory for fewer stalls.
+     * The kernel rounds the request up to a page multiple and an unprivileged
+     * caller is capped by /proc/sys/fs/pipe-max-size.
+     *
+     * @param nbBytes Requested capacity in bytes.
+     * @return Capacity actually granted by the kernel.
+     * @throws IOException if underlaying system call failed
+     */
+    size_type setCapacity(size_type nbBytes);
+
+    /** Relay bytes from this pipe directly into another file descriptor.
+     *
+     * The transfer is performed in-kernel via splice(), so forwarding pipe
+     * content to a socket or file moves page references instead of copying
+     * the data through userspace.
+     *
+     * @param dest Destination to relay the bytes into.
+     * @param bytesToRelay Number of bytes to relay.
+     * @return Number of bytes actually relayed, which can be less if the
+     * write side of this pipe has been closed and the buffer drained.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    IOResult relayTo(ISelectable& dest, size_type bytesToRelay);
+
+    /** Duplicate bytes from this pipe into another pipe without consuming them.
+     *
+     * Backed by tee(): the destination pipe references the same pages, so a
+     * stream can be forked to an observer while the primary consumer still
+     * reads every byte from this pipe.
+     *
+     * @param dest Pipe to duplicate the bytes into.
+     * @param bytesToTee Maximum number of bytes to duplicate.
+     * @return Number of bytes duplicated, which can be 0 if the write side
+     * of this pipe has been closed and the buffer drained.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    IOResult teeTo(Pipe& dest, size_type bytesToTee);
+
 };
 
 }  // End of namespace IO
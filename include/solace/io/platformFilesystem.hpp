@@ -25,6 +25,13 @@
 #define SOLACE_IO_PLATFORMFILESYSTEM_HPP
 
 #include "solace/io/filesystem.hpp"
+#include "solace/io/directoryReader.hpp"
+#include "solace/result.hpp"
+#include "solace/error.hpp"
+
+#include <functional>
+#include <string>
+#include <vector>
 
 
 namespace Solace { namespace IO {
@@ -88,6 +95,103 @@ public:
         FILE* _fp;
     };
 
+
+    /**
+     * A handle to an open directory that opens files relative to itself.
+     *
+     * Every PlatformFilesystem::open() resolves the full path from the root,
+     * re-walking each directory component in the kernel. A Directory holds
+     * the directory's own descriptor and opens files with openat(), so only
+     * the file name gets resolved. On top of that sits a small LRU cache of
+     * descriptors for recently opened names: a hit costs a dup() call and no
+     * path resolution at all.
+     *
+     * Note: descriptors handed out for one name share a file description -
+     * and with it the file offset - so use positional I/O when several
+     * handles to the same file are live at once.
+     *
+     * Call invalidate() when directory content changes behind the cache
+     * (files replaced via rename and alike): it bumps a generation counter
+     * that lazily retires every cached descriptor, without walking them.
+     */
+    class Directory {
+    public:
+
+        //! Number of file descriptors kept in the cache by default.
+        static constexpr uint32 kDefaultCacheSize = 64;
+
+    public:
+
+        ~Directory();
+
+        /**
+         * Open a directory to serve relative file opens.
+         * @param path A path to the directory to open.
+         * @param cacheSize Maximum number of file descriptors to cache.
+         */
+        explicit Directory(Path const& path, uint32 cacheSize = kDefaultCacheSize);
+
+        Directory(const Directory&) = delete;
+        Directory& operator= (const Directory&) = delete;
+
+        Directory(Directory&& rhs) noexcept;
+
+        Directory& operator= (Directory&& rhs) noexcept {
+            return swap(rhs);
+        }
+
+        Directory& swap(Directory& rhs) noexcept {
+            using std::swap;
+
+            swap(_dirFd, rhs._dirFd);
+            swap(_generation, rhs._generation);
+            swap(_cacheSize, rhs._cacheSize);
+            swap(_entries, rhs._entries);
+
+            return *this;
+        }
+
+        /**
+         * Open an existing file in this directory for reading and writing.
+         * @param name Name of the file - a single path component.
+         * @return The opened file.
+         */
+        File open(StringView name);
+
+        /**
+         * Create a new file in this directory, opened for reading and writing.
+         * @param name Name of the file - a single path component.
+         * @return The newly created file.
+         */
+        File create(StringView name);
+
+        /**
+         * Retire every cached descriptor in O(1).
+         * Subsequent opens go back to openat() and repopulate the cache.
+         */
+        void invalidate() noexcept {
+            ++_generation;
+        }
+
+        /** @return Number of descriptors the cache currently holds for this generation. */
+        uint32 cachedCount() const noexcept;
+
+    private:
+
+        File openAt(StringView name, int flags);
+
+        struct CacheEntry {
+            std::string name;       //!< File name the descriptor was opened under.
+            int         fd;
+            uint64      generation; //!< Generation the descriptor was cached in.
+        };
+
+        int         _dirFd;
+        uint64      _generation;
+        uint32      _cacheSize;
+        std::vector<CacheEntry> _entries;   //!< Most recently used first.
+    };
+
 public:
 
     ~PlatformFilesystem() override = default;
@@ -115,6 +219,28 @@ public:
      */
     std::unique_ptr<File> open(Path const& path) override;
 
+    /**
+     * Create a new file named by a path given as a plain view.
+     *
+     * The allocation-free sibling of create(Path const&): the name goes from
+     * the view onto the stack for null-termination and straight into the
+     * open syscall - no Path, no String, no heap file wrapper. For loops
+     * that create files by the thousand, e.g. segment rollover.
+     *
+     * @param path The full path of the file to create.
+     * @return The created file, opened for reading and writing.
+     */
+    File create(StringView path);
+
+    /**
+     * Open an already existing file named by a path given as a plain view.
+     * @see create(StringView) for why this exists next to open(Path const&).
+     *
+     * @param path The full path of the file to open.
+     * @return The opened file.
+     */
+    File open(StringView path);
+
     /**
      * Remove file by path
      * @param path A path to the file to be removed
@@ -195,6 +321,62 @@ public:
      */
     Array<Path> glob(std::initializer_list<const char*> patterns) const;
 
+    /**
+     * What applyTree() should do with an entry.
+     */
+    enum class TreeOp : byte {
+        Keep,       //!< Leave the entry in place.
+        Remove      //!< Unlink the entry, relative to its directory.
+    };
+
+    /**
+     * Per-entry decision callback for applyTree(): given the directory an
+     * entry lives in and the entry itself, decide what happens to it.
+     * Called concurrently from several threads when parallelism > 1, so the
+     * callback must be thread-safe.
+     */
+    using TreeAction = std::function<TreeOp(Path const& directory, DirectoryReader::Entry const&)>;
+
+    /** Outcome totals of a tree operation. @see applyTree() @see removeTree() */
+    struct TreeOpSummary {
+        uint64 entriesRemoved;      //!< Files and links unlinked.
+        uint64 entriesKept;         //!< Entries the action decided to keep.
+        uint64 directoriesRemoved;  //!< Directories removed after their content.
+        uint64 failures;            //!< Entries or subtrees that could not be processed.
+    };
+
+    /**
+     * Walk a directory tree and apply the action to every non-directory
+     * entry; directories are descended into, never removed.
+     *
+     * With parallelism > 1 subdirectories are fanned out over that many
+     * worker threads, per-directory work units pulled from a shared queue -
+     * the shape that scales with device queue depth rather than one
+     * thread's syscall latency. Removal happens via unlinkat() relative to
+     * the directory descriptor the scan already holds, so no path is
+     * re-resolved per entry. Failures are counted, not fatal: the rest of
+     * the tree is still processed.
+     *
+     * @param root Directory to start from.
+     * @param action Decision callback. Must be thread-safe when parallelism > 1.
+     * @param parallelism Number of worker threads; 1 applies serially.
+     * @return Outcome totals, or an error if the root itself cannot be scanned.
+     */
+    Result<TreeOpSummary, Error>
+    applyTree(Path const& root, TreeAction const& action, uint32 parallelism = 1);
+
+    /**
+     * Remove a directory tree: every file, every subdirectory and the root
+     * itself. Files go in parallel like applyTree(); emptied directories
+     * are then removed deepest-first.
+     *
+     * @param root Directory to remove.
+     * @param parallelism Number of worker threads; 1 removes serially.
+     * @return Outcome totals, or an error if the root itself cannot be scanned.
+     */
+    Result<TreeOpSummary, Error>
+    removeTree(Path const& root, uint32 parallelism = 1);
+
     /**
      * Get the path to the current executable
      * @return The path to the executable
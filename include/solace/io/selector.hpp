@@ -25,6 +25,9 @@
 #define SOLACE_IO_SELECTOR_HPP
 
 #include "solace/types.hpp"
+#include "solace/arrayView.hpp"
+#include "solace/memoryBuffer.hpp"
+#include "solace/timestamp.hpp"
 #include "solace/io/selectable.hpp"
 
 #include <memory>       // std::unique_ptr<>
@@ -32,6 +35,8 @@
 
 namespace Solace { namespace IO {
 
+class TraceRing;
+
 /**
  * Base class for the system specific poll mechanism
  */
@@ -55,6 +60,79 @@ public:
      */
     static Selector createPoll(size_type maxEvents);
 
+    /**
+     * Create a Selector backed by the io_uring submission/completion rings.
+     * Readiness requests are batched and submitted with a single syscall per poll.
+     * Linux only.
+     * @param queueDepth Submission queue depth, rounded up to a power of two by the kernel.
+     * @return An instance of a selector object.
+     */
+    static Selector createIOUring(size_type queueDepth);
+
+    /**
+     * Create the best selector the running kernel actually supports.
+     *
+     * Compiling the backend choice into each service breaks on container
+     * kernels with io_uring disabled or epoll locked down; this probes at
+     * startup instead: io_uring when the rings set up, epoll next, posix
+     * poll as the portable floor. Whatever backend wins is then
+     * self-calibrated - the blocking wakeup latency is measured with a pipe
+     * round trip and the busy-spin window (@see setSpinWindow) derived from
+     * it - so the spin threshold tracks the machine the process landed on
+     * rather than a static tuning file.
+     *
+     * @param maxEvents Maximum number of events expected at the same time.
+     * @return A selector over the best available mechanism, calibrated.
+     */
+    static Selector createBest(size_type maxEvents);
+
+
+    /** Pacing policy for a replaying selector. @see createReplay() */
+    enum class ReplayTiming {
+        AsRecorded,     //!< Sleep out the recorded kernel-wait time before each batch.
+        FastForward,    //!< Feed batches back as fast as the caller polls.
+    };
+
+    /**
+     * Wrap a selector so that every poll appends its event batch to the given
+     * trace ring: one batch record carrying the ready count and the time the
+     * poll spent blocked, then one record per delivered event (fd and event
+     * mask; data pointers are process-local and are not recorded).
+     *
+     * Back the ring with a file mapping and a production reactor ordering bug
+     * becomes a trace that createReplay() re-runs on a developer's desk.
+     *
+     * @param inner The selector doing the actual polling. Consumed.
+     * @param trace The ring to append batches to. Sized to the history wanted:
+     *  the ring overwrites its oldest events, so replay starts from whatever
+     *  it still retains.
+     * @return A selector identical to inner but recording as it goes.
+     */
+    static Selector createRecording(Selector&& inner, TraceRing&& trace);
+
+    /**
+     * Create a Selector that feeds back an event stream recorded by
+     * createRecording() instead of polling the kernel.
+     *
+     * Each poll() delivers the next recorded batch. With ReplayTiming::AsRecorded
+     * the recorded kernel-wait time is slept out first (capped by the poll
+     * timeout), reproducing the original pacing; FastForward skips the sleeps,
+     * which makes a tight replay loop a macro-benchmark of pure dispatch
+     * overhead. Once the trace is exhausted every poll reports no events.
+     *
+     * Replayed events carry the data pointer registered via add() for that fd
+     * in the replaying process, or nullptr for fds never registered.
+     *
+     * @param traceRegion The recorded trace: a mapping of the trace file
+     *  (or the live region), as formatted by TraceRing.
+     * @param timing Whether to reproduce the recorded pacing. @see ReplayTiming
+     * @return A selector replaying the recorded stream.
+     *
+     * @throws IllegalArgumentException if the region does not hold a trace ring.
+     */
+    static Selector createReplay(MemoryBuffer&& traceRegion,
+                                 ReplayTiming timing = ReplayTiming::AsRecorded);
+
 
 public:
 
@@ -68,6 +146,19 @@ public:
         // Following events are not selectable, but can be returned by a selector
         Error = 0x008,
         Hup = 0x010,
+
+        // Following are notification modes, not events: they can be OR'd into the event
+        // mask passed to add() and are never present in a returned event.
+        // Honoured by the epoll backend; level-triggered backends ignore them.
+
+        //!< Report readiness edges only. An fd reported ready is not reported again
+        //!< until its readiness changes, so the caller MUST drain it until the
+        //!< operation returns EAGAIN before polling again or risk never waking up.
+        EdgeTriggered = 0x020,
+
+        //!< Disarm the registration after the first reported event.
+        //!< Re-arm by calling add() again with the same fd.
+        OneShot = 0x040,
     };
 
     /**
@@ -80,7 +171,11 @@ public:
         //!< Event flags raised. @see Events
         int                     events;
 
-        //!< User provided data associated with this event.
+        //!< The pointer given to add() at registration time, delivered
+        //!< back verbatim by every backend. add(ISelectable*, events)
+        //!< stores the ISelectable itself. A reactor keeps its connection
+        //!< state reachable through this pointer and dispatches without
+        //!< an fd-keyed lookup per event.
         void*                   data;
 
         bool isSet(Events ev) const noexcept {
@@ -89,6 +184,39 @@ public:
     };
 
 
+    /**
+     * Self-observation counters maintained by poll() / pollInto().
+     *
+     * Updated with plain stores on whatever thread calls poll - there is no
+     * synchronisation, so read them from that same reactor thread. The point
+     * is an overload signal that is current within one loop iteration: when
+     * lastDispatchNanos grows while lastWaitNanos collapses towards zero the
+     * reactor is saturated, and a load-shedder can act on that long before
+     * downstream timeouts fire.
+     */
+    struct Stats {
+        //!< Completed poll() / pollInto() calls.
+        uint64      polls;
+
+        //!< Total events delivered over the lifetime of the selector.
+        uint64      eventsReported;
+
+        //!< Events delivered by the most recent poll.
+        size_type   lastReadyCount;
+
+        //!< Nanoseconds the most recent poll spent blocked in the kernel.
+        int64       lastWaitNanos;
+
+        //!< Nanoseconds between returning from the previous poll and entering
+        //!< this one - the time the caller spent dispatching events.
+        int64       lastDispatchNanos;
+
+        //!< Exponentially weighted moving average of the full loop duration
+        //!< (dispatch + wait), weight 1/8.
+        int64       loopEwmaNanos;
+    };
+
+
     class Iterator {
     public:
         Iterator(IPollerImpl* p, size_type index, size_type nbReady):
@@ -170,6 +298,9 @@ public:
         using std::swap;
 
         swap(_pimpl, rhs._pimpl);
+        swap(_stats, rhs._stats);
+        swap(_lastPollReturn, rhs._lastPollReturn);
+        swap(_spinWindowUsec, rhs._spinWindowUsec);
 
         return (*this);
     }
@@ -211,14 +342,81 @@ public:
      */
     Iterator poll(int msec = -1);
 
+    /**
+     * Wait for events and copy all of them into the caller provided buffer in one call.
+     *
+     * This is the bulk alternative to poll(): a reactor draining thousands of events
+     * per tick pays one virtual dispatch for the whole batch instead of two per event.
+     * At most events.size() events are reported per call.
+     *
+     * @param events - Caller owned buffer to store the ready events into.
+     * @param msec - The maximum wait time in milliseconds (-1 == infinite) or 0 to return immidiately.
+     * @return Number of events stored into the buffer.
+     */
+    size_type pollInto(ArrayView<Event> events, int msec = -1);
+
+    /**
+     * Readiness statistics over the polls made so far. @see Stats
+     * @return A reference to counters that poll() keeps updating in place.
+     */
+    Stats const& stats() const noexcept {
+        return _stats;
+    }
+
+    /**
+     * Set a busy-spin window applied before blocking in the kernel.
+     *
+     * With a non-zero window, poll() first probes the backend with
+     * non-blocking polls - a cpu pause hint between probes - for up to the
+     * given number of microseconds, and only then falls back to a blocking
+     * wait for the rest of the timeout. Events arriving within the window
+     * skip the sleep/wake penalty at the price of one core spinning; a
+     * window of 0 - the default - keeps plain blocking polls.
+     *
+     * @param usec Busy-spin window in microseconds.
+     * @return Reference to this for fluency.
+     */
+    Selector& setSpinWindow(uint32 usec) noexcept {
+        _spinWindowUsec = usec;
+
+        return *this;
+    }
+
+    /** Get the configured busy-spin window, in microseconds. */
+    uint32 spinWindow() const noexcept {
+        return _spinWindowUsec;
+    }
+
+    /**
+     * Measure this selector's blocking wakeup latency and derive the
+     * busy-spin window from it.
+     *
+     * A helper thread writes to a scratch pipe while this thread is parked
+     * in the backend; the best observed write-to-return time over a handful
+     * of rounds is the cost a spin window is trying to save. The window is
+     * set to twice that cost (clamped to [1, 100] microseconds): spinning
+     * longer than a sleep/wake cycle costs more than it buys.
+     *
+     * Takes a few milliseconds; meant for startup, @see createBest().
+     *
+     * @return The measured wakeup latency in nanoseconds, or 0 if the
+     * measurement could not be taken (the window is left untouched then).
+     */
+    int64 calibrateWakeupLatency();
+
 protected:
 
     Selector(std::unique_ptr<IPollerImpl>&& impl);
 
 private:
 
+    void noteCompletedPoll(Timestamp entered, Timestamp returned, size_type nbReady) noexcept;
+
     std::unique_ptr<IPollerImpl> _pimpl;
 
+    Stats       _stats {};
+    Timestamp   _lastPollReturn {};
+    uint32      _spinWindowUsec {0};    //!< Busy-spin window before blocking, 0 to disable.
 };
 
 
@@ -0,0 +1,111 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Double-buffered sequential file scanner
+ *	@file		solace/io/sequentialReader.hpp
+ *	@brief		Streaming reader with kernel read-ahead hints
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_SEQUENTIALREADER_HPP
+#define SOLACE_IO_SEQUENTIALREADER_HPP
+
+#include "solace/memoryManager.hpp"
+#include "solace/io/file.hpp"
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A streaming reader for scanning a file front to back at device bandwidth.
+ *
+ * Plain File::read keeps one request outstanding and gives the kernel no
+ * access-pattern hint, so a scan alternates between waiting for the disk and
+ * parsing what arrived. A SequentialReader tells the kernel up front that the
+ * whole file will be read in order (POSIX_FADV_SEQUENTIAL) and, after handing
+ * out each chunk, asks it to start fetching the next one
+ * (POSIX_FADV_WILLNEED) - so the device fills the page cache while the caller
+ * is still parsing, and the following next() is a memory copy, not an I/O wait.
+ *
+ * Chunks live in two buffers from the caller's MemoryManager, used
+ * alternately: the view returned by next() stays valid while the following
+ * next() call fills the other buffer, so a parser can carry state that points
+ * into the previous chunk across the call that fetches the next one.
+ *
+ * Reads go through readAt() (pread), so the reader never moves the file's
+ * position and several readers can scan one descriptor concurrently.
+ */
+class SequentialReader {
+public:
+
+    using size_type = File::size_type;
+
+public:
+
+    ~SequentialReader() = default;
+
+    SequentialReader(SequentialReader const&) = delete;
+    SequentialReader& operator= (SequentialReader const&) = delete;
+
+    SequentialReader(SequentialReader&&) = default;
+
+    /**
+     * Construct a reader scanning the given file from the start.
+     *
+     * @param file The file to scan. Must stay open for the reader's lifetime.
+     * @param allocator Memory manager to draw the two chunk buffers from.
+     * @param chunkSize Bytes fetched per next() call. Whole multiples of the
+     *  page size keep read-ahead aligned; a few MB is a good default for
+     *  spinning and solid-state devices alike.
+     *
+     * @throws IOException if the advisory call fails on an open descriptor.
+     */
+    SequentialReader(File& file, MemoryManager& allocator, size_type chunkSize);
+
+    /**
+     * Read the next chunk of the file.
+     *
+     * @return View of the bytes read - up to chunkSize() of them - or an
+     *  empty view once the end of the file has been reached. The view stays
+     *  valid until the call after the next one.
+     *
+     * @throws IOException if the underlying read fails.
+     */
+    ImmutableMemoryView next();
+
+    /** Number of bytes each next() call attempts to read. */
+    size_type chunkSize() const noexcept {
+        return _chunkSize;
+    }
+
+    /** File offset the next chunk will be read from. */
+    size_type offset() const noexcept {
+        return _offset;
+    }
+
+private:
+
+    File*           _file;
+    size_type       _chunkSize;
+    size_type       _offset {0};
+
+    bool            _eof {false};
+    uint32          _active {0};
+    MemoryBuffer    _buffers[2];
+};
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_SEQUENTIALREADER_HPP
@@ -25,6 +25,7 @@
 #define SOLACE_IO_SERIAL_HPP
 
 
+#include "solace/byteBuffer.hpp"
 #include "solace/io/file.hpp"
 
 
@@ -279,6 +280,42 @@ public:
     * (due to timeout or select interruption). */
     bool waitReadable(uint32 timeout);
 
+    /*! Configure the kernel's read batching window (termios VMIN/VTIME).
+    *
+    * With vmin > 0 a blocking read does not return until vmin bytes have
+    * accumulated or the inter-byte timer of vtime deciseconds expires, so a
+    * high-rate link yields a few large reads instead of dozens of tiny ones.
+    * Has no effect on reads while the port is in nonblocking mode, but still
+    * shapes when poll marks the port readable on drivers that honour it.
+    *
+    * \param vmin Minimum number of bytes a read waits for, 0..255.
+    * \param vtime Inter-byte timeout in tenths of a second, 0..255.
+    */
+    void setReadBatching(uint8 vmin, uint8 vtime);
+
+    /*! Toggle the driver's low-latency mode (ASYNC_LOW_LATENCY, Linux only).
+    *
+    * When set, the UART driver pushes received bytes up to the tty layer
+    * immediately instead of on the next flush tick, trading some CPU for
+    * millisecond-level latency off each delivery. Mutually beneficial with
+    * setReadBatching(): low latency moves bytes to the tty sooner, batching
+    * controls how many accumulate before a read returns.
+    */
+    void setLowLatency(bool enable);
+
+    /*! Drain everything currently readable into the given buffer.
+    *
+    * Loops reading until the port would block or the buffer fills, so one
+    * poll wakeup consumes a whole burst in as few syscalls as the kernel
+    * buffer allows. The buffer position is advanced past the bytes read.
+    *
+    * \param buffer Destination buffer; bytes are appended at its position.
+    * \return Number of bytes read, 0 if nothing was pending.
+    *
+    * \throw IOException if underlaying system call failed
+    */
+    size_type readAvailable(ByteBuffer& buffer);
+
 };
 
 }  // namespace IO
@@ -0,0 +1,182 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: SPSC ring channel over shared memory
+ *	@file		solace/io/sharedRingChannel.hpp
+ *	@brief		Single-producer single-consumer ring over a SharedMemory mapping
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_SHAREDRINGCHANNEL_HPP
+#define SOLACE_IO_SHAREDRINGCHANNEL_HPP
+
+#include "solace/arrayView.hpp"
+#include "solace/memoryBuffer.hpp"
+#include "solace/io/selectable.hpp"
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A single-producer single-consumer ring channel over a shared memory region.
+ *
+ * The region - typically a SharedMemory mapping shared between two processes -
+ * is carved into fixed-size slots with the producer and consumer cursors on
+ * separate cache lines, so on the fast path a hop is two atomic loads and one
+ * release store with no system call. Messages are written and read in place:
+ * reserve() / acquire() hand out MemoryView windows over the slots themselves,
+ * and commit() / release() move the cursors, so a hop copies payload bytes
+ * exactly once on each side and nothing else.
+ *
+ * Each side of the channel is single-threaded: one process (or thread) may
+ * produce and one may consume. The batch API amortises cursor traffic - a
+ * commit of N messages costs the same cache-line handoff as a commit of one.
+ *
+ * An optional eventfd doorbell makes the channel selectable: the producer
+ * rings it on commit and a consumer that has gone to sleep in a Selector
+ * wakes up. Busy consumers should just spin on acquire() and never touch the
+ * doorbell - the kernel only gets involved when somebody is actually asleep.
+ * The eventfd is per-process, so the consumer side either inherits it across
+ * fork() or receives it over a Unix-domain socket and passes it to attach().
+ */
+class SharedRingChannel : public ISelectable {
+public:
+
+    using size_type = MemoryView::size_type;
+
+public:
+
+    ~SharedRingChannel() override;
+
+    SharedRingChannel(SharedRingChannel&& rhs) noexcept;
+
+    SharedRingChannel& operator= (SharedRingChannel&& rhs) noexcept {
+        SharedRingChannel(std::move(rhs)).swap(*this);
+
+        return *this;
+    }
+
+    SharedRingChannel(SharedRingChannel const&) = delete;
+    SharedRingChannel& operator= (SharedRingChannel const&) = delete;
+
+    /**
+     * Size in bytes of the region needed for a channel of the given geometry.
+     * @param slotCount Number of slots in the ring. Must be a power of two.
+     * @param slotSize Size in bytes of each slot.
+     */
+    static size_type bufferSizeFor(uint32 slotCount, uint32 slotSize) noexcept;
+
+    /**
+     * Format a shared memory region as a new, empty channel.
+     *
+     * @param region Memory region backing the ring, at least bufferSizeFor() bytes.
+     * @param slotCount Number of slots in the ring. Must be a power of two.
+     * @param slotSize Size in bytes of each slot - the largest message the channel carries.
+     * @param withDoorbell Create an eventfd doorbell so the channel can be polled.
+     *
+     * @throws IllegalArgumentException if the geometry is invalid or the region too small.
+     */
+    static SharedRingChannel create(MemoryBuffer&& region,
+                                    uint32 slotCount, uint32 slotSize,
+                                    bool withDoorbell = true);
+
+    /**
+     * Attach to a channel already formatted by create() in another process.
+     *
+     * @param region Mapping of the same region the channel was created over.
+     * @param doorbell The creator's doorbell fd as inherited or received by
+     *  this process, or InvalidFd if the channel has no doorbell.
+     *
+     * @throws IllegalArgumentException if the region does not hold a channel.
+     */
+    static SharedRingChannel attach(MemoryBuffer&& region, poll_id doorbell = InvalidFd);
+
+    /**
+     * Producer: borrow views over up to slots.size() free slots.
+     * Each view spans one whole slot; write the message into it and then
+     * publish with commit(). Repeated calls before commit() return the same slots.
+     *
+     * @param slots Destination for the slot views.
+     * @return Number of slots reserved; 0 when the ring is full.
+     */
+    size_type reserve(ArrayView<MemoryView> slots);
+
+    /**
+     * Producer: publish the first count slots of the last reserve() to the
+     * consumer and ring the doorbell if there is one.
+     */
+    void commit(size_type count);
+
+    /**
+     * Consumer: borrow views over up to slots.size() pending messages.
+     * Views stay valid until release(); repeated calls return the same messages.
+     *
+     * @param slots Destination for the message views.
+     * @return Number of messages pending; 0 when the ring is empty.
+     */
+    size_type acquire(ArrayView<MemoryView> slots);
+
+    /**
+     * Consumer: retire the first count messages of the last acquire(),
+     * handing their slots back to the producer.
+     */
+    void release(size_type count);
+
+    /** Number of messages currently in flight. */
+    size_type size() const noexcept;
+
+    bool empty() const noexcept {
+        return size() == 0;
+    }
+
+    /** Number of slots in the ring. */
+    uint32 capacity() const noexcept;
+
+    /** Size in bytes of each slot. */
+    uint32 slotSize() const noexcept;
+
+    /** Get the doorbell fd to register with a Selector, or InvalidFd. */
+    poll_id getSelectId() const override {
+        return _doorbell;
+    }
+
+    /**
+     * Consumer: drain the doorbell after waking up from a Selector.
+     * Call before acquire() so a commit racing with the drain re-arms the bell.
+     */
+    void drainDoorbell();
+
+    SharedRingChannel& swap(SharedRingChannel& rhs) noexcept;
+
+protected:
+
+    SharedRingChannel(MemoryBuffer&& region, poll_id doorbell) noexcept;
+
+private:
+
+    MemoryBuffer    _region;
+    poll_id         _doorbell;
+
+    //!< Cursor past the last slot handed out by reserve() but not yet committed.
+    uint64          _reserved;
+
+    //!< Cursor past the last message handed out by acquire() but not yet released.
+    uint64          _acquired;
+};
+
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_SHAREDRINGCHANNEL_HPP
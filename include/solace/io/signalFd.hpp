@@ -0,0 +1,126 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Signals as Selector events
+ *	@file		solace/io/signalFd.hpp
+ *	@brief		signalfd-based signal delivery on the poll loop
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_SIGNALFD_HPP
+#define SOLACE_IO_SIGNALFD_HPP
+
+#include "solace/arrayView.hpp"
+#include "solace/optional.hpp"
+#include "solace/io/selectable.hpp"
+
+#include <initializer_list>
+
+
+namespace Solace { namespace IO {
+
+/**
+ * Signal delivery through a file descriptor instead of handlers.
+ *
+ * SignalFd blocks the chosen signals for the process and surfaces them as a
+ * readable fd, so a Selector loop consumes signals like any other event: no
+ * async-signal-context restrictions on what the handler may do, no EINTR
+ * interrupting poll calls, and signals queue in the kernel instead of
+ * interrupting whatever the thread was doing.
+ *
+ * This is the poll-loop alternative to SignalDispatcher: where the dispatcher
+ * installs process-wide handlers that run in signal context, a SignalFd turns
+ * delivery into plain reads on the reactor thread.
+ *
+ * @note Signal disposition is per-process but blocking is per-thread; create
+ * the SignalFd before spawning worker threads so they inherit the mask, or
+ * block the same signals in each thread by hand.
+ */
+class SignalFd : public ISelectable {
+public:
+
+    using size_type = uint32;
+
+    /** What was delivered, a portable slice of struct signalfd_siginfo. */
+    struct SignalInfo {
+        int32   signal;         //!< The signal number.
+        int32   senderPid;      //!< Pid of the process that sent it, when applicable.
+        uint32  senderUid;      //!< Real uid of the sender, when applicable.
+    };
+
+public:
+
+    /**
+     * Create a signalfd for the given set of signals.
+     * The signals are blocked for the calling thread so they are delivered
+     * through the fd instead of interrupting execution.
+     *
+     * @param signals Signal numbers to accept, e.g. {SIGINT, SIGTERM}.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    static SignalFd create(std::initializer_list<int> signals);
+
+    ~SignalFd() override;
+
+    SignalFd(SignalFd&& rhs) noexcept : _fd(rhs._fd) {
+        rhs._fd = ISelectable::InvalidFd;
+    }
+
+    SignalFd& operator= (SignalFd&& rhs) noexcept {
+        std::swap(_fd, rhs._fd);
+
+        return *this;
+    }
+
+    SignalFd(SignalFd const&) = delete;
+    SignalFd& operator= (SignalFd const&) = delete;
+
+    /**
+     * Take one pending signal, without blocking.
+     * @return The signal delivered, or none if nothing is pending.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    Optional<SignalInfo> take();
+
+    /**
+     * Drain up to dest.size() pending signals in one read.
+     * @param dest Destination for the delivered signals.
+     * @return Number of signals read; 0 when nothing is pending.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    size_type read(ArrayView<SignalInfo> dest);
+
+    /** Get fd to register with a Selector for Read events. */
+    poll_id getSelectId() const override {
+        return _fd;
+    }
+
+protected:
+
+    explicit SignalFd(poll_id fd) noexcept : _fd(fd)
+    {}
+
+private:
+
+    poll_id     _fd;
+};
+
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_SIGNALFD_HPP
@@ -0,0 +1,384 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Berkley socket wrappers
+ *	@file		solace/io/socket.hpp
+ *	@brief		TCP / UDP / Unix-domain sockets as first-class IO objects
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_SOCKET_HPP
+#define SOLACE_IO_SOCKET_HPP
+
+#include "solace/optional.hpp"
+#include "solace/stringView.hpp"
+#include "solace/arrayView.hpp"
+#include "solace/memoryManager.hpp"
+#include "solace/io/file.hpp"
+
+
+namespace Solace { namespace IO {
+
+/**
+ * Base class of all socket types.
+ *
+ * A socket is a File - it owns its descriptor, reads, writes, closes and can
+ * be registered with a Selector - with socket-level options on top. Sockets
+ * are created nonblocking by default, as they are meant to be driven by a
+ * Selector; switch with setBlocking() when synchronous use is wanted.
+ */
+class Socket : public File {
+public:
+
+    using File::size_type;
+
+    Socket(Socket&& rhs) : File(std::move(rhs))
+    {}
+
+    Socket& operator= (Socket&& rhs) noexcept {
+        File::operator=(std::move(rhs));
+
+        return *this;
+    }
+
+    /** Switch the socket between blocking and nonblocking mode. */
+    void setBlocking(bool blocking);
+
+    /** Set the size of the kernel send buffer (SO_SNDBUF).
+     * @note The kernel doubles the value to leave room for bookkeeping.
+     */
+    void setSendBufferSize(int bytes);
+
+    /** Set the size of the kernel receive buffer (SO_RCVBUF).
+     * @note The kernel doubles the value to leave room for bookkeeping.
+     */
+    void setReceiveBufferSize(int bytes);
+
+    /** Get the current size of the kernel send buffer. */
+    int getSendBufferSize() const;
+
+    /** Get the current size of the kernel receive buffer. */
+    int getReceiveBufferSize() const;
+
+protected:
+
+    explicit Socket(poll_id fd) noexcept : File(fd)
+    {}
+
+    /** Create a new nonblocking socket fd of the given family/type, raising IOException on failure. */
+    static poll_id createFd(int domain, int type, int protocol);
+};
+
+
+/**
+ * A TCP stream socket.
+ *
+ * Connect is nonblocking: connect() returns true if the connection was
+ * established immediately (loopback, mostly) and false while in progress, in
+ * which case register the socket for Write and call finishConnect() once it
+ * polls writable.
+ */
+class TcpSocket : public Socket {
+public:
+
+    /** Create a new, unconnected TCP socket.
+     * @param address Address to connect to later - only used to pick IPv4/IPv6.
+     */
+    static TcpSocket create(StringView address = StringView("0.0.0.0"));
+
+    TcpSocket(TcpSocket&& rhs) : Socket(std::move(rhs))
+    {}
+
+    TcpSocket& operator= (TcpSocket&& rhs) noexcept {
+        Socket::operator=(std::move(rhs));
+
+        return *this;
+    }
+
+    /**
+     * Begin connecting to the given address.
+     * @param address Numeric IPv4 or IPv6 address to connect to.
+     * @param port Port to connect to.
+     * @return True if the connection is established, false if it is in progress.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    bool connect(StringView address, uint16 port);
+
+    /**
+     * Complete a nonblocking connect after the socket polled writable.
+     * @return True if the connection is established, false if still in progress.
+     *
+     * @throws IOException if the connection attempt failed
+     */
+    bool finishConnect();
+
+    /** Disable Nagle's algorithm (TCP_NODELAY): send small writes immediately. */
+    void setNoDelay(bool enable);
+
+protected:
+    friend class TcpAcceptor;
+
+    explicit TcpSocket(poll_id fd) noexcept : Socket(fd)
+    {}
+};
+
+
+/**
+ * A preallocated batch of connection slots for burst accepting.
+ *
+ * During a reconnect storm the accept loop must not allocate per
+ * connection; the slab reserves room for a full batch of descriptors up
+ * front from the given arena and is reused on every poll cycle:
+ * @code{.cpp}
+ * AcceptSlab slab(memoryManager, 512);
+ * for (auto fd : acceptor.acceptBatch(slab.slots())) { ... }
+ * @endcode
+ */
+class AcceptSlab {
+public:
+
+    AcceptSlab(MemoryManager& allocator, uint32 capacity) :
+        _storage(allocator.create(capacity * sizeof(ISelectable::poll_id)))
+    {}
+
+    AcceptSlab(const AcceptSlab&) = delete;
+    AcceptSlab& operator= (const AcceptSlab&) = delete;
+
+    AcceptSlab(AcceptSlab&& rhs) noexcept = default;
+
+    /** The whole slab as accept slots, to pass to acceptBatch(). */
+    ArrayView<ISelectable::poll_id> slots() noexcept;
+
+    uint32 capacity() const noexcept {
+        return static_cast<uint32>(_storage.size() / sizeof(ISelectable::poll_id));
+    }
+
+private:
+
+    MemoryBuffer    _storage;
+};
+
+
+/**
+ * A TCP listening socket accepting incoming connections.
+ */
+class TcpAcceptor : public Socket {
+public:
+
+    /**
+     * Create a listening socket bound to the given address and port.
+     * The socket has SO_REUSEADDR set and is nonblocking.
+     *
+     * @param address Numeric IPv4 or IPv6 address to bind to.
+     * @param port Port to listen on, or 0 for an ephemeral port.
+     * @param backlog Size of the pending-connection queue.
+     */
+    static TcpAcceptor bind(StringView address, uint16 port, int backlog = 128);
+
+    TcpAcceptor(TcpAcceptor&& rhs) : Socket(std::move(rhs))
+    {}
+
+    TcpAcceptor& operator= (TcpAcceptor&& rhs) noexcept {
+        Socket::operator=(std::move(rhs));
+
+        return *this;
+    }
+
+    /**
+     * Accept a pending connection, if any.
+     * @return The accepted connection, or none if no connection is pending.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    Optional<TcpSocket> accept();
+
+    /**
+     * Accept connections until the backlog is dry or the slots are full.
+     *
+     * This is the burst pattern for reconnect storms: one readiness event
+     * from the Selector is answered with a whole batch of accept calls
+     * instead of one, so the listener backlog drains at syscall rate
+     * rather than at poll-cycle rate. Accepted descriptors come back
+     * nonblocking and close-on-exec, ready to register with the Selector.
+     *
+     * @param slots Caller-owned slots for the new descriptors,
+     *  typically AcceptSlab::slots().
+     * @return The prefix of slots holding the newly accepted descriptors.
+     *
+     * @throws IOException if accepting failed before any connection was
+     *  taken this call; a mid-batch failure returns the batch so far.
+     */
+    ArrayView<poll_id> acceptBatch(ArrayView<poll_id> slots);
+
+    /** Get the port the socket is bound to. Useful after binding port 0. */
+    uint16 boundPort() const;
+
+protected:
+
+    explicit TcpAcceptor(poll_id fd) noexcept : Socket(fd)
+    {}
+};
+
+
+/**
+ * A UDP datagram socket.
+ *
+ * Besides plain read()/write() on a connected socket and sendTo(), UDP
+ * sockets support batched transfer: receiveMany()/sendMany() move a whole
+ * array of datagrams per system call via recvmmsg()/sendmmsg(), which is the
+ * difference between one syscall per packet and one per batch on a hot feed.
+ */
+class UdpSocket : public Socket {
+public:
+
+    /** Create a new, unbound UDP socket.
+     * @param address Address to bind or connect to later - only used to pick IPv4/IPv6.
+     */
+    static UdpSocket create(StringView address = StringView("0.0.0.0"));
+
+    UdpSocket(UdpSocket&& rhs) : Socket(std::move(rhs))
+    {}
+
+    UdpSocket& operator= (UdpSocket&& rhs) noexcept {
+        Socket::operator=(std::move(rhs));
+
+        return *this;
+    }
+
+    /** Bind the socket to the given local address and port. */
+    void bind(StringView address, uint16 port);
+
+    /**
+     * Set the default destination for write()/sendMany() and filter received
+     * packets to that peer. Connecting a UDP socket never blocks.
+     */
+    void connect(StringView address, uint16 port);
+
+    /** Send one datagram to the given destination. */
+    IOResult sendTo(StringView address, uint16 port, const ImmutableMemoryView& message);
+
+    /**
+     * Receive up to buffers.size() datagrams in one system call (recvmmsg).
+     * Each received datagram fills one buffer, and the corresponding view is
+     * trimmed in place to the received length.
+     *
+     * @param buffers One buffer per datagram; trimmed to the bytes received.
+     * @return Number of datagrams received; 0 when the socket would block.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    size_type receiveMany(ArrayView<MemoryView> buffers);
+
+    /**
+     * Send up to messages.size() datagrams in one system call (sendmmsg).
+     * The socket must be connected. One datagram is sent per message view.
+     *
+     * @param messages One message per datagram to send.
+     * @return Number of datagrams actually sent, which can be short.
+     *
+     * @throws IOException if underlaying system call failed
+     */
+    size_type sendMany(ArrayView<ImmutableMemoryView> messages);
+
+    /** Get the port the socket is bound to. Useful after binding port 0. */
+    uint16 boundPort() const;
+
+protected:
+
+    explicit UdpSocket(poll_id fd) noexcept : Socket(fd)
+    {}
+};
+
+
+/**
+ * A Unix-domain stream socket.
+ */
+class UnixSocket : public Socket {
+public:
+
+    /** Create a new, unconnected Unix-domain stream socket. */
+    static UnixSocket create();
+
+    UnixSocket(UnixSocket&& rhs) : Socket(std::move(rhs))
+    {}
+
+    UnixSocket& operator= (UnixSocket&& rhs) noexcept {
+        Socket::operator=(std::move(rhs));
+
+        return *this;
+    }
+
+    /**
+     * Begin connecting to the socket file at the given path.
+     * @return True if the connection is established, false if it is in progress.
+     */
+    bool connect(StringView path);
+
+    /** Complete a nonblocking connect after the socket polled writable. @see TcpSocket::finishConnect */
+    bool finishConnect();
+
+protected:
+    friend class UnixAcceptor;
+
+    explicit UnixSocket(poll_id fd) noexcept : Socket(fd)
+    {}
+};
+
+
+/**
+ * A Unix-domain listening socket.
+ */
+class UnixAcceptor : public Socket {
+public:
+
+    /**
+     * Create a listening socket bound to the socket file at the given path.
+     * @param path Filesystem path of the socket file to create.
+     * @param backlog Size of the pending-connection queue.
+     */
+    static UnixAcceptor bind(StringView path, int backlog = 128);
+
+    UnixAcceptor(UnixAcceptor&& rhs) : Socket(std::move(rhs))
+    {}
+
+    UnixAcceptor& operator= (UnixAcceptor&& rhs) noexcept {
+        Socket::operator=(std::move(rhs));
+
+        return *this;
+    }
+
+    /**
+     * Accept a pending connection, if any.
+     * @return The accepted connection, or none if no connection is pending.
+     */
+    Optional<UnixSocket> accept();
+
+    /**
+     * Accept connections until the backlog is dry or the slots are full.
+     * @see TcpAcceptor::acceptBatch()
+     */
+    ArrayView<poll_id> acceptBatch(ArrayView<poll_id> slots);
+
+protected:
+
+    explicit UnixAcceptor(poll_id fd) noexcept : Socket(fd)
+    {}
+};
+
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_SOCKET_HPP
@@ -0,0 +1,105 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Group commit for file syncs
+ *	@file		solace/io/syncService.hpp
+ *	@brief		Batching fdatasync service completing a Future per requester
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_SYNCSERVICE_HPP
+#define SOLACE_IO_SYNCSERVICE_HPP
+
+#include "solace/future.hpp"
+#include "solace/io/file.hpp"
+
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A sync-batching service: group commit for files.
+ *
+ * Instead of each writer stalling in its own fsync, writers enqueue the file
+ * with sync() and get a Future<void> back; a dedicated flusher thread drains
+ * the queue and issues one fdatasync per distinct file per round, completing
+ * every waiting future it covers. Requests that arrive while a sync is on
+ * the disk pile up for the next round, so under load the batch - and the
+ * number of commits amortised into each flush - grows by itself.
+ *
+ * The returned future completes on the flusher thread once the data is on
+ * stable storage; continuations hang off it the usual way. Syncs that fail
+ * fail only the futures of that round for that file.
+ *
+ * @note The caller must keep the File open until its future completes -
+ * the service works on the descriptor and does not take ownership.
+ */
+class SyncService {
+public:
+
+    ~SyncService();
+
+    /** Start the service and its flusher thread. */
+    SyncService();
+
+    SyncService(SyncService const&) = delete;
+    SyncService& operator= (SyncService const&) = delete;
+
+    /**
+     * Request that the file's data be committed to stable storage.
+     *
+     * @param file File to sync; must stay open until the future completes.
+     * @param syncMetadata Use fsync() instead of fdatasync(), also flushing
+     *  metadata such as the modification time.
+     * @return A future completed once the covering sync has finished.
+     */
+    Future<void> sync(File& file, bool syncMetadata = false);
+
+    /**
+     * Stop accepting requests and wind down the flusher.
+     * Already queued requests are flushed before the thread exits; further
+     * sync() calls fail the returned future.
+     */
+    void stop();
+
+private:
+
+    void flusherLoop();
+
+private:
+
+    struct Request {
+        ISelectable::poll_id    fd;
+        bool                    syncMetadata;
+        bool                    handled;
+        Promise<void>           completion;
+    };
+
+    std::mutex                  _guard;
+    std::condition_variable     _workPending;
+    std::vector<Request>        _queue;
+    bool                        _stopped;
+
+    std::thread                 _flusher;
+};
+
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_SYNCSERVICE_HPP
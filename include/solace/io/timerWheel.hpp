@@ -0,0 +1,191 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Hierarchical timer wheel multiplexed over a single timerfd
+ *	@file		solace/io/timerWheel.hpp
+ *	@brief		O(1) schedule/cancel timers delivered through a Selector
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_TIMERWHEEL_HPP
+#define SOLACE_IO_TIMERWHEEL_HPP
+
+#include "solace/types.hpp"
+#include "solace/arrayView.hpp"
+#include "solace/io/selector.hpp"
+
+#include <vector>
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A hierarchical timer wheel that multiplexes any number of timeouts over a
+ * single timerfd, so connection idle-timeouts don't cost one fd each.
+ *
+ * Scheduling and cancellation are O(1): timers hash into a slot of one of the
+ * wheel levels by their deadline and are kept on intrusive free-lists.
+ * The wheel is a selectable object - register it with a Selector for Read
+ * events, and when it fires drain the expirations as synthetic events:
+ *
+ * @code{.cpp}
+ * TimerWheel timers(10);  // 10ms resolution
+ * selector.add(&timers, Selector::Read);
+ *
+ * auto id = timers.schedule(30000, connection);   // 30s idle timeout
+ * ...
+ * timers.cancel(id);                              // connection saw traffic
+ * ...
+ * for (auto event : selector.poll()) {
+ *     if (event.fd == timers.getSelectId()) {
+ *         Selector::Event expired[64];
+ *         const auto count = timers.expire(arrayView(expired));
+ *         // expired[i].data is the pointer given to schedule()
+ *     }
+ * }
+ * @endcode
+ *
+ * The timerfd ticks at the wheel resolution while any timer is pending and is
+ * disarmed when the wheel is empty, so an idle wheel costs no wakeups.
+ */
+class TimerWheel : public ISelectable {
+public:
+
+    using size_type = uint32;
+
+    //!< Opaque handle of a scheduled timer. Valid until the timer fires or is cancelled.
+    using timer_id = uint64;
+
+    //!< Number of slots per wheel level.
+    static constexpr size_type kWheelBits = 8;
+    static constexpr size_type kWheelSize = 1 << kWheelBits;
+
+    //!< Number of levels. 4 levels of 256 slots cover 2^32 ticks.
+    static constexpr size_type kLevels = 4;
+
+public:
+
+    ~TimerWheel() override;
+
+    TimerWheel(const TimerWheel&) = delete;
+    TimerWheel& operator= (const TimerWheel&) = delete;
+
+    /**
+     * Create a new timer wheel.
+     * @param tickDurationMs Wheel resolution: timeouts are rounded up to a multiple of it.
+     */
+    explicit TimerWheel(uint32 tickDurationMs = 10);
+
+    /** Native timerfd to be used by poll/select functions. */
+    poll_id getSelectId() const override {
+        return _timerFd;
+    }
+
+    /**
+     * Schedule a new timeout. O(1).
+     * @param delayMs Delay before expiration, rounded up to the wheel resolution.
+     * @param data User pointer delivered with the expiration event.
+     * @return Handle that can be used to cancel the timer before it fires.
+     */
+    timer_id schedule(uint64 delayMs, void* data);
+
+    /**
+     * Cancel a previously scheduled timer. O(1).
+     * @param id Handle returned by schedule().
+     * @return True if the timer was still pending, false if it already fired or was cancelled.
+     */
+    bool cancel(timer_id id);
+
+    /**
+     * Drain expired timers into caller provided storage as synthetic events.
+     * Must be called when the wheel's fd polls readable. Each event carries the
+     * wheel's fd, the Read flag and the user pointer given to schedule().
+     * If more timers expired than the buffer holds, the rest are kept for the next call.
+     *
+     * @param events Caller owned buffer to store the expiration events into.
+     * @return Number of events stored.
+     */
+    size_type expire(ArrayView<Selector::Event> events);
+
+    /**
+     * Advance the wheel by a span of virtual time, expiring timers as if it
+     * had elapsed. This is the test-clock path: no timerfd is involved, so
+     * unit tests and replay harnesses drive timeouts deterministically.
+     * Expirations are collected exactly like fd-driven ones and are drained
+     * by the next expire() call.
+     *
+     * @param elapsedMs Span to advance by, rounded down to whole ticks.
+     */
+    void advance(uint64 elapsedMs);
+
+    /** Number of timers currently pending. */
+    size_type size() const noexcept {
+        return _nbPending;
+    }
+
+    bool empty() const noexcept {
+        return (_nbPending == 0);
+    }
+
+protected:
+
+    //!< Intrusive list node. Links are indices into the node pool, so ids stay stable.
+    struct Node {
+        uint64      deadline;       //!< Absolute expiration time, in ticks.
+        void*       data;
+        size_type   next;
+        size_type   prev;
+        size_type   slot;           //!< Owning slot, encoded as level*kWheelSize + index.
+        uint32      generation;     //!< Bumped on release to invalidate stale ids.
+        bool        pending;
+    };
+
+    static constexpr size_type kNil = ~size_type(0);
+
+    void link(size_type nodeIndex);
+    void unlink(size_type nodeIndex);
+    size_type acquireNode();
+    void releaseNode(size_type nodeIndex);
+
+    void fireNode(size_type nodeIndex);
+    void advanceTick();
+    void cascade(size_type level);
+
+    void armTimerFd();
+    void disarmTimerFd();
+
+private:
+
+    //!< Slot lists: head node index per slot, per level.
+    size_type                       _slots[kLevels][kWheelSize];
+
+    std::vector<Node>               _nodes;
+    size_type                       _freeList = kNil;
+    size_type                       _nbPending = 0;
+
+    uint64                          _currentTick = 0;
+    uint32                          _tickDurationMs;
+
+    //!< Expirations collected but not yet drained by expire().
+    std::vector<Selector::Event>    _readyEvents;
+    size_type                       _readyCursor = 0;
+
+    int                             _timerFd;
+    bool                            _armed = false;
+};
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_TIMERWHEEL_HPP
@@ -0,0 +1,178 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Flight-recorder trace ring over a memory mapping
+ *	@file		solace/io/traceRing.hpp
+ *	@brief		Fixed-size binary event ring, overwriting in place
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_TRACERING_HPP
+#define SOLACE_IO_TRACERING_HPP
+
+#include "solace/arrayView.hpp"
+#include "solace/memoryBuffer.hpp"
+
+#include <atomic>
+#include <chrono>
+
+
+namespace Solace { namespace IO {
+
+/**
+ * An always-on flight recorder: a ring of fixed-size binary events over a
+ * memory region, typically a SharedMemory mapping of a file so the trace
+ * survives the process and can be read post-mortem.
+ *
+ * Unlike SharedRingChannel there is no consumer to keep up with: the writer
+ * overwrites the oldest events in place and never blocks, stalls or drops.
+ * record() is a cycle-counter read, four stores into the mapped slot and a
+ * release store of the cursor - cheap enough to stay enabled in production
+ * at tens of millions of events per second.
+ *
+ * Each ring has exactly one writer. Give every producing thread its own ring
+ * (its own region or its own slice of a larger file) rather than sharing one;
+ * that is what keeps record() free of atomic read-modify-writes. Readers -
+ * a post-mortem tool attaching to the file, or a live thread sampling the
+ * trace - use attach() and readBack(), which copies out the newest retained
+ * events and tolerates the writer racing ahead.
+ */
+class TraceRing {
+public:
+
+    using size_type = MemoryView::size_type;
+
+    /** One trace record: what happened, when, and two words of context. */
+    struct Event {
+        uint64 timestamp;   //!< Cycle counter at the time of the record() call.
+        uint64 id;          //!< Application-defined event id.
+        uint64 arg0;        //!< First payload word.
+        uint64 arg1;        //!< Second payload word.
+    };
+
+public:
+
+    ~TraceRing() = default;
+
+    TraceRing(TraceRing&& rhs) noexcept;
+
+    TraceRing& operator= (TraceRing&& rhs) noexcept {
+        TraceRing(std::move(rhs)).swap(*this);
+
+        return *this;
+    }
+
+    TraceRing(TraceRing const&) = delete;
+    TraceRing& operator= (TraceRing const&) = delete;
+
+    /**
+     * Size in bytes of the region needed for a ring of the given capacity.
+     * @param eventCount Number of events the ring retains. Must be a power of two.
+     */
+    static size_type bufferSizeFor(uint32 eventCount) noexcept;
+
+    /**
+     * Format a memory region as a new, empty trace ring.
+     *
+     * @param region Memory region backing the ring, at least bufferSizeFor() bytes.
+     *  Map a file here to get a persistent flight recorder.
+     * @param eventCount Number of events the ring retains. Must be a power of two.
+     *
+     * @throws IllegalArgumentException if the geometry is invalid or the region too small.
+     */
+    static TraceRing create(MemoryBuffer&& region, uint32 eventCount);
+
+    /**
+     * Attach to a ring already formatted by create(), e.g. a post-mortem
+     * mapping of the trace file. The attached object must only be read from.
+     *
+     * @throws IllegalArgumentException if the region does not hold a trace ring.
+     */
+    static TraceRing attach(MemoryBuffer&& region);
+
+    /**
+     * Record one event, overwriting the oldest if the ring is full.
+     * Writer side only; never blocks and never fails.
+     */
+    void record(uint64 id, uint64 arg0 = 0, uint64 arg1 = 0) noexcept {
+        auto const seq = _next->load(std::memory_order_relaxed);
+        auto& slot = _events[seq & _mask];
+
+        slot.timestamp = readTimestamp();
+        slot.id = id;
+        slot.arg0 = arg0;
+        slot.arg1 = arg1;
+
+        // The slot must be fully written before the cursor publishes it:
+        _next->store(seq + 1, std::memory_order_release);
+    }
+
+    /**
+     * Copy the newest retained events into dest, oldest first.
+     * Safe against a live writer: events overwritten mid-copy are re-read.
+     *
+     * @param dest Destination for the events.
+     * @return Number of events copied: min(recorded(), capacity(), dest.size()).
+     */
+    size_type readBack(ArrayView<Event> dest) const;
+
+    /** Total number of events ever recorded, including overwritten ones. */
+    uint64 recorded() const noexcept {
+        return _next->load(std::memory_order_acquire);
+    }
+
+    /** Number of events the ring retains. */
+    uint32 capacity() const noexcept {
+        return _mask + 1;
+    }
+
+    TraceRing& swap(TraceRing& rhs) noexcept;
+
+protected:
+
+    TraceRing(MemoryBuffer&& region, std::atomic<uint64>* next, Event* events, uint32 mask) noexcept :
+        _region(std::move(region)),
+        _next(next),
+        _events(events),
+        _mask(mask)
+    {
+    }
+
+    /** Read the cheapest monotonic-enough clock the platform has. */
+    static uint64 readTimestamp() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+        return __builtin_ia32_rdtsc();
+#else
+        return static_cast<uint64>(
+                    std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+    }
+
+private:
+
+    MemoryBuffer            _region;
+    std::atomic<uint64>*    _next;      //!< Free-running event cursor, in the mapped header.
+    Event*                  _events;    //!< First event slot, in the mapped region.
+    uint32                  _mask;
+};
+
+
+inline void swap(TraceRing& lhs, TraceRing& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_TRACERING_HPP
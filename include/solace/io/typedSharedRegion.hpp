@@ -0,0 +1,210 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Typed shared-memory region
+ *	@file		solace/io/typedSharedRegion.hpp
+ *	@brief		Schema-validated typed view over a SharedMemory mapping
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_IO_TYPEDSHAREDREGION_HPP
+#define SOLACE_IO_TYPEDSHAREDREGION_HPP
+
+#include "solace/arrayView.hpp"
+#include "solace/memoryBuffer.hpp"
+#include "solace/result.hpp"
+#include "solace/error.hpp"
+#include "solace/hashing/murmur3.hpp"
+
+
+namespace Solace { namespace IO {
+
+/**
+ * A typed window over a SharedMemory mapping, validated before use.
+ *
+ * Processes exchanging structs over raw mappings have been relying on
+ * convention to agree on layout - and every reader copies the whole region
+ * out defensively because nothing proves the producer wrote what the
+ * consumer expects. A TypedSharedRegion makes the agreement explicit: the
+ * producer formats the region with a header carrying a magic, a layout
+ * version and the Murmur3 hash of a schema string describing T, and a
+ * consumer attaches by re-deriving the same hash from its own schema
+ * string. A mismatch in any of magic, version, hash or element size fails
+ * the attach with a specific error; a match hands out ArrayView<T> directly
+ * into the mapping - the 100MB state table is read in place, never copied.
+ *
+ * The element type must be trivially copyable: objects with pointers,
+ * ownership or vtables cannot mean anything in another address space.
+ * Element storage starts at an alignof(T)-aligned offset past the header.
+ *
+ * @code{.cpp}
+ * auto shm = SharedMemory::create(Path::parse("/state").unwrap(), 100 * M);
+ * auto region = TypedSharedRegion<StateRow>::format(
+ *         shm.map(SharedMemory::Access::Shared), kStateSchema, 3).unwrap();
+ * region.view()[42].hits += 1;                 // In place, in the mapping
+ * ...
+ * // Another process:
+ * auto table = TypedSharedRegion<StateRow>::attach(
+ *         shm.map(SharedMemory::Access::Shared), kStateSchema, 3);
+ * if (table) { scan(table.unwrap().view()); }  // No copy-out
+ * @endcode
+ *
+ * The wrapper owns the mapping (the MemoryBuffer is consumed); views stay
+ * valid for the wrapper's lifetime. Concurrent access to the elements is
+ * the caller's protocol, exactly as it was with the raw mapping.
+ */
+template<typename T>
+class TypedSharedRegion {
+
+    static_assert(std::is_trivially_copyable<T>::value,
+                  "Only trivially copyable types can be shared across address spaces");
+
+public:
+
+    using size_type = MemoryView::size_type;
+
+    //!< Identifies a formatted region; hex of 'SLTR'.
+    static constexpr uint32 kMagic = 0x534C5452;
+
+    /** The validation header at the start of every formatted region. */
+    struct RegionHeader {
+        uint32              magic;          //!< kMagic for a formatted region.
+        uint32              layoutVersion;  //!< Producer's layout version.
+        hashing::Hash128    schemaHash;     //!< Murmur3-128 of the schema string.
+        uint64              elementSize;    //!< sizeof(T) on the producer side.
+        uint64              nbElements;     //!< Number of elements the region holds.
+    };
+
+    //!< Element storage starts here: the header rounded up to alignof(T).
+    static constexpr size_type kDataOffset =
+            ((sizeof(RegionHeader) + alignof(T) - 1) / alignof(T)) * alignof(T);
+
+public:
+
+    /**
+     * Format a fresh mapping: write the header and claim the rest for elements.
+     * Element bytes are left exactly as mapped (shared memory starts zeroed),
+     * so formatting a 100MB region touches one page.
+     *
+     * @param region Mapping to format. Consumed.
+     * @param schema The layout contract: a string describing T that both
+     *  sides compile in, hashed with Murmur3-128 into the header.
+     * @param layoutVersion Version of the layout, checked exactly on attach.
+     * @return A typed region over the mapping, or an error if the mapping
+     *  cannot hold the header and at least one element.
+     */
+    static Result<TypedSharedRegion, Error>
+    format(MemoryBuffer&& region, StringView schema, uint32 layoutVersion) {
+        if (region.size() < kDataOffset + sizeof(T)) {
+            return Err(Error("TypedSharedRegion::format(): region too small for one element"));
+        }
+
+        RegionHeader header;
+        header.magic = kMagic;
+        header.layoutVersion = layoutVersion;
+        header.schemaHash = hashing::murmur3_128(schema.view());
+        header.elementSize = sizeof(T);
+        header.nbElements = (region.size() - kDataOffset) / sizeof(T);
+
+        region.view().write(wrapMemory(&header, sizeof(header)));
+
+        return Ok(TypedSharedRegion(std::move(region)));
+    }
+
+    /**
+     * Attach to a region formatted by a producer, validating the contract.
+     *
+     * @param region Mapping to attach to. Consumed on success.
+     * @param schema The consumer's schema string; must hash to the value
+     *  the producer recorded.
+     * @param layoutVersion The layout version the consumer was built for.
+     * @return A typed region reading the mapping in place, or an error
+     *  naming the first mismatch found.
+     */
+    static Result<TypedSharedRegion, Error>
+    attach(MemoryBuffer&& region, StringView schema, uint32 layoutVersion) {
+        if (region.size() < kDataOffset) {
+            return Err(Error("TypedSharedRegion::attach(): region too small for a header"));
+        }
+
+        RegionHeader header = {};
+        wrapMemory(&header, sizeof(header)).write(region.view().slice(0, sizeof(header)));
+
+        if (header.magic != kMagic) {
+            return Err(Error("TypedSharedRegion::attach(): not a formatted region"));
+        }
+
+        if (header.layoutVersion != layoutVersion) {
+            return Err(Error("TypedSharedRegion::attach(): layout version mismatch"));
+        }
+
+        if (header.schemaHash != hashing::murmur3_128(schema.view())) {
+            return Err(Error("TypedSharedRegion::attach(): schema hash mismatch"));
+        }
+
+        if (header.elementSize != sizeof(T)) {
+            return Err(Error("TypedSharedRegion::attach(): element size mismatch"));
+        }
+
+        if (region.size() < kDataOffset + header.nbElements * sizeof(T)) {
+            return Err(Error("TypedSharedRegion::attach(): region shorter than its header claims"));
+        }
+
+        return Ok(TypedSharedRegion(std::move(region)));
+    }
+
+    TypedSharedRegion(TypedSharedRegion&&) noexcept = default;
+    TypedSharedRegion& operator= (TypedSharedRegion&&) noexcept = default;
+
+    TypedSharedRegion(TypedSharedRegion const&) = delete;
+    TypedSharedRegion& operator= (TypedSharedRegion const&) = delete;
+
+    /** Typed access directly into the mapping; valid for the wrapper's lifetime. */
+    ArrayView<T> view() noexcept {
+        return ArrayView<T>(_region.view().template dataAs<T>(kDataOffset),
+                            static_cast<typename ArrayView<T>::size_type>(size()));
+    }
+
+    /** @return Number of elements the region holds. */
+    size_type size() const noexcept {
+        return static_cast<size_type>(header().nbElements);
+    }
+
+    /** @return The layout version recorded by the producer. */
+    uint32 layoutVersion() const noexcept {
+        return header().layoutVersion;
+    }
+
+    /** @return The schema hash recorded by the producer. */
+    hashing::Hash128 schemaHash() const noexcept {
+        return header().schemaHash;
+    }
+
+private:
+
+    explicit TypedSharedRegion(MemoryBuffer&& region) noexcept :
+        _region(std::move(region))
+    {}
+
+    RegionHeader const& header() const noexcept {
+        return *_region.view().template dataAs<RegionHeader>();
+    }
+
+    MemoryBuffer    _region;
+};
+
+}  // End of namespace IO
+}  // End of namespace Solace
+#endif  // SOLACE_IO_TYPEDSHAREDREGION_HPP
@@ -51,6 +51,9 @@ public:
     using size_type = size_t;
     using IOResult = Result<size_type, Error>;
 
+    //!< Result of the exception-free I/O surface: a byte count or a cheap system ErrorCode.
+    using TryResult = Result<size_type, ErrorCode>;
+
 public:
 
     virtual ~IOObject() = default;
@@ -164,6 +167,30 @@ public:
      */
     virtual IOResult write(const ImmutableMemoryView& srcBuffer) = 0;
 
+
+    /** Read data with errors reported through the result, never thrown.
+     * For EAGAIN-dense nonblocking loops: a would-block or interrupted call
+     * comes back as a system ErrorCode - two words, no allocation, no stack
+     * unwinding - while the throwing read() stays for paths where an I/O
+     * failure is genuinely exceptional.
+     *
+     * Concrete IO objects override this with a direct no-throw path; the
+     * default implementation adapts read() by translating any IOException
+     * it throws, which is correct but pays for the unwinding.
+     *
+     * @param destBuffer Destanation buffer to read data into.
+     * @return Number of bytes actually read, or a system error code.
+     */
+    virtual TryResult tryRead(MemoryView& destBuffer);
+
+    /** Write data with errors reported through the result, never thrown.
+     * @see IOObject::tryRead() for the contract.
+     *
+     * @param srcBuffer Bytes to write into this io object.
+     * @return Number of bytes actually writen, or a system error code.
+     */
+    virtual TryResult tryWrite(const ImmutableMemoryView& srcBuffer);
+
 };
 
 }  // End of namespace Solace
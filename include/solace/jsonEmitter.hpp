@@ -0,0 +1,231 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Streaming JSON emitter
+ *	@file		solace/jsonEmitter.hpp
+ *	@brief		Forward-only structured JSON text emitter over a WriteBuffer
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_JSONEMITTER_HPP
+#define SOLACE_JSONEMITTER_HPP
+
+#include "solace/writeBuffer.hpp"
+#include "solace/stringView.hpp"
+#include "solace/optional.hpp"
+
+
+namespace Solace {
+
+/**
+ * Forward-only JSON text emitter over a WriteBuffer.
+ *
+ * Built for write-only serialization - telemetry, structured logs, wire
+ * responses - where building a document tree first is pure overhead: every
+ * call appends directly to the destination buffer in one pass, commas and
+ * colons are placed by the emitter, and string values are escaped with a
+ * bulk scan that copies clean runs wholesale.
+ *
+ * Write errors and structural misuse are latched rather than thrown: the
+ * emitting code stays a straight line of calls and checks finish() once at
+ * the end, the same way a WriteBuffer overflow surfaces.
+ *
+ * A second document started after the first one is closed is separated by a
+ * newline, so one emitter over one buffer produces newline-delimited JSON
+ * for batch shipment.
+ *
+ * @code{.cpp}
+ * WriteBuffer out(...);
+ * JsonEmitter json(out);
+ * {
+ *     auto doc = json.object();
+ *     json.field("name", "edge-42")
+ *         .field("rss", uint64(1724416));
+ *     auto samples = json.array("samples");
+ *     json.value(3.5).value(4.25);
+ * }
+ * auto result = json.finish();   // Ok, or first error encountered
+ * @endcode
+ */
+class JsonEmitter {
+public:
+
+    using size_type = WriteBuffer::size_type;
+
+    /** Deepest container nesting supported; separator bookkeeping is one bit
+     * per level in a machine word. Deeper nesting latches an error. */
+    static constexpr size_type kMaxDepth = 64;
+
+    /**
+     * A scope that closes its object or array when destroyed, so emitting
+     * code mirrors the document shape with plain block structure. Movable,
+     * not copyable; a moved-from scope closes nothing.
+     */
+    class Scope {
+    public:
+        ~Scope() noexcept {
+            if (_emitter) {
+                (_emitter->*_close)();
+            }
+        }
+
+        Scope(Scope&& rhs) noexcept : _emitter(rhs._emitter), _close(rhs._close) {
+            rhs._emitter = nullptr;
+        }
+
+        Scope(Scope const&) = delete;
+        Scope& operator= (Scope const&) = delete;
+        Scope& operator= (Scope&&) = delete;
+
+    private:
+        friend class JsonEmitter;
+
+        using Closer = JsonEmitter& (JsonEmitter::*)();
+
+        Scope(JsonEmitter& emitter, Closer close) noexcept :
+            _emitter(&emitter),
+            _close(close)
+        {}
+
+        JsonEmitter*    _emitter;
+        Closer          _close;
+    };
+
+public:
+
+    JsonEmitter(JsonEmitter const&) = delete;
+    JsonEmitter& operator= (JsonEmitter const&) = delete;
+
+    /** Construct an emitter appending to the given destination buffer.
+     * @param dest A buffer to write JSON text into. Must outlive the emitter.
+     */
+    explicit JsonEmitter(WriteBuffer& dest) noexcept :
+        _dest(dest)
+    {}
+
+    /** Open an object value: '{'. Close with endObject() or use object(). */
+    JsonEmitter& beginObject();
+
+    /** Close the innermost scope, which must be an object. */
+    JsonEmitter& endObject();
+
+    /** Open an array value: '['. Close with endArray() or use array(). */
+    JsonEmitter& beginArray();
+
+    /** Close the innermost scope, which must be an array. */
+    JsonEmitter& endArray();
+
+    /** Open an object and return a guard that closes it on scope exit. */
+    Scope object() {
+        beginObject();
+
+        return Scope(*this, &JsonEmitter::endObject);
+    }
+
+    /** Open an object member holding an object: "key":{ ... } */
+    Scope object(StringView key) {
+        name(key);
+
+        return object();
+    }
+
+    /** Open an array and return a guard that closes it on scope exit. */
+    Scope array() {
+        beginArray();
+
+        return Scope(*this, &JsonEmitter::endArray);
+    }
+
+    /** Open an object member holding an array: "key":[ ... ] */
+    Scope array(StringView key) {
+        name(key);
+
+        return array();
+    }
+
+    /** Emit a member key inside an object; the next value() belongs to it. */
+    JsonEmitter& name(StringView key);
+
+    /** Emit a string value, escaped per JSON. Text is treated as UTF-8 and
+     * passed through byte-for-byte; only quotes, backslashes and control
+     * characters are escaped. */
+    JsonEmitter& value(StringView v);
+    JsonEmitter& value(char const* v)   { return value(StringView{v}); }
+
+    /** Emit a numeric value as decimal text. Floats use the shortest
+     * round-trip form; non-finite floats have no JSON spelling and are
+     * emitted as null. */
+    JsonEmitter& value(int64 v);
+    JsonEmitter& value(uint64 v);
+    JsonEmitter& value(float64 v);
+    JsonEmitter& value(int32 v)         { return value(static_cast<int64>(v)); }
+    JsonEmitter& value(uint32 v)        { return value(static_cast<uint64>(v)); }
+
+    /** Emit a boolean value. */
+    JsonEmitter& value(bool v);
+
+    /** Emit a null value. */
+    JsonEmitter& nullValue();
+
+    /** Emit a complete "key":value member in one call. */
+    template<typename T>
+    JsonEmitter& field(StringView key, T&& v) {
+        name(key);
+
+        return value(std::forward<T>(v));
+    }
+
+    /** Emit a null-valued member: "key":null */
+    JsonEmitter& nullField(StringView key) {
+        name(key);
+
+        return nullValue();
+    }
+
+    /**
+     * Conclude emission: every begin must have been closed and every write
+     * must have succeeded.
+     * @return Ok, or the first error latched while emitting.
+     */
+    Result<void, Error> finish();
+
+private:
+
+    /** Emit the separator due before a value or key and mark the level. */
+    void beforeValue();
+
+    /** Append one raw character, latching any write error. */
+    void putRaw(char c);
+
+    /** Append raw bytes verbatim, latching any write error. */
+    void putRaw(char const* data, size_type size);
+
+    /** Append a string body with JSON escaping, quotes included. */
+    void putQuoted(StringView str);
+
+private:
+
+    WriteBuffer&        _dest;
+
+    Optional<Error>     _error;             //!< First failure; all writes after it are skipped.
+    uint64              _hasValue{0};       //!< Bit per depth: the level already holds a value.
+    uint64              _scopeIsObject{0};  //!< Bit per depth: the level is an object, not an array.
+    size_type           _depth{0};
+    bool                _pendingName{false};    //!< A key was just written; no comma before its value.
+    bool                _rootClosed{false};     //!< A complete document was emitted at depth zero.
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_JSONEMITTER_HPP
@@ -102,6 +102,25 @@
 #define GLIBCXX_FORCE_NEW
 #endif  // SOLACE_DEBUG_MEMORY
 
+/*-----------------------------------------------------------------------
+ * Define SOLACE_ENABLE_TELEMETRY (cmake -DENABLE_TELEMETRY=ON) to compile
+ * per-thread counters and cycle histograms into library hot paths.
+ * See solace/telemetry.hpp; without the define the probes cost nothing.
+ * -----------------------------------------------------------------------*/
+
+//! Branch prediction hints for error paths that are expected never to be taken.
+#if __clang__ || __GNUC__
+#define SOLACE_UNLIKELY(x) __builtin_expect(!!(x), 0)
+#define SOLACE_LIKELY(x) __builtin_expect(!!(x), 1)
+//! Mark a function as a cold path: it is outlined away from its callers'
+//! instruction stream and every call to it is predicted not-taken.
+#define SOLACE_COLD __attribute__((cold))
+#else
+#define SOLACE_UNLIKELY(x) (x)
+#define SOLACE_LIKELY(x) (x)
+#define SOLACE_COLD
+#endif
+
 
 
 #if __clang__
@@ -0,0 +1,125 @@
+/*
+*  Copyright 2017 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: LZ4 block compression encoder/decoder
+ *	@file		solace/lz4.hpp
+ *	@brief		LZ4-format block compression behind the Encoder contract
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_LZ4_HPP
+#define SOLACE_LZ4_HPP
+
+#include "solace/encoder.hpp"
+
+#include <vector>
+
+
+namespace Solace {
+
+/**
+ * LZ4 block compressor behind the Encoder contract.
+ *
+ * Each encode() call emits one self-contained frame into the destination
+ * buffer: an 8-byte header of raw size and packed size (both uint32, little
+ * endian) followed by the payload - an LZ4 block, or the input verbatim when
+ * compression would not shrink it (packed size == raw size marks the stored
+ * case). Frames concatenate, so a stream is compressed chunk by chunk with
+ * repeated encode() calls and Lz4Decoder walks the frames back in order.
+ *
+ * A dictionary view may be supplied for small repetitive messages: matches
+ * may then reach back into the dictionary, which compresses the first
+ * occurrence of boilerplate a fresh block would have to spell out. The
+ * decoder must be given the same dictionary. The dictionary applies to every
+ * frame independently and the last 64KiB of it are effective.
+ *
+ * The block format is standard LZ4; the 8-byte frame header is this
+ * library's own, as telemetry egress needs chunk sizes more than it needs
+ * interoperable framing.
+ */
+class Lz4Encoder : public Encoder {
+public:
+    using Encoder::size_type;
+
+    /** Worst-case frame size for an input of the given length. */
+    static size_type maxEncodedSize(size_type len);
+
+public:
+
+    Lz4Encoder(WriteBuffer& dest) :
+        Encoder(dest)
+    {}
+
+    /** Construct an encoder matching Lz4Decoder(dest, dictionary). */
+    Lz4Encoder(WriteBuffer& dest, ImmutableMemoryView dictionary) :
+        Encoder(dest),
+        _dictionary(std::move(dictionary))
+    {}
+
+    size_type encodedSize(ImmutableMemoryView const& data) const override {
+        return maxEncodedSize(data.size());
+    }
+
+    using Encoder::encode;
+
+    Result<void, Error>
+    encode(ImmutableMemoryView const& src) override;
+
+private:
+
+    ImmutableMemoryView _dictionary;
+    std::vector<byte>   _block;     //!< Reused compression scratch, grown once.
+};
+
+
+/**
+ * Decoder for the frames produced by Lz4Encoder.
+ * encode() - the transform in the Encoder contract - takes a view holding
+ * one or more complete frames and writes the decompressed payloads to the
+ * destination buffer in order. A dictionary given at construction must match
+ * the one the frames were compressed with.
+ */
+class Lz4Decoder : public Encoder {
+public:
+    using Encoder::size_type;
+
+public:
+
+    Lz4Decoder(WriteBuffer& dest) :
+        Encoder(dest)
+    {}
+
+    /** Construct a decoder matching Lz4Encoder(dest, dictionary). */
+    Lz4Decoder(WriteBuffer& dest, ImmutableMemoryView dictionary) :
+        Encoder(dest),
+        _dictionary(std::move(dictionary))
+    {}
+
+    /** Total decompressed size of the complete frames in the given view. */
+    size_type encodedSize(ImmutableMemoryView const& data) const override;
+
+    using Encoder::encode;
+
+    Result<void, Error>
+    encode(ImmutableMemoryView const& src) override;
+
+private:
+
+    ImmutableMemoryView _dictionary;
+    std::vector<byte>   _block;     //!< Reused decompression scratch, grown once.
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_LZ4_HPP
@@ -84,6 +84,23 @@ public:
         return *this;
     }
 
+    /** Detached ownership of the buffer memory. @see release() */
+    struct Released {
+        MemoryView                  data;
+        MemoryViewDisposer const*   disposer;
+    };
+
+    /**
+     * Relinquish ownership of the memory, leaving this buffer empty.
+     * The caller becomes responsible for handing the view back to the
+     * disposer, when there is one.
+     *
+     * @return The memory view and the disposer that owns it.
+     */
+    Released release() noexcept {
+        return Released{ std::exchange(_data, MemoryView{}), std::exchange(_disposer, nullptr) };
+    }
+
     MemoryView&         view() noexcept         { return _data; }
     MemoryView const&   view() const noexcept   { return _data; }
 
@@ -27,9 +27,328 @@
 
 #include "solace/memoryBuffer.hpp"
 
+#include <memory>
+
 
 namespace Solace {
 
+/**
+ * A bump-pointer sub-allocator over a single region of memory.
+ *
+ * An arena hands out buffers by advancing an offset into its region - no
+ * free-list, no per-buffer book-keeping. Individual buffers are not freed:
+ * disposing one is a no-op and the whole region is reclaimed at once by
+ * reset(), which makes an arena a good fit for batches of short-lived
+ * allocations with a common end of life, such as per-request processing.
+ *
+ * Note: reset() invalidates every buffer previously handed out by the arena.
+ * It is the caller's responsibility not to reset while such buffers are in use.
+ */
+class MemoryArena {
+public:
+    using size_type = MemoryView::size_type;
+
+public:
+
+    /** Construct an arena allocating from the given region.
+     * @param region A region of memory to allocate from. The arena owns it.
+     */
+    MemoryArena(MemoryBuffer region) noexcept :
+        _region(std::move(region))
+    {}
+
+    MemoryArena(MemoryArena&&) noexcept = default;
+    MemoryArena& operator= (MemoryArena&&) noexcept = default;
+
+    MemoryArena(MemoryArena const&) = delete;
+    MemoryArena& operator= (MemoryArena const&) = delete;
+
+    /**
+     * Allocate a memory segment of the given size out of the arena's region.
+     * Allocations are aligned to the platform's widest scalar type.
+     *
+     * @param dataSize The size of the memory segment to allocate.
+     * @return A newly allocated memory segment.
+     */
+    MemoryBuffer create(size_type dataSize);
+
+    /**
+     * Resize a buffer previously allocated from this arena.
+     * The most recent allocation grows (or shrinks) in place by moving the
+     * bump pointer - no bytes are copied. Older buffers fall back to a fresh
+     * allocation plus a copy, with their old block left in place until reset.
+     *
+     * @param buffer A buffer previously returned by this arena's create().
+     * @param newSize The new size for the buffer.
+     */
+    void resize(MemoryBuffer& buffer, size_type newSize);
+
+    /**
+     * Reclaim the whole region at once, invalidating all buffers handed out so far.
+     */
+    void reset() noexcept {
+        _offset = 0;
+    }
+
+    /** Get amount of memory in bytes allocated out of the arena so far.
+     * @return Total amount of memory allocated from this arena.
+     */
+    size_type size() const noexcept {
+        return _offset;
+    }
+
+    /**
+     * @return Total amount of memory this arena can allocate.
+     */
+    size_type capacity() const noexcept {
+        return _region.size();
+    }
+
+private:
+
+    /** Region of memory the arena allocates from. */
+    MemoryBuffer    _region;
+
+    /** Offset into the region where the next allocation starts. */
+    size_type       _offset{0};
+};
+
+
+/**
+ * A pool of fixed-size memory blocks with O(1) acquire and release.
+ *
+ * The pool pre-carves its region into blocks of one size and keeps the free
+ * ones on a lock-free freelist, so acquiring a buffer and disposing of it are
+ * a couple of atomic operations each - no locks and no size computation.
+ * This fits protocols where all messages are one of a few known sizes:
+ * one pool per size class.
+ *
+ * Unlike an arena, disposing of a pool buffer does return its block to the
+ * pool for reuse, from any thread.
+ */
+class MemoryPool {
+public:
+    using size_type = MemoryView::size_type;
+
+public:
+
+    ~MemoryPool();
+
+    /** Construct a pool carving the given region into fixed-size blocks.
+     * @param region A region of memory to carve up. The pool owns it.
+     * @param blockSize The size of the blocks the pool hands out.
+     * @param blockCount The number of blocks in the pool.
+     */
+    MemoryPool(MemoryBuffer region, size_type blockSize, uint32 blockCount);
+
+    MemoryPool(MemoryPool&&) noexcept;
+    MemoryPool& operator= (MemoryPool&&) noexcept;
+
+    MemoryPool(MemoryPool const&) = delete;
+    MemoryPool& operator= (MemoryPool const&) = delete;
+
+    /**
+     * Acquire a block from the pool.
+     * @return A memory buffer of blockSize bytes backed by a pool block.
+     */
+    MemoryBuffer create();
+
+    /**
+     * Acquire a raw block from the pool, without the MemoryBuffer wrapper.
+     * For allocator adaptors that manage object lifetime themselves, such as
+     * PoolAllocator; every block acquired this way must be handed back via
+     * releaseBlock(). Raises OverflowException when the pool is exhausted.
+     *
+     * @return Address of a blockSize-byte block.
+     */
+    void* acquireBlock();
+
+    /**
+     * Return a block previously acquired with acquireBlock() to the pool.
+     * Like buffer disposal, safe to call from any thread.
+     *
+     * @param address An address returned by acquireBlock().
+     */
+    void releaseBlock(void* address) noexcept;
+
+    /** Get the size of the blocks this pool hands out.
+     * @return Size of a single block in bytes.
+     */
+    size_type blockSize() const noexcept;
+
+    /** Get the total number of blocks in the pool.
+     * @return Number of blocks the pool was created with.
+     */
+    uint32 capacity() const noexcept;
+
+    /** Get the number of blocks currently handed out.
+     * @return Number of blocks in use.
+     */
+    uint32 size() const noexcept;
+
+    /** A snapshot of the free-space layout of the pool. @see fragmentation() */
+    struct FragmentationStats {
+        uint32      freeBlocks;         //!< Blocks currently on the freelist.
+        uint32      freeSpans;          //!< Runs of address-contiguous free blocks.
+        uint32      largestFreeSpan;    //!< Longest such run, in blocks.
+        size_type   reclaimableBytes;   //!< Whole pages inside free blocks that shrink() can release.
+    };
+
+    /**
+     * Measure how scattered the free blocks are.
+     *
+     * Free capacity gathered in one span can be handed back to the kernel
+     * wholesale; the same capacity split into many short spans is interleaved
+     * with live blocks and mostly pinned - that drift is what this reports.
+     *
+     * @note Walks the freelist without locking: call only while the pool is
+     * quiescent - no concurrent create() or buffer disposal.
+     *
+     * @return Free-space layout counters.
+     */
+    FragmentationStats fragmentation() const;
+
+    /**
+     * Return the whole pages covered by free blocks to the kernel and
+     * re-thread the freelist into ascending address order, so the pool
+     * refills front-to-back instead of in LIFO scatter.
+     *
+     * The contents of free blocks are discarded; live blocks are untouched.
+     * Pools from MemoryManager::createPagedPool release every free block in
+     * full - other pools only the pages that fall entirely inside one.
+     *
+     * @note Like fragmentation(), requires a quiescent pool.
+     *
+     * @return Number of bytes handed back to the kernel.
+     */
+    size_type shrink();
+
+private:
+
+    /** Shared pool state lives behind a stable address so that buffers
+     * in flight keep a valid disposer even if the pool object is moved. */
+    struct State;
+
+    friend class MemoryPoolCache;
+
+    std::unique_ptr<State>  _state;
+};
+
+
+/**
+ * A std-compatible allocator drawing fixed-size blocks from a MemoryPool.
+ *
+ * Every allocation takes one whole block off the pool's lock-free freelist
+ * and deallocation pushes it back, from any thread - no malloc on either
+ * side. The natural fit is std::allocate_shared over objects of one type,
+ * where object and control block land together in a single pool block.
+ *
+ * An allocation larger than the pool's block size raises OverflowException,
+ * as does drawing from an exhausted pool: size the blocks and their count
+ * for the peak, as with any pool. The pool must outlive every allocation
+ * made through the allocator.
+ */
+template<typename T>
+class PoolAllocator {
+public:
+
+    using value_type = T;
+
+    explicit PoolAllocator(MemoryPool& pool) noexcept :
+        _pool(&pool)
+    {}
+
+    template<typename U>
+    PoolAllocator(PoolAllocator<U> const& rhs) noexcept :
+        _pool(rhs._pool)
+    {}
+
+    T* allocate(size_t n) {
+        assertIndexInRange(n * sizeof(T), 0, _pool->blockSize() + 1, "PoolAllocator::allocate()");
+
+        return static_cast<T*>(_pool->acquireBlock());
+    }
+
+    void deallocate(T* addr, size_t) noexcept {
+        _pool->releaseBlock(addr);
+    }
+
+    template<typename U>
+    bool operator== (PoolAllocator<U> const& rhs) const noexcept {
+        return (_pool == rhs._pool);
+    }
+
+    template<typename U>
+    bool operator!= (PoolAllocator<U> const& rhs) const noexcept {
+        return (_pool != rhs._pool);
+    }
+
+private:
+
+    template<typename> friend class PoolAllocator;
+
+    MemoryPool* _pool;
+};
+
+
+/**
+ * A per-thread magazine of pool blocks, tcmalloc style.
+ *
+ * Each worker thread owns one cache over a shared MemoryPool. Blocks are
+ * acquired from and disposed into the thread's own magazine with no atomic
+ * operations at all; the pool's freelist is only touched when the magazine
+ * runs dry (batch refill) or overflows (batch flush), so under steady per
+ * thread churn cross-thread synchronization drops to one burst per half
+ * magazine of traffic.
+ *
+ * A cache is single-threaded by design: buffers it creates must be disposed
+ * of on the owning thread, and the cache must not outlive its pool.
+ */
+class MemoryPoolCache {
+public:
+    using size_type = MemoryView::size_type;
+
+public:
+
+    /** Destroy the cache, flushing any cached blocks back to the pool. */
+    ~MemoryPoolCache();
+
+    /** Construct a cache over the given pool.
+     * @param pool A pool to draw blocks from. Must outlive this cache.
+     * @param magazineSize The number of blocks the magazine holds at most.
+     */
+    MemoryPoolCache(MemoryPool& pool, uint32 magazineSize = 32);
+
+    MemoryPoolCache(MemoryPoolCache&&) noexcept;
+    MemoryPoolCache& operator= (MemoryPoolCache&&) noexcept;
+
+    MemoryPoolCache(MemoryPoolCache const&) = delete;
+    MemoryPoolCache& operator= (MemoryPoolCache const&) = delete;
+
+    /**
+     * Acquire a block, from the magazine if possible.
+     * @return A memory buffer of the pool's block size.
+     */
+    MemoryBuffer create();
+
+    /** Get the number of blocks currently sitting in the magazine.
+     * Note: from the pool's point of view cached blocks count as taken -
+     * they are off the shared freelist even though no buffer uses them yet.
+     *
+     * @return Number of cached free blocks.
+     */
+    uint32 cached() const noexcept;
+
+private:
+
+    /** Cache state lives behind a stable address so that buffers in flight
+     * keep a valid disposer even if the cache object is moved. */
+    struct State;
+
+    std::unique_ptr<State>  _state;
+};
+
+
 /**
  * An interface for platform's virtual memory manager.
  * An object of this class is to be used for all operations that require memory allocation.
@@ -53,11 +372,103 @@ public:
      */
     virtual ~MemoryManager() = default;
 
+    /**
+     * Options controlling how the manager sources its memory from the system.
+     */
+    struct Options {
+
+        /** Back allocations with 2MB huge pages to cut TLB pressure on large
+         * working sets. Requests are served via MAP_HUGETLB when pre-reserved
+         * huge pages are available, falling back to transparent huge pages,
+         * and buffer sizes are rounded up to whole huge pages. Ignored on
+         * platforms without huge page support. */
+        bool    useHugePages {false};
+
+        /** NUMA node to place allocations on, or -1 for no preference.
+         * A placement hint only: it is applied best-effort and allocation
+         * does not fail if the kernel cannot honour it. */
+        int32   numaNode {-1};
+
+        /** Prefault allocations at creation time so first-touch page faults
+         * land during initialization, not in the middle of traffic. Mapped
+         * regions are populated by the kernel; heap allocations get a touch
+         * pass, run from several threads for large regions. Allocation cost
+         * goes up by roughly one fault per page. */
+        bool    prefault {false};
+
+        /** Pin allocations in physical memory with mlock() so a loaded box
+         * never pages them out; pinned pages are faulted in by the kernel,
+         * so pinning prefaults too. Best effort: the allocation proceeds
+         * unpinned when the lock is refused (commonly RLIMIT_MEMLOCK).
+         * Pages are unlocked again when the buffer is disposed of. */
+        bool    lockMemory {false};
+
+        /** Keep an allocation ledger: a size histogram of every allocation
+         * plus per-tag outstanding bytes for allocations made through the
+         * tagged create(). Counters are per-thread, so the accounting does
+         * not serialize the allocator it watches. @see accounting() */
+        bool    trackAllocations {false};
+    };
+
+    /** Identity of one allocation call site in the accounting ledger.
+     * @see registerTag() */
+    using TagId = uint32;
+
+    /** Number of distinct ledger tags the accounting supports. */
+    static constexpr uint32 kMaxTags = 64;
+
+    /** Allocation size histogram buckets: bucket n counts allocations of
+     * 2^(n-1) < size <= 2^n bytes, bucket 0 the empty ones. */
+    static constexpr uint32 kNbSizeBuckets = 33;
+
+    /**
+     * A point-in-time view of the allocation ledger. Sums of per-thread
+     * counters read without stopping the world: totals lag in-flight
+     * operations by a few counter increments, which is fine for the
+     * intended use - finding who holds what when capacity runs out.
+     */
+    struct AccountingSnapshot {
+        struct TagStat {
+            const char* name;               //!< The name the tag was registered with.
+            int64       outstandingBytes;   //!< Allocated minus freed through this tag.
+            int64       outstandingBlocks;  //!< Live buffers created through this tag.
+            uint64      totalAllocations;   //!< Allocations ever made through this tag.
+        };
+
+        size_type   currentSize;            //!< Manager's allocated bytes right now.
+        size_type   peakSize;               //!< High-water mark of allocated bytes.
+        uint64      totalAllocations;       //!< Allocations ever, tagged or not.
+        uint64      sizeHistogram[kNbSizeBuckets];
+        uint32      nbTags;
+        TagStat     tags[kMaxTags];
+    };
+
+    /**
+     * Register a ledger tag with the given name, process-wide.
+     * Call once per call site - the idiomatic form is a local static - and
+     * pass the id to the tagged create(). Registering a name twice returns
+     * the same id. The name is referenced, not copied: use a literal.
+     *
+     * @throws OverflowException when kMaxTags distinct tags already exist.
+     */
+    static TagId registerTag(const char* name);
+
+public:
+
     /** Construct a new memory manager with the given capacity
      *
      * @param allowedCapacity The memory capacity this manager allowed to allocate.
      */
-    explicit MemoryManager(size_type allowedCapacity);
+    explicit MemoryManager(size_type allowedCapacity) :
+        MemoryManager(allowedCapacity, Options{})
+    {}
+
+    /** Construct a new memory manager with the given capacity and backing options.
+     *
+     * @param allowedCapacity The memory capacity this manager allowed to allocate.
+     * @param options Options controlling how memory is sourced from the system.
+     */
+    MemoryManager(size_type allowedCapacity, Options options);
 
     MemoryManager(const MemoryManager&) = delete;
 
@@ -106,6 +517,85 @@ public:
      */
     MemoryBuffer create(size_type dataSize);
 
+    /**
+     * Allocate a memory segment, charging it to the given ledger tag.
+     * With trackAllocations enabled the tag's outstanding bytes grow now and
+     * shrink when the buffer is disposed of, from whichever thread that
+     * happens on; with accounting disabled this is exactly create(dataSize).
+     *
+     * @param dataSize The size of the memory segment to allocate.
+     * @param tag A tag from registerTag() identifying the call site.
+     * @return A newly allocated memory segment.
+     */
+    MemoryBuffer create(size_type dataSize, TagId tag);
+
+    /**
+     * Sum the per-thread accounting counters into one consistent-enough view.
+     * Meaningful only with trackAllocations enabled; cheap enough to poll.
+     */
+    AccountingSnapshot accounting() const;
+
+    /**
+     * Allocate a memory segment whose address is aligned to the given boundary.
+     * Direct I/O (files opened with File::Flags::Direct) requires the buffer
+     * address, transfer size and file offset to be aligned to the device's
+     * logical block size - buffers from this call satisfy the first two: the
+     * segment size is rounded up to a whole multiple of the alignment.
+     *
+     * @param dataSize The size of the memory segment to allocate.
+     * @param alignment Required address alignment, a power of two. 4KB covers common devices.
+     * @return A newly allocated aligned memory segment.
+     */
+    MemoryBuffer createAligned(size_type dataSize, size_type alignment = 4096);
+
+    /**
+     * Resize a buffer previously returned by this manager's create().
+     * In huge page mode the mapping is extended in place via mremap where the
+     * kernel allows, so no bytes move; heap buffers fall back to allocating a
+     * new segment and copying. Either way the buffer is updated in place and
+     * existing views into it must be considered invalid afterwards.
+     *
+     * @param buffer A buffer previously returned by this manager's create().
+     * @param newSize The new size for the buffer.
+     */
+    void resize(MemoryBuffer& buffer, size_type newSize);
+
+    /**
+     * Allocate a region of memory to be used as a bump-pointer arena.
+     * The whole region is accounted against this manager's capacity up front
+     * and returned to it when the arena is destroyed.
+     *
+     * @param arenaSize The size of the arena's region.
+     * @return A new arena allocating out of a region owned by this manager.
+     */
+    MemoryArena createArena(size_type arenaSize) {
+        return MemoryArena(create(arenaSize));
+    }
+
+    /**
+     * Allocate a region of memory to be used as a pool of fixed-size blocks.
+     * The whole region is accounted against this manager's capacity up front
+     * and returned to it when the pool is destroyed.
+     *
+     * @param blockSize The size of the blocks the pool hands out.
+     * @param blockCount The number of blocks in the pool.
+     * @return A new pool allocating out of a region owned by this manager.
+     */
+    MemoryPool createPool(size_type blockSize, uint32 blockCount);
+
+    /**
+     * As createPool, with the block size rounded up to whole memory pages
+     * and the region page-aligned, so no page is shared between blocks.
+     * Such pools can return every free block to the kernel in full.
+     * @see MemoryPool::shrink()
+     *
+     * @param blockSize The smallest acceptable block size. blockSize() on the
+     *  resulting pool reports the page-rounded size actually handed out.
+     * @param blockCount The number of blocks in the pool.
+     * @return A new pool of page-granular blocks.
+     */
+    MemoryPool createPagedPool(size_type blockSize, uint32 blockCount);
+
     /**
      * Prohibit memory allocations.
      * Any calls to create to allocate a new memry segment will fail.
@@ -144,20 +634,107 @@ protected:
 
     friend class HeapMemoryDisposer;
 
+    /**
+     * A specialization of memory disposer for memory mapped from the system
+     * rather than taken off the heap, e.g. huge page regions.
+     */
+    class MappedMemoryDisposer : public MemoryViewDisposer {
+    public:
+        MappedMemoryDisposer(MemoryManager* self) : _self(self)
+        {}
+
+        void dispose(ImmutableMemoryView* view) const override;
+
+    private:
+        MemoryManager* _self;
+
+    };
+
+    friend class MappedMemoryDisposer;
+
+    /**
+     * A specialization of memory disposer for over-aligned segments, which must be
+     * released through the aligned allocator rather than delete[].
+     */
+    class AlignedMemoryDisposer : public MemoryViewDisposer {
+    public:
+        AlignedMemoryDisposer(MemoryManager* self) : _self(self)
+        {}
+
+        void dispose(ImmutableMemoryView* view) const override;
+
+    private:
+        MemoryManager* _self;
+
+    };
+
+    friend class AlignedMemoryDisposer;
+
+    /**
+     * A specialization of memory disposer carrying the ledger tag of the
+     * allocation, so disposal is attributed to the right call site without
+     * any per-buffer storage: one disposer instance per tag.
+     */
+    class AccountedMemoryDisposer : public MemoryViewDisposer {
+    public:
+        AccountedMemoryDisposer() = default;
+
+        void init(MemoryManager* self, TagId tag) noexcept {
+            _self = self;
+            _tag = tag;
+        }
+
+        void dispose(ImmutableMemoryView* view) const override;
+
+    private:
+        MemoryManager*  _self {nullptr};
+        TagId           _tag {0};
+
+    };
+
+    friend class AccountedMemoryDisposer;
+
     void free(ImmutableMemoryView* view);
 
+    void freeMapped(ImmutableMemoryView* view);
+
+    void freeAligned(ImmutableMemoryView* view);
+
+    void freeAccounted(ImmutableMemoryView* view, TagId tag);
+
 private:
 
+    MemoryBuffer createImpl(size_type dataSize, uint32 tag);
+
+    /** Keep the high-water mark in step after _size has grown. */
+    void noteSizeGrown() noexcept {
+        if (_size > _peakSize) {
+            _peakSize = _size;
+        }
+    }
+
     /** Amount of memeory in bytes allocatable by this manager */
     size_type   _capacity;
 
     /** Amount of memeory in bytes currently allocated by this manager */
     size_type   _size;
 
+    /** High-water mark of _size over this manager's lifetime. */
+    size_type   _peakSize {0};
+
     /** */
     bool        _isLocked;
 
-    HeapMemoryDisposer _disposer;
+    /** How memory is sourced from the system. */
+    Options     _options;
+
+    HeapMemoryDisposer      _disposer;
+    MappedMemoryDisposer    _mappedDisposer;
+    AlignedMemoryDisposer   _alignedDisposer;
+
+    /** One disposer per ledger tag, so a buffer's tag is encoded in which
+     * disposer it references. Initialized lazily by the tagged create(). */
+    AccountedMemoryDisposer _tagDisposers[kMaxTags];
 
 };
 
@@ -186,6 +186,30 @@ public:
     using ImmutableMemoryView::slice;
     MemoryView slice(size_type from, size_type to);
 
+    using ImmutableMemoryView::alignedSliceFor;
+
+    /** Carve this view into mutable head/body/tail slices for a vector kernel.
+     * @see ImmutableMemoryView::alignedSliceFor() for the decomposition contract.
+     *
+     * @return Head, aligned body and tail slices of this view.
+     */
+    template<typename T>
+    AlignedSplit<MemoryView> alignedSliceFor() {
+        auto const address = reinterpret_cast<std::uintptr_t>(dataAddress());
+        auto const misfit = address % alignof(T);
+
+        auto const headSize = (misfit != 0) ? static_cast<size_type>(alignof(T) - misfit) : 0;
+        if (headSize >= size()) {
+            return { slice(0, size()), slice(size(), size()), slice(size(), size()) };
+        }
+
+        auto const bodySize = ((size() - headSize) / sizeof(T)) * sizeof(T);
+
+        return {    slice(0, headSize),
+                    slice(headSize, headSize + bodySize),
+                    slice(headSize + bodySize, size()) };
+    }
+
     template<typename T, typename... Args>
     T* construct(Args&&... args) {
         assertIndexInRange(static_cast<size_type>(sizeof(T)), static_cast<size_type>(0), this->size() + 1);
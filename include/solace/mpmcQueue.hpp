@@ -0,0 +1,369 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Lock-free bounded queues for inter-thread message passing
+ *	@file		solace/mpmcQueue.hpp
+ *	@brief		Bounded MPMC queue and a faster single-producer variant
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_MPMCQUEUE_HPP
+#define SOLACE_MPMCQUEUE_HPP
+
+#include "solace/types.hpp"
+#include "solace/exception.hpp"
+
+#include <atomic>
+#include <cstdlib>      // posix_memalign / free
+#include <memory>       // std::unique_ptr
+#include <new>          // std::bad_alloc
+#include <type_traits>  // std::aligned_storage
+#include <utility>      // std::move
+
+
+namespace Solace {
+
+namespace details {
+
+constexpr bool isPowerOfTwoCapacity(uint32 value) noexcept {
+    return (value >= 2) && ((value & (value - 1)) == 0);
+}
+
+/// Alignment separating producer and consumer state onto their own cache lines.
+constexpr size_t kCacheLineSize = 64;
+
+/** Allocate storage honouring the queues' cache-line alignment.
+ * C++14 operator new only guarantees alignof(max_align_t), which is less than
+ * a cache line, so heap-allocated queues take this path instead.
+ */
+inline void* allocateCacheAligned(size_t size) {
+    void* mem = nullptr;
+    if (posix_memalign(&mem, kCacheLineSize, size) != 0) {
+        throw std::bad_alloc();
+    }
+
+    return mem;
+}
+
+}  // namespace details
+
+
+/** Bounded lock-free multi-producer multi-consumer queue aka MpmcQueue.
+ * The classic sequence-number ring: each cell carries a ticket that tells
+ * producers and consumers whose turn the cell is, so a handoff is one
+ * compare-and-swap plus one store with no mutex on any path. All storage is
+ * allocated at construction; enqueue and dequeue never allocate, making the
+ * queue safe to use on latency-critical paths.
+ *
+ * Capacity must be a power of two. Elements are moved in and out, so
+ * move-only payloads such as MemoryBuffer work.
+ */
+template<typename T>
+class MpmcQueue {
+public:
+    using value_type = T;
+    using size_type = uint32;
+
+public:
+
+    ~MpmcQueue() {
+        // Single-threaded by the time the queue dies: drop what was never consumed.
+        auto pos = _dequeuePos.load(std::memory_order_relaxed);
+        for (;;) {
+            auto& cell = _cells[pos & _mask];
+            if (cell.sequence.load(std::memory_order_relaxed) != pos + 1) {
+                break;
+            }
+
+            dataOf(cell)->~T();
+            pos += 1;
+        }
+    }
+
+    MpmcQueue(const MpmcQueue&) = delete;
+    MpmcQueue& operator= (const MpmcQueue&) = delete;
+
+    /** Construct a queue of a given fixed capacity.
+     * @param capacity Maximum number of queued elements. Must be a power of two.
+     */
+    explicit MpmcQueue(size_type capacity) :
+        _cells(new Cell[capacity]),
+        _mask(capacity - 1)
+    {
+        if (!details::isPowerOfTwoCapacity(capacity)) {
+            raise<IllegalArgumentException>("capacity");
+        }
+
+        for (size_type i = 0; i < capacity; ++i) {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    static void* operator new(size_t size) {
+        return details::allocateCacheAligned(size);
+    }
+
+    static void operator delete(void* mem) noexcept {
+        free(mem);
+    }
+
+public:
+
+    /** Maximum number of elements the queue can hold. */
+    size_type capacity() const noexcept {
+        return _mask + 1;
+    }
+
+    /**
+     * Attempt to add an element to the queue.
+     * Safe to call from any number of threads concurrently with dequeues.
+     *
+     * @param value A value to move into the queue.
+     * @return True if the element was queued, false if the queue was full.
+     */
+    bool tryEnqueue(T value) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        Cell* cell;
+        auto pos = _enqueuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            const auto seq = cell->sequence.load(std::memory_order_acquire);
+            const auto dif = static_cast<int64>(seq) - static_cast<int64>(pos);
+
+            if (dif == 0) {
+                if (_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false;  // The cell a lap ahead of us is still occupied.
+            } else {
+                pos = _enqueuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        new (dataOf(*cell)) T(std::move(value));
+        cell->sequence.store(pos + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Attempt to take an element off the queue.
+     * Safe to call from any number of threads concurrently with enqueues.
+     *
+     * @param dest Moved-to destination for the dequeued element.
+     * @return True if an element was dequeued, false if the queue was empty.
+     */
+    bool tryDequeue(T& dest) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        Cell* cell;
+        auto pos = _dequeuePos.load(std::memory_order_relaxed);
+
+        for (;;) {
+            cell = &_cells[pos & _mask];
+            const auto seq = cell->sequence.load(std::memory_order_acquire);
+            const auto dif = static_cast<int64>(seq) - static_cast<int64>(pos + 1);
+
+            if (dif == 0) {
+                if (_dequeuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (dif < 0) {
+                return false;  // Nothing published in this cell yet.
+            } else {
+                pos = _dequeuePos.load(std::memory_order_relaxed);
+            }
+        }
+
+        auto* data = dataOf(*cell);
+        dest = std::move(*data);
+        data->~T();
+        cell->sequence.store(pos + _mask + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Number of elements currently queued.
+     * A momentary snapshot only - concurrent producers and consumers can
+     * change it before the caller acts on the answer.
+     */
+    size_type size() const noexcept {
+        const auto enqueued = _enqueuePos.load(std::memory_order_acquire);
+        const auto dequeued = _dequeuePos.load(std::memory_order_acquire);
+
+        return (enqueued > dequeued)
+                ? static_cast<size_type>(enqueued - dequeued)
+                : 0;
+    }
+
+    bool empty() const noexcept {
+        return (size() == 0);
+    }
+
+private:
+
+    struct Cell {
+        std::atomic<uint64> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    static T* dataOf(Cell& cell) noexcept {
+        return reinterpret_cast<T*>(&cell.storage);
+    }
+
+private:
+
+    std::unique_ptr<Cell[]> _cells;
+    uint64 const            _mask;
+
+    alignas(details::kCacheLineSize) std::atomic<uint64> _enqueuePos {0};
+    alignas(details::kCacheLineSize) std::atomic<uint64> _dequeuePos {0};
+};
+
+
+/** Bounded wait-free single-producer single-consumer queue aka SpscQueue.
+ * The restricted concurrency contract - exactly one thread enqueues and
+ * exactly one dequeues - allows a plain ring with two cursors and no
+ * compare-and-swap at all. Each side keeps a cached copy of the other's
+ * cursor and only re-reads the shared atomic when the cache says the ring
+ * looks full or empty, so the fast path touches no shared state.
+ *
+ * For byte streams rather than typed messages see RingBuffer.
+ */
+template<typename T>
+class SpscQueue {
+public:
+    using value_type = T;
+    using size_type = uint32;
+
+public:
+
+    ~SpscQueue() {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        const auto head = _head.load(std::memory_order_relaxed);
+        for (; tail != head; ++tail) {
+            dataAt(tail & _mask)->~T();
+        }
+    }
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator= (const SpscQueue&) = delete;
+
+    /** Construct a queue of a given fixed capacity.
+     * @param capacity Maximum number of queued elements. Must be a power of two.
+     */
+    explicit SpscQueue(size_type capacity) :
+        _storage(new typename std::aligned_storage<sizeof(T), alignof(T)>::type[capacity]),
+        _mask(capacity - 1)
+    {
+        if (!details::isPowerOfTwoCapacity(capacity)) {
+            raise<IllegalArgumentException>("capacity");
+        }
+    }
+
+    static void* operator new(size_t size) {
+        return details::allocateCacheAligned(size);
+    }
+
+    static void operator delete(void* mem) noexcept {
+        free(mem);
+    }
+
+public:
+
+    /** Maximum number of elements the queue can hold. */
+    size_type capacity() const noexcept {
+        return _mask + 1;
+    }
+
+    /**
+     * Attempt to add an element to the queue. Producer thread only.
+     * @param value A value to move into the queue.
+     * @return True if the element was queued, false if the queue was full.
+     */
+    bool tryEnqueue(T value) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        const auto head = _head.load(std::memory_order_relaxed);
+
+        if (head - _tailCache > _mask) {
+            _tailCache = _tail.load(std::memory_order_acquire);
+            if (head - _tailCache > _mask) {
+                return false;
+            }
+        }
+
+        new (dataAt(head & _mask)) T(std::move(value));
+        _head.store(head + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Attempt to take an element off the queue. Consumer thread only.
+     * @param dest Moved-to destination for the dequeued element.
+     * @return True if an element was dequeued, false if the queue was empty.
+     */
+    bool tryDequeue(T& dest) noexcept(std::is_nothrow_move_assignable<T>::value) {
+        const auto tail = _tail.load(std::memory_order_relaxed);
+
+        if (tail == _headCache) {
+            _headCache = _head.load(std::memory_order_acquire);
+            if (tail == _headCache) {
+                return false;
+            }
+        }
+
+        auto* data = dataAt(tail & _mask);
+        dest = std::move(*data);
+        data->~T();
+        _tail.store(tail + 1, std::memory_order_release);
+
+        return true;
+    }
+
+    /**
+     * Number of elements currently queued.
+     * A momentary snapshot only, same caveat as MpmcQueue::size().
+     */
+    size_type size() const noexcept {
+        const auto head = _head.load(std::memory_order_acquire);
+        const auto tail = _tail.load(std::memory_order_acquire);
+
+        return static_cast<size_type>(head - tail);
+    }
+
+    bool empty() const noexcept {
+        return (size() == 0);
+    }
+
+private:
+
+    T* dataAt(uint64 index) const noexcept {
+        return reinterpret_cast<T*>(&_storage[index]);
+    }
+
+private:
+
+    std::unique_ptr<typename std::aligned_storage<sizeof(T), alignof(T)>::type[]> _storage;
+    uint64 const    _mask;
+
+    alignas(details::kCacheLineSize) std::atomic<uint64>    _head {0};
+    alignas(details::kCacheLineSize) uint64                 _headCache {0};
+
+    alignas(details::kCacheLineSize) std::atomic<uint64>    _tail {0};
+    alignas(details::kCacheLineSize) uint64                 _tailCache {0};
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_MPMCQUEUE_HPP
@@ -62,6 +62,31 @@ struct None {
 
 
 
+/**
+ * Traits hook that lets Optional<T> borrow a spare 'null' representation
+ * of T instead of keeping a separate engaged flag.
+ *
+ * Raw pointers opt in below; a view type opts in by specializing this
+ * trait next to its definition, naming the state no engaged value needs -
+ * a null data pointer, say. The pay-off is sizeof(Optional<T>) ==
+ * sizeof(T), so arrays of optional views pack twice as densely. The
+ * trade-off is that the sentinel value itself cannot be stored engaged:
+ * constructing an Optional from it yields none.
+ */
+template <typename T>
+struct OptionalSentinel : std::false_type {};
+
+template <typename T>
+struct OptionalSentinel<T*> : std::true_type {
+    static constexpr T* makeNull() noexcept { return nullptr; }
+    static constexpr bool isNull(T* const& value) noexcept { return (value == nullptr); }
+};
+
+
+template<typename T, typename = void>
+class Optional;
+
+
 /** Optional monad
  * One can think of optional as a list that contains at most 1 item but can be empty as well.
  * This concept allows for a better expression of situation when value might not be present.
@@ -72,7 +97,7 @@ struct None {
     unit: Optional.of()
     bind: Optional.flatMap()
  */
-template<typename T>
+template<typename T, typename Enable>
 // cppcheck-suppress copyCtorAndEqOperator
 class Optional {
 public:
@@ -199,14 +224,14 @@ public:
 
     constexpr bool isNone() const noexcept { return !_engaged; }
 
-    const T& get() const {
+    const T& get() const& {
         if (isNone())
             raiseInvalidStateError();
 
         return _payload;
     }
 
-    T& get() {
+    T& get() & {
         if (isNone()) {
             raiseInvalidStateError();
         }
@@ -214,6 +239,19 @@ public:
         return _payload;
     }
 
+    /** Accessing a temporary moves the value out, so pipelines like
+     * lookup().get() never copy a fat or move-only payload. */
+    T&& get() && {
+        if (isNone()) {
+            raiseInvalidStateError();
+        }
+
+        return std::move(_payload);
+    }
+
+    // A const temporary could only be copied from; make the copy visible at the call site.
+    const T&& get() const&& = delete;
+
 
     T&& move() {
         if (isNone()) {
@@ -292,7 +330,7 @@ private:
 
     static Optional<T> _emptyInstance;
 
-    template <class>
+    template <class, class>
     friend class Optional;
 
     using   Stored_type = std::remove_const_t<T>;
@@ -307,8 +345,172 @@ private:
 };
 
 
+template <typename T, typename Enable>
+Optional<T> Optional<T, Enable>::_emptyInstance {none};
+
+
+/**
+ * Compact Optional for pointer and view types with a spare null state.
+ *
+ * The payload's own null representation (see OptionalSentinel) stands for
+ * the empty optional, so no separate engaged flag is stored and this
+ * Optional is exactly the size of its payload.
+ */
+template<typename T>
+class Optional<T, std::enable_if_t<OptionalSentinel<T>::value>> {
+public:
+    using value_type = T;
+
+public:
+
+    ~Optional() = default;
+
+    /** Construct an new empty optional value. */
+    constexpr Optional() noexcept :
+        _payload{OptionalSentinel<T>::makeNull()}
+    {}
+
+    constexpr Optional(None) noexcept :
+        _payload{OptionalSentinel<T>::makeNull()}
+    {}
+
+    constexpr Optional(Optional const& other) noexcept = default;
+
+    constexpr Optional(Optional&& other) noexcept = default;
+
+    /** Construct an non-empty optional value by copying-value. */
+    constexpr Optional(T const& t) noexcept :
+        _payload{t}
+    {}
+
+    /** Construct an non-empty optional value moving value. */
+    constexpr Optional(T&& t) noexcept :
+        _payload{std::move(t)}
+    {}
+
+    /** Construct an non-empty optional in place. */
+    template<typename ...ARGS>
+    constexpr explicit Optional(InPlace, ARGS&&... args) noexcept :
+        _payload{std::forward<ARGS>(args)...}
+    {}
+
+    Optional& swap(Optional& rhs) noexcept {
+        using std::swap;
+        swap(_payload, rhs._payload);
+
+        return (*this);
+    }
+
+    Optional& operator= (None) noexcept {
+        _payload = OptionalSentinel<T>::makeNull();
+
+        return *this;
+    }
+
+    Optional& operator= (Optional&& rhs) noexcept {
+        return swap(rhs);
+    }
+
+    Optional& operator= (T&& rhs) noexcept {
+        _payload = std::move(rhs);
+
+        return *this;
+    }
+
+    constexpr explicit operator bool() const noexcept {
+      return isSome();
+    }
+
+    constexpr bool isSome() const noexcept { return !OptionalSentinel<T>::isNull(_payload); }
+
+    constexpr bool isNone() const noexcept { return OptionalSentinel<T>::isNull(_payload); }
+
+    const T& get() const& {
+        if (isNone())
+            raiseInvalidStateError();
+
+        return _payload;
+    }
+
+    T& get() & {
+        if (isNone()) {
+            raiseInvalidStateError();
+        }
+
+        return _payload;
+    }
+
+    /** @see Optional<T>::get() && - a temporary moves the value out. */
+    T&& get() && {
+        if (isNone()) {
+            raiseInvalidStateError();
+        }
+
+        return std::move(_payload);
+    }
+
+    const T&& get() const&& = delete;
+
+    T&& move() {
+        if (isNone()) {
+            raiseInvalidStateError();
+        }
+
+        return std::move(_payload);
+    }
+
+    const T& orElse(T const& t) const noexcept {
+        if (isNone()) {
+            return t;
+        }
+
+        return _payload;
+    }
+
+    template <typename F,
+              typename U = typename std::result_of<F(T&)>::type>
+    Optional<U> map(F&& f) {
+        return (isSome())
+                ? Optional<U>(f(_payload))
+                : none;
+    }
+
+    template <typename F,
+              typename U = typename std::result_of<F(T)>::type>
+    Optional<U> map(F&& f) const {
+        return (isSome())
+                ? Optional<U>(f(_payload))
+                : none;
+    }
+
+    template <typename U>
+    Optional<U> flatMap(std::function<Optional<U> (T const&)> const& f) const {
+        return (isSome())
+                ? f(_payload)
+                : none;
+    }
+
+    template <typename F>
+    const Optional& filter(F&& predicate) const {
+        return (isSome())
+                ? (predicate(_payload) ? *this : _emptyInstance)
+                : _emptyInstance;
+    }
+
+private:
+
+    static Optional _emptyInstance;
+
+    template <class, class>
+    friend class Optional;
+
+    T _payload;
+};
+
+
 template <typename T>
-Optional<T> Optional<T>::_emptyInstance {none};
+Optional<T, std::enable_if_t<OptionalSentinel<T>::value>>
+Optional<T, std::enable_if_t<OptionalSentinel<T>::value>>::_emptyInstance {none};
 
 
 template<typename T>
@@ -0,0 +1,144 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Allocation-free failure reporting
+ *	@file		solace/panic.hpp
+ *	@author		$LastChangedBy$
+ *	@date		$LastChangedDate$
+ *	ID:			$Id$
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_PANIC_HPP
+#define SOLACE_PANIC_HPP
+
+#include "solace/types.hpp"
+#include "solace/result.hpp"
+
+
+namespace Solace {
+
+/**
+ * A static descriptor of one failure condition. Instances live in the
+ * data segment - string literals only, nothing is built at failure time.
+ * This matters because the conditions reported here (out of memory,
+ * overflow) are exactly the ones under which constructing a message
+ * String would itself fail.
+ */
+struct PanicReason {
+    const char*     category;   //!< Short machine-greppable tag, e.g. "InvalidState".
+    const char*     message;    //!< Human readable description.
+};
+
+
+/** Well-known reasons shared by the assertion helpers. */
+namespace panics {
+
+extern PanicReason const InvalidState;
+extern PanicReason const NullPointer;
+extern PanicReason const IndexOutOfRange;
+extern PanicReason const OutOfMemory;
+extern PanicReason const Overflow;
+
+}  // namespace panics
+
+
+/**
+ * A no-allocation error value for the Result-returning assertion helpers:
+ * a pointer to a static descriptor plus an optional literal detail.
+ * Trivially copyable, fits in two registers, safe in -fno-exceptions code.
+ */
+struct PanicError {
+
+    PanicReason const*  reason;
+    const char*         detail;     //!< Optional extra context; a literal or nullptr.
+
+    constexpr PanicError(PanicReason const& why, const char* what = nullptr) noexcept :
+        reason(&why),
+        detail(what)
+    {}
+
+    bool operator== (PanicError const& rhs) const noexcept {
+        return reason == rhs.reason;
+    }
+};
+
+
+/**
+ * Report an unrecoverable failure and terminate the process.
+ *
+ * The report is rendered into a preallocated static buffer and written
+ * straight to stderr with write(2): no heap, no locale, no stdio locks.
+ * Unlike raise<>() this is usable from -fno-exceptions translation units
+ * and from out-of-memory handlers.
+ */
+[[noreturn]] SOLACE_COLD
+void panic(PanicReason const& reason) noexcept;
+
+/**
+ * Report an unrecoverable failure with extra context and terminate.
+ * @param reason Static descriptor of the failure class.
+ * @param detail Extra context. Copied into the preallocated report buffer.
+ */
+[[noreturn]] SOLACE_COLD
+void panic(PanicReason const& reason, const char* detail) noexcept;
+
+
+/**
+ * Non-throwing counterpart of assertIndexInRange for the data plane:
+ * returns the failure as a value instead of raising.
+ */
+inline Result<void, PanicError>
+checkIndexInRange(uint64 index, uint64 from, uint64 to) noexcept {
+#if !defined(SOLACE_DISABLE_BOUNDS_CHECKS)
+    if (SOLACE_UNLIKELY(index >= to || index < from)) {
+        return Err<PanicError>(PanicError(panics::IndexOutOfRange));
+    }
+#else
+    static_cast<void>(index);
+    static_cast<void>(from);
+    static_cast<void>(to);
+#endif
+
+    return Ok();
+}
+
+
+/**
+ * Non-throwing counterpart of assertNotNull: the pointer comes back as
+ * a value on success, the failure as a PanicError.
+ */
+template<typename T>
+Result<T*, PanicError> checkNotNull(T* ptr) noexcept {
+    if (SOLACE_UNLIKELY(ptr == nullptr)) {
+        return Err<PanicError>(PanicError(panics::NullPointer));
+    }
+
+    return Ok(ptr);
+}
+
+
+/** Non-throwing counterpart of raiseInvalidStateError. */
+inline Result<void, PanicError>
+checkState(bool condition, const char* detail = nullptr) noexcept {
+    if (SOLACE_UNLIKELY(!condition)) {
+        return Err<PanicError>(PanicError(panics::InvalidState, detail));
+    }
+
+    return Ok();
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_PANIC_HPP
@@ -0,0 +1,264 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Parallel algorithms over array views
+ *	@file		solace/parallel.hpp
+ *	@brief		Multi-threaded forEach/map/reduce/sort over ArrayView
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_PARALLEL_HPP
+#define SOLACE_PARALLEL_HPP
+
+#include "solace/arrayView.hpp"
+#include "solace/exception.hpp"
+
+#include <algorithm>    // std::sort, std::inplace_merge
+#include <thread>
+#include <vector>
+
+
+namespace Solace {
+
+/**
+ * Number of workers used when a parallel algorithm is not given an explicit count.
+ * @return The number of hardware threads, or 1 if it can not be determined.
+ */
+inline uint32 defaultParallelism() noexcept {
+    const auto hardwareThreads = std::thread::hardware_concurrency();
+
+    return (hardwareThreads == 0) ? 1 : hardwareThreads;
+}
+
+
+namespace details {
+
+/** Work splitting shared by the parallel algorithms: contiguous chunks of equal size. */
+struct ChunkPlan {
+
+    ChunkPlan(uint32 len, uint32 nbWorkers) noexcept :
+        chunkSize((len + nbWorkers - 1) / nbWorkers),
+        // Trailing workers left without a single element are dropped.
+        nbChunks((len == 0) ? 1 : (len + chunkSize - 1) / chunkSize)
+    {}
+
+    uint32 chunkFrom(uint32 index) const noexcept { return index * chunkSize; }
+    uint32 chunkTo(uint32 index, uint32 len) const noexcept {
+        return std::min(chunkFrom(index) + chunkSize, len);
+    }
+
+    uint32 chunkSize;
+    uint32 nbChunks;
+};
+
+
+/** Clamp a requested worker count to something sensible for the given input size. */
+inline uint32 clampWorkers(uint32 len, uint32 nbWorkers) noexcept {
+    if (nbWorkers == 0) {
+        nbWorkers = defaultParallelism();
+    }
+
+    return std::min(std::max<uint32>(len, 1), nbWorkers);
+}
+
+
+/**
+ * Run a job over [0, len) split into contiguous chunks, one chunk per worker.
+ * The calling thread processes the last chunk itself so a single-worker run
+ * spawns no threads at all. The first exception thrown by any worker is
+ * re-thrown on the calling thread after all workers have joined.
+ *
+ * @param len Total number of elements to cover.
+ * @param plan The chunking to use.
+ * @param job A callable invoked as job(chunkIndex, from, to) for each chunk.
+ */
+template<typename Job>
+void forEachChunk(uint32 len, ChunkPlan plan, Job&& job) {
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(plan.nbChunks);
+    workers.reserve(plan.nbChunks - 1);
+
+    for (uint32 i = 0; i < plan.nbChunks; ++i) {
+        const auto from = plan.chunkFrom(i);
+        const auto to = plan.chunkTo(i, len);
+
+        auto task = [&job, &errors, i, from, to]() {
+            try {
+                job(i, from, to);
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        if (i + 1 < plan.nbChunks) {
+            workers.emplace_back(std::move(task));
+        } else {
+            task();
+        }
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // namespace details
+
+
+/**
+ * Apply a function to every element of a view, splitting the work across workers.
+ * Each worker owns a contiguous chunk so no synchronisation is needed as long as
+ * the function does not touch elements outside the one it was given.
+ *
+ * @param view A view over the elements to process.
+ * @param f A function to apply to each element.
+ * @param nbWorkers Number of workers to use, 0 for defaultParallelism().
+ */
+template<typename T, typename F>
+void forEachParallel(ArrayView<T> view, F&& f, uint32 nbWorkers = 0) {
+    const auto len = view.size();
+    auto* data = view.begin();
+
+    details::ChunkPlan plan(len, details::clampWorkers(len, nbWorkers));
+    details::forEachChunk(len, plan, [data, &f](uint32, uint32 from, uint32 to) {
+        for (uint32 i = from; i < to; ++i) {
+            f(data[i]);
+        }
+    });
+}
+
+
+/**
+ * Transform every element of a view into a destination view, across workers.
+ * Source and destination must be the same size and may not overlap.
+ *
+ * @param src A view over the elements to transform.
+ * @param dest A view the results are written into.
+ * @param f A function mapping a source element to a destination element.
+ * @param nbWorkers Number of workers to use, 0 for defaultParallelism().
+ */
+template<typename T, typename R, typename F>
+void mapParallel(ArrayView<T> src, ArrayView<R> dest, F&& f, uint32 nbWorkers = 0) {
+    if (src.size() != dest.size()) {
+        raise<IllegalArgumentException>("dest");
+    }
+
+    const auto len = src.size();
+    const auto* in = src.begin();
+    auto* out = dest.begin();
+
+    details::ChunkPlan plan(len, details::clampWorkers(len, nbWorkers));
+    details::forEachChunk(len, plan, [in, out, &f](uint32, uint32 from, uint32 to) {
+        for (uint32 i = from; i < to; ++i) {
+            out[i] = f(in[i]);
+        }
+    });
+}
+
+
+/**
+ * Fold a view into a single value across workers.
+ * Each worker reduces its own chunk and the partial results are combined on the
+ * calling thread in chunk order, so the operation must be associative for the
+ * result to be independent of the worker count.
+ *
+ * @param view A view over the elements to reduce.
+ * @param init Initial value of the fold.
+ * @param op An associative binary operation combining an accumulator and an element.
+ * @param nbWorkers Number of workers to use, 0 for defaultParallelism().
+ * @return The reduction of init and every element of the view.
+ */
+template<typename T, typename R, typename BinaryOp>
+R reduceParallel(ArrayView<T> view, R init, BinaryOp&& op, uint32 nbWorkers = 0) {
+    const auto len = view.size();
+    if (len == 0) {
+        return init;
+    }
+
+    const auto* data = view.begin();
+    details::ChunkPlan plan(len, details::clampWorkers(len, nbWorkers));
+
+    // Each chunk is seeded with its first element; init joins the fold once, up front.
+    std::vector<R> partials;
+    partials.reserve(plan.nbChunks);
+    for (uint32 i = 0; i < plan.nbChunks; ++i) {
+        partials.emplace_back((i == 0)
+                              ? op(std::move(init), data[0])
+                              : static_cast<R>(data[plan.chunkFrom(i)]));
+    }
+
+    details::forEachChunk(len, plan, [data, &partials, &op](uint32 index, uint32 from, uint32 to) {
+        auto acc = std::move(partials[index]);
+        for (uint32 i = from + 1; i < to; ++i) {
+            acc = op(std::move(acc), data[i]);
+        }
+
+        partials[index] = std::move(acc);
+    });
+
+    auto result = std::move(partials[0]);
+    for (uint32 i = 1; i < plan.nbChunks; ++i) {
+        result = op(std::move(result), std::move(partials[i]));
+    }
+
+    return result;
+}
+
+
+/**
+ * Sort a view in ascending order using multiple workers.
+ * Each worker sorts its own chunk and the sorted runs are then merged in place.
+ *
+ * @param view A view over the elements to sort.
+ * @param comp A strict weak ordering comparator.
+ * @param nbWorkers Number of workers to use, 0 for defaultParallelism().
+ */
+template<typename T, typename Comp>
+std::enable_if_t<isCallable<Comp, T, T>::value>
+sortParallel(ArrayView<T> view, Comp&& comp, uint32 nbWorkers = 0) {
+    const auto len = view.size();
+    auto* data = view.begin();
+
+    details::ChunkPlan plan(len, details::clampWorkers(len, nbWorkers));
+    details::forEachChunk(len, plan, [data, &comp](uint32, uint32 from, uint32 to) {
+        std::sort(data + from, data + to, comp);
+    });
+
+    // Merge the sorted runs pairwise, doubling the run length each pass.
+    for (auto run = plan.chunkSize; run < len; run *= 2) {
+        for (uint32 from = 0; from + run < len; from += 2 * run) {
+            const auto middle = from + run;
+            const auto to = std::min<uint32>(from + 2 * run, len);
+
+            std::inplace_merge(data + from, data + middle, data + to, comp);
+        }
+    }
+}
+
+
+/** Sort a view in ascending order of operator< using multiple workers. */
+template<typename T>
+void sortParallel(ArrayView<T> view, uint32 nbWorkers = 0) {
+    sortParallel(view, std::less<T>(), nbWorkers);
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_PARALLEL_HPP
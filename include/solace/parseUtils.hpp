@@ -90,5 +90,44 @@ inline
 Result<uint64, Error> tryParse<uint64>(StringView value) { return tryParseUInt64(value); }
 
 
+/** Parse a whole column of delimiter separated decimal values in one call.
+ *
+ * Designed for bulk ingestion of numeric fields - CSV columns and the like -
+ * where the per-call overhead of tryParse adds up. Parsing stops at the first
+ * value that fails to parse or when the destination runs out of room.
+ *
+ * @param text A string of delimiter separated values.
+ * @param delim The delimiter separating the values.
+ * @param dest Destination to store parsed values into.
+ * @return Number of values parsed on success or an error describing the first failure.
+ */
+template<typename T>
+Result<uint32, Error> tryParseColumn(StringView text, StringView::value_type delim, ArrayView<T> dest) {
+    uint32 count = 0;
+
+    const auto size = text.size();
+    StringView::size_type from = 0;
+    for (StringView::size_type to = 0; to <= size; ++to) {
+        if (to != size && text[to] != delim) {
+            continue;
+        }
+
+        if (count >= dest.size()) {
+            return Err<Error>(StringView("Too many values for the destination given"));
+        }
+
+        auto parsed = tryParse<T>(text.substring(from, to - from));
+        if (!parsed.isOk()) {
+            return Err(parsed.moveError());
+        }
+
+        dest[count++] = parsed.moveResult();
+        from = to + 1;
+    }
+
+    return Ok(count);
+}
+
+
 }  // End of namespace Solace
 #endif  // SOLACE_PARSEUTILS_HPP
@@ -31,6 +31,8 @@
 #include "solace/result.hpp"
 #include "solace/error.hpp"
 
+#include <atomic>
+
 
 namespace Solace {
 
@@ -108,18 +110,26 @@ public:  // Static methods
 
 public:  // Object construction
 
-    ~Path() noexcept /*override*/ = default;
+    ~Path() noexcept /*override*/ {
+        delete _render.load(std::memory_order_acquire);
+    }
 
 	/** Construct an empty path */
     Path() noexcept(std::is_nothrow_default_constructible<Array<String>>::value) : _components() {
         // No-op
     }
 
-    /** Construct path to be a copy of the given one */
-    Path(const Path& p) = default;
+    /** Construct path to be a copy of the given one.
+     * Memoized forms are not copied; the copy re-renders on first use. */
+    Path(const Path& p) : _components(p._components) {
+        // No-op
+    }
 
     /** Construct an object by moving content from a given */
-    Path(Path&& p) noexcept: _components(std::move(p._components)) {
+    Path(Path&& p) noexcept :
+        _components(std::move(p._components)),
+        _render(p._render.exchange(nullptr, std::memory_order_acq_rel)),
+        _cachedHash(p._cachedHash.load(std::memory_order_relaxed)) {
         // No-op
     }
 
@@ -169,9 +179,19 @@ public:  // Object construction
 
 public:  // Operation
 
+    /** Swap content with another path. Like any mutation, not meant to be
+     * called while other threads are reading either operand. */
     Path& swap(Path& rhs) noexcept {
         _components.swap(rhs._components);
 
+        auto* render = _render.load(std::memory_order_relaxed);
+        _render.store(rhs._render.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        rhs._render.store(render, std::memory_order_relaxed);
+
+        const auto hash = _cachedHash.load(std::memory_order_relaxed);
+        _cachedHash.store(rhs._cachedHash.load(std::memory_order_relaxed), std::memory_order_relaxed);
+        rhs._cachedHash.store(hash, std::memory_order_relaxed);
+
         return (*this);
     }
 
@@ -298,6 +318,17 @@ public:  // Operation
      */
     Path getParent() const;
 
+    /**
+     * Get a view of the parent path without constructing a new Path.
+     *
+     * The view points into the memoized default-delimiter rendering and is
+     * valid for the lifetime of this object; use it where the parent is only
+     * inspected or written out, and getParent() where a Path is needed.
+     *
+     * @return String view of the parent path; the whole path if it has no parent.
+     */
+    StringView getParentView() const;
+
     /**
      * Returns the name of the object this path leads to
      * @return The last element of the name sequence
@@ -402,9 +433,54 @@ public:  // Operation
         return toString(Delimiter);
     }
 
+    /**
+     * Render this path into the given buffer in a single pass.
+     *
+     * The total length is computed up front so the render either fits whole
+     * or fails without a partial write, and no intermediate String is
+     * constructed along the way.
+     *
+     * @param dest Buffer to write the rendered path into.
+     * @param delim Delimiter to join the components with.
+     * @return Nothing on success, an error if dest has not enough room left.
+     */
+    Result<void, Error> toString(WriteBuffer& dest, StringView delim = Delimiter) const;
+
+    /**
+     * Get a hash code of this path, suitable for keying a HashMap.
+     *
+     * The hash - like the default-delimiter string form - is computed on
+     * first use and memoized; Path is immutable so neither can ever go
+     * stale. Repeated calls are plain field reads.
+     *
+     * @return Hash code value of this path.
+     */
+    uint64 hashCode() const;
+
 private:
 
+    /** The memoized default-delimiter rendering and the offset of each
+     * component within it, built as one unit. @see rendered() */
+    struct RenderCache {
+        String          pathString;
+        Array<uint32>   componentOffsets;
+    };
+
+    /** Get the memoized rendering, building and publishing it on first use.
+     * Safe to call on a shared const Path from any number of threads. */
+    RenderCache const& rendered() const;
+
     Array<String> _components;
+
+    // Memoized derived forms, computed on first use and published with
+    // atomics so concurrent readers of a shared const Path stay safe, as
+    // they were before memoization: the render cache is built aside and
+    // installed with a compare-exchange (a racing duplicate is discarded),
+    // the hash with a relaxed store - recomputing it twice yields the same
+    // value. A zero hash stands for "not computed yet"; only the empty
+    // path hashes to a trivial recompute on that sentinel collision.
+    mutable std::atomic<RenderCache*>   _render {nullptr};
+    mutable std::atomic<uint64>         _cachedHash {0};
 };
 
 /** Convenience joint operator */
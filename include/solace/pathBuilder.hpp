@@ -0,0 +1,170 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Mutable builder of Path objects
+ *	@file		solace/pathBuilder.hpp
+ *	@author		$LastChangedBy$
+ *	@date		$LastChangedDate$
+ *	@brief		Flat-buffer builder companion to the immutable Path
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_PATHBUILDER_HPP
+#define SOLACE_PATHBUILDER_HPP
+
+
+#include "solace/path.hpp"
+
+#include <vector>
+
+
+namespace Solace {
+
+/**
+ * A mutable builder of paths, for code that constructs many of them.
+ *
+ * Path itself is immutable and stores one String per component, so composing
+ * a path - or walking a directory tree, appending and removing the last
+ * component at every node - allocates for every component touched. The
+ * builder instead keeps all component characters in one contiguous buffer
+ * with an offset table on the side. append() and removeLast() only move the
+ * end of that buffer, so once the buffer has grown to the depth of the walk
+ * they allocate nothing at all, and toString() lays out the final
+ * representation in a single pass.
+ *
+ * An immutable Path can still be materialized with toPath() when one is
+ * needed; until then components are visible as non-owning StringViews.
+ */
+class PathBuilder {
+public:
+
+    using size_type = Path::size_type;
+
+public:
+
+    /** Construct an empty builder. */
+    PathBuilder() = default;
+
+    PathBuilder(PathBuilder const& rhs) = default;
+
+    PathBuilder(PathBuilder&& rhs) noexcept = default;
+
+    /** Construct a builder seeded with the components of the given path. */
+    explicit PathBuilder(Path const& base) {
+        append(base);
+    }
+
+    PathBuilder& operator= (PathBuilder const& rhs) = default;
+
+    PathBuilder& operator= (PathBuilder&& rhs) noexcept = default;
+
+    /**
+     * Append one component to the path under construction.
+     * @param component A component to append. The characters are copied.
+     * @return A reference to self for a fluent interface.
+     */
+    PathBuilder& append(StringView component);
+
+    /** @see append(StringView) */
+    PathBuilder& append(String const& component) {
+        return append(component.view());
+    }
+
+    /** @see append(StringView) */
+    PathBuilder& append(char const* component) {
+        return append(StringView{component});
+    }
+
+    /**
+     * Append all components of the given path.
+     * @param path A path to append components of.
+     * @return A reference to self for a fluent interface.
+     */
+    PathBuilder& append(Path const& path);
+
+    /**
+     * Drop the last component, stepping back up one level of the walk.
+     * Dropping from an empty builder is a no-op, as Path::getParent is at
+     * the root.
+     * @return A reference to self for a fluent interface.
+     */
+    PathBuilder& removeLast() noexcept;
+
+    /**
+     * Remove all components. Buffer capacity is retained for reuse.
+     * @return A reference to self for a fluent interface.
+     */
+    PathBuilder& clear() noexcept;
+
+    /** Test if the builder holds no components yet. */
+    bool empty() const noexcept {
+        return _spans.empty();
+    }
+
+    /** Get the number of components appended so far. */
+    size_type size() const noexcept {
+        return static_cast<size_type>(_spans.size());
+    }
+
+    /**
+     * Test if the path under construction is absolute.
+     * @see Path::isAbsolute
+     */
+    bool isAbsolute() const noexcept {
+        return !_spans.empty() && (_spans.front().length == 0);
+    }
+
+    /**
+     * Get a view of a single component.
+     * @param index Index of the component to get.
+     * @return A view into the builder's buffer, valid until the next mutation.
+     */
+    StringView getComponent(size_type index) const;
+
+    /** Get a view of the last component, or an empty view if none. */
+    StringView last() const noexcept;
+
+    /**
+     * Get a string representation of the path built so far.
+     * The result is laid out in a single allocation.
+     * @param delim A delimiter to separate path components with.
+     * @return String representation of the path.
+     */
+    String toString(StringView delim) const;
+
+    /** @see IFormattable::toString() */
+    String toString() const {
+        return toString(Path::Delimiter);
+    }
+
+    /**
+     * Materialize an immutable Path from the current components.
+     * @return A new Path object holding a copy of the components.
+     */
+    Path toPath() const;
+
+private:
+
+    struct Span {
+        String::size_type offset;
+        String::size_type length;
+    };
+
+    std::vector<char>   _text;      //!< Characters of all components, back to back.
+    std::vector<Span>   _spans;     //!< Location of each component in _text.
+};
+
+}  // namespace Solace
+#endif  // SOLACE_PATHBUILDER_HPP
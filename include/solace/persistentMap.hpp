@@ -0,0 +1,348 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Persistent immutable map
+ *	@file		solace/persistentMap.hpp
+ *	@brief		Structurally shared immutable hash map
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_PERSISTENTMAP_HPP
+#define SOLACE_PERSISTENTMAP_HPP
+
+#include "solace/hashMap.hpp"   // hashOf() protocol and details::keyEquals()
+
+#include <memory>
+#include <vector>
+
+
+namespace Solace {
+
+/**
+ * An immutable hash map with structural sharing, the map counterpart of
+ * PersistentVector: set() and remove() return a new map sharing all
+ * untouched storage with the original, and no operation ever mutates an
+ * existing instance.
+ *
+ * Entries live in a hash-array-mapped trie consuming the key's hash 5 bits
+ * per level, so an update copies O(log32 n) small nodes and shares the rest
+ * by reference count. Keys use the same hashOf() protocol and equals()
+ * comparison as HashMap. Lookups are read-only pointer walks, so any number
+ * of threads may read one instance with no synchronization at all; derive
+ * new versions wherever convenient and publish them through AtomicShared.
+ * @see solace/atomicShared.hpp
+ *
+ * This is the read path for config-style data: HashMap remains the right
+ * choice for a table owned and mutated by one thread.
+ */
+template<typename K, typename V>
+class PersistentMap {
+public:
+    using size_type = uint32;
+
+    static constexpr uint32 kBits = 5;
+    static constexpr uint32 kWidth = 1 << kBits;        // 32-way branching.
+    static constexpr uint32 kMask = kWidth - 1;
+
+    /** Hash bits consumed before levels degrade to collision lists. */
+    static constexpr uint32 kMaxShift = 60;
+
+    struct Entry {
+        K key;
+        V value;
+    };
+
+private:
+
+    struct Node;
+    using NodePtr = std::shared_ptr<Node const>;
+    using EntryPtr = std::shared_ptr<Entry const>;
+
+    /** One trie position: either a child node or a single entry. */
+    struct Slot {
+        NodePtr     child;
+        EntryPtr    entry;
+    };
+
+    /**
+     * One trie node. Every set bit of the bitmap owns one slot; slots pack
+     * densely in bitmap order, found by a popcount of the lower bits. Nodes
+     * past kMaxShift hold hash-colliding entries as a flat list in their
+     * slots instead, bitmap unused. Nodes are immutable once published and
+     * shared between map versions by reference count.
+     */
+    struct Node {
+        uint32              bitmap {0};
+        std::vector<Slot>   slots;
+
+        uint32 slotOf(uint32 bit) const noexcept {
+            return static_cast<uint32>(__builtin_popcount(bitmap & (bit - 1)));
+        }
+    };
+
+public:
+
+    /** Construct an empty map. No storage is allocated. */
+    PersistentMap() noexcept = default;
+
+    PersistentMap(PersistentMap const&) = default;
+    PersistentMap(PersistentMap&&) noexcept = default;
+    PersistentMap& operator= (PersistentMap const&) = default;
+    PersistentMap& operator= (PersistentMap&&) noexcept = default;
+
+    size_type size() const noexcept { return _size; }
+    bool empty() const noexcept { return (_size == 0); }
+
+    /**
+     * Find the value stored under the given key.
+     * @return A pointer to the value or nullptr when the key is not present.
+     * The pointer stays valid as long as any map version holding the entry
+     * does - entries are shared between versions, never copied by updates.
+     */
+    template<typename L>
+    V const* find(L const& key) const noexcept {
+        if (!_root) {
+            return nullptr;
+        }
+
+        const auto hash = hashOf(key);
+        const Node* node = _root.get();
+
+        for (uint32 shift = 0; ; shift += kBits) {
+            if (shift > kMaxShift) {
+                // A collision list - scan it:
+                for (auto const& s : node->slots) {
+                    if (details::keyEquals(s.entry->key, key)) {
+                        return &(s.entry->value);
+                    }
+                }
+
+                return nullptr;
+            }
+
+            const auto bit = bitAt(hash, shift);
+            if ((node->bitmap & bit) == 0) {
+                return nullptr;
+            }
+
+            auto const& slot = node->slots[node->slotOf(bit)];
+            if (slot.child) {
+                node = slot.child.get();
+                continue;
+            }
+
+            return details::keyEquals(slot.entry->key, key)
+                    ? &(slot.entry->value)
+                    : nullptr;
+        }
+    }
+
+    template<typename L>
+    bool contains(L const& key) const noexcept {
+        return (find(key) != nullptr);
+    }
+
+    /** Derive a new map with the given key bound to the given value,
+     * replacing any previous binding. The receiver is unchanged.
+     */
+    PersistentMap set(K key, V value) const {
+        auto entry = std::make_shared<Entry const>(Entry{std::move(key), std::move(value)});
+        const auto hash = hashOf(entry->key);
+
+        bool replaced = false;
+        auto newRoot = _root
+                ? insertInto(*_root, 0, hash, std::move(entry), replaced)
+                : singleton(std::move(entry), hash, 0);
+
+        return PersistentMap(std::move(newRoot), replaced ? _size : _size + 1);
+    }
+
+    /** Derive a new map without the given key. The receiver is unchanged;
+     * removing an absent key returns an equal map.
+     */
+    template<typename L>
+    PersistentMap remove(L const& key) const {
+        if (!contains(key)) {
+            return *this;
+        }
+
+        return PersistentMap(removeFrom(*_root, 0, hashOf(key), key), _size - 1);
+    }
+
+    /** Apply the given function to every (key, value) pair, in unspecified order. */
+    template<typename F>
+    void forEach(F&& f) const {
+        if (_root) {
+            forEachIn(*_root, std::forward<F>(f));
+        }
+    }
+
+private:
+
+    PersistentMap(NodePtr root, size_type size) noexcept :
+        _root(std::move(root)),
+        _size(size)
+    {}
+
+    static uint32 bitAt(uint64 hash, uint32 shift) noexcept {
+        return (1u << ((hash >> shift) & kMask));
+    }
+
+    /** A node holding exactly the one given entry at the given level. */
+    static NodePtr singleton(EntryPtr entry, uint64 hash, uint32 shift) {
+        auto node = std::make_shared<Node>();
+        if (shift <= kMaxShift) {
+            node->bitmap = bitAt(hash, shift);
+        }
+        node->slots.push_back(Slot{nullptr, std::move(entry)});
+
+        return node;
+    }
+
+    /** A node holding two entries whose hashes diverge at or below shift. */
+    static NodePtr merge(EntryPtr a, uint64 hashA, EntryPtr b, uint64 hashB, uint32 shift) {
+        auto node = std::make_shared<Node>();
+        if (shift > kMaxShift) {
+            node->slots.push_back(Slot{nullptr, std::move(a)});
+            node->slots.push_back(Slot{nullptr, std::move(b)});
+
+            return node;
+        }
+
+        const auto bitA = bitAt(hashA, shift);
+        const auto bitB = bitAt(hashB, shift);
+        if (bitA == bitB) {
+            node->bitmap = bitA;
+            node->slots.push_back(
+                    Slot{merge(std::move(a), hashA, std::move(b), hashB, shift + kBits), nullptr});
+        } else {
+            node->bitmap = bitA | bitB;
+            // Slots pack in bitmap order:
+            if (bitA < bitB) {
+                node->slots.push_back(Slot{nullptr, std::move(a)});
+                node->slots.push_back(Slot{nullptr, std::move(b)});
+            } else {
+                node->slots.push_back(Slot{nullptr, std::move(b)});
+                node->slots.push_back(Slot{nullptr, std::move(a)});
+            }
+        }
+
+        return node;
+    }
+
+    static NodePtr insertInto(Node const& node, uint32 shift, uint64 hash,
+                              EntryPtr entry, bool& replaced) {
+        auto clone = std::make_shared<Node>(node);
+
+        if (shift > kMaxShift) {
+            for (auto& s : clone->slots) {
+                if (details::keyEquals(s.entry->key, entry->key)) {
+                    s.entry = std::move(entry);
+                    replaced = true;
+
+                    return clone;
+                }
+            }
+            clone->slots.push_back(Slot{nullptr, std::move(entry)});
+
+            return clone;
+        }
+
+        const auto bit = bitAt(hash, shift);
+        if ((node.bitmap & bit) == 0) {
+            clone->bitmap |= bit;
+            clone->slots.insert(clone->slots.begin() + clone->slotOf(bit),
+                                Slot{nullptr, std::move(entry)});
+
+            return clone;
+        }
+
+        auto& slot = clone->slots[node.slotOf(bit)];
+        if (slot.child) {
+            slot.child = insertInto(*slot.child, shift + kBits, hash, std::move(entry), replaced);
+
+            return clone;
+        }
+
+        if (details::keyEquals(slot.entry->key, entry->key)) {
+            slot.entry = std::move(entry);
+            replaced = true;
+
+            return clone;
+        }
+
+        // Two distinct keys in one slot - push both down a level:
+        const auto existingHash = hashOf(slot.entry->key);
+        slot.child = merge(std::move(slot.entry), existingHash,
+                           std::move(entry), hash, shift + kBits);
+        slot.entry = nullptr;
+
+        return clone;
+    }
+
+    template<typename L>
+    static NodePtr removeFrom(Node const& node, uint32 shift, uint64 hash, L const& key) {
+        auto clone = std::make_shared<Node>(node);
+
+        if (shift > kMaxShift) {
+            for (auto it = clone->slots.begin(); it != clone->slots.end(); ++it) {
+                if (details::keyEquals(it->entry->key, key)) {
+                    clone->slots.erase(it);
+                    break;
+                }
+            }
+
+            return clone->slots.empty() ? nullptr : NodePtr(std::move(clone));
+        }
+
+        const auto bit = bitAt(hash, shift);
+        const auto idx = node.slotOf(bit);
+        auto& slot = clone->slots[idx];
+
+        if (slot.child) {
+            auto sub = removeFrom(*slot.child, shift + kBits, hash, key);
+            if (sub) {
+                slot.child = std::move(sub);
+            } else {
+                clone->slots.erase(clone->slots.begin() + idx);
+                clone->bitmap &= ~bit;
+            }
+        } else {
+            clone->slots.erase(clone->slots.begin() + idx);
+            clone->bitmap &= ~bit;
+        }
+
+        return clone->slots.empty() ? nullptr : NodePtr(std::move(clone));
+    }
+
+    template<typename F>
+    static void forEachIn(Node const& node, F&& f) {
+        for (auto const& s : node.slots) {
+            if (s.child) {
+                forEachIn(*s.child, std::forward<F>(f));
+            } else {
+                f(s.entry->key, s.entry->value);
+            }
+        }
+    }
+
+private:
+
+    NodePtr     _root;
+    size_type   _size {0};
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_PERSISTENTMAP_HPP
@@ -0,0 +1,232 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Persistent immutable vector
+ *	@file		solace/persistentVector.hpp
+ *	@brief		Structurally shared immutable vector
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_PERSISTENTVECTOR_HPP
+#define SOLACE_PERSISTENTVECTOR_HPP
+
+#include "solace/types.hpp"
+#include "solace/assert.hpp"
+
+#include <memory>
+#include <vector>
+
+
+namespace Solace {
+
+/**
+ * An immutable vector with structural sharing, in the spirit of the
+ * library's immutable String and Path: no operation ever mutates an existing
+ * instance - set() and append() return a new vector sharing all untouched
+ * storage with the original.
+ *
+ * Elements live in a 32-way trie, so an update copies at most one 32-slot
+ * node per tree level - O(log32 n) nodes - while everything else is shared
+ * by reference count. That makes point updates to a large snapshot cheap
+ * where copying the whole thing is not, which is the intended use: config
+ * and routing snapshots published to readers that must never block.
+ *
+ * Instances are freely copyable across threads - a copy is two words and an
+ * atomic reference bump. Deriving a NEW version concurrently from the SAME
+ * instance is fine too; publishing it to readers is the caller's problem
+ * and what AtomicShared is for. @see solace/atomicShared.hpp
+ */
+template<typename T>
+class PersistentVector {
+public:
+    using size_type = uint32;
+
+    static constexpr uint32 kBits = 5;
+    static constexpr uint32 kWidth = 1 << kBits;        // 32-way branching.
+    static constexpr uint32 kMask = kWidth - 1;
+
+private:
+
+    /**
+     * One trie node: a branch holding child pointers or a leaf holding up to
+     * kWidth values, depending on the level it sits at. Nodes are immutable
+     * once published and shared between vector versions by reference count.
+     */
+    struct Node {
+        std::vector<std::shared_ptr<Node const>>    slots;      //!< Populated in branches.
+        std::vector<T>                              values;     //!< Populated in leaves.
+    };
+
+    using NodePtr = std::shared_ptr<Node const>;
+
+public:
+
+    /** Construct an empty vector. No storage is allocated. */
+    PersistentVector() noexcept = default;
+
+    PersistentVector(PersistentVector const&) = default;
+    PersistentVector(PersistentVector&&) noexcept = default;
+    PersistentVector& operator= (PersistentVector const&) = default;
+    PersistentVector& operator= (PersistentVector&&) noexcept = default;
+
+    size_type size() const noexcept { return _size; }
+    bool empty() const noexcept { return (_size == 0); }
+
+    /** Get the element at the given index.
+     * @throws IndexOutOfRangeException when the index is out of range.
+     */
+    T const& operator[] (size_type index) const {
+        assertIndexInRange(index, 0, _size, "PersistentVector[]");
+
+        const Node* node = _root.get();
+        for (auto shift = _shift; shift > 0; shift -= kBits) {
+            node = node->slots[(index >> shift) & kMask].get();
+        }
+
+        return node->values[index & kMask];
+    }
+
+    /** Derive a new vector with the given element appended.
+     * The receiver is unchanged; all untouched nodes are shared.
+     */
+    PersistentVector append(T value) const {
+        if (_size == 0) {
+            auto leaf = std::make_shared<Node>();
+            leaf->values.push_back(std::move(value));
+
+            return PersistentVector(std::move(leaf), 1, 0);
+        }
+
+        if ((_size & kMask) != 0) {
+            // The last leaf has room - clone the path to it:
+            return PersistentVector(appendInLeaf(_shift, *_root, std::move(value)),
+                                    _size + 1, _shift);
+        }
+
+        auto leaf = std::make_shared<Node>();
+        leaf->values.push_back(std::move(value));
+
+        if (_size == (kWidth << _shift)) {
+            // The trie is full - grow a new root on top:
+            auto newRoot = std::make_shared<Node>();
+            newRoot->slots.push_back(_root);
+            newRoot->slots.push_back(newPath(_shift, std::move(leaf)));
+
+            return PersistentVector(std::move(newRoot), _size + 1, _shift + kBits);
+        }
+
+        return PersistentVector(pushLeaf(_shift, *_root, std::move(leaf), _size),
+                                _size + 1, _shift);
+    }
+
+    /** Derive a new vector with the element at the given index replaced.
+     * The receiver is unchanged; all untouched nodes are shared.
+     * @throws IndexOutOfRangeException when the index is out of range.
+     */
+    PersistentVector set(size_type index, T value) const {
+        assertIndexInRange(index, 0, _size, "PersistentVector::set()");
+
+        return PersistentVector(assoc(_shift, *_root, index, std::move(value)),
+                                _size, _shift);
+    }
+
+    /** Apply the given function to every element in index order. */
+    template<typename F>
+    void forEach(F&& f) const {
+        if (_root) {
+            forEachIn(*_root, std::forward<F>(f));
+        }
+    }
+
+private:
+
+    PersistentVector(NodePtr root, size_type size, uint32 shift) noexcept :
+        _root(std::move(root)),
+        _size(size),
+        _shift(shift)
+    {}
+
+    /** A chain of single-slot branches of the given height ending in node. */
+    static NodePtr newPath(uint32 shift, NodePtr node) {
+        for (; shift > 0; shift -= kBits) {
+            auto branch = std::make_shared<Node>();
+            branch->slots.push_back(std::move(node));
+            node = std::move(branch);
+        }
+
+        return node;
+    }
+
+    /** Clone the path to the last leaf and append the value to its copy. */
+    static NodePtr appendInLeaf(uint32 shift, Node const& node, T&& value) {
+        auto clone = std::make_shared<Node>(node);
+        if (shift == 0) {
+            clone->values.push_back(std::move(value));
+        } else {
+            clone->slots.back() = appendInLeaf(shift - kBits, *node.slots.back(), std::move(value));
+        }
+
+        return clone;
+    }
+
+    /** Clone the path towards where the leaf holding newIndex belongs and
+     * hang the leaf there, growing fresh single-slot branches as needed. */
+    static NodePtr pushLeaf(uint32 shift, Node const& node, NodePtr leaf, size_type newIndex) {
+        auto clone = std::make_shared<Node>(node);
+        const auto slot = (newIndex >> shift) & kMask;
+
+        if (shift == kBits) {
+            clone->slots.push_back(std::move(leaf));
+        } else if (slot < node.slots.size()) {
+            clone->slots[slot] = pushLeaf(shift - kBits, *node.slots[slot], std::move(leaf), newIndex);
+        } else {
+            clone->slots.push_back(newPath(shift - kBits, std::move(leaf)));
+        }
+
+        return clone;
+    }
+
+    /** Clone the path to the given index and replace the value in the copy. */
+    static NodePtr assoc(uint32 shift, Node const& node, size_type index, T&& value) {
+        auto clone = std::make_shared<Node>(node);
+        if (shift == 0) {
+            clone->values[index & kMask] = std::move(value);
+        } else {
+            const auto slot = (index >> shift) & kMask;
+            clone->slots[slot] = assoc(shift - kBits, *node.slots[slot], index, std::move(value));
+        }
+
+        return clone;
+    }
+
+    template<typename F>
+    static void forEachIn(Node const& node, F&& f) {
+        for (auto const& v : node.values) {
+            f(v);
+        }
+        for (auto const& child : node.slots) {
+            forEachIn(*child, std::forward<F>(f));
+        }
+    }
+
+private:
+
+    NodePtr     _root;
+    size_type   _size {0};
+    uint32      _shift {0};     //!< Bit offset of the root's digit of an index.
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_PERSISTENTVECTOR_HPP
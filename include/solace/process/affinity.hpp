@@ -0,0 +1,182 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Thread placement and CPU topology
+ *	@file		solace/process/affinity.hpp
+ *	@author		$LastChangedBy: $
+ *	@date		$LastChangedDate: $
+ *	@brief		Thread placement and CPU topology
+ *	ID:			$Id: $
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_PROCESS_AFFINITY
+#define SOLACE_PROCESS_AFFINITY
+
+#include "solace/types.hpp"
+
+#include <vector>
+
+#include <sched.h>      // cpu_set_t
+
+
+namespace Solace { namespace Process {
+
+/**
+ * A set of CPU numbers, as consumed by the affinity calls.
+ */
+class CpuSet {
+public:
+
+    /** Construct an empty set. */
+    CpuSet() noexcept {
+        CPU_ZERO(&_mask);
+    }
+
+    /** Construct a set holding a single CPU. */
+    static CpuSet single(uint32 cpu) noexcept {
+        CpuSet cpus;
+        cpus.set(cpu);
+
+        return cpus;
+    }
+
+    CpuSet& set(uint32 cpu) noexcept {
+        CPU_SET(cpu, &_mask);
+
+        return *this;
+    }
+
+    CpuSet& unset(uint32 cpu) noexcept {
+        CPU_CLR(cpu, &_mask);
+
+        return *this;
+    }
+
+    bool isSet(uint32 cpu) const noexcept {
+        return CPU_ISSET(cpu, &_mask);
+    }
+
+    /** Number of CPUs in the set. */
+    uint32 count() const noexcept {
+        return static_cast<uint32>(CPU_COUNT(&_mask));
+    }
+
+    bool isEmpty() const noexcept {
+        return (count() == 0);
+    }
+
+    /** Access the underlying mask for the OS calls. */
+    cpu_set_t const& nativeHandle() const noexcept {
+        return _mask;
+    }
+
+    cpu_set_t& nativeHandle() noexcept {
+        return _mask;
+    }
+
+private:
+
+    cpu_set_t   _mask;
+};
+
+
+/**
+ * Pin the calling thread to the given set of CPUs.
+ * @param cpus CPUs the thread may run on. Must not be empty.
+ * @note IOException is thrown if the kernel rejects the mask.
+ */
+void setThreadAffinity(CpuSet const& cpus);
+
+/** Get the set of CPUs the calling thread may run on. */
+CpuSet getThreadAffinity();
+
+/**
+ * Put the calling thread into the SCHED_FIFO real-time class.
+ * @param priority Real-time priority, 1 (lowest) to 99 (highest).
+ * @note IOException is thrown if the caller lacks the privilege.
+ */
+void setRealtimePriority(int priority);
+
+/** Return the calling thread to the default time-sharing scheduler. */
+void dropRealtimePriority();
+
+/**
+ * Bind memory allocation of the calling thread to one NUMA node.
+ * Pages touched after this call come from the given node only.
+ * @param node NUMA node number.
+ * @note IOException is thrown if the node does not exist, or with
+ *  ENOSYS on kernels without set_mempolicy.
+ */
+void bindMemoryToNode(uint32 node);
+
+/** Revert the calling thread to the default memory allocation policy. */
+void resetMemoryPolicy();
+
+
+/**
+ * A snapshot of the machine CPU layout, read from the kernel at discovery
+ * time. Used at init to configure a reactor-per-core layout: one entry per
+ * online CPU carrying its NUMA node and last-level cache group, so threads
+ * that talk a lot can be placed under one cache and memory bound ones can
+ * each be given their own node.
+ */
+class Topology {
+public:
+
+    /** One online CPU. */
+    struct Cpu {
+        uint32  id;         //!< CPU number as the kernel sees it.
+        uint32  node;       //!< NUMA node the CPU belongs to.
+        uint32  cacheGroup; //!< CPUs with equal values share the last-level cache.
+    };
+
+public:
+
+    /** Read the topology of the machine this process runs on. */
+    static Topology discover();
+
+    /** All online CPUs in id order. */
+    std::vector<Cpu> const& cpus() const noexcept {
+        return _cpus;
+    }
+
+    uint32 cpuCount() const noexcept {
+        return static_cast<uint32>(_cpus.size());
+    }
+
+    /** Number of NUMA nodes seen. */
+    uint32 nodeCount() const noexcept;
+
+    /** The CPUs located on a given NUMA node. */
+    CpuSet cpusOnNode(uint32 node) const noexcept;
+
+    /** The CPUs sharing the last-level cache with the given CPU. */
+    CpuSet cpusSharingCacheWith(uint32 cpu) const noexcept;
+
+protected:
+
+    Topology(std::vector<Cpu>&& cpus) :
+        _cpus(std::move(cpus))
+    {}
+
+private:
+
+    std::vector<Cpu>    _cpus;
+};
+
+}  // End of namespace Process
+}  // End of namespace Solace
+#endif  // SOLACE_PROCESS_AFFINITY
@@ -28,6 +28,8 @@
 #include "solace/string.hpp"
 #include "solace/traits/iterable.hpp"
 
+#include <vector>
+
 
 namespace Solace { namespace Process {
 
@@ -121,6 +123,67 @@ public:
 
     typedef const Iterator const_iterator;
 
+
+    /**
+     * An immutable snapshot of the process environment.
+     *
+     * The raw environment is parsed exactly once - at capture time - into a
+     * flat buffer with a hash index over the variable names, so every
+     * subsequent lookup is an O(1) probe over owned memory: no libc call,
+     * no allocation and no locking. The snapshot does not observe later
+     * set() / unset() calls; capture a new one if that matters.
+     */
+    class Snapshot {
+    public:
+
+        Snapshot(const Snapshot&) = delete;
+        Snapshot& operator= (const Snapshot&) = delete;
+
+        Snapshot(Snapshot&&) noexcept = default;
+        Snapshot& operator= (Snapshot&&) noexcept = default;
+
+        /**
+         * Get a value of a variable as of the time of the capture.
+         *
+         * @param name Name of the variable to get value of.
+         * @return Value of the variable or None if it was not set.
+         */
+        Optional<StringView> get(StringView name) const noexcept;
+
+        /** Get the number of variables captured. */
+        size_type size() const noexcept { return _records.size(); }
+
+        /** Check if the captured environment was empty. */
+        bool empty() const noexcept { return _records.empty(); }
+
+        /**
+         * Iterate over the captured variables in environment order.
+         * @param f A callback invoked as f(name, value) for each variable.
+         * @return Reference to this for fluent interface.
+         */
+        const Snapshot& forEach(const std::function<void(StringView, StringView)>& f) const;
+
+    private:
+        friend class Env;
+
+        struct Record {
+            StringView  name;
+            StringView  value;
+            uint64      hash;
+        };
+
+        Snapshot() = default;
+
+        /// All captured "name=value" strings, back to back.
+        std::vector<char>       _data;
+
+        /// Variables in environment order, viewing into _data.
+        std::vector<Record>     _records;
+
+        /// Open-addressed hash index over _records; 0 means an empty slot.
+        std::vector<uint32>     _index;
+    };
+
 public:
 
     /**
@@ -136,6 +199,15 @@ public:
      */
     Optional<String> get(const String& name) const;
 
+    /**
+     * Capture an immutable snapshot of the current environment.
+     * All variables are parsed once into an owned, hash-indexed table;
+     * lookups against the snapshot never touch libc again.
+     *
+     * @return A snapshot of the environment as of this call.
+     */
+    Snapshot snapshot() const;
+
     /**
      * Set a value of the environment variable.
      *
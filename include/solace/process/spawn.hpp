@@ -0,0 +1,228 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Child process spawning and supervision
+ *	@file		solace/process/spawn.hpp
+ *	@author		$LastChangedBy: $
+ *	@date		$LastChangedDate: $
+ *	@brief		Child process spawning and supervision
+ *	ID:			$Id: $
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_PROCESS_SPAWN
+#define SOLACE_PROCESS_SPAWN
+
+#include "solace/future.hpp"
+#include "solace/promise.hpp"
+#include "solace/optional.hpp"
+#include "solace/stringView.hpp"
+#include "solace/io/pipe.hpp"
+#include "solace/io/selectable.hpp"
+
+#include <string>
+#include <vector>
+
+#include <sys/types.h>  // pid_t
+
+
+namespace Solace { namespace Process {
+
+/**
+ * Terminal state of a child process as reported by wait().
+ */
+struct ExitStatus {
+
+    bool    exited;     //!< True if the child exited; false if a signal terminated it.
+    int     value;      //!< The exit code when exited, the terminating signal otherwise.
+
+    /** A clean zero exit. */
+    bool isSuccess() const noexcept {
+        return (exited && value == 0);
+    }
+};
+
+
+/**
+ * A handle on a running child process.
+ *
+ * The handle is selectable: getSelectId() returns a process file descriptor
+ * that a Selector reports readable once the child has terminated, so a
+ * supervisor can park hundreds of children in one poll set instead of
+ * dedicating a thread to waitpid(). When the descriptor wakes up, call
+ * tryReap() to collect the status without blocking.
+ *
+ * Objects of this class are created via Spawner::spawn().
+ */
+class ChildProcess :
+        public IO::ISelectable {
+public:
+    using IO::ISelectable::poll_id;
+
+public:
+
+    ~ChildProcess();
+
+    ChildProcess(const ChildProcess&) = delete;
+    ChildProcess& operator= (const ChildProcess&) = delete;
+
+    ChildProcess(ChildProcess&& rhs) noexcept;
+
+    ChildProcess& operator= (ChildProcess&& rhs) noexcept {
+        return swap(rhs);
+    }
+
+    ChildProcess& swap(ChildProcess& rhs) noexcept;
+
+    /** OS id of the child process. */
+    pid_t pid() const noexcept {
+        return _pid;
+    }
+
+    /**
+     * Get the process descriptor to register with a Selector.
+     * @return A pidfd, or ISelectable::InvalidFd on kernels without
+     *  pidfd_open - fall back to wait() on those.
+     */
+    poll_id getSelectId() const override {
+        return _pidfd;
+    }
+
+    /**
+     * Get a future resolved with the exit status once the child has been
+     * reaped by tryReap() or wait().
+     * @note As with any promise this is meant to be called only once.
+     */
+    Future<ExitStatus> onExit();
+
+    /**
+     * Reap the child if it has terminated, without blocking.
+     * Meant to be called when the Selector reports the pidfd readable.
+     * @return The exit status, or none if the child is still running.
+     */
+    Optional<ExitStatus> tryReap();
+
+    /**
+     * Block until the child terminates and reap it.
+     * @return Exit status of the child.
+     */
+    ExitStatus wait();
+
+    /**
+     * Send a signal to the child.
+     * @param signum Signal number to deliver.
+     */
+    void sendSignal(int signum);
+
+protected:
+
+    friend class Spawner;
+
+    ChildProcess(pid_t id, poll_id pidfd);
+
+private:
+
+    ExitStatus complete(int rawStatus);
+
+    pid_t                   _pid;
+    poll_id                 _pidfd;
+
+    Optional<ExitStatus>    _status;        //!< Set once the child has been reaped.
+    Promise<ExitStatus>     _completion;    //!< Fulfilled when the child is reaped.
+};
+
+
+inline void swap(ChildProcess& lhs, ChildProcess& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+
+/**
+ * A builder collecting everything needed to launch one child process.
+ *
+ * The launch itself goes through posix_spawn, which on Linux shares the
+ * parent's page tables vfork-style for the exec window. A plain fork()
+ * would copy the page tables of the whole parent - a multi-hundred
+ * millisecond stall for a large-RSS supervisor - so it is deliberately
+ * not an option here.
+ *
+ * Usage example:
+ * @code{.cpp}
+ * IO::Pipe out;
+ * auto child = Spawner("/bin/echo")
+ *                  .arg("hello")
+ *                  .stdOut(out)
+ *                  .spawn();
+ * @endcode
+ */
+class Spawner {
+public:
+
+    /**
+     * Start describing a child running the given program.
+     * @param program Path of the executable image. Copied.
+     */
+    explicit Spawner(StringView program);
+
+    /**
+     * Append one command line argument.
+     * @param value Argument value. Copied; a temporary is fine.
+     * @return Reference to this for fluency.
+     */
+    Spawner& arg(StringView value);
+
+    /**
+     * Arrange for the given parent descriptor to appear in the child
+     * under the given number, dup2-style.
+     * @param childFd Descriptor number as the child will see it.
+     * @param parentFd An open descriptor of the calling process.
+     * @return Reference to this for fluency.
+     */
+    Spawner& mapFd(int childFd, IO::ISelectable::poll_id parentFd);
+
+    /** Connect the read end of the pipe to the child's stdin. */
+    Spawner& stdIn(IO::Pipe& pipe);
+
+    /** Connect the write end of the pipe to the child's stdout. */
+    Spawner& stdOut(IO::Pipe& pipe);
+
+    /** Connect the write end of the pipe to the child's stderr. */
+    Spawner& stdErr(IO::Pipe& pipe);
+
+    /**
+     * Launch the child process.
+     * @return A handle on the running child.
+     * @note IOException is thrown if the process can not be spawned.
+     */
+    ChildProcess spawn();
+
+private:
+
+    struct FdMapping {
+        int                         childFd;
+        IO::ISelectable::poll_id    parentFd;
+    };
+
+    std::string                 _program;
+    std::vector<std::string>    _args;
+    std::vector<FdMapping>      _mappings;
+
+    //!< The unused ends of connected pipes, closed in the child before exec.
+    std::vector<IO::ISelectable::poll_id>   _closeInChild;
+};
+
+}  // End of namespace Process
+}  // End of namespace Solace
+#endif  // SOLACE_PROCESS_SPAWN
@@ -28,10 +28,15 @@
 #include "solace/result.hpp"
 #include "solace/error.hpp"
 #include "solace/assert.hpp"
+#include "solace/memoryManager.hpp"
+#include "solace/timestamp.hpp"
 
 
 #include <atomic>
+#include <cstddef>      // std::max_align_t
+#include <limits>
 #include <memory>
+#include <new>          // placement new
 
 
 namespace Solace {
@@ -39,15 +44,293 @@ namespace Solace {
 namespace details  {
 
 template<typename T>
-struct CallbackBase : public std::enable_shared_from_this<CallbackBase<T>> {
+struct CallbackBase {
     virtual ~CallbackBase() = default;
 
+    CallbackBase() = default;
+
+    /// Moving is only meaningful before registration: the moved-to callback starts a fresh refcount.
+    CallbackBase(CallbackBase&& ) noexcept
+    {}
+
     virtual void operator() (Result<T, Error>&& result) = 0;
+
+    void retain() noexcept {
+        _refs.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    void release() noexcept {
+        if (_refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            dispose();
+        }
+    }
+
+protected:
+
+    /// Invoked when the last reference is gone. Heap-allocated callbacks delete themselves;
+    /// a callback embedded in somebody else's block overrides this to notify its owner instead.
+    virtual void dispose() noexcept {
+        delete this;
+    }
+
+private:
+
+    std::atomic<uint32> _refs {1};
+};
+
+
+/**
+ * An intrusive smart pointer over a callback, using the refcount built into CallbackBase.
+ * Unlike shared_ptr there is no separate control block to allocate.
+ */
+template<typename CBType>
+struct CallbackPtr {
+
+    explicit CallbackPtr(CBType* cb) noexcept : _cb(cb) {
+        _cb->retain();
+    }
+
+    CallbackPtr(const CallbackPtr& rhs) noexcept : _cb(rhs._cb) {
+        if (_cb) {
+            _cb->retain();
+        }
+    }
+
+    CallbackPtr(CallbackPtr&& rhs) noexcept : _cb(rhs._cb) {
+        rhs._cb = nullptr;
+    }
+
+    ~CallbackPtr() {
+        if (_cb) {
+            _cb->release();
+        }
+    }
+
+    CallbackPtr& operator= (const CallbackPtr&) = delete;
+    CallbackPtr& operator= (CallbackPtr&&) = delete;
+
+    CBType* operator-> () const noexcept { return _cb; }
+
+private:
+
+    CBType* _cb;
+};
+
+
+/// Callbacks that hand references to themselves out - to stay alive across a nested
+/// asynchronous chain - must live on the heap. They declare kSelfReferential to opt
+/// out of inline storage inside the core.
+template<typename CBType, typename = void>
+struct isSelfReferentialCallback : std::false_type {};
+
+template<typename CBType>
+struct isSelfReferentialCallback<CBType, std::enable_if_t<CBType::kSelfReferential>> : std::true_type {};
+
+
+/**
+ * Small-buffer-optimized storage for a core's completion handler.
+ * A continuation that fits - vtable pointer, the promise of the next stage and a small
+ * closure - is constructed in place inside the core, so a typical then() stage costs a
+ * single allocation: the core itself. Oversized or self-referential callbacks fall back
+ * to the heap.
+ */
+template<typename T>
+class CallbackStorage {
+public:
+
+    /// Room for a vtable pointer, the next stage's promise and a few captured words.
+    static constexpr size_t kInlineSize = 64;
+
+    template<typename CBType>
+    struct fitsInline : std::integral_constant<bool,
+            sizeof(CBType) <= kInlineSize &&
+            alignof(CBType) <= alignof(std::max_align_t) &&
+            !isSelfReferentialCallback<CBType>::value>
+    {};
+
+    ~CallbackStorage() {
+        reset();
+    }
+
+    CallbackStorage() = default;
+
+    CallbackStorage(const CallbackStorage&) = delete;
+    CallbackStorage& operator= (const CallbackStorage&) = delete;
+
+    template<typename CBType, typename... Args>
+    void emplace(Args&&... args) {
+        reset();
+        construct<CBType>(fitsInline<CBType>(), std::forward<Args>(args)...);
+    }
+
+    /// Take over a self-managing callback: its initial reference becomes ours.
+    void adopt(CallbackBase<T>* cb) noexcept {
+        reset();
+        _fn = cb;
+        _isInline = false;
+    }
+
+    explicit operator bool() const noexcept {
+        return (_fn != nullptr);
+    }
+
+    void operator() (Result<T, Error>&& result) {
+        (*_fn)(std::move(result));
+    }
+
+    void reset() noexcept {
+        if (!_fn) {
+            return;
+        }
+
+        auto* fn = _fn;
+        _fn = nullptr;
+        if (_isInline) {
+            fn->~CallbackBase();  // Inline callbacks are never referenced from outside
+        } else {
+            fn->release();
+        }
+    }
+
+private:
+
+    template<typename CBType, typename... Args>
+    void construct(std::true_type, Args&&... args) {
+        _fn = new (&_buffer) CBType(std::forward<Args>(args)...);
+        _isInline = true;
+    }
+
+    template<typename CBType, typename... Args>
+    void construct(std::false_type, Args&&... args) {
+        _fn = new CBType(std::forward<Args>(args)...);
+        _isInline = false;
+    }
+
+private:
+
+    CallbackBase<T>*    _fn {nullptr};
+    bool                _isInline {false};
+
+    typename std::aligned_storage<kInlineSize, alignof(std::max_align_t)>::type _buffer;
+};
+
+}  // namespace details
+
+
+/**
+ * A completion deadline carried along a Promise/Future chain.
+ *
+ * Load shedding needs the deadline to travel with the work: a stage that
+ * cannot see the request's deadline happily does work for a caller that has
+ * already timed out. A Deadline is an absolute point on the monotonic clock
+ * and nothing else - copying one copies an int64, and checking it is one
+ * clock read and a compare - so every stage boundary can afford the check.
+ *
+ * Attach one with Promise::setDeadline() (or Future::setDeadline()); every
+ * continuation chained via then()/onError() inherits it, and a stage whose
+ * input arrives after expiry is failed with an error instead of run.
+ * A default-constructed Deadline is unset and never expires.
+ */
+struct Deadline {
+
+    int64 expiryNanos {0};      //!< Monotonic clock expiry in nanoseconds; 0 for no deadline.
+
+    /** A deadline the given budget away from now. */
+    static Deadline in(int64 budgetNanos) noexcept {
+        return Deadline{Clock::monotonic().nanos + budgetNanos};
+    }
+
+    /** Is there a deadline attached at all? */
+    bool isSet() const noexcept {
+        return (expiryNanos != 0);
+    }
+
+    /** Has the deadline passed? An unset deadline never expires and costs
+     * no clock read to check. */
+    bool hasExpired() const noexcept {
+        return isSet() && (Clock::monotonic().nanos >= expiryNanos);
+    }
+
+    /** Budget left before expiry, clamped at zero; effectively unlimited
+     * when no deadline is set. Stages sizing their own work - a batch
+     * limit, a retry decision - read this instead of re-deriving time. */
+    int64 remainingNanos() const noexcept {
+        if (!isSet()) {
+            return std::numeric_limits<int64>::max();
+        }
+
+        const auto left = expiryNanos - Clock::monotonic().nanos;
+        return (left > 0) ? left : 0;
+    }
+
+    /** The error an expired stage is failed with. */
+    static Error expiredError() noexcept {
+        return Error("Deadline expired");
+    }
 };
 
+
+template<typename T>
+class Core;
+
+
+namespace details {
+
+/** The pool Core<T> instances are drawn from, or nullptr for the heap.
+ * One slot per value type; @see setFutureCorePool(). */
+template<typename T>
+std::atomic<MemoryPool*>& corePool() noexcept {
+    static std::atomic<MemoryPool*> pool{nullptr};
+
+    return pool;
+}
+
+/** Allocate a core from the configured pool, or off the heap when none is set. */
+template<typename T>
+std::shared_ptr<Core<T>> makeCore() {
+    auto* pool = corePool<T>().load(std::memory_order_acquire);
+    if (pool != nullptr) {
+        return std::allocate_shared<Core<T>>(PoolAllocator<Core<T>>(*pool));
+    }
+
+    return std::make_shared<Core<T>>();
+}
+
 }  // namespace details
 
 
+/**
+ * Route allocation of Future/Promise cores for T through the given pool.
+ *
+ * Every Promise<T> constructed afterwards - including the ones then() chains
+ * create internally - places its core and the shared_ptr control block
+ * together in one pool block, so a steady stream of async operations does no
+ * malloc in the future machinery. Core release goes through the pool's
+ * lock-free freelist and is safe from whichever thread drops the last
+ * reference.
+ *
+ * Pass nullptr to revert to the heap. The pool must hand out blocks of at
+ * least futureCoreSize<T>() bytes and must outlive every outstanding core;
+ * drawing from an exhausted pool raises OverflowException, so size the block
+ * count for peak operations in flight.
+ */
+template<typename T>
+void setFutureCorePool(MemoryPool* pool) noexcept {
+    details::corePool<T>().store(pool, std::memory_order_release);
+}
+
+
+/**
+ * The block size a future core pool for T must provide: the core itself plus
+ * a generous bound on the library's shared_ptr control block.
+ * @see setFutureCorePool()
+ */
+template<typename T>
+constexpr size_t futureCoreSize() noexcept {
+    return sizeof(Core<T>) + 8 * sizeof(void*);
+}
+
+
 template<typename T>
 class Core {
 public:
@@ -70,14 +353,19 @@ public:
         return _isDetached.load() && _result.isNone();
     }
 
-    void setCallback(std::shared_ptr<details::CallbackBase<T>>&& func) {
-        _completionHandler = std::move(func);
+    /** Construct the completion handler directly inside this core's storage. */
+    template<typename CBType, typename... Args>
+    void setCallback(Args&&... args) {
+        _completionHandler.template emplace<CBType>(std::forward<Args>(args)...);
 
-        if (_result.isSome()) {
-            (*_completionHandler)(_result.move());
-            _result = none;
-            _completionHandler.reset();
-        }
+        notifyIfFulfilled();
+    }
+
+    /** Attach a pre-built callback that manages its own lifetime. */
+    void adoptCallback(details::CallbackBase<T>* cb) {
+        _completionHandler.adopt(cb);
+
+        notifyIfFulfilled();
     }
 
     void setResult(Result<T, Error>&& result) {
@@ -87,19 +375,52 @@ public:
 
         if (_completionHandler) {
             // TODO(abbyssoul): Handle exceptions! What happenes if completion handler throws?
-            (*_completionHandler)(std::move(result));
+            _completionHandler(shedIfExpired(std::move(result)));
             _completionHandler.reset();
         } else {
             _result = std::move(result);
         }
     }
 
+    /** The deadline this core's delivery honours. @see Promise::setDeadline() */
+    Deadline deadline() const noexcept {
+        return _deadline;
+    }
+
+    void setDeadline(Deadline deadline) noexcept {
+        _deadline = deadline;
+    }
+
+private:
+
+    void notifyIfFulfilled() {
+        if (_result.isSome()) {
+            _completionHandler(shedIfExpired(_result.move()));
+            _result = none;
+            _completionHandler.reset();
+        }
+    }
+
+    /** A value delivered past the deadline is doomed work downstream: fail
+     * the stage here, at the boundary, so the rest of the chain sheds the
+     * request through the regular error path instead of computing for a
+     * caller that has already timed out. Errors pass through untouched -
+     * error handlers still get to see what happened. */
+    Result<T, Error> shedIfExpired(Result<T, Error>&& result) {
+        if (SOLACE_UNLIKELY(_deadline.hasExpired()) && !result.isError()) {
+            return Err(Deadline::expiredError());
+        }
+
+        return std::move(result);
+    }
+
 private:
 
     Optional<Result<T, Error>>      _result;
     std::atomic<bool> _fired        {false};
     std::atomic<bool> _isDetached   {false};
-    std::shared_ptr<details::CallbackBase<T>> _completionHandler;
+    Deadline                        _deadline;
+    details::CallbackStorage<T>     _completionHandler;
 
 };
 
@@ -133,7 +454,7 @@ public:
      * Construct an empty promise
      */
     Promise() :
-        _core(std::make_shared<Core<T>>())
+        _core(details::makeCore<T>())
     {}
 
     Promise(Promise<T>&& rhs) noexcept :
@@ -196,6 +517,20 @@ public:
         setValue(func());
     }
 
+    /**
+     * Attach a completion deadline to this promise's chain.
+     * Inherited by every continuation chained off the future; attach it
+     * before resolving so the first stage is covered too. @see Deadline
+     */
+    void setDeadline(Deadline deadline) noexcept {
+        _core->setDeadline(deadline);
+    }
+
+    /** The deadline attached to this chain; unset by default. */
+    Deadline deadline() const noexcept {
+        return _core->deadline();
+    }
+
 protected:
 
     template <class> friend class Future;
@@ -229,7 +564,7 @@ public:
      * Construct an empty promise
      */
     Promise() :
-        _core(std::make_shared<Core<void>>())
+        _core(details::makeCore<void>())
     {}
 
     Promise(Promise&& rhs) noexcept :
@@ -290,6 +625,20 @@ public:
         setValue();
     }
 
+    /**
+     * Attach a completion deadline to this promise's chain.
+     * Inherited by every continuation chained off the future; attach it
+     * before resolving so the first stage is covered too. @see Deadline
+     */
+    void setDeadline(Deadline deadline) noexcept {
+        _core->setDeadline(deadline);
+    }
+
+    /** The deadline attached to this chain; unset by default. */
+    Deadline deadline() const noexcept {
+        return _core->deadline();
+    }
+
 
 private:
     template <class> friend class Future;
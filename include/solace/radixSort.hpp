@@ -0,0 +1,213 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Radix sort over array views
+ *	@file		solace/radixSort.hpp
+ *	@brief		LSD radix sort for integer keys, direct and index-indirect
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_RADIXSORT_HPP
+#define SOLACE_RADIXSORT_HPP
+
+#include "solace/arrayView.hpp"
+#include "solace/parallel.hpp"  // ChunkPlan / forEachChunk / clampWorkers
+#include "solace/exception.hpp"
+
+#include <algorithm>    // std::stable_sort
+#include <cstring>      // memcpy
+#include <type_traits>
+#include <vector>
+
+
+namespace Solace {
+
+namespace details {
+
+/** Map an integer to an unsigned image with the same ordering, so byte-wise
+ * comparison from the most significant digit down agrees with operator<.
+ * Unsigned types are their own image; signed types get the sign bit flipped. */
+template<typename T>
+constexpr std::make_unsigned_t<T> radixKeyOf(T value) noexcept {
+    using U = std::make_unsigned_t<T>;
+
+    return static_cast<U>(value)
+            ^ (std::is_signed<T>::value ? (static_cast<U>(1) << (8 * sizeof(U) - 1)) : static_cast<U>(0));
+}
+
+// Below this many elements a comparison sort wins: the radix passes cost
+// a fixed number of full sweeps regardless of input size.
+constexpr uint32 kRadixSortCutoff = 2048;
+
+
+/**
+ * The LSD radix engine shared by the direct and the index-indirect sorts.
+ * Sorts the elements of view by keyOf(element), one byte per pass, ping-ponging
+ * between view and scratch. Stable. keyOf must return an unsigned integer.
+ *
+ * Each pass histograms per chunk in parallel, turns the counts into per-chunk
+ * scatter positions with one serial prefix sweep (256 * nbChunks additions),
+ * and scatters in parallel - every chunk owns its slice of the position table,
+ * so workers never contend. Passes in which all keys share the same byte are
+ * detected from the histogram and skipped without moving any data.
+ */
+template<typename T, typename KeyFn>
+void radixSortBy(ArrayView<T> view, ArrayView<T> scratch, KeyFn keyOf, uint32 nbWorkers) {
+    using U = decltype(keyOf(*view.begin()));
+    constexpr uint32 kDigits = 256;
+    constexpr uint32 kPasses = sizeof(U);
+
+    const auto len = view.size();
+    if (len < kRadixSortCutoff) {
+        std::stable_sort(view.begin(), view.end(),
+                         [&keyOf](T const& a, T const& b) { return keyOf(a) < keyOf(b); });
+        return;
+    }
+
+    if (scratch.size() < len) {
+        raise<IllegalArgumentException>("scratch");
+    }
+
+    ChunkPlan plan(len, clampWorkers(len, nbWorkers));
+    const auto nbChunks = plan.nbChunks;
+
+    // counts[digit * nbChunks + chunk]: written per chunk while histogramming,
+    // rewritten into scatter start positions by the prefix sweep.
+    std::vector<uint64> counts(static_cast<size_t>(kDigits) * nbChunks);
+
+    T* src = view.begin();
+    T* dst = scratch.begin();
+
+    for (uint32 pass = 0; pass < kPasses; ++pass) {
+        const uint32 shift = 8 * pass;
+
+        std::fill(counts.begin(), counts.end(), 0);
+        forEachChunk(len, plan, [src, shift, nbChunks, &counts, &keyOf](uint32 chunk, uint32 from, uint32 to) {
+            for (auto i = from; i < to; ++i) {
+                const auto digit = static_cast<uint32>((keyOf(src[i]) >> shift) & 0xFF);
+                ++counts[digit * nbChunks + chunk];
+            }
+        });
+
+        // A pass where every key shares the byte permutes nothing - skip it.
+        // With clustered keys this trims most passes: 64-bit keys that fit in
+        // 4 bytes cost 4 histogram sweeps but only 4 scatters.
+        uint64 position = 0;
+        bool degenerate = false;
+        for (uint32 digit = 0; digit < kDigits && !degenerate; ++digit) {
+            uint64 total = 0;
+            for (uint32 chunk = 0; chunk < nbChunks; ++chunk) {
+                total += counts[digit * nbChunks + chunk];
+            }
+
+            degenerate = (total == len);
+        }
+
+        if (degenerate) {
+            continue;
+        }
+
+        // Exclusive prefix: each slot becomes the first output index for that
+        // (digit, chunk) pair. Serial, but only kDigits * nbChunks additions.
+        for (uint32 digit = 0; digit < kDigits; ++digit) {
+            for (uint32 chunk = 0; chunk < nbChunks; ++chunk) {
+                const auto count = counts[digit * nbChunks + chunk];
+                counts[digit * nbChunks + chunk] = position;
+                position += count;
+            }
+        }
+
+        forEachChunk(len, plan, [src, dst, shift, nbChunks, &counts, &keyOf](uint32 chunk, uint32 from, uint32 to) {
+            for (auto i = from; i < to; ++i) {
+                const auto digit = static_cast<uint32>((keyOf(src[i]) >> shift) & 0xFF);
+                dst[counts[digit * nbChunks + chunk]++] = src[i];
+            }
+        });
+
+        std::swap(src, dst);
+    }
+
+    // An odd number of performed passes leaves the result in the scratch:
+    if (src != view.begin()) {
+        memcpy(view.begin(), src, len * sizeof(T));
+    }
+}
+
+}  // namespace details
+
+
+/**
+ * Sort a view of integers in ascending order with an LSD radix sort.
+ *
+ * One histogram and one scatter sweep per key byte instead of n*log(n)
+ * data-dependent branches: at 100M 64-bit keys this runs several times
+ * faster than a comparison sort, and both sweeps are split across workers.
+ * Small inputs fall back to a comparison sort automatically.
+ *
+ * @param view A view over the integers to sort.
+ * @param scratch Caller-owned working storage of at least view.size() elements.
+ * @param nbWorkers Number of workers to use, 0 for defaultParallelism().
+ */
+template<typename T>
+std::enable_if_t<std::is_integral<T>::value>
+radixSort(ArrayView<T> view, ArrayView<T> scratch, uint32 nbWorkers = 0) {
+    details::radixSortBy(view, scratch, [](T value) { return details::radixKeyOf(value); }, nbWorkers);
+}
+
+/** Sort a view of integers in ascending order, allocating the scratch internally. */
+template<typename T>
+std::enable_if_t<std::is_integral<T>::value>
+radixSort(ArrayView<T> view, uint32 nbWorkers = 0) {
+    std::vector<T> scratch(view.size());
+
+    radixSort(view, ArrayView<T>(scratch.data(), view.size()), nbWorkers);
+}
+
+
+/**
+ * Sort an index array by the keys it points into, leaving the keys in place.
+ *
+ * This is the columnar form: with values spread over SoaArray columns only
+ * the 4- or 8-byte indices move through the radix passes, and every other
+ * column is read off in sorted order through the index afterwards. Stable,
+ * so ties keep their original relative order.
+ *
+ * @param keys The key column. Read only; ArrayView carries no constness,
+ * but the keys come out exactly as they went in.
+ * @param index The indices to sort; each entry must be a valid index into keys.
+ * @param scratch Caller-owned working storage of at least index.size() entries.
+ * @param nbWorkers Number of workers to use, 0 for defaultParallelism().
+ */
+template<typename K, typename I>
+std::enable_if_t<std::is_integral<K>::value && std::is_integral<I>::value>
+radixSortIndex(ArrayView<K> keys, ArrayView<I> index, ArrayView<I> scratch, uint32 nbWorkers = 0) {
+    const K* keyData = keys.begin();
+
+    details::radixSortBy(index, scratch,
+                         [keyData](I i) { return details::radixKeyOf(keyData[i]); },
+                         nbWorkers);
+}
+
+/** Sort an index array by the keys it points into, allocating the scratch internally. */
+template<typename K, typename I>
+std::enable_if_t<std::is_integral<K>::value && std::is_integral<I>::value>
+radixSortIndex(ArrayView<K> keys, ArrayView<I> index, uint32 nbWorkers = 0) {
+    std::vector<I> scratch(index.size());
+
+    radixSortIndex(keys, index, ArrayView<I>(scratch.data(), index.size()), nbWorkers);
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_RADIXSORT_HPP
@@ -25,13 +25,20 @@
 #include "solace/immutableMemoryView.hpp"
 #include "solace/memoryView.hpp"
 #include "solace/memoryBuffer.hpp"
+#include "solace/arrayView.hpp"
+#include "solace/stringView.hpp"
 
 #include "solace/result.hpp"
 #include "solace/error.hpp"
 
+#include <cstring>  // memcpy
+
 
 namespace Solace {
 
+template<typename F>
+struct WireFieldOps;    // Codec field access, see solace/codec.hpp
+
 /**
  * A byte buffer with stream access semantic.
  * This is an adapter on top of Immutable Memory view (@see ImmutableMemoryView) to enable easy reading of data.
@@ -226,6 +233,91 @@ public:
         return read(offset, dest, dest.size());
     }
 
+    /**
+     * Read into destination storage that may be uninitialized.
+     * Equivalent to read(MemoryView&), but the view is taken by value so a
+     * temporary wrapping raw scratch memory can be passed directly. The
+     * destination's prior contents are never read - only overwritten - so a
+     * large scratch buffer needs no zero-fill before the call.
+     */
+    Result<void, Error>
+    readInto(MemoryView dest) {
+        return read(dest, dest.size());
+    }
+
+    Result<void, Error>
+    readInto(MemoryView dest, size_type bytesToRead) {
+        return read(dest, bytesToRead);
+    }
+
+    /**
+     * Copy bytes out from the current position without advancing it.
+     * As with readInto(), the destination is taken by value and its prior
+     * contents are never read, so it may be uninitialized.
+     *
+     * @param dest Buffer to store the bytes into.
+     * @return Nothing if successfull or an error.
+     */
+    Result<void, Error>
+    peek(MemoryView dest) const {
+        return read(_position, dest, dest.size());
+    }
+
+    Result<void, Error>
+    peek(MemoryView dest, size_type bytesToRead) const {
+        return read(_position, dest, bytesToRead);
+    }
+
+    /**
+     * Extract an integer field at the given offset with no position
+     * mutation - for peek-heavy parse paths where a position store per
+     * field stalls the decode loop on store-to-load forwarding. Bytes are
+     * taken as stored; @see extractAtLE()/extractAtBE() for wire-order fields.
+     *
+     * @param offset Offset of the field within this buffer.
+     * @return The extracted value or an error.
+     */
+    template<typename T>
+    std::enable_if_t<std::is_integral<T>::value, Result<T, Error>>
+    extractAt(size_type offset) const {
+        if (offset > limit() || sizeof(T) > limit() - offset) {
+            return Err<Error>(StringView("OverflowError: extractAt(): field pass the buffer end."));
+        }
+
+        T value;
+        memcpy(&value, _storage.view().dataAddress(offset), sizeof(T));
+
+        return Ok(value);
+    }
+
+    /** Extract a little-endian integer field at the given offset. No position mutation. */
+    template<typename T>
+    std::enable_if_t<std::is_integral<T>::value, Result<T, Error>>
+    extractAtLE(size_type offset) const {
+        if (offset > limit() || sizeof(T) > limit() - offset) {
+            return Err<Error>(StringView("OverflowError: extractAtLE(): field pass the buffer end."));
+        }
+
+        T raw;
+        memcpy(&raw, _storage.view().dataAddress(offset), sizeof(T));
+
+        return Ok(isBigendian() ? byteSwap(raw) : raw);
+    }
+
+    /** Extract a big-endian integer field at the given offset. No position mutation. */
+    template<typename T>
+    std::enable_if_t<std::is_integral<T>::value, Result<T, Error>>
+    extractAtBE(size_type offset) const {
+        if (offset > limit() || sizeof(T) > limit() - offset) {
+            return Err<Error>(StringView("OverflowError: extractAtBE(): field pass the buffer end."));
+        }
+
+        T raw;
+        memcpy(&raw, _storage.view().dataAddress(offset), sizeof(T));
+
+        return Ok(isBigendian() ? raw : byteSwap(raw));
+    }
+
     ImmutableMemoryView viewRemaining() const {
         return _storage.view().slice(position(), limit());
     }
@@ -234,6 +326,67 @@ public:
         return _storage.view().slice(0, position());
     }
 
+    /**
+     * A reader over a window of this buffer's storage - for decoding a nested
+     * container in place instead of copying it out. One combined bounds check
+     * covers the whole window; reads within the sub-reader then proceed
+     * exactly as reads on a top-level buffer.
+     *
+     * Note: the sub-reader borrows this buffer's storage, so this buffer
+     * must outlive it - the usual discipline of a parser call stack.
+     *
+     * @param offset Offset of the window within this buffer.
+     * @param length Number of bytes the sub-reader covers.
+     * @return A reader positioned at the start of the window or an error.
+     */
+    Result<ReadBuffer, Error> subReader(size_type offset, size_type length) const {
+        if (offset > limit() || length > limit() - offset) {
+            return Err<Error>(StringView("OverflowError: subReader(): window pass the buffer end."));
+        }
+
+        return Ok(ReadBuffer(ImmutableMemoryView(_storage.view().dataAddress() + offset, length)));
+    }
+
+    /**
+     * Read a string of the given length as a view over this buffer's storage.
+     * No bytes are copied; the view is valid for as long as this buffer is.
+     * Advances the position by the length on success.
+     */
+    Result<StringView, Error> readStringView(size_type length) {
+        if (remaining() < length) {
+            return Err<Error>(StringView("OverflowError: readStringView(): no data remained in the buffer"));
+        }
+
+        StringView result(_storage.view().dataAs<char>(_position),
+                          static_cast<StringView::size_type>(length));
+        _position += length;
+
+        return Ok(result);
+    }
+
+    /**
+     * Read an array of count elements of a trivially copyable type as a view
+     * over this buffer's storage. No bytes are copied; the view is valid for
+     * as long as this buffer is, and - ArrayView carrying no constness - is
+     * to be treated as read-only by convention, like the buffer itself.
+     * The elements are used where they lie: the caller vouches the offset is
+     * suitably aligned for T. Advances the position past the array on success.
+     */
+    template<typename T>
+    Result<ArrayView<T>, Error> readArrayView(size_type count) {
+        static_assert(std::is_trivially_copyable<T>::value,
+                      "readArrayView is for wire-format element types");
+
+        if (remaining() / sizeof(T) < count) {
+            return Err<Error>(StringView("OverflowError: readArrayView(): no data remained in the buffer"));
+        }
+
+        ArrayView<T> result(_storage.view().template dataAs<T>(_position), count);
+        _position += count * sizeof(T);
+
+        return Ok(result);
+    }
+
     Result<void, Error>  read(char*      dest) { return read(dest, sizeof(char));    }
     Result<void, Error>  read(int8*      dest) { return read(dest, sizeof(int8));    }
     Result<void, Error>  read(uint8*     dest) { return read(dest, sizeof(uint8));   }
@@ -265,9 +418,141 @@ public:
     Result<void, Error>  readBE(int64& value) { return readBE(reinterpret_cast<uint64&>(value)); }
     Result<void, Error>  readBE(uint64& value);
 
+    /**
+     * Decode an array of fixed-width integers in one go.
+     * The whole batch is covered by a single bounds check and the byte-order
+     * conversion is one tight pass over the array that compilers vectorize,
+     * instead of a position update and limit check per element.
+     *
+     * @param dest Array of at least count elements to decode into.
+     * @param count Number of elements to decode.
+     * @return Nothing if successfull or an error.
+     */
+    Result<void, Error>  readLE(uint16* dest, size_type count);
+    Result<void, Error>  readLE(uint32* dest, size_type count);
+    Result<void, Error>  readLE(uint64* dest, size_type count);
+    Result<void, Error>  readLE(int16* dest, size_type count) { return readLE(reinterpret_cast<uint16*>(dest), count); }
+    Result<void, Error>  readLE(int32* dest, size_type count) { return readLE(reinterpret_cast<uint32*>(dest), count); }
+    Result<void, Error>  readLE(int64* dest, size_type count) { return readLE(reinterpret_cast<uint64*>(dest), count); }
+
+    Result<void, Error>  readBE(uint16* dest, size_type count);
+    Result<void, Error>  readBE(uint32* dest, size_type count);
+    Result<void, Error>  readBE(uint64* dest, size_type count);
+    Result<void, Error>  readBE(int16* dest, size_type count) { return readBE(reinterpret_cast<uint16*>(dest), count); }
+    Result<void, Error>  readBE(int32* dest, size_type count) { return readBE(reinterpret_cast<uint32*>(dest), count); }
+    Result<void, Error>  readBE(int64* dest, size_type count) { return readBE(reinterpret_cast<uint64*>(dest), count); }
+
+    /**
+     * Decode a base-128 varint (LEB128, as used by protobuf).
+     * The common case - at least 8 bytes left in the buffer - is served by a
+     * single unaligned 8-byte load with no bounds check per encoded byte.
+     *
+     * @param value Integer to decode into.
+     * @return Nothing if successfull or an error if the varint is truncated
+     * or longer than the 10-byte maximum.
+     */
+    Result<void, Error>  readVarint(uint64& value);
+
+    Result<void, Error>  readVarint(uint32& value) {
+        uint64 wide;
+
+        return readVarint(wide).then([&]() { value = static_cast<uint32>(wide); });
+    }
+
+    /**
+     * Decode a zig-zag encoded signed varint, so that small negative values
+     * stay short on the wire.
+     */
+    Result<void, Error>  readVarint(int64& value) {
+        uint64 encoded;
+
+        return readVarint(encoded).then([&]() {
+            value = static_cast<int64>(encoded >> 1) ^ -static_cast<int64>(encoded & 1);
+        });
+    }
+
+    Result<void, Error>  readVarint(int32& value) {
+        int64 wide;
+
+        return readVarint(wide).then([&]() { value = static_cast<int32>(wide); });
+    }
+
+    /**
+     * Decode a fixed sequence of mixed-width integer fields in one go.
+     * The field list describes a wire-format struct: all fields are bounds
+     * checked as one unit, so a multi-field message header costs a single
+     * limit check instead of one per field.
+     *
+     * @return Nothing if successfull or an error; no field is decoded on error.
+     */
+    template<typename T, typename U, typename... Fields>
+    std::enable_if_t<allIntegral<T, U, Fields...>::value, Result<void, Error>>
+    readLE(T& first, U& second, Fields&... rest) {
+        if (remaining() < fieldsSize<T, U, Fields...>()) {
+            return Err<Error>(StringView("UnderflowError: readLE(fields): not enough data in the buffer"));
+        }
+
+        decodeLE(first, second, rest...);
+
+        return Ok();
+    }
+
+    template<typename T, typename U, typename... Fields>
+    std::enable_if_t<allIntegral<T, U, Fields...>::value, Result<void, Error>>
+    readBE(T& first, U& second, Fields&... rest) {
+        if (remaining() < fieldsSize<T, U, Fields...>()) {
+            return Err<Error>(StringView("UnderflowError: readBE(fields): not enough data in the buffer"));
+        }
+
+        decodeBE(first, second, rest...);
+
+        return Ok();
+    }
+
 protected:
+
+    //!< Codec decodes whole runs of fixed fields under one bounds check:
+    template<typename F>
+    friend struct WireFieldOps;
+
     Result<void, Error>  read(void* dest, size_type count);
 
+    template<typename T>
+    static constexpr size_type fieldsSize() noexcept { return sizeof(T); }
+
+    template<typename T, typename U, typename... Fields>
+    static constexpr size_type fieldsSize() noexcept { return sizeof(T) + fieldsSize<U, Fields...>(); }
+
+    /** Decode one field from the current position. Caller has checked the bounds. */
+    template<typename T>
+    T getUnchecked() noexcept {
+        T value;
+        memcpy(&value, _storage.view().dataAddress(_position), sizeof(T));
+        _position += sizeof(T);
+
+        return value;
+    }
+
+    void decodeLE() noexcept {}
+
+    template<typename T, typename... Fields>
+    void decodeLE(T& field, Fields&... rest) noexcept {
+        const auto raw = getUnchecked<T>();
+        field = isBigendian() ? byteSwap(raw) : raw;
+
+        decodeLE(rest...);
+    }
+
+    void decodeBE() noexcept {}
+
+    template<typename T, typename... Fields>
+    void decodeBE(T& field, Fields&... rest) noexcept {
+        const auto raw = getUnchecked<T>();
+        field = isBigendian() ? raw : byteSwap(raw);
+
+        decodeBE(rest...);
+    }
+
 protected:
 
     size_type           _position{};
@@ -0,0 +1,179 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Record iteration over raw memory
+ *	@file		solace/recordCursor.hpp
+ *	@brief		Zero-copy line/record scanning of mapped files
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_RECORDCURSOR_HPP
+#define SOLACE_RECORDCURSOR_HPP
+
+#include "solace/immutableMemoryView.hpp"
+#include "solace/stringView.hpp"
+#include "solace/parallel.hpp"
+
+#include <cstring>  // memchr
+#include <limits>
+
+
+namespace Solace {
+
+/** A record cursor over delimiter-separated bytes.
+ *
+ * Iterates the records of a memory view - a mapped file, typically - without
+ * copying or allocating: the cursor only holds an offset into the view it was
+ * constructed over, and each next() is one delimiter scan via the bulk byte
+ * search of the libc. The view's bytes must outlive the cursor and every
+ * record handed out.
+ *
+ * Records are yielded without their delimiter; a final record with no
+ * trailing delimiter is yielded too. Consecutive delimiters yield empty
+ * records.
+ *
+ * @note A record longer than a StringView can address is yielded in maximal
+ * pieces - only the piece ending at the delimiter is a complete record.
+ */
+class RecordCursor {
+public:
+
+    using size_type = ImmutableMemoryView::size_type;
+
+public:
+
+    RecordCursor(ImmutableMemoryView data, byte delimiter = '\n') noexcept
+        : _data(data)
+        , _delimiter(delimiter)
+    {}
+
+    /** @return True if there are more records to read. */
+    bool hasNext() const noexcept {
+        return (_offset < _data.size());
+    }
+
+    /** @return Offset in bytes of the next record to be read. */
+    constexpr size_type offset() const noexcept {
+        return _offset;
+    }
+
+    /** Scan out the next record and advance the cursor past its delimiter.
+     * Must not be called when hasNext() is false.
+     *
+     * @return The record at the current position, delimiter excluded.
+     */
+    StringView next() noexcept;
+
+private:
+
+    ImmutableMemoryView _data;
+    size_type           _offset{0};
+    byte                _delimiter;
+};
+
+
+/**
+ * Apply a function to every record of a view, splitting the work across workers.
+ *
+ * Provisional equal-size cuts are moved forward to the next record boundary,
+ * so every record is seen whole by exactly one worker. Records within a chunk
+ * arrive in file order; chunks run concurrently, so the function must be safe
+ * to call from multiple threads. With one worker - or when asked for zero on
+ * a single-core host - no threads are spawned at all.
+ *
+ * @param data A view over the records to process.
+ * @param f A function to apply to each record.
+ * @param delimiter The byte separating records.
+ * @param nbWorkers Number of workers to use, 0 for defaultParallelism().
+ */
+template<typename F>
+void forEachRecord(ImmutableMemoryView data, F&& f, byte delimiter = '\n', uint32 nbWorkers = 0) {
+    const auto size = data.size();
+    if (size == 0) {
+        return;
+    }
+
+    if (nbWorkers == 0) {
+        nbWorkers = defaultParallelism();
+    }
+
+    if (nbWorkers <= 1) {
+        RecordCursor cursor(data, delimiter);
+        while (cursor.hasNext()) {
+            f(cursor.next());
+        }
+
+        return;
+    }
+
+    // Cut points: even splits, each advanced past the delimiter that follows.
+    std::vector<ImmutableMemoryView::size_type> cuts;
+    cuts.reserve(nbWorkers + 1);
+    cuts.push_back(0);
+    for (uint32 i = 1; i < nbWorkers; ++i) {
+        const auto provisional = (size * i) / nbWorkers;
+        if (provisional <= cuts.back()) {
+            continue;
+        }
+
+        auto const* base = data.dataAddress();
+        auto const* hit = static_cast<byte const*>(
+                    memchr(base + provisional, delimiter, size - provisional));
+        const auto boundary = (hit == nullptr)
+                ? size
+                : static_cast<ImmutableMemoryView::size_type>(hit - base) + 1;
+        if (boundary > cuts.back() && boundary < size) {
+            cuts.push_back(boundary);
+        }
+    }
+    cuts.push_back(size);
+
+    std::vector<std::thread> workers;
+    std::vector<std::exception_ptr> errors(cuts.size() - 1);
+    workers.reserve(cuts.size() - 2);
+
+    for (size_t i = 0; i + 1 < cuts.size(); ++i) {
+        auto task = [&data, &f, &errors, delimiter, i, &cuts]() {
+            try {
+                RecordCursor cursor(data.slice(cuts[i], cuts[i + 1]), delimiter);
+                while (cursor.hasNext()) {
+                    f(cursor.next());
+                }
+            } catch (...) {
+                errors[i] = std::current_exception();
+            }
+        };
+
+        // The calling thread takes the last chunk itself:
+        if (i + 2 < cuts.size()) {
+            workers.emplace_back(std::move(task));
+        } else {
+            task();
+        }
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+
+    for (const auto& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_RECORDCURSOR_HPP
@@ -26,6 +26,7 @@
 
 #include "solace/types.hpp"
 #include "solace/assert.hpp"
+#include "solace/array.hpp"
 #include "solace/optional.hpp"
 
 #include <functional>
@@ -232,7 +233,7 @@ public:
      * @param rhs Source to copy values from
      */
     Result(const Result& rhs) /*noexcept*/ {
-        if (rhs.isOk()) {
+        if (SOLACE_LIKELY(rhs.isOk())) {
             ::new (reinterpret_cast<void *>(std::addressof(_value))) StoredValue_type(rhs._value);
             _engaged = true;
         } else {
@@ -246,7 +247,7 @@ public:
      * @param rhs Source to move values from
      */
     Result(Result&& rhs) noexcept {
-        if (rhs.isOk()) {
+        if (SOLACE_LIKELY(rhs.isOk())) {
             ::new (reinterpret_cast<void *>(std::addressof(_value))) StoredValue_type(std::move(rhs._value));
             _engaged = true;
         } else {
@@ -257,7 +258,7 @@ public:
 
     template<typename DV>
     Result(const Result<DV, E>& rhs) /*noexcept*/ {
-        if (rhs.isOk()) {
+        if (SOLACE_LIKELY(rhs.isOk())) {
             ::new (reinterpret_cast<void *>(std::addressof(_value))) StoredValue_type(rhs._value);
             _engaged = true;
         } else {
@@ -268,7 +269,7 @@ public:
 
     template<typename DV>
     Result(Result<DV, E>&& rhs) noexcept {
-        if (rhs.isOk()) {
+        if (SOLACE_LIKELY(rhs.isOk())) {
             ::new (reinterpret_cast<void *>(std::addressof(_value))) StoredValue_type(std::move(rhs._value));
             _engaged = true;
         } else {
@@ -293,7 +294,7 @@ public:
     std::enable_if_t<ResT::value, typename ResT::type>
     then(F&& f) {
 
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             // TODO(abbyssoul): We probably should handle exeptions here
             return f(moveResult());
         }
@@ -308,7 +309,7 @@ public:
     Result<R, E>>
     then(F&& f) {
 
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             // TODO(abbyssoul): Handle exeptions and convert then into Error
             return Ok<R>(f(moveResult()));
         }
@@ -323,7 +324,7 @@ public:
     std::enable_if_t<std::is_same<void, R>::value, Result<R, E>>
     then(F&& f) {
 
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             // TODO(abbyssoul): Handle exeptions and convert them into error_type
             f(moveResult());
 
@@ -340,7 +341,7 @@ public:
              typename R = typename std::result_of<F(E)>::type>
     std::enable_if_t<isResult<V, E, R>::value, typename isResult<V, E, R>::type>
     orElse(F&& f) {
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             return Ok(moveResult());
         }
 
@@ -352,7 +353,7 @@ public:
              typename RE = typename std::result_of<F(E)>::type>
     std::enable_if_t<!isResult<V, E, RE>::value, Result<RE, E>>
     orElse(F&& f) {
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             return Ok(moveResult());
         }
 
@@ -369,7 +370,7 @@ public:
     template<typename F,
              typename EE = typename std::result_of<F(E)>::type>
     Result<V, EE> mapError(F&& f) {
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             return Ok(moveResult());
         }
 
@@ -382,8 +383,8 @@ public:
     Result& swap(Result& rhs) noexcept {
         using std::swap;
 
-        if (isOk()) {
-            if (rhs.isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
+            if (SOLACE_LIKELY(rhs.isOk())) {
 //                swap(_value, rhs._value);
 
                 StoredValue_type v(std::move(_value));
@@ -396,7 +397,7 @@ public:
             }
 
         } else {
-            if (rhs.isOk()) {
+            if (SOLACE_LIKELY(rhs.isOk())) {
                 StoredValue_type v(std::move(rhs._value));
                 rhs.constructError(std::move(_error));
                 constructValue(std::move(v));
@@ -429,41 +430,94 @@ public:
         return !_engaged;
     }
 
-    const V& unwrap() const {
-        if (isError())
+    const V& unwrap() const& {
+        if (SOLACE_UNLIKELY(isError()))
             raiseInvalidStateError();
 
         return _value;
     }
 
-    V& unwrap() {
-        if (isError())
+    V& unwrap() & {
+        if (SOLACE_UNLIKELY(isError()))
             raiseInvalidStateError();
 
         return _value;
     }
 
+    /** Unwrapping a temporary moves the value out - parse(s).unwrap()
+     * hands over a String without the copy the lvalue overloads make. */
+    V&& unwrap() && {
+        if (SOLACE_UNLIKELY(isError()))
+            raiseInvalidStateError();
+
+        return std::move(_value);
+    }
+
+    // A const temporary could only be copied from; make the copy visible at the call site.
+    const V&& unwrap() const&& = delete;
+
     V&& moveResult() {
-        if (isError())
+        if (SOLACE_UNLIKELY(isError()))
             raiseInvalidStateError();
 
         return std::move(_value);
     }
 
+    /**
+     * Get the stored value without checking the state.
+     * Only valid when isOk() is true: for loops that have already branched
+     * on it, this folds the test-and-access double check into one branch.
+     */
+    constexpr V const& unwrapUnsafe() const noexcept {
+        return _value;
+    }
+
+    /** @see unwrapUnsafe() const */
+    V& unwrapUnsafe() noexcept {
+        return _value;
+    }
+
+    /**
+     * Move the stored value out without checking the state.
+     * Only valid when isOk() is true: the counterpart of unwrapUnsafe() for
+     * callers that have already branched and want a guaranteed move-out.
+     */
+    V&& moveResultUnsafe() noexcept {
+        return std::move(_value);
+    }
+
+    /**
+     * Move the stored error out without checking the state.
+     * Only valid when isError() is true.
+     */
+    E&& moveErrorUnsafe() noexcept {
+        return std::move(_error);
+    }
+
     E&& moveError() {
-        if (isOk())
+        if (SOLACE_UNLIKELY(isOk()))
             raiseInvalidStateError();
 
         return std::move(_error);
     }
 
-    const E& getError() const {
-        if (isOk())
+    const E& getError() const& {
+        if (SOLACE_UNLIKELY(isOk()))
             raiseInvalidStateError();
 
         return _error;
     }
 
+    /** @see Result::unwrap() && - a temporary moves the error out. */
+    E&& getError() && {
+        if (SOLACE_UNLIKELY(isOk()))
+            raiseInvalidStateError();
+
+        return std::move(_error);
+    }
+
+    const E&& getError() const&& = delete;
+
 private:
 
     void destroy() {
@@ -591,7 +645,7 @@ public:
     std::enable_if_t<isResult<void, E, R>::value, typename isResult<void, E, R>::type>
     then(F&& f) {
 
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             // TODO(abbyssoul): We probably should handle exeptions here
             return f();
         }
@@ -605,7 +659,7 @@ public:
     std::enable_if_t<!std::is_same<R, void>::value && !isResult<void, E, R>::value, Result<R, E>>
     then(F&& f) {
 
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             // TODO(abbyssoul): Handle exeptions and convert then into Error
             return Ok<R>(f());
         }
@@ -620,7 +674,7 @@ public:
     std::enable_if_t<std::is_same<void, R>::value, Result<R, E>>
     then(F&& f) {
 
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             // TODO(abbyssoul): Handle exeptions and convert then into Error
             f();
 
@@ -636,7 +690,7 @@ public:
     std::enable_if_t<std::is_same<void, R>::value, Result<R, E>>
     then(F&& f) const {
 
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             // TODO(abbyssoul): Handle exeptions and convert then into Error
             f();
 
@@ -652,7 +706,7 @@ public:
              typename R = typename std::result_of<F(E)>::type>
     std::enable_if_t<isResult<void, E, R>::value, typename isResult<void, E, R>::type>
     orElse(F&& f) {
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             return Ok();
         }
 
@@ -663,7 +717,7 @@ public:
              typename R = typename std::result_of<F(E)>::type>
     std::enable_if_t<!std::is_same<void, R>::value && !isResult<void, E, R>::value, Result<R, E>>
     orElse(F&& f) {
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             return Ok();
         }
 
@@ -674,7 +728,7 @@ public:
              typename U = typename std::result_of<F(E)>::type>
     std::enable_if_t<std::is_same<void, U>::value, Result<U, E>>
     orElse(F&& f) {
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             return Ok();
         }
 
@@ -693,7 +747,7 @@ public:
     template<typename F,
              typename ER = typename std::result_of<F(E)>::type>
     Result<void, ER> mapError(F&& f) {
-        if (isOk()) {
+        if (SOLACE_LIKELY(isOk())) {
             return Ok();
         }
 
@@ -724,18 +778,37 @@ public:
         return _maybeError.isSome();
     }
 
-    const E& getError() const {
+    const E& getError() const& {
         return _maybeError.get();
     }
 
-    E& getError() {
+    E& getError() & {
         return _maybeError.get();
     }
 
+    /** @see Result::unwrap() && - a temporary moves the error out. */
+    E&& getError() && {
+        return _maybeError.move();
+    }
+
+    const E&& getError() const&& = delete;
+
     E&& moveError() {
         return _maybeError.move();
     }
 
+    /** No-op for the void specialisation, so SOLACE_TRY works uniformly. */
+    void moveResultUnsafe() noexcept {
+    }
+
+    /**
+     * Move the stored error out without checking the state.
+     * Only valid when isError() is true.
+     */
+    E&& moveErrorUnsafe() {
+        return _maybeError.move();
+    }
+
 private:
     Optional<error_type> _maybeError;
 };
@@ -761,5 +834,122 @@ bool operator == (const Result<V, E>& res, const types::Err<E>& errValue) {
     return res.isError() && (res.getError() == errValue.val_);
 }
 
+
+namespace details {
+
+/** Pick apart a Result type into its value and error types. */
+template <typename R>
+struct ResultTraits;
+
+template <typename V, typename E>
+struct ResultTraits<Result<V, E>> {
+    using value_type = V;
+    using error_type = E;
+};
+
+}  // End of namespace details
+
+
+/**
+ * Apply a Result-returning function to every element of a view, collecting
+ * the successes into an Array.
+ *
+ * Stops at the first error and returns it; on full success the outputs are
+ * moved straight into the array's storage, reserved up front, so a batch
+ * of N validations costs one allocation and one branch per element instead
+ * of a hand-written then/orElse chain.
+ *
+ * @param input Elements to feed to the function, in order.
+ * @param f A callable mapping an element to Result<T, E>.
+ * @return An array of all the outputs, or the first error encountered.
+ */
+template<typename U, typename F,
+         typename R = decltype(std::declval<F>()(std::declval<U&>())),
+         typename T = typename details::ResultTraits<R>::value_type,
+         typename E = typename details::ResultTraits<R>::error_type>
+Result<Array<T>, E>
+collect(ArrayView<U> input, F&& f) {
+    typename Array<T>::Storage storage;
+    storage.reserve(input.size());
+
+    for (auto& element : input) {
+        auto r = f(element);
+        if (SOLACE_UNLIKELY(r.isError())) {
+            return Err(r.moveError());
+        }
+
+        storage.emplace_back(r.moveResult());
+    }
+
+    return Ok(Array<T>(std::move(storage)));
+}
+
+
+/**
+ * Apply a Result-returning function to every element of a view for its
+ * effect only, short-circuiting on the first error.
+ *
+ * The companion of collect() for validation loops that do not keep the
+ * outputs: values produced by the function are discarded.
+ *
+ * @param input Elements to feed to the function, in order.
+ * @param f A callable mapping an element to a Result.
+ * @return Ok if the function succeeded on every element, else the first error.
+ */
+template<typename U, typename F,
+         typename R = decltype(std::declval<F>()(std::declval<U&>())),
+         typename E = typename details::ResultTraits<R>::error_type>
+Result<void, E>
+traverse(ArrayView<U> input, F&& f) {
+    for (auto& element : input) {
+        auto r = f(element);
+        if (SOLACE_UNLIKELY(r.isError())) {
+            return Err(r.moveError());
+        }
+    }
+
+    return Ok();
+}
+
 }  // End of namespace Solace
+
+
+#define SOLACE_TRY_CONCAT_(a, b) a##b
+#define SOLACE_TRY_CONCAT(a, b) SOLACE_TRY_CONCAT_(a, b)
+
+/**
+ * Propagate the error of a Result-producing expression out of the calling
+ * function, or bind its value to a fresh variable.
+ *
+ * Expands to one unlikely branch: on error the calling function returns
+ * Err() of the moved-out error; on success the value is moved out of the
+ * temporary, so deep call chains pay neither re-checks nor Result copies
+ * per frame. The calling function must itself return a Result with the
+ * same error type, and the macro must be used as a statement:
+ *
+ *      SOLACE_TRY(file, openSomething(name));      // file is the Ok value
+ *      return file.read(buffer);
+ */
+#define SOLACE_TRY(varname, ...)                                                \
+    auto SOLACE_TRY_CONCAT(_solaceTry_, varname) = (__VA_ARGS__);               \
+    if (SOLACE_UNLIKELY(SOLACE_TRY_CONCAT(_solaceTry_, varname).isError())) {   \
+        return ::Solace::Err(                                                   \
+                SOLACE_TRY_CONCAT(_solaceTry_, varname).moveErrorUnsafe());     \
+    }                                                                           \
+    auto&& varname = SOLACE_TRY_CONCAT(_solaceTry_, varname).moveResultUnsafe()
+
+/**
+ * As SOLACE_TRY, for expressions evaluated for effect only: propagates the
+ * error and discards the Ok value. This is the Result<void> form of the
+ * `if (!r) return r.moveError()` boilerplate.
+ */
+#define SOLACE_TRY_VOID(...)                                                    \
+    do {                                                                        \
+        auto SOLACE_TRY_CONCAT(_solaceTry_, __LINE__) = (__VA_ARGS__);          \
+        if (SOLACE_UNLIKELY(SOLACE_TRY_CONCAT(_solaceTry_, __LINE__).isError())) {  \
+            return ::Solace::Err(                                               \
+                    SOLACE_TRY_CONCAT(_solaceTry_, __LINE__).moveErrorUnsafe());    \
+        }                                                                       \
+    } while (false)
+
 #endif  // SOLACE_RESULT_HPP
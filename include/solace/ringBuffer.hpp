@@ -0,0 +1,179 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Ring buffer
+ *	@file		solace/ringBuffer.hpp
+ *	@brief		Single-producer single-consumer circular byte buffer
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_RINGBUFFER_HPP
+#define SOLACE_RINGBUFFER_HPP
+
+#include "solace/memoryView.hpp"
+#include "solace/memoryBuffer.hpp"
+
+#include "solace/result.hpp"
+#include "solace/error.hpp"
+
+#include <atomic>
+
+
+namespace Solace {
+
+/**
+ * A circular byte buffer for streaming bytes between one producer and one consumer.
+ *
+ * Unlike ByteBuffer, which must be compacted once the write position reaches
+ * the end of the storage, a ring buffer wraps around: bytes are never moved
+ * after they are written. The storage size must be a power of two so that
+ * wrap-around is a bit mask of free-running cursors instead of a division.
+ *
+ * The read and write cursors are published with acquire/release atomics, so
+ * exactly one producer thread may write while exactly one consumer thread
+ * reads, with no further locking. No more than one thread may be on either
+ * side at a time.
+ *
+ * Both the copying API (read/write) and a zero-copy one are provided: the
+ * view*() accessors expose the contiguous run of readable bytes or writable
+ * space up to the wrap point, and commitRead()/commitWrite() advance the
+ * cursor after the caller has consumed or filled such a run directly.
+ */
+class RingBuffer {
+public:
+
+    using Storage = MemoryBuffer;
+    using size_type = Storage::size_type;
+
+public:
+
+    /** Construct an empty ring of size zero */
+    RingBuffer() noexcept = default;
+
+    RingBuffer(RingBuffer const&) = delete;
+    RingBuffer& operator= (RingBuffer const&) = delete;
+
+    /**
+     * Construct the ring buffer by moving content from the other buffer.
+     * @note Moving is only safe while no other thread uses the ring.
+     * @param other Other buffer to take over from
+     */
+    RingBuffer(RingBuffer&& other) noexcept :
+        _readCursor(other._readCursor.load(std::memory_order_relaxed)),
+        _writeCursor(other._writeCursor.load(std::memory_order_relaxed)),
+        _storage(std::move(other._storage))
+    {}
+
+    /**
+     * Construct the ring buffer over the given storage.
+     * @param buffer Storage the ring lives in. Its size must be a power of two.
+     *
+     * @throws IllegalArgumentException if the storage size is not a power of two.
+     */
+    RingBuffer(MemoryBuffer buffer);
+
+
+    /** Returns this buffer's capacity.
+     * @return Maximum number of bytes the ring can hold at once.
+     */
+    size_type capacity() const noexcept { return _storage.size(); }
+
+    /**
+     * Get the number of bytes written but not yet read.
+     * @return Number of bytes available for reading.
+     */
+    size_type size() const noexcept {
+        return _writeCursor.load(std::memory_order_acquire) - _readCursor.load(std::memory_order_acquire);
+    }
+
+    /**
+     * Get the number of bytes that can be written before the ring is full.
+     * @return Number of bytes of free space.
+     */
+    size_type remaining() const noexcept { return capacity() - size(); }
+
+    bool empty() const noexcept { return size() == 0; }
+
+    bool full() const noexcept { return size() == capacity(); }
+
+
+    /**
+     * Write given raw bytes into the ring, wrapping around the end of the
+     * storage if needed. All-or-nothing: on error nothing is written.
+     * @param data Raw bytes data to write.
+     * @return Nothing if successfull or an error if the ring lacks the space.
+     */
+    Result<void, Error> write(ImmutableMemoryView const& data);
+
+    /**
+     * Read bytes from the ring into the given destination.
+     * All-or-nothing: on error nothing is consumed.
+     * @param dest Buffer to store read data into.
+     * @return Nothing if successfull or an error if fewer bytes are available.
+     */
+    Result<void, Error> read(MemoryView& dest) {
+        return read(dest, dest.size());
+    }
+
+    Result<void, Error> read(MemoryView& dest, size_type bytesToRead);
+
+
+    /**
+     * View the contiguous run of readable bytes up to the wrap point.
+     * There may be more data in the ring than the run shows; a second call
+     * after commitRead() of the full run returns the wrapped remainder.
+     * @return A view of readable bytes. May be empty.
+     */
+    ImmutableMemoryView viewReadable() const noexcept;
+
+    /**
+     * View the contiguous run of writable space up to the wrap point.
+     * There may be more free space in the ring than the run shows; a second
+     * call after commitWrite() of the full run returns the wrapped remainder.
+     * @return A view of writable space. May be empty.
+     */
+    MemoryView viewWritable() noexcept;
+
+    /**
+     * Mark bytes at the head of the readable run as consumed.
+     * @param count Number of bytes consumed. Must not exceed size().
+     * @return Nothing if successfull or an error.
+     */
+    Result<void, Error> commitRead(size_type count);
+
+    /**
+     * Mark bytes at the head of the writable run as written.
+     * @param count Number of bytes written. Must not exceed remaining().
+     * @return Nothing if successfull or an error.
+     */
+    Result<void, Error> commitWrite(size_type count);
+
+protected:
+
+    /** Offset into the storage a free-running cursor maps to. */
+    size_type maskCursor(size_type cursor) const noexcept {
+        return cursor & (capacity() - 1);
+    }
+
+private:
+
+    std::atomic<size_type>  _readCursor{0};
+    std::atomic<size_type>  _writeCursor{0};
+
+    Storage                 _storage;
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_RINGBUFFER_HPP
@@ -0,0 +1,213 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Segmented Read Buffer
+ *	@file		solace/segmentedReadBuffer.hpp
+ *	@brief		Read-only byte stream over a chain of memory segments
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_SEGMENTEDREADBUFFER_HPP
+#define SOLACE_SEGMENTEDREADBUFFER_HPP
+
+#include "solace/immutableMemoryView.hpp"
+#include "solace/memoryView.hpp"
+#include "solace/arrayView.hpp"
+
+#include "solace/result.hpp"
+#include "solace/error.hpp"
+
+#include <vector>
+
+
+namespace Solace {
+
+/**
+ * A read buffer over an ordered chain of non-contiguous memory segments.
+ *
+ * ReadBuffer requires one contiguous view, which forces protocol parsers
+ * reassembling scattered input - TCP segments, iovec reads, ring slots -
+ * to linearize the bytes into a scratch buffer first. This buffer presents
+ * the same read()/readLE()/readBE() stream API directly over the segment
+ * chain, so the payload is parsed where it landed and never copied whole.
+ *
+ * Reads that fit inside the current segment - which is every read but the
+ * few that straddle a boundary - take a contiguous fast path: one bounds
+ * check and one memcpy, same cost as ReadBuffer. Only a value split across
+ * two segments falls back to a byte-gathering loop.
+ *
+ * The buffer does not own the segment bytes: the caller keeps the backing
+ * memory alive for the lifetime of the reader, as with the view-wrapping
+ * ReadBuffer constructor.
+ */
+class SegmentedReadBuffer {
+public:
+
+    using size_type = ImmutableMemoryView::size_type;
+
+public:
+
+    /** Construct an empty buffer of size zero */
+    SegmentedReadBuffer() noexcept = default;
+
+    SegmentedReadBuffer(SegmentedReadBuffer const& other) = delete;
+    SegmentedReadBuffer& operator= (SegmentedReadBuffer const&) = delete;
+
+    SegmentedReadBuffer(SegmentedReadBuffer&& other) = default;
+    SegmentedReadBuffer& operator= (SegmentedReadBuffer&& rhs) = default;
+
+    /**
+     * Construct the buffer over an ordered list of segments.
+     * @param segments Views over the segments, in stream order. Empty views are skipped.
+     */
+    SegmentedReadBuffer(ArrayView<ImmutableMemoryView const> segments) {
+        for (auto const& segment : segments) {
+            append(segment);
+        }
+    }
+
+    /**
+     * Append one more segment to the end of the chain, e.g. as the next
+     * packet of a message arrives. Appending does not move the position.
+     *
+     * @param segment View over the bytes to append. An empty view is skipped.
+     * @return A reference to this for fluency.
+     */
+    SegmentedReadBuffer& append(ImmutableMemoryView segment) {
+        if (segment.size() > 0) {
+            _segments.push_back(segment);
+            _limit += segment.size();
+        }
+
+        return *this;
+    }
+
+    /**
+     * Leave the limit unchanged and sets the position to zero.
+     * @return A reference to this for fluency.
+     */
+    SegmentedReadBuffer& rewind() noexcept {
+        _position = 0;
+        _segmentIndex = 0;
+        _segmentOffset = 0;
+
+        return *this;
+    }
+
+    /** Number of segments in the chain. */
+    size_type segmentCount() const noexcept { return _segments.size(); }
+
+    /** Total number of bytes in the chain that can be read from this buffer. */
+    size_type limit() const noexcept { return _limit; }
+
+    /**
+     * Get remaining number of bytes in the buffer (Up to the limit)
+     * @return Remaining number of bytes in the buffer.
+     */
+    size_type remaining() const noexcept { return limit() - position(); }
+
+    /**
+     * Check if there are bytes left in the buffer (Up to the limit)
+     * @return True if there are still some data before the limit is reached.
+     */
+    bool hasRemaining() const noexcept { return remaining() > 0; }
+
+    /**
+     * Get current position in the buffer.
+     * It can be stored to later return to it using @see position
+     * @return Current position in the buffer
+     */
+    size_type position() const noexcept { return _position; }
+
+    /**
+     * Set current position to the given one.
+     * @return Nothing if successfull or an error if the position is past the limit.
+     */
+    Result<void, Error> position(size_type newPosition);
+
+    /**
+     * Increment current position by the given amount.
+     * @param increment Amount to advance current position by.
+     * @return Nothing if successfull or an error if the move is past the limit.
+     */
+    Result<void, Error> advance(size_type increment);
+
+    /**
+     * Read a single byte from the buffer
+     * @return One byte read from the buffer
+     */
+    Result<byte, Error> get();
+
+    /**
+     * Read data form this buffer and store it into a given destantion.
+     * @param dest Buffer to store read data into.
+     * @return Nothing if successfull or an error.
+     */
+    Result<void, Error>
+    read(MemoryView& dest) {
+        return read(dest, dest.size());
+    }
+
+    Result<void, Error>
+    read(MemoryView& dest, size_type bytesToRead);
+
+    Result<void, Error>  read(char*      dest) { return read(dest, sizeof(char));    }
+    Result<void, Error>  read(int8*      dest) { return read(dest, sizeof(int8));    }
+    Result<void, Error>  read(uint8*     dest) { return read(dest, sizeof(uint8));   }
+    Result<void, Error>  read(int16*     dest) { return read(dest, sizeof(int16));   }
+    Result<void, Error>  read(uint16*    dest) { return read(dest, sizeof(uint16));  }
+    Result<void, Error>  read(int32*     dest) { return read(dest, sizeof(int32));   }
+    Result<void, Error>  read(uint32*    dest) { return read(dest, sizeof(uint32));  }
+    Result<void, Error>  read(int64*     dest) { return read(dest, sizeof(int64));   }
+    Result<void, Error>  read(uint64*    dest) { return read(dest, sizeof(uint64));  }
+    Result<void, Error>  read(float32*   dest) { return read(dest, sizeof(float32)); }
+    Result<void, Error>  read(float64*   dest) { return read(dest, sizeof(float64)); }
+
+    // Endianess aware read/write
+    Result<void, Error>  readLE(int8& value)  { return read(&value, sizeof(int8)); }
+    Result<void, Error>  readLE(uint8& value) { return read(&value, sizeof(uint8)); }
+    Result<void, Error>  readLE(int16& value) { return readLE(reinterpret_cast<uint16&>(value)); }
+    Result<void, Error>  readLE(uint16& value);
+    Result<void, Error>  readLE(int32& value) { return readLE(reinterpret_cast<uint32&>(value)); }
+    Result<void, Error>  readLE(uint32& value);
+    Result<void, Error>  readLE(int64& value) { return readLE(reinterpret_cast<uint64&>(value)); }
+    Result<void, Error>  readLE(uint64& value);
+
+    Result<void, Error>  readBE(int8& value)  { return read(&value, sizeof(int8)); }
+    Result<void, Error>  readBE(uint8& value) { return read(&value, sizeof(uint8)); }
+    Result<void, Error>  readBE(int16& value) { return readBE(reinterpret_cast<uint16&>(value)); }
+    Result<void, Error>  readBE(uint16& value);
+    Result<void, Error>  readBE(int32& value) { return readBE(reinterpret_cast<uint32&>(value)); }
+    Result<void, Error>  readBE(uint32& value);
+    Result<void, Error>  readBE(int64& value) { return readBE(reinterpret_cast<uint64&>(value)); }
+    Result<void, Error>  readBE(uint64& value);
+
+protected:
+
+    Result<void, Error>  read(void* dest, size_type count);
+
+private:
+
+    std::vector<ImmutableMemoryView>    _segments;
+
+    size_type           _position{};        //!< Stream position across the whole chain.
+    size_type           _limit{};           //!< Total number of bytes in the chain.
+
+    size_type           _segmentIndex{};    //!< Segment the position falls into.
+    size_type           _segmentOffset{};   //!< Offset of the position within that segment.
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_SEGMENTEDREADBUFFER_HPP
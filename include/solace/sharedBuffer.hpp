@@ -0,0 +1,147 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: SharedBuffer
+ *	@file		solace/sharedBuffer.hpp
+ *	@brief		Reference-counted immutable memory buffer
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_SHAREDBUFFER_HPP
+#define SOLACE_SHAREDBUFFER_HPP
+
+#include "solace/immutableMemoryView.hpp"
+
+#include <atomic>
+
+
+namespace Solace {
+
+/**
+ * An immutable memory buffer shared by reference count.
+ *
+ * Where MemoryBuffer has exactly one owner and ImmutableMemoryView has none,
+ * SharedBuffer sits in between: the bytes are owned jointly by every handle,
+ * and the last one to go frees them. The count lives in a header co-allocated
+ * in front of the bytes themselves - one allocation, one cache line walk away
+ * from the data - so handing a payload to N consumers costs N atomic
+ * increments, not N copies.
+ *
+ * The bytes are written once, by copyOf(), before any sharing happens; after
+ * that every handle sees them as const. That is what makes the fan-out safe
+ * with no further synchronization. slice() produces handles onto a window of
+ * the same bytes - a parsed-out message inside a batch keeps the whole batch
+ * alive rather than copying out.
+ *
+ * Handles are cheap values: copy them across queues and threads freely. The
+ * count is atomic; the handle itself, like every other value type here, is
+ * not - give each thread its own copy.
+ */
+class SharedBuffer {
+public:
+    using size_type = ImmutableMemoryView::size_type;
+
+    /** Allocate a new buffer holding a copy of the given bytes.
+     * This is the single copy the payload will ever need; every subsequent
+     * handle shares it.
+     */
+    static SharedBuffer copyOf(ImmutableMemoryView data);
+
+public:
+
+    ~SharedBuffer() { release(); }
+
+    /** Construct an empty buffer handle. No storage is allocated. */
+    SharedBuffer() noexcept = default;
+
+    SharedBuffer(SharedBuffer const& rhs) noexcept :
+        _header(rhs._header),
+        _view(rhs._view.dataAddress(), rhs._view.size())
+    {
+        if (_header) {
+            _header->refs.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    SharedBuffer(SharedBuffer&& rhs) noexcept :
+        _header(std::exchange(rhs._header, nullptr)),
+        _view(std::move(rhs._view))
+    {}
+
+    SharedBuffer& operator= (SharedBuffer const& rhs) noexcept {
+        SharedBuffer copy(rhs);
+
+        return swap(copy);
+    }
+
+    SharedBuffer& operator= (SharedBuffer&& rhs) noexcept {
+        return swap(rhs);
+    }
+
+    SharedBuffer& swap(SharedBuffer& rhs) noexcept {
+        std::swap(_header, rhs._header);
+        _view.swap(rhs._view);
+
+        return *this;
+    }
+
+    /** View of the bytes this handle covers. Valid for the handle's lifetime. */
+    ImmutableMemoryView const& view() const noexcept { return _view; }
+
+    size_type size() const noexcept { return _view.size(); }
+    bool empty() const noexcept { return _view.empty(); }
+
+    explicit operator bool() const noexcept { return (_header != nullptr); }
+
+    /**
+     * A handle onto a window of the same bytes - no copy is made and the
+     * whole underlying buffer stays alive as long as the slice does.
+     * @see ImmutableMemoryView::slice() for the range conventions.
+     */
+    SharedBuffer slice(size_type from, size_type to) const {
+        SharedBuffer result(*this);
+        result._view = _view.slice(from, to);
+
+        return result;
+    }
+
+    /** Number of handles currently sharing the bytes. Racy by nature -
+     * useful for tests and diagnostics, not for lifetime decisions. */
+    uint32 shareCount() const noexcept {
+        return _header ? _header->refs.load(std::memory_order_relaxed) : 0;
+    }
+
+private:
+
+    /** The co-allocated prefix of every buffer: the count, then the bytes. */
+    struct Header {
+        std::atomic<uint32> refs;
+    };
+
+    SharedBuffer(Header* header, ImmutableMemoryView view) noexcept :
+        _header(header),
+        _view(std::move(view))
+    {}
+
+    void release() noexcept;
+
+private:
+
+    Header*             _header {nullptr};
+    ImmutableMemoryView _view;
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_SHAREDBUFFER_HPP
@@ -0,0 +1,375 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Structure-of-arrays container
+ *	@file		solace/soaArray.hpp
+ *	@brief		Fixed size collection storing each field in its own column
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_SOAARRAY_HPP
+#define SOLACE_SOAARRAY_HPP
+
+#include "solace/assert.hpp"
+#include "solace/arrayView.hpp"
+#include "solace/memoryManager.hpp"
+
+#include <tuple>
+#include <utility>      // std::index_sequence
+
+
+namespace Solace {
+
+namespace details {
+
+/** Disposer for buffers that SoaArray allocates from the global heap. */
+class SoaHeapDisposer : public MemoryViewDisposer {
+public:
+    void dispose(ImmutableMemoryView* view) const override {
+        delete[] const_cast<byte*>(view->dataAddress());
+    }
+};
+
+inline SoaHeapDisposer* soaHeapDisposer() noexcept {
+    static SoaHeapDisposer disposer;
+
+    return &disposer;
+}
+
+constexpr size_t alignUp(size_t offset, size_t alignment) noexcept {
+    return (offset + alignment - 1) & ~(alignment - 1);
+}
+
+/** Check that every type in a pack is trivially copyable. */
+template<typename... Ts> struct allTriviallyCopyable;
+template<> struct allTriviallyCopyable<> : std::true_type {};
+template<typename T, typename... Ts>
+struct allTriviallyCopyable<T, Ts...> :
+        std::integral_constant<bool,
+                               std::is_trivially_copyable<T>::value && allTriviallyCopyable<Ts...>::value> {};
+
+}  // namespace details
+
+
+/** Fixed-size collection of records stored column-wise aka structure-of-arrays.
+ * Where Array<Record> interleaves all fields of a record in memory, SoaArray
+ * keeps each field in its own contiguous column, so a scan touching a single
+ * field walks sequential memory and wastes no cache line on the fields it does
+ * not read. Whole-record access is still available through operator[] and
+ * iteration, which zip the columns into a tuple of references.
+ *
+ * Field types must be trivially copyable as columns live in raw memory and
+ * no per-element constructors or destructors are run.
+ */
+template<typename... Fields>
+class SoaArray {
+
+    static_assert(sizeof...(Fields) > 0, "SoaArray requires at least one field");
+    static_assert(details::allTriviallyCopyable<Fields...>::value,
+                  "SoaArray fields must be trivially copyable");
+
+public:
+    using size_type = uint32;
+
+    /** A record materialized as a value. */
+    using Record = std::tuple<Fields...>;
+
+    /** A record zipped out of the columns: a tuple of references into them. */
+    using RecordRef = std::tuple<Fields&...>;
+    using RecordConstRef = std::tuple<Fields const&...>;
+
+    template<size_t I>
+    using FieldType = typename std::tuple_element<I, Record>::type;
+
+    static constexpr size_t FieldCount = sizeof...(Fields);
+
+public:
+
+    /** Iterator zipping the columns into per-record reference tuples. */
+    class Iterator {
+    public:
+        Iterator(SoaArray& array, size_type index) noexcept :
+            _array(&array),
+            _index(index)
+        {}
+
+        RecordRef operator* () { return (*_array)[_index]; }
+
+        Iterator& operator++ () noexcept {
+            ++_index;
+
+            return *this;
+        }
+
+        bool operator== (const Iterator& other) const noexcept { return (_index == other._index); }
+        bool operator!= (const Iterator& other) const noexcept { return (_index != other._index); }
+
+    private:
+        SoaArray*   _array;
+        size_type   _index;
+    };
+
+
+    class const_iterator {
+    public:
+        const_iterator(const SoaArray& array, size_type index) noexcept :
+            _array(&array),
+            _index(index)
+        {}
+
+        RecordConstRef operator* () const { return (*_array)[_index]; }
+
+        const_iterator& operator++ () noexcept {
+            ++_index;
+
+            return *this;
+        }
+
+        bool operator== (const const_iterator& other) const noexcept { return (_index == other._index); }
+        bool operator!= (const const_iterator& other) const noexcept { return (_index != other._index); }
+
+    private:
+        const SoaArray* _array;
+        size_type       _index;
+    };
+
+public:
+
+    ~SoaArray() noexcept = default;
+
+    /** Construct an empty collection */
+    SoaArray() noexcept = default;
+
+    SoaArray(const SoaArray&) = delete;
+    SoaArray& operator= (const SoaArray&) = delete;
+
+    /** Construct a new collection by moving content of a given one */
+    SoaArray(SoaArray&& other) noexcept :
+        _buffer(std::move(other._buffer)),
+        _count(std::exchange(other._count, 0))
+    {
+        for (size_t i = 0; i < FieldCount; ++i) {
+            _columns[i] = std::exchange(other._columns[i], nullptr);
+        }
+    }
+
+    SoaArray& operator= (SoaArray&& rhs) noexcept {
+        return swap(rhs);
+    }
+
+    /** Construct a collection of a given fixed size backed by the global heap */
+    explicit SoaArray(size_type count) :
+        SoaArray(count, MemoryBuffer(wrapMemory(new byte[requiredStorage(count)], requiredStorage(count)),
+                                     details::soaHeapDisposer()))
+    {}
+
+    /** Construct a collection of a given size with storage drawn from a memory manager.
+     * @param count Number of records to hold.
+     * @param manager A memory manager to allocate storage through. Must outlive this collection.
+     */
+    SoaArray(size_type count, MemoryManager& manager) :
+        SoaArray(count, manager.create(requiredStorage(count)))
+    {}
+
+    /** Construct a collection of a given size with storage drawn from an arena.
+     * @param count Number of records to hold.
+     * @param arena An arena to allocate storage from. Must outlive this collection.
+     */
+    SoaArray(size_type count, MemoryArena& arena) :
+        SoaArray(count, arena.create(requiredStorage(count)))
+    {}
+
+    /** Construct a collection of a given size over caller-provided storage.
+     * @param count Number of records to hold.
+     * @param buffer A buffer of at least requiredStorage(count) bytes.
+     */
+    SoaArray(size_type count, MemoryBuffer buffer) :
+        _buffer(std::move(buffer)),
+        _count(count)
+    {
+        assertIndexInRange(static_cast<MemoryView::size_type>(requiredStorage(count)),
+                           static_cast<MemoryView::size_type>(0),
+                           _buffer.size() + 1,
+                           "SoaArray(buffer)");
+        _buffer.view().fill(0);
+
+        layoutColumns();
+    }
+
+public:
+
+    SoaArray& swap(SoaArray& rhs) noexcept {
+        using std::swap;
+        swap(_buffer, rhs._buffer);
+        swap(_count, rhs._count);
+        swap(_columns, rhs._columns);
+
+        return (*this);
+    }
+
+    /**
+     * Number of bytes of storage needed to hold the given number of records.
+     * @param count Number of records.
+     * @return Storage size in bytes, including inter-column alignment padding.
+     */
+    static size_type requiredStorage(size_type count) noexcept {
+        const size_t sizes[] = {sizeof(Fields)...};
+        const size_t aligns[] = {alignof(Fields)...};
+
+        size_t offset = 0;
+        for (size_t i = 0; i < FieldCount; ++i) {
+            offset = details::alignUp(offset, aligns[i]);
+            offset += sizes[i] * count;
+        }
+
+        return offset;
+    }
+
+    /**
+     * Check if this collection is empty.
+     * @return True is this is an empty collection.
+     */
+    bool empty() const noexcept {
+        return (_count == 0);
+    }
+
+    /**
+     * Get the number of records in this collection
+     * @return The size of this finite collection
+     */
+    size_type size() const noexcept {
+        return _count;
+    }
+
+    /**
+     * Get a view over a single column of this collection.
+     * Elements of one column are contiguous in memory, so scans over it are
+     * sequential and candidates for vectorization.
+     * @return A view over the I-th field of every record.
+     */
+    template<size_t I>
+    ArrayView<FieldType<I>> column() noexcept {
+        return ArrayView<FieldType<I>>(columnData<I>(), _count);
+    }
+
+    template<size_t I>
+    ArrayView<const FieldType<I>> column() const noexcept {
+        return ArrayView<const FieldType<I>>(wrapMemory(_columns[I], _count * sizeof(FieldType<I>)));
+    }
+
+    /** Access a whole record as a tuple of references into the columns. */
+    RecordRef operator[] (size_type index) {
+        index = assertIndexInRange(index, 0, size(), "SoaArray[]");
+
+        return zipRecord(index, std::index_sequence_for<Fields...>());
+    }
+
+    RecordConstRef operator[] (size_type index) const {
+        index = assertIndexInRange(index, 0, size(), "SoaArray[] const");
+
+        return zipRecord(index, std::index_sequence_for<Fields...>());
+    }
+
+    Iterator begin() noexcept { return Iterator(*this, 0); }
+    Iterator end() noexcept { return Iterator(*this, _count); }
+
+    const_iterator begin() const noexcept { return const_iterator(*this, 0); }
+    const_iterator end() const noexcept { return const_iterator(*this, _count); }
+
+    /*
+     *--------------------------------------------------------------------------
+     * Functional methods that operates on the collection without changing it.
+     *--------------------------------------------------------------------------
+     */
+
+    /** Apply a function to every record, invoked as f(fields&...). */
+    template<typename F>
+    const SoaArray& forEach(F&& f) {
+        for (size_type i = 0; i < _count; ++i) {
+            applyRecord(std::forward<F>(f), i, std::index_sequence_for<Fields...>());
+        }
+
+        return *this;
+    }
+
+    template<typename F>
+    const SoaArray& forEach(F&& f) const {
+        for (size_type i = 0; i < _count; ++i) {
+            applyRecord(std::forward<F>(f), i, std::index_sequence_for<Fields...>());
+        }
+
+        return *this;
+    }
+
+protected:
+
+    template<size_t I>
+    FieldType<I>* columnData() const noexcept {
+        return reinterpret_cast<FieldType<I>*>(_columns[I]);
+    }
+
+    template<size_t... Is>
+    RecordRef zipRecord(size_type index, std::index_sequence<Is...>) noexcept {
+        return RecordRef(columnData<Is>()[index]...);
+    }
+
+    template<size_t... Is>
+    RecordConstRef zipRecord(size_type index, std::index_sequence<Is...>) const noexcept {
+        return RecordConstRef(columnData<Is>()[index]...);
+    }
+
+    template<typename F, size_t... Is>
+    void applyRecord(F&& f, size_type index, std::index_sequence<Is...>) {
+        f(columnData<Is>()[index]...);
+    }
+
+    template<typename F, size_t... Is>
+    void applyRecord(F&& f, size_type index, std::index_sequence<Is...>) const {
+        f(static_cast<const FieldType<Is>*>(columnData<Is>())[index]...);
+    }
+
+    /** Carve the backing buffer into per-field columns. */
+    void layoutColumns() noexcept {
+        const size_t sizes[] = {sizeof(Fields)...};
+        const size_t aligns[] = {alignof(Fields)...};
+
+        auto* base = _buffer.view().dataAddress();
+
+        size_t offset = 0;
+        for (size_t i = 0; i < FieldCount; ++i) {
+            offset = details::alignUp(offset, aligns[i]);
+            _columns[i] = base + offset;
+            offset += sizes[i] * _count;
+        }
+    }
+
+private:
+
+    /// Memory where all the columns are stored.
+    MemoryBuffer    _buffer;
+    size_type       _count {0};
+
+    /// Start of each field's column inside the buffer.
+    byte*           _columns[FieldCount] {};
+};
+
+
+template<typename... Fields>
+void swap(SoaArray<Fields...>& lhs, SoaArray<Fields...>& rhs) noexcept {
+    lhs.swap(rhs);
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_SOAARRAY_HPP
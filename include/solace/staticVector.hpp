@@ -0,0 +1,312 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Fixed capacity vector with inline storage
+ *	@file		solace/staticVector.hpp
+ *	@brief		A growable collection of up to N elements that never allocates
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_STATICVECTOR_HPP
+#define SOLACE_STATICVECTOR_HPP
+
+#include "solace/types.hpp"
+#include "solace/assert.hpp"
+#include "solace/arrayView.hpp"
+
+#include <initializer_list>
+#include <type_traits>  // std::aligned_storage
+#include <utility>      // std::move, std::forward
+
+
+namespace Solace {
+
+/** A growable collection of up to N elements stored inline aka StaticVector.
+ * Complements Array (heap allocated, fixed size) and ArrayView (non-owning):
+ * the elements live inside the object itself, so small scratch collections on
+ * hot paths never touch the allocator. The capacity is part of the type and
+ * exceeding it is a usage error, not a reallocation.
+ *
+ * Elements are constructed on insertion and destroyed on removal, so
+ * non-trivial types are fine.
+ */
+template<typename T, uint32 N>
+class StaticVector {
+public:
+    using value_type = T;
+    using size_type = uint32;
+
+    using Iterator = T *;
+    using const_iterator = const T *;
+
+    using reference = T &;
+    using const_reference = const T &;
+
+    using pointer_type = T *;
+    using const_pointer = const T *;
+
+public:
+
+    ~StaticVector() {
+        clear();
+    }
+
+    /** Construct an empty collection */
+    StaticVector() noexcept = default;
+
+    /** Construct a new collection by moving elements out of a given one */
+    StaticVector(StaticVector&& other) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        for (auto& x : other) {
+            emplaceBackUnchecked(std::move(x));
+        }
+
+        other.clear();
+    }
+
+    /** Construct a new collection to be a copy of a given */
+    StaticVector(const StaticVector& other) {
+        for (const auto& x : other) {
+            emplaceBackUnchecked(x);
+        }
+    }
+
+    /** Construct a collection from an initialized list */
+    StaticVector(const std::initializer_list<T>& list) {
+        assertIndexInRange(static_cast<size_type>(list.size()), 0, N + 1, "StaticVector(initializer_list)");
+
+        for (const auto& x : list) {
+            emplaceBackUnchecked(x);
+        }
+    }
+
+public:
+
+    StaticVector& swap(StaticVector& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        using std::swap;
+
+        StaticVector tmp(std::move(rhs));
+        rhs = std::move(*this);
+        *this = std::move(tmp);
+
+        return (*this);
+    }
+
+    StaticVector& operator= (const StaticVector& rhs) {
+        if (&rhs != this) {
+            clear();
+            for (const auto& x : rhs) {
+                emplaceBackUnchecked(x);
+            }
+        }
+
+        return *this;
+    }
+
+    StaticVector& operator= (StaticVector&& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) {
+        if (&rhs != this) {
+            clear();
+            for (auto& x : rhs) {
+                emplaceBackUnchecked(std::move(x));
+            }
+            rhs.clear();
+        }
+
+        return *this;
+    }
+
+    bool equals(const StaticVector& other) const noexcept {
+        return view().equals(other.view());
+    }
+
+    bool operator== (const StaticVector& rhv) const noexcept {
+        return equals(rhv);
+    }
+
+    bool operator!= (const StaticVector& rhv) const noexcept {
+        return !equals(rhv);
+    }
+
+    /**
+     * Check if this collection is empty.
+     * @return True is this is an empty collection.
+     */
+    bool empty() const noexcept {
+        return (_count == 0);
+    }
+
+    /**
+     * Check if this collection is filled to capacity.
+     * @return True if no more elements can be added.
+     */
+    bool full() const noexcept {
+        return (_count == N);
+    }
+
+    /**
+     * Get the number of elements in this collection
+     * @return number of elements in this collection.
+     */
+    size_type size() const noexcept {
+        return _count;
+    }
+
+    /**
+     * Get the maximum number of elements this collection can hold.
+     * @return The fixed capacity baked into the type.
+     */
+    static constexpr size_type capacity() noexcept {
+        return N;
+    }
+
+    /**
+     * Add an element to the end of the collection.
+     * @param value A value to copy into the collection.
+     * @return A reference to the newly added element.
+     * @throws IndexOutOfRangeException if the collection is already full.
+     */
+    reference pushBack(const_reference value) {
+        return emplaceBack(value);
+    }
+
+    reference pushBack(T&& value) {
+        return emplaceBack(std::move(value));
+    }
+
+    /**
+     * Construct an element in place at the end of the collection.
+     * @param args Arguments forwarded to the element's constructor.
+     * @return A reference to the newly constructed element.
+     * @throws IndexOutOfRangeException if the collection is already full.
+     */
+    template<typename... Args>
+    reference emplaceBack(Args&&... args) {
+        assertIndexInRange(_count, 0, N, "StaticVector::emplaceBack()");
+
+        return emplaceBackUnchecked(std::forward<Args>(args)...);
+    }
+
+    /**
+     * Remove the last element of the collection.
+     * @throws IndexOutOfRangeException if the collection is empty.
+     */
+    void popBack() {
+        assertIndexInRange(static_cast<size_type>(0), 0, _count, "StaticVector::popBack()");
+
+        _count -= 1;
+        data()[_count].~T();
+    }
+
+    /** Destroy all elements leaving the collection empty. */
+    void clear() noexcept {
+        while (_count > 0) {
+            _count -= 1;
+            data()[_count].~T();
+        }
+    }
+
+    const_reference operator[] (size_type index) const {
+        index = assertIndexInRange(index, 0, size(), "StaticVector[] const");
+
+        return data()[index];
+    }
+
+    reference operator[] (size_type index) {
+        index = assertIndexInRange(index, 0, size(), "StaticVector[]");
+
+        return data()[index];
+    }
+
+    Iterator begin() noexcept { return data(); }
+    Iterator end() noexcept { return data() + _count; }
+    reference front() noexcept { return *begin(); }
+    reference back() noexcept { return *(begin() + _count - 1); }
+
+    const_iterator begin() const noexcept { return data(); }
+    const_iterator end() const noexcept { return (begin() + _count); }
+    const_reference front() const noexcept { return *begin(); }
+    const_reference back() const noexcept { return *(begin() + _count - 1); }
+
+    pointer_type data() noexcept {
+        return reinterpret_cast<T*>(_storage);
+    }
+
+    const_pointer data() const noexcept {
+        return reinterpret_cast<const T*>(_storage);
+    }
+
+    /** Get a non-owning view over the elements currently in the collection. */
+    ArrayView<T> view() noexcept {
+        return ArrayView<T>(data(), _count);
+    }
+
+    ArrayView<const T> view() const noexcept {
+        return ArrayView<const T>(wrapMemory(const_cast<StaticVector*>(this)->_storage,
+                                             _count * sizeof(T)));
+    }
+
+    bool contains(const_reference value) const noexcept {
+        return view().contains(value);
+    }
+
+    /*
+     *--------------------------------------------------------------------------
+     * Functional methods that operates on the collection without changing it.
+     *--------------------------------------------------------------------------
+     */
+
+    template<typename F>
+    const StaticVector& forEach(F&& f) {
+        for (auto& x : *this) {
+            f(x);
+        }
+
+        return *this;
+    }
+
+    template<typename F>
+    const StaticVector& forEach(F&& f) const {
+        for (const auto& x : *this) {
+            f(x);
+        }
+
+        return *this;
+    }
+
+protected:
+
+    template<typename... Args>
+    reference emplaceBackUnchecked(Args&&... args) {
+        auto* element = new (data() + _count) T(std::forward<Args>(args)...);
+        _count += 1;
+
+        return *element;
+    }
+
+private:
+
+    /// Uninitialized inline storage the elements are constructed into.
+    typename std::aligned_storage<sizeof(T), alignof(T)>::type _storage[N];
+
+    size_type _count {0};
+};
+
+
+template<typename T, uint32 N>
+void swap(StaticVector<T, N>& lhs, StaticVector<T, N>& rhs) noexcept(std::is_nothrow_move_constructible<T>::value) {
+    lhs.swap(rhs);
+}
+
+}  // End of namespace Solace
+#endif  // SOLACE_STATICVECTOR_HPP
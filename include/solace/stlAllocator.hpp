@@ -0,0 +1,174 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: STL allocator adapter
+ *	@file		solace/stlAllocator.hpp
+ *	@brief		STL-compatible allocator drawing from a MemoryManager or arena
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_STLALLOCATOR_HPP
+#define SOLACE_STLALLOCATOR_HPP
+
+#include "solace/memoryManager.hpp"
+
+#include <memory>   // std::shared_ptr
+#include <vector>
+
+
+namespace Solace {
+
+/**
+ * An STL-compatible allocator that draws its memory from a MemoryManager or
+ * a MemoryArena instead of the global heap.
+ *
+ * This is the bridge between standard containers and this library's explicit
+ * memory management: a container bound to a manager-backed allocator has its
+ * storage accounted against the manager's capacity, and one bound to an arena
+ * allocates by bumping the arena's pointer with deallocation a no-op until the
+ * arena is reset. A default-constructed allocator falls back to the global
+ * heap, preserving the behaviour of containers that never asked for anything
+ * else.
+ *
+ * Copies of an allocator share the source it was bound to, as containers
+ * expect: memory allocated through one copy may be deallocated through
+ * another. The bound manager or arena must outlive every container using it.
+ */
+template<typename T>
+class StlAllocator {
+public:
+
+    using value_type = T;
+
+public:
+
+    /** Construct an allocator backed by the global heap. */
+    StlAllocator() noexcept = default;
+
+    /** Construct an allocator drawing from the given memory manager.
+     * @param manager A manager to allocate through. Must outlive this allocator.
+     */
+    StlAllocator(MemoryManager& manager) :
+        _manager(&manager),
+        _held(std::make_shared<std::vector<MemoryBuffer>>())
+    {}
+
+    /** Construct an allocator drawing from the given arena.
+     * @param arena An arena to allocate from. Must outlive this allocator.
+     */
+    StlAllocator(MemoryArena& arena) noexcept :
+        _arena(&arena)
+    {}
+
+    template<typename U>
+    StlAllocator(StlAllocator<U> const& other) noexcept :
+        _manager(other._manager),
+        _arena(other._arena),
+        _held(other._held),
+        _defaultInit(other._defaultInit)
+    {}
+
+    /**
+     * Opt this allocator into default-initializing construction: elements
+     * constructed with no arguments are default-initialized instead of
+     * value-initialized, which for trivial types means the memory is left
+     * untouched. The container's element count is unaffected - only the
+     * zeroing pass is skipped.
+     * @return Reference to this for fluency.
+     */
+    StlAllocator& deferInitialization() noexcept {
+        _defaultInit = true;
+
+        return *this;
+    }
+
+    /** Zero-argument construction honouring deferInitialization(); any
+     * construction with arguments takes the standard placement-new path. */
+    template<typename U>
+    void construct(U* p) {
+        if (_defaultInit) {
+            ::new (static_cast<void*>(p)) U;
+        } else {
+            ::new (static_cast<void*>(p)) U();
+        }
+    }
+
+    T* allocate(std::size_t n) {
+        const auto bytes = n * sizeof(T);
+
+        if (_arena != nullptr) {
+            // Arena buffers need no disposal - the temporary's disposer is a no-op.
+            return reinterpret_cast<T*>(_arena->create(bytes).view().dataAddress());
+        }
+
+        if (_manager != nullptr) {
+            auto buffer = _manager->create(bytes);
+            auto* addr = buffer.view().dataAddress();
+            _held->emplace_back(std::move(buffer));
+
+            return reinterpret_cast<T*>(addr);
+        }
+
+        return static_cast<T*>(::operator new(bytes));
+    }
+
+    void deallocate(T* p, std::size_t /*n*/) noexcept {
+        if (_arena != nullptr) {
+            return;  // Reclaimed wholesale when the arena is reset.
+        }
+
+        if (_manager != nullptr) {
+            auto* addr = reinterpret_cast<byte*>(p);
+            for (auto i = _held->begin(); i != _held->end(); ++i) {
+                if (i->view().dataAddress() == addr) {
+                    _held->erase(i);  // The buffer's disposer returns the memory to the manager.
+
+                    return;
+                }
+            }
+
+            return;
+        }
+
+        ::operator delete(p);
+    }
+
+    template<typename U>
+    bool operator== (StlAllocator<U> const& rhs) const noexcept {
+        return (_manager == rhs._manager) && (_arena == rhs._arena);
+    }
+
+    template<typename U>
+    bool operator!= (StlAllocator<U> const& rhs) const noexcept {
+        return !(*this == rhs);
+    }
+
+private:
+
+    template<typename>
+    friend class StlAllocator;
+
+    MemoryManager*  _manager {nullptr};
+    MemoryArena*    _arena {nullptr};
+
+    /** Buffers handed out on behalf of a manager, kept so that their
+     * disposers run on deallocation. Shared between allocator copies. */
+    std::shared_ptr<std::vector<MemoryBuffer>>  _held;
+
+    bool            _defaultInit {false};   //!< Skip value-initialization of elements.
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_STLALLOCATOR_HPP
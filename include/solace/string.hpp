@@ -28,6 +28,8 @@
 
 #include "solace/stringView.hpp"
 #include "solace/array.hpp"
+#include "solace/result.hpp"
+#include "solace/error.hpp"
 
 
 #include <string>   // std::string
@@ -36,6 +38,10 @@
 
 namespace Solace {
 
+class MemoryBuffer;
+class MemoryViewDisposer;
+class WriteBuffer;
+
 /** Immutable String object
  * Solace::String is a proper immutable unicode string that brings the comfort yet
  * it can be easily converted to and from std::string and/or C-strings
@@ -71,8 +77,8 @@ public:
     String(StringView view);
 
     //!< Construct the string from std::string - STD compatibility method
-    explicit String(std::string const& buffer) : _str(buffer) {}
-    String(std::string&& buffer) : _str(std::move(buffer)) {}
+    explicit String(std::string const& buffer) : String(buffer.data(), static_cast<size_type>(buffer.size())) {}
+    String(std::string&& buffer) : String(buffer.data(), static_cast<size_type>(buffer.size())) {}
 
 public:  // Additional to base object operations
 
@@ -89,7 +95,7 @@ public:  // Additional to base object operations
     }
 
     String& operator= (std::string rhs) noexcept {
-        _str.swap(rhs);
+        String(std::move(rhs)).swap(*this);
 
         return *this;
     }
@@ -199,6 +205,34 @@ public:  // Basic collection operations:
      */
     String concat(const char* str) const;
 
+    /**
+     * Concatenate a sequence of string fragments.
+     *
+     * The fragments are measured first and the result is built in a single
+     * sized-once allocation, where a chain of concat() calls allocates and
+     * copies at every link. Usually reached through the variadic concat()
+     * free function. @see Solace::concat
+     *
+     * @param fragments Fragments to join, in order.
+     * @param count Number of fragments.
+     * @return A string holding every fragment, back to back.
+     */
+    static String fuse(StringView const* fragments, size_type count);
+
+    /**
+     * Take ownership of a buffer holding already-built string content.
+     *
+     * When the buffer owns its memory and has room for a null terminator
+     * past textSize, the storage transfers into the string as-is: O(1),
+     * no copy. Content short enough for in-place storage, a non-owning
+     * buffer or one filled to the brim fall back to a copy.
+     *
+     * @param buffer Buffer holding the string bytes; consumed either way.
+     * @param textSize Number of content bytes at the start of the buffer.
+     * @return A string owning the content.
+     */
+    static String adopt(MemoryBuffer&& buffer, size_type textSize);
+
 	/**
 	 * Returns a new string with all occurrences of 'what'
 	 * replaced with 'with'.
@@ -238,6 +272,56 @@ public:  // Basic collection operations:
      */
     String substring(size_type from) const;
 
+    /**
+     * A substring as a view into this string - no copy, no allocation.
+     * This is the path to prefer when the substring is only read; the
+     * copying substring() stays for callers that need the text to outlive
+     * the source. The view is valid for as long as this string is alive
+     * and unmodified.
+     *
+     *  @param from [in] Index of first character of the substring.
+     *  @param len [in] Length of the substring.
+     *  @return View of the substring, tied to this string's lifetime.
+     */
+    StringView substringView(size_type from, size_type len) const {
+        return view().substring(from, len);
+    }
+
+    /**
+     * A view of the tail of this string starting at 'from' - no copy.
+     * @see substringView(size_type, size_type) for the lifetime rules.
+     *
+     *  @param from [in] Index of first character of the substring.
+     *  @return View of the substring, tied to this string's lifetime.
+     */
+    StringView substringView(size_type from) const {
+        return view().substring(from);
+    }
+
+    /**
+     * Split this string by a delimiter into views of its pieces - the
+     * allocation-free counterpart of split(): only the array of views is
+     * allocated, never the text. The views follow the lifetime rules of
+     * substringView().
+     *
+     * @param delim A delimiter to split the string by.
+     * @return A list of views of the pieces.
+     */
+    Array<StringView> splitView(StringView delim) const {
+        return view().split(delim);
+    }
+
+    /**
+     * Split this string by a delimiter character into views of its pieces.
+     * @see splitView(StringView)
+     *
+     * @param delim A delimiter to split the string by.
+     * @return A list of views of the pieces.
+     */
+    Array<StringView> splitView(char delim) const {
+        return view().split(delim);
+    }
+
 	/**
 	 * Returns a copy of the string,
 	 * with leading and trailing whitespace omitted.
@@ -297,6 +381,15 @@ public:  // Basic collection operations:
 	 */
     uint64 hashCode() const;
 
+	/** Returns a seeded hash code for this string.
+	 * Matches StringView::hashCode(seed) over the same characters, so String
+	 * keys and StringView probes agree in seeded hash tables.
+	 *
+	 * @param seed Seed the hash is keyed by, normally hashSeed().
+	 * @return A hash code value for this string under the given seed.
+	 */
+    uint64 hashCode(uint64 seed) const;
+
 	/**
 	 * Identity operation
 	 */
@@ -338,7 +431,7 @@ public:  // Basic collection operations:
 
     // FIXME: Must be conditional to std support mode only
     std::string to_str() const {
-        return _str;
+        return std::string{_storage.data(), _storage.size()};
     }
 
 public:
@@ -364,6 +457,32 @@ public:
      */
     static String join(StringView by, const Array<String>& list);
 
+    /**
+     * Join a sequence of string views with the given separator.
+     *
+     * Unlike the String overloads the fragments need not be materialized
+     * strings - the total length is computed up front and the result is
+     * built in a single allocation and a single copy pass.
+     *
+     * @param by - A separator placed between the fragments
+     * @param list - The fragments to join, in order
+     *
+     * @return The resulting string
+     */
+    static String join(StringView by, ArrayView<StringView> list);
+
+    /**
+     * Join a sequence of string views straight into a caller's buffer.
+     * Nothing is written unless the whole joined string fits.
+     *
+     * @param dest - A buffer to write the joined string into
+     * @param by - A separator placed between the fragments
+     * @param list - The fragments to join, in order
+     *
+     * @return Nothing on success, an overflow error when dest is too small
+     */
+    static Result<void, Error> join(WriteBuffer& dest, StringView by, ArrayView<StringView> list);
+
     /**
      * Return String representation of value.
      * @param val Value to convert into the string
@@ -458,11 +577,108 @@ public:
 
 private:
 
-    // FIXME(abbyssoul): Come up with a better implementation based on MemoryView
-    std::string _str;
+    /** Small-string-optimised storage for the string bytes.
+     *
+     * Strings of up to kInlineCapacity bytes are stored in-place and never touch the heap.
+     * Longer strings spill into a heap allocated buffer.
+     * The buffer is always null-terminated so that c_str() is a trivial accessor.
+     */
+    class Storage {
+    public:
+        /// Longest string, in bytes, that is stored without heap allocation.
+        static constexpr size_type InlineCapacity = 23;
+
+        ~Storage();
+
+        constexpr Storage() noexcept : _buffer{}, _size{0}
+        {}
+
+        Storage(char const* data, size_type dataSize);
+
+        /** Take over the buffer holding the string bytes, avoiding a copy
+         * when the buffer owns its memory and has room for the terminator. */
+        Storage(MemoryBuffer&& buffer, size_type textSize);
+
+        /** Build the bytes of several fragments back to back, sized once. */
+        Storage(StringView const* fragments, size_type count);
+
+        /** As above, with a separator between consecutive fragments. */
+        Storage(StringView by, StringView const* fragments, size_type count);
+
+        Storage(Storage const& rhs) : Storage(rhs.data(), rhs.size())
+        {}
+
+        Storage(Storage&& rhs) noexcept;
+
+        Storage& swap(Storage& rhs) noexcept;
+
+        constexpr size_type size() const noexcept { return _size; }
+
+        constexpr bool empty() const noexcept { return (_size == 0); }
+
+        char const* data() const noexcept {
+            return isInlined()
+                    ? _buffer.inplace
+                    : _buffer.heap;
+        }
+
+    private:
+
+        constexpr bool isInlined() const noexcept { return (_size <= InlineCapacity); }
+
+        /** Spilled storage taken over from a MemoryBuffer, disposer and all. */
+        struct AdoptedBuffer {
+            char*                       data;
+            MemoryViewDisposer const*   disposer;
+            uint64                      capacity;
+        };
+
+        union Buffer {
+            char            inplace[InlineCapacity + 1];
+            char*           heap;
+            AdoptedBuffer   adopted;
+        }           _buffer;
+
+        size_type   _size;
+        bool        _adopted {false};   //!< Spilled storage is adopted, not new[]-ed.
+    };
+
+
+    String(Storage&& storage) noexcept : _storage(std::move(storage))
+    {}
+
+private:
+
+    Storage _storage;
 };
 
 
+namespace details {
+
+/** Normalize a concat() fragment to a view of its bytes. */
+inline StringView asFragment(StringView view) noexcept      { return view; }
+inline StringView asFragment(String const& str) noexcept    { return str.view(); }
+inline StringView asFragment(const char* str) noexcept      { return StringView{str}; }
+
+}  // namespace details
+
+
+/**
+ * Concatenate any number of string fragments - String, StringView or
+ * c-style strings - in one go.
+ *
+ * The whole chain is sized once and each byte is copied once, so assembling
+ * a message from 8 parts costs a single allocation - a String::concat chain
+ * of the same shape allocates and copies at every link.
+ */
+template <typename... Fragments>
+String concat(Fragments const&... fragments) {
+    const StringView views[] = { details::asFragment(fragments)... };
+
+    return String::fuse(views, sizeof...(Fragments));
+}
+
+
 inline
 bool operator< (String const& lhs, String const& rhs) {
 	return lhs.compareTo(rhs) < 0;
@@ -0,0 +1,126 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Interned string atom
+ *	@file		solace/stringAtom.hpp
+ *	@brief		Process-wide interned string identifier
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_STRINGATOM_HPP
+#define SOLACE_STRINGATOM_HPP
+
+#include "solace/string.hpp"
+#include "solace/stringView.hpp"
+
+
+namespace Solace {
+
+/** Interned string identifier.
+ *
+ * A StringAtom is a handle into a process-wide intern table of unique strings.
+ * Two atoms interned from equal strings always compare equal by id, so equality
+ * is a single integer compare - no byte scan is involved. This is designed for
+ * keys compared far more often than they are created: channel names, metric
+ * names, config keys and such.
+ *
+ * Interned strings are never evicted for the lifetime of the process, so atoms
+ * remain valid - and their view() stable - once created.
+ */
+class StringAtom {
+public:
+
+    using id_type = uint32;
+
+public:
+
+    ~StringAtom() = default;
+
+    //!< Default constructor produces the atom of the empty string.
+    constexpr StringAtom() noexcept = default;
+
+    constexpr StringAtom(StringAtom const& other) noexcept = default;
+
+    StringAtom& operator= (StringAtom const& rhs) noexcept = default;
+
+    /** Intern the given string and return its atom.
+     * The probe is keyed by the view's bytes and hashCode() - no String object
+     * is constructed unless the string is seen for the first time.
+     *
+     * @param view The string to intern.
+     * @return An atom such that atoms of equal strings are equal.
+     */
+    static StringAtom intern(StringView view);
+
+    /** Intern the given string and return its atom.
+     * @see StringAtom::intern(StringView)
+     */
+    static StringAtom intern(String const& str) {
+        return intern(str.view());
+    }
+
+    /** Number of unique strings interned so far, process wide. */
+    static id_type internedCount() noexcept;
+
+    //!< True if atoms refer to the same interned string.
+    constexpr bool equals(StringAtom other) const noexcept {
+        return (_id == other._id);
+    }
+
+    //!< The interned string id. Stable for the lifetime of the process.
+    constexpr id_type id() const noexcept {
+        return _id;
+    }
+
+    /** A view of the interned string bytes. Stable for the lifetime of the process. */
+    StringView view() const noexcept;
+
+    /** The hash of the interned string, computed once at intern time. */
+    uint64 hashCode() const noexcept;
+
+    constexpr bool empty() const noexcept {
+        return (_id == 0);
+    }
+
+private:
+
+    constexpr explicit StringAtom(id_type id) noexcept : _id(id)
+    {}
+
+private:
+
+    /// Id 0 is reserved for the empty string.
+    id_type _id = 0;
+};
+
+
+inline
+bool operator== (StringAtom lhv, StringAtom rhv) noexcept {
+    return lhv.equals(rhv);
+}
+
+inline
+bool operator!= (StringAtom lhv, StringAtom rhv) noexcept {
+    return !lhv.equals(rhv);
+}
+
+inline
+bool operator< (StringAtom lhv, StringAtom rhv) noexcept {
+    return lhv.id() < rhv.id();
+}
+
+
+}  // namespace Solace
+#endif  // SOLACE_STRINGATOM_HPP
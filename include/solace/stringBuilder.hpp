@@ -27,6 +27,7 @@
 
 
 #include "solace/writeBuffer.hpp"
+#include "solace/memoryManager.hpp"
 #include "solace/string.hpp"
 
 #include "solace/traits/iformattable.hpp"
@@ -62,6 +63,15 @@ public:
     /** Initialize a new instance of StringBuilder with a given storage and initial string value.*/
     StringBuilder(MemoryBuffer&& buffer, StringView str);
 
+    /** Initialize a new instance of a growable StringBuilder.
+     * Storage is allocated via the given memory manager and is re-allocated -
+     * doubling in size - whenever an append outgrows it.
+     *
+     * @param allocator A memory manager to allocate the storage with.
+     * @param initialCapacity Initial storage capacity in bytes.
+     */
+    StringBuilder(MemoryManager& allocator, size_type initialCapacity);
+
     //!< Move construct string builder
     StringBuilder(const StringBuilder&) = delete;
 
@@ -78,6 +88,7 @@ public:
         using std::swap;
 
         swap(_buffer, rhs._buffer);
+        swap(_allocator, rhs._allocator);
 
         return *this;
     }
@@ -93,51 +104,29 @@ public:
         return append(str.view());
     }
 
+    /** Append decimal representation of the value directly into the underlying buffer.
+     * No intermediate string object is created.
+     */
+    StringBuilder& append(int64 value);
+
+    /** Append decimal representation of the value directly into the underlying buffer.
+     * No intermediate string object is created.
+     */
+    StringBuilder& append(uint64 value);
+
+    /** Append the shortest round-trip decimal representation of the value
+     * directly into the underlying buffer. No intermediate string object is created.
+     */
+    StringBuilder& append(float64 value);
+
     StringBuilder& append(IFormattable const& str) {
         return append(str.toString());
     }
 
     StringBuilder& appendFormat(StringView fmt) { return append(fmt); }
 
-//        template<typename T>
-//        StringBuilder& appendFormat(const String& fmt, T&& value) {
-//            return append(Format(fmt).formatArg(std::forward<T>(value)));
-//        }
-
-//        template<typename T>
-//        StringBuilder& appendFormat(char* fmt, T&& value) {
-//            return append(Format(fmt).formatArg(std::forward<T>(value)));
-//        }
-
-//        template<typename T>
-//        StringBuilder& appendFormat(char16_t* fmt, T&& value) {
-//            return append(Format(fmt).formatArg(std::forward<T>(value)));
-//        }
-
-//        template<typename T>
-//        StringBuilder& appendFormat(char32_t* fmt, T&& value) {
-//            return append(Format(fmt).formatArg(std::forward<T>(value)));
-//        }
-
-//        template<typename T, typename... Args>
-//        StringBuilder& appendFormat(const String& fmt, T&& value, Args... args) {
-//            return append(Format(fmt).formatArg(std::forward<T>(value), args...));
-//        }
-
-//        template<typename T, typename... Args>
-//        StringBuilder& appendFormat(const char* fmt, T&& value, Args... args) {
-//            return append(Format(fmt).formatArg(std::forward<T>(value), args...));
-//        }
-
-//        template<typename T, typename... Args>
-//        StringBuilder& appendFormat(const char16_t* fmt, T&& value, Args... args) {
-//            return append(Format(fmt).formatArg(std::forward<T>(value), args...));
-//        }
-
-//        template<typename T, typename... Args>
-//        StringBuilder& appendFormat(const char32_t* fmt, T&& value, Args... args) {
-//            return append(Format(fmt).formatArg(std::forward<T>(value), args...));
-//        }
+    // Variadic '{}'-style formatting lives in solace/format.hpp as the free
+    // function format(builder, fmt, args...) to keep this header light.
 
     String substring(size_type from, size_type to) const;
 	StringBuilder& clear();
@@ -158,14 +147,49 @@ public:
     size_type length() const noexcept;
 	bool empty() const;
 
+    /** Storage capacity in bytes. */
+    size_type capacity() const noexcept;
+
+    /** Make sure the storage can hold at least the given number of bytes.
+     * Growing is only possible for builders constructed with a memory manager;
+     * an exception is raised on an attempt to grow a fixed-storage builder.
+     *
+     * @param newCapacity Requested storage capacity in bytes.
+     * @return Reference to this for fluency.
+     */
+    StringBuilder& reserve(size_type newCapacity);
+
     StringView view() const noexcept;
 
     /** Get resulting string */
     String toString() const;
 
+    /**
+     * Finish building: take the accumulated content out as a String.
+     *
+     * Ownership of the underlying storage moves into the returned String,
+     * so finalizing is O(1) when the storage is owned and has room for the
+     * null terminator - no copy of the content is made. The builder is left
+     * empty with no storage; a growable builder re-allocates on the next
+     * append, a fixed-storage one can only stay empty.
+     *
+     * @return A string holding the built content.
+     */
+    String takeString();
+
+private:
+
+    /** Grow the storage - if a growth policy is set - so that appending
+     * the given number of bytes will not overflow.
+     */
+    void ensureRoomFor(size_type appendSize);
+
 private:
 
-    WriteBuffer  _buffer;
+    WriteBuffer     _buffer;
+
+    /// Optional growth policy: when set, storage doubles on overflow.
+    MemoryManager*  _allocator {nullptr};
 };
 
 
@@ -173,5 +197,22 @@ inline void swap(StringBuilder& lhs, StringBuilder& rhs) noexcept {
     lhs.swap(rhs);
 }
 
+
+/**
+ * Concatenate string fragments straight into a builder.
+ * Unlike the String-returning concat() no intermediate String is
+ * materialized - each fragment lands in the builder's storage directly.
+ */
+template <typename... Fragments>
+StringBuilder& concat(StringBuilder& dest, Fragments const&... fragments) {
+    const StringView views[] = { details::asFragment(fragments)... };
+
+    for (auto const& fragment : views) {
+        dest.append(fragment);
+    }
+
+    return dest;
+}
+
 }  // namespace Solace
 #endif  // SOLACE_STRINGBUILDER_HPP
@@ -24,6 +24,7 @@
 
 #include "solace/char.hpp"
 #include "solace/array.hpp"
+#include "solace/memoryView.hpp"
 #include "solace/optional.hpp"
 
 #include <ostream>
@@ -82,7 +83,12 @@ public:
      * After construction, data() is equal to s, and size() is equal to Traits::length(s).
      * @param s A pointer to a character array or a C string to initialize the view with.
      */
-    StringView(char const* s);
+    constexpr StringView(char const* s) :
+            _size((s != nullptr)
+                  ? strLength(s)
+                  : raiseNullString()),
+            _data(s)
+    {}
 
 
     StringView& swap(StringView& rhs) noexcept {
@@ -120,8 +126,48 @@ public:
         return _data;
     }
 
-    //!< True if values are equal
-    bool equals(StringView x) const noexcept;
+    /** True if values are equal.
+     *
+     * The length check and a first-word probe are inline: most unequal keys
+     * in practice differ in length or within the first 8 bytes, and those
+     * resolve at the call site without entering the full comparison.
+     */
+    bool equals(StringView x) const noexcept {
+        if (_size != x._size) {
+            return false;
+        }
+
+        if (_data == x._data || _size == 0) {
+            return true;
+        }
+
+        const size_type probe = (_size < sizeof(uint64)) ? _size : sizeof(uint64);
+        if (readWordAt(0, probe) != x.readWordAt(0, probe)) {
+            return false;
+        }
+
+        return (_size <= sizeof(uint64)) || equalsSlow(x);
+    }
+
+    /**
+     * Compare this view with another one, byte-wise.
+     * A differing lead byte - the common case for ordered keys - is decided
+     * inline; everything else falls through to the full comparison.
+     *
+     * @param other A view to compare against.
+     * @return Negative, zero or positive as this view orders before, equal
+     * to or after the other, a-la memcmp.
+     */
+    int compareTo(StringView other) const noexcept {
+        if (_size != 0 && other._size != 0) {
+            const int lead = static_cast<byte>(_data[0]) - static_cast<byte>(other._data[0]);
+            if (lead != 0) {
+                return lead;
+            }
+        }
+
+        return compareSlow(other);
+    }
 
     /**
      * Tests if the string starts with the specified prefix.
@@ -197,6 +243,35 @@ public:
      */
     Optional<size_type> lastIndexOf(value_type const& ch, size_type fromIndex = 0) const;
 
+    /** Length of the run of characters of the given classes starting at an offset.
+     *
+     * One table load per character and whole runs consumed per call, so a
+     * tokenizer advances span-at-a-time instead of byte-at-a-time predicate
+     * calls. Class bits combine: spanOfClass(Char::Digit | Char::Whitespace).
+     *
+     * @param classMask Character classes accepted in the run. @see Char::Category
+     * @param fromIndex Offset the run starts at.
+     * @return Number of consecutive matching characters; 0 when the first
+     * character does not match or fromIndex is past the end.
+     */
+    size_type spanOfClass(uint16 classMask, size_type fromIndex = 0) const noexcept;
+
+    //!< Length of the run of decimal digits starting at the given offset.
+    size_type spanOfDigits(size_type fromIndex = 0) const noexcept
+    {   return spanOfClass(Char::Digit, fromIndex); }
+
+    //!< Length of the run of hex digits starting at the given offset.
+    size_type spanOfXDigits(size_type fromIndex = 0) const noexcept
+    {   return spanOfClass(Char::HexDigit, fromIndex); }
+
+    //!< Length of the run of letters starting at the given offset.
+    size_type spanOfLetters(size_type fromIndex = 0) const noexcept
+    {   return spanOfClass(Char::Letter, fromIndex); }
+
+    //!< Length of the run of whitespace starting at the given offset.
+    size_type spanOfWhitespace(size_type fromIndex = 0) const noexcept
+    {   return spanOfClass(Char::Whitespace, fromIndex); }
+
     /** Determine if the string contains a given substring.
      *
      * @param str The substring to search for.
@@ -239,6 +314,26 @@ public:
      */
     StringView trim() const;
 
+    /** Copy this string into the given buffer converting ASCII letters to lower case.
+     * Non-ASCII bytes are copied through untouched, so valid UTF-8 stays valid.
+     * The destination may alias this view's bytes for an in-place conversion.
+     *
+     * @param dest A buffer to write the converted string into.
+     * @return A view of the converted string over the destination buffer.
+     * @throw OverflowException If the destination is too small to hold the string.
+     */
+    StringView toLowerCase(MemoryView dest) const;
+
+    /** Copy this string into the given buffer converting ASCII letters to upper case.
+     * Non-ASCII bytes are copied through untouched, so valid UTF-8 stays valid.
+     * The destination may alias this view's bytes for an in-place conversion.
+     *
+     * @param dest A buffer to write the converted string into.
+     * @return A view of the converted string over the destination buffer.
+     * @throw OverflowException If the destination is too small to hold the string.
+     */
+    StringView toUpperCase(MemoryView dest) const;
+
     /** Array index operator. Obtain a copy of the character at the given
 	 * offset in the string.
 	 *
@@ -246,7 +341,7 @@ public:
 	 * @return The character at the specified index, as a Char.
 	 * @throw OutOfBoundsException If <i>index</I> is out of range.
 	 */
-    value_type operator[] (size_type index) const {
+    constexpr value_type operator[] (size_type index) const noexcept {
         return _data[index];
     }
 
@@ -275,30 +370,171 @@ public:
      */
     Array<StringView> split(value_type delim) const;
 
+    /** Splits the string around matches of the delimiter, lazily.
+     * Each token is passed to the given callable as a sub-view of this string.
+     * Unlike the Array returning overloads no memory is allocated.
+     *
+     * @param delim A delimiter to split the string by.
+     * @param f A callable to invoke with each token.
+     */
+    template<typename F>
+    void split(value_type delim, F&& f) const {
+        size_type from = 0;
+        for (size_type to = 0; to < size(); ++to) {
+            if (_data[to] == delim) {
+                f(substring(from, to - from));
+                from = to + 1;
+            }
+        }
+
+        f(substring(from, size() - from));
+    }
+
+    /** Splits the string around matches of the delimiter, lazily.
+     * Each token is passed to the given callable as a sub-view of this string.
+     * Unlike the Array returning overloads no memory is allocated.
+     *
+     * @param delim A delimiter to split the string by.
+     * @param f A callable to invoke with each token.
+     */
+    template<typename F>
+    void split(StringView delim, F&& f) const {
+        const auto delimLength = delim.length();
+        if (delimLength == 0 || delimLength > size()) {
+            f(*this);
+            return;
+        }
+
+        size_type to = 0, from = 0;
+        for (; to + delimLength <= size(); ++to) {
+            if (substring(to, delimLength).equals(delim)) {
+                f(substring(from, to - from));
+                to += delimLength - 1;
+                from = to + 1;
+            }
+        }
+
+        f(substring(from, size() - from));
+    }
+
     /** Returns a hash code for this string.
+     * The hash is computable at compile time for constexpr-constructed views,
+     * so it can be used to build dispatch tables with no startup cost.
      *
      * @return A hash code value for the string.
      */
-    uint64 hashCode() const noexcept;
+    constexpr uint64 hashCode() const noexcept {
+        uint64 result = 0;
+        const uint64 prime = 31;
+        for (size_type i = 0; i < _size; ++i) {
+            result = _data[i] + (result * prime);
+        }
+
+        return result;
+    }
+
+    /** Returns a seeded hash code for this string.
+     *
+     * The unseeded hashCode() is a fixed public function: anyone can
+     * precompute arbitrarily many colliding keys and flood a table built on
+     * it. Mixing in a secret per-process seed (@see hashSeed()) makes the
+     * collision structure unpredictable while staying cheap: the mix is an
+     * XXH3-class folded 64x128-bit multiply over 8-byte lanes, a couple of
+     * instructions per word.
+     *
+     * Hash tables pick this overload up automatically through the hashOf()
+     * protocol; keep the unseeded hashCode() for stable, compile-time
+     * computable values such as dispatch tables.
+     *
+     * @param seed Seed the hash is keyed by, normally hashSeed().
+     * @return A hash code value for the string under the given seed.
+     */
+    constexpr uint64 hashCode(uint64 seed) const noexcept {
+        // Mixing constants are the xxHash primes: odd and bit-rich.
+        constexpr uint64 prime1 = 0x9E3779B185EBCA87ULL;
+        constexpr uint64 prime2 = 0xC2B2AE3D27D4EB4FULL;
+        constexpr uint64 prime3 = 0x165667B19E3779F9ULL;
+
+        uint64 result = seed ^ foldedMultiply(static_cast<uint64>(_size) ^ prime1, prime2);
 
-    const_iterator begin() const noexcept {
+        size_type i = 0;
+        for (; i + sizeof(uint64) <= _size; i += sizeof(uint64)) {
+            result = foldedMultiply(result ^ readWordAt(i, sizeof(uint64)), prime2);
+        }
+
+        if (i < _size) {
+            result = foldedMultiply(result ^ readWordAt(i, _size - i), prime3);
+        }
+
+        return foldedMultiply(result, result ^ prime1);
+    }
+
+    constexpr const_iterator begin() const noexcept {
         return empty()
                 ? nullptr
                 : _data;
     }
 
-    const_iterator end() const noexcept { return begin() + size(); }
+    constexpr const_iterator end() const noexcept { return begin() + size(); }
 
     ImmutableMemoryView view() const noexcept {
         return wrapMemory(_data, _size);
     }
 
+private:
+
+    /** Fold a full-width 64x64 multiply into 64 bits; the core of the seeded hash. */
+    static constexpr uint64 foldedMultiply(uint64 a, uint64 b) noexcept {
+        uint64 hi = 0;
+        uint64 lo = 0;
+        mul64wide(a, b, hi, lo);
+
+        return hi ^ lo;
+    }
+
+    /** Read up to 8 bytes little-endian; byte loads keep it a constant expression. */
+    constexpr uint64 readWordAt(size_type from, size_type nbBytes) const noexcept {
+        uint64 word = 0;
+        for (size_type i = 0; i < nbBytes; ++i) {
+            word |= static_cast<uint64>(static_cast<byte>(_data[from + i])) << (8 * i);
+        }
+
+        return word;
+    }
+
+    /** Compute the length of a null-terminated string; usable at compile time. */
+    static constexpr size_type strLength(char const* s) noexcept {
+        size_type length = 0;
+        while (s[length] != '\0') {
+            ++length;
+        }
+
+        return length;
+    }
+
+    /** Raise an exception about a null c-string. Never a constant expression. */
+    static size_type raiseNullString();
+
+    /** Equality tail for views the inline pre-checks could not reject. */
+    bool equalsSlow(StringView x) const noexcept;
+
+    /** Ordering for views whose lead bytes agree. */
+    int compareSlow(StringView other) const noexcept;
+
 private:
     size_type   _size = 0;
     char const* _data = nullptr;
 };
 
 
+/** StringView's null state - a view of no data - backs a compact Optional. */
+template <>
+struct OptionalSentinel<StringView> : std::true_type {
+    static constexpr StringView makeNull() noexcept { return StringView{}; }
+    static constexpr bool isNull(StringView const& view) noexcept { return (view.data() == nullptr); }
+};
+
+
 /** Immutable Unicode String Literal
  * StringLiteral is a wrapper of C-string defined in place in the code.
  * Naturally it is immutable.
@@ -357,6 +593,11 @@ bool operator!= (StringView const& str, char const* rhv) noexcept {
     return !str.equals(rhv);
 }
 
+inline
+bool operator< (StringView lhv, StringView rhv) noexcept {
+    return lhv.compareTo(rhv) < 0;
+}
+
 
 inline std::ostream& operator<< (std::ostream& ostr, StringView const& str) {
     return ostr.write(str.data(), str.size());
@@ -0,0 +1,140 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Opt-in hot-path instrumentation
+ *	@file		solace/telemetry.hpp
+ *	@brief		Per-thread counters and cycle histograms for library hot paths
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_TELEMETRY_HPP
+#define SOLACE_TELEMETRY_HPP
+
+#include "solace/types.hpp"
+#include "solace/libsolace_config.hpp"
+
+#if defined(SOLACE_ENABLE_TELEMETRY) && !(defined(__x86_64__) || defined(__i386__))
+#include <chrono>
+#endif
+
+
+namespace Solace { namespace Telemetry {
+
+/**
+ * Instrumented library events. Each probe aggregates a count, a sum and a
+ * log2 histogram of the recorded values; the unit of the value is a
+ * property of the probe (bytes, cycles or batch sizes - see below).
+ *
+ * Instrumentation is compiled in only when SOLACE_ENABLE_TELEMETRY is
+ * defined (cmake -DENABLE_TELEMETRY=ON). When it is not, the recording
+ * macros expand to nothing - the disabled library carries no counters, no
+ * branches and no argument evaluation on any hot path. The snapshot API
+ * below exists in both modes so monitoring code compiles unconditionally;
+ * a disabled build reports all zeroes.
+ *
+ * Counters are per thread and cache-line padded, so recording never
+ * contends. snapshot() sums the live thread slots without stopping
+ * writers: totals are monotone but may mix in-flight updates, which is
+ * the intended trade for zero recording overhead.
+ */
+enum class Probe : uint32 {
+    MemoryManagerAllocBytes = 0,    //!< Size of each MemoryManager allocation.
+    MemoryManagerAllocCycles,       //!< rdtsc cycles spent inside create().
+    MemoryManagerFreeBytes,         //!< Size of each segment returned.
+    SelectorPollBatch,              //!< Events delivered by one poll() call.
+    ByteBufferWriteBytes,           //!< Size of each bulk ByteBuffer write.
+};
+
+constexpr uint32 kProbeCount = 5;
+
+/// Histogram buckets are powers of two: bucket i counts values in [2^i, 2^(i+1)).
+constexpr uint32 kHistogramBuckets = 64;
+
+
+/** Aggregated state of one probe, summed across every thread. */
+struct ProbeSnapshot {
+    uint64 count;
+    uint64 sum;
+    uint64 histogram[kHistogramBuckets];
+};
+
+/** Aggregated state of every probe at one point in time. */
+struct Snapshot {
+    ProbeSnapshot probes[kProbeCount];
+};
+
+
+/** Get a human-readable name of a probe, for reporting. */
+const char* probeName(Probe probe) noexcept;
+
+/**
+ * Sum the per-thread counters of every probe.
+ * @return Aggregated totals; all zeroes when telemetry is compiled out.
+ */
+Snapshot takeSnapshot() noexcept;
+
+
+#if defined(SOLACE_ENABLE_TELEMETRY)
+
+/** Record one value against a probe on this thread's counters. */
+void record(Probe probe, uint64 value) noexcept;
+
+/** Read the cycle counter backing scoped timings. */
+inline uint64 readCycleCounter() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    // No cheap cycle counter on this target; nanoseconds keep the probes useful.
+    return static_cast<uint64>(
+            std::chrono::steady_clock::now().time_since_epoch().count());
+#endif
+}
+
+/** Records the cycles spent in the enclosing scope against a probe. */
+struct ScopedCycles {
+    Probe   probe;
+    uint64  started;
+
+    ScopedCycles(Probe inProbe) noexcept :
+        probe(inProbe),
+        started(readCycleCounter())
+    {}
+
+    ~ScopedCycles() noexcept {
+        record(probe, readCycleCounter() - started);
+    }
+
+    ScopedCycles(ScopedCycles const&) = delete;
+    ScopedCycles& operator= (ScopedCycles const&) = delete;
+};
+
+#endif  // SOLACE_ENABLE_TELEMETRY
+
+}  // End of namespace Telemetry
+}  // End of namespace Solace
+
+
+#if defined(SOLACE_ENABLE_TELEMETRY)
+#define SOLACE_TELEMETRY_RECORD(probe, value) \
+    ::Solace::Telemetry::record(probe, (value))
+#define SOLACE_TELEMETRY_SCOPED_CYCLES(probe) \
+    ::Solace::Telemetry::ScopedCycles solaceTelemetryScope_ {probe}
+#else
+// The value expression is swallowed unevaluated: zero cost when disabled.
+#define SOLACE_TELEMETRY_RECORD(probe, value) do { } while (false)
+#define SOLACE_TELEMETRY_SCOPED_CYCLES(probe) do { } while (false)
+#endif
+
+#endif  // SOLACE_TELEMETRY_HPP
@@ -0,0 +1,131 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Realtime-safe clock and timestamp type
+ *	@file		solace/timestamp.hpp
+ *	@author		$LastChangedBy: $
+ *	@date		$LastChangedDate: $
+ *	@brief		Realtime-safe clock and timestamp type
+ *	ID:			$Id: $
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_TIMESTAMP_HPP
+#define SOLACE_TIMESTAMP_HPP
+
+#include "solace/types.hpp"
+#include "solace/result.hpp"
+#include "solace/error.hpp"
+
+
+namespace Solace {
+
+class WriteBuffer;
+class StringBuilder;
+
+
+/**
+ * A point in time with nanosecond resolution.
+ *
+ * The value is nanoseconds since the Unix epoch when produced by the
+ * realtime clock, or since an arbitrary boot-time origin when produced
+ * by the monotonic one; the type does not track which. It is a plain
+ * 64-bit value - cheap to copy, store in messages and subtract.
+ */
+struct Timestamp {
+
+    static constexpr int64 NanosInSecond = 1000000000;
+
+    int64   nanos;      //!< Nanoseconds since the clock origin.
+
+    /** Whole seconds since the clock origin. */
+    int64 seconds() const noexcept {
+        return nanos / NanosInSecond;
+    }
+
+    /** Nanoseconds into the current second. */
+    int64 nanosOfSecond() const noexcept {
+        return nanos % NanosInSecond;
+    }
+
+    bool operator== (Timestamp rhs) const noexcept { return nanos == rhs.nanos; }
+    bool operator!= (Timestamp rhs) const noexcept { return nanos != rhs.nanos; }
+    bool operator<  (Timestamp rhs) const noexcept { return nanos <  rhs.nanos; }
+    bool operator<= (Timestamp rhs) const noexcept { return nanos <= rhs.nanos; }
+    bool operator>  (Timestamp rhs) const noexcept { return nanos >  rhs.nanos; }
+    bool operator>= (Timestamp rhs) const noexcept { return nanos >= rhs.nanos; }
+
+    /** Distance between two points in time, in nanoseconds. */
+    int64 operator- (Timestamp rhs) const noexcept {
+        return nanos - rhs.nanos;
+    }
+
+    Timestamp operator+ (int64 delta) const noexcept {
+        return Timestamp{nanos + delta};
+    }
+
+    /**
+     * Format this timestamp as ISO-8601 UTC with nanoseconds, e.g.
+     * "2016-06-20T07:31:56.123456789Z". No allocation and no locale state:
+     * the date math is done inline rather than through strftime.
+     *
+     * @param dest Buffer to write the 30 characters into.
+     * @return Nothing if successfull, or the buffer's overflow error.
+     */
+    Result<void, Error> formatIso8601(WriteBuffer& dest) const;
+
+    /** @see formatIso8601(WriteBuffer&), appending to a string builder. */
+    void formatIso8601(StringBuilder& dest) const;
+
+    /** Number of characters formatIso8601() produces. */
+    static constexpr uint32 Iso8601Size = 30;
+};
+
+
+/**
+ * Clock readings for code that takes timestamps on every message.
+ *
+ * realtime() and monotonic() are plain clock_gettime wrappers. now() is
+ * the fast path: it extrapolates the realtime clock from the TSC using a
+ * calibration taken at first use, turning a vsyscall plus conversion into
+ * a dozen cycles. The extrapolation drifts with the TSC (ppm-level per
+ * calibration interval), so code that compares against other machines
+ * should recalibrate() periodically - a logging loop need not bother.
+ */
+class Clock {
+public:
+
+    /** Read CLOCK_REALTIME: nanoseconds since the Unix epoch. */
+    static Timestamp realtime() noexcept;
+
+    /** Read CLOCK_MONOTONIC: unaffected by wall clock adjustment. */
+    static Timestamp monotonic() noexcept;
+
+    /**
+     * Estimate CLOCK_REALTIME from the cycle counter.
+     * Falls back to realtime() on platforms without a usable TSC.
+     */
+    static Timestamp now() noexcept;
+
+    /**
+     * Re-anchor the TSC extrapolation against the realtime clock.
+     * The first call (or the first now()) measures the TSC frequency,
+     * which blocks the calling thread for about a millisecond.
+     */
+    static void recalibrate() noexcept;
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_TIMESTAMP_HPP
@@ -53,6 +53,40 @@ using float64 = double;
 //! 8 bit unsigned variable - byte.
 using byte = uint8;
 
+#if defined(__SIZEOF_INT128__)
+//! 128 bit unsigned variable, on compilers that provide one.
+/** __extension__ keeps the non-ISO type acceptable under -pedantic-errors. */
+__extension__ using uint128 = unsigned __int128;
+#endif
+
+
+/**
+ * Full-width 64x64 multiply: the high and low halves of a*b.
+ * The building block of the folded-multiply hashes. A single wide multiply
+ * where the compiler has a 128-bit type, a four-way schoolbook product
+ * otherwise; usable in constant expressions either way.
+ */
+constexpr void mul64wide(uint64 a, uint64 b, uint64& hi, uint64& lo) noexcept {
+#if defined(__SIZEOF_INT128__)
+    const auto product = static_cast<uint128>(a) * b;
+    hi = static_cast<uint64>(product >> 64);
+    lo = static_cast<uint64>(product);
+#else
+    const uint64 aLo = a & 0xFFFFFFFFu;
+    const uint64 aHi = a >> 32;
+    const uint64 bLo = b & 0xFFFFFFFFu;
+    const uint64 bHi = b >> 32;
+
+    const uint64 ll = aLo * bLo;
+    const uint64 lh = aLo * bHi;
+    const uint64 hl = aHi * bLo;
+
+    const uint64 cross = (ll >> 32) + (lh & 0xFFFFFFFFu) + (hl & 0xFFFFFFFFu);
+    hi = (aHi * bHi) + (lh >> 32) + (hl >> 32) + (cross >> 32);
+    lo = (cross << 32) | (ll & 0xFFFFFFFFu);
+#endif
+}
+
 
 // Static check of Integral types
 // ...otherwise things might fail with compilers!
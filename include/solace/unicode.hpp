@@ -0,0 +1,100 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Unicode transcoding kernels
+ *	@file		solace/unicode.hpp
+ *	@brief		Bulk UTF-8 / UTF-16 / UTF-32 conversion over memory views
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_UNICODE_HPP
+#define SOLACE_UNICODE_HPP
+
+#include "solace/memoryView.hpp"
+#include "solace/result.hpp"
+#include "solace/error.hpp"
+
+
+namespace Solace { namespace unicode {
+
+using size_type = MemoryView::size_type;
+
+/**
+ * Bulk transcoding between UTF-8, UTF-16 and UTF-32, view to view.
+ *
+ * Each kernel validates and converts in one fused pass - malformed input
+ * fails the call instead of producing replacement characters - and runs of
+ * ASCII are moved a vector register at a time where the platform has one.
+ * Nothing is allocated: the caller provides the destination, sized with the
+ * worst-case helpers below or by measuring the input first.
+ *
+ * UTF-16 and UTF-32 code units are read and written in native byte order.
+ *
+ * Every kernel returns the number of BYTES written into the destination,
+ * or an error for malformed input or a destination too small.
+ */
+
+/** Worst-case destination size for utf8ToUtf16(), in bytes. */
+constexpr size_type utf16CapacityFor(size_type utf8Bytes) noexcept {
+    return utf8Bytes * 2;   // One code unit per input byte at worst (ASCII).
+}
+
+/** Worst-case destination size for utf8ToUtf32(), in bytes. */
+constexpr size_type utf32CapacityFor(size_type utf8Bytes) noexcept {
+    return utf8Bytes * 4;   // One code point per input byte at worst (ASCII).
+}
+
+/** Worst-case destination size for utf16ToUtf8(), in bytes. */
+constexpr size_type utf8CapacityForUtf16(size_type utf16Bytes) noexcept {
+    return (utf16Bytes / 2) * 3;    // A lone unit expands to 3 bytes at worst.
+}
+
+/** Worst-case destination size for utf32ToUtf8(), in bytes. */
+constexpr size_type utf8CapacityForUtf32(size_type utf32Bytes) noexcept {
+    return utf32Bytes;      // A code point expands to 4 bytes at worst.
+}
+
+
+/** Transcode UTF-8 into native-endian UTF-16.
+ * @param src View of the UTF-8 bytes to convert.
+ * @param dest Destination for the UTF-16 code units.
+ * @return Number of bytes written, or an error.
+ */
+Result<size_type, Error> utf8ToUtf16(ImmutableMemoryView src, MemoryView dest) noexcept;
+
+/** Transcode native-endian UTF-16 into UTF-8.
+ * @param src View of the UTF-16 code units to convert; must be an even number of bytes.
+ * @param dest Destination for the UTF-8 bytes.
+ * @return Number of bytes written, or an error.
+ */
+Result<size_type, Error> utf16ToUtf8(ImmutableMemoryView src, MemoryView dest) noexcept;
+
+/** Transcode UTF-8 into native-endian UTF-32.
+ * @param src View of the UTF-8 bytes to convert.
+ * @param dest Destination for the UTF-32 code points.
+ * @return Number of bytes written, or an error.
+ */
+Result<size_type, Error> utf8ToUtf32(ImmutableMemoryView src, MemoryView dest) noexcept;
+
+/** Transcode native-endian UTF-32 into UTF-8.
+ * @param src View of the UTF-32 code points to convert; must be a multiple of 4 bytes.
+ * @param dest Destination for the UTF-8 bytes.
+ * @return Number of bytes written, or an error.
+ */
+Result<size_type, Error> utf32ToUtf8(ImmutableMemoryView src, MemoryView dest) noexcept;
+
+}  // End of namespace unicode
+}  // End of namespace Solace
+#endif  // SOLACE_UNICODE_HPP
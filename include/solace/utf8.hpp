@@ -0,0 +1,90 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: UTF-8 encoding utilities
+ *	@file		solace/utf8.hpp
+ *	@brief		Bulk UTF-8 validation and zero-copy code point iteration
+ ******************************************************************************/
+#pragma once
+#ifndef SOLACE_UTF8_HPP
+#define SOLACE_UTF8_HPP
+
+#include "solace/char.hpp"
+#include "solace/stringView.hpp"
+
+
+namespace Solace {
+
+/** Check that a string is well-formed UTF-8.
+ *
+ * Validates the whole input in bulk: runs of ASCII are skipped a vector
+ * register at a time and only the multi-byte sequences pay for the full
+ * range checks. Rejects overlong encodings, surrogate code points and
+ * values above U+10FFFF, per RFC 3629.
+ *
+ * @param text A string to validate.
+ * @return True if the input is a well-formed UTF-8 sequence.
+ */
+bool isValidUtf8(StringView text) noexcept;
+
+
+/** A code point cursor over a UTF-8 encoded string view.
+ *
+ * Iterates the code points of a string without copying or allocating:
+ * the cursor only holds an offset into the view it was constructed over.
+ * The view's bytes must outlive the cursor.
+ *
+ * Input is expected to be valid UTF-8 - see isValidUtf8() for a bulk
+ * check. A malformed sequence does not throw: it decodes as U+FFFD
+ * (the replacement character) and the cursor advances by one byte,
+ * which is the standard lossy decoding behaviour.
+ */
+class Utf8Cursor {
+public:
+
+    using size_type = StringView::size_type;
+
+public:
+
+    constexpr Utf8Cursor(StringView text) noexcept
+        : _text(text)
+    {}
+
+    /** @return True if there are more code points to read. */
+    constexpr bool hasNext() const noexcept {
+        return (_offset < _text.size());
+    }
+
+    /** @return Offset in bytes of the next code point to be read. */
+    constexpr size_type offset() const noexcept {
+        return _offset;
+    }
+
+    /** Decode the next code point and advance the cursor past it.
+     * Must not be called when hasNext() is false.
+     *
+     * @return The code point at the current position.
+     */
+    Char next() noexcept;
+
+private:
+
+    StringView  _text;
+    size_type   _offset{0};
+};
+
+}  // End of namespace Solace
+#endif  // SOLACE_UTF8_HPP
@@ -78,6 +78,18 @@ template<class X, class Y> using has_greater_than = op_valid<X, Y, std::greater<
 template<class X, class Y> using has_greater_equal = op_valid<X, Y, std::greater_equal<>>;
 
 
+/** Check that every type in a pack is a built-in integral type. */
+template<typename... Ts>
+struct allIntegral;
+
+template<>
+struct allIntegral<> : std::true_type {};
+
+template<typename T, typename... Ts>
+struct allIntegral<T, Ts...> :
+        std::integral_constant<bool, std::is_integral<T>::value && allIntegral<Ts...>::value> {};
+
+
 /**
  * Replacement for std::move() and std::forward() in order to not pull
  * std header <utility> that drags a lot of other stuff we don't use.
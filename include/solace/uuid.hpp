@@ -29,6 +29,7 @@
 #include "solace/traits/icomparable.hpp"
 
 #include "solace/immutableMemoryView.hpp"
+#include "solace/arrayView.hpp"
 #include "solace/string.hpp"
 #include "solace/result.hpp"
 #include "solace/error.hpp"
@@ -36,6 +37,8 @@
 
 namespace Solace {
 
+class ByteBuffer;
+
 /**
  * Universally Unique Identifier - as per RFC 4122, eg. unique 128 bit number.
  * UUID is a collection of bytes or a single unique 128bit nubmer.
@@ -68,6 +71,29 @@ public:
      */
     static UUID random() noexcept;
 
+    /**
+     * Generate a batch of random version-4 UUIDs in one call.
+     *
+     * The whole batch is served from a buffered system CSPRNG, so minting
+     * N ids costs one read of the entropy pool per few hundred ids rather
+     * than a random number generator round-trip each. Version and variant
+     * bits are set as per RFC 4122.
+     *
+     * @param dest A view of UUIDs to overwrite with fresh random ids.
+     */
+    static void randomize(ArrayView<UUID> dest) noexcept;
+
+    /**
+     * Create a time-ordered UUID, as per the version-7 draft.
+     *
+     * The id starts with the 48-bit Unix timestamp in milliseconds followed
+     * by a monotonic counter that breaks ties within a millisecond, so ids
+     * minted by one process sort by creation time. Use these as storage
+     * keys where v4's random prefixes would scatter inserts all over an
+     * ordered index; the remaining bits are random as in v4.
+     */
+    static UUID timeOrdered() noexcept;
+
     /**
      * Parse a UUID object from a string.
      *
@@ -169,6 +195,31 @@ public:
     /** @see IFormattable::toString() */
     String toString() const override;
 
+    /**
+     * Write the canonical 36-character form of this UUID into a buffer.
+     * Unlike toString() this allocates nothing - the characters go straight
+     * into the buffer at its current position.
+     *
+     * @param dest A buffer to write the string form into.
+     * @return A reference to the destination buffer for a fluent interface.
+     */
+    ByteBuffer& format(ByteBuffer& dest) const;
+
+    /**
+     * Write the canonical 36-character form into the front of the given
+     * memory view.
+     *
+     * The zero-allocation path for naming things after UUIDs in bulk - no
+     * String, no buffer object, just characters into caller-owned memory.
+     * The returned view of the written text is ready to pass on as a file
+     * name or an index key.
+     *
+     * @param dest Memory to write the text into, at least StringSize bytes.
+     * @return A view of the 36 characters written, or an error if dest is
+     * too small.
+     */
+    Result<StringView, Error> formatInto(MemoryView dest) const noexcept;
+
     friend bool operator < (UUID const& lhs, UUID const& rhs) noexcept;
 
 private:
@@ -30,6 +30,7 @@
 #include "solace/string.hpp"
 #include "solace/result.hpp"
 #include "solace/error.hpp"
+#include "solace/arrayView.hpp"
 
 
 namespace Solace {
@@ -73,6 +74,69 @@ public:
     parse(StringView const& value);
 
 
+    /**
+     * Pack a numeric version triple into a single comparable 64-bit value:
+     * 16 bits of major, 16 bits of minor and 32 bits of patch. Packed
+     * values order exactly like the versions they encode, so hot paths can
+     * compare (and hash) one integer instead of three fields.
+     *
+     * Components must fit their fields; @see isPackable().
+     */
+    static constexpr uint64 pack(value_type aMajor, value_type aMinor, value_type aPatch) noexcept {
+        return ((aMajor & 0xFFFF) << 48)
+                | ((aMinor & 0xFFFF) << 32)
+                | (aPatch & 0xFFFFFFFF);
+    }
+
+    /**
+     * Parse a "major.minor.patch" literal into the packed encoding at
+     * compile time. Malformed input - or components that do not fit the
+     * packed fields - yields 0, which is also what "0.0.0" packs to, so a
+     * literal table built this way should not contain the zero version.
+     *
+     * @param str A null-terminated numeric version string.
+     * @return The packed encoding of the version, or 0 if unparsable.
+     */
+    static constexpr uint64 parsePacked(char const* str) noexcept {
+        value_type parts[3] = {0, 0, 0};
+        int part = 0;
+        bool hasDigits = false;
+
+        for (; *str != '\0'; ++str) {
+            const char c = *str;
+
+            if (c == '.') {
+                if (!hasDigits || part == 2) {
+                    return 0;
+                }
+
+                ++part;
+                hasDigits = false;
+            } else if (c >= '0' && c <= '9') {
+                parts[part] = parts[part] * 10 + static_cast<value_type>(c - '0');
+                hasDigits = true;
+            } else {
+                return 0;
+            }
+        }
+
+        if (part != 2 || !hasDigits) {
+            return 0;
+        }
+
+        if (parts[0] > 0xFFFF || parts[1] > 0xFFFF || parts[2] > 0xFFFFFFFF) {
+            return 0;
+        }
+
+        return pack(parts[0], parts[1], parts[2]);
+    }
+
+    /** Reconstruct a numeric-only version from its packed encoding. */
+    static Version fromPacked(uint64 value) {
+        return Version(value >> 48, (value >> 32) & 0xFFFF, value & 0xFFFFFFFF);
+    }
+
+
 public:
 
 	/** Empty version constructor */
@@ -107,9 +171,24 @@ public:
 
 public:
 
-    bool operator> (Version const& rhv) const;
+    /** Check whether this version fits the packed encoding:
+     * no pre-release identifier and numeric components within field range.
+     */
+    bool isPackable() const noexcept {
+        return preRelease.empty()
+                && majorNumber <= 0xFFFF
+                && minorNumber <= 0xFFFF
+                && patchNumber <= 0xFFFFFFFF;
+    }
+
+    /** Packed encoding of this version's numeric triple. @see pack() */
+    uint64 packed() const noexcept {
+        return pack(majorNumber, minorNumber, patchNumber);
+    }
+
+    bool operator> (Version const& rhv) const noexcept;
 
-    bool operator< (Version const& rhv) const {
+    bool operator< (Version const& rhv) const noexcept {
 		return !(operator >(rhv));
 	}
 
@@ -147,6 +226,101 @@ public:
 };
 
 
+/** A compiled semver range predicate.
+ * A range string such as ">=1.4 <2.0" is parsed once into a pair of packed
+ * numeric bounds - @see Version::pack() - and membership evaluates with two
+ * integer compares, so a handshake path checking peer versions pays no
+ * re-parsing and no string work per check.
+ *
+ * The grammar is a whitespace-separated conjunction of comparator clauses:
+ * each clause is one of >=, >, <=, < or = (or nothing, meaning =) followed
+ * by a numeric version with missing components read as zero, so "<2.0"
+ * bounds below 2.0.0. Clauses intersect; a contradiction parses to an error.
+ *
+ * Versions with a pre-release identifier never match a range, matching
+ * common semver range semantics.
+ */
+class VersionRange {
+public:
+    using size_type = uint32;
+
+public:
+
+    /**
+     * Compile a range object from its string representation.
+     * @return Compiled range or an error.
+     */
+    static Result<VersionRange, Error>
+    parse(StringView const& value);
+
+    /** An unbounded range: matches every packable version. */
+    constexpr VersionRange() noexcept = default;
+
+    /** Construct a range directly from packed bounds, both inclusive. */
+    constexpr VersionRange(uint64 lowerPacked, uint64 upperPacked) noexcept :
+        _lower(lowerPacked),
+        _upper(upperPacked)
+    {}
+
+    /** Check a packed version - @see Version::packed() - for membership. Two compares. */
+    constexpr bool contains(uint64 packedVersion) const noexcept {
+        return (_lower <= packedVersion) && (packedVersion <= _upper);
+    }
+
+    /** Check a version for membership. Pre-release versions never match. */
+    bool contains(Version const& version) const noexcept {
+        return version.isPackable() && contains(version.packed());
+    }
+
+    /**
+     * Sweep a batch of versions - a peer table, say - for membership.
+     *
+     * @param candidates Versions to test.
+     * @param matches Caller owned buffer filled with the indices of the
+     * members, in order. Extra members beyond its size are counted but dropped.
+     * @return Number of members found, which may exceed the indices stored.
+     */
+    size_type selectInto(ArrayView<const Version> candidates, ArrayView<size_type> matches) const noexcept {
+        size_type found = 0;
+        const auto capacity = matches.size();
+        const auto count = candidates.size();
+        for (size_type i = 0; i < count; ++i) {
+            if (contains(candidates[i])) {
+                if (found < capacity) {
+                    matches[found] = i;
+                }
+                found += 1;
+            }
+        }
+
+        return found;
+    }
+
+    /** Count the members of a batch of versions. */
+    size_type count(ArrayView<const Version> candidates) const noexcept {
+        size_type members = 0;
+        for (const auto& candidate : candidates) {
+            if (contains(candidate)) {
+                members += 1;
+            }
+        }
+
+        return members;
+    }
+
+    /** Inclusive packed lower bound of the range. */
+    constexpr uint64 lowerPacked() const noexcept { return _lower; }
+
+    /** Inclusive packed upper bound of the range. */
+    constexpr uint64 upperPacked() const noexcept { return _upper; }
+
+private:
+
+    uint64 _lower {0};
+    uint64 _upper {~uint64(0)};
+};
+
+
 /**
  * Get build version of the linked library.
  * @return Build version of libsolace we are linked against.
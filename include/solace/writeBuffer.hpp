@@ -27,10 +27,18 @@
 
 #include "solace/result.hpp"
 #include "solace/error.hpp"
+#include "solace/optional.hpp"
+
+#include <cstring>  // memcpy
+#include <functional>
+#include <vector>
 
 
 namespace Solace {
 
+template<typename F>
+struct WireFieldOps;    // Codec field access, see solace/codec.hpp
+
 
 /**
  * Write-only adapter for a memory buffer.
@@ -41,6 +49,14 @@ public:
     using Storage = MemoryBuffer;
     using size_type = Storage::size_type;
 
+    /**
+     * Supplier of more storage for a writer that overran its buffer.
+     * Called with the number of bytes that did not fit; returns the next
+     * buffer to continue writing into - typically grabbed from a MemoryManager
+     * pool - or none to make the write fail as it would without a handler.
+     */
+    using OverflowHandler = std::function<Optional<MemoryBuffer> (size_type)>;
+
 public:
 
     /** Construct an empty buffer of size zero */
@@ -82,6 +98,9 @@ public:
         swap(_position, rhs._position);
         swap(_limit, rhs._limit);
         swap(_storage, rhs._storage);
+        swap(_chain, rhs._chain);
+        swap(_chained, rhs._chained);
+        swap(_onOverflow, rhs._onOverflow);
 
         return *this;
     }
@@ -110,6 +129,22 @@ public:
      */
     size_type capacity() const noexcept { return _storage.size(); }
 
+    /**
+     * Give up ownership of the underlying storage.
+     * This buffer is left empty, with zero capacity; the written content
+     * stays at the front of the returned storage.
+     *
+     * @return The storage this buffer was writing into.
+     */
+    MemoryBuffer moveStorage() noexcept {
+        MemoryBuffer result(std::move(_storage));
+        _storage = MemoryBuffer{};
+        _position = 0;
+        _limit = 0;
+
+        return result;
+    }
+
     /** Return data read/write limit of this buffer.
      * For write buffer this is the maximum number of bytes this buffer can hold.
      * For read buffer this is number of bytes that can be read from this buffer.
@@ -173,10 +208,13 @@ public:
 
     /**
      * Set the limit to the capacity and the position to zero.
+     * Buffers chained by an overflow handler are released.
      */
     WriteBuffer& clear() noexcept {
         _position = 0;
         _limit = capacity();
+        _chain.clear();
+        _chained = 0;
 
         return *this;
     }
@@ -209,6 +247,45 @@ public:
     }
 
 
+    /**
+     * Install an overflow handler, turning overruns into spills.
+     *
+     * With a handler set, a write that does not fit fills the current buffer
+     * to its limit, retires it into an internal chain, continues into the
+     * buffer the handler supplies, and succeeds. That lets an encoder write
+     * optimistically into an average-sized buffer instead of sizing every
+     * buffer for the worst case; the occasional oversized message grows a
+     * chain instead of failing. Collect the output with forEachChunk().
+     *
+     * If the handler returns none the write fails as it would without one;
+     * bytes already spilled into earlier chunks stay written.
+     *
+     * @param handler Supplier of the next buffer, or an empty function to
+     *  restore the fail-on-overflow behaviour.
+     * @return A reference to this for fluency.
+     */
+    WriteBuffer& onOverflow(OverflowHandler handler) noexcept {
+        _onOverflow = std::move(handler);
+
+        return *this;
+    }
+
+    /** Total number of bytes written, across all chained buffers. */
+    size_type totalWritten() const noexcept { return _chained + position(); }
+
+    /** Number of buffers holding written bytes: retired chunks plus the current one. */
+    size_type chunkCount() const noexcept { return _chain.size() + 1; }
+
+    /**
+     * Visit the written bytes of every chained buffer in write order,
+     * ending with the current buffer - e.g. to gather them into iovecs.
+     * The last view is empty if nothing was written since the last spill.
+     *
+     * @param f Callback invoked with a view over each chunk's written bytes.
+     * @return A reference to this for fluency.
+     */
+    WriteBuffer const& forEachChunk(std::function<void(ImmutableMemoryView)> const& f) const;
+
     /**
      * Write given raw bytes into this buffer.
      * @param data Raw bytes data to write.
@@ -258,16 +335,190 @@ public:
     Result<void, Error> writeBE(int64 value) { return writeBE(static_cast<uint64>(value)); }
     Result<void, Error> writeBE(uint64 value);
 
+    /**
+     * Encode an array of fixed-width integers in one go.
+     * The whole batch is covered by a single bounds check and the byte-order
+     * conversion is one tight pass over the array that compilers vectorize,
+     * instead of a position update and limit check per element.
+     *
+     * @param src Array of count elements to encode.
+     * @param count Number of elements to encode.
+     * @return Nothing if successfull or an error.
+     */
+    Result<void, Error> writeLE(uint16 const* src, size_type count);
+    Result<void, Error> writeLE(uint32 const* src, size_type count);
+    Result<void, Error> writeLE(uint64 const* src, size_type count);
+    Result<void, Error> writeLE(int16 const* src, size_type count) {
+        return writeLE(reinterpret_cast<uint16 const*>(src), count);
+    }
+    Result<void, Error> writeLE(int32 const* src, size_type count) {
+        return writeLE(reinterpret_cast<uint32 const*>(src), count);
+    }
+    Result<void, Error> writeLE(int64 const* src, size_type count) {
+        return writeLE(reinterpret_cast<uint64 const*>(src), count);
+    }
+
+    Result<void, Error> writeBE(uint16 const* src, size_type count);
+    Result<void, Error> writeBE(uint32 const* src, size_type count);
+    Result<void, Error> writeBE(uint64 const* src, size_type count);
+    Result<void, Error> writeBE(int16 const* src, size_type count) {
+        return writeBE(reinterpret_cast<uint16 const*>(src), count);
+    }
+    Result<void, Error> writeBE(int32 const* src, size_type count) {
+        return writeBE(reinterpret_cast<uint32 const*>(src), count);
+    }
+    Result<void, Error> writeBE(int64 const* src, size_type count) {
+        return writeBE(reinterpret_cast<uint64 const*>(src), count);
+    }
+
+    /**
+     * Encode an integer as a base-128 varint (LEB128, as used by protobuf).
+     * Values below 128 take a single byte; a 64-bit value takes at most 10.
+     *
+     * @param value Integer to encode.
+     * @return Nothing if successfull or an error if the buffer lacks the space.
+     */
+    Result<void, Error> writeVarint(uint64 value);
+
+    Result<void, Error> writeVarint(uint32 value) { return writeVarint(static_cast<uint64>(value)); }
+
+    /**
+     * Encode a signed integer as a zig-zag varint, so that small negative
+     * values stay short on the wire.
+     */
+    Result<void, Error> writeVarint(int64 value) {
+        return writeVarint((static_cast<uint64>(value) << 1) ^ ((value < 0) ? ~static_cast<uint64>(0) : 0));
+    }
+
+    Result<void, Error> writeVarint(int32 value) { return writeVarint(static_cast<int64>(value)); }
+
+    /**
+     * Encode a fixed sequence of mixed-width integer fields in one go.
+     * The field list describes a wire-format struct: all fields are bounds
+     * checked as one unit, so a multi-field message header costs a single
+     * limit check instead of one per field.
+     *
+     * @return Nothing if successfull or an error; no field is written on error.
+     */
+    template<typename T, typename U, typename... Fields>
+    std::enable_if_t<allIntegral<T, U, Fields...>::value, Result<void, Error>>
+    writeLE(T first, U second, Fields... rest) {
+        if (remaining() < fieldsSize<T, U, Fields...>()) {
+            if (!_onOverflow) {
+                return Err(Error("OverflowError: writeLE(fields): no space left in the buffer"));
+            }
+
+            return spillLE(first, second, rest...);
+        }
+
+        encodeLE(first, second, rest...);
+
+        return Ok();
+    }
+
+    template<typename T, typename U, typename... Fields>
+    std::enable_if_t<allIntegral<T, U, Fields...>::value, Result<void, Error>>
+    writeBE(T first, U second, Fields... rest) {
+        if (remaining() < fieldsSize<T, U, Fields...>()) {
+            if (!_onOverflow) {
+                return Err(Error("OverflowError: writeBE(fields): no space left in the buffer"));
+            }
+
+            return spillBE(first, second, rest...);
+        }
+
+        encodeBE(first, second, rest...);
+
+        return Ok();
+    }
+
 protected:
 
+    //!< Codec encodes whole runs of fixed fields under one bounds check:
+    template<typename F>
+    friend struct WireFieldOps;
+
     Result<void, Error> write(void const* bytes, size_type count);
 
+    /** Cold path of write(): fill what fits, chain handler-supplied buffers for the rest. */
+    Result<void, Error> spill(byte const* bytes, size_type count);
+
+    /** Write an array of integers converting every element to the opposite byte order. */
+    template<typename T>
+    Result<void, Error> writeSwabbed(T const* src, size_type count);
+
+    template<typename T>
+    static constexpr size_type fieldsSize() noexcept { return sizeof(T); }
+
+    template<typename T, typename U, typename... Fields>
+    static constexpr size_type fieldsSize() noexcept { return sizeof(T) + fieldsSize<U, Fields...>(); }
+
+    /** Encode one field at the current position. Caller has checked the bounds. */
+    template<typename T>
+    void putUnchecked(T value) noexcept {
+        memcpy(_storage.view().dataAddress(_position), &value, sizeof(T));
+        _position += sizeof(T);
+    }
+
+    void encodeLE() noexcept {}
+
+    template<typename T, typename... Fields>
+    void encodeLE(T field, Fields... rest) noexcept {
+        putUnchecked(isBigendian() ? byteSwap(field) : field);
+
+        encodeLE(rest...);
+    }
+
+    void encodeBE() noexcept {}
+
+    template<typename T, typename... Fields>
+    void encodeBE(T field, Fields... rest) noexcept {
+        putUnchecked(isBigendian() ? field : byteSwap(field));
+
+        encodeBE(rest...);
+    }
+
+    /** Field-batch cold path: encode field by field so each may spill. */
+    Result<void, Error> spillLE() { return Ok(); }
+
+    template<typename T, typename... Fields>
+    Result<void, Error> spillLE(T field, Fields... rest) {
+        auto result = writeLE(field);
+        if (!result) {
+            return result;
+        }
+
+        return spillLE(rest...);
+    }
+
+    Result<void, Error> spillBE() { return Ok(); }
+
+    template<typename T, typename... Fields>
+    Result<void, Error> spillBE(T field, Fields... rest) {
+        auto result = writeBE(field);
+        if (!result) {
+            return result;
+        }
+
+        return spillBE(rest...);
+    }
+
 private:
 
+    /** One retired link of the spill chain: a full buffer and how much of it was written. */
+    struct Chunk {
+        Storage     storage;
+        size_type   written;
+    };
+
     size_type           _position{};
     size_type           _limit{};
 
     Storage             _storage;
+
+    std::vector<Chunk>  _chain;         //!< Buffers retired by spilling writes, in write order.
+    size_type           _chained{};     //!< Total bytes written into retired buffers.
+    OverflowHandler     _onOverflow;    //!< Optional supplier of the next buffer on overrun.
 };
 
 
@@ -21,63 +21,63 @@
  *	ID:			$Id: $
  ******************************************************************************/
 #include "solace/assert.hpp"
+#include "solace/counters.hpp"
 #include "solace/exception.hpp"
+#include "solace/io/traceRing.hpp"
+
+#include <atomic>
 
 
 using namespace Solace;
 
-uint16
-Solace::assertIndexInRange(uint16 index, uint16 from, uint16 to) {
-    if (index >= to || index < from) {
-        Solace::raise<IndexOutOfRangeException>(index, from, to);
-    }
 
-    return index;
-}
+namespace {
 
+StatsCounter gIndexViolations;
+StatsCounter gNullViolations;
 
-uint32
-Solace::assertIndexInRange(uint32 index, uint32 from, uint32 to) {
-    if (index >= to || index < from) {
-        Solace::raise<IndexOutOfRangeException>(index, from, to);
-    }
+std::atomic<IO::TraceRing*> gTraceSink {nullptr};
 
-    return index;
+}  // namespace
+
+
+AssertStats Solace::assertViolations() noexcept {
+    return { gIndexViolations.value(), gNullViolations.value() };
 }
 
-uint64 Solace::assertIndexInRange(uint64 index, uint64 from, uint64 to) {
-    if (index >= to || index < from) {
-        Solace::raise<IndexOutOfRangeException>(index, from, to);
-    }
 
-    return index;
+void Solace::setAssertTraceSink(IO::TraceRing* sink) noexcept {
+    gTraceSink.store(sink, std::memory_order_release);
 }
 
 
-uint64 Solace::assertIndexInRange(uint64 index, uint64 from, uint64 to, const char* message) {
-    if (index >= to || index < from) {
-        Solace::raise<IndexOutOfRangeException>(index, from, to, message);
-    }
+void Solace::noteIndexOutOfRange(uint64 index, uint64 /*from*/, uint64 to) noexcept {
+    gIndexViolations.add();
 
-    return index;
+    if (auto* sink = gTraceSink.load(std::memory_order_acquire)) {
+        sink->record(AssertTraceEvents::kIndexOutOfRange, index, to);
+    }
 }
 
-uint32 Solace::assertIndexInRange(uint32 index, uint32 from, uint32 to, const char* message) {
-    if (index >= to || index < from) {
-        Solace::raise<IndexOutOfRangeException>(index, from, to, message);
+
+void Solace::noteNullPointer() noexcept {
+    gNullViolations.add();
+
+    if (auto* sink = gTraceSink.load(std::memory_order_acquire)) {
+        sink->record(AssertTraceEvents::kNullPointer);
     }
+}
 
-    return index;
+void Solace::raiseIndexOutOfRange(uint64 index, uint64 from, uint64 to) {
+    Solace::raise<IndexOutOfRangeException>(index, from, to);
 }
 
-uint16 Solace::assertIndexInRange(uint16 index, uint16 from, uint16 to, const char* message) {
-    if (index >= to || index < from) {
-        Solace::raise<IndexOutOfRangeException>(index, from, to, message);
-    }
 
-    return index;
+void Solace::raiseIndexOutOfRange(uint64 index, uint64 from, uint64 to, const char* message) {
+    Solace::raise<IndexOutOfRangeException>(index, from, to, message);
 }
 
+
 void Solace::raiseInvalidStateError() {
     Solace::raise<NoSuchElementException>("None");
 }
@@ -93,8 +93,15 @@ const void* Solace::assertNotNull(const void* ptr) {
 
 
 const void* Solace::assertNotNull(const void* ptr, const char* message) {
+#if defined(SOLACE_ASSERT_COUNT_VIOLATIONS)
+    static_cast<void>(message);
+    if (SOLACE_UNLIKELY(ptr == nullptr)) {
+        noteNullPointer();
+    }
+#else
     if (ptr == nullptr)
         Solace::raise<Exception>(message);
+#endif
 
     return ptr;
 }
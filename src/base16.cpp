@@ -224,3 +224,132 @@ Base16Decoded_Iterator::operator++ () {
 
     return *this;
 }
+
+
+Result<void, Error>
+Base16StreamDecoder::encode(ImmutableMemoryView const& src) {
+    auto& dest = *getDestBuffer();
+
+    for (auto c : src) {
+        auto value = charToBin(c);
+        if (!value) {
+            return Err(value.moveError());
+        }
+
+        if (!_hasCarry) {
+            _carry = value.unwrap();
+            _hasCarry = true;
+            continue;
+        }
+
+        _hasCarry = false;
+        auto res = dest.write(static_cast<byte>((_carry << 4) | value.unwrap()));
+        if (!res)
+            return Err(res.moveError());
+    }
+
+    return Ok();
+}
+
+
+/* 256-entry variant of kHexToBin so bulk decode can index with any byte value
+ * without a range check; invalid characters map to -1 and poison the block's
+ * accumulated validity, which is tested once per 16 characters.
+ */
+static const signed char kHexToBinFull[256] = {
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+          0,  1,  2,  3,  4,  5,  6,  7,  8,  9, -1, -1, -1, -1, -1, -1,  // 0..9
+         -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // A..F
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, 10, 11, 12, 13, 14, 15, -1, -1, -1, -1, -1, -1, -1, -1, -1,  // a..f
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,  //
+         -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1   //
+};
+
+
+Result<MemoryView::size_type, Error>
+Solace::base16Encode(ImmutableMemoryView src, MemoryView dest) {
+    if (dest.size() < 2 * src.size()) {
+        return Err(Error("Failed to encode base16: destination is too small"));
+    }
+
+    auto const* in = src.dataAddress();
+    auto* out = dest.dataAddress();
+
+    // Main loop: 16 input bytes -> 32 characters per iteration.
+    MemoryView::size_type i = 0;
+    for (; i + 16 <= src.size(); i += 16) {
+        for (int j = 0; j < 16; ++j) {
+            out[0] = kBase16Alphabet_l[in[j]][0];
+            out[1] = kBase16Alphabet_l[in[j]][1];
+            out += 2;
+        }
+        in += 16;
+    }
+
+    for (; i < src.size(); ++i) {
+        out[0] = kBase16Alphabet_l[*in][0];
+        out[1] = kBase16Alphabet_l[*in][1];
+        in += 1;
+        out += 2;
+    }
+
+    return Ok(2 * src.size());
+}
+
+
+Result<MemoryView::size_type, Error>
+Solace::base16Decode(ImmutableMemoryView src, MemoryView dest) {
+    if (src.size() % 2 != 0) {
+        return Err(Error("Failed to decode base16: input length is not even"));
+    }
+
+    auto const decodedSize = src.size() / 2;
+    if (dest.size() < decodedSize) {
+        return Err(Error("Failed to decode base16: destination is too small"));
+    }
+
+    auto const* in = src.dataAddress();
+    auto* out = dest.dataAddress();
+
+    // Main loop: 16 characters -> 8 bytes, one validity branch per block.
+    MemoryView::size_type i = 0;
+    for (; i + 16 <= src.size(); i += 16) {
+        int poison = 0;
+        for (int j = 0; j < 8; ++j) {
+            int const hi = kHexToBinFull[in[2*j]];
+            int const lo = kHexToBinFull[in[2*j + 1]];
+            poison |= hi | lo;
+            out[j] = static_cast<byte>((hi << 4) | (lo & 0x0F));
+        }
+
+        if (poison < 0) {
+            return Err(Error("Failed to decode base16 string: value is not in base16 alphabet"));
+        }
+
+        in += 16;
+        out += 8;
+    }
+
+    for (; i < src.size(); i += 2) {
+        int const hi = kHexToBinFull[in[0]];
+        int const lo = kHexToBinFull[in[1]];
+        if ((hi | lo) < 0) {
+            return Err(Error("Failed to decode base16 string: value is not in base16 alphabet"));
+        }
+
+        *out++ = static_cast<byte>((hi << 4) | lo);
+        in += 2;
+    }
+
+    return Ok(decodedSize);
+}
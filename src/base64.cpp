@@ -19,12 +19,18 @@
  *	@brief		Implementation of Base64 encoder and decoder.
  ******************************************************************************/
 #include "solace/base64.hpp"
+#include "solace/cpuFeatures.hpp"
 #include "solace/exception.hpp"
 
 
 #include <cstring>  // memcpy
 #include <limits>
 
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define SOLACE_BASE64_SIMD 1
+#include <immintrin.h>
+#endif
+
 
 using namespace Solace;
 
@@ -219,3 +225,406 @@ Result<void, Error>
 Base64UrlDecoder::encode(ImmutableMemoryView const& src) {
     return base64decode(*getDestBuffer(), src, prUrl2six);
 }
+
+
+/* ---------------------------------------------------------------------------
+ * Streaming encoder / decoder
+ * ------------------------------------------------------------------------ */
+
+static void encodeGroupsScalar(byte const* src, size_t groups, byte* out) {
+    for (size_t i = 0; i < groups; ++i) {
+        out[0] = kBase64Alphabet[ (src[0] >> 2) & 0x3F];
+        out[1] = kBase64Alphabet[((src[0] & 0x3) << 4) | (static_cast<int>(src[1] & 0xF0) >> 4)];
+        out[2] = kBase64Alphabet[((src[1] & 0xF) << 2) | (static_cast<int>(src[2] & 0xC0) >> 6)];
+        out[3] = kBase64Alphabet[  src[2] & 0x3F];
+
+        src += 3;
+        out += 4;
+    }
+}
+
+
+#ifdef SOLACE_BASE64_SIMD
+
+/* Shuffle-based kernels after Wojciech Mula's base64 work: split each 3-byte
+ * group into four 6-bit indices with multiplies instead of per-byte shifts,
+ * then translate indices to ASCII with a single pshufb against an offset LUT.
+ * Each kernel consumes as many whole groups as it can while a full register
+ * load stays inside the input, and reports how many bytes it consumed; the
+ * scalar loop finishes the tail.
+ */
+
+__attribute__((target("ssse3")))
+static size_t encodeGroupsSsse3(byte const* src, size_t srcLen, byte* out) {
+    const __m128i gatherShuffle = _mm_set_epi8(10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m128i shiftLut = _mm_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    size_t consumed = 0;
+    while (consumed + 16 <= srcLen) {  // Loads 16 bytes, consumes 12.
+        __m128i in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + consumed));
+        in = _mm_shuffle_epi8(in, gatherShuffle);
+
+        const __m128i t0 = _mm_and_si128(in, _mm_set1_epi32(0x0fc0fc00));
+        const __m128i t1 = _mm_mulhi_epu16(t0, _mm_set1_epi32(0x04000040));
+        const __m128i t2 = _mm_and_si128(in, _mm_set1_epi32(0x003f03f0));
+        const __m128i t3 = _mm_mullo_epi16(t2, _mm_set1_epi32(0x01000010));
+        const __m128i indices = _mm_or_si128(t1, t3);
+
+        __m128i offsets = _mm_subs_epu8(indices, _mm_set1_epi8(51));
+        const __m128i isLetter = _mm_cmpgt_epi8(_mm_set1_epi8(26), indices);
+        offsets = _mm_or_si128(offsets, _mm_and_si128(isLetter, _mm_set1_epi8(13)));
+        offsets = _mm_shuffle_epi8(shiftLut, offsets);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out), _mm_add_epi8(offsets, indices));
+
+        out += 16;
+        consumed += 12;
+    }
+
+    return consumed;
+}
+
+
+__attribute__((target("avx2")))
+static size_t encodeGroupsAvx2(byte const* src, size_t srcLen, byte* out) {
+    const __m256i gatherShuffle = _mm256_set_epi8(
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1,
+        10, 11, 9, 10, 7, 8, 6, 7, 4, 5, 3, 4, 1, 2, 0, 1);
+    const __m256i shiftLut = _mm256_setr_epi8(
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0,
+        'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+        '0' - 52, '0' - 52, '0' - 52, '0' - 52, '+' - 62, '/' - 63, 'A', 0, 0);
+
+    size_t consumed = 0;
+    while (consumed + 32 <= srcLen) {  // Loads two 16-byte lanes, consumes 24.
+        const __m128i lo = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + consumed));
+        const __m128i hi = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + consumed + 12));
+        __m256i in = _mm256_set_m128i(hi, lo);
+        in = _mm256_shuffle_epi8(in, gatherShuffle);
+
+        const __m256i t0 = _mm256_and_si256(in, _mm256_set1_epi32(0x0fc0fc00));
+        const __m256i t1 = _mm256_mulhi_epu16(t0, _mm256_set1_epi32(0x04000040));
+        const __m256i t2 = _mm256_and_si256(in, _mm256_set1_epi32(0x003f03f0));
+        const __m256i t3 = _mm256_mullo_epi16(t2, _mm256_set1_epi32(0x01000010));
+        const __m256i indices = _mm256_or_si256(t1, t3);
+
+        __m256i offsets = _mm256_subs_epu8(indices, _mm256_set1_epi8(51));
+        const __m256i isLetter = _mm256_cmpgt_epi8(_mm256_set1_epi8(26), indices);
+        offsets = _mm256_or_si256(offsets, _mm256_and_si256(isLetter, _mm256_set1_epi8(13)));
+        offsets = _mm256_shuffle_epi8(shiftLut, offsets);
+
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(out), _mm256_add_epi8(offsets, indices));
+
+        out += 32;
+        consumed += 24;
+    }
+
+    return consumed;
+}
+
+
+static size_t encodeGroupsNone(byte const*, size_t, byte*) {
+    return 0;
+}
+
+
+static size_t encodeGroupsSimd(byte const* src, size_t srcLen, byte* out) {
+    using Kernel = size_t (*)(byte const*, size_t, byte*);
+
+    static const Kernel kernel = cpuFeatures().avx2  ? encodeGroupsAvx2
+                               : cpuFeatures().ssse3 ? encodeGroupsSsse3
+                                                     : encodeGroupsNone;
+
+    return kernel(src, srcLen, out);
+}
+
+
+/* Decode kernels, also after Mula: classify each character by nibble pair
+ * against a pair of LUTs - one pshufb each - which both validates the block
+ * and yields the offset that rolls ASCII back to a sextet; then two multiply-
+ * adds pack four sextets into three bytes. A block that fails validation -
+ * whitespace, padding or garbage - stops the kernel and is left for the
+ * scalar loop to skip or reject one character at a time. Stores run 16 bytes
+ * wide, so the output buffer needs 4 bytes of slack past the last group.
+ */
+
+__attribute__((target("ssse3")))
+static size_t decodeBlocksSsse3(byte const* src, size_t srcLen, byte* out, size_t outCap, size_t* outLen) {
+    const __m128i lutLo = _mm_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m128i lutHi = _mm_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m128i lutRoll = _mm_setr_epi8(0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m128i packShuffle = _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    size_t consumed = 0;
+    size_t produced = 0;
+    while (consumed + 16 <= srcLen && produced + 16 <= outCap) {  // Consumes 16 chars, stores 16, 12 of them payload.
+        const __m128i in = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + consumed));
+
+        const __m128i hiNibbles = _mm_and_si128(_mm_srli_epi16(in, 4), _mm_set1_epi8(0x0f));
+        const __m128i loNibbles = _mm_and_si128(in, _mm_set1_epi8(0x0f));
+        const __m128i lo = _mm_shuffle_epi8(lutLo, loNibbles);
+        const __m128i hi = _mm_shuffle_epi8(lutHi, hiNibbles);
+
+        if (_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_and_si128(lo, hi), _mm_setzero_si128())) != 0) {
+            break;  // Something other than an alphabet character in this block.
+        }
+
+        const __m128i eqSlash = _mm_cmpeq_epi8(in, _mm_set1_epi8(0x2f));
+        const __m128i roll = _mm_shuffle_epi8(lutRoll, _mm_add_epi8(eqSlash, hiNibbles));
+        const __m128i sextets = _mm_add_epi8(in, roll);
+
+        const __m128i merged = _mm_maddubs_epi16(sextets, _mm_set1_epi32(0x01400140));
+        const __m128i packed = _mm_madd_epi16(merged, _mm_set1_epi32(0x00011000));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + produced),
+                         _mm_shuffle_epi8(packed, packShuffle));
+
+        consumed += 16;
+        produced += 12;
+    }
+
+    *outLen = produced;
+    return consumed;
+}
+
+
+__attribute__((target("avx2")))
+static size_t decodeBlocksAvx2(byte const* src, size_t srcLen, byte* out, size_t outCap, size_t* outLen) {
+    const __m256i lutLo = _mm256_setr_epi8(
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+        0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11,
+        0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A);
+    const __m256i lutHi = _mm256_setr_epi8(
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+        0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08,
+        0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10);
+    const __m256i lutRoll = _mm256_setr_epi8(
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0,
+        0, 16, 19, 4, -65, -65, -71, -71, 0, 0, 0, 0, 0, 0, 0, 0);
+    const __m256i packShuffle = _mm256_setr_epi8(
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1,
+        2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1);
+
+    size_t consumed = 0;
+    size_t produced = 0;
+    while (consumed + 32 <= srcLen && produced + 28 <= outCap) {  // Consumes 32 chars, stores two 16-byte lanes.
+        const __m256i in = _mm256_loadu_si256(reinterpret_cast<__m256i const*>(src + consumed));
+
+        const __m256i hiNibbles = _mm256_and_si256(_mm256_srli_epi16(in, 4), _mm256_set1_epi8(0x0f));
+        const __m256i loNibbles = _mm256_and_si256(in, _mm256_set1_epi8(0x0f));
+        const __m256i lo = _mm256_shuffle_epi8(lutLo, loNibbles);
+        const __m256i hi = _mm256_shuffle_epi8(lutHi, hiNibbles);
+
+        if (_mm256_movemask_epi8(_mm256_cmpgt_epi8(_mm256_and_si256(lo, hi), _mm256_setzero_si256())) != 0) {
+            break;  // Something other than an alphabet character in this block.
+        }
+
+        const __m256i eqSlash = _mm256_cmpeq_epi8(in, _mm256_set1_epi8(0x2f));
+        const __m256i roll = _mm256_shuffle_epi8(lutRoll, _mm256_add_epi8(eqSlash, hiNibbles));
+        const __m256i sextets = _mm256_add_epi8(in, roll);
+
+        const __m256i merged = _mm256_maddubs_epi16(sextets, _mm256_set1_epi32(0x01400140));
+        const __m256i packed = _mm256_madd_epi16(merged, _mm256_set1_epi32(0x00011000));
+        const __m256i shuffled = _mm256_shuffle_epi8(packed, packShuffle);
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + produced), _mm256_castsi256_si128(shuffled));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(out + produced + 12), _mm256_extracti128_si256(shuffled, 1));
+
+        consumed += 32;
+        produced += 24;
+    }
+
+    *outLen = produced;
+    return consumed;
+}
+
+
+static size_t decodeBlocksNone(byte const*, size_t, byte*, size_t, size_t* outLen) {
+    *outLen = 0;
+    return 0;
+}
+
+
+static size_t decodeBlocksSimd(byte const* src, size_t srcLen, byte* out, size_t outCap, size_t* outLen) {
+    using Kernel = size_t (*)(byte const*, size_t, byte*, size_t, size_t*);
+
+    static const Kernel kernel = cpuFeatures().avx2  ? decodeBlocksAvx2
+                               : cpuFeatures().ssse3 ? decodeBlocksSsse3
+                                                     : decodeBlocksNone;
+
+    return kernel(src, srcLen, out, outCap, outLen);
+}
+
+#endif  // SOLACE_BASE64_SIMD
+
+
+Result<void, Error>
+Base64StreamEncoder::encode(ImmutableMemoryView const& src) {
+    auto& dest = *getDestBuffer();
+    size_type pos = 0;
+
+    // Top the carry up to a whole group first:
+    if (_carrySize > 0) {
+        while (_carrySize < 3 && pos < src.size()) {
+            _carry[_carrySize++] = src[pos++];
+        }
+
+        if (_carrySize < 3) {
+            return Ok();
+        }
+
+        byte encoded[4];
+        encodeGroupsScalar(_carry, 1, encoded);
+        _carrySize = 0;
+
+        auto res = dest.write(wrapMemory(encoded));
+        if (!res)
+            return Err(res.moveError());
+    }
+
+    // Bulk: transform whole groups through a staging buffer, one write per chunk.
+    byte staging[4096];
+    while (src.size() - pos >= 3) {
+        auto const groups = std::min<size_t>((src.size() - pos) / 3, sizeof(staging) / 4);
+        auto const chunkLen = groups * 3;
+
+        size_t done = 0;
+#ifdef SOLACE_BASE64_SIMD
+        done = encodeGroupsSimd(src.dataAddress() + pos, chunkLen, staging);
+#endif
+        encodeGroupsScalar(src.dataAddress() + pos + done, (chunkLen - done) / 3,
+                           staging + (done / 3) * 4);
+
+        auto res = dest.write(wrapMemory(staging, groups * 4));
+        if (!res)
+            return Err(res.moveError());
+
+        pos += chunkLen;
+    }
+
+    // Remember the incomplete tail group for the next chunk:
+    while (pos < src.size()) {
+        _carry[_carrySize++] = src[pos++];
+    }
+
+    return Ok();
+}
+
+
+Result<void, Error>
+Base64StreamEncoder::finalize() {
+    if (_carrySize == 0) {
+        return Ok();
+    }
+
+    byte encoded[4];
+    encoded[0] = kBase64Alphabet[(_carry[0] >> 2) & 0x3F];
+    if (_carrySize == 1) {
+        encoded[1] = kBase64Alphabet[((_carry[0] & 0x3) << 4)];
+        encoded[2] = '=';
+    } else {
+        encoded[1] = kBase64Alphabet[((_carry[0] & 0x3) << 4) | (static_cast<int>(_carry[1] & 0xF0) >> 4)];
+        encoded[2] = kBase64Alphabet[((_carry[1] & 0xF) << 2)];
+    }
+    encoded[3] = '=';
+    _carrySize = 0;
+
+    auto res = getDestBuffer()->write(wrapMemory(encoded));
+    if (!res)
+        return Err(res.moveError());
+
+    return Ok();
+}
+
+
+Result<void, Error>
+Base64StreamDecoder::encode(ImmutableMemoryView const& src) {
+    auto& dest = *getDestBuffer();
+    size_type pos = 0;
+
+    while (pos < src.size()) {
+#ifdef SOLACE_BASE64_SIMD
+        // Bulk: clean whole blocks decode in-register, straight off the input.
+        // The first block with whitespace, padding or garbage in it stops the
+        // kernel and drops through to the per-character loop below.
+        if (_carrySize == 0) {
+            byte staging[4096];
+            size_t produced = 0;
+            auto const consumed = decodeBlocksSimd(src.dataAddress() + pos, src.size() - pos,
+                                                   staging, sizeof(staging), &produced);
+            if (consumed > 0) {
+                auto res = dest.write(wrapMemory(staging, produced));
+                if (!res)
+                    return Err(res.moveError());
+
+                pos += consumed;
+                continue;
+            }
+        }
+#endif
+
+        auto const c = src[pos++];
+        auto const sextet = pr2six[c];
+        if (sextet > 63) {
+            if (c == '=') {
+                continue;
+            }
+
+            if (_whitespace == Whitespace::Skip
+                && (c == ' ' || c == '\t' || c == '\r' || c == '\n')) {
+                continue;
+            }
+
+            return Err(Error("Base64Decoding error: character is not in base64 alphabet"));
+        }
+
+        _carry[_carrySize++] = sextet;
+        if (_carrySize < 4) {
+            continue;
+        }
+
+        byte const decoded[] = {
+            static_cast<byte>(_carry[0] << 2 | _carry[1] >> 4),
+            static_cast<byte>(_carry[1] << 4 | _carry[2] >> 2),
+            static_cast<byte>(_carry[2] << 6 | _carry[3])
+        };
+        _carrySize = 0;
+
+        auto res = dest.write(wrapMemory(decoded));
+        if (!res)
+            return Err(res.moveError());
+    }
+
+    return Ok();
+}
+
+
+Result<void, Error>
+Base64StreamDecoder::finalize() {
+    auto& dest = *getDestBuffer();
+    auto const carrySize = _carrySize;
+    _carrySize = 0;
+
+    /* Note: (carrySize == 1) would be an error, so just ignore that case */
+    if (carrySize > 1) {
+        auto res = dest.write(static_cast<byte>(_carry[0] << 2 | _carry[1] >> 4));
+        if (!res)
+            return Err(res.moveError());
+    }
+    if (carrySize > 2) {
+        auto res = dest.write(static_cast<byte>(_carry[1] << 4 | _carry[2] >> 2));
+        if (!res)
+            return Err(res.moveError());
+    }
+
+    return Ok();
+}
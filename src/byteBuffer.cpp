@@ -23,6 +23,7 @@
  ******************************************************************************/
 #include "solace/byteBuffer.hpp"
 #include "solace/exception.hpp"
+#include "solace/telemetry.hpp"
 
 
 #include <cstring>  // memcpy
@@ -32,6 +33,83 @@ using namespace Solace;
 
 
 
+namespace /* anonymous */ {
+
+bool sameName(std::string const& lhs, StringView rhs) noexcept {
+    return StringView(lhs.data(), static_cast<StringView::size_type>(lhs.size())).equals(rhs);
+}
+
+}  // namespace
+
+
+ByteBuffer& ByteBuffer::mark(StringView name) {
+    for (auto& existing : _marks) {
+        if (sameName(existing.name, name)) {
+            existing.savedPosition = position();
+
+            return *this;
+        }
+    }
+
+    _marks.push_back(Mark{std::string(name.data(), name.size()), position()});
+
+    return *this;
+}
+
+
+Result<void, Error>
+ByteBuffer::restore(StringView name) {
+    for (auto const& existing : _marks) {
+        if (sameName(existing.name, name)) {
+            if (existing.savedPosition < _consumed) {
+                return Err<Error>(StringView("OverflowError: restore(): mark points into consumed bytes"));
+            }
+
+            return position(existing.savedPosition);
+        }
+    }
+
+    return Err<Error>(StringView("OverflowError: restore(): no such mark"));
+}
+
+
+Optional<ByteBuffer::size_type>
+ByteBuffer::markPosition(StringView name) const noexcept {
+    for (auto const& existing : _marks) {
+        if (sameName(existing.name, name)) {
+            return Optional<size_type>(existing.savedPosition);
+        }
+    }
+
+    return none;
+}
+
+
+bool ByteBuffer::dropMark(StringView name) noexcept {
+    for (auto it = _marks.begin(); it != _marks.end(); ++it) {
+        if (sameName(it->name, name)) {
+            _marks.erase(it);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+Result<void, Error>
+ByteBuffer::consume(size_type count) {
+    if (unconsumed() < count) {
+        return Err<Error>(StringView("OverflowError: consume(): watermark pass the current position."));
+    }
+
+    _consumed += count;
+
+    return Ok();
+}
+
+
 MemoryView ByteBuffer::viewRemaining() {
     auto destAddr = _storage.view().dataAddress(position());
 
@@ -54,6 +132,8 @@ ByteBuffer& ByteBuffer::write(const ImmutableMemoryView& data, size_type bytesTo
          raise<OverflowException>("bytesToWrite", bytesToWrite, 0, data.size());
     }
 
+    SOLACE_TELEMETRY_RECORD(Telemetry::Probe::ByteBufferWriteBytes, bytesToWrite);
+
     return write(data.dataAddress(), bytesToWrite);
 }
 
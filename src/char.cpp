@@ -28,10 +28,65 @@
 
 
 using Solace::byte;
+using Solace::uint16;
+using Solace::uint32;
 using Solace::Char;
 using Solace::ImmutableMemoryView;
 
 
+namespace /* anonymous */ {
+
+/** Class bits of one byte value, matching <cctype> in the "C" locale. */
+constexpr uint16 classifyByte(uint32 c) noexcept {
+    uint16 mask = 0;
+
+    if (c < 0x20 || c == 0x7f)                  { mask |= Char::Control; }
+    if (c == ' ' || (c >= '\t' && c <= '\r'))   { mask |= Char::Whitespace; }
+    if (c >= 'A' && c <= 'Z')                   { mask |= Char::UpperCase; }
+    if (c >= 'a' && c <= 'z')                   { mask |= Char::LowerCase; }
+    if (c >= '0' && c <= '9')                   { mask |= Char::Digit; }
+
+    if ((mask & Char::Digit)
+        || (c >= 'a' && c <= 'f')
+        || (c >= 'A' && c <= 'F'))              { mask |= Char::HexDigit; }
+
+    if (c >= 0x21 && c <= 0x7e) {
+        mask |= Char::Graphical | Char::Printable;
+        if (!(mask & Char::LetterOrDigit))      { mask |= Char::Punctuation; }
+    }
+    if (c == ' ')                               { mask |= Char::Printable; }
+
+    if ((mask & Char::Letter) || c == '_')      { mask |= Char::SymbolStart; }
+    if ((mask & Char::LetterOrDigit) || c == '_') { mask |= Char::Symbol; }
+
+    return mask;
+}
+
+
+struct CharClassTable {
+    uint16 masks[256];
+};
+
+constexpr CharClassTable buildCharClasses() noexcept {
+    CharClassTable table{};
+    for (uint32 c = 0; c < 256; ++c) {
+        table.masks[c] = classifyByte(c);
+    }
+
+    return table;
+}
+
+constexpr CharClassTable kCharClasses = buildCharClasses();
+
+
+/** Class bits of a code point: one table load for byte-range values. */
+uint16 classOf(uint32 value) noexcept {
+    return (value < 256) ? kCharClasses.masks[value] : 0;
+}
+
+}  // namespace
+
+
 const Char Char::Eof {static_cast<value_type>(EOF)};
 
 
@@ -97,48 +152,53 @@ const ImmutableMemoryView Char::getBytes() const {
 }
 
 
+uint16 Char::categoryOf(byte c) noexcept {
+    return kCharClasses.masks[c];
+}
+
+
 bool Char::isDigit() const {
-    return isdigit(_value);
+    return (classOf(_value) & Digit) != 0;
 }
 
 
 bool Char::isXDigit() const {
-    return isxdigit(_value);
+    return (classOf(_value) & HexDigit) != 0;
 }
 
 
 bool Char::isLetter() const {
-    return isalpha(_value);
+    return (classOf(_value) & Letter) != 0;
 }
 
 
 bool Char::isLetterOrDigit() const {
-    return isalnum(_value);
+    return (classOf(_value) & LetterOrDigit) != 0;
 }
 
 
 bool Char::isUpperCase() const {
-    return isupper(_value);
+    return (classOf(_value) & UpperCase) != 0;
 }
 
 
 bool Char::isLowerCase() const {
-    return islower(_value);
+    return (classOf(_value) & LowerCase) != 0;
 }
 
 
 bool Char::isWhitespace() const {
-    return isspace(_value);
+    return (classOf(_value) & Whitespace) != 0;
 }
 
 
 bool Char::isSymbol() const {
-    return (isLetterOrDigit() || ((_bytes[0] == '_') && (_bytes[1] == 0)));
+    return (classOf(_value) & Symbol) != 0;
 }
 
 
 bool Char::isFirstSymbol() const {
-    return (isLetter() || ((_bytes[0] == '_') && (_bytes[1] == 0)));
+    return (classOf(_value) & SymbolStart) != 0;
 }
 
 
@@ -148,22 +208,22 @@ bool Char::isNewLine() const {
 
 
 bool Char::isCntrl() const {
-    return iscntrl(_value);
+    return (classOf(_value) & Control) != 0;
 }
 
 
 bool Char::isGraphical() const {
-    return isgraph(_value);
+    return (classOf(_value) & Graphical) != 0;
 }
 
 
 bool Char::isPrintable() const {
-    return isprint(_value);
+    return (classOf(_value) & Printable) != 0;
 }
 
 
 bool Char::isPunctuation() const {
-    return ispunct(_value);
+    return (classOf(_value) & Punctuation) != 0;
 }
 
 
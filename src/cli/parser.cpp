@@ -336,9 +336,28 @@ Parser::Parser(StringView appDescription, std::initializer_list<Option> options)
 }
 
 
+Array<uint64>
+Parser::Option::hashNames(Array<StringLiteral> const& names) {
+    Array<uint64>::Storage hashes;
+    hashes.reserve(names.size());
+
+    for (const auto& name : names) {
+        hashes.emplace_back(name.hashCode());
+    }
+
+    return Array<uint64>(std::move(hashes));
+}
+
+
 bool Parser::Option::isMatch(StringView name) const noexcept {
-    for (const auto& optName : _names) {
-        if (optName == name) {
+    return isMatch(name, name.hashCode());
+}
+
+
+bool Parser::Option::isMatch(StringView name, uint64 nameHash) const noexcept {
+    const auto count = _names.size();
+    for (Array<StringLiteral>::size_type i = 0; i < count; ++i) {
+        if (_nameHashes[i] == nameHash && _names[i] == name) {
             return true;
         }
     }
@@ -436,8 +455,11 @@ parseOptions(const Parser::Context& cntx,
 
         auto const optCntx = Parser::Context {cntx.argc, cntx.argv, i, argName, cntx.parser};
 
+        // Each token is hashed once; candidate options compare hashes first.
+        auto const argHash = argName.hashCode();
+
         for (auto& option : options) {
-            if (option.isMatch(argName)) {
+            if (option.isMatch(argName, argHash)) {
                 if (argValue.isNone() &&
                     option.getArgumentExpectations() == Parser::OptionArgument::Required) {
                     // Argument is required but none was given, error out!
@@ -0,0 +1,72 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file     counters.cpp
+ *
+ * Wait-free statistics counters.
+*******************************************************************************/
+#include "solace/counters.hpp"
+
+
+using namespace Solace;
+
+
+uint32
+Solace::details::counterShard() noexcept {
+    static std::atomic<uint32> nextOrdinal{0};
+    static thread_local const uint32 ordinal =
+            nextOrdinal.fetch_add(1, std::memory_order_relaxed);
+
+    return ordinal;
+}
+
+
+StatsHistogram::Snapshot
+StatsHistogram::snapshot() const noexcept {
+    Snapshot result{};
+
+    for (const auto& shard : _shards) {
+        result.count += shard.count.load(std::memory_order_relaxed);
+        result.sum += shard.sum.load(std::memory_order_relaxed);
+        for (uint32 b = 0; b < kNbBuckets; ++b) {
+            result.buckets[b] += shard.buckets[b].load(std::memory_order_relaxed);
+        }
+    }
+
+    return result;
+}
+
+
+uint64
+StatsHistogram::Snapshot::quantile(float64 q) const noexcept {
+    if (count == 0) {
+        return 0;
+    }
+
+    const auto rank = static_cast<uint64>(q * static_cast<float64>(count));
+
+    uint64 seen = 0;
+    for (uint32 b = 0; b < kNbBuckets; ++b) {
+        seen += buckets[b];
+        if (seen > rank) {
+            // Upper bound of bucket b: 2^(b+1) - 1, saturating in the last one.
+            return (b + 1 < 64) ? ((static_cast<uint64>(1) << (b + 1)) - 1)
+                                : ~static_cast<uint64>(0);
+        }
+    }
+
+    return ~static_cast<uint64>(0);
+}
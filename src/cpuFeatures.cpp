@@ -0,0 +1,81 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file     cpuFeatures.cpp
+ *
+ * Runtime CPU feature detection.
+*******************************************************************************/
+#include "solace/cpuFeatures.hpp"
+
+#include <cstdlib>      // getenv
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#include <sys/auxv.h>
+#endif
+
+
+using namespace Solace;
+
+
+namespace /* anonymous */ {
+
+CpuFeatures detect() noexcept {
+    CpuFeatures features;
+
+    if (getenv("SOLACE_CPU_BASELINE") != nullptr) {
+        return features;
+    }
+
+#if defined(__GNUC__) && defined(__x86_64__)
+    // __builtin_cpu_supports covers both CPUID and, for the AVX family,
+    // the XGETBV check that the OS actually saves the wider registers.
+    features.ssse3      = __builtin_cpu_supports("ssse3");
+    features.sse41      = __builtin_cpu_supports("sse4.1");
+    features.sse42      = __builtin_cpu_supports("sse4.2");
+    features.avx        = __builtin_cpu_supports("avx");
+    features.avx2       = __builtin_cpu_supports("avx2");
+    features.avx512bw   = __builtin_cpu_supports("avx512bw");
+    features.sha        = __builtin_cpu_supports("sha");
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+    const auto hwcap = getauxval(AT_HWCAP);
+
+#if defined(HWCAP_ASIMD)
+    features.neon   = (hwcap & HWCAP_ASIMD) != 0;
+#endif
+#if defined(HWCAP_CRC32)
+    features.crc32  = (hwcap & HWCAP_CRC32) != 0;
+#endif
+#if defined(HWCAP_SHA2)
+    features.sha2   = (hwcap & HWCAP_SHA2) != 0;
+#endif
+#if defined(HWCAP_AES)
+    features.aes    = (hwcap & HWCAP_AES) != 0;
+#endif
+#endif  // __aarch64__
+
+    return features;
+}
+
+}  // namespace
+
+
+CpuFeatures const& Solace::cpuFeatures() noexcept {
+    static const CpuFeatures features = detect();
+
+    return features;
+}
@@ -0,0 +1,104 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Encoder stage pipeline
+ *	@file		encoderPipeline.cpp
+ ******************************************************************************/
+#include "solace/encoderPipeline.hpp"
+
+
+using namespace Solace;
+
+
+EncoderPipeline::size_type
+EncoderPipeline::chunkEncodedSize(ImmutableMemoryView const& data, size_type chunkLen) const {
+    // Stage estimates are derived from the input length alone, so a view of
+    // the source with the running size stands in for the intermediate data
+    // no stage has produced yet. Never dereferenced; any non-null address
+    // serves for an empty source.
+    auto const* address = (data.dataAddress() != nullptr)
+            ? static_cast<void const*>(data.dataAddress())
+            : static_cast<void const*>(this);
+
+    auto runningSize = chunkLen;
+    for (auto const& stage : _stages) {
+        runningSize = stage.encoder->encodedSize(ImmutableMemoryView{address, runningSize});
+    }
+
+    return runningSize;
+}
+
+
+EncoderPipeline::size_type
+EncoderPipeline::encodedSize(ImmutableMemoryView const& data) const {
+    if (_stages.empty()) {
+        return data.size();
+    }
+
+    const auto nbFullChunks = data.size() / _options.chunkSize;
+    const auto remainder = data.size() % _options.chunkSize;
+
+    auto total = nbFullChunks * chunkEncodedSize(data, _options.chunkSize);
+    if (remainder != 0 || nbFullChunks == 0) {
+        total += chunkEncodedSize(data, remainder);
+    }
+
+    return total;
+}
+
+
+Result<void, Error>
+EncoderPipeline::encode(ImmutableMemoryView const& src) {
+    if (_stages.empty()) {
+        return getDestBuffer()->write(src);
+    }
+
+    const auto total = src.size();
+    size_type offset = 0;
+
+    do {
+        const auto chunkLen = (total - offset < _options.chunkSize)
+                ? total - offset
+                : _options.chunkSize;
+
+        auto current = src.slice(offset, offset + chunkLen);
+
+        for (auto& stage : _stages) {
+            const auto need = stage.encoder->encodedSize(current);
+            if (stage.out->capacity() < need) {
+                *stage.out = WriteBuffer(_allocator->create(need));
+            } else {
+                stage.out->clear();
+            }
+
+            auto transformed = stage.encoder->encode(current);
+            if (!transformed) {
+                return transformed;
+            }
+
+            current = stage.out->viewWritten();
+        }
+
+        auto landed = getDestBuffer()->write(current);
+        if (!landed) {
+            return landed;
+        }
+
+        offset += chunkLen;
+    } while (offset < total);
+
+    return Ok();
+}
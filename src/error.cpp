@@ -22,6 +22,8 @@
  ******************************************************************************/
 #include "solace/error.hpp"
 
+#include <cstring>  // strerror
+
 
 using namespace Solace;
 
@@ -30,3 +32,46 @@ StringView Error::toString() const {
     // FIXME(abbyssoul): This is just a shitty engineering
     return StringView{_message.c_str(), static_cast<StringView::size_type>(_message.size())};
 }
+
+
+ErrorDomain::~ErrorDomain() = default;
+
+
+namespace {
+
+class SystemErrorDomain :
+        public ErrorDomain {
+public:
+
+    StringView name() const noexcept override {
+        return "system";
+    }
+
+    StringView message(int code) const noexcept override {
+        static thread_local char buffer[128];
+
+        return StringView{describe(strerror_r(code, buffer, sizeof(buffer)), buffer)};
+    }
+
+private:
+
+    // The two strerror_r flavours: GNU returns the message pointer, XSI
+    // returns an int and fills the buffer. Overloading on the actual return
+    // type picks the right one without a feature-macro dance.
+    static char const* describe(char const* result, char const*) noexcept { return result; }
+    static char const* describe(int, char const* buffer) noexcept { return buffer; }
+};
+
+const SystemErrorDomain kSystemErrorDomain;
+
+}  // namespace
+
+
+ErrorDomain const& Solace::systemErrorDomain() noexcept {
+    return kSystemErrorDomain;
+}
+
+
+ErrorCode Solace::systemError(int errnoCode) noexcept {
+    return ErrorCode(kSystemErrorDomain, errnoCode);
+}
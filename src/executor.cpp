@@ -0,0 +1,116 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		executor.cpp
+ *	@brief		Implementation of executors
+ ******************************************************************************/
+#include "solace/executor.hpp"
+
+
+using namespace Solace;
+
+
+Executor::~Executor() = default;
+
+
+ThreadPoolExecutor::ThreadPoolExecutor(uint32 nbWorkers) {
+    if (nbWorkers == 0) {
+        const auto hw = std::thread::hardware_concurrency();
+        nbWorkers = (hw > 0) ? hw : 1;
+    }
+
+    _queues.reserve(nbWorkers);
+    for (uint32 i = 0; i < nbWorkers; ++i) {
+        _queues.emplace_back(new MpmcQueue<Task>(kQueueCapacity));
+    }
+
+    _threads.reserve(nbWorkers);
+    for (uint32 i = 0; i < nbWorkers; ++i) {
+        _threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+}
+
+
+ThreadPoolExecutor::~ThreadPoolExecutor() {
+    _stopping.store(true);
+    {   // Pair with the wait in workerLoop so no worker misses the shutdown signal.
+        std::lock_guard<std::mutex> guard(_wakeLock);
+    }
+    _wake.notify_all();
+
+    for (auto& worker : _threads) {
+        worker.join();
+    }
+}
+
+
+void ThreadPoolExecutor::submit(Task task) {
+    const auto nbQueues = _queues.size();
+    const auto start = _submitIndex.fetch_add(1, std::memory_order_relaxed);
+
+    for (size_t attempt = 0; attempt < nbQueues; ++attempt) {
+        // Enqueue a copy so the task survives a full queue: delegate shares
+        // its closure, making the copy a reference-count bump.
+        if (_queues[(start + attempt) % nbQueues]->tryEnqueue(task)) {
+            _pending.fetch_add(1, std::memory_order_release);
+            {
+                std::lock_guard<std::mutex> guard(_wakeLock);
+            }
+            _wake.notify_one();
+
+            return;
+        }
+    }
+
+    // Every queue is full - run on the submitting thread for backpressure.
+    task();
+}
+
+
+bool ThreadPoolExecutor::runOne(uint32 home) {
+    const auto nbQueues = _queues.size();
+
+    Task task;
+    for (size_t attempt = 0; attempt < nbQueues; ++attempt) {
+        if (_queues[(home + attempt) % nbQueues]->tryDequeue(task)) {
+            _pending.fetch_sub(1, std::memory_order_release);
+            task();
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void ThreadPoolExecutor::workerLoop(uint32 home) {
+    for (;;) {
+        if (runOne(home)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeLock);
+        _wake.wait(lock, [this]() {
+            return _stopping.load() || (_pending.load(std::memory_order_acquire) > 0);
+        });
+
+        if (_stopping.load() && (_pending.load(std::memory_order_acquire) == 0)) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Type-safe string formatting
+ *	@file		format.cpp
+ ******************************************************************************/
+#include "solace/format.hpp"
+
+#include "solace/exception.hpp"
+
+
+using namespace Solace;
+using Solace::details::FormatArg;
+
+
+namespace /*anonymous*/ {
+
+void renderArg(StringBuilder& dest, FormatArg const& arg) {
+    switch (arg.tag) {
+    case FormatArg::Tag::Int:       dest.append(arg.i); break;
+    case FormatArg::Tag::UInt:      dest.append(arg.u); break;
+    case FormatArg::Tag::Float:     dest.append(arg.f); break;
+    case FormatArg::Tag::Character: dest.append(arg.c); break;
+    case FormatArg::Tag::Str:       dest.append(arg.s); break;
+    case FormatArg::Tag::Bool:
+        dest.append(arg.b ? StringView("true") : StringView("false"));
+        break;
+    }
+}
+
+}  // namespace
+
+
+StringBuilder&
+Solace::details::formatTo(StringBuilder& dest, StringView fmt,
+                          FormatArg const* args, uint32 nbArgs) {
+    const auto* str = fmt.data();
+    const auto len = fmt.size();
+
+    uint32 nextArg = 0;
+    StringView::size_type runStart = 0;
+
+    for (StringView::size_type i = 0; i < len; ++i) {
+        const auto c = str[i];
+        if (c != '{' && c != '}') {
+            continue;
+        }
+
+        // The literal run up to the brace goes out in one write:
+        if (i > runStart) {
+            dest.append(StringView(str + runStart, i - runStart));
+        }
+
+        if (i + 1 >= len) {
+            raise<IllegalArgumentException>("fmt");
+        }
+
+        if (c == str[i + 1]) {
+            // '{{' or '}}' - an escaped literal brace:
+            dest.append(c);
+        } else if (c == '{' && str[i + 1] == '}') {
+            if (nextArg >= nbArgs) {
+                raise<IllegalArgumentException>("fmt");
+            }
+            renderArg(dest, args[nextArg++]);
+        } else {
+            raise<IllegalArgumentException>("fmt");
+        }
+
+        ++i;  // Both branches consumed the character after the brace.
+        runStart = i + 1;
+    }
+
+    if (len > runStart) {
+        dest.append(StringView(str + runStart, len - runStart));
+    }
+
+    if (nextArg != nbArgs) {
+        raise<IllegalArgumentException>("fmt");
+    }
+
+    return dest;
+}
@@ -20,6 +20,7 @@
 *******************************************************************************/
 
 #include "solace/framework/application.hpp"
+#include "solace/hashMap.hpp"
 
 
 using namespace Solace;
@@ -28,3 +29,13 @@ using namespace Solace::Framework;
 
 Application::~Application()
 {}
+
+
+Application::Application(Version const& version) :
+    _version(version)
+{
+    // Fix the hash seed before any subsystem builds a request-keyed table:
+    // a seed drawn lazily mid-run would change hashCode(seed) values under
+    // tables already populated with the earlier seed.
+    hashSeed();
+}
@@ -0,0 +1,128 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		framework/eventLoop.cpp
+ *	@brief		Implementation of the reactor event-loop driver
+ ******************************************************************************/
+#include "solace/framework/eventLoop.hpp"
+#include "solace/arrayView.hpp"
+
+
+using namespace Solace;
+using namespace Solace::IO;
+using namespace Solace::Framework;
+
+
+constexpr EventLoop::size_type EventLoop::kEventBatch;
+
+
+EventLoop::EventLoop(Selector&& selector, Options options) :
+    _selector(std::move(selector)),
+    _timers(options.tickDurationMs),
+    _wakeup(EventFd::create()),
+    _options(options)
+{
+    _selector.add(&_timers, Selector::Events::Read);
+    _selector.add(&_wakeup, Selector::Events::Read);
+}
+
+
+void EventLoop::post(Task&& task) {
+    {
+        std::lock_guard<std::mutex> guard(_postLock);
+        _posted.emplace_back(std::move(task));
+    }
+
+    _wakeup.notify();
+}
+
+
+void EventLoop::drainPosted() {
+    {
+        std::lock_guard<std::mutex> guard(_postLock);
+        _draining.swap(_posted);
+    }
+
+    for (auto& task : _draining) {
+        task();
+    }
+
+    _draining.clear();
+}
+
+
+Result<void, Error>
+EventLoop::run(EventHandler&& handler) {
+    bool expected = false;
+    if (!_running.compare_exchange_strong(expected, true)) {
+        return Err(Error("EventLoop is already running"));
+    }
+
+    _keepRunning.store(true, std::memory_order_relaxed);
+
+    Selector::Event events[kEventBatch] = {};
+    Selector::Event expired[kEventBatch] = {};
+
+    const auto timerFd = _timers.getSelectId();
+    const auto wakeupFd = _wakeup.getSelectId();
+
+    while (_keepRunning.load(std::memory_order_relaxed)) {
+        // Deadline clamping is the timerfd's job: the kernel cuts the wait
+        // short at the next pending tick, so the loop reads no clock here.
+        const auto timeout = _onIdle ? _options.idlePollMs : -1;
+        const auto count = _selector.pollInto(arrayView(events), timeout);
+
+        if (count == 0) {
+            if (_onIdle) {
+                _onIdle();
+            }
+            continue;
+        }
+
+        for (size_type i = 0; i < count; ++i) {
+            auto const& event = events[i];
+
+            if (event.fd == timerFd) {
+                // Drain the wheel in batches through the same handler:
+                size_type nbExpired = 0;
+                do {
+                    nbExpired = _timers.expire(arrayView(expired));
+                    for (size_type t = 0; t < nbExpired; ++t) {
+                        handler(expired[t]);
+                    }
+                } while (nbExpired == kEventBatch);
+            } else if (event.fd == wakeupFd) {
+                _wakeup.take();
+                drainPosted();
+            } else {
+                handler(event);
+            }
+        }
+    }
+
+    // Run everything posted up to the stop, then hand the loop back:
+    drainPosted();
+    _running.store(false, std::memory_order_relaxed);
+
+    return Ok();
+}
+
+
+void EventLoop::stop() {
+    _keepRunning.store(false, std::memory_order_relaxed);
+    _wakeup.notify();
+}
@@ -0,0 +1,249 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: framework/initGraph.cpp
+*******************************************************************************/
+
+#include "solace/framework/initGraph.hpp"
+#include "solace/exception.hpp"
+
+#include <condition_variable>
+#include <mutex>
+
+
+using namespace Solace;
+using namespace Solace::Framework;
+
+
+namespace {
+
+Error namedError(const char* what, StringView name) {
+    std::string message(what);
+    message.append(name.data(), name.size());
+    message.push_back('\'');
+
+    return Error(std::move(message));
+}
+
+}  // namespace
+
+
+InitGraph&
+InitGraph::add(StringView name, InitAction action) {
+    return add(name, {}, std::move(action));
+}
+
+
+InitGraph&
+InitGraph::add(StringView name, std::initializer_list<StringView> dependsOn, InitAction action) {
+    if (findNode(name).isSome()) {
+        raise<IllegalArgumentException>("name");
+    }
+
+    _nodes.push_back(Node{name, std::vector<StringView>{dependsOn}, std::move(action), false});
+
+    return *this;
+}
+
+
+Optional<InitGraph::size_type>
+InitGraph::findNode(StringView name) const noexcept {
+    for (size_type i = 0; i < size(); ++i) {
+        if (_nodes[i].name.equals(name)) {
+            return Optional<size_type>{i};
+        }
+    }
+
+    return none;
+}
+
+
+bool InitGraph::isStarted(StringView name) const noexcept {
+    auto const index = findNode(name);
+
+    return index.isSome() && _nodes[index.get()].started;
+}
+
+
+Result<void, Error>
+InitGraph::startNode(size_type index, std::vector<byte>& visitState) {
+    auto& node = _nodes[index];
+    if (node.started) {
+        return Ok();
+    }
+
+    if (visitState[index] != 0) {
+        return Err(namedError("Subsystem dependency cycle through '", node.name));
+    }
+
+    visitState[index] = 1;
+
+    for (auto const& depName : node.dependsOn) {
+        auto const dep = findNode(depName);
+        if (dep.isNone()) {
+            return Err(namedError("Unknown subsystem dependency '", depName));
+        }
+
+        auto depResult = startNode(dep.get(), visitState);
+        if (!depResult) {
+            return depResult;
+        }
+    }
+
+    auto result = node.action();
+    if (!result) {
+        return result;
+    }
+
+    node.started = true;
+
+    return Ok();
+}
+
+
+Result<void, Error>
+InitGraph::start(StringView name) {
+    auto const index = findNode(name);
+    if (index.isNone()) {
+        return Err(namedError("Unknown subsystem '", name));
+    }
+
+    std::vector<byte> visitState(_nodes.size(), 0);
+
+    return startNode(index.get(), visitState);
+}
+
+
+Result<void, Error>
+InitGraph::startAll() {
+    InlineExecutor executor;
+
+    return startAll(executor);
+}
+
+
+Result<void, Error>
+InitGraph::startAll(Executor& executor) {
+    auto const count = size();
+
+    // Resolve dependency names into edges once, up front:
+    std::vector<std::vector<size_type>> dependents(count);
+    std::vector<size_type> nbPendingDeps(count, 0);
+
+    for (size_type i = 0; i < count; ++i) {
+        for (auto const& depName : _nodes[i].dependsOn) {
+            auto const dep = findNode(depName);
+            if (dep.isNone()) {
+                return Err(namedError("Unknown subsystem dependency '", depName));
+            }
+
+            dependents[dep.get()].push_back(i);
+            nbPendingDeps[i] += 1;
+        }
+    }
+
+    std::vector<size_type> phase;
+    phase.reserve(count);
+    for (size_type i = 0; i < count; ++i) {
+        if (nbPendingDeps[i] == 0) {
+            phase.push_back(i);
+        }
+    }
+
+    size_type nbProcessed = 0;
+    std::vector<size_type> toRun;
+    std::vector<Optional<Error>> failures;
+
+    while (!phase.empty()) {
+        toRun.clear();
+        for (auto const index : phase) {
+            if (!_nodes[index].started) {
+                toRun.push_back(index);
+            }
+        }
+
+        if (toRun.size() == 1) {
+            // A phase of one gains nothing from the executor:
+            auto result = _nodes[toRun.front()].action();
+            if (!result) {
+                return Err(result.moveError());
+            }
+
+            _nodes[toRun.front()].started = true;
+        } else if (toRun.size() > 1) {
+            // Members of a phase are independent of each other, so they
+            // are all submitted before the first completion is awaited:
+            failures.clear();
+            for (std::size_t j = 0; j < toRun.size(); ++j) {
+                failures.emplace_back(none);
+            }
+
+            std::mutex guard;
+            std::condition_variable allDone;
+            auto nbRemaining = toRun.size();
+
+            for (std::size_t j = 0; j < toRun.size(); ++j) {
+                auto& node = _nodes[toRun[j]];
+                auto& failure = failures[j];
+
+                executor.submit([&node, &failure, &guard, &allDone, &nbRemaining]() {
+                    auto result = node.action();
+                    if (!result) {
+                        failure = result.moveError();
+                    }
+
+                    std::lock_guard<std::mutex> lock(guard);
+                    nbRemaining -= 1;
+                    allDone.notify_one();
+                });
+            }
+
+            {
+                std::unique_lock<std::mutex> lock(guard);
+                allDone.wait(lock, [&nbRemaining]() { return nbRemaining == 0; });
+            }
+
+            // The whole phase has completed; report the first failure in
+            // registration order so the outcome does not depend on timing:
+            for (std::size_t j = 0; j < toRun.size(); ++j) {
+                if (failures[j].isSome()) {
+                    return Err(failures[j].move());
+                }
+
+                _nodes[toRun[j]].started = true;
+            }
+        }
+
+        // Release the next phase:
+        std::vector<size_type> nextPhase;
+        for (auto const index : phase) {
+            for (auto const dependent : dependents[index]) {
+                if (--nbPendingDeps[dependent] == 0) {
+                    nextPhase.push_back(dependent);
+                }
+            }
+        }
+
+        nbProcessed += static_cast<size_type>(phase.size());
+        phase.swap(nextPhase);
+    }
+
+    if (nbProcessed != count) {
+        return Err(Error("Subsystem dependency cycle"));
+    }
+
+    return Ok();
+}
@@ -0,0 +1,235 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		framework/taskScheduler.cpp
+ *	@brief		Implementation of the work-stealing task scheduler
+ ******************************************************************************/
+#include "solace/framework/taskScheduler.hpp"
+
+
+using namespace Solace;
+using namespace Solace::Framework;
+
+
+namespace {
+
+/// Which scheduler - if any - the current thread is a worker of, and its slot.
+thread_local TaskScheduler const* tHomeScheduler = nullptr;
+thread_local uint32 tHomeIndex = 0;
+
+}  // namespace
+
+
+TaskScheduler::StealQueue::StealQueue(uint32 capacity) :
+    _buffer(new std::atomic<Task*>[capacity]),
+    _mask(capacity - 1)
+{
+}
+
+
+bool TaskScheduler::StealQueue::push(Task* task) noexcept {
+    auto const b = _bottom.load(std::memory_order_relaxed);
+    auto const t = _top.load(std::memory_order_acquire);
+
+    if (b - t > static_cast<int64>(_mask)) {  // Deque is at capacity.
+        return false;
+    }
+
+    _buffer[b & _mask].store(task, std::memory_order_relaxed);
+    _bottom.store(b + 1, std::memory_order_release);
+
+    return true;
+}
+
+
+TaskScheduler::Task* TaskScheduler::StealQueue::pop() noexcept {
+    auto const b = _bottom.load(std::memory_order_relaxed) - 1;
+    _bottom.store(b, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto t = _top.load(std::memory_order_relaxed);
+
+    if (t > b) {  // Deque was empty: restore bottom.
+        _bottom.store(b + 1, std::memory_order_relaxed);
+
+        return nullptr;
+    }
+
+    auto task = _buffer[b & _mask].load(std::memory_order_relaxed);
+    if (t == b) {
+        // Taking the last element: race the thieves for it.
+        if (!_top.compare_exchange_strong(t, t + 1,
+                                          std::memory_order_seq_cst, std::memory_order_relaxed)) {
+            task = nullptr;  // A thief got there first.
+        }
+
+        _bottom.store(b + 1, std::memory_order_relaxed);
+    }
+
+    return task;
+}
+
+
+TaskScheduler::Task* TaskScheduler::StealQueue::steal() noexcept {
+    auto t = _top.load(std::memory_order_acquire);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    auto const b = _bottom.load(std::memory_order_acquire);
+
+    if (t >= b) {
+        return nullptr;
+    }
+
+    auto task = _buffer[t & _mask].load(std::memory_order_relaxed);
+    if (!_top.compare_exchange_strong(t, t + 1,
+                                      std::memory_order_seq_cst, std::memory_order_relaxed)) {
+        return nullptr;  // Lost the race to the owner or another thief.
+    }
+
+    return task;
+}
+
+
+TaskScheduler::TaskScheduler(uint32 nbWorkers) :
+    _nbWorkers(nbWorkers),
+    _injection(kInjectionCapacity)
+{
+    if (_nbWorkers == 0) {
+        const auto hw = std::thread::hardware_concurrency();
+        _nbWorkers = (hw > 0) ? hw : 1;
+    }
+}
+
+
+TaskScheduler::~TaskScheduler() {
+    _stopping.store(true);
+    {   // Pair with the wait in workerLoop so no worker misses the shutdown signal.
+        std::lock_guard<std::mutex> guard(_wakeLock);
+    }
+    _wake.notify_all();
+
+    for (auto& worker : _threads) {
+        worker.join();
+    }
+}
+
+
+Result<void, Error>
+TaskScheduler::start() {
+    if (isStarted()) {
+        return Err(Error("TaskScheduler: already started"));
+    }
+
+    _deques.reserve(_nbWorkers);
+    for (uint32 i = 0; i < _nbWorkers; ++i) {
+        _deques.emplace_back(new StealQueue(kDequeCapacity));
+    }
+
+    _threads.reserve(_nbWorkers);
+    for (uint32 i = 0; i < _nbWorkers; ++i) {
+        _threads.emplace_back([this, i]() { workerLoop(i); });
+    }
+
+    return Ok();
+}
+
+
+void TaskScheduler::schedule(Task task) {
+    if (!isStarted()) {
+        // No workers to hand the task to - run it here and now.
+        task();
+        return;
+    }
+
+    std::unique_ptr<Task> node(new Task(std::move(task)));
+
+    // A worker submitting to its own scheduler pushes to its own deque, so
+    // nested tasks run in LIFO order close to their parent's working set.
+    // Everything else - and a full deque - goes through the injection queue:
+    bool queued = (tHomeScheduler == this) && _deques[tHomeIndex]->push(node.get());
+    if (!queued) {
+        queued = _injection.tryEnqueue(node.get());
+    }
+
+    if (queued) {
+        node.release();
+        _pending.fetch_add(1, std::memory_order_release);
+        {
+            std::lock_guard<std::mutex> guard(_wakeLock);
+        }
+        _wake.notify_one();
+
+        return;
+    }
+
+    // No queue space anywhere - run on the submitting thread for backpressure.
+    (*node)();
+}
+
+
+void TaskScheduler::runReclaiming(Task* task) {
+    std::unique_ptr<Task> guard(task);
+    _pending.fetch_sub(1, std::memory_order_release);
+
+    (*task)();
+}
+
+
+bool TaskScheduler::runOne(uint32 home) {
+    if (auto task = _deques[home]->pop()) {
+        runReclaiming(task);
+
+        return true;
+    }
+
+    Task* injected = nullptr;
+    if (_injection.tryDequeue(injected)) {
+        runReclaiming(injected);
+
+        return true;
+    }
+
+    const auto nbWorkers = static_cast<uint32>(_deques.size());
+    for (uint32 attempt = 1; attempt < nbWorkers; ++attempt) {
+        if (auto task = _deques[(home + attempt) % nbWorkers]->steal()) {
+            runReclaiming(task);
+
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+void TaskScheduler::workerLoop(uint32 home) {
+    tHomeScheduler = this;
+    tHomeIndex = home;
+
+    for (;;) {
+        if (runOne(home)) {
+            continue;
+        }
+
+        std::unique_lock<std::mutex> lock(_wakeLock);
+        _wake.wait(lock, [this]() {
+            return _stopping.load() || (_pending.load(std::memory_order_acquire) > 0);
+        });
+
+        if (_stopping.load() && (_pending.load(std::memory_order_acquire) == 0)) {
+            return;
+        }
+    }
+}
@@ -0,0 +1,169 @@
+/*
+*  Copyright 2017 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Checksummed message framing over byte streams
+ *	@file		framing.cpp
+ ******************************************************************************/
+#include "solace/framing.hpp"
+#include "solace/hashing/crc32c.hpp"
+
+#include <cstring>  // memcpy
+
+
+using namespace Solace;
+
+
+namespace /*anonymous*/ {
+
+constexpr byte kMarkerByte = 0xA5;   // Low byte of Framing::kMagic, first on the wire.
+
+
+uint32 readLE32(const byte* p) noexcept {
+    return static_cast<uint32>(p[0])
+            | (static_cast<uint32>(p[1]) << 8)
+            | (static_cast<uint32>(p[2]) << 16)
+            | (static_cast<uint32>(p[3]) << 24);
+}
+
+
+/**
+ * Find the next occurrence of the marker byte, examining eight bytes per
+ * iteration: the classic has-zero-byte trick on data xor-ed with the marker
+ * broadcast to every lane. Returns len when there is no marker.
+ */
+FrameDecoder::size_type
+findMarker(const byte* data, FrameDecoder::size_type len) noexcept {
+    constexpr uint64 kEach = 0x0101010101010101ull;
+    constexpr uint64 kHigh = 0x8080808080808080ull;
+    const uint64 pattern = kEach * kMarkerByte;
+
+    FrameDecoder::size_type i = 0;
+    for (; i + sizeof(uint64) <= len; i += sizeof(uint64)) {
+        uint64 word;
+        memcpy(&word, data + i, sizeof(word));
+
+        const uint64 match = word ^ pattern;
+        if ((match - kEach) & ~match & kHigh) {
+            break;  // Some byte in this word matches - pin it down below.
+        }
+    }
+
+    while (i < len && data[i] != kMarkerByte) {
+        ++i;
+    }
+
+    return i;
+}
+
+}  // namespace
+
+
+Result<void, Error>
+FrameEncoder::encode(ImmutableMemoryView const& src) {
+    const auto length = static_cast<uint32>(src.size());
+
+    // The checksum covers the length field as it appears on the wire:
+    const byte lengthBytes[sizeof(uint32)] = {
+        static_cast<byte>(length & 0xFF),
+        static_cast<byte>((length >> 8) & 0xFF),
+        static_cast<byte>((length >> 16) & 0xFF),
+        static_cast<byte>((length >> 24) & 0xFF)
+    };
+
+    auto crc = hashing::crc32c(wrapMemory(lengthBytes, sizeof(lengthBytes)));
+    crc = hashing::crc32c(src, crc);
+
+    auto& dest = *getDestBuffer();
+    auto written = dest.writeLE(Framing::kMagic);
+    if (!written) {
+        return Err(written.moveError());
+    }
+
+    written = dest.writeLE(length);
+    if (!written) {
+        return Err(written.moveError());
+    }
+
+    written = dest.write(src);
+    if (!written) {
+        return Err(written.moveError());
+    }
+
+    return dest.writeLE(crc);
+}
+
+
+void FrameDecoder::resync(ReadBuffer& src, ImmutableMemoryView remaining) {
+    // The byte at the current position has been ruled out; hunt for the next
+    // candidate marker past it:
+    const auto* bytes = remaining.dataAddress();
+    const auto skip = 1 + findMarker(bytes + 1, remaining.size() - 1);
+
+    _stats.bytesSkipped += skip;
+    src.position(src.position() + skip);
+}
+
+
+Result<Optional<FrameDecoder::size_type>, Error>
+FrameDecoder::decode(ReadBuffer& src, MemoryView dest) {
+    for (;;) {
+        const auto view = src.viewRemaining();
+        const auto* bytes = view.dataAddress();
+        const auto available = view.size();
+
+        if (available < Framing::kHeaderSize) {
+            return Ok(Optional<size_type>(none));
+        }
+
+        if (bytes[0] != kMarkerByte || bytes[1] != (Framing::kMagic >> 8)) {
+            // Not at a frame boundary - skip to the next candidate marker:
+            resync(src, view);
+            continue;
+        }
+
+        const auto length = readLE32(bytes + 2);
+        if (length > _maxPayloadSize) {
+            // An insane length is corruption, not a frame to wait for:
+            _stats.framesCorrupted += 1;
+            resync(src, view);
+            continue;
+        }
+
+        const auto frameSize = Framing::kHeaderSize + length + Framing::kTrailerSize;
+        if (available < frameSize) {
+            return Ok(Optional<size_type>(none));  // Come back with more bytes.
+        }
+
+        auto crc = hashing::crc32c(wrapMemory(bytes + 2, sizeof(uint32)));
+        crc = hashing::crc32c(wrapMemory(bytes + Framing::kHeaderSize, length), crc);
+        if (crc != readLE32(bytes + Framing::kHeaderSize + length)) {
+            _stats.framesCorrupted += 1;
+            resync(src, view);
+            continue;
+        }
+
+        // The frame checks out - only now does it claim dest space:
+        if (dest.size() < length) {
+            return Err(Error("FrameDecoding error: Destination too small for frame"));
+        }
+
+        memcpy(dest.dataAddress(), bytes + Framing::kHeaderSize, length);
+        src.position(src.position() + frameSize);
+        _stats.framesDecoded += 1;
+
+        return Ok(Optional<size_type>(length));
+    }
+}
@@ -0,0 +1,52 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		hashMap.cpp
+ *	@brief		The per-process hash seed
+ ******************************************************************************/
+#include "solace/hashMap.hpp"
+
+#include <chrono>
+#include <random>
+
+
+namespace {
+
+Solace::uint64 generateSeed() noexcept {
+    try {
+        std::random_device entropy;
+
+        return (static_cast<Solace::uint64>(entropy()) << 32) | entropy();
+    } catch (...) {
+        // No usable entropy source: fall back to the clock and ASLR bits.
+        auto const now = std::chrono::steady_clock::now().time_since_epoch().count();
+
+        return static_cast<Solace::uint64>(now)
+                ^ reinterpret_cast<std::uintptr_t>(&generateSeed);
+    }
+}
+
+}  // namespace
+
+
+Solace::uint64
+Solace::hashSeed() noexcept {
+    // The magic static fixes the seed on first use, thread-safely.
+    static uint64 const seed = generateSeed();
+
+    return seed;
+}
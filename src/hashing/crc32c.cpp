@@ -0,0 +1,358 @@
+//-----------------------------------------------------------------------------
+// CRC-32C computation after Mark Adler's public-domain crc32c.c: a
+// slicing-by-eight table implementation as the portable baseline, and a
+// hardware path that runs three crc32 instruction streams in parallel to
+// cover the instruction's three-cycle latency, stitching the lanes back
+// together with precomputed zero-block shift operators over GF(2).
+/*******************************************************************************
+ * libSolace
+ *	@file		solace/hashing/crc32c.cpp
+ *	@brief		Implementation of the CRC-32C checksum.
+ ******************************************************************************/
+#include "solace/hashing/crc32c.hpp"
+
+#include "solace/cpuFeatures.hpp"
+
+#include <memory.h>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SOLACE_CRC32C_SSE42 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#define SOLACE_CRC32C_ARMV8 1
+#include <arm_acle.h>
+#include <sys/auxv.h>
+#endif
+
+using namespace Solace;
+using namespace Solace::hashing;
+
+static const String CRC32C_NAME = "CRC32C";
+
+// CRC-32C (iSCSI) polynomial, reflected:
+static const uint32 kCrc32cPoly = 0x82f63b78;
+
+// Block sizes of the two interleaved phases of the hardware path. Long blocks
+// amortize the lane-stitching cost; short blocks mop up what is left of a
+// medium-sized buffer before the sequential tail.
+static const size_t kLongBlock = 8192;
+static const size_t kShortBlock = 256;
+
+
+namespace /* anonymous */ {
+
+/** Tables for slicing-by-eight software CRC and for shifting a CRC through
+ * a block of zero bytes, all derived from the polynomial at startup. */
+struct Crc32cTables {
+
+    uint32 sw[8][256];          //!< Slicing-by-eight byte tables.
+    uint32 longShift[4][256];   //!< Shift operator for kLongBlock zero bytes.
+    uint32 shortShift[4][256];  //!< Shift operator for kShortBlock zero bytes.
+
+    Crc32cTables() {
+        for (uint32 n = 0; n < 256; ++n) {
+            uint32 crc = n;
+            for (int k = 0; k < 8; ++k) {
+                crc = (crc & 1) ? (crc >> 1) ^ kCrc32cPoly : crc >> 1;
+            }
+            sw[0][n] = crc;
+        }
+        for (uint32 n = 0; n < 256; ++n) {
+            uint32 crc = sw[0][n];
+            for (int k = 1; k < 8; ++k) {
+                crc = sw[0][crc & 0xff] ^ (crc >> 8);
+                sw[k][n] = crc;
+            }
+        }
+
+        zeros(longShift, kLongBlock);
+        zeros(shortShift, kShortBlock);
+    }
+
+private:
+
+    static uint32 gf2MatrixTimes(const uint32* mat, uint32 vec) {
+        uint32 sum = 0;
+        while (vec) {
+            if (vec & 1) {
+                sum ^= *mat;
+            }
+            vec >>= 1;
+            mat++;
+        }
+
+        return sum;
+    }
+
+    static void gf2MatrixSquare(uint32* square, const uint32* mat) {
+        for (int n = 0; n < 32; ++n) {
+            square[n] = gf2MatrixTimes(mat, mat[n]);
+        }
+    }
+
+    /** Construct the operator applying the CRC of len zero bytes, as a matrix
+     * power of the one-bit shift, then expand it into four byte tables. */
+    static void zeros(uint32 shift[][256], size_t len) {
+        uint32 even[32];    // Operator for an even number of zero bits.
+        uint32 odd[32];     // Operator for an odd number of zero bits.
+
+        // One shifted bit:
+        odd[0] = kCrc32cPoly;
+        uint32 row = 1;
+        for (int n = 1; n < 32; ++n) {
+            odd[n] = row;
+            row <<= 1;
+        }
+
+        gf2MatrixSquare(even, odd);     // Two zero bits.
+        gf2MatrixSquare(odd, even);     // Four zero bits.
+
+        // Square until the operator covers len zero bytes:
+        size_t n = len;
+        do {
+            gf2MatrixSquare(even, odd);
+            n >>= 1;
+            if (n == 0) {
+                memcpy(odd, even, sizeof(odd));
+                break;
+            }
+            gf2MatrixSquare(odd, even);
+            n >>= 1;
+        } while (n);
+
+        for (uint32 i = 0; i < 256; ++i) {
+            shift[0][i] = gf2MatrixTimes(odd, i);
+            shift[1][i] = gf2MatrixTimes(odd, i << 8);
+            shift[2][i] = gf2MatrixTimes(odd, i << 16);
+            shift[3][i] = gf2MatrixTimes(odd, i << 24);
+        }
+    }
+};
+
+
+Crc32cTables const& tables() {
+    static const Crc32cTables instance;
+
+    return instance;
+}
+
+
+inline uint32 shiftCrc(const uint32 shift[][256], uint32 crc) {
+    return shift[0][crc & 0xff]
+         ^ shift[1][(crc >> 8) & 0xff]
+         ^ shift[2][(crc >> 16) & 0xff]
+         ^ shift[3][crc >> 24];
+}
+
+}  // namespace
+
+
+static uint32 crc32c_sw(uint32 crci, const byte* data, size_t len) {
+    auto const& t = tables();
+    uint64 crc = crci ^ 0xffffffff;
+
+    while (len && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+        crc = t.sw[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+        len--;
+    }
+
+    while (len >= 8) {
+        uint64 word;
+        memcpy(&word, data, 8);
+        crc ^= word;
+        crc = t.sw[7][crc & 0xff]
+            ^ t.sw[6][(crc >> 8) & 0xff]
+            ^ t.sw[5][(crc >> 16) & 0xff]
+            ^ t.sw[4][(crc >> 24) & 0xff]
+            ^ t.sw[3][(crc >> 32) & 0xff]
+            ^ t.sw[2][(crc >> 40) & 0xff]
+            ^ t.sw[1][(crc >> 48) & 0xff]
+            ^ t.sw[0][crc >> 56];
+        data += 8;
+        len -= 8;
+    }
+
+    while (len) {
+        crc = t.sw[0][(crc ^ *data++) & 0xff] ^ (crc >> 8);
+        len--;
+    }
+
+    return static_cast<uint32>(crc) ^ 0xffffffff;
+}
+
+
+#if defined(SOLACE_CRC32C_SSE42)
+
+__attribute__((target("sse4.2")))
+static uint32 crc32c_hw(uint32 crci, const byte* data, size_t len) {
+    auto const& t = tables();
+
+    uint64 crc0 = crci ^ 0xffffffff;
+
+    // Align to an 8-byte boundary:
+    while (len && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+        crc0 = _mm_crc32_u8(static_cast<uint32>(crc0), *data++);
+        len--;
+    }
+
+    // Three interleaved streams over long blocks, stitched with the
+    // precomputed zero-shift operators:
+    while (len >= 3 * kLongBlock) {
+        uint64 crc1 = 0;
+        uint64 crc2 = 0;
+        const byte* end = data + kLongBlock;
+        do {
+            uint64 w0, w1, w2;
+            memcpy(&w0, data, 8);
+            memcpy(&w1, data + kLongBlock, 8);
+            memcpy(&w2, data + 2 * kLongBlock, 8);
+            crc0 = _mm_crc32_u64(crc0, w0);
+            crc1 = _mm_crc32_u64(crc1, w1);
+            crc2 = _mm_crc32_u64(crc2, w2);
+            data += 8;
+        } while (data < end);
+        crc0 = shiftCrc(t.longShift, static_cast<uint32>(crc0)) ^ crc1;
+        crc0 = shiftCrc(t.longShift, static_cast<uint32>(crc0)) ^ crc2;
+        data += 2 * kLongBlock;
+        len -= 3 * kLongBlock;
+    }
+
+    while (len >= 3 * kShortBlock) {
+        uint64 crc1 = 0;
+        uint64 crc2 = 0;
+        const byte* end = data + kShortBlock;
+        do {
+            uint64 w0, w1, w2;
+            memcpy(&w0, data, 8);
+            memcpy(&w1, data + kShortBlock, 8);
+            memcpy(&w2, data + 2 * kShortBlock, 8);
+            crc0 = _mm_crc32_u64(crc0, w0);
+            crc1 = _mm_crc32_u64(crc1, w1);
+            crc2 = _mm_crc32_u64(crc2, w2);
+            data += 8;
+        } while (data < end);
+        crc0 = shiftCrc(t.shortShift, static_cast<uint32>(crc0)) ^ crc1;
+        crc0 = shiftCrc(t.shortShift, static_cast<uint32>(crc0)) ^ crc2;
+        data += 2 * kShortBlock;
+        len -= 3 * kShortBlock;
+    }
+
+    while (len >= 8) {
+        uint64 word;
+        memcpy(&word, data, 8);
+        crc0 = _mm_crc32_u64(crc0, word);
+        data += 8;
+        len -= 8;
+    }
+
+    while (len) {
+        crc0 = _mm_crc32_u8(static_cast<uint32>(crc0), *data++);
+        len--;
+    }
+
+    return static_cast<uint32>(crc0) ^ 0xffffffff;
+}
+
+#endif  // SOLACE_CRC32C_SSE42
+
+
+#if defined(SOLACE_CRC32C_ARMV8)
+
+__attribute__((target("+crc")))
+static uint32 crc32c_hw(uint32 crci, const byte* data, size_t len) {
+    uint32 crc = crci ^ 0xffffffff;
+
+    while (len && (reinterpret_cast<uintptr_t>(data) & 7) != 0) {
+        crc = __crc32cb(crc, *data++);
+        len--;
+    }
+
+    while (len >= 8) {
+        uint64 word;
+        memcpy(&word, data, 8);
+        crc = __crc32cd(crc, word);
+        data += 8;
+        len -= 8;
+    }
+
+    while (len) {
+        crc = __crc32cb(crc, *data++);
+        len--;
+    }
+
+    return crc ^ 0xffffffff;
+}
+
+#endif  // SOLACE_CRC32C_ARMV8
+
+
+using Crc32cKernel = uint32 (*)(uint32 crci, const byte* data, size_t len);
+
+static Crc32cKernel resolveCrc32c() {
+#if defined(SOLACE_CRC32C_SSE42)
+    if (cpuFeatures().sse42) {
+        return crc32c_hw;
+    }
+#elif defined(SOLACE_CRC32C_ARMV8)
+    if (cpuFeatures().crc32) {
+        return crc32c_hw;
+    }
+#endif
+
+    return crc32c_sw;
+}
+
+
+static uint32 crc32c_compute(uint32 crc, const byte* data, size_t len) {
+    static const Crc32cKernel kernel = resolveCrc32c();
+
+    return kernel(crc, data, len);
+}
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+
+Crc32c::Crc32c() :
+    _crc(0)
+{
+}
+
+
+String Crc32c::getAlgorithm() const {
+    return CRC32C_NAME;
+}
+
+
+Crc32c::size_type
+Crc32c::getDigestLength() const {
+    return 32 / 8;
+}
+
+
+HashingAlgorithm& Crc32c::update(ImmutableMemoryView input) {
+    _crc = crc32c_compute(_crc, input.dataAddress(), input.size());
+
+    return (*this);
+}
+
+
+MessageDigest Crc32c::digest() {
+    byte result[4];
+
+    putUint32_BE(_crc, result, 0);
+
+    return MessageDigest(wrapMemory(result));
+}
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+
+uint32 Solace::hashing::crc32c(ImmutableMemoryView data, uint32 crc) noexcept {
+    return crc32c_compute(crc, data.dataAddress(), data.size());
+}
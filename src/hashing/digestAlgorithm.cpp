@@ -0,0 +1,61 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		solace/hashing/digestAlgorithm.cpp
+ *	@brief		Non-trivial update sources shared by all digest algorithms
+ ******************************************************************************/
+#include "solace/hashing/digestAlgorithm.hpp"
+#include "solace/io/file.hpp"
+
+#include <algorithm>    // std::min
+#include <unistd.h>     // sysconf
+
+using namespace Solace;
+using namespace Solace::hashing;
+
+
+// Size of one mapped window: big enough to keep the read-ahead pipeline busy,
+// small enough not to blow up the address space accounting of a long job.
+static constexpr uint64 kMapWindowSize = 16 * 1024 * 1024;
+
+
+HashingAlgorithm&
+HashingAlgorithm::updateFrom(IO::File& file, uint64 offset, uint64 length) {
+    const auto pageSize = static_cast<uint64>(::sysconf(_SC_PAGESIZE));
+
+    uint64 consumed = 0;
+    while (consumed < length) {
+        // mmap insists on a page aligned file offset, so each window starts
+        // at the enclosing page boundary and the digest skips the slack:
+        const auto absolute = offset + consumed;
+        const auto mapBase = absolute & ~(pageSize - 1);
+        const auto slack = absolute - mapBase;
+        const auto mapSize = std::min(slack + (length - consumed), kMapWindowSize);
+
+        auto window = file.map(static_cast<IO::File::size_type>(mapBase),
+                               static_cast<MemoryView::size_type>(mapSize),
+                               IO::File::MapSharing::Private);
+        IO::File::advise(window.view(), IO::File::MapAdvice::Sequential);
+
+        update(window.view().slice(static_cast<MemoryView::size_type>(slack),
+                                   static_cast<MemoryView::size_type>(mapSize)));
+
+        consumed += mapSize - slack;
+    }
+
+    return *this;
+}
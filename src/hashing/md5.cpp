@@ -36,26 +36,31 @@ static const byte md5_padding[64] = {
 };
 
 
+/* Load the sixteen little-endian message words of a block in one go.
+ * memcpy compiles to plain (unaligned-tolerant) word loads on every target
+ * we build for - the byte-by-byte assembly it replaces cost four loads and
+ * three shift-ors per word, whatever the input alignment was. */
+static void md5_load_words(uint32_t X[16], const byte* data) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    memcpy(X, data, 64);
+#elif defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    memcpy(X, data, 64);
+    for (int t = 0; t < 16; ++t) {
+        X[t] = __builtin_bswap32(X[t]);
+    }
+#else
+    for (int t = 0; t < 16; ++t) {
+        getUint32_LE(X[t], data, 4 * static_cast<size_t>(t));
+    }
+#endif
+}
+
+
 SOLACE_NO_SANITIZE("unsigned-integer-overflow")
 void md5_process(MD5::State& ctx, const byte data[64]) {
     uint32_t X[16], A, B, C, D;
 
-    getUint32_LE(X[ 0], data,  0);
-    getUint32_LE(X[ 1], data,  4);
-    getUint32_LE(X[ 2], data,  8);
-    getUint32_LE(X[ 3], data, 12);
-    getUint32_LE(X[ 4], data, 16);
-    getUint32_LE(X[ 5], data, 20);
-    getUint32_LE(X[ 6], data, 24);
-    getUint32_LE(X[ 7], data, 28);
-    getUint32_LE(X[ 8], data, 32);
-    getUint32_LE(X[ 9], data, 36);
-    getUint32_LE(X[10], data, 40);
-    getUint32_LE(X[11], data, 44);
-    getUint32_LE(X[12], data, 48);
-    getUint32_LE(X[13], data, 52);
-    getUint32_LE(X[14], data, 56);
-    getUint32_LE(X[15], data, 60);
+    md5_load_words(X, data);
 
 #define S(x, n) ((x << n) | ((x & 0xFFFFFFFF) >> (32 - n)))
 #define F(x, y, z) (z ^ (x & (y ^ z)))
@@ -21,6 +21,7 @@
 #include "solace/hashing/messageDigest.hpp"
 
 #include "solace/base16.hpp"
+#include "solace/base64.hpp"
 
 #include <sstream>      // std::stringstream, std::stringbuf
 
@@ -55,15 +56,55 @@ operator<< (std::ostream& ostr, MessageDigest const& a) {
 
 String
 MessageDigest::toString() const {
-    std::vector<char> stringRepr;
-    stringRepr.reserve(Base16Encoder::encodedSize(size()));
-    WriteBuffer dest(wrapMemory(stringRepr.data(), stringRepr.size()));
-
-    for (auto i = base16Encode_begin(_storage.view()),
-         end = base16Encode_end(_storage.view());
-         i != end; ++i) {
-        dest.write((*i).view());
-    }
+    std::vector<char> stringRepr(Base16Encoder::encodedSize(size()));
+    base16Encode(view(), wrapMemory(stringRepr.data(), stringRepr.size()));
 
     return String{stringRepr.data(), static_cast<String::size_type>(stringRepr.size())};
 }
+
+
+Result<MessageDigest::size_type, Error>
+MessageDigest::formatInto(MemoryView dest, Encoding encoding) const {
+    if (encoding == Encoding::Base16) {
+        // Straight through the bulk kernel - no buffer bookkeeping at all:
+        auto encoded = base16Encode(view(), dest);
+        if (encoded.isError()) {
+            return Err(encoded.moveError());
+        }
+
+        return Ok(static_cast<size_type>(encoded.unwrap()));
+    }
+
+    WriteBuffer buffer(dest);
+    auto written = formatInto(buffer, encoding);
+    if (written.isError()) {
+        return Err(written.moveError());
+    }
+
+    return Ok(written.unwrap());
+}
+
+
+Result<MessageDigest::size_type, Error>
+MessageDigest::formatInto(WriteBuffer& dest, Encoding encoding) const {
+    if (encoding == Encoding::Base16) {
+        auto encoded = base16Encode(view(), dest.viewRemaining());
+        if (encoded.isError()) {
+            return Err(encoded.moveError());
+        }
+
+        // Written within the remaining window, so the advance cannot fail:
+        dest.advance(static_cast<WriteBuffer::size_type>(encoded.unwrap()));
+
+        return Ok(static_cast<size_type>(encoded.unwrap()));
+    }
+
+    const auto before = dest.position();
+    Base64Encoder encoder(dest);
+    auto encoded = encoder.encode(view());
+    if (encoded.isError()) {
+        return Err(encoded.moveError());
+    }
+
+    return Ok(static_cast<size_type>(dest.position() - before));
+}
@@ -12,6 +12,7 @@
  *	@brief		Implementation of Murmur3 hashing algorithm.
  ******************************************************************************/
 #include "solace/hashing/murmur3.hpp"
+#include "solace/exception.hpp"
 
 using namespace Solace;
 using namespace Solace::hashing;
@@ -390,3 +391,33 @@ MessageDigest Murmur3_128::digest() {
     return MessageDigest(wrapMemory(reinterpret_cast<byte*>(_hash), sizeof(_hash)));
 }
 
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+
+Hash128 Solace::hashing::murmur3_128(ImmutableMemoryView key, uint32 seed) noexcept {
+    uint64 out[2];
+
+#if  defined(__i386__) || defined(__arm__)
+    MurmurHash3_x86_128(key.dataAddress(), key.size(), seed, out);
+#elif  defined(__x86_64__) ||  defined(__aarch64__)
+    MurmurHash3_x64_128(key.dataAddress(), key.size(), seed, out);
+#else
+#error "Unsupported CPU architecture"
+#endif
+
+    return {out[0], out[1]};
+}
+
+
+void Solace::hashing::murmur3_128(ArrayView<ImmutableMemoryView> keys, ArrayView<Hash128> hashes, uint32 seed) {
+    if (hashes.size() < keys.size()) {
+        raise<IllegalArgumentException>("hashes");
+    }
+
+    for (ArrayView<ImmutableMemoryView>::size_type i = 0; i < keys.size(); ++i) {
+        hashes[i] = murmur3_128(keys[i], seed);
+    }
+}
+
@@ -35,26 +35,31 @@ static const byte sha1_padding[64] = {
 };
 
 
+/* Load the sixteen big-endian message words of a block in one go.
+ * memcpy compiles to plain (unaligned-tolerant) word loads, and the byte
+ * swap to one bswap per word - the byte-by-byte assembly it replaces cost
+ * four loads and three shift-ors per word, whatever the input alignment. */
+static void sha1_load_words(uint32_t W[16], const byte* data) {
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    memcpy(W, data, 64);
+    for (int t = 0; t < 16; ++t) {
+        W[t] = __builtin_bswap32(W[t]);
+    }
+#elif defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_BIG_ENDIAN__)
+    memcpy(W, data, 64);
+#else
+    for (int t = 0; t < 16; ++t) {
+        getUint32_BE(W[t], data, 4 * static_cast<size_t>(t));
+    }
+#endif
+}
+
+
 SOLACE_NO_SANITIZE("unsigned-integer-overflow")
 void sha1_process(Sha1::State& ctx, const byte data[64]) {
     uint32_t temp, W[16], A, B, C, D, E;
 
-    getUint32_BE(W[ 0], data,  0);
-    getUint32_BE(W[ 1], data,  4);
-    getUint32_BE(W[ 2], data,  8);
-    getUint32_BE(W[ 3], data, 12);
-    getUint32_BE(W[ 4], data, 16);
-    getUint32_BE(W[ 5], data, 20);
-    getUint32_BE(W[ 6], data, 24);
-    getUint32_BE(W[ 7], data, 28);
-    getUint32_BE(W[ 8], data, 32);
-    getUint32_BE(W[ 9], data, 36);
-    getUint32_BE(W[10], data, 40);
-    getUint32_BE(W[11], data, 44);
-    getUint32_BE(W[12], data, 48);
-    getUint32_BE(W[13], data, 52);
-    getUint32_BE(W[14], data, 56);
-    getUint32_BE(W[15], data, 60);
+    sha1_load_words(W, data);
 
 #define S(x, n) ((x << n) | ((x & 0xFFFFFFFF) >> (32 - n)))
 
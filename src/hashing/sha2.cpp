@@ -20,7 +20,22 @@
  ******************************************************************************/
 #include "solace/hashing/sha2.hpp"
 
+#include "solace/cpuFeatures.hpp"
+
 #include <memory.h>
+#include <algorithm>    // std::min
+#include <vector>
+
+#if defined(__GNUC__) && defined(__x86_64__)
+#define SOLACE_SHA256_SHANI 1
+#include <immintrin.h>
+#endif
+
+#if defined(__GNUC__) && defined(__aarch64__) && defined(__linux__)
+#define SOLACE_SHA256_ARMV8 1
+#include <arm_neon.h>
+#include <sys/auxv.h>
+#endif
 
 using namespace Solace;
 using namespace Solace::hashing;
@@ -140,6 +155,356 @@ void sha256_process(Sha256::State& ctx, const byte data[64] ) {
 }
 
 
+using Sha256CompressMany = void (*)(Sha256::State& ctx, const byte* data, Sha256::size_type blocks);
+
+static void
+sha256_process_many_scalar(Sha256::State& ctx, const byte* data, Sha256::size_type blocks) {
+    for (; blocks > 0; --blocks, data += 64) {
+        sha256_process(ctx, data);
+    }
+}
+
+
+#if defined(SOLACE_SHA256_SHANI)
+
+/**
+ * SHA-NI compression: two rounds per sha256rnds2 instruction, with the message
+ * schedule computed on the fly by sha256msg1/sha256msg2. The instruction works
+ * on the state split into ABEF/CDGH lanes, hence the shuffles on entry and exit.
+ */
+__attribute__((target("sha,sse4.1,ssse3")))
+static void
+sha256_process_many_shani(Sha256::State& ctx, const byte* data, Sha256::size_type blocks) {
+    const __m128i kShuffleBE = _mm_set_epi64x(0x0c0d0e0f08090a0b, 0x0405060700010203);
+
+    __m128i tmp    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ctx.state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&ctx.state[4]));
+
+    tmp    = _mm_shuffle_epi32(tmp, 0xB1);              // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B);           // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);   // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);        // CDGH
+
+    for (; blocks > 0; --blocks, data += 64) {
+        const __m128i abefSave = state0;
+        const __m128i cdghSave = state1;
+
+        __m128i msg;
+        __m128i msg0 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data +  0)), kShuffleBE);
+        __m128i msg1 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16)), kShuffleBE);
+        __m128i msg2 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 32)), kShuffleBE);
+        __m128i msg3 = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 48)), kShuffleBE);
+
+        // Rounds 0-3
+        msg = _mm_add_epi32(msg0, _mm_set_epi64x(0xE9B5DBA5B5C0FBCF, 0x71374491428A2F98));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+
+        // Rounds 4-7
+        msg = _mm_add_epi32(msg1, _mm_set_epi64x(0xAB1C5ED5923F82A4, 0x59F111F13956C25B));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+        // Rounds 8-11
+        msg = _mm_add_epi32(msg2, _mm_set_epi64x(0x550C7DC3243185BE, 0x12835B01D807AA98));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+        // Rounds 12-15
+        msg = _mm_add_epi32(msg3, _mm_set_epi64x(0xC19BF1749BDC06A7, 0x80DEB1FE72BE5D74));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg0 = _mm_add_epi32(msg0, _mm_alignr_epi8(msg3, msg2, 4));
+        msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        // Rounds 16-19
+        msg = _mm_add_epi32(msg0, _mm_set_epi64x(0x240CA1CC0FC19DC6, 0xEFBE4786E49B69C1));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg1 = _mm_add_epi32(msg1, _mm_alignr_epi8(msg0, msg3, 4));
+        msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+        // Rounds 20-23
+        msg = _mm_add_epi32(msg1, _mm_set_epi64x(0x76F988DA5CB0A9DC, 0x4A7484AA2DE92C6F));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg2 = _mm_add_epi32(msg2, _mm_alignr_epi8(msg1, msg0, 4));
+        msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+        // Rounds 24-27
+        msg = _mm_add_epi32(msg2, _mm_set_epi64x(0xBF597FC7B00327C8, 0xA831C66D983E5152));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg3 = _mm_add_epi32(msg3, _mm_alignr_epi8(msg2, msg1, 4));
+        msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+        // Rounds 28-31
+        msg = _mm_add_epi32(msg3, _mm_set_epi64x(0x1429296706CA6351, 0xD5A79147C6E00BF3));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg0 = _mm_add_epi32(msg0, _mm_alignr_epi8(msg3, msg2, 4));
+        msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        // Rounds 32-35
+        msg = _mm_add_epi32(msg0, _mm_set_epi64x(0x53380D134D2C6DFC, 0x2E1B213827B70A85));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg1 = _mm_add_epi32(msg1, _mm_alignr_epi8(msg0, msg3, 4));
+        msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+        // Rounds 36-39
+        msg = _mm_add_epi32(msg1, _mm_set_epi64x(0x92722C8581C2C92E, 0x766A0ABB650A7354));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg2 = _mm_add_epi32(msg2, _mm_alignr_epi8(msg1, msg0, 4));
+        msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg0 = _mm_sha256msg1_epu32(msg0, msg1);
+
+        // Rounds 40-43
+        msg = _mm_add_epi32(msg2, _mm_set_epi64x(0xC76C51A3C24B8B70, 0xA81A664BA2BFE8A1));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg3 = _mm_add_epi32(msg3, _mm_alignr_epi8(msg2, msg1, 4));
+        msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg1 = _mm_sha256msg1_epu32(msg1, msg2);
+
+        // Rounds 44-47
+        msg = _mm_add_epi32(msg3, _mm_set_epi64x(0x106AA070F40E3585, 0xD6990624D192E819));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg0 = _mm_add_epi32(msg0, _mm_alignr_epi8(msg3, msg2, 4));
+        msg0 = _mm_sha256msg2_epu32(msg0, msg3);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg2 = _mm_sha256msg1_epu32(msg2, msg3);
+
+        // Rounds 48-51
+        msg = _mm_add_epi32(msg0, _mm_set_epi64x(0x34B0BCB52748774C, 0x1E376C0819A4C116));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg1 = _mm_add_epi32(msg1, _mm_alignr_epi8(msg0, msg3, 4));
+        msg1 = _mm_sha256msg2_epu32(msg1, msg0);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+        msg3 = _mm_sha256msg1_epu32(msg3, msg0);
+
+        // Rounds 52-55
+        msg = _mm_add_epi32(msg1, _mm_set_epi64x(0x682E6FF35B9CCA4F, 0x4ED8AA4A391C0CB3));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg2 = _mm_add_epi32(msg2, _mm_alignr_epi8(msg1, msg0, 4));
+        msg2 = _mm_sha256msg2_epu32(msg2, msg1);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+
+        // Rounds 56-59
+        msg = _mm_add_epi32(msg2, _mm_set_epi64x(0x8CC7020884C87814, 0x78A5636F748F82EE));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        msg3 = _mm_add_epi32(msg3, _mm_alignr_epi8(msg2, msg1, 4));
+        msg3 = _mm_sha256msg2_epu32(msg3, msg2);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+
+        // Rounds 60-63
+        msg = _mm_add_epi32(msg3, _mm_set_epi64x(0xC67178F2BEF9A3F7, 0xA4506CEB90BEFFFA));
+        state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+        state0 = _mm_sha256rnds2_epu32(state0, state1, _mm_shuffle_epi32(msg, 0x0E));
+
+        state0 = _mm_add_epi32(state0, abefSave);
+        state1 = _mm_add_epi32(state1, cdghSave);
+    }
+
+    tmp    = _mm_shuffle_epi32(state0, 0x1B);           // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);           // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0);        // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);           // HGFE -> EFGH
+
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&ctx.state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&ctx.state[4]), state1);
+}
+
+#endif  // SOLACE_SHA256_SHANI
+
+
+#if defined(SOLACE_SHA256_ARMV8)
+
+/**
+ * ARMv8 crypto-extension compression: four rounds per sha256h/sha256h2 pair,
+ * with the message schedule computed by sha256su0/sha256su1.
+ */
+__attribute__((target("+crypto")))
+static void
+sha256_process_many_armv8(Sha256::State& ctx, const byte* data, Sha256::size_type blocks) {
+    uint32x4_t state0 = vld1q_u32(&ctx.state[0]);
+    uint32x4_t state1 = vld1q_u32(&ctx.state[4]);
+
+    for (; blocks > 0; --blocks, data += 64) {
+        const uint32x4_t abcdSave = state0;
+        const uint32x4_t efghSave = state1;
+
+        uint32x4_t msg0 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data +  0)));
+        uint32x4_t msg1 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16)));
+        uint32x4_t msg2 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 32)));
+        uint32x4_t msg3 = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 48)));
+
+        uint32x4_t tmp0 = vaddq_u32(msg0, vld1q_u32(&K[0]));
+        uint32x4_t tmp1;
+        uint32x4_t tmp2;
+
+        // Rounds 0-3
+        tmp1 = vaddq_u32(msg1, vld1q_u32(&K[4]));
+        tmp2 = state0;
+        msg0 = vsha256su0q_u32(msg0, msg1);
+        state0 = vsha256hq_u32(state0, state1, tmp0);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp0);
+        msg0 = vsha256su1q_u32(msg0, msg2, msg3);
+
+        // Rounds 4-7
+        tmp0 = vaddq_u32(msg2, vld1q_u32(&K[8]));
+        tmp2 = state0;
+        msg1 = vsha256su0q_u32(msg1, msg2);
+        state0 = vsha256hq_u32(state0, state1, tmp1);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp1);
+        msg1 = vsha256su1q_u32(msg1, msg3, msg0);
+
+        // Rounds 8-11
+        tmp1 = vaddq_u32(msg3, vld1q_u32(&K[12]));
+        tmp2 = state0;
+        msg2 = vsha256su0q_u32(msg2, msg3);
+        state0 = vsha256hq_u32(state0, state1, tmp0);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp0);
+        msg2 = vsha256su1q_u32(msg2, msg0, msg1);
+
+        // Rounds 12-15
+        tmp0 = vaddq_u32(msg0, vld1q_u32(&K[16]));
+        tmp2 = state0;
+        msg3 = vsha256su0q_u32(msg3, msg0);
+        state0 = vsha256hq_u32(state0, state1, tmp1);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp1);
+        msg3 = vsha256su1q_u32(msg3, msg1, msg2);
+
+        // Rounds 16-19
+        tmp1 = vaddq_u32(msg1, vld1q_u32(&K[20]));
+        tmp2 = state0;
+        msg0 = vsha256su0q_u32(msg0, msg1);
+        state0 = vsha256hq_u32(state0, state1, tmp0);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp0);
+        msg0 = vsha256su1q_u32(msg0, msg2, msg3);
+
+        // Rounds 20-23
+        tmp0 = vaddq_u32(msg2, vld1q_u32(&K[24]));
+        tmp2 = state0;
+        msg1 = vsha256su0q_u32(msg1, msg2);
+        state0 = vsha256hq_u32(state0, state1, tmp1);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp1);
+        msg1 = vsha256su1q_u32(msg1, msg3, msg0);
+
+        // Rounds 24-27
+        tmp1 = vaddq_u32(msg3, vld1q_u32(&K[28]));
+        tmp2 = state0;
+        msg2 = vsha256su0q_u32(msg2, msg3);
+        state0 = vsha256hq_u32(state0, state1, tmp0);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp0);
+        msg2 = vsha256su1q_u32(msg2, msg0, msg1);
+
+        // Rounds 28-31
+        tmp0 = vaddq_u32(msg0, vld1q_u32(&K[32]));
+        tmp2 = state0;
+        msg3 = vsha256su0q_u32(msg3, msg0);
+        state0 = vsha256hq_u32(state0, state1, tmp1);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp1);
+        msg3 = vsha256su1q_u32(msg3, msg1, msg2);
+
+        // Rounds 32-35
+        tmp1 = vaddq_u32(msg1, vld1q_u32(&K[36]));
+        tmp2 = state0;
+        msg0 = vsha256su0q_u32(msg0, msg1);
+        state0 = vsha256hq_u32(state0, state1, tmp0);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp0);
+        msg0 = vsha256su1q_u32(msg0, msg2, msg3);
+
+        // Rounds 36-39
+        tmp0 = vaddq_u32(msg2, vld1q_u32(&K[40]));
+        tmp2 = state0;
+        msg1 = vsha256su0q_u32(msg1, msg2);
+        state0 = vsha256hq_u32(state0, state1, tmp1);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp1);
+        msg1 = vsha256su1q_u32(msg1, msg3, msg0);
+
+        // Rounds 40-43
+        tmp1 = vaddq_u32(msg3, vld1q_u32(&K[44]));
+        tmp2 = state0;
+        msg2 = vsha256su0q_u32(msg2, msg3);
+        state0 = vsha256hq_u32(state0, state1, tmp0);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp0);
+        msg2 = vsha256su1q_u32(msg2, msg0, msg1);
+
+        // Rounds 44-47
+        tmp0 = vaddq_u32(msg0, vld1q_u32(&K[48]));
+        tmp2 = state0;
+        msg3 = vsha256su0q_u32(msg3, msg0);
+        state0 = vsha256hq_u32(state0, state1, tmp1);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp1);
+        msg3 = vsha256su1q_u32(msg3, msg1, msg2);
+
+        // Rounds 48-51
+        tmp1 = vaddq_u32(msg1, vld1q_u32(&K[52]));
+        tmp2 = state0;
+        state0 = vsha256hq_u32(state0, state1, tmp0);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp0);
+
+        // Rounds 52-55
+        tmp0 = vaddq_u32(msg2, vld1q_u32(&K[56]));
+        tmp2 = state0;
+        state0 = vsha256hq_u32(state0, state1, tmp1);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp1);
+
+        // Rounds 56-59
+        tmp1 = vaddq_u32(msg3, vld1q_u32(&K[60]));
+        tmp2 = state0;
+        state0 = vsha256hq_u32(state0, state1, tmp0);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp0);
+
+        // Rounds 60-63
+        tmp2 = state0;
+        state0 = vsha256hq_u32(state0, state1, tmp1);
+        state1 = vsha256h2q_u32(state1, tmp2, tmp1);
+
+        state0 = vaddq_u32(state0, abcdSave);
+        state1 = vaddq_u32(state1, efghSave);
+    }
+
+    vst1q_u32(&ctx.state[0], state0);
+    vst1q_u32(&ctx.state[4], state1);
+}
+
+#endif  // SOLACE_SHA256_ARMV8
+
+
+static Sha256CompressMany resolveSha256Compress() {
+#if defined(SOLACE_SHA256_SHANI)
+    if (cpuFeatures().sha && cpuFeatures().sse41) {
+        return sha256_process_many_shani;
+    }
+#elif defined(SOLACE_SHA256_ARMV8)
+    if (cpuFeatures().sha2) {
+        return sha256_process_many_armv8;
+    }
+#endif
+
+    return sha256_process_many_scalar;
+}
+
+
+static void
+sha256_process_many(Sha256::State& ctx, const byte* data, Sha256::size_type blocks) {
+    static const Sha256CompressMany compress = resolveSha256Compress();
+
+    compress(ctx, data, blocks);
+}
+
+
 void sha256_update(Sha256::State& ctx, const byte input[], Sha256::size_type ilen) {
     Sha256::size_type fill;
     uint32 left;
@@ -158,17 +523,18 @@ void sha256_update(Sha256::State& ctx, const byte input[], Sha256::size_type ile
 
     if (left && ilen >= fill) {
         memcpy((ctx.buffer + left), input, fill);
-        sha256_process(ctx, ctx.buffer);
+        sha256_process_many(ctx, ctx.buffer, 1);
 
         input += fill;
         ilen  -= fill;
         left = 0;
     }
 
-    while (ilen >= 64) {
-        sha256_process(ctx, input);
-        input += 64;
-        ilen  -= 64;
+    const auto blocks = ilen / 64;
+    if (blocks > 0) {
+        sha256_process_many(ctx, input, blocks);
+        input += 64 * blocks;
+        ilen  -= 64 * blocks;
     }
 
     if (ilen > 0) {
@@ -178,18 +544,53 @@ void sha256_update(Sha256::State& ctx, const byte input[], Sha256::size_type ile
 
 
 
-Sha256::Sha256() {
-    _state.total[0] = 0;
-    _state.total[1] = 0;
+static void sha256_init(Sha256::State& ctx) {
+    ctx.total[0] = 0;
+    ctx.total[1] = 0;
+
+    ctx.state[0] = 0x6a09e667;
+    ctx.state[1] = 0xbb67ae85;
+    ctx.state[2] = 0x3c6ef372;
+    ctx.state[3] = 0xa54ff53a;
+    ctx.state[4] = 0x510e527f;
+    ctx.state[5] = 0x9b05688c;
+    ctx.state[6] = 0x1f83d9ab;
+    ctx.state[7] = 0x5be0cd19;
+}
+
+
+static MessageDigest sha256_finish(Sha256::State& ctx) {
+    byte result[32];
+
+    uint32 high, low;
+    high = (ctx.total[0] >> 29) | (ctx.total[1] <<  3);
+    low  = (ctx.total[0] <<  3);
+
+    byte msglen[8];
+    putUint32_BE(high, msglen, 0);
+    putUint32_BE(low,  msglen, 4);
+
+    const uint32 last = ctx.total[0] & 0x3F;
+    const uint32 padn = (last < 56) ? (56 - last) : (120 - last);
 
-    _state.state[0] = 0x6a09e667;
-    _state.state[1] = 0xbb67ae85;
-    _state.state[2] = 0x3c6ef372;
-    _state.state[3] = 0xa54ff53a;
-    _state.state[4] = 0x510e527f;
-    _state.state[5] = 0x9b05688c;
-    _state.state[6] = 0x1f83d9ab;
-    _state.state[7] = 0x5be0cd19;
+    sha256_update(ctx, sha256_padding, padn);
+    sha256_update(ctx, msglen, 8);
+
+    putUint32_BE(ctx.state[0], result,  0);
+    putUint32_BE(ctx.state[1], result,  4);
+    putUint32_BE(ctx.state[2], result,  8);
+    putUint32_BE(ctx.state[3], result, 12);
+    putUint32_BE(ctx.state[4], result, 16);
+    putUint32_BE(ctx.state[5], result, 20);
+    putUint32_BE(ctx.state[6], result, 24);
+    putUint32_BE(ctx.state[7], result, 28);
+
+    return MessageDigest(wrapMemory(result));
+}
+
+
+Sha256::Sha256() {
+    sha256_init(_state);
 }
 
 
@@ -211,30 +612,152 @@ HashingAlgorithm& Sha256::update(ImmutableMemoryView input) {
 
 
 MessageDigest Sha256::digest() {
-    byte result[32];
+    return sha256_finish(_state);
+}
 
-    uint32 high, low;
-    high = (_state.total[0] >> 29) | (_state.total[1] <<  3);
-    low  = (_state.total[0] <<  3);
 
-    byte msglen[8];
-    putUint32_BE(high, msglen, 0);
-    putUint32_BE(low,  msglen, 4);
+#if defined(SOLACE_SHA256_SHANI)  // Any x86-64 GCC/clang build, not just one with SHA-NI hardware.
 
-    const uint32 last = _state.total[0] & 0x3F;
-    const uint32 padn = (last < 56) ? (56 - last) : (120 - last);
+#define VROTR(x, n) _mm256_or_si256(_mm256_srli_epi32((x), (n)), _mm256_slli_epi32((x), 32 - (n)))
 
-    sha256_update(_state, sha256_padding, padn);
-    sha256_update(_state, msglen, 8);
+/**
+ * Eight-lane SHA-256: one independent message per 32-bit AVX2 lane, all eight
+ * compressed in lockstep for the given number of 64-byte blocks. The round
+ * logic is the scalar compression verbatim, lifted onto vectors; only the
+ * message words are transposed on load.
+ */
+__attribute__((target("avx2")))
+static void
+sha256_process_x8(Sha256::State* states[8], const byte* data[8], Sha256::size_type blocks) {
+    alignas(32) uint32 lane[8];
 
-    putUint32_BE(_state.state[0], result,  0);
-    putUint32_BE(_state.state[1], result,  4);
-    putUint32_BE(_state.state[2], result,  8);
-    putUint32_BE(_state.state[3], result, 12);
-    putUint32_BE(_state.state[4], result, 16);
-    putUint32_BE(_state.state[5], result, 20);
-    putUint32_BE(_state.state[6], result, 24);
-    putUint32_BE(_state.state[7], result, 28);
+    __m256i s[8];
+    for (int w = 0; w < 8; ++w) {
+        for (int l = 0; l < 8; ++l) {
+            lane[l] = states[l]->state[w];
+        }
+        s[w] = _mm256_load_si256(reinterpret_cast<const __m256i*>(lane));
+    }
 
-    return MessageDigest(wrapMemory(result));
+    for (Sha256::size_type b = 0; b < blocks; ++b) {
+        __m256i W[16];
+        for (int t = 0; t < 16; ++t) {
+            for (int l = 0; l < 8; ++l) {
+                uint32 v;
+                memcpy(&v, data[l] + 64*b + 4*t, sizeof(v));
+                lane[l] = __builtin_bswap32(v);
+            }
+            W[t] = _mm256_load_si256(reinterpret_cast<const __m256i*>(lane));
+        }
+
+        __m256i a = s[0], bb = s[1], c = s[2], d = s[3];
+        __m256i e = s[4], f = s[5], g = s[6], h = s[7];
+
+        for (int t = 0; t < 64; ++t) {
+            if (t >= 16) {
+                const __m256i w15 = W[(t - 15) & 15];
+                const __m256i w2 = W[(t - 2) & 15];
+                const __m256i sig0 = _mm256_xor_si256(_mm256_xor_si256(VROTR(w15, 7), VROTR(w15, 18)),
+                                                      _mm256_srli_epi32(w15, 3));
+                const __m256i sig1 = _mm256_xor_si256(_mm256_xor_si256(VROTR(w2, 17), VROTR(w2, 19)),
+                                                      _mm256_srli_epi32(w2, 10));
+                W[t & 15] = _mm256_add_epi32(_mm256_add_epi32(W[t & 15], sig0),
+                                             _mm256_add_epi32(W[(t - 7) & 15], sig1));
+            }
+
+            const __m256i bigSig1 = _mm256_xor_si256(_mm256_xor_si256(VROTR(e, 6), VROTR(e, 11)), VROTR(e, 25));
+            const __m256i ch = _mm256_xor_si256(_mm256_and_si256(e, f), _mm256_andnot_si256(e, g));
+            const __m256i temp1 = _mm256_add_epi32(_mm256_add_epi32(_mm256_add_epi32(h, bigSig1),
+                                                                    _mm256_add_epi32(ch, _mm256_set1_epi32(K[t]))),
+                                                   W[t & 15]);
+            const __m256i bigSig0 = _mm256_xor_si256(_mm256_xor_si256(VROTR(a, 2), VROTR(a, 13)), VROTR(a, 22));
+            const __m256i maj = _mm256_xor_si256(_mm256_xor_si256(_mm256_and_si256(a, bb), _mm256_and_si256(a, c)),
+                                                 _mm256_and_si256(bb, c));
+            const __m256i temp2 = _mm256_add_epi32(bigSig0, maj);
+
+            h = g; g = f; f = e;
+            e = _mm256_add_epi32(d, temp1);
+            d = c; c = bb; bb = a;
+            a = _mm256_add_epi32(temp1, temp2);
+        }
+
+        s[0] = _mm256_add_epi32(s[0], a);
+        s[1] = _mm256_add_epi32(s[1], bb);
+        s[2] = _mm256_add_epi32(s[2], c);
+        s[3] = _mm256_add_epi32(s[3], d);
+        s[4] = _mm256_add_epi32(s[4], e);
+        s[5] = _mm256_add_epi32(s[5], f);
+        s[6] = _mm256_add_epi32(s[6], g);
+        s[7] = _mm256_add_epi32(s[7], h);
+    }
+
+    for (int w = 0; w < 8; ++w) {
+        _mm256_store_si256(reinterpret_cast<__m256i*>(lane), s[w]);
+        for (int l = 0; l < 8; ++l) {
+            states[l]->state[w] = lane[l];
+        }
+    }
+}
+
+#undef VROTR
+
+#endif  // SOLACE_SHA256_SHANI
+
+
+Array<MessageDigest>
+Solace::hashing::sha256Batch(ArrayView<ImmutableMemoryView> messages) {
+    Array<MessageDigest>::Storage digests;
+    digests.reserve(messages.size());
+
+#if defined(SOLACE_SHA256_SHANI)
+    static const bool haveAvx2 = cpuFeatures().avx2;
+
+    ArrayView<ImmutableMemoryView>::size_type i = 0;
+    if (haveAvx2) {
+        for (; i + 8 <= messages.size(); i += 8) {
+            Sha256::State states[8];
+            Sha256::State* statePtrs[8];
+            const byte* dataPtrs[8];
+
+            // Run all eight lanes in lockstep for as many blocks as the
+            // shortest message provides, then let the scalar code pad out
+            // each lane from wherever the vector pass left it:
+            Sha256::size_type commonBlocks = messages[i].size() / 64;
+            for (int l = 0; l < 8; ++l) {
+                sha256_init(states[l]);
+                statePtrs[l] = &states[l];
+                dataPtrs[l] = messages[i + l].dataAddress();
+                commonBlocks = std::min<Sha256::size_type>(commonBlocks, messages[i + l].size() / 64);
+            }
+
+            if (commonBlocks > 0) {
+                sha256_process_x8(statePtrs, dataPtrs, commonBlocks);
+            }
+
+            for (int l = 0; l < 8; ++l) {
+                auto& ctx = states[l];
+                const auto consumed = 64 * commonBlocks;
+
+                ctx.total[0] = static_cast<uint32>(consumed & 0xFFFFFFFF);
+                ctx.total[1] = static_cast<uint32>(consumed >> 32);
+                sha256_update(ctx, messages[i + l].dataAddress() + consumed, messages[i + l].size() - consumed);
+                digests.emplace_back(sha256_finish(ctx));
+            }
+        }
+    }
+
+    for (; i < messages.size(); ++i) {
+        Sha256 hash;
+        hash.update(messages[i]);
+        digests.emplace_back(hash.digest());
+    }
+#else
+    for (auto const& message : messages) {
+        Sha256 hash;
+        hash.update(message);
+        digests.emplace_back(hash.digest());
+    }
+#endif
+
+    return Array<MessageDigest>(std::move(digests));
 }
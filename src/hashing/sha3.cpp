@@ -19,10 +19,235 @@
  *	@brief		Implementation of SHA-3 hashing algorithm
  ******************************************************************************/
 #include "solace/hashing/sha3.hpp"
+#include "solace/exception.hpp"
+
+#include <memory.h>
 
 using namespace Solace;
 using namespace Solace::hashing;
 
+static const String SHA_3_NAME = "SHA3-256";
+
+// Sponge parameters of the FIPS 202 instances, in bytes:
+static const uint32 kSha3_256Rate = 136;
+static const uint32 kShake128Rate = 168;
+static const uint32 kShake256Rate = 136;
+
+// Domain separation suffixes, xored in front of the pad10*1 padding:
+static const byte kSha3Domain = 0x06;
+static const byte kShakeDomain = 0x1F;
+
+
+#define ROTL64(x, n) (((x) << (n)) | ((x) >> (64 - (n))))
+
+static const uint64 kRoundConstants[24] = {
+    0x0000000000000001ULL, 0x0000000000008082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+    0x000000000000808bULL, 0x0000000080000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+    0x000000000000008aULL, 0x0000000000000088ULL, 0x0000000080008009ULL, 0x000000008000000aULL,
+    0x000000008000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+    0x8000000000008002ULL, 0x8000000000000080ULL, 0x000000000000800aULL, 0x800000008000000aULL,
+    0x8000000080008081ULL, 0x8000000000008080ULL, 0x0000000080000001ULL, 0x8000000080008008ULL
+};
+
+// Rotation amounts and the lane permutation of the combined rho-pi step:
+static const int kRotations[24] = {
+     1,  3,  6, 10, 15, 21, 28, 36, 45, 55,  2, 14,
+    27, 41, 56,  8, 25, 43, 62, 18, 39, 61, 20, 44
+};
+
+static const int kPiLane[24] = {
+    10,  7, 11, 17, 18,  3,  5, 16,  8, 21, 24,  4,
+    15, 23, 19, 13, 12,  2, 20, 14, 22,  9,  6,  1
+};
+
+
+/**
+ * The Keccak-f[1600] permutation. All loops have constant trip counts and
+ * constant rotation amounts, so the optimizer unrolls the round body into
+ * straight-line rotate-xor code.
+ */
+static void keccakF1600(uint64 st[25]) {
+    uint64 bc[5];
+
+    for (int round = 0; round < 24; ++round) {
+        // Theta
+        for (int i = 0; i < 5; ++i) {
+            bc[i] = st[i] ^ st[i + 5] ^ st[i + 10] ^ st[i + 15] ^ st[i + 20];
+        }
+        for (int i = 0; i < 5; ++i) {
+            const uint64 t = bc[(i + 4) % 5] ^ ROTL64(bc[(i + 1) % 5], 1);
+            for (int j = 0; j < 25; j += 5) {
+                st[j + i] ^= t;
+            }
+        }
+
+        // Rho and Pi
+        uint64 t = st[1];
+        for (int i = 0; i < 24; ++i) {
+            const int j = kPiLane[i];
+            bc[0] = st[j];
+            st[j] = ROTL64(t, kRotations[i]);
+            t = bc[0];
+        }
+
+        // Chi
+        for (int j = 0; j < 25; j += 5) {
+            for (int i = 0; i < 5; ++i) {
+                bc[i] = st[j + i];
+            }
+            for (int i = 0; i < 5; ++i) {
+                st[j + i] ^= (~bc[(i + 1) % 5]) & bc[(i + 2) % 5];
+            }
+        }
+
+        // Iota
+        st[0] ^= kRoundConstants[round];
+    }
+}
+
+
+// Note - lanes are absorbed and squeezed as little-endian byte strings, which
+// on the little-endian hosts this library targets is a plain byte overlay of
+// the state. A big-endian port would need byte swaps here.
+
+static void sponge_init(Sha3::State& ctx, uint32 rate) {
+    memset(ctx.lanes, 0, sizeof(ctx.lanes));
+    ctx.rate = rate;
+    ctx.offset = 0;
+}
+
+
+static void sponge_absorb(Sha3::State& ctx, const byte* data, Sha3::size_type len) {
+    byte* state = reinterpret_cast<byte*>(ctx.lanes);
+
+    while (len > 0) {
+        const auto take = (len < ctx.rate - ctx.offset)
+                ? static_cast<uint32>(len)
+                : ctx.rate - ctx.offset;
+
+        for (uint32 i = 0; i < take; ++i) {
+            state[ctx.offset + i] ^= data[i];
+        }
+
+        data += take;
+        len -= take;
+        ctx.offset += take;
+
+        if (ctx.offset == ctx.rate) {
+            keccakF1600(ctx.lanes);
+            ctx.offset = 0;
+        }
+    }
+}
+
+
+static void sponge_finish(Sha3::State& ctx, byte domain) {
+    byte* state = reinterpret_cast<byte*>(ctx.lanes);
+
+    state[ctx.offset] ^= domain;
+    state[ctx.rate - 1] ^= 0x80;
+    keccakF1600(ctx.lanes);
+    ctx.offset = 0;
+}
+
+
+static void sponge_squeeze(Sha3::State& ctx, byte* out, Sha3::size_type len) {
+    const byte* state = reinterpret_cast<const byte*>(ctx.lanes);
+
+    while (len > 0) {
+        if (ctx.offset == ctx.rate) {
+            keccakF1600(ctx.lanes);
+            ctx.offset = 0;
+        }
+
+        const auto take = (len < ctx.rate - ctx.offset)
+                ? static_cast<uint32>(len)
+                : ctx.rate - ctx.offset;
+
+        memcpy(out, state + ctx.offset, take);
+        out += take;
+        len -= take;
+        ctx.offset += take;
+    }
+}
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+
 Sha3::Sha3() {
+    sponge_init(_state, kSha3_256Rate);
+}
+
+
+String Sha3::getAlgorithm() const {
+    return SHA_3_NAME;
+}
+
+
+Sha3::size_type Sha3::getDigestLength() const {
+    return 256 / 8;
+}
+
+
+HashingAlgorithm& Sha3::update(ImmutableMemoryView input) {
+    sponge_absorb(_state, input.dataAddress(), input.size());
+
+    return (*this);
+}
+
+
+MessageDigest Sha3::digest() {
+    byte result[32];
+
+    sponge_finish(_state, kSha3Domain);
+    sponge_squeeze(_state, result, sizeof(result));
+
+    // Reset for a new message, as the other digest algorithms do:
+    sponge_init(_state, kSha3_256Rate);
+
+    return MessageDigest(wrapMemory(result));
+}
+
+
+//-----------------------------------------------------------------------------
+//-----------------------------------------------------------------------------
+
+
+Shake::Shake(uint32 rateBytes) :
+    _squeezing(false)
+{
+    sponge_init(_state, rateBytes);
+}
+
+
+Shake& Shake::update(ImmutableMemoryView input) {
+    if (_squeezing) {
+        raise<Exception>("Shake: update() after read()");
+    }
+
+    sponge_absorb(_state, input.dataAddress(), input.size());
+
+    return (*this);
+}
+
+
+void Shake::read(MemoryView dest) {
+    if (!_squeezing) {
+        sponge_finish(_state, kShakeDomain);
+        _squeezing = true;
+    }
+
+    sponge_squeeze(_state, dest.dataAddress(), dest.size());
+}
+
+
+Shake128::Shake128() : Shake(kShake128Rate)
+{
+}
+
 
+Shake256::Shake256() : Shake(kShake256Rate)
+{
 }
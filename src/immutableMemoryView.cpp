@@ -37,6 +37,23 @@ using namespace Solace;
 constexpr int kOne = 1;
 
 
+Optional<ImmutableMemoryView::size_type>
+ImmutableMemoryView::findFirstOf(value_type value, size_type fromOffset) const {
+    assertIndexInRange(fromOffset, 0, size() + 1, "ImmutableMemoryView::findFirstOf() const");
+
+    if (fromOffset == size()) {
+        return none;
+    }
+
+    const auto* match = static_cast<value_type const*>(memchr(_dataAddress + fromOffset,
+                                                              value, size() - fromOffset));
+
+    return (match != nullptr)
+            ? Optional<size_type>(static_cast<size_type>(match - _dataAddress))
+            : none;
+}
+
+
 bool Solace::isBigendian() noexcept {
     return *reinterpret_cast<const char*>(&kOne) == 0;
 }
@@ -0,0 +1,226 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		io/asyncService.cpp
+ *	@author		$LastChangedBy: soultaker $
+ *	@date		$LastChangedDate$
+ *	@brief		Implementation of the async read/write service
+ *	ID:			$Id$
+ ******************************************************************************/
+#include "solace/io/asyncService.hpp"
+
+#include <cerrno>
+#include <cstring>
+
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+namespace /* anonymous */ {
+
+Error errorFromErrno(int errorCode) {
+    return Error(strerror(errorCode), errorCode);
+}
+
+}  // namespace
+
+
+Future<AsyncService::size_type>
+AsyncService::asyncRead(File& file, MemoryView buffer) {
+    Operation op;
+    op.writing = false;
+    op.readInto = std::move(buffer);
+    op.progress = 0;
+
+    auto future = op.completion.getFuture();
+    enqueue(file.getSelectId(), std::move(op));
+
+    return future;
+}
+
+
+Future<AsyncService::size_type>
+AsyncService::asyncWrite(File& file, ImmutableMemoryView buffer) {
+    Operation op;
+    op.writing = true;
+    op.writeFrom = std::move(buffer);
+    op.progress = 0;
+
+    auto future = op.completion.getFuture();
+    enqueue(file.getSelectId(), std::move(op));
+
+    return future;
+}
+
+
+void AsyncService::enqueue(ISelectable::poll_id fd, Operation&& op) {
+    auto& queue = _queues[fd];
+    queue.operations.push_back(std::move(op));
+
+    rearm(fd, queue);
+}
+
+
+void AsyncService::rearm(ISelectable::poll_id fd, FdQueue& queue) {
+    int wanted = 0;
+    for (const auto& op : queue.operations) {
+        wanted |= op.writing ? Selector::Events::Write : Selector::Events::Read;
+    }
+
+    if (wanted == queue.armedEvents) {
+        return;
+    }
+
+    // Deregister before re-adding: the poll backend keeps a flat list and
+    // would grow a duplicate entry on a bare re-add.
+    if (queue.armedEvents != 0) {
+        _selector.remove(fd);
+    }
+    if (wanted != 0) {
+        _selector.add(fd, wanted, nullptr);
+    }
+
+    queue.armedEvents = wanted;
+}
+
+
+uint32 AsyncService::drain(ISelectable::poll_id fd, FdQueue& queue, int readyEvents) {
+    uint32 completed = 0;
+
+    const bool failed = (readyEvents & Selector::Events::Error) != 0;
+
+    while (!queue.operations.empty()) {
+        auto& op = queue.operations.front();
+
+        if (failed) {
+            op.completion.setError(errorFromErrno(EIO));
+            queue.operations.pop_front();
+            ++completed;
+            continue;
+        }
+
+        // Hup still allows draining buffered data, so reads proceed on it:
+        const int needed = op.writing ? Selector::Events::Write
+                                      : (Selector::Events::Read | Selector::Events::Hup);
+        if ((readyEvents & needed) == 0) {
+            break;
+        }
+
+        if (op.writing) {
+            const auto chunk = ::write(fd,
+                                       op.writeFrom.dataAddress(op.progress),
+                                       op.writeFrom.size() - op.progress);
+            if (chunk < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;  // Descriptor is dry - wait for the next readiness edge.
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                op.completion.setError(errorFromErrno(errno));
+                queue.operations.pop_front();
+                ++completed;
+                continue;
+            }
+
+            op.progress += static_cast<size_type>(chunk);
+            if (op.progress < op.writeFrom.size()) {
+                continue;  // Short write: push the rest while the fd is willing.
+            }
+
+            op.completion.setValue(op.progress);
+            queue.operations.pop_front();
+            ++completed;
+        } else {
+            const auto chunk = ::read(fd, op.readInto.dataAddress(), op.readInto.size());
+            if (chunk < 0) {
+                if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                    break;
+                }
+                if (errno == EINTR) {
+                    continue;
+                }
+
+                op.completion.setError(errorFromErrno(errno));
+                queue.operations.pop_front();
+                ++completed;
+                continue;
+            }
+
+            op.completion.setValue(static_cast<size_type>(chunk));
+            queue.operations.pop_front();
+            ++completed;
+
+            if (chunk == 0) {  // End of stream completes every queued read with 0.
+                continue;
+            }
+        }
+    }
+
+    return completed;
+}
+
+
+uint32 AsyncService::poll(int msec) {
+    if (_queues.empty()) {
+        return 0;
+    }
+
+    // Descriptors touched this round are re-armed only after the iteration:
+    // the selector's event range must not be mutated while being walked.
+    _touched.clear();
+
+    uint32 completed = 0;
+    for (auto event : _selector.poll(msec)) {
+        const auto it = _queues.find(event.fd);
+        if (it == _queues.end()) {
+            continue;
+        }
+
+        completed += drain(event.fd, it->second, event.events);
+        _touched.push_back(event.fd);
+    }
+
+    for (const auto fd : _touched) {
+        const auto it = _queues.find(fd);
+        if (it == _queues.end()) {
+            continue;
+        }
+
+        rearm(it->first, it->second);
+
+        if (it->second.operations.empty()) {
+            _queues.erase(it);
+        }
+    }
+
+    return completed;
+}
+
+
+size_t AsyncService::outstanding() const noexcept {
+    size_t count = 0;
+    for (const auto& entry : _queues) {
+        count += entry.second.operations.size();
+    }
+
+    return count;
+}
@@ -0,0 +1,246 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/bufferedWriter.cpp
+*******************************************************************************/
+#include <solace/io/bufferedWriter.hpp>
+#include <solace/exception.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+namespace /*anonymous*/ {
+
+/** Write the whole block, riding out partial writes and EINTR.
+ * @return 0 on success, the failing errno otherwise. */
+int writeFully(int fd, const byte* data, size_t nbBytes) {
+    size_t written = 0;
+    while (written < nbBytes) {
+        const auto r = ::write(fd, data + written, nbBytes - written);
+        if (r < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+
+            return errno;
+        }
+
+        written += static_cast<size_t>(r);
+    }
+
+    return 0;
+}
+
+}  // namespace
+
+
+BufferedWriter::BufferedWriter(File& file, MemoryManager& allocator, size_type bufferSize, Options options) :
+    _file(&file),
+    _options(options),
+    _bufferSize(bufferSize),
+    _buffers{allocator.create(bufferSize), allocator.create(bufferSize)},
+    _flusher(&BufferedWriter::flusherLoop, this)
+{
+    if (bufferSize == 0) {
+        stop();
+        raise<IllegalArgumentException>("bufferSize");
+    }
+}
+
+
+BufferedWriter::~BufferedWriter() {
+    stop();
+}
+
+
+void BufferedWriter::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_guard);
+        if (_stopped) {
+            return;
+        }
+
+        _stopped = true;
+    }
+
+    _workPending.notify_all();
+    _spaceFreed.notify_all();
+
+    if (_flusher.joinable()) {
+        _flusher.join();
+    }
+}
+
+
+Result<void, Error>
+BufferedWriter::write(ImmutableMemoryView data) {
+    size_type taken = 0;
+
+    std::unique_lock<std::mutex> lock(_guard);
+    while (taken < data.size()) {
+        if (_stopped) {
+            return Err<Error>(StringView("BufferedWriter is stopped"));
+        }
+
+        if (_writeFailure != 0) {
+            return Err(Error(strerror(_writeFailure), _writeFailure));
+        }
+
+        const auto space = _bufferSize - _fill;
+        if (space == 0) {
+            // Both buffers are busy - backpressure until the flusher drains one:
+            _workPending.notify_one();
+            _spaceFreed.wait(lock);
+            continue;
+        }
+
+        const auto n = std::min<size_type>(space, data.size() - taken);
+        memcpy(_buffers[_active].view().dataAddress() + _fill, data.dataAddress() + taken, n);
+        _fill += n;
+        _accepted += n;
+        taken += n;
+    }
+
+    const bool wakeFlusher = (_fill >= _options.flushWatermark);
+    lock.unlock();
+
+    if (wakeFlusher) {
+        _workPending.notify_one();
+    }
+
+    return Ok();
+}
+
+
+Future<void> BufferedWriter::barrier() {
+    Promise<void> completion;
+    auto future = completion.getFuture();
+
+    {
+        std::lock_guard<std::mutex> lock(_guard);
+        if (_stopped) {
+            completion.setError(Error("BufferedWriter is stopped"));
+
+            return future;
+        }
+
+        if (_writeFailure != 0) {
+            completion.setError(Error(strerror(_writeFailure), _writeFailure));
+
+            return future;
+        }
+
+        _barriers.push_back(BarrierRequest{std::move(completion)});
+    }
+
+    _workPending.notify_one();
+
+    return future;
+}
+
+
+void BufferedWriter::flusherLoop() {
+    std::vector<BarrierRequest> covered;
+
+    std::unique_lock<std::mutex> lock(_guard);
+    for (;;) {
+        // Wait for a reason to flush: watermark, barrier, stop - or, for a
+        // partially filled buffer, the flush interval running out.
+        while (!_stopped && _barriers.empty() && _fill < _options.flushWatermark) {
+            if (_fill > 0 && _options.flushIntervalMs > 0) {
+                const auto status = _workPending.wait_for(
+                            lock, std::chrono::milliseconds(_options.flushIntervalMs));
+                if (status == std::cv_status::timeout) {
+                    break;  // Timed flush of what has trickled in.
+                }
+            } else {
+                _workPending.wait(lock);
+            }
+        }
+
+        if (_fill == 0 && _barriers.empty()) {
+            if (_stopped) {
+                return;
+            }
+
+            continue;
+        }
+
+        // Swap the staging buffers: writers refill one while we drain the other.
+        const auto flushing = _active;
+        const auto nbBytes = _fill;
+        _active ^= 1;
+        _fill = 0;
+
+        covered.swap(_barriers);
+
+        lock.unlock();
+        _spaceFreed.notify_all();
+
+        int failure = 0;
+        if (nbBytes > 0) {
+            failure = writeFully(_file->getSelectId(),
+                                 _buffers[flushing].view().dataAddress(), nbBytes);
+        }
+
+        if (failure != 0) {
+            for (auto& barrier : covered) {
+                barrier.completion.setError(Error(strerror(failure), failure));
+            }
+            covered.clear();
+
+            lock.lock();
+            _writeFailure = failure;
+            continue;
+        }
+
+        if (!covered.empty()) {
+            if (_options.syncService != nullptr) {
+                // Durable barriers: complete once the group commit confirms
+                // the bytes are on stable storage.
+                auto pending = std::make_shared<std::vector<BarrierRequest>>(std::move(covered));
+                _options.syncService->sync(*_file)
+                        .then([pending]() {
+                            for (auto& barrier : *pending) {
+                                barrier.completion.setValue();
+                            }
+                        })
+                        .onError([pending](Error&& e) {
+                            for (auto& barrier : *pending) {
+                                barrier.completion.setError(Error(e));
+                            }
+                        });
+                covered = std::vector<BarrierRequest>();
+            } else {
+                for (auto& barrier : covered) {
+                    barrier.completion.setValue();
+                }
+                covered.clear();
+            }
+        }
+
+        lock.lock();
+    }
+}
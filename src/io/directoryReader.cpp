@@ -0,0 +1,254 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/directoryReader.cpp
+*******************************************************************************/
+#include <solace/io/directoryReader.hpp>
+#include <solace/exception.hpp>
+
+#include <condition_variable>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <cerrno>
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+#ifdef SOLACE_PLATFORM_LINUX
+#include <sys/syscall.h>
+#endif
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+namespace {
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+/* The raw getdents64 record; glibc's struct dirent64 matches the layout but
+ * going through the syscall directly lets the kernel fill the caller's arena
+ * with no intermediate buffer.
+ */
+struct LinuxDirent64 {
+    uint64  d_ino;
+    int64   d_off;
+    uint16  d_reclen;
+    byte    d_type;
+    char    d_name[1];
+};
+
+long bulkReadDirents(int fd, void* buffer, size_t bufferSize) {
+    return syscall(SYS_getdents64, fd, buffer, bufferSize);
+}
+
+#endif  // SOLACE_PLATFORM_LINUX
+
+
+DirectoryReader::Type typeOfDirent(byte kernelType) noexcept {
+    switch (kernelType) {
+    case DT_REG:    return DirectoryReader::Type::File;
+    case DT_DIR:    return DirectoryReader::Type::Directory;
+    case DT_LNK:    return DirectoryReader::Type::Symlink;
+    case DT_UNKNOWN: return DirectoryReader::Type::Unknown;
+    default:        return DirectoryReader::Type::Other;
+    }
+}
+
+bool isDotOrDotDot(const char* name) noexcept {
+    return name[0] == '.' && (name[1] == '\0' || (name[1] == '.' && name[2] == '\0'));
+}
+
+/// Arena size used by walk(): big enough to swallow most directories in one syscall.
+constexpr size_t kWalkArenaSize = 64 * 1024;
+constexpr size_t kWalkBatchSize = 1024;
+
+}  // namespace
+
+
+DirectoryReader::DirectoryReader(Path const& path) {
+    auto const pathString = path.toString();
+
+    _fd = ::open(pathString.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (_fd < 0) {
+        raise<IOException>(errno, "open");
+    }
+}
+
+
+DirectoryReader::~DirectoryReader() {
+    if (_fd >= 0) {
+        ::close(_fd);
+        _fd = -1;
+    }
+}
+
+
+DirectoryReader::size_type
+DirectoryReader::read(MemoryView arena, ArrayView<Entry> entries) {
+#ifdef SOLACE_PLATFORM_LINUX
+    if (arena.empty() || entries.empty()) {
+        return 0;
+    }
+
+    // d_off of an entry is the directory position of the one after it; keep
+    // the last consumed position so parsing can stop mid-batch and resume.
+    auto resumeAt = ::lseek(_fd, 0, SEEK_CUR);
+
+    auto const bytesRead = bulkReadDirents(_fd, arena.dataAddress(), arena.size());
+    if (bytesRead < 0) {
+        raise<IOException>(errno, "getdents64");
+    }
+
+    size_type produced = 0;
+    size_t offset = 0;
+    while (offset < static_cast<size_t>(bytesRead)) {
+        auto const* dirent = reinterpret_cast<LinuxDirent64 const*>(arena.dataAddress() + offset);
+
+        if (produced >= entries.size()) {
+            // Out of entry slots with dirents left over: rewind the directory
+            // cursor so the next read() resumes exactly where parsing stopped.
+            ::lseek(_fd, resumeAt, SEEK_SET);
+            break;
+        }
+
+        if (!isDotOrDotDot(dirent->d_name)) {
+            entries[produced].name = StringView(dirent->d_name);
+            entries[produced].type = typeOfDirent(dirent->d_type);
+            produced += 1;
+        }
+
+        resumeAt = static_cast<off_t>(dirent->d_off);
+        offset += dirent->d_reclen;
+    }
+
+    return produced;
+#else
+    (void)arena;
+    (void)entries;
+    raise<IOException>("DirectoryReader is not supported on this platform");
+    return 0;
+#endif
+}
+
+
+namespace {
+
+void scanOneDirectory(Path const& directory,
+                      DirectoryReader::Visitor const& visit,
+                      std::vector<Path>& subdirectories) {
+    DirectoryReader reader(directory);
+
+    std::vector<byte> arena(kWalkArenaSize);
+    std::vector<DirectoryReader::Entry> entries(kWalkBatchSize);
+
+    auto arenaView = wrapMemory(arena.data(), arena.size());
+    auto entriesView = ArrayView<DirectoryReader::Entry>(entries.data(), entries.size());
+
+    for (;;) {
+        auto const count = reader.read(arenaView, entriesView);
+        if (count == 0) {
+            break;
+        }
+
+        for (DirectoryReader::size_type i = 0; i < count; ++i) {
+            visit(directory, entries[i]);
+
+            if (entries[i].type == DirectoryReader::Type::Directory) {
+                subdirectories.push_back(Path::join(directory, entries[i].name));
+            }
+        }
+    }
+}
+
+}  // namespace
+
+
+void DirectoryReader::walk(Path const& root, Visitor const& visit, uint32 parallelism) {
+    if (parallelism <= 1) {
+        std::vector<Path> pending;
+        pending.push_back(root);
+
+        while (!pending.empty()) {
+            auto directory = std::move(pending.back());
+            pending.pop_back();
+
+            scanOneDirectory(directory, visit, pending);
+        }
+
+        return;
+    }
+
+    std::mutex guard;
+    std::condition_variable workAvailable;
+    std::deque<Path> pending;
+    uint32 scanning = 0;
+    bool done = false;
+
+    pending.push_back(root);
+
+    auto const workerLoop = [&]() {
+        std::vector<Path> discovered;
+
+        std::unique_lock<std::mutex> lock(guard);
+        for (;;) {
+            while (pending.empty() && !done) {
+                workAvailable.wait(lock);
+            }
+
+            if (done && pending.empty()) {
+                return;
+            }
+
+            auto directory = std::move(pending.front());
+            pending.pop_front();
+            scanning += 1;
+            lock.unlock();
+
+            discovered.clear();
+            scanOneDirectory(directory, visit, discovered);
+
+            lock.lock();
+            scanning -= 1;
+            for (auto& subdirectory : discovered) {
+                pending.push_back(std::move(subdirectory));
+            }
+
+            if (!discovered.empty()) {
+                workAvailable.notify_all();
+            } else if (pending.empty() && scanning == 0) {
+                // The tree is exhausted; let everybody drain out.
+                done = true;
+                workAvailable.notify_all();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(parallelism);
+    for (uint32 i = 0; i < parallelism; ++i) {
+        workers.emplace_back(workerLoop);
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
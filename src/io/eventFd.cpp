@@ -0,0 +1,91 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/eventFd.cpp
+*******************************************************************************/
+#include <solace/io/eventFd.hpp>
+#include <solace/exception.hpp>
+
+#include <cerrno>
+
+#ifdef SOLACE_PLATFORM_LINUX
+#include <sys/eventfd.h>
+#endif
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+EventFd EventFd::create(Mode mode, uint64 initialValue) {
+    int flags = EFD_NONBLOCK | EFD_CLOEXEC;
+    if (mode == Mode::Semaphore) {
+        flags |= EFD_SEMAPHORE;
+    }
+
+    auto const fd = eventfd(static_cast<unsigned int>(initialValue), flags);
+    if (fd < 0) {
+        raise<IOException>(errno, "eventfd");
+    }
+
+    return EventFd(fd);
+}
+
+
+EventFd::~EventFd() {
+    if (_fd != ISelectable::InvalidFd) {
+        ::close(_fd);
+        _fd = ISelectable::InvalidFd;
+    }
+}
+
+
+void EventFd::notify(uint64 count) {
+    for (;;) {
+        auto const written = ::write(_fd, &count, sizeof(count));
+        if (written == sizeof(count)) {
+            return;
+        }
+
+        if (errno != EINTR) {
+            raise<IOException>(errno, "write");
+        }
+    }
+}
+
+
+uint64 EventFd::take() {
+    uint64 count = 0;
+    for (;;) {
+        auto const bytesRead = ::read(_fd, &count, sizeof(count));
+        if (bytesRead == sizeof(count)) {
+            return count;
+        }
+
+        if (errno == EAGAIN || errno == EWOULDBLOCK) {
+            return 0;
+        }
+
+        if (errno != EINTR) {
+            raise<IOException>(errno, "read");
+        }
+    }
+}
+
+#endif  // SOLACE_PLATFORM_LINUX
@@ -26,9 +26,16 @@
 
 #include <sys/stat.h>
 #include <sys/types.h>
+#include <sys/uio.h>    // writev
 #include <fcntl.h>
 #include <unistd.h>
 
+#include <sys/mman.h>   // mmap, madvise
+
+#ifdef SOLACE_PLATFORM_LINUX
+#include <sys/sendfile.h>
+#endif
+
 
 using Solace::IOObject;
 using Solace::String;
@@ -78,6 +85,12 @@ const int File::Mode::IWOTH = S_IWOTH;
 const int File::Mode::IXOTH = S_IXOTH;
 
 
+const int File::MapProtection::None = PROT_NONE;
+const int File::MapProtection::Exec = PROT_EXEC;
+const int File::MapProtection::Read = PROT_READ;
+const int File::MapProtection::Write = PROT_WRITE;
+
+
 File::File() : File(ISelectable::InvalidFd) {
 
 }
@@ -156,6 +169,174 @@ File::read(MemoryView& buffer) {
 }
 
 
+IOObject::IOResult
+File::read(ArrayView<MemoryView> buffers) {
+    const auto fd = validateFd();
+
+    struct iovec iov[MaxIOSegments];
+    const auto segmentCount = (buffers.size() < MaxIOSegments) ? static_cast<uint32>(buffers.size())
+                                                               : MaxIOSegments;
+    for (uint32 i = 0; i < segmentCount; ++i) {
+        iov[i].iov_base = buffers[i].dataAddress();
+        iov[i].iov_len = buffers[i].size();
+    }
+
+    const auto bytesRead = ::readv(fd, iov, static_cast<int>(segmentCount));
+
+    if (bytesRead < 0) {
+        raise<IOException>(errno);
+    }
+
+    return IOObject::IOResult(bytesRead);
+}
+
+
+IOObject::IOResult
+File::readAt(size_type offset, MemoryView& buffer) {
+    const auto fd = validateFd();
+    const auto bytesRead = ::pread(fd, buffer.dataAddress(), buffer.size(), static_cast<off_t>(offset));
+
+    if (bytesRead < 0) {
+        raise<IOException>(errno);
+    }
+
+    return IOObject::IOResult(bytesRead);
+}
+
+
+IOObject::IOResult
+File::writeAt(size_type offset, const Solace::ImmutableMemoryView& buffer) {
+    const auto fd = validateFd();
+    const auto bytesWritten = ::pwrite(fd, buffer.dataAddress(), buffer.size(), static_cast<off_t>(offset));
+
+    if (bytesWritten < 0) {
+        raise<IOException>(errno);
+    }
+
+    return IOObject::IOResult(bytesWritten);
+}
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+namespace /*anonymous*/ {
+
+/** splice() fallback for transferTo: move bytes through a transient pipe, still in-kernel. */
+size_t spliceThroughPipe(int srcFd, int destFd, size_t bytesToTransfer) {
+    int pipeFds[2];
+    if (-1 == pipe2(pipeFds, O_CLOEXEC)) {
+        Solace::raise<Solace::IOException>(errno);
+    }
+
+    size_t total = 0;
+    int transferErrno = 0;
+    while (total < bytesToTransfer && transferErrno == 0) {
+        auto inFlight = splice(srcFd, nullptr, pipeFds[1], nullptr,
+                               bytesToTransfer - total, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (inFlight < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            transferErrno = errno;
+            break;
+        }
+        if (inFlight == 0) {
+            break;  // Source exhausted.
+        }
+
+        while (inFlight > 0) {
+            const auto sent = splice(pipeFds[0], nullptr, destFd, nullptr,
+                                     static_cast<size_t>(inFlight), SPLICE_F_MOVE | SPLICE_F_MORE);
+            if (sent < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                transferErrno = errno;
+                break;
+            }
+
+            inFlight -= sent;
+            total += sent;
+        }
+    }
+
+    close(pipeFds[0]);
+    close(pipeFds[1]);
+
+    if (transferErrno != 0) {
+        Solace::raise<Solace::IOException>(transferErrno);
+    }
+
+    return total;
+}
+
+}  // namespace
+#endif  // SOLACE_PLATFORM_LINUX
+
+
+IOObject::IOResult
+File::transferTo(ISelectable& dest, size_type bytesToTransfer) {
+    const auto fd = validateFd();
+    const auto destFd = dest.getSelectId();
+    const auto bytesWanted = (bytesToTransfer > 0) ? static_cast<size_t>(bytesToTransfer) : 0;
+
+    size_t total = 0;
+
+#ifdef SOLACE_PLATFORM_LINUX
+    while (total < bytesWanted) {
+        const auto sent = ::sendfile(destFd, fd, nullptr, bytesWanted - total);
+
+        if (sent < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            // sendfile requires an mmap-able source; splice covers the rest:
+            if ((errno == EINVAL || errno == ENOSYS) && total == 0) {
+                return IOObject::IOResult(spliceThroughPipe(fd, destFd, bytesWanted));
+            }
+            raise<IOException>(errno);
+        }
+        if (sent == 0) {
+            break;  // Source exhausted.
+        }
+
+        total += sent;
+    }
+#else
+    // No zero-copy facility on this platform - copy through a bounce buffer.
+    Solace::byte bounce[16 * 1024];
+    while (total < bytesWanted) {
+        const auto chunk = (sizeof(bounce) < bytesWanted - total) ? sizeof(bounce) : (bytesWanted - total);
+        const auto bytesRead = ::read(fd, bounce, chunk);
+        if (bytesRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            raise<IOException>(errno);
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+
+        ssize_t written = 0;
+        while (written < bytesRead) {
+            const auto bytesWritten = ::write(destFd, bounce + written, bytesRead - written);
+            if (bytesWritten < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                raise<IOException>(errno);
+            }
+            written += bytesWritten;
+        }
+
+        total += bytesRead;
+    }
+#endif  // SOLACE_PLATFORM_LINUX
+
+    return IOObject::IOResult(total);
+}
+
+
 IOObject::IOResult
 File::write(const Solace::ImmutableMemoryView& buffer) {
     const auto fd = validateFd();
@@ -169,6 +350,120 @@ File::write(const Solace::ImmutableMemoryView& buffer) {
 }
 
 
+IOObject::TryResult
+File::tryRead(MemoryView& buffer) {
+    if (!isOpened()) {
+        return Err(systemError(EBADF));
+    }
+
+    const auto bytesRead = ::read(_fd, buffer.dataAddress(), buffer.size());
+    if (bytesRead < 0) {
+        return Err(systemError(errno));
+    }
+
+    return Ok(static_cast<size_type>(bytesRead));
+}
+
+
+IOObject::TryResult
+File::tryWrite(const Solace::ImmutableMemoryView& buffer) {
+    if (!isOpened()) {
+        return Err(systemError(EBADF));
+    }
+
+    const auto bytesWritten = ::write(_fd, buffer.dataAddress(), buffer.size());
+    if (bytesWritten < 0) {
+        return Err(systemError(errno));
+    }
+
+    return Ok(static_cast<size_type>(bytesWritten));
+}
+
+
+IOObject::IOResult
+File::write(const Solace::CompositeMemoryView& buffer) {
+    const auto fd = validateFd();
+
+    struct iovec iov[CompositeMemoryView::MaxSegments];
+    const auto segmentCount = buffer.count();
+    for (uint32 i = 0; i < segmentCount; ++i) {
+        auto const& segment = buffer.segment(i);
+        iov[i].iov_base = const_cast<byte*>(segment.dataAddress());
+        iov[i].iov_len = segment.size();
+    }
+
+    const auto bytesWritten = ::writev(fd, iov, static_cast<int>(segmentCount));
+
+    if (bytesWritten < 0) {
+        raise<IOException>(errno);
+    }
+
+    return IOObject::IOResult(bytesWritten);
+}
+
+
+
+namespace /*anonymous*/ {
+
+class FileMappingDisposer : public Solace::MemoryViewDisposer {
+public:
+
+    void dispose(Solace::ImmutableMemoryView* view) const override {
+        const auto size = view->size();
+        auto addr = const_cast<Solace::ImmutableMemoryView::value_type*>(view->dataAddress());
+        if (addr && size > 0) {
+            const auto result = munmap(addr, size);
+            if (result != 0) {
+                Solace::raise<IOException>(errno, "munmap");
+            }
+        }
+    }
+};
+
+static FileMappingDisposer g_fileMappingDisposer;
+
+}  // namespace
+
+
+Solace::MemoryBuffer
+File::map(size_type offset, MemoryView::size_type mapSize, MapSharing sharing, int protection) {
+    const auto fd = validateFd();
+
+    if (mapSize == 0) {
+        Solace::raise<IllegalArgumentException>("mapSize");
+    }
+
+    int flags = 0;
+    switch (sharing) {
+    case MapSharing::Private: flags |= MAP_PRIVATE; break;
+    case MapSharing::Shared: flags |= MAP_SHARED; break;
+    }
+
+    auto addr = mmap(nullptr, mapSize, protection, flags, fd, static_cast<off_t>(offset));
+    if (addr == MAP_FAILED) {
+        Solace::raise<IOException>(errno, "mmap");
+    }
+
+    return Solace::MemoryBuffer(Solace::wrapMemory(addr, mapSize), &g_fileMappingDisposer);
+}
+
+
+void File::advise(const Solace::ImmutableMemoryView& mapping, MapAdvice advice) {
+    int nativeAdvice = MADV_NORMAL;
+    switch (advice) {
+    case MapAdvice::Normal:     nativeAdvice = MADV_NORMAL; break;
+    case MapAdvice::Sequential: nativeAdvice = MADV_SEQUENTIAL; break;
+    case MapAdvice::Random:     nativeAdvice = MADV_RANDOM; break;
+    case MapAdvice::WillNeed:   nativeAdvice = MADV_WILLNEED; break;
+    case MapAdvice::DontNeed:   nativeAdvice = MADV_DONTNEED; break;
+    }
+
+    auto addr = const_cast<Solace::ImmutableMemoryView::value_type*>(mapping.dataAddress());
+    if (-1 == madvise(addr, mapping.size(), nativeAdvice)) {
+        Solace::raise<IOException>(errno, "madvise");
+    }
+}
+
 
 File::size_type File::seek(size_type offset, Seek type) {
     const auto fd = validateFd();
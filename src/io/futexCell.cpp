@@ -0,0 +1,117 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/futexCell.cpp
+*******************************************************************************/
+#include <solace/io/futexCell.hpp>
+#include <solace/exception.hpp>
+
+#include <cerrno>
+
+#ifdef SOLACE_PLATFORM_LINUX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <sys/time.h>
+#include <unistd.h>
+#endif
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+namespace {
+
+/* No glibc wrapper exists for futex; go through syscall() directly.
+ * FUTEX_PRIVATE_FLAG is deliberately NOT used: the whole point of the cell
+ * is waking across process boundaries through a shared mapping.
+ */
+long futexCall(std::atomic<uint32>* addr, int op, uint32 value, const struct timespec* timeout) {
+    return syscall(SYS_futex, reinterpret_cast<uint32*>(addr), op, value, timeout, nullptr, 0);
+}
+
+}  // namespace
+
+
+FutexCell& FutexCell::at(MemoryView view) {
+    if (view.size() < sizeof(FutexCell)) {
+        raise<IllegalArgumentException>("view");
+    }
+
+    auto* address = view.dataAddress();
+    if (reinterpret_cast<uintptr_t>(address) % alignof(value_type) != 0) {
+        raise<IllegalArgumentException>("view");
+    }
+
+    return *reinterpret_cast<FutexCell*>(address);
+}
+
+
+bool FutexCell::wait(value_type expected, int timeoutMs) {
+    struct timespec timeout;
+    struct timespec* timeoutPtr = nullptr;
+    if (timeoutMs >= 0) {
+        timeout.tv_sec = timeoutMs / 1000;
+        timeout.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+        timeoutPtr = &timeout;
+    }
+
+    for (;;) {
+        if (_value.load(std::memory_order_acquire) != expected) {
+            return true;
+        }
+
+        auto const result = futexCall(&_value, FUTEX_WAIT, expected, timeoutPtr);
+        if (result == 0) {
+            continue;  // Woken up - re-check, wakeups may be spurious.
+        }
+
+        switch (errno) {
+        case EAGAIN:        // The value changed before the kernel could sleep.
+            return true;
+        case EINTR:         // Interrupted by a signal - go around.
+            continue;
+        case ETIMEDOUT:
+            return false;
+        default:
+            raise<IOException>(errno, "futex(FUTEX_WAIT)");
+        }
+    }
+}
+
+
+int FutexCell::wakeOne() {
+    auto const woken = futexCall(&_value, FUTEX_WAKE, 1, nullptr);
+    if (woken < 0) {
+        raise<IOException>(errno, "futex(FUTEX_WAKE)");
+    }
+
+    return static_cast<int>(woken);
+}
+
+
+int FutexCell::wakeAll() {
+    auto const woken = futexCall(&_value, FUTEX_WAKE, INT32_MAX, nullptr);
+    if (woken < 0) {
+        raise<IOException>(errno, "futex(FUTEX_WAKE)");
+    }
+
+    return static_cast<int>(woken);
+}
+
+#endif  // SOLACE_PLATFORM_LINUX
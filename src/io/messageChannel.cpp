@@ -0,0 +1,134 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		solace/io/messageChannel.cpp
+ ******************************************************************************/
+#include <solace/io/messageChannel.hpp>
+#include <solace/exception.hpp>
+
+#include <cstring>  // memmove
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+MessageChannel::MessageChannel(Duplex& channel, MemoryManager& allocator, size_type maxMessageSize) :
+    _channel(&channel),
+    _maxMessageSize(maxMessageSize),
+    _sendStorage(allocator.create(maxMessageSize + Framing::kOverhead)),
+    _sendBuffer(_sendStorage.view()),
+    _recvStorage(allocator.create(maxMessageSize + Framing::kOverhead)),
+    _messageStorage(allocator.create(maxMessageSize)),
+    _decoder(maxMessageSize)
+{
+    if (maxMessageSize == 0) {
+        raise<IllegalArgumentException>("maxMessageSize");
+    }
+}
+
+
+Result<void, Error>
+MessageChannel::sendMessage(ImmutableMemoryView message) {
+    if (message.size() > _maxMessageSize) {
+        return Err(Error("OverflowError: message exceeds maxMessageSize"));
+    }
+
+    // No room for this frame in the current batch - push the batch out first:
+    if (_sendBuffer.remaining() < message.size() + Framing::kOverhead) {
+        auto flushed = flushMessages();
+        if (flushed.isError()) {
+            return flushed;
+        }
+    }
+
+    FrameEncoder encoder(_sendBuffer);
+    auto encoded = encoder.encode(message);
+    if (encoded.isOk()) {
+        ++_pendingMessages;
+    }
+
+    return encoded;
+}
+
+
+Result<void, Error>
+MessageChannel::flushMessages() {
+    const auto pending = _sendBuffer.position();
+    if (pending == 0) {
+        return Ok();
+    }
+
+    size_type written = 0;
+    while (written < pending) {
+        auto sent = _channel->write(_sendStorage.view().slice(written, pending));
+        if (sent.isError()) {
+            return Err(sent.moveError());
+        }
+
+        written += static_cast<size_type>(sent.unwrap());
+    }
+
+    _sendBuffer.rewind();
+    _pendingMessages = 0;
+
+    return Ok();
+}
+
+
+Result<MemoryView, Error>
+MessageChannel::receiveMessage() {
+    for (;;) {
+        // First try to cut a frame out of the bytes already buffered:
+        if (_recvFill > _recvPos) {
+            ReadBuffer reader(ImmutableMemoryView(_recvStorage.view().slice(_recvPos, _recvFill)));
+            auto decoded = _decoder.decode(reader, _messageStorage.view());
+            if (decoded.isError()) {
+                return Err(decoded.moveError());
+            }
+
+            // The decoder consumes a whole frame or skips garbage - never
+            // un-reads, so whatever it advanced past is done with:
+            _recvPos += static_cast<size_type>(reader.position());
+
+            if (decoded.unwrap().isSome()) {
+                return Ok(_messageStorage.view().slice(0, decoded.unwrap().get()));
+            }
+        }
+
+        // A partial frame: move it to the front and pull more of the stream in.
+        if (_recvPos != 0) {
+            const auto remaining = _recvFill - _recvPos;
+            memmove(_recvStorage.view().dataAddress(),
+                    _recvStorage.view().dataAddress(_recvPos), remaining);
+            _recvFill = remaining;
+            _recvPos = 0;
+        }
+
+        auto dest = _recvStorage.view().slice(_recvFill, _recvStorage.size());
+        auto got = _channel->read(dest);
+        if (got.isError()) {
+            return Err(got.moveError());
+        }
+
+        if (got.unwrap() == 0) {
+            return Err(Error("MessageChannel: stream closed by peer"));
+        }
+
+        _recvFill += static_cast<size_type>(got.unwrap());
+    }
+}
@@ -54,3 +54,118 @@ Pipe::Pipe(Pipe&& duplex) : Duplex(std::move(duplex))
 {
 }
 
+
+Pipe::size_type Pipe::capacity() const {
+#ifdef F_GETPIPE_SZ
+    const auto nbBytes = fcntl(getWriteEnd().getSelectId(), F_GETPIPE_SZ);
+    if (nbBytes < 0) {
+        Solace::raise<IOException>(errno, "fcntl(F_GETPIPE_SZ)");
+    }
+
+    return nbBytes;
+#else
+    return 0;
+#endif
+}
+
+
+Pipe::size_type Pipe::setCapacity(size_type nbBytes) {
+#ifdef F_SETPIPE_SZ
+    // The kernel resizes the buffer, rounds the request up and reports what it granted:
+    const auto granted = fcntl(getWriteEnd().getSelectId(), F_SETPIPE_SZ, static_cast<int>(nbBytes));
+    if (granted < 0) {
+        Solace::raise<IOException>(errno, "fcntl(F_SETPIPE_SZ)");
+    }
+
+    return granted;
+#else
+    Solace::raise<IOException>(ENOSYS, "fcntl(F_SETPIPE_SZ)");
+    return nbBytes;
+#endif
+}
+
+
+IOObject::IOResult
+Pipe::relayTo(ISelectable& dest, size_type bytesToRelay) {
+    const auto destFd = dest.getSelectId();
+    const auto bytesWanted = (bytesToRelay > 0) ? static_cast<size_t>(bytesToRelay) : 0;
+
+    size_t total = 0;
+
+#ifdef SOLACE_PLATFORM_LINUX
+    while (total < bytesWanted) {
+        const auto moved = ::splice(getReadEnd().getSelectId(), nullptr, destFd, nullptr,
+                                    bytesWanted - total, SPLICE_F_MOVE | SPLICE_F_MORE);
+        if (moved < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            raise<IOException>(errno, "splice");
+        }
+        if (moved == 0) {
+            break;  // Write side closed and the buffer drained.
+        }
+
+        total += moved;
+    }
+#else
+    // No splice on this platform - copy through a bounce buffer.
+    Solace::byte bounce[16 * 1024];
+    while (total < bytesWanted) {
+        const auto chunk = (sizeof(bounce) < bytesWanted - total) ? sizeof(bounce) : (bytesWanted - total);
+        const auto bytesRead = ::read(getReadEnd().getSelectId(), bounce, chunk);
+        if (bytesRead < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            raise<IOException>(errno);
+        }
+        if (bytesRead == 0) {
+            break;
+        }
+
+        ssize_t written = 0;
+        while (written < bytesRead) {
+            const auto bytesWritten = ::write(destFd, bounce + written, bytesRead - written);
+            if (bytesWritten < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                raise<IOException>(errno);
+            }
+            written += bytesWritten;
+        }
+
+        total += bytesRead;
+    }
+#endif  // SOLACE_PLATFORM_LINUX
+
+    return IOObject::IOResult(total);
+}
+
+
+IOObject::IOResult
+Pipe::teeTo(Pipe& dest, size_type bytesToTee) {
+    const auto bytesWanted = (bytesToTee > 0) ? static_cast<size_t>(bytesToTee) : 0;
+
+#ifdef SOLACE_PLATFORM_LINUX
+    for (;;) {
+        const auto duplicated = ::tee(getReadEnd().getSelectId(), dest.getWriteEnd().getSelectId(),
+                                      bytesWanted, 0);
+        if (duplicated < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            raise<IOException>(errno, "tee");
+        }
+
+        return IOObject::IOResult(static_cast<size_t>(duplicated));
+    }
+#else
+    (void) dest;
+    (void) bytesWanted;
+    raise<IOException>(ENOSYS, "tee");
+    return IOObject::IOResult(static_cast<size_t>(0));
+#endif  // SOLACE_PLATFORM_LINUX
+}
+
@@ -24,10 +24,18 @@
 
 #include <memory>   // std::unique_ptr<>
 #include <cstring>  // memcpy (should review)
+#include <algorithm>    // std::rotate
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
 #include <time.h>
 #include <unistd.h>
+#include <fcntl.h>
 #include <sys/stat.h>
 #include <glob.h>
+#include <climits>  // PATH_MAX
 
 
 using namespace Solace;
@@ -116,6 +124,147 @@ PlatformFilesystem::BufferedFile::size_type PlatformFilesystem::BufferedFile::te
 
 
 
+PlatformFilesystem::Directory::Directory(Path const& path, uint32 cacheSize) :
+    _dirFd(-1),
+    _generation(0),
+    _cacheSize(cacheSize)
+{
+    const auto& pathString = path.toString();
+    _dirFd = ::open(pathString.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (_dirFd < 0) {
+        raise<IOException>(errno);
+    }
+}
+
+
+PlatformFilesystem::Directory::Directory(Directory&& rhs) noexcept :
+    _dirFd(rhs._dirFd),
+    _generation(rhs._generation),
+    _cacheSize(rhs._cacheSize),
+    _entries(std::move(rhs._entries))
+{
+    rhs._dirFd = -1;
+    rhs._entries.clear();
+}
+
+
+PlatformFilesystem::Directory::~Directory() {
+    for (const auto& entry : _entries) {
+        ::close(entry.fd);
+    }
+
+    if (_dirFd >= 0) {
+        ::close(_dirFd);
+    }
+}
+
+
+File PlatformFilesystem::Directory::open(StringView name) {
+    // Cache lookup: a hit moves to the front of the LRU order, a stale
+    // entry - cached before the last invalidate() - gets retired on sight.
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+        if (it->name.size() != name.size() || memcmp(it->name.data(), name.data(), name.size()) != 0) {
+            continue;
+        }
+
+        if (it->generation != _generation) {
+            ::close(it->fd);
+            _entries.erase(it);
+            break;
+        }
+
+        auto const fd = ::dup(it->fd);
+        if (fd < 0) {
+            raise<IOException>(errno);
+        }
+
+        ::lseek(fd, 0, SEEK_SET);
+        std::rotate(_entries.begin(), it, it + 1);
+
+        return File::fromFd(fd);
+    }
+
+    return openAt(name, O_RDWR | O_CLOEXEC);
+}
+
+
+File PlatformFilesystem::Directory::create(StringView name) {
+    return openAt(name, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC);
+}
+
+
+File PlatformFilesystem::Directory::openAt(StringView name, int flags) {
+    std::string cname(name.data(), name.size());  // openat() wants the name null-terminated.
+
+    auto const fd = ::openat(_dirFd, cname.c_str(), flags,
+                             S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+    if (fd < 0) {
+        raise<IOException>(errno);
+    }
+
+    // Keep a duplicate around so the next open of this name is a dup(), not a path walk:
+    if (_cacheSize > 0) {
+        auto const cached = ::dup(fd);
+        if (cached >= 0) {
+            if (_entries.size() >= _cacheSize) {
+                ::close(_entries.back().fd);
+                _entries.pop_back();
+            }
+
+            _entries.insert(_entries.begin(), CacheEntry{std::move(cname), cached, _generation});
+        }
+    }
+
+    return File::fromFd(fd);
+}
+
+
+uint32 PlatformFilesystem::Directory::cachedCount() const noexcept {
+    uint32 count = 0;
+    for (const auto& entry : _entries) {
+        if (entry.generation == _generation) {
+            ++count;
+        }
+    }
+
+    return count;
+}
+
+
+namespace {
+
+/** Open by a non-terminated name: stack copy for the trailing NUL, then the syscall. */
+File openCPath(StringView path, int flags) {
+    char cpath[PATH_MAX];
+    if (path.size() >= sizeof(cpath)) {
+        raise<IOException>(ENAMETOOLONG);
+    }
+
+    memcpy(cpath, path.data(), path.size());
+    cpath[path.size()] = '\0';
+
+    auto const fd = ::open(cpath, flags,
+                           S_IRUSR | S_IWUSR | S_IRGRP | S_IWGRP | S_IROTH | S_IWOTH);
+    if (fd < 0) {
+        raise<IOException>(errno);
+    }
+
+    return File::fromFd(fd);
+}
+
+}  // namespace
+
+
+File PlatformFilesystem::create(StringView path) {
+    return openCPath(path, O_RDWR | O_CREAT | O_EXCL | O_CLOEXEC);
+}
+
+
+File PlatformFilesystem::open(StringView path) {
+    return openCPath(path, O_RDWR | O_CLOEXEC);
+}
+
+
 std::unique_ptr<File> PlatformFilesystem::create(const Path& path) {
     const auto& pathString = path.toString();
     auto fp = fopen(pathString.c_str(), "w+x");
@@ -230,7 +379,7 @@ std::unique_ptr<PlatformFilesystem::BufferedFile> PlatformFilesystem::createTemp
 
 
 Array<Path> PlatformFilesystem::glob(const String& pattern) const {
-    std::vector<Path> pathsFound;
+    Array<Path>::Storage pathsFound;
 
     glob_t globResults;
     auto ret = ::glob(pattern.c_str(), 0, nullptr, &globResults);
@@ -261,7 +410,7 @@ Array<Path> PlatformFilesystem::glob(const String& pattern) const {
 
 Array<Path>
 PlatformFilesystem::glob(std::initializer_list<const char*> patterns) const {
-    std::vector<Path> pathsFound;
+    Array<Path>::Storage pathsFound;
 
     if (patterns.size() == 0)
         return pathsFound;
@@ -285,6 +434,233 @@ PlatformFilesystem::glob(std::initializer_list<const char*> patterns) const {
 }
 
 
+namespace {
+
+/// Scratch geometry for tree operations, mirroring DirectoryReader::walk.
+constexpr size_t kTreeArenaSize = 64 * 1024;
+constexpr size_t kTreeBatchSize = 1024;
+
+/** Running totals shared by the workers of one tree operation. */
+struct TreeTotals {
+    std::atomic<uint64> entriesRemoved {0};
+    std::atomic<uint64> entriesKept {0};
+    std::atomic<uint64> failures {0};
+};
+
+
+/** Apply the action to one directory's entries and collect its subdirectories. */
+void applyOneDirectory(Path const& directory,
+                       PlatformFilesystem::TreeAction const& action,
+                       std::vector<Path>& subdirectories,
+                       TreeTotals& totals) {
+    DirectoryReader reader(directory);
+
+    std::vector<byte> arena(kTreeArenaSize);
+    std::vector<DirectoryReader::Entry> entries(kTreeBatchSize);
+
+    auto arenaView = wrapMemory(arena.data(), arena.size());
+    auto entriesView = ArrayView<DirectoryReader::Entry>(entries.data(), entries.size());
+
+    for (;;) {
+        auto const count = reader.read(arenaView, entriesView);
+        if (count == 0) {
+            break;
+        }
+
+        for (DirectoryReader::size_type i = 0; i < count; ++i) {
+            auto const& entry = entries[i];
+
+            if (entry.type == DirectoryReader::Type::Directory) {
+                subdirectories.push_back(Path::join(directory, entry.name));
+                continue;
+            }
+
+            if (action(directory, entry) == PlatformFilesystem::TreeOp::Keep) {
+                totals.entriesKept.fetch_add(1, std::memory_order_relaxed);
+                continue;
+            }
+
+            // Entry names point at NUL-terminated dirent names in the arena,
+            // so removal is a single name-only syscall on the scan's own fd:
+            if (::unlinkat(reader.descriptor(), entry.name.data(), 0) == 0) {
+                totals.entriesRemoved.fetch_add(1, std::memory_order_relaxed);
+            } else {
+                totals.failures.fetch_add(1, std::memory_order_relaxed);
+            }
+        }
+    }
+}
+
+
+/** Wrapper counting a subtree whose scan itself failed instead of throwing. */
+void applyOneDirectoryCounted(Path const& directory,
+                              PlatformFilesystem::TreeAction const& action,
+                              std::vector<Path>& subdirectories,
+                              TreeTotals& totals) {
+    try {
+        applyOneDirectory(directory, action, subdirectories, totals);
+    } catch (IOException const&) {
+        totals.failures.fetch_add(1, std::memory_order_relaxed);
+    }
+}
+
+
+/**
+ * Drain the given directories and everything below them through the action.
+ * Directories popped from the queue are appended to visited, in pop order,
+ * when the caller needs them for a later pass.
+ */
+void processSubtrees(std::vector<Path>&& seeds,
+                     PlatformFilesystem::TreeAction const& action,
+                     uint32 parallelism,
+                     TreeTotals& totals,
+                     std::vector<Path>* visited) {
+    if (parallelism <= 1) {
+        auto pending = std::move(seeds);
+        while (!pending.empty()) {
+            auto directory = std::move(pending.back());
+            pending.pop_back();
+
+            if (visited) {
+                visited->push_back(directory);
+            }
+
+            applyOneDirectoryCounted(directory, action, pending, totals);
+        }
+
+        return;
+    }
+
+    std::mutex guard;
+    std::condition_variable workAvailable;
+    std::deque<Path> pending(std::make_move_iterator(seeds.begin()),
+                             std::make_move_iterator(seeds.end()));
+    uint32 scanning = 0;
+    bool done = pending.empty();
+
+    auto const workerLoop = [&]() {
+        std::vector<Path> discovered;
+
+        std::unique_lock<std::mutex> lock(guard);
+        for (;;) {
+            while (pending.empty() && !done) {
+                workAvailable.wait(lock);
+            }
+
+            if (done && pending.empty()) {
+                return;
+            }
+
+            auto directory = std::move(pending.front());
+            pending.pop_front();
+            if (visited) {
+                visited->push_back(directory);
+            }
+            scanning += 1;
+            lock.unlock();
+
+            discovered.clear();
+            applyOneDirectoryCounted(directory, action, discovered, totals);
+
+            lock.lock();
+            scanning -= 1;
+            for (auto& subdirectory : discovered) {
+                pending.push_back(std::move(subdirectory));
+            }
+
+            if (!discovered.empty()) {
+                workAvailable.notify_all();
+            } else if (pending.empty() && scanning == 0) {
+                // The tree is exhausted; let everybody drain out.
+                done = true;
+                workAvailable.notify_all();
+            }
+        }
+    };
+
+    std::vector<std::thread> workers;
+    workers.reserve(parallelism);
+    for (uint32 i = 0; i < parallelism; ++i) {
+        workers.emplace_back(workerLoop);
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+}  // namespace
+
+
+Result<PlatformFilesystem::TreeOpSummary, Error>
+PlatformFilesystem::applyTree(Path const& root, TreeAction const& action, uint32 parallelism) {
+    TreeTotals totals;
+    std::vector<Path> pending;
+
+    // The root is scanned on the calling thread: a tree whose root cannot
+    // be opened is an error, unlike a subtree lost mid-operation.
+    try {
+        applyOneDirectory(root, action, pending, totals);
+    } catch (IOException const& e) {
+        return Err(Error(e.getMessage()));
+    }
+
+    processSubtrees(std::move(pending), action, parallelism, totals, nullptr);
+
+    return Ok(TreeOpSummary{
+        totals.entriesRemoved.load(std::memory_order_relaxed),
+        totals.entriesKept.load(std::memory_order_relaxed),
+        0,
+        totals.failures.load(std::memory_order_relaxed)
+    });
+}
+
+
+Result<PlatformFilesystem::TreeOpSummary, Error>
+PlatformFilesystem::removeTree(Path const& root, uint32 parallelism) {
+    TreeTotals totals;
+    std::vector<Path> pending;
+    std::vector<Path> directories;
+
+    auto const removeEverything = [](Path const&, DirectoryReader::Entry const&) {
+        return TreeOp::Remove;
+    };
+
+    try {
+        applyOneDirectory(root, removeEverything, pending, totals);
+    } catch (IOException const& e) {
+        return Err(Error(e.getMessage()));
+    }
+
+    processSubtrees(std::move(pending), removeEverything, parallelism, totals, &directories);
+
+    // Emptied directories go deepest-first so every rmdir finds no children;
+    // the root closes the operation. This pass is one syscall per directory -
+    // noise next to the per-file work above.
+    std::sort(directories.begin(), directories.end(),
+              [](Path const& a, Path const& b) {
+                  return a.getComponentsCount() > b.getComponentsCount();
+              });
+    directories.push_back(root);
+
+    uint64 directoriesRemoved = 0;
+    for (auto const& directory : directories) {
+        if (::rmdir(directory.toString().c_str()) == 0) {
+            directoriesRemoved += 1;
+        } else {
+            totals.failures.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    return Ok(TreeOpSummary{
+        totals.entriesRemoved.load(std::memory_order_relaxed),
+        totals.entriesKept.load(std::memory_order_relaxed),
+        directoriesRemoved,
+        totals.failures.load(std::memory_order_relaxed)
+    });
+}
+
+
 Path PlatformFilesystem::getExecPath() const {
     char execPath[1024];
     const size_t buffSize = sizeof(execPath);
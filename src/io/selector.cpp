@@ -24,11 +24,45 @@
 
 #include "selector_impl.hpp"
 
+#include <atomic>
+#include <limits>
+#include <thread>
+
+#include <unistd.h>
+
 
 using namespace Solace;
 using namespace Solace::IO;
 
 
+namespace {
+
+/** Hint the cpu that we are in a spin-wait loop between poll probes. */
+inline void cpuRelax() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    __builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+    asm volatile ("yield" ::: "memory");
+#else
+    asm volatile ("" ::: "memory");
+#endif
+}
+
+
+/** Time left of the caller's timeout after the spin window, in milliseconds. */
+int remainingMsec(int msec, Timestamp entered) noexcept {
+    if (msec < 0) {
+        return msec;
+    }
+
+    const auto elapsedMsec = (Clock::monotonic() - entered) / 1000000;
+    return (elapsedMsec >= msec)
+            ? 0
+            : msec - static_cast<int>(elapsedMsec);
+}
+
+}  // namespace
+
 
 Selector::Iterator Selector::Iterator::begin() const {
     return Iterator(_pimpl, _index, _size);
@@ -90,7 +124,184 @@ void Selector::remove(ISelectable::poll_id fd) {
 
 
 Selector::Iterator Selector::poll(int msec) {
-    auto r = _pimpl->poll(msec);
+    const auto entered = Clock::monotonic();
+    const bool hybrid = (_spinWindowUsec > 0 && msec != 0);
+
+    auto r = _pimpl->poll(hybrid ? 0 : msec);
+
+    if (hybrid && std::get<1>(r) == 0) {
+        // Busy-spin for the window, probing without blocking:
+        const auto window = static_cast<int64>(_spinWindowUsec) * 1000;
+        while (std::get<1>(r) == 0 && (Clock::monotonic() - entered) < window) {
+            cpuRelax();
+            r = _pimpl->poll(0);
+        }
+
+        // The window lapsed quiet - park in the kernel for what is left:
+        if (std::get<1>(r) == 0) {
+            r = _pimpl->poll(remainingMsec(msec, entered));
+        }
+    }
+
+    const auto returned = Clock::monotonic();
+
+    noteCompletedPoll(entered, returned, std::get<1>(r));
 
     return Selector::Iterator(_pimpl.get(), std::get<0>(r), std::get<1>(r));
 }
+
+
+Selector::size_type Selector::pollInto(ArrayView<Event> events, int msec) {
+    if (events.empty()) {
+        return 0;
+    }
+
+    const auto entered = Clock::monotonic();
+    const bool hybrid = (_spinWindowUsec > 0 && msec != 0);
+
+    auto nbReady = static_cast<size_type>(
+                _pimpl->pollInto(events.begin(), events.size(), hybrid ? 0 : msec));
+
+    if (hybrid && nbReady == 0) {
+        const auto window = static_cast<int64>(_spinWindowUsec) * 1000;
+        while (nbReady == 0 && (Clock::monotonic() - entered) < window) {
+            cpuRelax();
+            nbReady = static_cast<size_type>(_pimpl->pollInto(events.begin(), events.size(), 0));
+        }
+
+        if (nbReady == 0) {
+            nbReady = static_cast<size_type>(
+                        _pimpl->pollInto(events.begin(), events.size(), remainingMsec(msec, entered)));
+        }
+    }
+
+    const auto returned = Clock::monotonic();
+
+    noteCompletedPoll(entered, returned, nbReady);
+
+    return nbReady;
+}
+
+
+Selector Selector::createBest(size_type maxEvents) {
+#ifdef SOLACE_PLATFORM_LINUX
+    try {
+        auto selector = createIOUring(maxEvents);
+        selector.calibrateWakeupLatency();
+
+        return selector;
+    } catch (IOException const&) {
+        // Kernel too old for io_uring or the rings locked down by policy.
+    }
+
+    try {
+        auto selector = createEPoll(maxEvents);
+        selector.calibrateWakeupLatency();
+
+        return selector;
+    } catch (IOException const&) {
+        // Container runtimes have been seen rejecting epoll_create too.
+    }
+#endif  // SOLACE_PLATFORM_LINUX
+
+    auto selector = createPoll(maxEvents);
+    selector.calibrateWakeupLatency();
+
+    return selector;
+}
+
+
+int64 Selector::calibrateWakeupLatency() {
+    int fds[2];
+    if (::pipe(fds) < 0) {
+        return 0;
+    }
+
+    addRaw(fds[0], Events::Read, nullptr);
+
+    // The helper parks us for a moment after each arm so the write lands
+    // while this thread really is asleep in the backend, then stamps the
+    // moment it wrote. Measured latency = write stamp to poll return.
+    std::atomic<bool> armed(false);
+    std::atomic<bool> running(true);
+    std::atomic<int64> writeStamp(0);
+
+    std::thread waker([&]() {
+        while (running.load(std::memory_order_acquire)) {
+            if (!armed.exchange(false, std::memory_order_acq_rel)) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            const auto armTime = Clock::monotonic();
+            while (Clock::monotonic() - armTime < 20000) {  // 20 usec for the poller to park
+                cpuRelax();
+            }
+
+            const byte token = 1;
+            writeStamp.store(Clock::monotonic().nanos, std::memory_order_release);
+            if (::write(fds[1], &token, sizeof(token)) < 0) {
+                break;
+            }
+        }
+    });
+
+    constexpr int kRounds = 16;
+    int64 best = std::numeric_limits<int64>::max();
+
+    for (int round = 0; round < kRounds; ++round) {
+        armed.store(true, std::memory_order_release);
+
+        Event scratch[4];
+        const auto nbReady = _pimpl->pollInto(scratch, 4, -1);
+        const auto awoke = Clock::monotonic();
+
+        if (nbReady > 0) {
+            const auto latency = awoke.nanos - writeStamp.load(std::memory_order_acquire);
+            if (latency > 0 && latency < best) {
+                best = latency;
+            }
+        }
+
+        byte sink[8];
+        if (::read(fds[0], sink, sizeof(sink)) < 0) {
+            break;
+        }
+    }
+
+    running.store(false, std::memory_order_release);
+    waker.join();
+
+    remove(fds[0]);
+    ::close(fds[0]);
+    ::close(fds[1]);
+
+    if (best == std::numeric_limits<int64>::max()) {
+        return 0;
+    }
+
+    // Spinning is worth at most one sleep/wake cycle; double the measured
+    // wakeup for headroom and clamp to a sane range.
+    const auto windowUsec = (2 * best) / 1000;
+    setSpinWindow(static_cast<uint32>((windowUsec < 1) ? 1 : (windowUsec > 100) ? 100 : windowUsec));
+
+    return best;
+}
+
+
+void Selector::noteCompletedPoll(Timestamp entered, Timestamp returned, size_type nbReady) noexcept {
+    _stats.polls += 1;
+    _stats.eventsReported += nbReady;
+    _stats.lastReadyCount = nbReady;
+    _stats.lastWaitNanos = returned - entered;
+
+    // The first poll has no preceding dispatch phase to measure:
+    if (_lastPollReturn.nanos != 0) {
+        _stats.lastDispatchNanos = entered - _lastPollReturn;
+
+        const auto loop = _stats.lastDispatchNanos + _stats.lastWaitNanos;
+        _stats.loopEwmaNanos += (loop - _stats.loopEwmaNanos) / 8;
+    }
+
+    _lastPollReturn = returned;
+}
@@ -22,9 +22,11 @@
 #include <solace/io/selector.hpp>
 #include <solace/exception.hpp>
 #include <solace/array.hpp>
+#include <solace/telemetry.hpp>
 
 #include "selector_impl.hpp"
 
+#include <list>
 
 #include <unistd.h>  // close()
 #include <fcntl.h>
@@ -68,7 +70,6 @@ public:
             Solace::raise<IOException>(errno);
         }
 
-        _selectables.reserve(maxReportedEvents);
     }
 
     void add(ISelectable* selectable, int events) override {
@@ -87,6 +88,10 @@ public:
             nativeEvents |= EPOLLERR;
         if (events & Selector::Events::Hup)
             nativeEvents|= EPOLLHUP;
+        if (events & Selector::Events::EdgeTriggered)
+            nativeEvents |= EPOLLET;
+        if (events & Selector::Events::OneShot)
+            nativeEvents |= EPOLLONESHOT;
 
         addRaw(fd, nativeEvents, data);
     }
@@ -94,6 +99,24 @@ public:
 
     void addRaw(ISelectable::poll_id fd, int nativeEvents, void* data) override {
 
+        // Re-adding a registered fd modifies the registration in place.
+        // This is the re-arming path for one-shot registrations.
+        const auto known = std::find_if(_selectables.begin(), _selectables.end(),
+                                        [fd](const auto& x) { return x.fd == fd; });
+        if (known != _selectables.end()) {
+            known->data = data;
+
+            epoll_event epollEvent;
+            epollEvent.data.ptr = &(*known);
+            epollEvent.events = nativeEvents;
+
+            if (-1 == epoll_ctl(_epfd, EPOLL_CTL_MOD, fd, &epollEvent)) {
+                Solace::raise<IOException>(errno);
+            }
+
+            return;
+        }
+
         Selector::Event ev;
         ev.data = data;
         ev.fd = fd;
@@ -126,9 +149,7 @@ public:
             }
         }
 
-        _selectables.erase(
-                    std::remove_if(_selectables.begin(), _selectables.end(), [fd](auto x) { return x.fd == fd; }),
-                    _selectables.end());
+        _selectables.remove_if([fd](const auto& x) { return x.fd == fd; });
     }
 
 
@@ -142,6 +163,7 @@ public:
                     Solace::raise<IOException>(errno);
                 }
             } else {
+                SOLACE_TELEMETRY_RECORD(Telemetry::Probe::SelectorPollBatch, static_cast<uint32>(ready));
                 return std::make_tuple(0, ready);
             }
         }
@@ -176,8 +198,34 @@ public:
     }
 
 
+    size_t pollInto(Selector::Event* dest, size_t capacity, int msec) override {
+        const auto batchSize = std::min<size_t>(capacity, _evlist.size());
+
+        for (int i = 0; i < 3; ++i) {   // Allow for 3 interapts in a row
+            const int ready = epoll_wait(_epfd, _evlist.data(), static_cast<int>(batchSize), msec);
+
+            if (ready < 0) {
+                if (errno != EINTR) {
+                    Solace::raise<IOException>(errno);
+                }
+            } else {
+                // One translation pass over the kernel events, straight into caller storage:
+                for (int j = 0; j < ready; ++j) {
+                    dest[j] = getEvent(j);
+                }
+
+                return ready;
+            }
+        }
+
+        return 0;
+    }
+
+
 private:
-    std::vector<Selector::Event>    _selectables;
+    // The kernel keeps a pointer to each node in epoll_data, so the
+    // registration store must never relocate entries: a list, not a vector.
+    std::list<Selector::Event>      _selectables;
     Solace::Array<epoll_event>      _evlist;
     int                             _epfd;
 };
@@ -49,6 +49,23 @@ public:
     virtual Selector::Event getEvent(size_t i) = 0;
 
     virtual size_t advance(size_t i) = 0;
+
+    /**
+     * Bulk poll: store up to `capacity` ready events into caller provided storage.
+     * Backends with a contiguous ready list should override this to copy it out directly.
+     */
+    virtual size_t pollInto(Selector::Event* dest, size_t capacity, int msec) {
+        const auto readyRange = poll(msec);
+        const auto endIndex = std::get<1>(readyRange);
+
+        size_t count = 0;
+        for (auto i = static_cast<size_t>(std::get<0>(readyRange)); i < endIndex && count < capacity;
+             i = advance(i)) {
+            dest[count++] = getEvent(i);
+        }
+
+        return count;
+    }
 };
 
 
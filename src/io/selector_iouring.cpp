@@ -0,0 +1,401 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/selector_iouring.cpp
+ * io_uring based implemenation of the selector
+ *
+ * Readiness requests are queued as POLL_ADD submission entries and flushed
+ * with a single io_uring_enter() per poll() call, so registering N new
+ * pollables costs one syscall instead of N epoll_ctl() calls. The ring is
+ * driven through the raw kernel interface - no liburing dependency.
+*******************************************************************************/
+#include <solace/io/selector.hpp>
+#include <solace/exception.hpp>
+#include <solace/telemetry.hpp>
+
+#include "selector_impl.hpp"
+
+
+#include <vector>
+#include <memory>
+#include <algorithm>
+
+#include <poll.h>
+#include <unistd.h>     // close()
+#include <cerrno>
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+#include <linux/io_uring.h>
+#include <linux/time_types.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+namespace /*anonymous*/ {
+
+int io_uring_setup(unsigned entries, struct io_uring_params* p) {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+int io_uring_enter(int ringFd, unsigned toSubmit, unsigned minComplete, unsigned flags) {
+    return static_cast<int>(syscall(__NR_io_uring_enter, ringFd, toSubmit, minComplete, flags, nullptr, 0));
+}
+
+
+class IOUringSelectorImpl :
+        public Solace::IO::Selector::IPollerImpl {
+public:
+
+    // Poll requests are one-shot: an entry must be re-armed after each completion.
+    struct Entry {
+        Selector::Event     ev;
+        uint32              pollEvents;
+        bool                armed;
+        bool                removed;
+    };
+
+    // user_data tag of the timeout entry. Entries are pointer-aligned so an odd
+    // value can never collide with an Entry address.
+    static constexpr __u64 kTimeoutTag = 1;
+
+
+    ~IOUringSelectorImpl() override {
+        if (_sqes != MAP_FAILED) {
+            munmap(_sqes, _params.sq_entries * sizeof(io_uring_sqe));
+        }
+        if (_cqRing != MAP_FAILED && _cqRing != _sqRing) {
+            munmap(_cqRing, _cqRingSize);
+        }
+        if (_sqRing != MAP_FAILED) {
+            munmap(_sqRing, _sqRingSize);
+        }
+
+        close(_ringFd);  // TODO(abbyssoul): Maybe check return value?
+    }
+
+    IOUringSelectorImpl(IOUringSelectorImpl const&) = delete;
+    IOUringSelectorImpl& operator= (IOUringSelectorImpl const&) = delete;
+
+    explicit IOUringSelectorImpl(uint32 queueDepth) :
+        _params(),
+        _sqRing(MAP_FAILED),
+        _cqRing(MAP_FAILED),
+        _sqes(MAP_FAILED)
+    {
+        _ringFd = io_uring_setup(queueDepth, &_params);
+        if (-1 == _ringFd) {
+            Solace::raise<IOException>(errno);
+        }
+
+        _sqRingSize = _params.sq_off.array + _params.sq_entries * sizeof(__u32);
+        _cqRingSize = _params.cq_off.cqes + _params.cq_entries * sizeof(io_uring_cqe);
+
+        // Newer kernels map both rings through a single region:
+        if (_params.features & IORING_FEAT_SINGLE_MMAP) {
+            _sqRingSize = _cqRingSize = std::max(_sqRingSize, _cqRingSize);
+        }
+
+        _sqRing = mmap(nullptr, _sqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                       _ringFd, IORING_OFF_SQ_RING);
+        if (MAP_FAILED == _sqRing) {
+            const auto savedErrno = errno;
+            close(_ringFd);
+            Solace::raise<IOException>(savedErrno);
+        }
+
+        if (_params.features & IORING_FEAT_SINGLE_MMAP) {
+            _cqRing = _sqRing;
+        } else {
+            _cqRing = mmap(nullptr, _cqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE,
+                           _ringFd, IORING_OFF_CQ_RING);
+            if (MAP_FAILED == _cqRing) {
+                const auto savedErrno = errno;
+                munmap(_sqRing, _sqRingSize);
+                close(_ringFd);
+                Solace::raise<IOException>(savedErrno);
+            }
+        }
+
+        _sqes = mmap(nullptr, _params.sq_entries * sizeof(io_uring_sqe), PROT_READ | PROT_WRITE,
+                     MAP_SHARED | MAP_POPULATE, _ringFd, IORING_OFF_SQES);
+        if (MAP_FAILED == _sqes) {
+            const auto savedErrno = errno;
+            if (_cqRing != _sqRing) {
+                munmap(_cqRing, _cqRingSize);
+            }
+            munmap(_sqRing, _sqRingSize);
+            close(_ringFd);
+            Solace::raise<IOException>(savedErrno);
+        }
+
+        _selectables.reserve(queueDepth);
+        _readyEvents.reserve(queueDepth);
+    }
+
+    void add(ISelectable* selectable, int events) override {
+        add(selectable->getSelectId(), events, selectable);
+    }
+
+
+    void add(ISelectable::poll_id fd, int events, void* data) override {
+        int pollEvents = 0;
+
+        if (events & Selector::Events::Read)
+            pollEvents |= POLLIN | POLLPRI;
+        if (events & Selector::Events::Write)
+            pollEvents |= POLLOUT;
+        if (events & Selector::Events::Hup)
+            pollEvents |= POLLRDHUP;
+
+        addRaw(fd, pollEvents, data);
+    }
+
+
+    void addRaw(ISelectable::poll_id fd, int nativeEvents, void* data) override {
+        auto entry = std::make_unique<Entry>();
+        entry->ev.fd = fd;
+        entry->ev.data = data;
+        entry->ev.events = 0;
+        entry->pollEvents = static_cast<uint32>(nativeEvents);
+        entry->armed = false;
+        entry->removed = false;
+
+        // Submission is deferred: the next poll() batches all un-armed entries
+        // into a single io_uring_enter().
+        _selectables.push_back(std::move(entry));
+    }
+
+
+    void remove(const ISelectable* selectable) override {
+        remove(selectable->getSelectId());
+    }
+
+
+    void remove(ISelectable::poll_id fd) override {
+        for (auto& entry : _selectables) {
+            if (entry->ev.fd != fd || entry->removed) {
+                continue;
+            }
+
+            entry->removed = true;
+            if (entry->armed) {
+                // The entry is freed once the cancelled request completes.
+                auto* sqe = nextSqe();
+                sqe->opcode = IORING_OP_POLL_REMOVE;
+                sqe->fd = -1;
+                sqe->addr = reinterpret_cast<__u64>(entry.get());
+                sqe->user_data = 0;
+            }
+        }
+
+        // Entries never armed can go right away:
+        _selectables.erase(
+                    std::remove_if(_selectables.begin(), _selectables.end(),
+                                   [](const auto& x) { return (x->removed && !x->armed); }),
+                    _selectables.end());
+    }
+
+
+    std::tuple<uint32, uint32> poll(int msec) override {
+        _readyEvents.clear();
+
+        for (auto& entry : _selectables) {
+            if (entry->armed || entry->removed) {
+                continue;
+            }
+
+            auto* sqe = nextSqe();
+            sqe->opcode = IORING_OP_POLL_ADD;
+            sqe->fd = entry->ev.fd;
+            sqe->poll_events = static_cast<__u16>(entry->pollEvents);
+            sqe->user_data = reinterpret_cast<__u64>(entry.get());
+            entry->armed = true;
+        }
+
+        __kernel_timespec timeout;
+        if (msec > 0) {
+            timeout.tv_sec = msec / 1000;
+            timeout.tv_nsec = static_cast<long long>(msec % 1000) * 1000000;
+
+            auto* sqe = nextSqe();
+            sqe->opcode = IORING_OP_TIMEOUT;
+            sqe->fd = -1;
+            sqe->addr = reinterpret_cast<__u64>(&timeout);
+            sqe->len = 1;
+            sqe->user_data = kTimeoutTag;
+        }
+
+        for (int i = 0; i < 3; ++i) {   // Allow for 3 interapts in a row
+            const unsigned minComplete = (msec == 0) ? 0 : 1;
+            const int r = io_uring_enter(_ringFd, flushSqTail(), minComplete, IORING_ENTER_GETEVENTS);
+
+            if (r < 0) {
+                if (errno != EINTR) {
+                    Solace::raise<IOException>(errno);
+                }
+            } else {
+                break;
+            }
+        }
+
+        reapCompletions();
+
+        SOLACE_TELEMETRY_RECORD(Telemetry::Probe::SelectorPollBatch, static_cast<uint32>(_readyEvents.size()));
+
+        return std::make_tuple(0, static_cast<uint32>(_readyEvents.size()));
+    }
+
+
+    Selector::Event getEvent(size_t i) override {
+        return _readyEvents[i];
+    }
+
+    size_t advance(size_t offsetIndex) override {
+        return offsetIndex + 1;
+    }
+
+
+    size_t pollInto(Selector::Event* dest, size_t capacity, int msec) override {
+        const auto readyRange = poll(msec);
+        const auto ready = std::min<size_t>(capacity, std::get<1>(readyRange));
+
+        // The ready list is already in Selector::Event form - copy it out in one shot:
+        std::copy(_readyEvents.begin(), _readyEvents.begin() + ready, dest);
+
+        return ready;
+    }
+
+protected:
+
+    io_uring_sqe* nextSqe() {
+        auto* sqHead = reinterpret_cast<__u32*>(static_cast<byte*>(_sqRing) + _params.sq_off.head);
+        const __u32 head = __atomic_load_n(sqHead, __ATOMIC_ACQUIRE);
+
+        if (_sqTail - head >= _params.sq_entries) {
+            // The queue is full - flush what we have to make room:
+            if (io_uring_enter(_ringFd, flushSqTail(), 0, 0) < 0) {
+                Solace::raise<IOException>(errno);
+            }
+        }
+
+        const __u32 index = _sqTail & (_params.sq_entries - 1);
+        auto* sqe = static_cast<io_uring_sqe*>(_sqes) + index;
+        *sqe = io_uring_sqe();
+
+        auto* sqArray = reinterpret_cast<__u32*>(static_cast<byte*>(_sqRing) + _params.sq_off.array);
+        sqArray[index] = index;
+        _sqTail += 1;
+
+        return sqe;
+    }
+
+    /** Publish locally queued submission entries. @return number to submit. */
+    unsigned flushSqTail() {
+        auto* sqTail = reinterpret_cast<__u32*>(static_cast<byte*>(_sqRing) + _params.sq_off.tail);
+        const __u32 published = __atomic_load_n(sqTail, __ATOMIC_RELAXED);
+
+        __atomic_store_n(sqTail, _sqTail, __ATOMIC_RELEASE);
+
+        return _sqTail - published;
+    }
+
+    void reapCompletions() {
+        auto* cqHead = reinterpret_cast<__u32*>(static_cast<byte*>(_cqRing) + _params.cq_off.head);
+        auto* cqTail = reinterpret_cast<__u32*>(static_cast<byte*>(_cqRing) + _params.cq_off.tail);
+        auto* cqes = reinterpret_cast<io_uring_cqe*>(static_cast<byte*>(_cqRing) + _params.cq_off.cqes);
+
+        __u32 head = __atomic_load_n(cqHead, __ATOMIC_RELAXED);
+        const __u32 tail = __atomic_load_n(cqTail, __ATOMIC_ACQUIRE);
+
+        for (; head != tail; ++head) {
+            const auto& cqe = cqes[head & (_params.cq_entries - 1)];
+
+            if (cqe.user_data == 0 || cqe.user_data == kTimeoutTag) {
+                continue;  // Poll-remove / timeout bookkeeping entries.
+            }
+
+            auto* entry = reinterpret_cast<Entry*>(cqe.user_data);
+            entry->armed = false;
+
+            if (entry->removed || cqe.res == -ECANCELED) {
+                releaseIfRemoved(entry);
+                continue;
+            }
+
+            if (cqe.res < 0) {
+                Selector::Event event;
+                event.fd = entry->ev.fd;
+                event.data = entry->ev.data;
+                event.events = Selector::Events::Error;
+                _readyEvents.push_back(event);
+                continue;
+            }
+
+            Selector::Event event;
+            event.fd = entry->ev.fd;
+            event.data = entry->ev.data;
+            event.events = 0;
+
+            if ((cqe.res & POLLIN) || (cqe.res & POLLPRI))
+                event.events |= Selector::Events::Read;
+            if (cqe.res & POLLOUT)
+                event.events |= Selector::Events::Write;
+            if (cqe.res & POLLERR)
+                event.events |= Selector::Events::Error;
+            if ((cqe.res & POLLHUP) || (cqe.res & POLLRDHUP))
+                event.events |= Selector::Events::Hup;
+
+            _readyEvents.push_back(event);
+        }
+
+        __atomic_store_n(cqHead, head, __ATOMIC_RELEASE);
+    }
+
+    void releaseIfRemoved(const Entry* entry) {
+        _selectables.erase(
+                    std::remove_if(_selectables.begin(), _selectables.end(),
+                                   [entry](const auto& x) { return (x.get() == entry && x->removed); }),
+                    _selectables.end());
+    }
+
+private:
+
+    std::vector<std::unique_ptr<Entry>>     _selectables;
+    std::vector<Selector::Event>            _readyEvents;
+
+    io_uring_params     _params;
+    void*               _sqRing;
+    void*               _cqRing;
+    void*               _sqes;
+    size_t              _sqRingSize;
+    size_t              _cqRingSize;
+    __u32               _sqTail = 0;
+    int                 _ringFd;
+};
+
+}  // namespace
+
+
+Selector Selector::createIOUring(uint32 queueDepth) {
+    return Selector(std::make_unique<IOUringSelectorImpl>(queueDepth));
+}
+
+#endif  // SOLACE_PLATFORM_LINUX
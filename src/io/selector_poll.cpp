@@ -20,6 +20,7 @@
 *******************************************************************************/
 #include <solace/io/selector.hpp>
 #include <solace/exception.hpp>
+#include <solace/telemetry.hpp>
 
 #include "selector_impl.hpp"
 
@@ -115,6 +116,8 @@ public:
             return std::make_tuple(0, 0);
         }
 
+        SOLACE_TELEMETRY_RECORD(Telemetry::Probe::SelectorPollBatch, static_cast<uint32>(r));
+
         const auto pollCount = _pollfds.size();
         return std::make_tuple(findFirstReady(0, pollCount), pollCount);
     }
@@ -135,6 +138,9 @@ public:
             event.events |= Selector::Events::Write;
         if (ev.revents & POLLERR)
             event.events |= Selector::Events::Error;
+        // The epoll backend reports EPOLLHUP as Hup; mirror that here.
+        if (ev.revents & POLLHUP)
+            event.events |= Selector::Events::Hup;
         #ifdef SOLACE_PLATFORM_LINUX
         if (ev.revents & POLLRDHUP)
             event.events |= Selector::Events::Hup;
@@ -0,0 +1,283 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/selector_trace.cpp
+ * @brief: Record / replay backends for Selector event streams
+*******************************************************************************/
+#include <solace/io/selector.hpp>
+#include <solace/io/traceRing.hpp>
+#include <solace/exception.hpp>
+
+#include "selector_impl.hpp"
+
+
+#include <vector>
+#include <algorithm>
+#include <thread>   // std::this_thread::sleep_for
+#include <chrono>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+namespace /*anonymous*/ {
+
+// Trace record ids used by the recording selector. Distinctive values so a
+// selector trace can share a ring with application events without ambiguity.
+constexpr uint64 kBatchRecordId = 0x534C4250;   // 'SLBP': batch header, arg0=ready count, arg1=wait nanos
+constexpr uint64 kReadyRecordId = 0x534C4556;   // 'SLEV': one ready event, arg0=fd, arg1=event mask
+
+
+/**
+ * A decorator poller: delegates everything to the wrapped backend and appends
+ * each poll's event batch to a trace ring on the way out. The ready list is
+ * materialized here so that iteration over the returned range does not hit
+ * the inner backend again after the batch has been recorded.
+ */
+class RecordingSelectorImpl :
+        public Solace::IO::Selector::IPollerImpl {
+public:
+
+    ~RecordingSelectorImpl() override = default;
+    RecordingSelectorImpl(RecordingSelectorImpl const&) = delete;
+    RecordingSelectorImpl& operator= (RecordingSelectorImpl const&) = delete;
+
+    RecordingSelectorImpl(std::unique_ptr<Selector::IPollerImpl> inner, TraceRing&& trace) :
+        _inner(std::move(inner)),
+        _trace(std::move(trace))
+    {
+    }
+
+    void add(ISelectable* selectable, int events) override {
+        _inner->add(selectable, events);
+    }
+
+    void add(ISelectable::poll_id fd, int events, void* data) override {
+        _inner->add(fd, events, data);
+    }
+
+    void addRaw(ISelectable::poll_id fd, int nativeEvents, void* data) override {
+        _inner->addRaw(fd, nativeEvents, data);
+    }
+
+    void remove(const ISelectable* selectable) override {
+        _inner->remove(selectable);
+    }
+
+    void remove(ISelectable::poll_id fd) override {
+        _inner->remove(fd);
+    }
+
+
+    std::tuple<uint32, uint32> poll(int msec) override {
+        const auto entered = Clock::monotonic();
+        const auto readyRange = _inner->poll(msec);
+        const auto waitNanos = Clock::monotonic() - entered;
+
+        _current.clear();
+        const auto endIndex = static_cast<size_t>(std::get<1>(readyRange));
+        for (auto i = static_cast<size_t>(std::get<0>(readyRange)); i < endIndex; i = _inner->advance(i)) {
+            _current.push_back(_inner->getEvent(i));
+        }
+
+        _trace.record(kBatchRecordId, _current.size(), static_cast<uint64>(waitNanos));
+        for (const auto& event : _current) {
+            _trace.record(kReadyRecordId, static_cast<uint64>(event.fd), static_cast<uint64>(event.events));
+        }
+
+        return std::make_tuple(0, static_cast<uint32>(_current.size()));
+    }
+
+
+    Selector::Event getEvent(size_t i) override {
+        return _current[i];
+    }
+
+
+    size_t advance(size_t offsetIndex) override {
+        return offsetIndex + 1;
+    }
+
+private:
+
+    std::unique_ptr<Selector::IPollerImpl>  _inner;
+    TraceRing                               _trace;
+    std::vector<Selector::Event>            _current;
+};
+
+
+/**
+ * A poller that never touches the kernel: each poll() hands out the next
+ * batch recorded by RecordingSelectorImpl, optionally sleeping out the
+ * recorded kernel-wait time first. Registrations are kept only to re-bind
+ * the process-local data pointer to replayed fds.
+ */
+class ReplaySelectorImpl :
+        public Solace::IO::Selector::IPollerImpl {
+public:
+
+    ~ReplaySelectorImpl() override = default;
+    ReplaySelectorImpl(ReplaySelectorImpl const&) = delete;
+    ReplaySelectorImpl& operator= (ReplaySelectorImpl const&) = delete;
+
+    ReplaySelectorImpl(MemoryBuffer&& traceRegion, Selector::ReplayTiming timing) :
+        _timing(timing)
+    {
+        const auto trace = TraceRing::attach(std::move(traceRegion));
+
+        std::vector<TraceRing::Event> raw(trace.capacity());
+        const auto nbRecords = trace.readBack(ArrayView<TraceRing::Event>(raw.data(), raw.size()));
+
+        // The ring may have overwritten the header of its oldest batch;
+        // skip leading ready records until the first complete batch.
+        TraceRing::size_type i = 0;
+        while (i < nbRecords && raw[i].id != kBatchRecordId) {
+            ++i;
+        }
+
+        while (i < nbRecords) {
+            const auto& header = raw[i];
+            ++i;
+
+            Batch batch;
+            batch.begin = static_cast<uint32>(_events.size());
+            batch.waitNanos = header.arg1;
+
+            const auto nbReady = header.arg0;
+            for (uint64 n = 0; n < nbReady && i < nbRecords && raw[i].id == kReadyRecordId; ++n, ++i) {
+                Selector::Event event;
+                event.fd = static_cast<ISelectable::poll_id>(raw[i].arg0);
+                event.events = static_cast<int>(raw[i].arg1);
+                event.data = nullptr;
+
+                _events.push_back(event);
+            }
+
+            batch.count = static_cast<uint32>(_events.size()) - batch.begin;
+            _batches.push_back(batch);
+        }
+    }
+
+    void add(ISelectable* selectable, int events) override {
+        add(selectable->getSelectId(), events, selectable);
+    }
+
+    void add(ISelectable::poll_id fd, int events, void* data) override {
+        addRaw(fd, events, data);
+    }
+
+    void addRaw(ISelectable::poll_id fd, int /*nativeEvents*/, void* data) override {
+        Selector::Event registration;
+        registration.fd = fd;
+        registration.events = 0;
+        registration.data = data;
+
+        _registrations.push_back(registration);
+    }
+
+    void remove(const ISelectable* selectable) override {
+        remove(selectable->getSelectId());
+    }
+
+    void remove(ISelectable::poll_id fd) override {
+        _registrations.erase(
+                std::remove_if(_registrations.begin(), _registrations.end(),
+                               [fd](const Selector::Event& x) { return x.fd == fd; }),
+                _registrations.end());
+    }
+
+
+    std::tuple<uint32, uint32> poll(int msec) override {
+        if (_nextBatch >= _batches.size()) {
+            return std::make_tuple(0, 0);
+        }
+
+        const auto& batch = _batches[_nextBatch];
+        _nextBatch += 1;
+
+        if (_timing == Selector::ReplayTiming::AsRecorded && batch.waitNanos > 0) {
+            // Honour the poll timeout the way the kernel would have:
+            auto waitNanos = batch.waitNanos;
+            if (msec >= 0) {
+                waitNanos = std::min<uint64>(waitNanos, static_cast<uint64>(msec) * 1000000);
+            }
+
+            std::this_thread::sleep_for(std::chrono::nanoseconds(waitNanos));
+        }
+
+        _current.clear();
+        for (uint32 n = 0; n < batch.count; ++n) {
+            auto event = _events[batch.begin + n];
+            event.data = dataFor(event.fd);
+
+            _current.push_back(event);
+        }
+
+        return std::make_tuple(0, batch.count);
+    }
+
+
+    Selector::Event getEvent(size_t i) override {
+        return _current[i];
+    }
+
+
+    size_t advance(size_t offsetIndex) override {
+        return offsetIndex + 1;
+    }
+
+protected:
+
+    void* dataFor(ISelectable::poll_id fd) const {
+        for (const auto& registration : _registrations) {
+            if (registration.fd == fd) {
+                return registration.data;
+            }
+        }
+
+        return nullptr;
+    }
+
+private:
+
+    struct Batch {
+        uint32 begin;       //!< Index of the batch's first event in _events.
+        uint32 count;       //!< Number of events in the batch.
+        uint64 waitNanos;   //!< Time the recorded poll spent blocked in the kernel.
+    };
+
+    Selector::ReplayTiming          _timing;
+
+    std::vector<Selector::Event>    _events;
+    std::vector<Batch>              _batches;
+    size_t                          _nextBatch {0};
+
+    std::vector<Selector::Event>    _registrations;
+    std::vector<Selector::Event>    _current;
+};
+
+}  // namespace
+
+
+Selector Selector::createRecording(Selector&& inner, TraceRing&& trace) {
+    return Selector(std::make_unique<RecordingSelectorImpl>(std::move(inner._pimpl), std::move(trace)));
+}
+
+
+Selector Selector::createReplay(MemoryBuffer&& traceRegion, ReplayTiming timing) {
+    return Selector(std::make_unique<ReplaySelectorImpl>(std::move(traceRegion), timing));
+}
@@ -0,0 +1,75 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		solace/io/sequentialReader.cpp
+ ******************************************************************************/
+#include <solace/io/sequentialReader.hpp>
+#include <solace/exception.hpp>
+
+#include <fcntl.h>      // posix_fadvise
+#include <cerrno>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+SequentialReader::SequentialReader(File& file, MemoryManager& allocator, size_type chunkSize) :
+    _file(&file),
+    _chunkSize(chunkSize),
+    _buffers{allocator.create(chunkSize), allocator.create(chunkSize)}
+{
+    if (chunkSize == 0) {
+        raise<IllegalArgumentException>("chunkSize");
+    }
+
+#if defined(POSIX_FADV_SEQUENTIAL)
+    // One hint for the whole scan: lets the kernel double its read-ahead window.
+    const auto r = posix_fadvise(file.getSelectId(), 0, 0, POSIX_FADV_SEQUENTIAL);
+    if (r != 0) {
+        raise<IOException>(r, "posix_fadvise");
+    }
+#endif
+}
+
+
+ImmutableMemoryView SequentialReader::next() {
+    if (_eof) {
+        return ImmutableMemoryView();
+    }
+
+    // Alternate buffers so the previously returned view survives this read:
+    _active ^= 1;
+    auto dest = _buffers[_active].view().slice(0, _chunkSize);
+
+    const auto bytesRead = _file->readAt(_offset, dest).unwrap();
+    if (bytesRead == 0) {
+        _eof = true;
+        return ImmutableMemoryView();
+    }
+
+    _offset += bytesRead;
+
+#if defined(POSIX_FADV_WILLNEED)
+    // Kick off the fetch of the next window now, so the device works while
+    // the caller parses this one. Purely advisory - ignore any refusal.
+    posix_fadvise(_file->getSelectId(), static_cast<off_t>(_offset),
+                  static_cast<off_t>(_chunkSize), POSIX_FADV_WILLNEED);
+#endif
+
+    return dest.slice(0, bytesRead);
+}
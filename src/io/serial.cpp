@@ -578,3 +578,77 @@ Serial::size_type Serial::available() const {
 
     return static_cast<size_type>(count);
 }
+
+
+void Serial::setReadBatching(Solace::uint8 vmin, Solace::uint8 vtime) {
+    const auto fd = validateFd();
+
+    termios options;
+    if (tcgetattr(fd, &options) == -1) {
+        Solace::raise<IOException>(errno, "tcgetattr");
+    }
+
+    options.c_cc[VMIN] = vmin;
+    options.c_cc[VTIME] = vtime;
+
+    if (tcsetattr(fd, TCSANOW, &options) == -1) {
+        Solace::raise<IOException>(errno, "tcsetattr");
+    }
+}
+
+
+void Serial::setLowLatency(bool enable) {
+#if defined(__linux__) && defined(TIOCSSERIAL)
+    const auto fd = validateFd();
+
+    struct serial_struct ser;
+    if (-1 == ioctl(fd, TIOCGSERIAL, &ser)) {
+        Solace::raise<IOException>(errno, "ioctl(TIOCGSERIAL)");
+    }
+
+    if (enable) {
+        ser.flags |= ASYNC_LOW_LATENCY;
+    } else {
+        ser.flags &= ~ASYNC_LOW_LATENCY;
+    }
+
+    if (-1 == ioctl(fd, TIOCSSERIAL, &ser)) {
+        Solace::raise<IOException>(errno, "ioctl(TIOCSSERIAL)");
+    }
+#else
+    (void)enable;
+    Solace::raise<IOException>("Not supported method on this OS");
+#endif
+}
+
+
+Serial::size_type Serial::readAvailable(Solace::ByteBuffer& buffer) {
+    const auto fd = validateFd();
+
+    size_type total = 0;
+    while (buffer.remaining() > 0) {
+        auto view = buffer.viewRemaining();
+
+        const auto bytesRead = ::read(fd, view.dataAddress(), view.size());
+        if (bytesRead < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+                break;  // Burst consumed - nothing more until the next poll wakeup.
+            }
+
+            Solace::raise<IOException>(errno, "read");
+        }
+
+        if (bytesRead == 0) {
+            break;
+        }
+
+        buffer.advance(static_cast<size_type>(bytesRead));
+        total += static_cast<size_type>(bytesRead);
+
+        if (static_cast<Solace::MemoryView::size_type>(bytesRead) < view.size()) {
+            break;  // Short read: the kernel buffer is empty.
+        }
+    }
+
+    return total;
+}
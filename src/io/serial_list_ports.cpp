@@ -132,7 +132,7 @@ Solace::IO::Serial::enumeratePorts() {
                                         });
 
     // NOTE: The vector is used here even thou the size is know already because we don't want to initialize structs yet
-    std::vector<Solace::IO::SerialPortInfo> results;
+    Solace::Array<Solace::IO::SerialPortInfo>::Storage results;
     results.reserve(devices_found.size());
 
     for (const auto& device : devices_found) {
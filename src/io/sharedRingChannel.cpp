@@ -0,0 +1,287 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/sharedRingChannel.cpp
+*******************************************************************************/
+#include <solace/io/sharedRingChannel.hpp>
+#include <solace/exception.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+
+#ifdef SOLACE_PLATFORM_LINUX
+#include <sys/eventfd.h>
+#endif
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+namespace {
+
+constexpr uint32 kRingMagic = 0x53524331;   // 'SRC1', bumped on layout changes
+constexpr size_t kCacheLineSize = 64;
+
+/* The control block living at the start of the shared region.
+ * Head and tail sit on their own cache lines so the producer touching tail
+ * never invalidates the line the consumer spins on, and vice versa. The
+ * cursors are free-running and wrapped on use, which makes full/empty
+ * unambiguous without sacrificing a slot.
+ */
+struct RingHeader {
+    uint32 magic;
+    uint32 slotCount;
+    uint32 slotSize;
+    uint32 mask;
+
+    alignas(kCacheLineSize) std::atomic<uint64> head;     //!< Consumer cursor
+    alignas(kCacheLineSize) std::atomic<uint64> tail;     //!< Producer cursor
+};
+
+static_assert(std::is_trivially_destructible<RingHeader>::value,
+              "RingHeader must be placeable into raw shared memory");
+
+RingHeader* headerOf(MemoryBuffer& region) {
+    return reinterpret_cast<RingHeader*>(region.view().dataAddress());
+}
+
+RingHeader const* headerOf(MemoryBuffer const& region) {
+    return reinterpret_cast<RingHeader const*>(region.view().dataAddress());
+}
+
+MemoryView slotAt(MemoryBuffer& region, RingHeader const* header, uint64 cursor) {
+    auto const index = static_cast<MemoryView::size_type>(cursor & header->mask);
+    auto const offset = sizeof(RingHeader) + index * header->slotSize;
+
+    return region.view().slice(offset, offset + header->slotSize);
+}
+
+bool isPowerOfTwo(uint32 value) noexcept {
+    return (value >= 2) && ((value & (value - 1)) == 0);
+}
+
+}  // namespace
+
+
+SharedRingChannel::SharedRingChannel(MemoryBuffer&& region, poll_id doorbell) noexcept :
+    _region(std::move(region)),
+    _doorbell(doorbell),
+    _reserved(0),
+    _acquired(0)
+{
+}
+
+
+SharedRingChannel::SharedRingChannel(SharedRingChannel&& rhs) noexcept :
+    _region(std::move(rhs._region)),
+    _doorbell(rhs._doorbell),
+    _reserved(rhs._reserved),
+    _acquired(rhs._acquired)
+{
+    rhs._doorbell = ISelectable::InvalidFd;
+}
+
+
+SharedRingChannel::~SharedRingChannel() {
+    if (_doorbell != ISelectable::InvalidFd) {
+        ::close(_doorbell);
+        _doorbell = ISelectable::InvalidFd;
+    }
+}
+
+
+SharedRingChannel& SharedRingChannel::swap(SharedRingChannel& rhs) noexcept {
+    _region.swap(rhs._region);
+    std::swap(_doorbell, rhs._doorbell);
+    std::swap(_reserved, rhs._reserved);
+    std::swap(_acquired, rhs._acquired);
+
+    return *this;
+}
+
+
+SharedRingChannel::size_type
+SharedRingChannel::bufferSizeFor(uint32 slotCount, uint32 slotSize) noexcept {
+    return sizeof(RingHeader) + static_cast<size_type>(slotCount) * slotSize;
+}
+
+
+SharedRingChannel
+SharedRingChannel::create(MemoryBuffer&& region, uint32 slotCount, uint32 slotSize, bool withDoorbell) {
+    if (!isPowerOfTwo(slotCount)) {
+        raise<IllegalArgumentException>("slotCount");
+    }
+
+    if (slotSize == 0) {
+        raise<IllegalArgumentException>("slotSize");
+    }
+
+    if (region.size() < bufferSizeFor(slotCount, slotSize)) {
+        raise<IllegalArgumentException>("region");
+    }
+
+    auto* header = headerOf(region);
+    header->slotCount = slotCount;
+    header->slotSize = slotSize;
+    header->mask = slotCount - 1;
+    header->head.store(0, std::memory_order_relaxed);
+    header->tail.store(0, std::memory_order_relaxed);
+    // The magic goes in last so a concurrent attach() never sees a half-formatted ring:
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = kRingMagic;
+
+    poll_id doorbell = ISelectable::InvalidFd;
+    if (withDoorbell) {
+#ifdef SOLACE_PLATFORM_LINUX
+        doorbell = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+        if (doorbell < 0) {
+            raise<IOException>(errno, "eventfd");
+        }
+#else
+        raise<IOException>("Doorbell is not supported on this platform");
+#endif
+    }
+
+    return SharedRingChannel(std::move(region), doorbell);
+}
+
+
+SharedRingChannel
+SharedRingChannel::attach(MemoryBuffer&& region, poll_id doorbell) {
+    if (region.size() < sizeof(RingHeader)) {
+        raise<IllegalArgumentException>("region");
+    }
+
+    auto const* header = headerOf(region);
+    if (header->magic != kRingMagic) {
+        raise<IllegalArgumentException>("region");
+    }
+
+    if (region.size() < bufferSizeFor(header->slotCount, header->slotSize)) {
+        raise<IllegalArgumentException>("region");
+    }
+
+    return SharedRingChannel(std::move(region), doorbell);
+}
+
+
+SharedRingChannel::size_type
+SharedRingChannel::reserve(ArrayView<MemoryView> slots) {
+    auto* header = headerOf(_region);
+
+    auto const tail = header->tail.load(std::memory_order_relaxed);
+    auto const head = header->head.load(std::memory_order_acquire);
+    auto const free = header->slotCount - static_cast<uint32>(tail - head);
+
+    auto const count = static_cast<size_type>(std::min<uint64>(free, slots.size()));
+    for (size_type i = 0; i < count; ++i) {
+        slots[i] = slotAt(_region, header, tail + i);
+    }
+
+    _reserved = tail + count;
+
+    return count;
+}
+
+
+void SharedRingChannel::commit(size_type count) {
+    auto* header = headerOf(_region);
+
+    auto const tail = header->tail.load(std::memory_order_relaxed);
+    if (tail + count > _reserved) {
+        raise<IllegalArgumentException>("count");
+    }
+
+    // Payload writes must be visible before the cursor that publishes them:
+    header->tail.store(tail + count, std::memory_order_release);
+
+#ifdef SOLACE_PLATFORM_LINUX
+    if (count > 0 && _doorbell != ISelectable::InvalidFd) {
+        const uint64 one = 1;
+        auto const ignored = ::write(_doorbell, &one, sizeof(one));
+        (void)ignored;  // A full eventfd still wakes the consumer up.
+    }
+#endif
+}
+
+
+SharedRingChannel::size_type
+SharedRingChannel::acquire(ArrayView<MemoryView> slots) {
+    auto* header = headerOf(_region);
+
+    auto const head = header->head.load(std::memory_order_relaxed);
+    auto const tail = header->tail.load(std::memory_order_acquire);
+    auto const pending = static_cast<uint32>(tail - head);
+
+    auto const count = static_cast<size_type>(std::min<uint64>(pending, slots.size()));
+    for (size_type i = 0; i < count; ++i) {
+        slots[i] = slotAt(_region, header, head + i);
+    }
+
+    _acquired = head + count;
+
+    return count;
+}
+
+
+void SharedRingChannel::release(size_type count) {
+    auto* header = headerOf(_region);
+
+    auto const head = header->head.load(std::memory_order_relaxed);
+    if (head + count > _acquired) {
+        raise<IllegalArgumentException>("count");
+    }
+
+    // The consumer must be done reading the slots before they are handed back:
+    header->head.store(head + count, std::memory_order_release);
+}
+
+
+SharedRingChannel::size_type SharedRingChannel::size() const noexcept {
+    auto const* header = headerOf(_region);
+
+    auto const head = header->head.load(std::memory_order_acquire);
+    auto const tail = header->tail.load(std::memory_order_acquire);
+
+    return static_cast<size_type>(tail - head);
+}
+
+
+uint32 SharedRingChannel::capacity() const noexcept {
+    return headerOf(_region)->slotCount;
+}
+
+
+uint32 SharedRingChannel::slotSize() const noexcept {
+    return headerOf(_region)->slotSize;
+}
+
+
+void SharedRingChannel::drainDoorbell() {
+#ifdef SOLACE_PLATFORM_LINUX
+    if (_doorbell == ISelectable::InvalidFd) {
+        return;
+    }
+
+    uint64 counter;
+    while (::read(_doorbell, &counter, sizeof(counter)) > 0) {
+        // Keep draining: the producer may have rung more than once.
+    }
+#endif
+}
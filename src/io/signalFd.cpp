@@ -0,0 +1,104 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/signalFd.cpp
+*******************************************************************************/
+#include <solace/io/signalFd.hpp>
+#include <solace/exception.hpp>
+
+#include <algorithm>
+#include <cerrno>
+
+#ifdef SOLACE_PLATFORM_LINUX
+#include <sys/signalfd.h>
+#endif
+#include <signal.h>
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+SignalFd SignalFd::create(std::initializer_list<int> signals) {
+    sigset_t mask;
+    sigemptyset(&mask);
+    for (auto signal : signals) {
+        sigaddset(&mask, signal);
+    }
+
+    // Block the signals so they queue for the fd instead of firing handlers:
+    if (pthread_sigmask(SIG_BLOCK, &mask, nullptr) != 0) {
+        raise<IOException>(errno, "pthread_sigmask");
+    }
+
+    auto const fd = signalfd(-1, &mask, SFD_NONBLOCK | SFD_CLOEXEC);
+    if (fd < 0) {
+        raise<IOException>(errno, "signalfd");
+    }
+
+    return SignalFd(fd);
+}
+
+
+SignalFd::~SignalFd() {
+    if (_fd != ISelectable::InvalidFd) {
+        ::close(_fd);
+        _fd = ISelectable::InvalidFd;
+    }
+}
+
+
+Optional<SignalFd::SignalInfo> SignalFd::take() {
+    SignalInfo info;
+    if (read(ArrayView<SignalInfo>(&info, 1)) == 0) {
+        return none;
+    }
+
+    return Optional<SignalInfo>(std::move(info));
+}
+
+
+SignalFd::size_type SignalFd::read(ArrayView<SignalInfo> dest) {
+    if (dest.empty()) {
+        return 0;
+    }
+
+    signalfd_siginfo pending[16];
+    auto const batchSize = std::min<size_t>(dest.size(), sizeof(pending) / sizeof(pending[0]));
+
+    auto const bytesRead = ::read(_fd, pending, batchSize * sizeof(signalfd_siginfo));
+    if (bytesRead < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return 0;
+        }
+
+        raise<IOException>(errno, "read");
+    }
+
+    auto const count = static_cast<size_type>(bytesRead / sizeof(signalfd_siginfo));
+    for (size_type i = 0; i < count; ++i) {
+        dest[i].signal = static_cast<int32>(pending[i].ssi_signo);
+        dest[i].senderPid = static_cast<int32>(pending[i].ssi_pid);
+        dest[i].senderUid = pending[i].ssi_uid;
+    }
+
+    return count;
+}
+
+#endif  // SOLACE_PLATFORM_LINUX
@@ -0,0 +1,533 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/socket.cpp
+ *
+ * Berkley socket wrappers
+*******************************************************************************/
+#include <solace/io/socket.hpp>
+#include <solace/exception.hpp>
+
+#include <cstring>      // memset / memcpy
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+namespace /*anonymous*/ {
+
+bool looksLikeV6(StringView address) {
+    for (StringView::size_type i = 0; i < address.size(); ++i) {
+        if (address[i] == ':') {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+
+/** Parse a numeric IPv4/IPv6 address + port into a native socket address. */
+socklen_t parseAddress(StringView address, uint16 port, sockaddr_storage& dest) {
+    char buffer[INET6_ADDRSTRLEN];
+    if (address.size() >= sizeof(buffer)) {
+        raise<IllegalArgumentException>("address");
+    }
+
+    memcpy(buffer, address.data(), address.size());
+    buffer[address.size()] = '\0';
+
+    memset(&dest, 0, sizeof(dest));
+
+    if (looksLikeV6(address)) {
+        auto& addr = reinterpret_cast<sockaddr_in6&>(dest);
+        addr.sin6_family = AF_INET6;
+        addr.sin6_port = htons(port);
+        if (1 != inet_pton(AF_INET6, buffer, &addr.sin6_addr)) {
+            raise<IllegalArgumentException>("address");
+        }
+
+        return sizeof(sockaddr_in6);
+    }
+
+    auto& addr = reinterpret_cast<sockaddr_in&>(dest);
+    addr.sin_family = AF_INET;
+    addr.sin_port = htons(port);
+    if (1 != inet_pton(AF_INET, buffer, &addr.sin_addr)) {
+        raise<IllegalArgumentException>("address");
+    }
+
+    return sizeof(sockaddr_in);
+}
+
+
+socklen_t parseUnixPath(StringView path, sockaddr_un& dest) {
+    if (path.size() >= sizeof(dest.sun_path)) {
+        raise<IllegalArgumentException>("path");
+    }
+
+    memset(&dest, 0, sizeof(dest));
+    dest.sun_family = AF_UNIX;
+    memcpy(dest.sun_path, path.data(), path.size());
+
+    return static_cast<socklen_t>(offsetof(sockaddr_un, sun_path) + path.size() + 1);
+}
+
+
+/** The shared accept-until-EAGAIN loop behind TCP and Unix acceptBatch(). */
+ArrayView<ISelectable::poll_id>
+acceptUntilDry(int listenFd, ArrayView<ISelectable::poll_id> slots) {
+    ArrayView<ISelectable::poll_id>::size_type taken = 0;
+
+    while (taken < slots.size()) {
+        const auto clientFd = ::accept4(listenFd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+        if (-1 == clientFd) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;  // Backlog is dry.
+            }
+            if (errno == EINTR || errno == ECONNABORTED) {
+                continue;  // The client is gone already; take the next one.
+            }
+
+            if (taken == 0) {
+                raise<IOException>(errno);
+            }
+
+            break;  // Keep what the batch has - the caller sees the error on the next call.
+        }
+
+        slots[taken++] = clientFd;
+    }
+
+    return (taken == slots.size()) ? slots : slots.slice(0, taken);
+}
+
+
+int familyOf(StringView address) {
+    return looksLikeV6(address) ? AF_INET6 : AF_INET;
+}
+
+
+bool beginConnect(int fd, const sockaddr* addr, socklen_t addrLen) {
+    if (0 == ::connect(fd, addr, addrLen)) {
+        return true;
+    }
+
+    if (errno == EINPROGRESS || errno == EAGAIN || errno == EWOULDBLOCK) {
+        return false;  // In progress: poll for Write and finishConnect().
+    }
+
+    raise<IOException>(errno);
+    return false;  // Unreachable.
+}
+
+
+bool checkConnectionOutcome(int fd) {
+    int soError = 0;
+    socklen_t len = sizeof(soError);
+    if (-1 == getsockopt(fd, SOL_SOCKET, SO_ERROR, &soError, &len)) {
+        raise<IOException>(errno);
+    }
+
+    if (soError == 0) {
+        return true;
+    }
+
+    if (soError == EINPROGRESS || soError == EALREADY) {
+        return false;
+    }
+
+    raise<IOException>(soError);
+    return false;  // Unreachable.
+}
+
+
+uint16 portOfBoundSocket(int fd) {
+    sockaddr_storage local;
+    socklen_t len = sizeof(local);
+    if (-1 == getsockname(fd, reinterpret_cast<sockaddr*>(&local), &len)) {
+        raise<IOException>(errno);
+    }
+
+    if (local.ss_family == AF_INET6) {
+        return ntohs(reinterpret_cast<const sockaddr_in6&>(local).sin6_port);
+    }
+
+    return ntohs(reinterpret_cast<const sockaddr_in&>(local).sin_port);
+}
+
+}  // namespace
+
+
+//------------------------------------------------------------------------------
+// Socket
+//------------------------------------------------------------------------------
+
+Socket::poll_id Socket::createFd(int domain, int type, int protocol) {
+    const auto fd = ::socket(domain, type | SOCK_NONBLOCK | SOCK_CLOEXEC, protocol);
+    if (-1 == fd) {
+        raise<IOException>(errno);
+    }
+
+    return fd;
+}
+
+
+void Socket::setBlocking(bool blocking) {
+    const auto fd = validateFd();
+
+    const auto flags = fcntl(fd, F_GETFL);
+    if (-1 == flags) {
+        raise<IOException>(errno);
+    }
+
+    const auto newFlags = blocking ? (flags & ~O_NONBLOCK) : (flags | O_NONBLOCK);
+    if (-1 == fcntl(fd, F_SETFL, newFlags)) {
+        raise<IOException>(errno);
+    }
+}
+
+
+void Socket::setSendBufferSize(int bytes) {
+    if (-1 == setsockopt(validateFd(), SOL_SOCKET, SO_SNDBUF, &bytes, sizeof(bytes))) {
+        raise<IOException>(errno);
+    }
+}
+
+
+void Socket::setReceiveBufferSize(int bytes) {
+    if (-1 == setsockopt(validateFd(), SOL_SOCKET, SO_RCVBUF, &bytes, sizeof(bytes))) {
+        raise<IOException>(errno);
+    }
+}
+
+
+int Socket::getSendBufferSize() const {
+    int bytes = 0;
+    socklen_t len = sizeof(bytes);
+    if (-1 == getsockopt(validateFd(), SOL_SOCKET, SO_SNDBUF, &bytes, &len)) {
+        raise<IOException>(errno);
+    }
+
+    return bytes;
+}
+
+
+int Socket::getReceiveBufferSize() const {
+    int bytes = 0;
+    socklen_t len = sizeof(bytes);
+    if (-1 == getsockopt(validateFd(), SOL_SOCKET, SO_RCVBUF, &bytes, &len)) {
+        raise<IOException>(errno);
+    }
+
+    return bytes;
+}
+
+
+//------------------------------------------------------------------------------
+// TcpSocket
+//------------------------------------------------------------------------------
+
+TcpSocket TcpSocket::create(StringView address) {
+    return TcpSocket(createFd(familyOf(address), SOCK_STREAM, 0));
+}
+
+
+bool TcpSocket::connect(StringView address, uint16 port) {
+    const auto fd = validateFd();
+
+    sockaddr_storage addr;
+    const auto addrLen = parseAddress(address, port, addr);
+
+    return beginConnect(fd, reinterpret_cast<const sockaddr*>(&addr), addrLen);
+}
+
+
+bool TcpSocket::finishConnect() {
+    return checkConnectionOutcome(validateFd());
+}
+
+
+void TcpSocket::setNoDelay(bool enable) {
+    const int value = enable ? 1 : 0;
+    if (-1 == setsockopt(validateFd(), IPPROTO_TCP, TCP_NODELAY, &value, sizeof(value))) {
+        raise<IOException>(errno);
+    }
+}
+
+
+//------------------------------------------------------------------------------
+// TcpAcceptor
+//------------------------------------------------------------------------------
+
+TcpAcceptor TcpAcceptor::bind(StringView address, uint16 port, int backlog) {
+    sockaddr_storage addr;
+    const auto addrLen = parseAddress(address, port, addr);
+
+    auto acceptor = TcpAcceptor(createFd(familyOf(address), SOCK_STREAM, 0));
+    const auto fd = acceptor.validateFd();
+
+    const int enable = 1;
+    if (-1 == setsockopt(fd, SOL_SOCKET, SO_REUSEADDR, &enable, sizeof(enable))) {
+        raise<IOException>(errno);
+    }
+
+    if (-1 == ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), addrLen)) {
+        raise<IOException>(errno);
+    }
+
+    if (-1 == ::listen(fd, backlog)) {
+        raise<IOException>(errno);
+    }
+
+    return acceptor;
+}
+
+
+Optional<TcpSocket> TcpAcceptor::accept() {
+    const auto fd = validateFd();
+
+    const auto clientFd = ::accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (-1 == clientFd) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == ECONNABORTED) {
+            return none;
+        }
+
+        raise<IOException>(errno);
+    }
+
+    return Optional<TcpSocket>(TcpSocket(clientFd));
+}
+
+
+ArrayView<TcpAcceptor::poll_id>
+TcpAcceptor::acceptBatch(ArrayView<poll_id> slots) {
+    return acceptUntilDry(validateFd(), slots);
+}
+
+
+uint16 TcpAcceptor::boundPort() const {
+    return portOfBoundSocket(validateFd());
+}
+
+
+ArrayView<ISelectable::poll_id> AcceptSlab::slots() noexcept {
+    auto view = _storage.view();
+    auto* first = reinterpret_cast<ISelectable::poll_id*>(
+            const_cast<ImmutableMemoryView::value_type*>(view.dataAddress()));
+
+    return ArrayView<ISelectable::poll_id>(first, capacity());
+}
+
+
+//------------------------------------------------------------------------------
+// UdpSocket
+//------------------------------------------------------------------------------
+
+UdpSocket UdpSocket::create(StringView address) {
+    return UdpSocket(createFd(familyOf(address), SOCK_DGRAM, 0));
+}
+
+
+void UdpSocket::bind(StringView address, uint16 port) {
+    const auto fd = validateFd();
+
+    sockaddr_storage addr;
+    const auto addrLen = parseAddress(address, port, addr);
+
+    if (-1 == ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), addrLen)) {
+        raise<IOException>(errno);
+    }
+}
+
+
+void UdpSocket::connect(StringView address, uint16 port) {
+    const auto fd = validateFd();
+
+    sockaddr_storage addr;
+    const auto addrLen = parseAddress(address, port, addr);
+
+    if (-1 == ::connect(fd, reinterpret_cast<const sockaddr*>(&addr), addrLen)) {
+        raise<IOException>(errno);
+    }
+}
+
+
+IOObject::IOResult
+UdpSocket::sendTo(StringView address, uint16 port, const ImmutableMemoryView& message) {
+    const auto fd = validateFd();
+
+    sockaddr_storage addr;
+    const auto addrLen = parseAddress(address, port, addr);
+
+    const auto bytesSent = ::sendto(fd, message.dataAddress(), message.size(), 0,
+                                    reinterpret_cast<const sockaddr*>(&addr), addrLen);
+    if (bytesSent < 0) {
+        raise<IOException>(errno);
+    }
+
+    return IOObject::IOResult(bytesSent);
+}
+
+
+Socket::size_type UdpSocket::receiveMany(ArrayView<MemoryView> buffers) {
+    const auto fd = validateFd();
+
+    const auto batchSize = (buffers.size() < MaxIOSegments) ? static_cast<uint32>(buffers.size())
+                                                            : MaxIOSegments;
+    struct mmsghdr headers[MaxIOSegments];
+    struct iovec iov[MaxIOSegments];
+
+    memset(headers, 0, sizeof(headers[0]) * batchSize);
+    for (uint32 i = 0; i < batchSize; ++i) {
+        iov[i].iov_base = buffers[i].dataAddress();
+        iov[i].iov_len = buffers[i].size();
+        headers[i].msg_hdr.msg_iov = &iov[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const auto received = ::recvmmsg(fd, headers, batchSize, 0, nullptr);
+    if (received < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return 0;
+        }
+
+        raise<IOException>(errno);
+    }
+
+    // Trim each buffer view to the received datagram length:
+    for (int i = 0; i < received; ++i) {
+        buffers[i] = buffers[i].slice(0, headers[i].msg_len);
+    }
+
+    return received;
+}
+
+
+Socket::size_type UdpSocket::sendMany(ArrayView<ImmutableMemoryView> messages) {
+    const auto fd = validateFd();
+
+    const auto batchSize = (messages.size() < MaxIOSegments) ? static_cast<uint32>(messages.size())
+                                                             : MaxIOSegments;
+    struct mmsghdr headers[MaxIOSegments];
+    struct iovec iov[MaxIOSegments];
+
+    memset(headers, 0, sizeof(headers[0]) * batchSize);
+    for (uint32 i = 0; i < batchSize; ++i) {
+        iov[i].iov_base = const_cast<byte*>(messages[i].dataAddress());
+        iov[i].iov_len = messages[i].size();
+        headers[i].msg_hdr.msg_iov = &iov[i];
+        headers[i].msg_hdr.msg_iovlen = 1;
+    }
+
+    const auto sent = ::sendmmsg(fd, headers, batchSize, 0);
+    if (sent < 0) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return 0;
+        }
+
+        raise<IOException>(errno);
+    }
+
+    return sent;
+}
+
+
+uint16 UdpSocket::boundPort() const {
+    return portOfBoundSocket(validateFd());
+}
+
+
+//------------------------------------------------------------------------------
+// UnixSocket
+//------------------------------------------------------------------------------
+
+UnixSocket UnixSocket::create() {
+    return UnixSocket(createFd(AF_UNIX, SOCK_STREAM, 0));
+}
+
+
+bool UnixSocket::connect(StringView path) {
+    const auto fd = validateFd();
+
+    sockaddr_un addr;
+    const auto addrLen = parseUnixPath(path, addr);
+
+    return beginConnect(fd, reinterpret_cast<const sockaddr*>(&addr), addrLen);
+}
+
+
+bool UnixSocket::finishConnect() {
+    return checkConnectionOutcome(validateFd());
+}
+
+
+//------------------------------------------------------------------------------
+// UnixAcceptor
+//------------------------------------------------------------------------------
+
+UnixAcceptor UnixAcceptor::bind(StringView path, int backlog) {
+    sockaddr_un addr;
+    const auto addrLen = parseUnixPath(path, addr);
+
+    // Remove a stale socket file left from a previous run:
+    unlink(addr.sun_path);
+
+    auto acceptor = UnixAcceptor(createFd(AF_UNIX, SOCK_STREAM, 0));
+    const auto fd = acceptor.validateFd();
+
+    if (-1 == ::bind(fd, reinterpret_cast<const sockaddr*>(&addr), addrLen)) {
+        raise<IOException>(errno);
+    }
+
+    if (-1 == ::listen(fd, backlog)) {
+        raise<IOException>(errno);
+    }
+
+    return acceptor;
+}
+
+
+Optional<UnixSocket> UnixAcceptor::accept() {
+    const auto fd = validateFd();
+
+    const auto clientFd = ::accept4(fd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+    if (-1 == clientFd) {
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR || errno == ECONNABORTED) {
+            return none;
+        }
+
+        raise<IOException>(errno);
+    }
+
+    return Optional<UnixSocket>(UnixSocket(clientFd));
+}
+
+
+ArrayView<UnixAcceptor::poll_id>
+UnixAcceptor::acceptBatch(ArrayView<poll_id> slots) {
+    return acceptUntilDry(validateFd(), slots);
+}
@@ -0,0 +1,134 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/syncService.cpp
+*******************************************************************************/
+#include <solace/io/syncService.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+SyncService::SyncService() :
+    _stopped(false),
+    _flusher(&SyncService::flusherLoop, this)
+{
+}
+
+
+SyncService::~SyncService() {
+    stop();
+}
+
+
+void SyncService::stop() {
+    {
+        std::lock_guard<std::mutex> lock(_guard);
+        if (_stopped) {
+            return;
+        }
+
+        _stopped = true;
+    }
+
+    _workPending.notify_all();
+    if (_flusher.joinable()) {
+        _flusher.join();
+    }
+}
+
+
+Future<void> SyncService::sync(File& file, bool syncMetadata) {
+    Promise<void> completion;
+    auto future = completion.getFuture();
+
+    {
+        std::lock_guard<std::mutex> lock(_guard);
+        if (_stopped) {
+            completion.setError(Error("SyncService is stopped"));
+
+            return future;
+        }
+
+        _queue.push_back(Request{file.getSelectId(), syncMetadata, false, std::move(completion)});
+    }
+
+    _workPending.notify_one();
+
+    return future;
+}
+
+
+void SyncService::flusherLoop() {
+    std::vector<Request> batch;
+
+    std::unique_lock<std::mutex> lock(_guard);
+    for (;;) {
+        while (_queue.empty() && !_stopped) {
+            _workPending.wait(lock);
+        }
+
+        if (_queue.empty() && _stopped) {
+            return;
+        }
+
+        // Take the whole queue in one go: everything queued while the
+        // previous sync was on the disk commits under a single syscall.
+        batch.swap(_queue);
+        lock.unlock();
+
+        // One sync per distinct fd covers every request for it. An fsync
+        // request upgrades the whole fd's round from fdatasync.
+        for (size_t i = 0; i < batch.size(); ++i) {
+            auto const fd = batch[i].fd;
+            if (batch[i].handled) {
+                continue;  // Covered as a duplicate of an earlier request.
+            }
+
+            bool syncMetadata = batch[i].syncMetadata;
+            for (size_t j = i + 1; j < batch.size(); ++j) {
+                if (batch[j].fd == fd) {
+                    syncMetadata = syncMetadata || batch[j].syncMetadata;
+                }
+            }
+
+            auto const result = syncMetadata ? ::fsync(fd) : ::fdatasync(fd);
+            auto const failure = (result < 0) ? errno : 0;
+
+            for (size_t j = i; j < batch.size(); ++j) {
+                if (batch[j].fd != fd || batch[j].handled) {
+                    continue;
+                }
+
+                if (failure != 0) {
+                    batch[j].completion.setError(Error(strerror(failure), failure));
+                } else {
+                    batch[j].completion.setValue();
+                }
+                batch[j].handled = true;
+            }
+        }
+
+        batch.clear();
+        lock.lock();
+    }
+}
@@ -0,0 +1,295 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/timerWheel.cpp
+ * Hierarchical timer wheel over a single timerfd
+ *
+ * Classic Varghese/Lauck wheel: kLevels levels of kWheelSize slots, timers
+ * hashed by deadline, higher levels cascaded into lower ones as the clock
+ * crosses level boundaries. All bookkeeping is index based so schedule and
+ * cancel never allocate once the node pool is warm.
+*******************************************************************************/
+#include <solace/io/timerWheel.hpp>
+#include <solace/exception.hpp>
+
+#include <unistd.h>     // close(), read()
+#include <cerrno>
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+#include <sys/timerfd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+TimerWheel::~TimerWheel() {
+    close(_timerFd);  // TODO(abbyssoul): Maybe check return value?
+}
+
+
+TimerWheel::TimerWheel(uint32 tickDurationMs) :
+    _tickDurationMs(tickDurationMs > 0 ? tickDurationMs : 1)
+{
+    for (auto& level : _slots) {
+        for (auto& slot : level) {
+            slot = kNil;
+        }
+    }
+
+    _timerFd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+    if (-1 == _timerFd) {
+        Solace::raise<IOException>(errno);
+    }
+}
+
+
+TimerWheel::timer_id TimerWheel::schedule(uint64 delayMs, void* data) {
+    const uint64 ticks = (delayMs + _tickDurationMs - 1) / _tickDurationMs;
+
+    const auto nodeIndex = acquireNode();
+    auto& node = _nodes[nodeIndex];
+    node.deadline = _currentTick + (ticks > 0 ? ticks : 1);
+    node.data = data;
+    node.pending = true;
+
+    link(nodeIndex);
+    _nbPending += 1;
+
+    if (!_armed) {
+        armTimerFd();
+    }
+
+    return (static_cast<timer_id>(node.generation) << 32) | nodeIndex;
+}
+
+
+bool TimerWheel::cancel(timer_id id) {
+    const auto nodeIndex = static_cast<size_type>(id & 0xFFFFFFFF);
+    const auto generation = static_cast<uint32>(id >> 32);
+
+    if (nodeIndex >= _nodes.size()) {
+        return false;
+    }
+
+    auto& node = _nodes[nodeIndex];
+    if (!node.pending || node.generation != generation) {
+        return false;  // Already fired or cancelled - the handle is stale.
+    }
+
+    unlink(nodeIndex);
+    releaseNode(nodeIndex);
+    _nbPending -= 1;
+
+    if (empty() && _readyEvents.empty()) {
+        disarmTimerFd();
+    }
+
+    return true;
+}
+
+
+TimerWheel::size_type TimerWheel::expire(ArrayView<Selector::Event> events) {
+    uint64 elapsedTicks = 0;
+    const auto r = read(_timerFd, &elapsedTicks, sizeof(elapsedTicks));
+    if (r == sizeof(elapsedTicks)) {
+        while (elapsedTicks > 0 && _nbPending > 0) {
+            advanceTick();
+            elapsedTicks -= 1;
+        }
+    }
+
+    size_type count = 0;
+    const auto capacity = events.size();
+    while (_readyCursor < _readyEvents.size() && count < capacity) {
+        events[count] = _readyEvents[_readyCursor];
+        count += 1;
+        _readyCursor += 1;
+    }
+
+    if (_readyCursor >= _readyEvents.size()) {
+        _readyEvents.clear();
+        _readyCursor = 0;
+
+        if (empty()) {
+            disarmTimerFd();
+        }
+    }
+
+    return count;
+}
+
+
+void TimerWheel::advance(uint64 elapsedMs) {
+    auto ticks = elapsedMs / _tickDurationMs;
+    while (ticks > 0 && _nbPending > 0) {
+        advanceTick();
+        ticks -= 1;
+    }
+}
+
+
+void TimerWheel::link(size_type nodeIndex) {
+    auto& node = _nodes[nodeIndex];
+    const uint64 delta = node.deadline - _currentTick;
+
+    size_type level = 0;
+    while ((level + 1 < kLevels) && (delta >> (kWheelBits * (level + 1))) != 0) {
+        level += 1;
+    }
+
+    const auto slotIndex = static_cast<size_type>((node.deadline >> (kWheelBits * level)) & (kWheelSize - 1));
+
+    node.slot = level * kWheelSize + slotIndex;
+    node.prev = kNil;
+    node.next = _slots[level][slotIndex];
+    if (node.next != kNil) {
+        _nodes[node.next].prev = nodeIndex;
+    }
+
+    _slots[level][slotIndex] = nodeIndex;
+}
+
+
+void TimerWheel::unlink(size_type nodeIndex) {
+    auto& node = _nodes[nodeIndex];
+
+    if (node.prev != kNil) {
+        _nodes[node.prev].next = node.next;
+    } else {
+        _slots[node.slot / kWheelSize][node.slot % kWheelSize] = node.next;
+    }
+
+    if (node.next != kNil) {
+        _nodes[node.next].prev = node.prev;
+    }
+}
+
+
+TimerWheel::size_type TimerWheel::acquireNode() {
+    if (_freeList != kNil) {
+        const auto nodeIndex = _freeList;
+        _freeList = _nodes[nodeIndex].next;
+
+        return nodeIndex;
+    }
+
+    _nodes.push_back(Node{0, nullptr, kNil, kNil, 0, 0, false});
+
+    return static_cast<size_type>(_nodes.size() - 1);
+}
+
+
+void TimerWheel::releaseNode(size_type nodeIndex) {
+    auto& node = _nodes[nodeIndex];
+    node.pending = false;
+    node.generation += 1;       // Invalidates any outstanding handle to this node.
+    node.next = _freeList;
+
+    _freeList = nodeIndex;
+}
+
+
+void TimerWheel::fireNode(size_type nodeIndex) {
+    Selector::Event event;
+    event.fd = _timerFd;
+    event.events = Selector::Events::Read;
+    event.data = _nodes[nodeIndex].data;
+    _readyEvents.push_back(event);
+
+    releaseNode(nodeIndex);
+    _nbPending -= 1;
+}
+
+
+void TimerWheel::advanceTick() {
+    _currentTick += 1;
+
+    if ((_currentTick & (kWheelSize - 1)) == 0) {
+        cascade(1);
+    }
+
+    const auto slotIndex = static_cast<size_type>(_currentTick & (kWheelSize - 1));
+    auto head = _slots[0][slotIndex];
+    _slots[0][slotIndex] = kNil;
+
+    while (head != kNil) {
+        const auto next = _nodes[head].next;
+        fireNode(head);
+        head = next;
+    }
+}
+
+
+void TimerWheel::cascade(size_type level) {
+    if (level >= kLevels) {
+        return;
+    }
+
+    const auto slotIndex = static_cast<size_type>((_currentTick >> (kWheelBits * level)) & (kWheelSize - 1));
+    if (slotIndex == 0) {
+        cascade(level + 1);
+    }
+
+    // Re-hash every timer of the crossed slot into a lower level:
+    auto head = _slots[level][slotIndex];
+    _slots[level][slotIndex] = kNil;
+
+    while (head != kNil) {
+        const auto next = _nodes[head].next;
+        if (_nodes[head].deadline <= _currentTick) {
+            fireNode(head);
+        } else {
+            link(head);
+        }
+        head = next;
+    }
+}
+
+
+void TimerWheel::armTimerFd() {
+    itimerspec spec;
+    spec.it_interval.tv_sec = _tickDurationMs / 1000;
+    spec.it_interval.tv_nsec = static_cast<long>(_tickDurationMs % 1000) * 1000000;
+    spec.it_value = spec.it_interval;
+
+    if (-1 == timerfd_settime(_timerFd, 0, &spec, nullptr)) {
+        Solace::raise<IOException>(errno);
+    }
+
+    _armed = true;
+}
+
+
+void TimerWheel::disarmTimerFd() {
+    if (!_armed) {
+        return;
+    }
+
+    itimerspec spec;
+    spec.it_interval.tv_sec = 0;
+    spec.it_interval.tv_nsec = 0;
+    spec.it_value = spec.it_interval;
+
+    if (-1 == timerfd_settime(_timerFd, 0, &spec, nullptr)) {
+        Solace::raise<IOException>(errno);
+    }
+
+    _armed = false;
+}
+
+#endif  // SOLACE_PLATFORM_LINUX
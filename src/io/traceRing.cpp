@@ -0,0 +1,160 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file: io/traceRing.cpp
+*******************************************************************************/
+#include <solace/io/traceRing.hpp>
+#include <solace/exception.hpp>
+
+#include <algorithm>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+namespace {
+
+constexpr uint32 kTraceMagic = 0x53545231;   // 'STR1', bumped on layout changes
+constexpr size_t kCacheLineSize = 64;
+
+/* The control block living at the start of the region. The cursor sits on
+ * its own cache line so readers polling it never contend with the writer's
+ * event stores. It is free-running: (cursor & mask) is the next slot, and
+ * cursor itself is the total number of events ever recorded.
+ */
+struct TraceHeader {
+    uint32 magic;
+    uint32 eventCount;
+
+    alignas(kCacheLineSize) std::atomic<uint64> next;     //!< Writer cursor
+};
+
+static_assert(std::is_trivially_destructible<TraceHeader>::value,
+              "TraceHeader must be placeable into raw mapped memory");
+static_assert(sizeof(TraceRing::Event) == 4 * sizeof(uint64),
+              "Trace events are a fixed 32-byte binary record");
+
+TraceHeader* headerOf(MemoryBuffer& region) {
+    return reinterpret_cast<TraceHeader*>(region.view().dataAddress());
+}
+
+TraceRing::Event* eventsOf(MemoryBuffer& region) {
+    return reinterpret_cast<TraceRing::Event*>(region.view().dataAddress(sizeof(TraceHeader)));
+}
+
+bool isPowerOfTwo(uint32 value) noexcept {
+    return (value >= 2) && ((value & (value - 1)) == 0);
+}
+
+}  // namespace
+
+
+TraceRing::TraceRing(TraceRing&& rhs) noexcept :
+    _region(std::move(rhs._region)),
+    _next(rhs._next),
+    _events(rhs._events),
+    _mask(rhs._mask)
+{
+    rhs._next = nullptr;
+    rhs._events = nullptr;
+    rhs._mask = 0;
+}
+
+
+TraceRing& TraceRing::swap(TraceRing& rhs) noexcept {
+    _region.swap(rhs._region);
+    std::swap(_next, rhs._next);
+    std::swap(_events, rhs._events);
+    std::swap(_mask, rhs._mask);
+
+    return *this;
+}
+
+
+TraceRing::size_type
+TraceRing::bufferSizeFor(uint32 eventCount) noexcept {
+    return sizeof(TraceHeader) + static_cast<size_type>(eventCount) * sizeof(Event);
+}
+
+
+TraceRing
+TraceRing::create(MemoryBuffer&& region, uint32 eventCount) {
+    if (!isPowerOfTwo(eventCount)) {
+        raise<IllegalArgumentException>("eventCount");
+    }
+
+    if (region.size() < bufferSizeFor(eventCount)) {
+        raise<IllegalArgumentException>("region");
+    }
+
+    auto* header = headerOf(region);
+    header->eventCount = eventCount;
+    header->next.store(0, std::memory_order_relaxed);
+    // The magic goes in last so a concurrent attach() never sees a half-formatted ring:
+    std::atomic_thread_fence(std::memory_order_release);
+    header->magic = kTraceMagic;
+
+    auto* events = eventsOf(region);
+    auto* next = &header->next;
+
+    return TraceRing(std::move(region), next, events, eventCount - 1);
+}
+
+
+TraceRing
+TraceRing::attach(MemoryBuffer&& region) {
+    if (region.size() < sizeof(TraceHeader)) {
+        raise<IllegalArgumentException>("region");
+    }
+
+    auto* header = headerOf(region);
+    if (header->magic != kTraceMagic || !isPowerOfTwo(header->eventCount)) {
+        raise<IllegalArgumentException>("region");
+    }
+
+    if (region.size() < bufferSizeFor(header->eventCount)) {
+        raise<IllegalArgumentException>("region");
+    }
+
+    auto* events = eventsOf(region);
+    auto* next = &header->next;
+    auto const mask = header->eventCount - 1;
+
+    return TraceRing(std::move(region), next, events, mask);
+}
+
+
+TraceRing::size_type
+TraceRing::readBack(ArrayView<Event> dest) const {
+    for (;;) {
+        auto const end = _next->load(std::memory_order_acquire);
+        auto const retained = std::min<uint64>(end, _mask + 1);
+        auto const count = static_cast<size_type>(std::min<uint64>(retained, dest.size()));
+
+        auto const first = end - count;
+        for (size_type i = 0; i < count; ++i) {
+            dest[i] = _events[(first + i) & _mask];
+        }
+
+        // A live writer may have lapped the slots just copied; if so the
+        // oldest of them are torn - take a fresh, shorter window and retry.
+        auto const endAfter = _next->load(std::memory_order_acquire);
+        if (endAfter - first <= _mask + 1) {
+            return count;
+        }
+    }
+}
@@ -22,6 +22,7 @@
  *	ID:			$Id$
  ******************************************************************************/
 #include "solace/ioobject.hpp"
+#include "solace/exception.hpp"
 
 using namespace Solace;
 
@@ -47,3 +48,36 @@ IOObject::write(ReadBuffer& srcBuffer, size_type bytesToWrite) {
                 return bytesRead;
             });
 }
+
+
+// Default adapters over the throwing surface: correct for every IO object,
+// but paying for the unwinding. Concrete objects override with direct paths.
+
+IOObject::TryResult
+IOObject::tryRead(MemoryView& destBuffer) {
+    try {
+        auto result = read(destBuffer);
+        if (!result.isOk()) {
+            return Err(systemError(result.getError().value()));
+        }
+
+        return Ok(result.unwrap());
+    } catch (IOException const& e) {
+        return Err(systemError(e.getErrorCode()));
+    }
+}
+
+
+IOObject::TryResult
+IOObject::tryWrite(const ImmutableMemoryView& srcBuffer) {
+    try {
+        auto result = write(srcBuffer);
+        if (!result.isOk()) {
+            return Err(systemError(result.getError().value()));
+        }
+
+        return Ok(result.unwrap());
+    } catch (IOException const& e) {
+        return Err(systemError(e.getErrorCode()));
+    }
+}
@@ -0,0 +1,375 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: Streaming JSON emitter
+ *	@file		jsonEmitter.cpp
+ ******************************************************************************/
+#include "solace/jsonEmitter.hpp"
+
+#include "solace/details/decimalFormat.hpp"
+
+#include <cmath>    // isfinite
+
+#if defined(__SSE2__)
+#include <emmintrin.h>  // SSE2 escape scan kernel
+#endif
+
+
+using namespace Solace;
+
+
+namespace /* anonymous */ {
+
+constexpr bool needsEscape(char c) noexcept {
+    return (static_cast<byte>(c) < 0x20) || (c == '"') || (c == '\\');
+}
+
+#if defined(__SSE2__)
+
+/** Escape classification of 16 bytes at once: bit i of the result is set if
+ * p[i] must be escaped in a JSON string - a quote, a backslash or a control
+ * character. Clean blocks come back as zero and are copied in bulk. */
+inline uint32 escapableMask16(char const* p) noexcept {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+
+    const __m128i isQuote = _mm_cmpeq_epi8(block, _mm_set1_epi8('"'));
+    const __m128i isSlash = _mm_cmpeq_epi8(block, _mm_set1_epi8('\\'));
+    // Signed compares: controls are 0x00..0x1F, so 'positive and below 0x20'.
+    // UTF-8 continuation bytes read as negative and stay out of the range.
+    const __m128i isControl = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(-1)),
+                                            _mm_cmplt_epi8(block, _mm_set1_epi8(0x20)));
+
+    return static_cast<uint32>(
+            _mm_movemask_epi8(_mm_or_si128(_mm_or_si128(isQuote, isSlash), isControl)));
+}
+
+#endif  // __SSE2__
+
+const char kHexDigits[] = "0123456789abcdef";
+
+}  // namespace
+
+
+void JsonEmitter::putRaw(char c) {
+    if (_error.isSome()) {
+        return;
+    }
+
+    auto result = _dest.write(c);
+    if (!result) {
+        _error = Optional<Error>(result.moveError());
+    }
+}
+
+
+void JsonEmitter::putRaw(char const* data, size_type size) {
+    if (_error.isSome() || size == 0) {
+        return;
+    }
+
+    auto result = _dest.write(wrapMemory(data, size));
+    if (!result) {
+        _error = Optional<Error>(result.moveError());
+    }
+}
+
+
+void JsonEmitter::putQuoted(StringView str) {
+    putRaw('"');
+
+    char const* data = str.data();
+    const size_type size = str.size();
+
+    // Copy runs of clean bytes wholesale; stop only on characters that need
+    // an escape sequence.
+    size_type runStart = 0;
+    size_type i = 0;
+
+    auto escapeAt = [&](size_type at) {
+        putRaw(data + runStart, at - runStart);
+        runStart = at + 1;
+
+        const char c = data[at];
+        switch (c) {
+        case '"':   putRaw("\\\"", 2);  break;
+        case '\\':  putRaw("\\\\", 2);  break;
+        case '\b':  putRaw("\\b", 2);   break;
+        case '\f':  putRaw("\\f", 2);   break;
+        case '\n':  putRaw("\\n", 2);   break;
+        case '\r':  putRaw("\\r", 2);   break;
+        case '\t':  putRaw("\\t", 2);   break;
+        default: {
+            const char unicode[] = {'\\', 'u', '0', '0',
+                                    kHexDigits[static_cast<byte>(c) >> 4],
+                                    kHexDigits[static_cast<byte>(c) & 0x0F]};
+            putRaw(unicode, sizeof(unicode));
+        } break;
+        }
+    };
+
+#if defined(__SSE2__)
+    for (; i + 16 <= size; i += 16) {
+        uint32 mask = escapableMask16(data + i);
+        while (mask != 0) {
+            escapeAt(i + static_cast<size_type>(__builtin_ctz(mask)));
+            mask &= mask - 1;
+        }
+    }
+#endif  // __SSE2__
+
+    for (; i < size; ++i) {
+        if (needsEscape(data[i])) {
+            escapeAt(i);
+        }
+    }
+
+    putRaw(data + runStart, size - runStart);
+    putRaw('"');
+}
+
+
+void JsonEmitter::beforeValue() {
+    if (_pendingName) {
+        _pendingName = false;
+
+        return;
+    }
+
+    if (_depth == 0) {
+        if (_rootClosed) {
+            // Another root document: newline-delimited JSON.
+            putRaw('\n');
+            _rootClosed = false;
+        }
+
+        return;
+    }
+
+    const uint64 levelBit = uint64(1) << (_depth - 1);
+    if ((_scopeIsObject & levelBit) && _error.isNone()) {
+        _error = Optional<Error>(Error("JsonEmitter: value in an object requires a key"));
+    }
+
+    if (_hasValue & levelBit) {
+        putRaw(',');
+    }
+    _hasValue |= levelBit;
+}
+
+
+JsonEmitter& JsonEmitter::name(StringView key) {
+    const uint64 levelBit = (_depth != 0) ? uint64(1) << (_depth - 1) : 0;
+    if ((_depth == 0 || !(_scopeIsObject & levelBit)) && _error.isNone()) {
+        _error = Optional<Error>(Error("JsonEmitter: key outside of an object"));
+    }
+
+    if (_hasValue & levelBit) {
+        putRaw(',');
+    }
+    _hasValue |= levelBit;
+
+    putQuoted(key);
+    putRaw(':');
+    _pendingName = true;
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::beginObject() {
+    beforeValue();
+    putRaw('{');
+
+    if (_depth >= kMaxDepth) {
+        if (_error.isNone()) {
+            _error = Optional<Error>(Error("JsonEmitter: nesting too deep"));
+        }
+
+        return *this;
+    }
+
+    _depth += 1;
+    const uint64 levelBit = uint64(1) << (_depth - 1);
+    _hasValue &= ~levelBit;
+    _scopeIsObject |= levelBit;
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::endObject() {
+    const uint64 levelBit = (_depth != 0) ? uint64(1) << (_depth - 1) : 0;
+    if ((_depth == 0 || !(_scopeIsObject & levelBit)) && _error.isNone()) {
+        _error = Optional<Error>(Error("JsonEmitter: mismatched endObject"));
+    }
+
+    putRaw('}');
+    if (_depth != 0) {
+        _depth -= 1;
+    }
+    if (_depth == 0) {
+        _rootClosed = true;
+    }
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::beginArray() {
+    beforeValue();
+    putRaw('[');
+
+    if (_depth >= kMaxDepth) {
+        if (_error.isNone()) {
+            _error = Optional<Error>(Error("JsonEmitter: nesting too deep"));
+        }
+
+        return *this;
+    }
+
+    _depth += 1;
+    const uint64 levelBit = uint64(1) << (_depth - 1);
+    _hasValue &= ~levelBit;
+    _scopeIsObject &= ~levelBit;
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::endArray() {
+    const uint64 levelBit = (_depth != 0) ? uint64(1) << (_depth - 1) : 0;
+    if ((_depth == 0 || (_scopeIsObject & levelBit)) && _error.isNone()) {
+        _error = Optional<Error>(Error("JsonEmitter: mismatched endArray"));
+    }
+
+    putRaw(']');
+    if (_depth != 0) {
+        _depth -= 1;
+    }
+    if (_depth == 0) {
+        _rootClosed = true;
+    }
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::value(StringView v) {
+    beforeValue();
+    putQuoted(v);
+    if (_depth == 0) {
+        _rootClosed = true;
+    }
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::value(uint64 v) {
+    beforeValue();
+
+    char scratch[details::kMaxDecimalDigits];
+    const auto pos = details::formatDecimal(v, scratch);
+    putRaw(scratch + pos, static_cast<size_type>(details::kMaxDecimalDigits - pos));
+
+    if (_depth == 0) {
+        _rootClosed = true;
+    }
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::value(int64 v) {
+    beforeValue();
+
+    char scratch[details::kMaxDecimalDigits + 1];
+    auto pos = details::formatDecimal((v < 0)
+                                      ? ~static_cast<uint64>(v) + 1
+                                      : static_cast<uint64>(v),
+                                      scratch + 1) + 1;
+    if (v < 0) {
+        scratch[--pos] = '-';
+    }
+    putRaw(scratch + pos, static_cast<size_type>(details::kMaxDecimalDigits + 1 - pos));
+
+    if (_depth == 0) {
+        _rootClosed = true;
+    }
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::value(float64 v) {
+    if (!std::isfinite(v)) {
+        // JSON has no spelling for NaN or infinities.
+        return nullValue();
+    }
+
+    beforeValue();
+
+    char scratch[32];
+    const auto len = details::formatShortestFloat(v, scratch);
+    putRaw(scratch, static_cast<size_type>(len));
+
+    if (_depth == 0) {
+        _rootClosed = true;
+    }
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::value(bool v) {
+    beforeValue();
+    if (v) {
+        putRaw("true", 4);
+    } else {
+        putRaw("false", 5);
+    }
+
+    if (_depth == 0) {
+        _rootClosed = true;
+    }
+
+    return *this;
+}
+
+
+JsonEmitter& JsonEmitter::nullValue() {
+    beforeValue();
+    putRaw("null", 4);
+    if (_depth == 0) {
+        _rootClosed = true;
+    }
+
+    return *this;
+}
+
+
+Result<void, Error>
+JsonEmitter::finish() {
+    if (_error.isSome()) {
+        return Err(_error.move());
+    }
+
+    if (_depth != 0) {
+        return Err(Error("JsonEmitter: unclosed scope"));
+    }
+
+    return Ok();
+}
@@ -0,0 +1,406 @@
+/*
+*  Copyright 2017 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: LZ4 block compression encoder/decoder
+ *	@file		lz4.cpp
+ ******************************************************************************/
+#include "solace/lz4.hpp"
+
+#include <cstring>  // memcpy
+
+
+using namespace Solace;
+
+
+namespace /*anonymous*/ {
+
+constexpr uint32 kMinMatch = 4;
+constexpr uint32 kMaxDistance = 65535;
+constexpr uint32 kHashLog = 12;
+constexpr uint32 kHashSize = 1 << kHashLog;
+constexpr uint32 kNoPosition = ~static_cast<uint32>(0);
+
+// The LZ4 block format forbids matches running into the last 5 bytes and
+// match search starting within the last 12 - both end as plain literals.
+constexpr uint32 kLastLiterals = 5;
+constexpr uint32 kMatchFindLimit = 12;
+
+constexpr uint32 kFrameHeaderSize = 8;
+
+
+uint32 hashOf32(uint32 sequence) noexcept {
+    return (sequence * 2654435761u) >> (32 - kHashLog);
+}
+
+
+/**
+ * The match window: the dictionary and the block being compressed addressed
+ * as one coordinate space, dictionary first. Keeps the matcher oblivious to
+ * whether a match starts in the dictionary or in the block itself.
+ */
+struct Window {
+    const byte* dict;
+    uint32      dictLen;
+    const byte* src;
+    uint32      srcLen;
+
+    uint32 total() const noexcept { return dictLen + srcLen; }
+
+    byte at(uint32 p) const noexcept {
+        return (p < dictLen) ? dict[p] : src[p - dictLen];
+    }
+
+    uint32 read32(uint32 p) const noexcept {
+        if (p >= dictLen) {
+            uint32 v;
+            memcpy(&v, src + (p - dictLen), sizeof(v));
+            return v;
+        }
+
+        if (p + sizeof(uint32) <= dictLen) {
+            uint32 v;
+            memcpy(&v, dict + p, sizeof(v));
+            return v;
+        }
+
+        // The rare read straddling the dictionary / block seam:
+        return static_cast<uint32>(at(p))
+                | (static_cast<uint32>(at(p + 1)) << 8)
+                | (static_cast<uint32>(at(p + 2)) << 16)
+                | (static_cast<uint32>(at(p + 3)) << 24);
+    }
+};
+
+
+void putLength(std::vector<byte>& out, uint32 value) {
+    while (value >= 255) {
+        out.push_back(255);
+        value -= 255;
+    }
+    out.push_back(static_cast<byte>(value));
+}
+
+
+void emitSequence(std::vector<byte>& out, const byte* literals, uint32 litLen,
+                  uint32 offset, uint32 matchLen) {
+    const auto litNibble = (litLen < 15) ? litLen : 15;
+    const auto matchNibble = (matchLen < kMinMatch + 15) ? (matchLen - kMinMatch) : 15;
+    out.push_back(static_cast<byte>((litNibble << 4) | matchNibble));
+
+    if (litLen >= 15) {
+        putLength(out, litLen - 15);
+    }
+    out.insert(out.end(), literals, literals + litLen);
+
+    out.push_back(static_cast<byte>(offset & 0xFF));
+    out.push_back(static_cast<byte>(offset >> 8));
+
+    if (matchLen >= kMinMatch + 15) {
+        putLength(out, matchLen - kMinMatch - 15);
+    }
+}
+
+
+void emitFinalLiterals(std::vector<byte>& out, const byte* literals, uint32 litLen) {
+    const auto litNibble = (litLen < 15) ? litLen : 15;
+    out.push_back(static_cast<byte>(litNibble << 4));
+
+    if (litLen >= 15) {
+        putLength(out, litLen - 15);
+    }
+    out.insert(out.end(), literals, literals + litLen);
+}
+
+
+/** Greedy single-pass LZ4 block compression of the window's block segment. */
+void compressBlock(Window const& w, std::vector<byte>& out) {
+    out.clear();
+
+    uint32 table[kHashSize];
+    for (auto& slot : table) {
+        slot = kNoPosition;
+    }
+
+    // Seed the matcher with the dictionary so the very first bytes of the
+    // block can already refer back to it:
+    if (w.dictLen >= kMinMatch) {
+        for (uint32 p = 0; p + kMinMatch <= w.dictLen; ++p) {
+            table[hashOf32(w.read32(p))] = p;
+        }
+    }
+
+    const auto total = w.total();
+    uint32 pos = w.dictLen;
+    uint32 anchor = w.dictLen;
+
+    if (w.srcLen > kMatchFindLimit) {
+        const auto matchFindLimit = total - kMatchFindLimit;
+        const auto matchEndLimit = total - kLastLiterals;
+
+        while (pos < matchFindLimit) {
+            const auto sequence = w.read32(pos);
+            const auto h = hashOf32(sequence);
+            const auto candidate = table[h];
+            table[h] = pos;
+
+            if (candidate == kNoPosition
+                || (pos - candidate) > kMaxDistance
+                || w.read32(candidate) != sequence) {
+                ++pos;
+                continue;
+            }
+
+            uint32 matchLen = kMinMatch;
+            while ((pos + matchLen) < matchEndLimit && w.at(candidate + matchLen) == w.at(pos + matchLen)) {
+                ++matchLen;
+            }
+
+            emitSequence(out, w.src + (anchor - w.dictLen), pos - anchor, pos - candidate, matchLen);
+            pos += matchLen;
+            anchor = pos;
+        }
+    }
+
+    emitFinalLiterals(out, w.src + (anchor - w.dictLen), total - anchor);
+}
+
+
+Error corruptFrame() {
+    return Error("Lz4Decoding error: Malformed frame");
+}
+
+
+/**
+ * Decode one LZ4 block into out, which is pre-sized to the expected raw
+ * length. Every read and write is bounds-checked against the declared sizes,
+ * so corrupt input fails cleanly instead of overrunning.
+ */
+Result<void, Error>
+decompressBlock(const byte* in, uint32 inLen, std::vector<byte>& out,
+                const byte* dict, uint32 dictLen) {
+    const auto rawSize = static_cast<uint32>(out.size());
+    uint32 ip = 0;
+    uint32 op = 0;
+
+    while (ip < inLen) {
+        const auto token = in[ip++];
+
+        uint32 litLen = token >> 4;
+        if (litLen == 15) {
+            byte more;
+            do {
+                if (ip >= inLen) return Err(corruptFrame());
+                more = in[ip++];
+                litLen += more;
+            } while (more == 255);
+        }
+
+        if (litLen > inLen - ip || litLen > rawSize - op) {
+            return Err(corruptFrame());
+        }
+        memcpy(out.data() + op, in + ip, litLen);
+        ip += litLen;
+        op += litLen;
+
+        if (ip == inLen) {
+            break;  // The last sequence carries no match.
+        }
+
+        if (inLen - ip < 2) {
+            return Err(corruptFrame());
+        }
+        const uint32 offset = static_cast<uint32>(in[ip]) | (static_cast<uint32>(in[ip + 1]) << 8);
+        ip += 2;
+        if (offset == 0) {
+            return Err(corruptFrame());
+        }
+
+        uint32 matchLen = (token & 0x0F);
+        if (matchLen == 15) {
+            byte more;
+            do {
+                if (ip >= inLen) return Err(corruptFrame());
+                more = in[ip++];
+                matchLen += more;
+            } while (more == 255);
+        }
+        matchLen += kMinMatch;
+
+        if (matchLen > rawSize - op) {
+            return Err(corruptFrame());
+        }
+
+        uint32 remaining = matchLen;
+        if (offset > op) {
+            // The match starts in the dictionary:
+            const auto fromDict = offset - op;
+            if (fromDict > dictLen) {
+                return Err(corruptFrame());
+            }
+
+            const auto dictPart = (remaining < fromDict) ? remaining : fromDict;
+            memcpy(out.data() + op, dict + (dictLen - fromDict), dictPart);
+            op += dictPart;
+            remaining -= dictPart;
+        }
+
+        // Byte-by-byte on purpose: overlapping matches (offset < length)
+        // replicate their own freshly written output.
+        while (remaining != 0) {
+            out[op] = out[op - offset];
+            ++op;
+            --remaining;
+        }
+    }
+
+    if (op != rawSize) {
+        return Err(corruptFrame());
+    }
+
+    return Ok();
+}
+
+
+/** Use no more than the reachable tail of a dictionary view. */
+Window windowOver(ImmutableMemoryView const& dictionary, const byte* src, uint32 srcLen) noexcept {
+    auto dictLen = static_cast<uint32>(dictionary.size());
+    auto* dict = dictionary.dataAddress();
+    if (dictLen > kMaxDistance) {
+        dict += dictLen - kMaxDistance;
+        dictLen = kMaxDistance;
+    }
+
+    return Window{dict, dictLen, src, srcLen};
+}
+
+}  // namespace
+
+
+Lz4Encoder::size_type Lz4Encoder::maxEncodedSize(size_type len) {
+    // Worst case the block expands by one token per 255-byte literal run,
+    // plus the frame header:
+    return len + len / 255 + 1 + kFrameHeaderSize;
+}
+
+
+Result<void, Error>
+Lz4Encoder::encode(ImmutableMemoryView const& src) {
+    const auto rawSize = static_cast<uint32>(src.size());
+
+    const auto w = windowOver(_dictionary, src.dataAddress(), rawSize);
+    compressBlock(w, _block);
+
+    const bool stored = (_block.size() >= rawSize);
+    const auto packedSize = stored ? rawSize : static_cast<uint32>(_block.size());
+
+    auto& dest = *getDestBuffer();
+    auto written = dest.writeLE(rawSize);
+    if (!written) {
+        return Err(written.moveError());
+    }
+
+    written = dest.writeLE(packedSize);
+    if (!written) {
+        return Err(written.moveError());
+    }
+
+    return stored
+            ? dest.write(src)
+            : dest.write(wrapMemory(_block.data(), packedSize));
+}
+
+
+Lz4Decoder::size_type Lz4Decoder::encodedSize(ImmutableMemoryView const& data) const {
+    const auto* bytes = data.dataAddress();
+    const auto len = data.size();
+
+    size_type total = 0;
+    for (decltype(data.size()) offset = 0; offset + kFrameHeaderSize <= len; ) {
+        uint32 rawSize = 0;
+        uint32 packedSize = 0;
+        for (uint32 i = 0; i < sizeof(uint32); ++i) {
+            rawSize |= static_cast<uint32>(bytes[offset + i]) << (8 * i);
+            packedSize |= static_cast<uint32>(bytes[offset + sizeof(uint32) + i]) << (8 * i);
+        }
+
+        if (len - offset - kFrameHeaderSize < packedSize) {
+            break;  // Truncated frame: count complete frames only.
+        }
+
+        total += rawSize;
+        offset += kFrameHeaderSize + packedSize;
+    }
+
+    return total;
+}
+
+
+Result<void, Error>
+Lz4Decoder::encode(ImmutableMemoryView const& src) {
+    const auto* bytes = src.dataAddress();
+    const auto len = src.size();
+
+    auto& dest = *getDestBuffer();
+    decltype(src.size()) offset = 0;
+    while (offset < len) {
+        if (len - offset < kFrameHeaderSize) {
+            return Err(corruptFrame());
+        }
+
+        // Frame sizes are little endian on the wire:
+        uint32 rawSize = 0;
+        uint32 packedSize = 0;
+        for (uint32 i = 0; i < sizeof(uint32); ++i) {
+            rawSize |= static_cast<uint32>(bytes[offset + i]) << (8 * i);
+            packedSize |= static_cast<uint32>(bytes[offset + sizeof(uint32) + i]) << (8 * i);
+        }
+        offset += kFrameHeaderSize;
+
+        if (len - offset < packedSize) {
+            return Err(corruptFrame());
+        }
+
+        if (packedSize == rawSize) {
+            // Stored frame - the payload is the data:
+            auto written = dest.write(wrapMemory(bytes + offset, rawSize));
+            if (!written) {
+                return Err(written.moveError());
+            }
+        } else {
+            auto dictLen = static_cast<uint32>(_dictionary.size());
+            auto* dict = _dictionary.dataAddress();
+            if (dictLen > kMaxDistance) {
+                dict += dictLen - kMaxDistance;
+                dictLen = kMaxDistance;
+            }
+
+            _block.resize(rawSize);
+            auto decoded = decompressBlock(bytes + offset, packedSize, _block, dict, dictLen);
+            if (!decoded) {
+                return Err(decoded.moveError());
+            }
+
+            auto written = dest.write(wrapMemory(_block.data(), rawSize));
+            if (!written) {
+                return Err(written.moveError());
+            }
+        }
+
+        offset += packedSize;
+    }
+
+    return Ok();
+}
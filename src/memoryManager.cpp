@@ -23,21 +23,775 @@
  ******************************************************************************/
 #include "solace/memoryManager.hpp"
 #include "solace/exception.hpp"
+#include "solace/telemetry.hpp"
 
 
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
 #include <cstring>  // memcpy
 #include <unistd.h>
 #include <cerrno>
 
+#ifdef SOLACE_PLATFORM_LINUX
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#endif
+
 
 using namespace Solace;
 
 
-MemoryManager::MemoryManager(size_type allowedCapacity) :
+namespace /* anonymous */ {
+
+/** Arena buffers are reclaimed wholesale by MemoryArena::reset, so disposing one is a no-op.
+ * A single stateless instance serves all arenas, which keeps MemoryArena movable.
+ */
+class ArenaMemoryDisposer : public MemoryViewDisposer {
+public:
+    void dispose(ImmutableMemoryView* SOLACE_UNUSED(view)) const override {
+    }
+};
+
+ArenaMemoryDisposer arenaDisposer;
+
+}  // namespace
+
+
+namespace /* anonymous */ {
+
+/** Round an arena allocation up so that the next one starts suitably aligned for any type. */
+constexpr MemoryArena::size_type
+arenaAlignUp(MemoryArena::size_type size) noexcept {
+    constexpr MemoryArena::size_type alignment = alignof(std::max_align_t);
+
+    return (size + alignment - 1) & ~(alignment - 1);
+}
+
+}  // namespace
+
+
+MemoryBuffer MemoryArena::create(size_type dataSize) {
+    const size_type alignedSize = arenaAlignUp(dataSize);
+
+    if (_offset + alignedSize > capacity()) {
+        raise<OverflowException>("dataSize", dataSize, 0, capacity() - _offset);
+    }
+
+    auto* data = _region.view().dataAddress(_offset);
+    _offset += alignedSize;
+
+    return MemoryBuffer(wrapMemory(data, dataSize), &arenaDisposer);
+}
+
+
+void MemoryArena::resize(MemoryBuffer& buffer, size_type newSize) {
+    auto* const data = buffer.view().dataAddress();
+    auto* const regionStart = _region.view().dataAddress();
+    const auto bufferOffset = static_cast<size_type>(data - regionStart);
+
+    if (bufferOffset + arenaAlignUp(buffer.size()) == _offset) {
+        // The most recent allocation: just move the bump pointer.
+        const auto newOffset = bufferOffset + arenaAlignUp(newSize);
+        if (newOffset > capacity()) {
+            raise<OverflowException>("newSize", newSize, 0, capacity() - bufferOffset);
+        }
+
+        _offset = newOffset;
+        buffer.view() = wrapMemory(data, newSize);
+
+        return;
+    }
+
+    // An older allocation: its block cannot move, so allocate afresh and copy.
+    auto replacement = create(newSize);
+    memcpy(replacement.view().dataAddress(), data, (newSize < buffer.size()) ? newSize : buffer.size());
+
+    buffer.swap(replacement);
+}
+
+
+namespace /* anonymous */ {
+
+/** Round a block size up so that every block starts suitably aligned for any type.
+ * A free block stores its freelist link in its first bytes, hence the lower bound.
+ */
+constexpr MemoryPool::size_type
+poolStride(MemoryPool::size_type blockSize) noexcept {
+    constexpr MemoryPool::size_type alignment = alignof(std::max_align_t);
+
+    return (((blockSize < sizeof(uint32)) ? sizeof(uint32) : blockSize) + alignment - 1) & ~(alignment - 1);
+}
+
+constexpr uint32 kFreelistEnd = ~static_cast<uint32>(0);
+
+}  // namespace
+
+
+struct MemoryPool::State {
+
+    class Disposer : public MemoryViewDisposer {
+    public:
+        Disposer(State* self) : _self(self)
+        {}
+
+        void dispose(ImmutableMemoryView* view) const override {
+            _self->release(view->dataAddress());
+        }
+
+    private:
+        State* _self;
+    };
+
+
+    State(MemoryBuffer region, size_type blockSize, uint32 blockCount) :
+        _region(std::move(region)),
+        _blockSize(blockSize),
+        _stride(poolStride(blockSize)),
+        _blockCount(blockCount),
+        _disposer(this)
+    {
+        // Thread all blocks onto the freelist, each free block holding the
+        // index of the next one in its first bytes.
+        for (uint32 i = 0; i < blockCount; ++i) {
+            const uint32 next = (i + 1 < blockCount) ? (i + 1) : kFreelistEnd;
+            memcpy(blockAddress(i), &next, sizeof(next));
+        }
+
+        _head.store((blockCount != 0) ? 0 : kFreelistEnd, std::memory_order_relaxed);
+    }
+
+    byte* blockAddress(uint32 index) noexcept {
+        return _region.view().dataAddress(index * _stride);
+    }
+
+    /** Pop a block off the freelist.
+     * @return Address of the block or nullptr if the pool is exhausted.
+     */
+    byte* acquire() noexcept {
+        // The head carries a generation tag in its upper half so that a stale
+        // index re-appearing at the top of the list cannot be mistaken for an
+        // unchanged one (the classic ABA hazard of a Treiber stack).
+        auto head = _head.load(std::memory_order_acquire);
+        for (;;) {
+            const auto index = static_cast<uint32>(head);
+            if (index == kFreelistEnd) {
+                return nullptr;
+            }
+
+            auto* block = blockAddress(index);
+            uint32 next;
+            memcpy(&next, block, sizeof(next));
+
+            const uint64 newHead = ((head >> 32) + 1) << 32 | next;
+            if (_head.compare_exchange_weak(head, newHead,
+                                            std::memory_order_acq_rel, std::memory_order_acquire)) {
+                _taken.fetch_add(1, std::memory_order_relaxed);
+
+                return block;
+            }
+        }
+    }
+
+    /** Mark each free block in a per-block map by walking the freelist.
+     * Only meaningful while the pool is quiescent. */
+    std::vector<bool> freeMap() {
+        std::vector<bool> isFree(_blockCount, false);
+
+        auto index = static_cast<uint32>(_head.load(std::memory_order_acquire));
+        while (index != kFreelistEnd) {
+            isFree[index] = true;
+
+            uint32 next;
+            memcpy(&next, blockAddress(index), sizeof(next));
+            index = next;
+        }
+
+        return isFree;
+    }
+
+    /** Push a block back onto the freelist. */
+    void release(void const* address) noexcept {
+        auto* block = static_cast<byte*>(const_cast<void*>(address));
+        const auto index = static_cast<uint32>((block - blockAddress(0)) / _stride);
+
+        auto head = _head.load(std::memory_order_acquire);
+        for (;;) {
+            const auto next = static_cast<uint32>(head);
+            memcpy(block, &next, sizeof(next));
+
+            const uint64 newHead = ((head >> 32) + 1) << 32 | index;
+            if (_head.compare_exchange_weak(head, newHead,
+                                            std::memory_order_acq_rel, std::memory_order_acquire)) {
+                _taken.fetch_sub(1, std::memory_order_relaxed);
+
+                return;
+            }
+        }
+    }
+
+
+    MemoryBuffer            _region;
+    size_type               _blockSize;
+    size_type               _stride;
+    uint32                  _blockCount;
+
+    std::atomic<uint64>     _head{0};
+    std::atomic<uint32>     _taken{0};
+
+    Disposer                _disposer;
+};
+
+
+MemoryPool::~MemoryPool() = default;
+
+MemoryPool::MemoryPool(MemoryPool&&) noexcept = default;
+MemoryPool& MemoryPool::operator= (MemoryPool&&) noexcept = default;
+
+
+MemoryPool::MemoryPool(MemoryBuffer region, size_type blockSize, uint32 blockCount) :
+    _state(std::make_unique<State>(std::move(region), blockSize, blockCount))
+{
+}
+
+
+MemoryBuffer MemoryPool::create() {
+    auto* block = _state->acquire();
+    if (block == nullptr) {
+        raise<OverflowException>("blockCount", capacity(), 0, capacity());
+    }
+
+    return MemoryBuffer(wrapMemory(block, _state->_blockSize), &_state->_disposer);
+}
+
+
+void* MemoryPool::acquireBlock() {
+    auto* block = _state->acquire();
+    if (block == nullptr) {
+        raise<OverflowException>("blockCount", capacity(), 0, capacity());
+    }
+
+    return block;
+}
+
+
+void MemoryPool::releaseBlock(void* address) noexcept {
+    _state->release(address);
+}
+
+
+MemoryPool::size_type MemoryPool::blockSize() const noexcept {
+    return _state->_blockSize;
+}
+
+uint32 MemoryPool::capacity() const noexcept {
+    return _state->_blockCount;
+}
+
+uint32 MemoryPool::size() const noexcept {
+    return _state->_taken.load(std::memory_order_relaxed);
+}
+
+
+namespace /* anonymous */ {
+
+/** The whole-page interior of [lo, hi): both bounds rounded inward. */
+struct PageSpan {
+    uintptr_t lo;
+    uintptr_t hi;
+
+    uintptr_t size() const noexcept { return (hi > lo) ? hi - lo : 0; }
+};
+
+PageSpan pageInterior(const void* lo, const void* hi, uintptr_t pageSize) noexcept {
+    return PageSpan {
+        (reinterpret_cast<uintptr_t>(lo) + pageSize - 1) & ~(pageSize - 1),
+        reinterpret_cast<uintptr_t>(hi) & ~(pageSize - 1)
+    };
+}
+
+}  // namespace
+
+
+MemoryPool::FragmentationStats MemoryPool::fragmentation() const {
+    auto& state = *_state;
+    const auto isFree = state.freeMap();
+    const auto pageSize = static_cast<uintptr_t>(getpagesize());
+
+    FragmentationStats stats{0, 0, 0, 0};
+    uint32 runLength = 0;
+    for (uint32 i = 0; i <= state._blockCount; ++i) {
+        if (i < state._blockCount && isFree[i]) {
+            ++runLength;
+            continue;
+        }
+
+        if (runLength != 0) {
+            stats.freeBlocks += runLength;
+            stats.freeSpans += 1;
+            if (runLength > stats.largestFreeSpan) {
+                stats.largestFreeSpan = runLength;
+            }
+
+            const auto span = pageInterior(state.blockAddress(i - runLength),
+                                           state.blockAddress(i - 1) + state._stride, pageSize);
+            stats.reclaimableBytes += static_cast<size_type>(span.size());
+
+            runLength = 0;
+        }
+    }
+
+    return stats;
+}
+
+
+MemoryPool::size_type MemoryPool::shrink() {
+    auto& state = *_state;
+    const auto isFree = state.freeMap();
+    const auto pageSize = static_cast<uintptr_t>(getpagesize());
+
+    // Hand the whole pages of every maximal free run back to the kernel:
+    size_type released = 0;
+    uint32 runLength = 0;
+    for (uint32 i = 0; i <= state._blockCount; ++i) {
+        if (i < state._blockCount && isFree[i]) {
+            ++runLength;
+            continue;
+        }
+
+        if (runLength != 0) {
+            const auto span = pageInterior(state.blockAddress(i - runLength),
+                                           state.blockAddress(i - 1) + state._stride, pageSize);
+#ifdef SOLACE_PLATFORM_LINUX
+            if (span.size() != 0
+                && madvise(reinterpret_cast<void*>(span.lo), span.size(), MADV_DONTNEED) == 0) {
+                released += static_cast<size_type>(span.size());
+            }
+#endif
+            runLength = 0;
+        }
+    }
+
+    // Re-thread the freelist in ascending address order - madvise discarded
+    // the old links along with the rest of the free block contents:
+    uint32 next = kFreelistEnd;
+    for (uint32 i = state._blockCount; i != 0; --i) {
+        const auto index = i - 1;
+        if (!isFree[index]) {
+            continue;
+        }
+
+        memcpy(state.blockAddress(index), &next, sizeof(next));
+        next = index;
+    }
+
+    const auto head = state._head.load(std::memory_order_relaxed);
+    state._head.store(((head >> 32) + 1) << 32 | next, std::memory_order_release);
+
+    return released;
+}
+
+
+struct MemoryPoolCache::State {
+
+    class Disposer : public MemoryViewDisposer {
+    public:
+        Disposer(State* self) : _self(self)
+        {}
+
+        void dispose(ImmutableMemoryView* view) const override {
+            _self->release(view->dataAddress());
+        }
+
+    private:
+        State* _self;
+    };
+
+
+    State(MemoryPool::State* central, uint32 magazineSize) :
+        _central(central),
+        _magazineSize(magazineSize),
+        _disposer(this)
+    {
+        _magazine.reserve(magazineSize);
+    }
+
+    ~State() {
+        flush(static_cast<uint32>(_magazine.size()));
+    }
+
+    /** Pop a block off the magazine, refilling it from the central pool when dry.
+     * @return Address of a block or nullptr if the pool itself is exhausted.
+     */
+    byte* acquire() {
+        if (_magazine.empty()) {
+            // Refill half a magazine in one go: one burst of freelist traffic
+            // amortized over the next magazineSize/2 local allocations.
+            const uint32 batch = (_magazineSize / 2 != 0) ? _magazineSize / 2 : 1;
+            for (uint32 i = 0; i < batch; ++i) {
+                auto* block = _central->acquire();
+                if (block == nullptr) {
+                    break;
+                }
+
+                _magazine.push_back(block);
+            }
+
+            if (_magazine.empty()) {
+                return nullptr;
+            }
+        }
+
+        auto* block = _magazine.back();
+        _magazine.pop_back();
+
+        return block;
+    }
+
+    /** Return a block to the magazine, flushing a batch to the central pool when full. */
+    void release(void const* address) {
+        if (_magazine.size() >= _magazineSize) {
+            flush((_magazineSize / 2 != 0) ? _magazineSize / 2 : 1);
+        }
+
+        _magazine.push_back(static_cast<byte*>(const_cast<void*>(address)));
+    }
+
+    /** Push count blocks from the magazine back onto the central freelist. */
+    void flush(uint32 count) {
+        for (; count != 0 && !_magazine.empty(); --count) {
+            _central->release(_magazine.back());
+            _magazine.pop_back();
+        }
+    }
+
+
+    MemoryPool::State*  _central;
+    uint32              _magazineSize;
+    std::vector<byte*>  _magazine;
+
+    Disposer            _disposer;
+};
+
+
+MemoryPoolCache::~MemoryPoolCache() = default;
+
+MemoryPoolCache::MemoryPoolCache(MemoryPoolCache&&) noexcept = default;
+MemoryPoolCache& MemoryPoolCache::operator= (MemoryPoolCache&&) noexcept = default;
+
+
+MemoryPoolCache::MemoryPoolCache(MemoryPool& pool, uint32 magazineSize) :
+    _state(std::make_unique<State>(pool._state.get(), magazineSize))
+{
+}
+
+
+MemoryBuffer MemoryPoolCache::create() {
+    auto* block = _state->acquire();
+    if (block == nullptr) {
+        raise<OverflowException>("blockCount", _state->_central->_blockCount, 0, _state->_central->_blockCount);
+    }
+
+    return MemoryBuffer(wrapMemory(block, _state->_central->_blockSize), &_state->_disposer);
+}
+
+
+uint32 MemoryPoolCache::cached() const noexcept {
+    return static_cast<uint32>(_state->_magazine.size());
+}
+
+
+MemoryPool MemoryManager::createPool(size_type blockSize, uint32 blockCount) {
+    return MemoryPool(create(poolStride(blockSize) * blockCount), blockSize, blockCount);
+}
+
+
+MemoryPool MemoryManager::createPagedPool(size_type blockSize, uint32 blockCount) {
+    const auto pageSize = getPageSize();
+    const auto pagedSize = (blockSize + pageSize - 1) & ~(pageSize - 1);
+
+    // A page-aligned region of page-multiple blocks: no page straddles two
+    // blocks, so shrink() can release free blocks in their entirety.
+    return MemoryPool(createAligned(pagedSize * blockCount, pageSize), pagedSize, blockCount);
+}
+
+
+
+
+namespace /* anonymous */ {
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+constexpr MemoryManager::size_type kHugePageSize = 2 * 1024 * 1024;
+
+/** Map an anonymous region backed by huge pages, with an optional NUMA placement hint.
+ * Pre-reserved huge pages are used when available; otherwise the region falls
+ * back to plain pages advised to be merged by transparent huge pages.
+ */
+byte* mapHugeRegion(size_t mappedSize, int32 numaNode, bool prefault) {
+    // MAP_POPULATE makes the kernel fault the whole region in before mmap
+    // returns, so the warmup cost is paid here and not one page at a time
+    // under traffic.
+    const int populate = prefault ? MAP_POPULATE : 0;
+
+    auto* addr = mmap(nullptr, mappedSize,
+                      PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | populate, -1, 0);
+
+    if (addr == MAP_FAILED) {
+        addr = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE,
+                    MAP_PRIVATE | MAP_ANONYMOUS | populate, -1, 0);
+        if (addr == MAP_FAILED) {
+            raise<IOException>(errno, "mmap");
+        }
+
+#ifdef MADV_HUGEPAGE
+        madvise(addr, mappedSize, MADV_HUGEPAGE);
+#endif
+    }
+
+#ifdef SYS_mbind
+    if (numaNode >= 0) {
+        // Best effort only: a hint the kernel is free to ignore.
+        const unsigned long nodemask = 1UL << numaNode;
+        syscall(SYS_mbind, addr, mappedSize,
+                2 /* MPOL_BIND */, &nodemask, sizeof(nodemask) * 8, 0);
+    }
+#endif
+
+    return static_cast<byte*>(addr);
+}
+
+#endif  // SOLACE_PLATFORM_LINUX
+
+
+/** Touch one byte per page of a fresh heap allocation, faulting its backing
+ * in before the buffer is handed out. Regions past the threshold are touched
+ * from several threads: faults on disjoint ranges are served concurrently,
+ * which cuts warmup of a multi-GB reservation to a fraction of a serial pass.
+ */
+void pretouchRegion(byte* data, size_t regionSize, size_t pageSize) {
+    constexpr size_t kParallelTouchThreshold = 64 * 1024 * 1024;
+
+    if (regionSize < kParallelTouchThreshold) {
+        for (size_t offset = 0; offset < regionSize; offset += pageSize) {
+            data[offset] = 0;
+        }
+
+        return;
+    }
+
+    const auto hardwareThreads = std::thread::hardware_concurrency();
+    const size_t nbWorkers = (hardwareThreads > 1)
+            ? ((hardwareThreads < 4) ? hardwareThreads : 4)
+            : 1;
+
+    const auto nbPages = (regionSize + pageSize - 1) / pageSize;
+    const auto pagesPerWorker = (nbPages + nbWorkers - 1) / nbWorkers;
+
+    std::vector<std::thread> workers;
+    workers.reserve(nbWorkers);
+    for (size_t i = 0; i < nbWorkers; ++i) {
+        const auto from = i * pagesPerWorker;
+        const auto to = ((from + pagesPerWorker) < nbPages) ? (from + pagesPerWorker) : nbPages;
+        if (from >= to) {
+            break;
+        }
+
+        workers.emplace_back([data, pageSize, from, to]() {
+            for (auto page = from; page < to; ++page) {
+                data[page * pageSize] = 0;
+            }
+        });
+    }
+
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+
+/** Pin a region in physical memory. Best effort only: RLIMIT_MEMLOCK commonly
+ * denies this to unprivileged processes and the allocation proceeds unpinned.
+ */
+void lockRegion(void* addr, size_t regionSize) noexcept {
+#ifdef SOLACE_PLATFORM_LINUX
+    mlock(addr, regionSize);
+#else
+    static_cast<void>(addr);
+    static_cast<void>(regionSize);
+#endif
+}
+
+
+/** Undo lockRegion() when a pinned buffer is disposed of, so the pages the
+ * allocator reuses are not still charged against the memlock limit.
+ */
+void unlockRegion(void const* addr, size_t regionSize) noexcept {
+#ifdef SOLACE_PLATFORM_LINUX
+    munlock(addr, regionSize);
+#else
+    static_cast<void>(addr);
+    static_cast<void>(regionSize);
+#endif
+}
+
+}  // namespace
+
+
+namespace /* anonymous */ {
+
+/**
+ * Per-thread accounting counters. Each thread owns one block and bumps it
+ * with relaxed atomics - no other thread ever writes it, so the stores cost
+ * a plain cache hit. Blocks are chained into a global list the snapshot
+ * walks; blocks of finished threads stay on the list because buffers they
+ * allocated may still be outstanding.
+ */
+struct AccountingCounters {
+    std::atomic<uint64> histogram[MemoryManager::kNbSizeBuckets] {};
+    std::atomic<uint64> totalAllocations {0};
+
+    std::atomic<int64>  tagBytes[MemoryManager::kMaxTags] {};
+    std::atomic<int64>  tagBlocks[MemoryManager::kMaxTags] {};
+    std::atomic<uint64> tagAllocations[MemoryManager::kMaxTags] {};
+
+    AccountingCounters* next {nullptr};
+};
+
+std::atomic<AccountingCounters*> gCountersHead {nullptr};
+
+AccountingCounters& countersOfThisThread() {
+    static thread_local AccountingCounters* mine = nullptr;
+    if (!mine) {
+        mine = new AccountingCounters();
+        mine->next = gCountersHead.load(std::memory_order_relaxed);
+        while (!gCountersHead.compare_exchange_weak(mine->next, mine,
+                                                    std::memory_order_release,
+                                                    std::memory_order_relaxed)) {
+        }
+    }
+
+    return *mine;
+}
+
+uint32 sizeBucketOf(MemoryManager::size_type size) noexcept {
+    if (size == 0) {
+        return 0;
+    }
+
+    const auto log2 = 63 - static_cast<uint32>(__builtin_clzll(size));
+    const auto bucket = log2 + (((size & (size - 1)) != 0) ? 1 : 0);
+
+    return (bucket < MemoryManager::kNbSizeBuckets) ? bucket : MemoryManager::kNbSizeBuckets - 1;
+}
+
+/** The process-wide tag name registry. Registration is rare and locked;
+ * reading an already-registered name is not. */
+struct TagRegistry {
+    std::mutex          guard;
+    std::atomic<uint32> count {0};
+    const char*         names[MemoryManager::kMaxTags];
+};
+
+TagRegistry& tagRegistry() {
+    static TagRegistry registry;
+
+    return registry;
+}
+
+}  // namespace
+
+
+MemoryManager::TagId MemoryManager::registerTag(const char* name) {
+    auto& registry = tagRegistry();
+    std::lock_guard<std::mutex> lock(registry.guard);
+
+    const auto nbTags = registry.count.load(std::memory_order_relaxed);
+    for (uint32 i = 0; i < nbTags; ++i) {
+        if (strcmp(registry.names[i], name) == 0) {
+            return i;
+        }
+    }
+
+    if (nbTags >= kMaxTags) {
+        raise<OverflowException>("tag", nbTags, 0, uint32{kMaxTags});
+    }
+
+    registry.names[nbTags] = name;
+    registry.count.store(nbTags + 1, std::memory_order_release);
+
+    return nbTags;
+}
+
+
+MemoryBuffer MemoryManager::create(size_type dataSize, TagId tag) {
+    return createImpl(dataSize, _options.trackAllocations ? tag : kMaxTags);
+}
+
+
+MemoryManager::AccountingSnapshot MemoryManager::accounting() const {
+    AccountingSnapshot snapshot {};
+    snapshot.currentSize = _size;
+    snapshot.peakSize = _peakSize;
+
+    auto& registry = tagRegistry();
+    snapshot.nbTags = registry.count.load(std::memory_order_acquire);
+    for (uint32 i = 0; i < snapshot.nbTags; ++i) {
+        snapshot.tags[i].name = registry.names[i];
+    }
+
+    for (auto* block = gCountersHead.load(std::memory_order_acquire); block; block = block->next) {
+        snapshot.totalAllocations += block->totalAllocations.load(std::memory_order_relaxed);
+        for (uint32 b = 0; b < kNbSizeBuckets; ++b) {
+            snapshot.sizeHistogram[b] += block->histogram[b].load(std::memory_order_relaxed);
+        }
+
+        for (uint32 i = 0; i < snapshot.nbTags; ++i) {
+            snapshot.tags[i].outstandingBytes += block->tagBytes[i].load(std::memory_order_relaxed);
+            snapshot.tags[i].outstandingBlocks += block->tagBlocks[i].load(std::memory_order_relaxed);
+            snapshot.tags[i].totalAllocations += block->tagAllocations[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    return snapshot;
+}
+
+
+void
+MemoryManager::AccountedMemoryDisposer::dispose(ImmutableMemoryView* view) const {
+    _self->freeAccounted(view, _tag);
+}
+
+
+void MemoryManager::freeAccounted(ImmutableMemoryView* view, TagId tag) {
+    const auto size = view->size();
+
+    auto& counters = countersOfThisThread();
+    counters.tagBytes[tag].fetch_sub(static_cast<int64>(size), std::memory_order_relaxed);
+    counters.tagBlocks[tag].fetch_sub(1, std::memory_order_relaxed);
+
+    // Tagged buffers come off the same path untagged ones do:
+#ifdef SOLACE_PLATFORM_LINUX
+    if (_options.useHugePages) {
+        freeMapped(view);
+
+        return;
+    }
+#endif
+    free(view);
+}
+
+
+MemoryManager::MemoryManager(size_type allowedCapacity, Options options) :
     _capacity(allowedCapacity),
     _size(0),
     _isLocked(false),
-    _disposer(this)
+    _options(options),
+    _disposer(this),
+    _mappedDisposer(this),
+    _alignedDisposer(this)
 {
 
     const auto totalAvaliableMemory = getPageSize() * getNbPages();
@@ -52,7 +806,9 @@ MemoryManager& MemoryManager::swap(MemoryManager& rhs) noexcept {
 
     swap(_capacity, rhs._capacity);
     swap(_size, rhs._size);
+    swap(_peakSize, rhs._peakSize);
     swap(_isLocked, rhs._isLocked);
+    swap(_options, rhs._options);
 
     return (*this);
 }
@@ -114,16 +870,120 @@ MemoryManager::HeapMemoryDisposer::dispose(ImmutableMemoryView* view) const {
 }
 
 
+void
+MemoryManager::MappedMemoryDisposer::dispose(ImmutableMemoryView* view) const {
+    _self->freeMapped(view);
+}
+
+
+void
+MemoryManager::AlignedMemoryDisposer::dispose(ImmutableMemoryView* view) const {
+    _self->freeAligned(view);
+}
+
+
+void MemoryManager::freeMapped(ImmutableMemoryView* view) {
+#ifdef SOLACE_PLATFORM_LINUX
+    const auto size = view->size();
+    munmap(const_cast<value_type*>(view->dataAddress()), size);
+
+    _size -= size;
+    SOLACE_TELEMETRY_RECORD(Telemetry::Probe::MemoryManagerFreeBytes, size);
+#else
+    free(view);
+#endif
+}
+
+
 void MemoryManager::free(ImmutableMemoryView* view) {
     const auto size = view->size();
+    if (_options.lockMemory) {
+        unlockRegion(view->dataAddress(), size);
+    }
     delete [] view->dataAddress();
 
     _size -= size;
+    SOLACE_TELEMETRY_RECORD(Telemetry::Probe::MemoryManagerFreeBytes, size);
+}
+
+
+void MemoryManager::freeAligned(ImmutableMemoryView* view) {
+    const auto size = view->size();
+    if (_options.lockMemory) {
+        unlockRegion(view->dataAddress(), size);
+    }
+    ::free(const_cast<value_type*>(view->dataAddress()));
+
+    _size -= size;
+    SOLACE_TELEMETRY_RECORD(Telemetry::Probe::MemoryManagerFreeBytes, size);
+}
+
+
+MemoryBuffer MemoryManager::createAligned(size_type dataSize, size_type alignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0 || (alignment % sizeof(void*)) != 0) {
+        raise<IllegalArgumentException>("alignment");
+    }
+
+#ifdef SOLACE_PLATFORM_LINUX
+    // Huge page regions are already aligned to the huge page boundary:
+    if (_options.useHugePages && alignment <= kHugePageSize) {
+        return create(dataSize);
+    }
+#endif
+
+    // Direct I/O requires the transfer size aligned too - round the segment up:
+    const auto allocSize = (dataSize + alignment - 1) & ~(alignment - 1);
+
+    if (size() + allocSize > capacity()) {
+        raise<OverflowException>("dataSize", dataSize, 0, capacity() - size());
+    }
+
+    if (isLocked()) {
+        raise<Exception>("Cannot allocate memory block: allocator is locked.");
+    }
+
+    void* data = nullptr;
+    const auto result = posix_memalign(&data, alignment, allocSize);
+    if (result != 0) {
+        raise<IOException>(result, "posix_memalign");
+    }
+
+    if (_options.prefault) {
+        pretouchRegion(static_cast<value_type*>(data), allocSize, getPageSize());
+    }
+    if (_options.lockMemory) {
+        lockRegion(data, allocSize);
+    }
+
+    _size += allocSize;
+    noteSizeGrown();
+
+    return MemoryBuffer(wrapMemory(static_cast<value_type*>(data), allocSize), &_alignedDisposer);
 }
 
 
 MemoryBuffer MemoryManager::create(size_type dataSize) {
-    if (size() + dataSize > capacity()) {
+    return createImpl(dataSize, kMaxTags);
+}
+
+
+/** The shared allocation path. A tag of kMaxTags means untagged. */
+MemoryBuffer MemoryManager::createImpl(size_type dataSize, uint32 tag) {
+    SOLACE_TELEMETRY_SCOPED_CYCLES(Telemetry::Probe::MemoryManagerAllocCycles);
+    SOLACE_TELEMETRY_RECORD(Telemetry::Probe::MemoryManagerAllocBytes, dataSize);
+
+#ifdef SOLACE_PLATFORM_LINUX
+    // In huge page mode allocations are rounded up to whole pages and the
+    // caller gets the full mapping; the rounded size is what counts against
+    // capacity and what is unmapped on disposal.
+    const auto allocSize = _options.useHugePages
+            ? (dataSize + kHugePageSize - 1) & ~(kHugePageSize - 1)
+            : dataSize;
+#else
+    const auto allocSize = dataSize;
+#endif
+
+    if (size() + allocSize > capacity()) {
         raise<OverflowException>("dataSize", dataSize, 0, capacity() - size());
     }
 
@@ -131,11 +991,103 @@ MemoryBuffer MemoryManager::create(size_type dataSize) {
         raise<Exception>("Cannot allocate memory block: allocator is locked.");
     }
 
-    auto data = new MemoryView::value_type[dataSize];
+    if (_options.trackAllocations) {
+        auto& counters = countersOfThisThread();
+        counters.totalAllocations.fetch_add(1, std::memory_order_relaxed);
+        counters.histogram[sizeBucketOf(dataSize)].fetch_add(1, std::memory_order_relaxed);
+
+        if (tag < kMaxTags) {
+            // The ledger carries what disposal will give back - the full
+            // allocated size, which in huge page mode exceeds the request:
+            counters.tagBytes[tag].fetch_add(static_cast<int64>(allocSize), std::memory_order_relaxed);
+            counters.tagBlocks[tag].fetch_add(1, std::memory_order_relaxed);
+            counters.tagAllocations[tag].fetch_add(1, std::memory_order_relaxed);
+            _tagDisposers[tag].init(this, tag);
+        }
+    }
+
+    auto* disposer = (tag < kMaxTags)
+            ? static_cast<MemoryViewDisposer*>(&_tagDisposers[tag])
+            : nullptr;
+
+#ifdef SOLACE_PLATFORM_LINUX
+    if (_options.useHugePages) {
+        auto* data = mapHugeRegion(allocSize, _options.numaNode, _options.prefault);
+        if (_options.lockMemory) {
+            lockRegion(data, allocSize);
+        }
+
+        _size += allocSize;
+        noteSizeGrown();
+
+        return MemoryBuffer(wrapMemory(data, allocSize),
+                            disposer ? disposer : &_mappedDisposer);
+    }
+#endif
+
+    auto data = new MemoryView::value_type[allocSize];
+
+    if (_options.prefault) {
+        pretouchRegion(data, allocSize, getPageSize());
+    }
+    if (_options.lockMemory) {
+        lockRegion(data, allocSize);
+    }
+
+    _size += allocSize;
+    noteSizeGrown();
+
+    return MemoryBuffer(wrapMemory(data, allocSize),
+                        disposer ? disposer : &_disposer);
+}
+
+
+void MemoryManager::resize(MemoryBuffer& buffer, size_type newSize) {
+#ifdef SOLACE_PLATFORM_LINUX
+#ifdef MREMAP_MAYMOVE
+    if (_options.useHugePages) {
+        const auto oldMapped = buffer.size();
+        const auto newMapped = (newSize + kHugePageSize - 1) & ~(kHugePageSize - 1);
+        if (newMapped == oldMapped) {
+            return;
+        }
+
+        if (newMapped > oldMapped && size() + (newMapped - oldMapped) > capacity()) {
+            raise<OverflowException>("newSize", newSize, 0, capacity() - size() + oldMapped);
+        }
+
+        // mremap grows the mapping without touching a single byte of data,
+        // relocating page table entries instead if the region has to move.
+        auto* addr = mremap(buffer.view().dataAddress(), oldMapped, newMapped, MREMAP_MAYMOVE);
+        if (addr == MAP_FAILED) {
+            raise<IOException>(errno, "mremap");
+        }
+
+        // The grown tail is fresh pages mremap does not populate:
+        if (newMapped > oldMapped && _options.prefault) {
+            pretouchRegion(static_cast<value_type*>(addr) + oldMapped,
+                           newMapped - oldMapped, kHugePageSize);
+        }
+        if (_options.lockMemory) {
+            lockRegion(addr, newMapped);
+        }
+
+        _size += newMapped;
+        _size -= oldMapped;
+        noteSizeGrown();
+        buffer.view() = wrapMemory(addr, newMapped);
+
+        return;
+    }
+#endif  // MREMAP_MAYMOVE
+#endif  // SOLACE_PLATFORM_LINUX
 
-    _size += dataSize;
+    // Heap segments cannot grow in place: allocate a new one and copy over.
+    auto replacement = create(newSize);
+    memcpy(replacement.view().dataAddress(), buffer.view().dataAddress(),
+           (newSize < buffer.size()) ? newSize : buffer.size());
 
-    return MemoryBuffer(wrapMemory(data, dataSize), &_disposer);
+    buffer.swap(replacement);
 }
 
 
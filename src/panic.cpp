@@ -0,0 +1,94 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		panic.cpp
+ *	@author		$LastChangedBy: soultaker $
+ *	@date		$LastChangedDate$
+ *	@brief		Implementation of the allocation-free panic path
+ *	ID:			$Id$
+ ******************************************************************************/
+#include "solace/panic.hpp"
+
+#include <cstdlib>      // abort
+
+#include <unistd.h>     // write
+
+
+using namespace Solace;
+
+
+PanicReason const Solace::panics::InvalidState     = {"InvalidState",    "Object is in an invalid state"};
+PanicReason const Solace::panics::NullPointer      = {"NullPointer",     "Null pointer value passed"};
+PanicReason const Solace::panics::IndexOutOfRange  = {"IndexOutOfRange", "Index is out of range"};
+PanicReason const Solace::panics::OutOfMemory      = {"OutOfMemory",     "Memory allocation failed"};
+PanicReason const Solace::panics::Overflow         = {"Overflow",        "Value overflows its destination"};
+
+
+namespace /* anonymous */ {
+
+/**
+ * The report buffer is reserved up front: a panic fired from an
+ * out-of-memory handler must not touch the heap. Unsynchronized on
+ * purpose - the first panic aborts the process, a concurrent second
+ * one can at worst garble a message that ends in abort() anyway.
+ */
+char reportBuffer[512];
+
+size_t appendTo(size_t offset, const char* text) noexcept {
+    if (!text) {
+        return offset;
+    }
+
+    while (*text && offset < sizeof(reportBuffer) - 1) {
+        reportBuffer[offset++] = *text++;
+    }
+
+    return offset;
+}
+
+[[noreturn]]
+void reportAndAbort(PanicReason const& reason, const char* detail) noexcept {
+    size_t offset = appendTo(0, "panic: ");
+    offset = appendTo(offset, reason.category);
+    offset = appendTo(offset, ": ");
+    offset = appendTo(offset, reason.message);
+
+    if (detail) {
+        offset = appendTo(offset, ": ");
+        offset = appendTo(offset, detail);
+    }
+
+    reportBuffer[offset++] = '\n';
+
+    // A short write leaves a truncated report - nothing useful to do about it here.
+    const auto written = write(STDERR_FILENO, reportBuffer, offset);
+    static_cast<void>(written);
+
+    abort();
+}
+
+}  // namespace
+
+
+void Solace::panic(PanicReason const& reason) noexcept {
+    reportAndAbort(reason, nullptr);
+}
+
+
+void Solace::panic(PanicReason const& reason, const char* detail) noexcept {
+    reportAndAbort(reason, detail);
+}
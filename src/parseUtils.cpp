@@ -26,6 +26,7 @@
 #include <sstream>      // std::stringstream, std::stringbuf
 
 #include <type_traits>  // std::is_signed
+#include <limits>       // std::numeric_limits
 #include <climits>
 
 
@@ -43,6 +44,92 @@ auto conversionError(const char* fmt, StringView value) {
 }
 
 
+namespace /* anonymous */ {
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+
+/** Check that all 8 bytes of the chunk are ASCII decimal digits. */
+constexpr bool isAllDigits8(uint64 chunk) noexcept {
+    return ((chunk & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL) &&
+           (((chunk + 0x0606060606060606ULL) & 0xF0F0F0F0F0F0F0F0ULL) == 0x3030303030303030ULL);
+}
+
+/** Convert 8 ASCII digits packed in a little-endian chunk into their numeric value.
+ * Pairs of digits are combined in three multiply-shift steps working on all
+ * lanes at once.
+ */
+inline uint32 parseEightDigits(uint64 chunk) noexcept {
+    chunk = (chunk & 0x0F0F0F0F0F0F0F0FULL) * 2561 >> 8;
+    chunk = (chunk & 0x00FF00FF00FF00FFULL) * 6553601 >> 16;
+
+    return static_cast<uint32>((chunk & 0x0000FFFF0000FFFFULL) * 42949672960001ULL >> 32);
+}
+
+#endif  // little endian
+
+/** SWAR fast path for plain decimal integers of up to 19 digits.
+ * Everything else - hex/octal prefixes, whitespace, overlong input - is left
+ * to the strtoll based slow path which preserves its semantics exactly.
+ *
+ * @return True if the value was a plain decimal integer and has been parsed.
+ */
+bool fastParseDecimal(StringView value, uint64& magnitude, bool& negative) noexcept {
+    auto* data = value.data();
+    auto size = value.size();
+
+    negative = false;
+    if (size == 0) {
+        return false;
+    }
+
+    if (*data == '-' || *data == '+') {
+        negative = (*data == '-');
+        ++data;
+        --size;
+    }
+
+    // 19 decimal digits always fit an uint64; longer input needs range diagnostics.
+    if (size == 0 || size > 19) {
+        return false;
+    }
+
+    // A leading zero may be an octal/hex prefix under base-0 slow path semantics.
+    if (size > 1 && *data == '0') {
+        return false;
+    }
+
+    uint64 result = 0;
+
+#if defined(__BYTE_ORDER__) && (__BYTE_ORDER__ == __ORDER_LITTLE_ENDIAN__)
+    while (size >= 8) {
+        uint64 chunk;
+        memcpy(&chunk, data, sizeof(chunk));
+        if (!isAllDigits8(chunk)) {
+            return false;
+        }
+
+        result = result * 100000000 + parseEightDigits(chunk);
+        data += 8;
+        size -= 8;
+    }
+#endif
+
+    for (; size != 0; --size, ++data) {
+        if (*data < '0' || *data > '9') {
+            return false;
+        }
+
+        result = result * 10 + static_cast<uint64>(*data - '0');
+    }
+
+    magnitude = result;
+
+    return true;
+}
+
+}  // namespace
+
+
 template<typename T, bool isSigned = std::is_signed<T>::value>
 struct Longest {
 };
@@ -53,6 +140,24 @@ struct Longest<T, true> {
     using type = int64;  // long long;
 
     static Result<type, Error> parse(StringView value) {
+        uint64 magnitude;
+        bool negative;
+        if (fastParseDecimal(value, magnitude, negative)) {
+            if (negative) {
+                const auto bound = static_cast<uint64>(std::numeric_limits<T>::max()) + 1;
+                if (magnitude > bound)
+                    return conversionError("Value is outside of bounds: ", value);
+
+                // Two's complement negation handles the most negative value safely.
+                return Ok(static_cast<type>(~magnitude + 1));
+            }
+
+            if (magnitude > static_cast<uint64>(std::numeric_limits<T>::max()))
+                return conversionError("Value is outside of bounds: ", value);
+
+            return Ok(static_cast<type>(magnitude));
+        }
+
         errno = 0;
         char* pEnd = nullptr;
         // FIXME(abbyssoul): The use of value.data() here is not safe for substrings.
@@ -80,6 +185,15 @@ struct Longest<T, false> {
     using type = uint64;  // unsigned long long;
 
     static Result<type, Error> parse(StringView value) {
+        uint64 magnitude;
+        bool negative;
+        if (fastParseDecimal(value, magnitude, negative) && !negative) {
+            if (magnitude > static_cast<uint64>(std::numeric_limits<T>::max()))
+                return conversionError("Value is outside of bounds: ", value);
+
+            return Ok(static_cast<type>(magnitude));
+        }
+
         errno = 0;
         char* pEnd = nullptr;
         // FIXME(abbyssoul): The use of value.data() here is not safe for substrings.
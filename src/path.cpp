@@ -21,6 +21,9 @@
 ******************************************************************************/
 #include "solace/path.hpp"
 #include "solace/exception.hpp"
+#include "solace/writeBuffer.hpp"
+
+#include <memory>   // std::make_unique
 
 
 using namespace Solace;
@@ -37,7 +40,7 @@ const Path Path::Root(StringView{""});
 
 
 template<typename T>
-void joinComponents(std::vector<String>& base, std::initializer_list<T> paths) {
+void joinComponents(Array<String>::Storage& base, std::initializer_list<T> paths) {
     for (auto& component : paths) {
         base.emplace_back(std::move(component));
     }
@@ -45,8 +48,8 @@ void joinComponents(std::vector<String>& base, std::initializer_list<T> paths) {
 
 
 template<typename T>
-std::vector<String> joinComponents(std::initializer_list<T> paths) {
-    std::vector<String> components;
+Array<String>::Storage joinComponents(std::initializer_list<T> paths) {
+    Array<String>::Storage components;
     components.reserve(paths.size());
 
     joinComponents(components, paths);
@@ -56,14 +59,14 @@ std::vector<String> joinComponents(std::initializer_list<T> paths) {
 
 
 template<>
-std::vector<String> joinComponents(std::initializer_list<Path> paths) {
+Array<String>::Storage joinComponents(std::initializer_list<Path> paths) {
     size_t numberOfComponents = 0;
     // Count number of components
     for (const auto& p : paths) {
         numberOfComponents += p.getComponentsCount();
     }
 
-    std::vector<String> components;
+    Array<String>::Storage components;
     components.reserve(numberOfComponents);
 
     for (auto& path : paths) {
@@ -96,7 +99,7 @@ Path::join(Path const& base, std::initializer_list<Path> paths) {
     }
 
     // Now we can pr-eallocate storage for components
-    std::vector<String> components;
+    Array<String>::Storage components;
     components.reserve(numberOfComponents);
 
     for (auto& path : paths) {
@@ -111,7 +114,7 @@ Path::join(Path const& base, std::initializer_list<Path> paths) {
 
 Path
 Path::join(Path const& base, std::initializer_list<String> paths) {
-    std::vector<String> components;
+    Array<String>::Storage components;
     components.reserve(base.getComponentsCount() + paths.size());
 
     for (auto& component : base) {
@@ -126,7 +129,7 @@ Path::join(Path const& base, std::initializer_list<String> paths) {
 
 Path
 Path::join(Path const& base, std::initializer_list<StringView> paths) {
-    std::vector<String> components;
+    Array<String>::Storage components;
     components.reserve(base.getComponentsCount() + paths.size());
 
     for (auto& component : base) {
@@ -142,7 +145,7 @@ Path::join(Path const& base, std::initializer_list<StringView> paths) {
 
 Path
 Path::join(Path const& base, std::initializer_list<const char*> paths) {
-    std::vector<String> components;
+    Array<String>::Storage components;
     components.reserve(base.getComponentsCount() + paths.size());
 
     for (auto& component : base) {
@@ -160,7 +163,7 @@ Path::parse(StringView str, StringView delim) {
     auto components = str.split(delim);
     const auto nbOfComponents = components.size();
 
-    std::vector<String> nonEmptyComponents;
+    Array<String>::Storage nonEmptyComponents;
     nonEmptyComponents.reserve(nbOfComponents);
 
     for (decltype(components)::size_type i = 0; i < components.size(); ++i) {
@@ -315,7 +318,7 @@ bool Path::contains(const Path& path) const {
 
 Path Path::normalize() const {
     // FIXME(abbyssoul): Dynamic memory re-allocation!!!
-    std::vector<String> components;
+    Array<String>::Storage components;
 
     for (const auto& c : _components) {
         if (c.equals(SelfRef)) {
@@ -345,6 +348,25 @@ Path Path::getParent() const {
     return Path(std::move(basePath));
 }
 
+StringView
+Path::getParentView() const {
+    const auto nbComponents = _components.size();
+    if (nbComponents < 2) {
+        return rendered().pathString.view();
+    }
+
+    auto const& render = rendered();
+    const auto lastOffset = render.componentOffsets[nbComponents - 1];
+
+    // The parent of a first-level absolute path is the root itself:
+    if (isAbsolute() && lastOffset <= Delimiter.size()) {
+        return Delimiter;
+    }
+
+    return render.pathString.view().substring(0, lastOffset - Delimiter.size());
+}
+
+
 StringView
 Path::getBasename() const {
     return (isAbsolute() && _components.size() == 1)
@@ -384,7 +406,7 @@ Path Path::subpath(size_type beginIndex, size_type endIndex) const {
 }
 
 Path Path::join(const Path& rhs) const {
-    std::vector<String> components;
+    Array<String>::Storage components;
     components.reserve(getComponentsCount() + rhs.getComponentsCount());
 
     for (const auto& c : _components) {
@@ -398,7 +420,7 @@ Path Path::join(const Path& rhs) const {
 }
 
 Path Path::join(StringView rhs) const {
-    std::vector<String> components;
+    Array<String>::Storage components;
     components.reserve(getComponentsCount() + 1);
 
     for (const auto& c : _components) {
@@ -436,7 +458,90 @@ const String& Path::last() const {
 
 String
 Path::toString(const StringView& delim) const {
-    return (isAbsolute() && _components.size() == 1)
-            ? delim
-            : String::join(delim, _components);
+    // Only the default-delimiter form is memoized; custom delimiters are rare.
+    if (!delim.equals(Delimiter)) {
+        return (isAbsolute() && _components.size() == 1)
+                ? String{delim}
+                : String::join(delim, _components);
+    }
+
+    return rendered().pathString;
+}
+
+
+Result<void, Error>
+Path::toString(WriteBuffer& dest, StringView delim) const {
+    const auto totalSize = length(delim);
+    if (totalSize > dest.viewRemaining().size()) {
+        return Err(Error("OverflowError: toString(): destination buffer is too small"));
+    }
+
+    // Capacity is checked - none of the writes below can fail:
+    const auto nbComponents = _components.size();
+    if (isAbsolute() && nbComponents == 1) {
+        dest.write(wrapMemory(delim.data(), delim.size()));
+
+        return Ok();
+    }
+
+    for (size_type i = 0; i < nbComponents; ++i) {
+        const auto component = _components[i].view();
+        dest.write(wrapMemory(component.data(), component.size()));
+        if (i + 1 < nbComponents) {
+            dest.write(wrapMemory(delim.data(), delim.size()));
+        }
+    }
+
+    return Ok();
+}
+
+
+Path::RenderCache const&
+Path::rendered() const {
+    auto* cache = _render.load(std::memory_order_acquire);
+    if (cache) {
+        return *cache;
+    }
+
+    // Build the rendering aside and install it with a compare-exchange:
+    // concurrent first calls may both render, but exactly one result is
+    // published and the loser's duplicate is discarded, so a reader never
+    // observes a half-written cache.
+    auto fresh = std::make_unique<RenderCache>();
+
+    const auto nbComponents = _components.size();
+    if (nbComponents != 0) {
+        fresh->pathString = (isAbsolute() && nbComponents == 1)
+                ? String{Delimiter}
+                : String::join(Delimiter, _components);
+
+        Array<uint32> offsets(nbComponents);
+        uint32 position = 0;
+        for (size_type i = 0; i < nbComponents; ++i) {
+            offsets[i] = position;
+            position += _components[i].size() + Delimiter.size();
+        }
+
+        fresh->componentOffsets = std::move(offsets);
+    }
+
+    RenderCache* expected = nullptr;
+    if (_render.compare_exchange_strong(expected, fresh.get(),
+                                        std::memory_order_acq_rel,
+                                        std::memory_order_acquire)) {
+        return *fresh.release();
+    }
+
+    return *expected;
+}
+
+
+uint64 Path::hashCode() const {
+    auto hash = _cachedHash.load(std::memory_order_relaxed);
+    if (hash == 0) {
+        hash = toString().hashCode();
+        _cachedHash.store(hash, std::memory_order_relaxed);
+    }
+
+    return hash;
 }
@@ -0,0 +1,127 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		solace/pathBuilder.cpp
+ *	@brief		Implementation of the PathBuilder
+ ******************************************************************************/
+#include "solace/pathBuilder.hpp"
+#include "solace/exception.hpp"
+
+
+using namespace Solace;
+
+
+PathBuilder& PathBuilder::append(StringView component) {
+    Span span;
+    span.offset = static_cast<String::size_type>(_text.size());
+    span.length = component.size();
+
+    _text.insert(_text.end(), component.begin(), component.end());
+    _spans.push_back(span);
+
+    return (*this);
+}
+
+
+PathBuilder& PathBuilder::append(Path const& path) {
+    for (auto const& component : path) {
+        append(component.view());
+    }
+
+    return (*this);
+}
+
+
+PathBuilder& PathBuilder::removeLast() noexcept {
+    if (_spans.empty()) {
+        return (*this);
+    }
+
+    _text.resize(_spans.back().offset);
+    _spans.pop_back();
+
+    return (*this);
+}
+
+
+PathBuilder& PathBuilder::clear() noexcept {
+    _text.clear();
+    _spans.clear();
+
+    return (*this);
+}
+
+
+StringView PathBuilder::getComponent(size_type index) const {
+    if (index >= size()) {
+        raise<IndexOutOfRangeException>(index, 0, size());
+    }
+
+    auto const& span = _spans[index];
+
+    return StringView{_text.data() + span.offset, span.length};
+}
+
+
+StringView PathBuilder::last() const noexcept {
+    if (_spans.empty()) {
+        return StringView{};
+    }
+
+    auto const& span = _spans.back();
+
+    return StringView{_text.data() + span.offset, span.length};
+}
+
+
+String PathBuilder::toString(StringView delim) const {
+    if (_spans.empty()) {
+        return String::Empty;
+    }
+
+    // An absolute path of a single (empty) component is the root:
+    if (isAbsolute() && _spans.size() == 1) {
+        return delim;
+    }
+
+    std::string buffer;
+    buffer.reserve(_text.size() + (_spans.size() - 1) * delim.size());
+
+    bool first = true;
+    for (auto const& span : _spans) {
+        if (!first) {
+            buffer.append(delim.data(), delim.size());
+        }
+        first = false;
+
+        buffer.append(_text.data() + span.offset, span.length);
+    }
+
+    return String(std::move(buffer));
+}
+
+
+Path PathBuilder::toPath() const {
+    Array<String>::Storage components;
+    components.reserve(_spans.size());
+
+    for (auto const& span : _spans) {
+        components.emplace_back(StringView{_text.data() + span.offset, span.length});
+    }
+
+    return Path(Array<String>{std::move(components)});
+}
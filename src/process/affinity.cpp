@@ -0,0 +1,289 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		process/affinity.cpp
+ *	@author		$LastChangedBy: soultaker $
+ *	@date		$LastChangedDate$
+ *	@brief		Implementation of thread placement utilities
+ *	ID:			$Id$
+ ******************************************************************************/
+#include "solace/process/affinity.hpp"
+#include "solace/exception.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+#include <unistd.h>
+
+#ifdef SOLACE_PLATFORM_LINUX
+#include <sys/syscall.h>
+#endif
+
+
+using namespace Solace;
+using namespace Solace::Process;
+
+
+namespace /* anonymous */ {
+
+/**
+ * Read a small sysfs attribute into the given buffer.
+ * @return True if the file existed and was read.
+ */
+bool readSysfsLine(const char* path, char* buffer, size_t bufferSize) {
+    FILE* file = fopen(path, "re");
+    if (!file) {
+        return false;
+    }
+
+    const bool ok = (fgets(buffer, static_cast<int>(bufferSize), file) != nullptr);
+    fclose(file);
+
+    return ok;
+}
+
+/**
+ * Parse a kernel cpu list such as "0-3,8,10-11" into a CpuSet.
+ */
+CpuSet parseCpuList(const char* list) {
+    CpuSet cpus;
+
+    const char* cursor = list;
+    while (*cursor && *cursor != '\n') {
+        char* end = nullptr;
+        const auto first = strtoul(cursor, &end, 10);
+        auto last = first;
+
+        if (*end == '-') {
+            last = strtoul(end + 1, &end, 10);
+        }
+
+        for (auto cpu = first; cpu <= last; ++cpu) {
+            cpus.set(static_cast<uint32>(cpu));
+        }
+
+        cursor = (*end == ',') ? end + 1 : end;
+    }
+
+    return cpus;
+}
+
+/**
+ * Find the NUMA node of a CPU by probing for the node link in its sysfs
+ * directory. Non-NUMA machines report node 0.
+ */
+uint32 nodeOfCpu(uint32 cpu) {
+    char path[128];
+    for (uint32 node = 0; node < 1024; ++node) {
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/node%u", cpu, node);
+        if (access(path, F_OK) == 0) {
+            return node;
+        }
+    }
+
+    return 0;
+}
+
+/**
+ * Identify the last-level cache group of a CPU: the lowest CPU number
+ * sharing the deepest cache serves as the group id.
+ */
+uint32 cacheGroupOfCpu(uint32 cpu) {
+    char path[128];
+    char line[256];
+
+    uint32 group = cpu;
+    for (uint32 index = 0; index < 16; ++index) {
+        snprintf(path, sizeof(path),
+                 "/sys/devices/system/cpu/cpu%u/cache/index%u/shared_cpu_list", cpu, index);
+        if (!readSysfsLine(path, line, sizeof(line))) {
+            break;  // Cache levels are contiguous; the deepest one seen wins.
+        }
+
+        const auto sharers = parseCpuList(line);
+        for (uint32 candidate = 0; candidate <= cpu; ++candidate) {
+            if (sharers.isSet(candidate)) {
+                group = candidate;
+                break;
+            }
+        }
+    }
+
+    return group;
+}
+
+}  // namespace
+
+
+void Solace::Process::setThreadAffinity(CpuSet const& cpus) {
+    if (cpus.isEmpty()) {
+        raise<IllegalArgumentException>("cpus");
+    }
+
+    if (sched_setaffinity(0, sizeof(cpu_set_t), &cpus.nativeHandle()) < 0) {
+        raise<IOException>(errno);
+    }
+}
+
+
+CpuSet Solace::Process::getThreadAffinity() {
+    CpuSet cpus;
+    if (sched_getaffinity(0, sizeof(cpu_set_t), &cpus.nativeHandle()) < 0) {
+        raise<IOException>(errno);
+    }
+
+    return cpus;
+}
+
+
+void Solace::Process::setRealtimePriority(int priority) {
+    if (priority < 1 || priority > 99) {
+        raise<IllegalArgumentException>("priority");
+    }
+
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+    param.sched_priority = priority;
+
+    if (sched_setscheduler(0, SCHED_FIFO, &param) < 0) {
+        raise<IOException>(errno);
+    }
+}
+
+
+void Solace::Process::dropRealtimePriority() {
+    sched_param param;
+    memset(&param, 0, sizeof(param));
+
+    if (sched_setscheduler(0, SCHED_OTHER, &param) < 0) {
+        raise<IOException>(errno);
+    }
+}
+
+
+void Solace::Process::bindMemoryToNode(uint32 node) {
+#if defined(SOLACE_PLATFORM_LINUX) && defined(SYS_set_mempolicy)
+    // No libnuma dependency for two flag words, thus the raw syscall.
+    const int MPOL_BIND_POLICY = 2;  // MPOL_BIND from <linux/mempolicy.h>
+
+    unsigned long nodeMask[16] = {0};
+    if (node >= sizeof(nodeMask) * 8) {
+        raise<IllegalArgumentException>("node");
+    }
+    nodeMask[node / (sizeof(unsigned long) * 8)] |= 1UL << (node % (sizeof(unsigned long) * 8));
+
+    if (syscall(SYS_set_mempolicy, MPOL_BIND_POLICY, nodeMask, sizeof(nodeMask) * 8) < 0) {
+        raise<IOException>(errno);
+    }
+#else
+    (void) node;
+    raise<IOException>(ENOSYS);
+#endif
+}
+
+
+void Solace::Process::resetMemoryPolicy() {
+#if defined(SOLACE_PLATFORM_LINUX) && defined(SYS_set_mempolicy)
+    const int MPOL_DEFAULT_POLICY = 0;  // MPOL_DEFAULT from <linux/mempolicy.h>
+
+    if (syscall(SYS_set_mempolicy, MPOL_DEFAULT_POLICY, nullptr, 0) < 0) {
+        raise<IOException>(errno);
+    }
+#else
+    raise<IOException>(ENOSYS);
+#endif
+}
+
+
+Topology Topology::discover() {
+    const auto configured = sysconf(_SC_NPROCESSORS_CONF);
+    const auto limit = (configured > 0) ? static_cast<uint32>(configured) : 1;
+
+    std::vector<Cpu> cpus;
+    cpus.reserve(limit);
+
+    char path[128];
+    for (uint32 cpu = 0; cpu < limit; ++cpu) {
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u", cpu);
+        if (access(path, F_OK) < 0) {
+            if (cpu == 0) {  // No sysfs at all: degrade to a flat layout.
+                for (uint32 id = 0; id < limit; ++id) {
+                    cpus.push_back(Cpu{id, 0, id});
+                }
+            }
+            break;
+        }
+
+        // Hot-unplugged CPUs keep the directory but drop from the online list;
+        // a missing topology entry is treated as online for simplicity.
+        snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%u/online", cpu);
+        char line[16];
+        if (readSysfsLine(path, line, sizeof(line)) && line[0] == '0') {
+            continue;
+        }
+
+        cpus.push_back(Cpu{cpu, nodeOfCpu(cpu), cacheGroupOfCpu(cpu)});
+    }
+
+    return Topology(std::move(cpus));
+}
+
+
+uint32 Topology::nodeCount() const noexcept {
+    uint32 highest = 0;
+    for (const auto& cpu : _cpus) {
+        if (cpu.node > highest) {
+            highest = cpu.node;
+        }
+    }
+
+    return _cpus.empty() ? 0 : highest + 1;
+}
+
+
+CpuSet Topology::cpusOnNode(uint32 node) const noexcept {
+    CpuSet cpus;
+    for (const auto& cpu : _cpus) {
+        if (cpu.node == node) {
+            cpus.set(cpu.id);
+        }
+    }
+
+    return cpus;
+}
+
+
+CpuSet Topology::cpusSharingCacheWith(uint32 cpuId) const noexcept {
+    uint32 group = cpuId;
+    for (const auto& cpu : _cpus) {
+        if (cpu.id == cpuId) {
+            group = cpu.cacheGroup;
+            break;
+        }
+    }
+
+    CpuSet cpus;
+    for (const auto& cpu : _cpus) {
+        if (cpu.cacheGroup == group) {
+            cpus.set(cpu.id);
+        }
+    }
+
+    return cpus;
+}
@@ -169,3 +169,103 @@ const Env& Env::forEach(const std::function<void(const String&)> &f) const {
 
     return *this;
 }
+
+
+Env::Snapshot Env::snapshot() const {
+    Snapshot snapshot;
+
+    // One pass to size the flat buffer so views into it stay stable:
+    size_type count = 0;
+    size_t totalLength = 0;
+    for (size_type i = 0; environ && environ[i]; ++i) {
+        totalLength += strlen(environ[i]);
+        ++count;
+    }
+
+    snapshot._data.reserve(totalLength);
+    snapshot._records.reserve(count);
+
+    for (size_type i = 0; environ && environ[i]; ++i) {
+        const auto* env = environ[i];
+        const auto* separator = strchr(env, '=');
+        if (!separator) {
+            continue;       // Malformed entry; getenv would not find it either.
+        }
+
+        const auto recordOffset = snapshot._data.size();
+        snapshot._data.insert(snapshot._data.end(), env, env + strlen(env));
+
+        const auto nameLength = static_cast<StringView::size_type>(separator - env);
+        const StringView name{snapshot._data.data() + recordOffset,
+                              nameLength};
+        const StringView value{snapshot._data.data() + recordOffset + nameLength + 1,
+                               static_cast<StringView::size_type>(strlen(separator + 1))};
+
+        snapshot._records.push_back(Snapshot::Record{name, value, name.hashCode()});
+    }
+
+    // Index capacity is the power of two giving at most 50% load:
+    size_type capacity = 8;
+    while (capacity < 2 * snapshot._records.size()) {
+        capacity *= 2;
+    }
+
+    snapshot._index.assign(capacity, 0);
+
+    const auto mask = capacity - 1;
+    for (size_type i = 0; i < snapshot._records.size(); ++i) {
+        const auto& record = snapshot._records[i];
+
+        auto slot = static_cast<size_type>(record.hash) & mask;
+        bool isDuplicate = false;
+        while (snapshot._index[slot] != 0) {
+            const auto& resident = snapshot._records[snapshot._index[slot] - 1];
+            if (resident.hash == record.hash && resident.name.equals(record.name)) {
+                // getenv returns the first match, so does the snapshot:
+                isDuplicate = true;
+                break;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+
+        if (!isDuplicate) {
+            snapshot._index[slot] = static_cast<uint32>(i + 1);
+        }
+    }
+
+    return snapshot;
+}
+
+
+Optional<StringView>
+Env::Snapshot::get(StringView name) const noexcept {
+    if (_index.empty()) {
+        return none;
+    }
+
+    const auto hash = name.hashCode();
+    const auto mask = _index.size() - 1;
+
+    auto slot = static_cast<size_t>(hash) & mask;
+    while (_index[slot] != 0) {
+        const auto& record = _records[_index[slot] - 1];
+        if (record.hash == hash && record.name.equals(name)) {
+            return Optional<StringView>{record.value};
+        }
+
+        slot = (slot + 1) & mask;
+    }
+
+    return none;
+}
+
+
+const Env::Snapshot&
+Env::Snapshot::forEach(const std::function<void(StringView, StringView)>& f) const {
+    for (const auto& record : _records) {
+        f(record.name, record.value);
+    }
+
+    return *this;
+}
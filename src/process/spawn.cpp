@@ -0,0 +1,237 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		process/spawn.cpp
+ *	@author		$LastChangedBy: soultaker $
+ *	@date		$LastChangedDate$
+ *	@brief		Implementation of process spawning
+ *	ID:			$Id$
+ ******************************************************************************/
+#include "solace/process/spawn.hpp"
+#include "solace/exception.hpp"
+
+#include <spawn.h>
+#include <signal.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+#ifdef SOLACE_PLATFORM_LINUX
+#include <sys/syscall.h>
+#endif
+
+
+using namespace Solace;
+using namespace Solace::Process;
+
+
+#ifdef __APPLE__
+# include <crt_externs.h>
+# define environ (*_NSGetEnviron())
+#else
+extern char **environ;
+#endif
+
+
+namespace /* anonymous */ {
+
+ChildProcess::poll_id openPidfd(pid_t id) {
+#if defined(SOLACE_PLATFORM_LINUX) && defined(SYS_pidfd_open)
+    // No glibc wrapper until 2.36, thus the raw syscall:
+    return static_cast<ChildProcess::poll_id>(syscall(SYS_pidfd_open, id, 0));
+#else
+    (void) id;
+    return IO::ISelectable::InvalidFd;
+#endif
+}
+
+}  // namespace
+
+
+ChildProcess::ChildProcess(pid_t id, poll_id pidfd) :
+    _pid(id),
+    _pidfd(pidfd)
+{
+}
+
+
+ChildProcess::ChildProcess(ChildProcess&& rhs) noexcept :
+    _pid(rhs._pid),
+    _pidfd(rhs._pidfd),
+    _status(std::move(rhs._status)),
+    _completion(std::move(rhs._completion))
+{
+    rhs._pid = 0;
+    rhs._pidfd = IO::ISelectable::InvalidFd;
+}
+
+
+ChildProcess::~ChildProcess() {
+    if (_pidfd != IO::ISelectable::InvalidFd) {
+        ::close(_pidfd);
+    }
+}
+
+
+ChildProcess& ChildProcess::swap(ChildProcess& rhs) noexcept {
+    using std::swap;
+
+    swap(_pid, rhs._pid);
+    swap(_pidfd, rhs._pidfd);
+    swap(_status, rhs._status);
+    _completion.swap(rhs._completion);
+
+    return *this;
+}
+
+
+Future<ExitStatus> ChildProcess::onExit() {
+    return _completion.getFuture();
+}
+
+
+ExitStatus ChildProcess::complete(int rawStatus) {
+    const ExitStatus status = WIFEXITED(rawStatus)
+            ? ExitStatus{ true,  WEXITSTATUS(rawStatus) }
+            : ExitStatus{ false, WTERMSIG(rawStatus) };
+
+    _status = Optional<ExitStatus>(status);
+    _completion.setValue(status);
+
+    return status;
+}
+
+
+Optional<ExitStatus> ChildProcess::tryReap() {
+    if (!_status.isNone()) {
+        return _status;
+    }
+
+    int rawStatus = 0;
+    const auto reaped = ::waitpid(_pid, &rawStatus, WNOHANG);
+    if (reaped < 0) {
+        raise<IOException>(errno);
+    }
+
+    if (reaped == 0) {  // Still running.
+        return none;
+    }
+
+    return Optional<ExitStatus>(complete(rawStatus));
+}
+
+
+ExitStatus ChildProcess::wait() {
+    if (!_status.isNone()) {
+        return _status.get();
+    }
+
+    int rawStatus = 0;
+    if (::waitpid(_pid, &rawStatus, 0) < 0) {
+        raise<IOException>(errno);
+    }
+
+    return complete(rawStatus);
+}
+
+
+void ChildProcess::sendSignal(int signum) {
+    if (::kill(_pid, signum) < 0) {
+        raise<IOException>(errno);
+    }
+}
+
+
+Spawner::Spawner(StringView program) :
+    _program(program.data(), program.size())
+{
+}
+
+
+Spawner& Spawner::arg(StringView value) {
+    _args.emplace_back(value.data(), value.size());
+
+    return *this;
+}
+
+
+Spawner& Spawner::mapFd(int childFd, IO::ISelectable::poll_id parentFd) {
+    _mappings.push_back(FdMapping{childFd, parentFd});
+
+    return *this;
+}
+
+
+Spawner& Spawner::stdIn(IO::Pipe& pipe) {
+    _closeInChild.push_back(pipe.getWriteEnd().getSelectId());
+
+    return mapFd(STDIN_FILENO, pipe.getReadEnd().getSelectId());
+}
+
+
+Spawner& Spawner::stdOut(IO::Pipe& pipe) {
+    _closeInChild.push_back(pipe.getReadEnd().getSelectId());
+
+    return mapFd(STDOUT_FILENO, pipe.getWriteEnd().getSelectId());
+}
+
+
+Spawner& Spawner::stdErr(IO::Pipe& pipe) {
+    _closeInChild.push_back(pipe.getReadEnd().getSelectId());
+
+    return mapFd(STDERR_FILENO, pipe.getWriteEnd().getSelectId());
+}
+
+
+ChildProcess Spawner::spawn() {
+    std::vector<char*> argv;
+    argv.reserve(_args.size() + 2);
+    argv.push_back(const_cast<char*>(_program.c_str()));
+    for (auto& value : _args) {
+        argv.push_back(const_cast<char*>(value.c_str()));
+    }
+    argv.push_back(nullptr);
+
+    posix_spawn_file_actions_t fileActions;
+    posix_spawn_file_actions_init(&fileActions);
+    for (const auto& mapping : _mappings) {
+        posix_spawn_file_actions_adddup2(&fileActions, mapping.parentFd, mapping.childFd);
+    }
+    for (const auto fd : _closeInChild) {
+        posix_spawn_file_actions_addclose(&fileActions, fd);
+    }
+
+    posix_spawnattr_t attr;
+    posix_spawnattr_init(&attr);
+#ifdef POSIX_SPAWN_USEVFORK
+    // Share the parent's page tables for the exec window instead of copying
+    // them fork-style: on a large-RSS parent the copy alone costs hundreds
+    // of milliseconds. Newer glibc does this by default via clone(VFORK).
+    posix_spawnattr_setflags(&attr, POSIX_SPAWN_USEVFORK);
+#endif
+
+    pid_t childPid = 0;
+    const auto rc = ::posix_spawn(&childPid, _program.c_str(), &fileActions, &attr, argv.data(), environ);
+
+    posix_spawnattr_destroy(&attr);
+    posix_spawn_file_actions_destroy(&fileActions);
+
+    if (rc != 0) {
+        raise<IOException>(rc);
+    }
+
+    return ChildProcess(childPid, openPidfd(childPid));
+}
@@ -230,3 +230,107 @@ ReadBuffer::readBE(uint64& value) {
                 }
     });
 }
+
+
+namespace /* anonymous */ {
+
+/** Reverse the byte order of every element of an array in place.
+ * A plain loop over byteSwap() that compilers unroll and vectorize.
+ */
+template<typename T>
+void byteSwapInPlace(T* data, ReadBuffer::size_type count) noexcept {
+    for (ReadBuffer::size_type i = 0; i < count; ++i) {
+        data[i] = byteSwap(data[i]);
+    }
+}
+
+}  // namespace
+
+
+Result<void, Error>
+ReadBuffer::readLE(uint16* dest, size_type count) {
+    return read(dest, count * sizeof(uint16))
+            .then([dest, count]() { if (isBigendian()) { byteSwapInPlace(dest, count); } });
+}
+
+Result<void, Error>
+ReadBuffer::readLE(uint32* dest, size_type count) {
+    return read(dest, count * sizeof(uint32))
+            .then([dest, count]() { if (isBigendian()) { byteSwapInPlace(dest, count); } });
+}
+
+Result<void, Error>
+ReadBuffer::readLE(uint64* dest, size_type count) {
+    return read(dest, count * sizeof(uint64))
+            .then([dest, count]() { if (isBigendian()) { byteSwapInPlace(dest, count); } });
+}
+
+Result<void, Error>
+ReadBuffer::readBE(uint16* dest, size_type count) {
+    return read(dest, count * sizeof(uint16))
+            .then([dest, count]() { if (!isBigendian()) { byteSwapInPlace(dest, count); } });
+}
+
+Result<void, Error>
+ReadBuffer::readBE(uint32* dest, size_type count) {
+    return read(dest, count * sizeof(uint32))
+            .then([dest, count]() { if (!isBigendian()) { byteSwapInPlace(dest, count); } });
+}
+
+Result<void, Error>
+ReadBuffer::readBE(uint64* dest, size_type count) {
+    return read(dest, count * sizeof(uint64))
+            .then([dest, count]() { if (!isBigendian()) { byteSwapInPlace(dest, count); } });
+}
+
+
+Result<void, Error>
+ReadBuffer::readVarint(uint64& value) {
+    byte const* data = _storage.view().dataAddress(_position);
+    const size_type available = remaining();
+
+    // A 64-bit varint spans at most 10 encoded bytes.
+    const size_type maxBytes = (available < 10) ? available : 10;
+
+    uint64 result = 0;
+    uint32 shift = 0;
+    size_type i = 0;
+
+    if (available >= sizeof(uint64)) {
+        // Fast path: one unaligned 8-byte load serves up to 8 encoded bytes
+        // with no bounds check per byte.
+        uint64 word;
+        memcpy(&word, data, sizeof(word));
+
+        for (; i < sizeof(uint64); ++i) {
+            result |= (word & 0x7Fu) << shift;
+            if ((word & 0x80u) == 0) {
+                _position += i + 1;
+                value = result;
+
+                return Ok();
+            }
+
+            word >>= 8;
+            shift += 7;
+        }
+    }
+
+    // Scalar tail: bytes 9 and 10, or a buffer shorter than one word.
+    for (; i < maxBytes; ++i) {
+        const uint64 encoded = data[i];
+        result |= (encoded & 0x7Fu) << shift;
+        if ((encoded & 0x80u) == 0) {
+            _position += i + 1;
+            value = result;
+
+            return Ok();
+        }
+
+        shift += 7;
+    }
+
+    return (available < 10)
+            ? Err<Error>(StringView("UnderflowError: readVarint(): truncated varint"))
+            : Err<Error>(StringView("MalformedError: readVarint(): varint longer than 10 bytes"));
+}
@@ -0,0 +1,48 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * @file     recordCursor.cpp
+ *
+ * Record iteration over raw memory.
+*******************************************************************************/
+#include "solace/recordCursor.hpp"
+
+
+using namespace Solace;
+
+
+StringView RecordCursor::next() noexcept {
+    auto const* base = reinterpret_cast<char const*>(_data.dataAddress());
+    const auto from = _offset;
+    const auto remaining = _data.size() - from;
+
+    // A record a StringView cannot address is yielded in maximal pieces:
+    constexpr auto kWindow = static_cast<size_type>(std::numeric_limits<StringView::size_type>::max());
+    const auto window = (remaining < kWindow) ? remaining : kWindow;
+
+    // memchr / memcmp map onto whatever SIMD the libc was built with:
+    auto const* hit = static_cast<char const*>(memchr(base + from, _delimiter, window));
+    if (hit == nullptr) {
+        _offset = from + window;
+
+        return StringView(base + from, static_cast<StringView::size_type>(window));
+    }
+
+    const auto recordLength = static_cast<StringView::size_type>(hit - (base + from));
+    _offset = from + recordLength + 1;
+
+    return StringView(base + from, recordLength);
+}
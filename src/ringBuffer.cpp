@@ -0,0 +1,157 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		ringBuffer.cpp
+ *	@brief		Implementation of RingBuffer
+ ******************************************************************************/
+#include "solace/ringBuffer.hpp"
+#include "solace/exception.hpp"
+
+#include <cstring>  // memcpy
+
+
+using namespace Solace;
+
+
+namespace /* anonymous */ {
+
+constexpr bool isPowerOfTwo(RingBuffer::size_type value) noexcept {
+    return (value != 0) && ((value & (value - 1)) == 0);
+}
+
+}  // namespace
+
+
+RingBuffer::RingBuffer(MemoryBuffer buffer) :
+    _storage(std::move(buffer))
+{
+    if (!isPowerOfTwo(_storage.size())) {
+        raise<IllegalArgumentException>("buffer");
+    }
+}
+
+
+Result<void, Error>
+RingBuffer::write(ImmutableMemoryView const& data) {
+    // Only this producer advances the write cursor, so a relaxed read of it is exact;
+    // the consumer's cursor is acquired to see the space it has freed.
+    const auto writeCursor = _writeCursor.load(std::memory_order_relaxed);
+    const auto readCursor = _readCursor.load(std::memory_order_acquire);
+
+    if (capacity() - (writeCursor - readCursor) < data.size()) {
+        return Err(Error("OverflowError: write(data): no space left in the ring"));
+    }
+
+    const auto offset = maskCursor(writeCursor);
+    const auto run = capacity() - offset;
+    if (data.size() <= run) {
+        memcpy(_storage.view().dataAddress(offset), data.dataAddress(), data.size());
+    } else {
+        memcpy(_storage.view().dataAddress(offset), data.dataAddress(), run);
+        memcpy(_storage.view().dataAddress(), data.dataAddress(run), data.size() - run);
+    }
+
+    // Publish the bytes to the consumer.
+    _writeCursor.store(writeCursor + data.size(), std::memory_order_release);
+
+    return Ok();
+}
+
+
+Result<void, Error>
+RingBuffer::read(MemoryView& dest, size_type bytesToRead) {
+    if (dest.size() < bytesToRead) {
+        return Err(Error("OverflowError: read(dest, size): destination buffer is too small"));
+    }
+
+    const auto readCursor = _readCursor.load(std::memory_order_relaxed);
+    const auto writeCursor = _writeCursor.load(std::memory_order_acquire);
+
+    if (writeCursor - readCursor < bytesToRead) {
+        return Err(Error("UnderflowError: read(dest, size): not enough data in the ring"));
+    }
+
+    const auto offset = maskCursor(readCursor);
+    const auto run = capacity() - offset;
+    if (bytesToRead <= run) {
+        memcpy(dest.dataAddress(), _storage.view().dataAddress(offset), bytesToRead);
+    } else {
+        memcpy(dest.dataAddress(), _storage.view().dataAddress(offset), run);
+        memcpy(dest.dataAddress(run), _storage.view().dataAddress(), bytesToRead - run);
+    }
+
+    // Release the space back to the producer.
+    _readCursor.store(readCursor + bytesToRead, std::memory_order_release);
+
+    return Ok();
+}
+
+
+ImmutableMemoryView
+RingBuffer::viewReadable() const noexcept {
+    const auto readCursor = _readCursor.load(std::memory_order_relaxed);
+    const auto writeCursor = _writeCursor.load(std::memory_order_acquire);
+
+    const auto offset = maskCursor(readCursor);
+    const auto run = capacity() - offset;
+    const auto available = writeCursor - readCursor;
+
+    return _storage.view().slice(offset, offset + ((available < run) ? available : run));
+}
+
+
+MemoryView
+RingBuffer::viewWritable() noexcept {
+    const auto writeCursor = _writeCursor.load(std::memory_order_relaxed);
+    const auto readCursor = _readCursor.load(std::memory_order_acquire);
+
+    const auto offset = maskCursor(writeCursor);
+    const auto run = capacity() - offset;
+    const auto available = capacity() - (writeCursor - readCursor);
+
+    return _storage.view().slice(offset, offset + ((available < run) ? available : run));
+}
+
+
+Result<void, Error>
+RingBuffer::commitRead(size_type count) {
+    const auto readCursor = _readCursor.load(std::memory_order_relaxed);
+    const auto writeCursor = _writeCursor.load(std::memory_order_acquire);
+
+    if (writeCursor - readCursor < count) {
+        return Err(Error("UnderflowError: commitRead(count): not enough data in the ring"));
+    }
+
+    _readCursor.store(readCursor + count, std::memory_order_release);
+
+    return Ok();
+}
+
+
+Result<void, Error>
+RingBuffer::commitWrite(size_type count) {
+    const auto writeCursor = _writeCursor.load(std::memory_order_relaxed);
+    const auto readCursor = _readCursor.load(std::memory_order_acquire);
+
+    if (capacity() - (writeCursor - readCursor) < count) {
+        return Err(Error("OverflowError: commitWrite(count): no space left in the ring"));
+    }
+
+    _writeCursor.store(writeCursor + count, std::memory_order_release);
+
+    return Ok();
+}
@@ -0,0 +1,177 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		segmentedReadBuffer.cpp
+ *	@brief		Implementation of SegmentedReadBuffer
+ ******************************************************************************/
+#include "solace/segmentedReadBuffer.hpp"
+
+
+#include <algorithm>
+#include <cstring>  // memcpy
+
+
+using namespace Solace;
+
+
+Result<void, Error>
+SegmentedReadBuffer::position(size_type newPosition) {
+    if (limit() < newPosition) {
+        return Err<Error>(StringView("OverflowError: position(): value pass the buffer end."));
+    }
+
+    // Seeks are rare; re-derive the segment cursor by walking from the front.
+    size_type index = 0;
+    size_type offset = newPosition;
+    while (index < _segments.size() && offset >= _segments[index].size()) {
+        offset -= _segments[index].size();
+        ++index;
+    }
+
+    _position = newPosition;
+    _segmentIndex = index;
+    _segmentOffset = offset;
+
+    return Ok();
+}
+
+
+Result<void, Error>
+SegmentedReadBuffer::advance(size_type increment) {
+    if (remaining() < increment) {
+        return Err<Error>(StringView("OverflowError: advance(): move pass the buffer end."));
+    }
+
+    _position += increment;
+    _segmentOffset += increment;
+    while (_segmentIndex < _segments.size() && _segmentOffset >= _segments[_segmentIndex].size()) {
+        _segmentOffset -= _segments[_segmentIndex].size();
+        ++_segmentIndex;
+    }
+
+    return Ok();
+}
+
+
+Result<byte, Error>
+SegmentedReadBuffer::get() {
+    if (remaining() < 1) {
+        return Err<Error>(StringView("OverflowError: get(): no data remained in the buffer"));
+    }
+
+    auto const value = _segments[_segmentIndex][_segmentOffset];
+
+    _position += 1;
+    _segmentOffset += 1;
+    if (_segmentOffset == _segments[_segmentIndex].size()) {
+        _segmentOffset = 0;
+        _segmentIndex += 1;
+    }
+
+    return Ok(value);
+}
+
+
+Result<void, Error>
+SegmentedReadBuffer::read(MemoryView& dest, size_type bytesToRead) {
+    if (dest.size() < bytesToRead) {
+        return Err<Error>(StringView("OverflowError: read(dest, size): destination buffer is too small"));
+    }
+
+    return read(dest.dataAddress(), bytesToRead);
+}
+
+
+Result<void, Error>
+SegmentedReadBuffer::read(void* dest, size_type bytesToRead) {
+    if (remaining() < bytesToRead) {
+        return Err<Error>(StringView("UnderflowError: read(dest, size): not enough data in the buffer"));
+    }
+
+    // Fast path: the read does not straddle a segment boundary.
+    if (_segmentIndex < _segments.size()
+        && _segments[_segmentIndex].size() - _segmentOffset >= bytesToRead) {
+        auto const& segment = _segments[_segmentIndex];
+        memcpy(dest, segment.dataAddress(_segmentOffset), bytesToRead);
+
+        _position += bytesToRead;
+        _segmentOffset += bytesToRead;
+        if (_segmentOffset == segment.size()) {
+            _segmentOffset = 0;
+            _segmentIndex += 1;
+        }
+
+        return Ok();
+    }
+
+    // Slow path: gather the value from as many segments as it spans.
+    auto* out = static_cast<byte*>(dest);
+    size_type bytesLeft = bytesToRead;
+    while (bytesLeft > 0) {
+        auto const& segment = _segments[_segmentIndex];
+        auto const chunk = std::min(segment.size() - _segmentOffset, bytesLeft);
+        memcpy(out, segment.dataAddress(_segmentOffset), chunk);
+
+        out += chunk;
+        bytesLeft -= chunk;
+        _position += chunk;
+        _segmentOffset += chunk;
+        if (_segmentOffset == segment.size()) {
+            _segmentOffset = 0;
+            _segmentIndex += 1;
+        }
+    }
+
+    return Ok();
+}
+
+
+Result<void, Error>
+SegmentedReadBuffer::readLE(uint16& value) {
+    return read(&value, sizeof(value))
+            .then([&]() { if (isBigendian()) { value = byteSwap(value); } });
+}
+
+Result<void, Error>
+SegmentedReadBuffer::readLE(uint32& value) {
+    return read(&value, sizeof(value))
+            .then([&]() { if (isBigendian()) { value = byteSwap(value); } });
+}
+
+Result<void, Error>
+SegmentedReadBuffer::readLE(uint64& value) {
+    return read(&value, sizeof(value))
+            .then([&]() { if (isBigendian()) { value = byteSwap(value); } });
+}
+
+Result<void, Error>
+SegmentedReadBuffer::readBE(uint16& value) {
+    return read(&value, sizeof(value))
+            .then([&]() { if (!isBigendian()) { value = byteSwap(value); } });
+}
+
+Result<void, Error>
+SegmentedReadBuffer::readBE(uint32& value) {
+    return read(&value, sizeof(value))
+            .then([&]() { if (!isBigendian()) { value = byteSwap(value); } });
+}
+
+Result<void, Error>
+SegmentedReadBuffer::readBE(uint64& value) {
+    return read(&value, sizeof(value))
+            .then([&]() { if (!isBigendian()) { value = byteSwap(value); } });
+}
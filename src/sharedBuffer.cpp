@@ -0,0 +1,59 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace: SharedBuffer
+ *	@file		sharedBuffer.cpp
+ ******************************************************************************/
+#include "solace/sharedBuffer.hpp"
+
+#include <cstring>  // memcpy
+#include <new>
+
+
+using namespace Solace;
+
+
+SharedBuffer
+SharedBuffer::copyOf(ImmutableMemoryView data) {
+    if (data.empty()) {
+        return SharedBuffer();
+    }
+
+    // One allocation for the count and the bytes together:
+    auto* raw = ::operator new(sizeof(Header) + data.size());
+    auto* header = new (raw) Header{{1}};
+
+    auto* bytes = reinterpret_cast<byte*>(header + 1);
+    memcpy(bytes, data.dataAddress(), data.size());
+
+    return SharedBuffer(header, ImmutableMemoryView(bytes, data.size()));
+}
+
+
+void SharedBuffer::release() noexcept {
+    if (!_header) {
+        return;
+    }
+
+    // The release order publishes this handle's reads; the last owner
+    // acquires them all before freeing:
+    if (_header->refs.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        _header->~Header();
+        ::operator delete(_header);
+    }
+
+    _header = nullptr;
+}
@@ -21,8 +21,12 @@
  *	ID:			$Id: aprilString.cpp 179 2009-11-17 23:28:25Z soultaker $
  ******************************************************************************/
 #include "solace/string.hpp"
+#include "solace/exception.hpp"
+#include "solace/memoryBuffer.hpp"
+#include "solace/writeBuffer.hpp"
 
-#include <cstring>  // va_list
+#include <cstring>  // memcpy / strlen
+#include <algorithm>  // std::min
 #include <regex>
 
 
@@ -30,162 +34,254 @@ using namespace Solace;
 
 
 
-const String String::Empty(std::string(""));
-const String TRUE_STRING(std::string("true"));
-const String FALSE_STRING(std::string("false"));
+const String String::Empty("");
+const String TRUE_STRING("true");
+const String FALSE_STRING("false");
+
+
+String::Storage::~Storage() {
+    if (isInlined()) {
+        return;
+    }
+
+    if (_adopted) {
+        auto view = wrapMemory(_buffer.adopted.data, _buffer.adopted.capacity);
+        _buffer.adopted.disposer->dispose(&view);
+    } else {
+        delete [] _buffer.heap;
+    }
+}
+
+
+String::Storage::Storage(char const* data, size_type dataSize) :
+    _size(dataSize)
+{
+    char* dest = isInlined()
+            ? _buffer.inplace
+            : (_buffer.heap = new char[dataSize + 1]);
+
+    memcpy(dest, data, dataSize);
+    dest[dataSize] = '\0';
+}
+
+
+String::Storage::Storage(MemoryBuffer&& buffer, size_type textSize) :
+    _size(textSize)
+{
+    // Short content lands in-place; adopting a whole buffer for it buys nothing.
+    // Adoption also needs room for the terminator, else the content is re-homed.
+    if (isInlined() || buffer.size() < static_cast<MemoryBuffer::size_type>(textSize) + 1) {
+        char* dest = isInlined()
+                ? _buffer.inplace
+                : (_buffer.heap = new char[textSize + 1]);
+
+        memcpy(dest, buffer.view().dataAddress(), textSize);
+        dest[textSize] = '\0';
+
+        return;  // The buffer disposes of its own memory on scope exit.
+    }
+
+    auto released = buffer.release();
+    auto* text = released.data.dataAs<char>();
+
+    if (released.disposer == nullptr) {
+        // The buffer never owned the memory - nothing to adopt, copy instead.
+        _buffer.heap = new char[textSize + 1];
+        memcpy(_buffer.heap, text, textSize);
+        _buffer.heap[textSize] = '\0';
+
+        return;
+    }
+
+    text[textSize] = '\0';
+    _buffer.adopted = AdoptedBuffer{ text, released.disposer, released.data.size() };
+    _adopted = true;
+}
+
+
+String::Storage::Storage(StringView const* fragments, size_type count) :
+    Storage(StringView(), fragments, count)
+{}
+
+
+String::Storage::Storage(StringView by, StringView const* fragments, size_type count) :
+    _size(0)
+{
+    for (size_type i = 0; i < count; ++i) {
+        _size += fragments[i].size();
+    }
+    if (count > 1) {
+        _size += (count - 1) * by.size();
+    }
+
+    char* dest = isInlined()
+            ? _buffer.inplace
+            : (_buffer.heap = new char[_size + 1]);
+
+    for (size_type i = 0; i < count; ++i) {
+        memcpy(dest, fragments[i].data(), fragments[i].size());
+        dest += fragments[i].size();
+
+        if (i + 1 < count) {
+            memcpy(dest, by.data(), by.size());
+            dest += by.size();
+        }
+    }
+    *dest = '\0';
+}
+
+
+String::Storage::Storage(Storage&& rhs) noexcept :
+    _size(rhs._size),
+    _adopted(rhs._adopted)
+{
+    if (isInlined()) {
+        memcpy(_buffer.inplace, rhs._buffer.inplace, _size + 1);
+    } else {
+        // Steal the spilled buffer leaving rhs empty but valid.
+        _buffer = rhs._buffer;
+        rhs._size = 0;
+        rhs._adopted = false;
+        rhs._buffer.inplace[0] = '\0';
+    }
+}
+
+
+String::Storage&
+String::Storage::swap(Storage& rhs) noexcept {
+    using std::swap;
+
+    swap(_buffer, rhs._buffer);
+    swap(_size, rhs._size);
+    swap(_adopted, rhs._adopted);
+
+    return *this;
+}
 
 
 String::String(const char* data) :
-    _str(assertNotNull(data)) {
+    String(assertNotNull(data), static_cast<size_type>(strlen(data))) {
 }
 
 
-String::String(const char* data, size_type dataLength): _str(data, dataLength) {
+String::String(const char* data, size_type dataLength) :
+    _storage(data, dataLength)
+{
 }
 
 String::String(StringView view) :
-        _str(view.data(), view.size())
+    _storage(view.data(), view.size())
 {
 }
 
 
 String& String::swap(String& rhs) noexcept {
-    _str.swap(rhs._str);
+    _storage.swap(rhs._storage);
 
     return *this;
 }
 
 bool String::empty() const  noexcept {
-    return _str.empty();
+    return _storage.empty();
 }
 
 String::size_type String::length() const noexcept {
-    return static_cast<size_type>(_str.length());
+    return _storage.size();
 }
 
 String::size_type String::size() const noexcept {
-    return static_cast<size_type>(_str.length());
+    return _storage.size();
 }
 
 bool String::equals(const String& v) const noexcept {
-    return (_str == v._str);
+    return view().equals(v.view());
 }
 
 bool String::equals(const char* v) const {
-    return _str.compare(v) == 0;
+    return view().equals(StringView{v});
 }
 
 
 bool String::equals(StringView v) const {
-    return _str.compare(0, _str.length(), v.data(), v.size()) == 0;
+    return view().equals(v);
 }
 
 
 int String::compareTo(const String& other) const {
-    return _str.compare(other._str);
+    const auto minSize = std::min(size(), other.size());
+    const auto result = memcmp(_storage.data(), other._storage.data(), minSize);
+
+    return (result != 0)
+            ? result
+            : static_cast<int>(size()) - static_cast<int>(other.size());
 }
 
 int String::compareTo(const char* other) const {
-    return _str.compare(other);
+    return strcmp(c_str(), other);
 }
 
 String::value_type String::charAt(size_type index) const {
     // FIXME: Properly handle UTF-8 String
-    return Char(_str[index]);
+    return Char(_storage.data()[index]);
 }
 
 
 Optional<String::size_type>
 String::indexOf(const String& str, size_type fromIndex) const {
-    const auto index = _str.find(str._str, fromIndex);
-
-    return (index != std::string::npos)
-            ? Optional<size_type>(index)
-            : none;
+    return view().indexOf(str.view(), fromIndex);
 }
 
 Optional<String::size_type>
 String::indexOf(const value_type& ch, size_type fromIndex) const {
-    const auto index = _str.find(ch.getValue(), fromIndex);
-
-    return (index != std::string::npos)
-            ? Optional<size_type>(index)
-            : none;
+    return view().indexOf(StringView{ch.c_str(), static_cast<size_type>(ch.getBytesCount())}, fromIndex);
 }
 
 Optional<String::size_type>
 String::indexOf(const char* str, size_type fromIndex) const {
-    const auto index = _str.find(str, fromIndex);
-
-    return (index != std::string::npos)
-            ? Optional<size_type>(index)
-            : none;
+    return view().indexOf(StringView{str}, fromIndex);
 }
 
 Optional<String::size_type>
 String::lastIndexOf(const String& str, size_type fromIndex) const {
-    const auto thisSize = size();
-
-    std::string::size_type index = fromIndex;
-    std::string::size_type lastIndex = std::string::npos;
-    while ((index < thisSize) &&
-           (index = _str.find(str._str, index)) != std::string::npos)
-    {
-        lastIndex = index;
-        index += str._str.length();
-    }
-
-    return (lastIndex != std::string::npos)
-            ? Optional<size_type>(lastIndex)
-            : none;
+    return view().lastIndexOf(str.view(), fromIndex);
 }
 
 Optional<String::size_type>
 String::lastIndexOf(const value_type& ch, size_type fromIndex) const {
-    const auto thisSize = size();
-
-    const auto chSize = ch.getBytesCount();
-    std::string::size_type index = fromIndex;
-    std::string::size_type lastIndex = std::string::npos;
-    while ((index < thisSize) &&
-           (index = _str.find(ch.c_str(), index, chSize)) != std::string::npos) {
-        lastIndex = index;
-        index += chSize;
-    }
-
-    return (lastIndex != std::string::npos)
-            ? Optional<size_type>(lastIndex)
-            : none;
+    return view().lastIndexOf(StringView{ch.c_str(), static_cast<size_type>(ch.getBytesCount())}, fromIndex);
 }
 
 Optional<String::size_type>
 String::lastIndexOf(const char* str, size_type fromIndex) const {
-    const auto thisSize = size();
-    const auto strLen = strlen(str);
-
-    std::string::size_type index = fromIndex;
-    auto lastIndex = std::string::npos;
-    while ((index < thisSize) &&
-           (index = _str.find(str, index)) != std::string::npos) {
-        lastIndex = index;
-        index += strLen;
-    }
-
-    return (lastIndex != std::string::npos)
-            ? Optional<size_type>(lastIndex)
-            : none;
+    return view().lastIndexOf(StringView{str}, fromIndex);
 }
 
 String String::concat(const String& str) const {
-    return String(_str + str._str);
+    const StringView fragments[] = {view(), str.view()};
+
+    return fuse(fragments, 2);
 }
 
 String String::concat(const char* str) const {
-    return String(_str + str);
+    const StringView fragments[] = {view(), StringView{str}};
+
+    return fuse(fragments, 2);
+}
+
+String String::fuse(StringView const* fragments, size_type count) {
+    return String{ Storage(fragments, count) };
+}
+
+String String::adopt(MemoryBuffer&& buffer, size_type textSize) {
+    if (static_cast<MemoryBuffer::size_type>(textSize) > buffer.size()) {
+        raise<IllegalArgumentException>("textSize");
+    }
+
+    return String{ Storage(std::move(buffer), textSize) };
 }
 
 String String::replace(const value_type& what, const value_type& with) const {
-    std::string subject(_str);
+    std::string subject(to_str());
     std::string::size_type pos = 0;
 
     const Char::size_type whatSize = what.getBytesCount();
@@ -200,24 +296,26 @@ String String::replace(const value_type& what, const value_type& with) const {
 }
 
 String String::replace(const String& what, const String& by) const {
-    std::string subject(_str);
+    std::string subject(to_str());
+    const std::string whatStr(what.to_str());
+    const std::string byStr(by.to_str());
     std::string::size_type pos = 0;
 
-    while ((pos = subject.find(what._str, pos)) != std::string::npos) {
-        subject.replace(pos, what._str.length(), by._str);
-        pos += by._str.length();
+    while ((pos = subject.find(whatStr, pos)) != std::string::npos) {
+        subject.replace(pos, whatStr.length(), byStr);
+        pos += byStr.length();
     }
 
     return String{ std::move(subject) };
 }
 
 Array<String> String::split(const String& expr) const {
-    std::regex splitBy(expr._str);
+    std::regex splitBy(expr.to_str());
 
     std::smatch m;
-    std::string s = _str;
+    std::string s = to_str();
 
-    std::vector<String> splits;
+    Array<String>::Storage splits;
     while (std::regex_search(s, m, splitBy)) {
         splits.emplace_back(m.prefix());
         s = m.suffix().str();
@@ -234,40 +332,23 @@ Array<String> String::split(const String& expr) const {
 
 
 String String::substring(size_type from, size_type len) const {
-    return String(_str.substr(from, len));
+    return String{ view().substring(from, std::min<size_type>(len, size() - from)) };
 }
 
 String String::substring(size_type from) const {
-    return String(_str.substr(from));
+    return String{ view().substring(from) };
 }
 
 
 String String::trim() const {
-
-    size_type firstNonWhitespace = 0;
-    while (firstNonWhitespace < _str.size() &&
-            Char::isWhitespace(_str[firstNonWhitespace])) {
-        ++firstNonWhitespace;
-    }
-
-    // This string is whitespaces only
-    if (firstNonWhitespace == _str.size())
-        return Empty;
-
-    size_type lastNonWhitespace = _str.size() - 1;
-    while (lastNonWhitespace > firstNonWhitespace &&
-           Char::isWhitespace(_str[lastNonWhitespace])) {
-        --lastNonWhitespace;
-    }
-
-    return substring(firstNonWhitespace, lastNonWhitespace - firstNonWhitespace + 1);
+    return String{ view().trim() };
 }
 
 String String::toLowerCase() const {
     std::string res;
 
-    res.reserve(_str.size());
-    for (auto c : _str) {
+    res.reserve(size());
+    for (auto c : view()) {
         auto lower = Char::toLower(c);
         res.push_back(lower.c_str()[0]);  // FIXME(abbyssoul): Non-UTF8 compatible code
     }
@@ -278,10 +359,10 @@ String String::toLowerCase() const {
 String String::toUpperCase() const {
     std::string res;
 
-    res.reserve(_str.size());
-    for (auto c : _str) {
-        auto lower = Char::toUpper(c);
-        res.push_back(lower.c_str()[0]);  // FIXME(abbyssoul): Non-UTF8 compatible code
+    res.reserve(size());
+    for (auto c : view()) {
+        auto upper = Char::toUpper(c);
+        res.push_back(upper.c_str()[0]);  // FIXME(abbyssoul): Non-UTF8 compatible code
     }
 
     return String{ std::move(res) };
@@ -295,15 +376,12 @@ bool String::startsWith(const String& prefix) const {
     if (prefix.empty())
         return empty();
 
-    if (prefix.size() > size())
-        return false;
-
-    return std::strncmp(_str.data(), prefix._str.data(), prefix.size()) == 0;
+    return view().startsWith(prefix.view());
 }
 
 bool String::startsWith(const value_type& prefix) const {
     return empty() ? false :
-            Char::equals(prefix, _str[0]);
+            Char::equals(prefix, _storage.data()[0]);
 }
 
 bool String::endsWith(const String& suffix) const {
@@ -313,23 +391,24 @@ bool String::endsWith(const String& suffix) const {
     if (suffix.empty())
         return empty();
 
-    if (suffix.size() > size())
-        return false;
-
-    return std::strncmp(_str.data() + (_str.size() - suffix.size()), suffix._str.data(), suffix.size()) == 0;
+    return view().endsWith(suffix.view());
 }
 
 bool String::endsWith(const value_type& suffix) const {
     return empty() ? false :
-           Char::equals(suffix, _str[_str.size() - 1]);
+           Char::equals(suffix, _storage.data()[size() - 1]);
 }
 
 uint64 String::hashCode() const {
-    return std::hash<std::string>()(_str);
+    return view().hashCode();
+}
+
+uint64 String::hashCode(uint64 seed) const {
+    return view().hashCode(seed);
 }
 
 const char* String::c_str() const {
-    return _str.c_str();
+    return _storage.data();
 }
 
 String String::join(StringView by, std::initializer_list<String> list) {
@@ -346,12 +425,12 @@ String String::join(StringView by, std::initializer_list<String> list) {
 
     size_type i = 0;
     for (auto& s : list) {
-        buffer.append(s._str);
+        buffer.append(s._storage.data(), s.size());
         if (++i < list.size())
             buffer.append(by.data(), by.size());
     }
 
-    return String(buffer);
+    return String{ std::move(buffer) };
 }
 
 /** Return jointed string from the given collection */
@@ -370,13 +449,44 @@ String::join(StringView by, const Array<String>& list) {
 
     size_type i = 0;
     for (auto& s : list) {
-        buffer.append(s._str);
+        buffer.append(s._storage.data(), s.size());
         if (++i < list.size()) {
             buffer.append(by.data(), by.size());
         }
     }
 
-    return String(buffer);
+    return String{ std::move(buffer) };
+}
+
+String
+String::join(StringView by, ArrayView<StringView> list) {
+    return String{ Storage(by, list.begin(), static_cast<size_type>(list.size())) };
+}
+
+Result<void, Error>
+String::join(WriteBuffer& dest, StringView by, ArrayView<StringView> list) {
+    size_type totalSize = 0;
+    for (auto const& fragment : list) {
+        totalSize += fragment.size();
+    }
+    if (list.size() > 1) {
+        totalSize += (list.size() - 1) * by.size();
+    }
+
+    if (totalSize > dest.viewRemaining().size()) {
+        return Err(Error("OverflowError: join(): destination buffer is too small"));
+    }
+
+    // Capacity is checked - none of the writes below can fail:
+    size_type i = 0;
+    for (auto const& fragment : list) {
+        dest.write(wrapMemory(fragment.data(), fragment.size()));
+        if (++i < list.size()) {
+            dest.write(wrapMemory(by.data(), by.size()));
+        }
+    }
+
+    return Ok();
 }
 
 /** Return String representation of boolen value **/
@@ -0,0 +1,173 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ *	@file		solace/stringAtom.cpp
+ *	@brief		Implementation of the process-wide string intern table.
+ ******************************************************************************/
+#include "solace/stringAtom.hpp"
+
+#include <deque>
+#include <mutex>
+#include <vector>
+
+
+using namespace Solace;
+
+
+namespace {
+
+/** The process-wide intern table.
+ *
+ * Interned strings are kept in a deque-of-chunks style store so that views
+ * handed out remain stable while the table grows. Lookup is an open-addressing
+ * hash over (hashCode, bytes) keyed directly by StringView so a probe never
+ * constructs a String.
+ */
+class InternTable {
+public:
+
+    struct Entry {
+        String  str;
+        uint64  hash;
+    };
+
+    InternTable() {
+        _buckets.resize(kInitialBuckets, 0);
+
+        // Id 0 is the empty string; stored so view()/hashCode() need no special case.
+        _entries.push_back(Entry{String::Empty, StringView().hashCode()});
+    }
+
+    StringAtom::id_type intern(StringView view) {
+        if (view.empty()) {
+            return 0;
+        }
+
+        const auto hash = view.hashCode();
+
+        std::lock_guard<std::mutex> guard(_lock);
+
+        auto slot = findSlot(view, hash);
+        if (_buckets[slot] != 0) {
+            return _buckets[slot];
+        }
+
+        // Not seen before - this is the only place a String gets constructed.
+        _entries.push_back(Entry{String{view}, hash});
+        const auto id = static_cast<StringAtom::id_type>(_entries.size() - 1);
+        _buckets[slot] = id;
+
+        if (_entries.size() * 2 > _buckets.size()) {
+            rehash();
+        }
+
+        return id;
+    }
+
+    Entry const& entryOf(StringAtom::id_type id) noexcept {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        return _entries[id];
+    }
+
+    StringAtom::id_type size() noexcept {
+        std::lock_guard<std::mutex> guard(_lock);
+
+        return static_cast<StringAtom::id_type>(_entries.size() - 1);
+    }
+
+private:
+
+    static constexpr size_t kInitialBuckets = 1024;  // Must be a power of two.
+
+    size_t findSlot(StringView view, uint64 hash) const noexcept {
+        const auto mask = _buckets.size() - 1;
+
+        auto slot = hash & mask;
+        while (_buckets[slot] != 0) {
+            auto const& e = _entries[_buckets[slot]];
+            if (e.hash == hash && e.str.equals(view)) {
+                break;
+            }
+
+            slot = (slot + 1) & mask;
+        }
+
+        return slot;
+    }
+
+    void rehash() {
+        std::vector<StringAtom::id_type> old;
+        old.swap(_buckets);
+        _buckets.resize(old.size() * 2, 0);
+
+        const auto mask = _buckets.size() - 1;
+        for (auto id : old) {
+            if (id == 0) {
+                continue;
+            }
+
+            auto slot = _entries[id].hash & mask;
+            while (_buckets[slot] != 0) {
+                slot = (slot + 1) & mask;
+            }
+            _buckets[slot] = id;
+        }
+    }
+
+private:
+
+    std::mutex          _lock;
+
+    /// Entry store; entry 0 is the empty string.
+    std::deque<Entry>   _entries;
+
+    /// Open-addressing index into _entries; 0 means an empty slot.
+    std::vector<StringAtom::id_type> _buckets;
+};
+
+
+InternTable& table() {
+    static InternTable instance;
+
+    return instance;
+}
+
+}  // namespace
+
+
+StringAtom
+StringAtom::intern(StringView view) {
+    return StringAtom{table().intern(view)};
+}
+
+
+StringAtom::id_type
+StringAtom::internedCount() noexcept {
+    return table().size();
+}
+
+
+StringView
+StringAtom::view() const noexcept {
+    return table().entryOf(_id).str.view();
+}
+
+
+uint64
+StringAtom::hashCode() const noexcept {
+    return table().entryOf(_id).hash;
+}
@@ -25,6 +25,7 @@
 #include "solace/exception.hpp"
 
 #include "solace/readBuffer.hpp"
+#include "solace/details/decimalFormat.hpp"
 
 using namespace Solace;
 
@@ -42,7 +43,47 @@ StringBuilder::StringBuilder(MemoryBuffer&& buffer, StringView str)
     _buffer.write(str.view());
 }
 
+StringBuilder::StringBuilder(MemoryManager& allocator, size_type initialCapacity) :
+    _buffer(allocator.create(initialCapacity)),
+    _allocator(&allocator)
+{
+}
+
+
+StringBuilder&
+StringBuilder::reserve(size_type newCapacity) {
+    if (newCapacity <= _buffer.capacity())
+        return *this;
+
+    if (_allocator == nullptr) {
+        raise<OverflowException>("StringBuilder::reserve", newCapacity, 0, _buffer.capacity());
+    }
+
+    auto newStorage = _allocator->create(newCapacity);
+    WriteBuffer grown(std::move(newStorage));
+    grown.write(_buffer.viewWritten());
+
+    _buffer = std::move(grown);
+
+    return *this;
+}
+
+
+void StringBuilder::ensureRoomFor(size_type appendSize) {
+    if (appendSize <= _buffer.remaining() || _allocator == nullptr)
+        return;
+
+    auto newCapacity = (_buffer.capacity() > 0) ? _buffer.capacity() : appendSize;
+    while (newCapacity < _buffer.position() + appendSize) {
+        newCapacity *= 2;
+    }
+
+    reserve(newCapacity);
+}
+
+
 StringBuilder& StringBuilder::append(char c) {
+    ensureRoomFor(1);
     _buffer.write(c);
 
 	return *this;
@@ -53,11 +94,50 @@ StringBuilder& StringBuilder::append(Char c) {
 }
 
 StringBuilder& StringBuilder::append(StringView cstr) {
+    ensureRoomFor(cstr.size());
     _buffer.write(cstr.view());
 
 	return *this;
 }
 
+
+StringBuilder::size_type
+StringBuilder::capacity() const noexcept {
+    return _buffer.capacity();
+}
+
+
+StringBuilder& StringBuilder::append(uint64 value) {
+    char scratch[details::kMaxDecimalDigits];
+    const auto pos = details::formatDecimal(value, scratch);
+
+    return append(StringView{scratch + pos,
+                             static_cast<size_type>(details::kMaxDecimalDigits - pos)});
+}
+
+
+StringBuilder& StringBuilder::append(int64 value) {
+    char scratch[details::kMaxDecimalDigits + 1];
+    auto pos = details::formatDecimal((value < 0)
+                                      ? ~static_cast<uint64>(value) + 1
+                                      : static_cast<uint64>(value),
+                                      scratch + 1) + 1;
+    if (value < 0) {
+        scratch[--pos] = '-';
+    }
+
+    return append(StringView{scratch + pos,
+                             static_cast<size_type>(details::kMaxDecimalDigits + 1 - pos)});
+}
+
+
+StringBuilder& StringBuilder::append(float64 value) {
+    char scratch[32];
+    const auto len = details::formatShortestFloat(value, scratch);
+
+    return append(StringView{scratch, static_cast<size_type>(len)});
+}
+
 StringView
 StringBuilder::view() const noexcept {
     return StringView(_buffer.viewWritten().dataAs<const char>(), _buffer.position());
@@ -73,6 +153,16 @@ StringBuilder::toString() const {
     return StringView{written.dataAs<char>(), static_cast<size_type>(written.size())};
 }
 
+
+String
+StringBuilder::takeString() {
+    const auto contentSize = static_cast<size_type>(_buffer.position());
+    if (contentSize == 0)
+        return String::Empty;
+
+    return String::adopt(_buffer.moveStorage(), contentSize);
+}
+
 bool StringBuilder::empty() const {
     return (_buffer.position() == 0);
 }
@@ -18,31 +18,172 @@
  *	@brief		Implementation of string view class.
  ******************************************************************************/
 #include "solace/stringView.hpp"
+#include "solace/exception.hpp"
 
 #include <cstring>  // strlen
 #include <regex>
 
+#if defined(__SSE2__)
+#include <emmintrin.h>  // SSE2 substring scan kernel
+#endif
+
 
 using namespace Solace;
 
 
-StringView::StringView(const char* data) :
-    StringView(assertNotNull(data), data ? strlen(data) : 0)
-{
+namespace /* anonymous */ {
+
+/** Find the first occurrence of a needle in [haystack, haystack + haystackSize).
+ * Precondition: needleSize >= 1 and needleSize <= haystackSize.
+ * @return A pointer to the first match or nullptr if there is none.
+ */
+const char*
+findSubstring(char const* haystack, size_t haystackSize, char const* needle, size_t needleSize) noexcept {
+    if (needleSize == 1) {
+        return static_cast<char const*>(memchr(haystack, needle[0], haystackSize));
+    }
+
+    const size_t scanSize = haystackSize - needleSize + 1;
+
+#if defined(__SSE2__)
+    // Wide scan: compare 16 positions at a time against the first and last bytes of
+    // the needle and only run the full memcmp where both match. This filters out
+    // nearly all positions without ever leaving the vector unit.
+    const __m128i first = _mm_set1_epi8(needle[0]);
+    const __m128i last = _mm_set1_epi8(needle[needleSize - 1]);
+
+    size_t i = 0;
+    for (; i + 16 <= scanSize; i += 16) {
+        const __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<__m128i const*>(haystack + i));
+        const __m128i blockLast =
+                _mm_loadu_si128(reinterpret_cast<__m128i const*>(haystack + i + needleSize - 1));
+
+        auto mask = static_cast<uint32>(_mm_movemask_epi8(
+                _mm_and_si128(_mm_cmpeq_epi8(first, blockFirst), _mm_cmpeq_epi8(last, blockLast))));
+
+        while (mask != 0) {
+            const auto bit = static_cast<uint32>(__builtin_ctz(mask));
+            if (memcmp(haystack + i + bit + 1, needle + 1, needleSize - 2) == 0) {
+                return haystack + i + bit;
+            }
+            mask &= (mask - 1);
+        }
+    }
+
+    haystack += i;
+    haystackSize -= i;
+#endif  // __SSE2__
+
+    // Scalar tail (and the whole scan on targets with no vector unit):
+    // memchr / memcmp map onto whatever SIMD the libc was built with.
+    const char* const end = haystack + haystackSize;
+    while (static_cast<size_t>(end - haystack) >= needleSize) {
+        const char* candidate =
+                static_cast<char const*>(memchr(haystack, needle[0], (end - haystack) - needleSize + 1));
+        if (candidate == nullptr) {
+            return nullptr;
+        }
+
+        if (memcmp(candidate + 1, needle + 1, needleSize - 1) == 0) {
+            return candidate;
+        }
+
+        haystack = candidate + 1;
+    }
+
+    return nullptr;
+}
+
+/** True for the six ASCII whitespace characters recognised by isspace() in the C locale. */
+constexpr bool isAsciiWhitespace(char c) noexcept {
+    return (c == ' ') || (static_cast<Solace::byte>(c - '\t') < 5);  // \t \n \v \f \r
+}
+
+#if defined(__SSE2__)
+
+/** Whitespace classification of 16 bytes at once: bit i of the result is set
+ * if p[i] is ASCII whitespace. */
+inline uint32 whitespaceMask16(char const* p) noexcept {
+    const __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(p));
+
+    const __m128i isSpace = _mm_cmpeq_epi8(block, _mm_set1_epi8(' '));
+    const __m128i inTabRange = _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8('\t' - 1)),
+                                             _mm_cmplt_epi8(block, _mm_set1_epi8('\r' + 1)));
+
+    return static_cast<uint32>(_mm_movemask_epi8(_mm_or_si128(isSpace, inTabRange)));
+}
+
+#endif  // __SSE2__
+
+/** Copy size bytes from src to dst flipping the case bit of every byte in
+ * [rangeFirst, rangeFirst + 26). Aliasing src == dst is fine.
+ */
+void convertCase(char const* src, char* dst, size_t size, char rangeFirst) noexcept {
+#if defined(__SSE2__)
+    // Signed byte compares treat anything >= 0x80 as negative, which conveniently
+    // leaves UTF-8 multi-byte sequences outside of the letter range.
+    const __m128i beforeFirst = _mm_set1_epi8(rangeFirst - 1);
+    const __m128i afterLast = _mm_set1_epi8(rangeFirst + 26);
+    const __m128i caseBit = _mm_set1_epi8(0x20);
+
+    size_t i = 0;
+    for (; i + 16 <= size; i += 16) {
+        const __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(src + i));
+        const __m128i isLetter = _mm_and_si128(_mm_cmpgt_epi8(block, beforeFirst),
+                                               _mm_cmplt_epi8(block, afterLast));
+
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i),
+                         _mm_xor_si128(block, _mm_and_si128(isLetter, caseBit)));
+    }
+
+    src += i;
+    dst += i;
+    size -= i;
+#endif  // __SSE2__
+
+    for (; size != 0; --size, ++src, ++dst) {
+        const auto c = *src;
+        *dst = (static_cast<Solace::byte>(c - rangeFirst) < 26)
+                ? static_cast<char>(c ^ 0x20)
+                : c;
+    }
+}
+
+}  // namespace
+
+
+StringView::size_type
+StringView::raiseNullString() {
+    assertNotNull(static_cast<char const*>(nullptr));
+
+    return 0;  // Unreachable: assertNotNull throws on null.
 }
 
 
 bool
-StringView::equals(StringView str) const noexcept {
-    if (size() != str.size())
-        return false;
+StringView::equalsSlow(StringView str) const noexcept {
+    // Callers have established equal sizes and a matching first word;
+    // only the remainder needs a look.
+    return (memcmp(_data + sizeof(uint64),
+                   str._data + sizeof(uint64),
+                   size() - sizeof(uint64)) == 0);
+}
+
 
-    for (size_type i = 0; i < size(); ++i) {
-        if (_data[i] != str._data[i])
-            return false;
+int
+StringView::compareSlow(StringView other) const noexcept {
+    const auto sharedSize = (size() < other.size()) ? size() : other.size();
+    const auto order = (sharedSize != 0)
+            ? memcmp(_data, other._data, sharedSize)
+            : 0;
+
+    if (order != 0) {
+        return order;
     }
 
-    return true;
+    return (size() < other.size())
+            ? -1
+            : (size() > other.size()) ? 1 : 0;
 }
 
 
@@ -65,17 +206,26 @@ StringView::substring(size_type from, size_type len) const {
 }
 
 
+StringView::size_type
+StringView::spanOfClass(uint16 classMask, size_type fromIndex) const noexcept {
+    size_type i = fromIndex;
+    while (i < size() && (Char::categoryOf(static_cast<byte>(_data[i])) & classMask) != 0) {
+        ++i;
+    }
+
+    return i - fromIndex;
+}
+
+
 Optional<StringView::size_type>
 StringView::indexOf(const value_type& ch, size_type fromIndex) const {
     assertIndexInRange(fromIndex,  0,  size() + 1, "StringView::indexOf() const");
 
-    for (; fromIndex < size(); ++fromIndex) {
-        if (_data[fromIndex] == ch) {
-            return Optional<size_type>(fromIndex);
-        }
-    }
+    const auto* match = static_cast<char const*>(memchr(_data + fromIndex, ch, size() - fromIndex));
 
-    return none;
+    return (match != nullptr)
+            ? Optional<size_type>(static_cast<size_type>(match - _data))
+            : none;
 }
 
 Optional<StringView::size_type>
@@ -86,14 +236,21 @@ StringView::indexOf(const StringView& str, size_type fromIndex) const {
         return none;
     }
 
-    for (; fromIndex + str.size() < size() + 1; ++fromIndex) {
-        if (_data[fromIndex] == str._data[0] &&
-            substring(fromIndex, str.length()) == str) {
-            return Optional<size_type>(fromIndex);
-        }
+    if (str.empty()) {
+        return (fromIndex <= size())
+                ? Optional<size_type>(fromIndex)
+                : none;
+    }
+
+    if (fromIndex + str.size() > size()) {
+        return none;
     }
 
-    return none;
+    const auto* match = findSubstring(_data + fromIndex, size() - fromIndex, str._data, str.size());
+
+    return (match != nullptr)
+            ? Optional<size_type>(static_cast<size_type>(match - _data))
+            : none;
 }
 
 
@@ -138,8 +295,7 @@ StringView::startsWith(StringView prefix) const noexcept {
         return false;
     }
 
-//    return strncmp(_data, str._data, str.size()) == 0;
-    return (substring(0, prefix.length()) == prefix);
+    return (memcmp(_data, prefix._data, prefix.size()) == 0);
 }
 
 
@@ -149,21 +305,32 @@ StringView::endsWith(StringView suffix) const noexcept {
         return false;
     }
 
-//    return strncmp(_data + (size() - str.size()), str._data, str.size());
-    return (substring(size() - suffix.size(), suffix.length()) == suffix);
+    return (memcmp(_data + (size() - suffix.size()), suffix._data, suffix.size()) == 0);
 }
 
 
 StringView
 StringView::trim() const {
     size_type fromIndex = 0;
+    size_type toIndex = length();
 
-    while (fromIndex < length() && Char::isWhitespace(_data[fromIndex])) {
+#if defined(__SSE2__)
+    // Skip whole blocks of whitespace at both ends; the scalar loops below
+    // finish off whatever partial block the scan stopped in.
+    while (fromIndex + 16 <= toIndex && whitespaceMask16(_data + fromIndex) == 0xFFFF) {
+        fromIndex += 16;
+    }
+
+    while (toIndex >= fromIndex + 1 + 16 && whitespaceMask16(_data + toIndex - 16) == 0xFFFF) {
+        toIndex -= 16;
+    }
+#endif  // __SSE2__
+
+    while (fromIndex < toIndex && isAsciiWhitespace(_data[fromIndex])) {
         ++fromIndex;
     }
 
-    size_type toIndex = length();
-    while (fromIndex + 1 < toIndex && Char::isWhitespace(_data[toIndex - 1])) {
+    while (fromIndex + 1 < toIndex && isAsciiWhitespace(_data[toIndex - 1])) {
         --toIndex;
     }
 
@@ -171,15 +338,27 @@ StringView::trim() const {
 }
 
 
-uint64
-StringView::hashCode() const noexcept {
-    uint64 result = 0;
-    const uint64 prime = 31;
-    for (size_t i = 0; i < _size; ++i) {
-        result = _data[i] + (result * prime);
+StringView
+StringView::toLowerCase(MemoryView dest) const {
+    if (dest.size() < size()) {
+        raise<OverflowException>("dest", dest.size(), 0, size());
     }
 
-    return result;
+    convertCase(_data, dest.dataAs<char>(), size(), 'A');
+
+    return {dest.dataAs<char>(), size()};
+}
+
+
+StringView
+StringView::toUpperCase(MemoryView dest) const {
+    if (dest.size() < size()) {
+        raise<OverflowException>("dest", dest.size(), 0, size());
+    }
+
+    convertCase(_data, dest.dataAs<char>(), size(), 'a');
+
+    return {dest.dataAs<char>(), size()};
 }
 
 
@@ -0,0 +1,145 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		telemetry.cpp
+ *	@brief		Per-thread telemetry counters and snapshot aggregation
+ ******************************************************************************/
+#include "solace/telemetry.hpp"
+
+#include <cstring>
+
+#if defined(SOLACE_ENABLE_TELEMETRY)
+#include <cstdlib>
+#include <mutex>
+#include <new>
+#endif
+
+
+using namespace Solace;
+using namespace Solace::Telemetry;
+
+
+const char*
+Solace::Telemetry::probeName(Probe probe) noexcept {
+    switch (probe) {
+    case Probe::MemoryManagerAllocBytes:    return "memoryManager.alloc.bytes";
+    case Probe::MemoryManagerAllocCycles:   return "memoryManager.alloc.cycles";
+    case Probe::MemoryManagerFreeBytes:     return "memoryManager.free.bytes";
+    case Probe::SelectorPollBatch:          return "selector.poll.batch";
+    case Probe::ByteBufferWriteBytes:       return "byteBuffer.write.bytes";
+    }
+
+    return "unknown";
+}
+
+
+#if defined(SOLACE_ENABLE_TELEMETRY)
+
+namespace {
+
+/// One probe's counters, padded so threads never share a cache line.
+struct alignas(64) ProbeSlot {
+    uint64 count {0};
+    uint64 sum {0};
+    uint64 histogram[kHistogramBuckets] {};
+};
+
+
+/** All probe slots of one thread. Registered on first use and deliberately
+ * never freed: a snapshot must be able to include the totals of threads
+ * that have already exited.
+ */
+struct ThreadSlots {
+    ProbeSlot       probes[kProbeCount];
+    ThreadSlots*    next {nullptr};
+};
+
+
+std::mutex registryLock;
+ThreadSlots* registryHead = nullptr;
+
+
+ThreadSlots& localSlots() {
+    static thread_local ThreadSlots* slots = []() {
+        // C++14 operator new does not honour extended alignment, thus posix_memalign.
+        void* raw = nullptr;
+        if (posix_memalign(&raw, alignof(ThreadSlots), sizeof(ThreadSlots)) != 0) {
+            abort();
+        }
+        auto* fresh = new (raw) ThreadSlots;
+
+        std::lock_guard<std::mutex> lock(registryLock);
+        fresh->next = registryHead;
+        registryHead = fresh;
+
+        return fresh;
+    }();
+
+    return *slots;
+}
+
+
+inline uint32 bucketOf(uint64 value) noexcept {
+    return 63u - static_cast<uint32>(__builtin_clzll(value | 1));
+}
+
+}  // namespace
+
+
+void
+Solace::Telemetry::record(Probe probe, uint64 value) noexcept {
+    auto& slot = localSlots().probes[static_cast<uint32>(probe)];
+
+    slot.count += 1;
+    slot.sum += value;
+    slot.histogram[bucketOf(value)] += 1;
+}
+
+
+Snapshot
+Solace::Telemetry::takeSnapshot() noexcept {
+    Snapshot snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+
+    std::lock_guard<std::mutex> lock(registryLock);
+    for (const auto* slots = registryHead; slots; slots = slots->next) {
+        for (uint32 p = 0; p < kProbeCount; ++p) {
+            auto& total = snapshot.probes[p];
+            const auto& slot = slots->probes[p];
+
+            total.count += slot.count;
+            total.sum += slot.sum;
+            for (uint32 b = 0; b < kHistogramBuckets; ++b) {
+                total.histogram[b] += slot.histogram[b];
+            }
+        }
+    }
+
+    return snapshot;
+}
+
+#else  // Telemetry compiled out: the snapshot API still links, reporting zeroes.
+
+Snapshot
+Solace::Telemetry::takeSnapshot() noexcept {
+    Snapshot snapshot;
+    memset(&snapshot, 0, sizeof(snapshot));
+
+    return snapshot;
+}
+
+#endif  // SOLACE_ENABLE_TELEMETRY
@@ -0,0 +1,198 @@
+/*
+*  Copyright 2017 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace
+ *	@file		timestamp.cpp
+ *	@author		$LastChangedBy: soultaker $
+ *	@date		$LastChangedDate$
+ *	@brief		Implementation of the clock and timestamp formatting
+ *	ID:			$Id$
+ ******************************************************************************/
+#include "solace/timestamp.hpp"
+#include "solace/writeBuffer.hpp"
+#include "solace/stringBuilder.hpp"
+#include "solace/memoryView.hpp"
+
+#include <atomic>
+
+#include <time.h>
+
+
+using namespace Solace;
+
+
+namespace /* anonymous */ {
+
+Timestamp readClock(clockid_t clockId) noexcept {
+    timespec ts;
+    clock_gettime(clockId, &ts);
+
+    return Timestamp{static_cast<int64>(ts.tv_sec) * Timestamp::NanosInSecond + ts.tv_nsec};
+}
+
+
+inline uint64 readCycleCounter() noexcept {
+#if defined(__x86_64__) || defined(__i386__)
+    return __builtin_ia32_rdtsc();
+#else
+    return 0;
+#endif
+}
+
+
+/**
+ * An anchor tying a cycle counter reading to a realtime reading, plus the
+ * measured counter rate. Published as an immutable block through an atomic
+ * pointer so the fast path never takes a lock; the block from a previous
+ * calibration is deliberately leaked on recalibration - it is tiny, rare,
+ * and a reader may still hold it.
+ */
+struct Calibration {
+    uint64  baseCycles;
+    int64   baseNanos;
+    double  nanosPerCycle;
+};
+
+std::atomic<Calibration*> calibration{nullptr};
+
+
+Calibration* calibrate() noexcept {
+    const auto cycles0 = readCycleCounter();
+    const auto nanos0 = readClock(CLOCK_REALTIME);
+
+    // A millisecond window keeps the frequency estimate within a few ppm:
+    timespec window{0, 1000000};
+    nanosleep(&window, nullptr);
+
+    const auto cycles1 = readCycleCounter();
+    const auto nanos1 = readClock(CLOCK_REALTIME);
+
+    auto* fresh = new Calibration;
+    fresh->baseCycles = cycles1;
+    fresh->baseNanos = nanos1.nanos;
+    fresh->nanosPerCycle = (cycles1 > cycles0)
+            ? static_cast<double>(nanos1.nanos - nanos0.nanos) / static_cast<double>(cycles1 - cycles0)
+            : 0.0;
+
+    calibration.store(fresh, std::memory_order_release);
+
+    return fresh;
+}
+
+
+void putDigits(char* dest, uint32 value, uint32 width) noexcept {
+    for (uint32 i = width; i > 0; --i) {
+        dest[i - 1] = static_cast<char>('0' + (value % 10));
+        value /= 10;
+    }
+}
+
+
+/**
+ * Render the timestamp into exactly Timestamp::Iso8601Size characters.
+ * Date math follows the days-from-civil inverse (public domain algorithm):
+ * no table lookups, no locale, no allocation.
+ */
+void renderIso8601(Timestamp time, char* out) noexcept {
+    auto secs = time.seconds();
+    auto nanos = time.nanosOfSecond();
+    if (nanos < 0) {  // Flooring for pre-epoch times.
+        nanos += Timestamp::NanosInSecond;
+        secs -= 1;
+    }
+
+    auto days = secs / 86400;
+    auto secondOfDay = secs - days * 86400;
+    if (secondOfDay < 0) {
+        secondOfDay += 86400;
+        days -= 1;
+    }
+
+    const auto z = days + 719468;
+    const auto era = (z >= 0 ? z : z - 146096) / 146097;
+    const auto dayOfEra = z - era * 146097;                                             // [0, 146096]
+    const auto yearOfEra = (dayOfEra - dayOfEra/1460 + dayOfEra/36524 - dayOfEra/146096) / 365;
+    const auto dayOfYear = dayOfEra - (365*yearOfEra + yearOfEra/4 - yearOfEra/100);    // [0, 365]
+    const auto mp = (5*dayOfYear + 2) / 153;                                            // [0, 11]
+    const auto day = dayOfYear - (153*mp + 2)/5 + 1;
+    const auto month = mp + (mp < 10 ? 3 : -9);
+    const auto year = yearOfEra + era * 400 + (month <= 2 ? 1 : 0);
+
+    putDigits(out + 0, static_cast<uint32>(year), 4);
+    out[4] = '-';
+    putDigits(out + 5, static_cast<uint32>(month), 2);
+    out[7] = '-';
+    putDigits(out + 8, static_cast<uint32>(day), 2);
+    out[10] = 'T';
+    putDigits(out + 11, static_cast<uint32>(secondOfDay / 3600), 2);
+    out[13] = ':';
+    putDigits(out + 14, static_cast<uint32>((secondOfDay / 60) % 60), 2);
+    out[16] = ':';
+    putDigits(out + 17, static_cast<uint32>(secondOfDay % 60), 2);
+    out[19] = '.';
+    putDigits(out + 20, static_cast<uint32>(nanos), 9);
+    out[29] = 'Z';
+}
+
+}  // namespace
+
+
+Result<void, Error>
+Timestamp::formatIso8601(WriteBuffer& dest) const {
+    char text[Iso8601Size];
+    renderIso8601(*this, text);
+
+    return dest.write(wrapMemory(text, Iso8601Size));
+}
+
+
+void Timestamp::formatIso8601(StringBuilder& dest) const {
+    char text[Iso8601Size];
+    renderIso8601(*this, text);
+
+    dest.append(StringView(text, Iso8601Size));
+}
+
+
+Timestamp Clock::realtime() noexcept {
+    return readClock(CLOCK_REALTIME);
+}
+
+
+Timestamp Clock::monotonic() noexcept {
+    return readClock(CLOCK_MONOTONIC);
+}
+
+
+Timestamp Clock::now() noexcept {
+    auto* anchor = calibration.load(std::memory_order_acquire);
+    if (!anchor) {
+        anchor = calibrate();
+    }
+
+    if (anchor->nanosPerCycle <= 0.0) {  // No usable cycle counter on this platform.
+        return realtime();
+    }
+
+    const auto elapsed = readCycleCounter() - anchor->baseCycles;
+
+    return Timestamp{anchor->baseNanos + static_cast<int64>(elapsed * anchor->nanosPerCycle)};
+}
+
+
+void Clock::recalibrate() noexcept {
+    calibrate();
+}
@@ -0,0 +1,378 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ *	@file		solace/unicode.cpp
+ *	@brief		Implementation of the fused validate-and-convert kernels.
+ ******************************************************************************/
+#include "solace/unicode.hpp"
+
+#include <cstring>  // memcpy
+
+#if defined(__SSE2__)
+#include <emmintrin.h>  // ASCII fast paths
+#endif
+
+
+using namespace Solace;
+using namespace Solace::unicode;
+
+
+namespace /* anonymous */ {
+
+constexpr uint32 kMaxCodePoint = 0x10FFFF;
+
+constexpr bool isContinuation(byte b) noexcept {
+    return ((b & 0xC0) == 0x80);
+}
+
+constexpr bool isSurrogate(uint32 codePoint) noexcept {
+    return (codePoint >= 0xD800 && codePoint <= 0xDFFF);
+}
+
+
+struct Decoded {
+    uint32 length;      //!< Bytes consumed; 0 for a malformed sequence.
+    uint32 codePoint;
+};
+
+/** Validate and decode one UTF-8 sequence starting at data[i] in one go.
+ * Precondition: data[i] >= 0x80.
+ */
+Decoded decodeUtf8(byte const* data, size_t i, size_t size) noexcept {
+    const byte lead = data[i];
+
+    if ((lead & 0xE0) == 0xC0) {                            // 2 bytes: U+0080..U+07FF
+        if (lead < 0xC2 ||                                  // C0 / C1 are always overlong
+            i + 1 >= size || !isContinuation(data[i + 1])) {
+            return {0, 0};
+        }
+
+        return {2, (static_cast<uint32>(lead & 0x1F) << 6)
+                    | static_cast<uint32>(data[i + 1] & 0x3F)};
+    }
+
+    if ((lead & 0xF0) == 0xE0) {                            // 3 bytes: U+0800..U+FFFF
+        if (i + 2 >= size || !isContinuation(data[i + 1]) || !isContinuation(data[i + 2])) {
+            return {0, 0};
+        }
+
+        if (lead == 0xE0 && data[i + 1] < 0xA0) {           // Overlong
+            return {0, 0};
+        }
+
+        if (lead == 0xED && data[i + 1] > 0x9F) {           // Surrogate range U+D800..U+DFFF
+            return {0, 0};
+        }
+
+        return {3, (static_cast<uint32>(lead & 0x0F) << 12)
+                    | (static_cast<uint32>(data[i + 1] & 0x3F) << 6)
+                    | static_cast<uint32>(data[i + 2] & 0x3F)};
+    }
+
+    if ((lead & 0xF8) == 0xF0) {                            // 4 bytes: U+10000..U+10FFFF
+        if (lead > 0xF4 ||                                  // Above U+10FFFF
+            i + 3 >= size ||
+            !isContinuation(data[i + 1]) || !isContinuation(data[i + 2]) || !isContinuation(data[i + 3])) {
+            return {0, 0};
+        }
+
+        if (lead == 0xF0 && data[i + 1] < 0x90) {           // Overlong
+            return {0, 0};
+        }
+
+        if (lead == 0xF4 && data[i + 1] > 0x8F) {           // Above U+10FFFF
+            return {0, 0};
+        }
+
+        return {4, (static_cast<uint32>(lead & 0x07) << 18)
+                    | (static_cast<uint32>(data[i + 1] & 0x3F) << 12)
+                    | (static_cast<uint32>(data[i + 2] & 0x3F) << 6)
+                    | static_cast<uint32>(data[i + 3] & 0x3F)};
+    }
+
+    return {0, 0};                                          // Stray continuation or F8..FF
+}
+
+
+/** Encode one code point as UTF-8 into dest + out.
+ * Precondition: the code point is valid and dest has room for utf8LengthOf() bytes.
+ * @return Number of bytes written.
+ */
+uint32 encodeUtf8(uint32 codePoint, byte* dest) noexcept {
+    if (codePoint < 0x80) {
+        dest[0] = static_cast<byte>(codePoint);
+        return 1;
+    }
+
+    if (codePoint < 0x800) {
+        dest[0] = static_cast<byte>(0xC0 | (codePoint >> 6));
+        dest[1] = static_cast<byte>(0x80 | (codePoint & 0x3F));
+        return 2;
+    }
+
+    if (codePoint < 0x10000) {
+        dest[0] = static_cast<byte>(0xE0 | (codePoint >> 12));
+        dest[1] = static_cast<byte>(0x80 | ((codePoint >> 6) & 0x3F));
+        dest[2] = static_cast<byte>(0x80 | (codePoint & 0x3F));
+        return 3;
+    }
+
+    dest[0] = static_cast<byte>(0xF0 | (codePoint >> 18));
+    dest[1] = static_cast<byte>(0x80 | ((codePoint >> 12) & 0x3F));
+    dest[2] = static_cast<byte>(0x80 | ((codePoint >> 6) & 0x3F));
+    dest[3] = static_cast<byte>(0x80 | (codePoint & 0x3F));
+    return 4;
+}
+
+constexpr uint32 utf8LengthOf(uint32 codePoint) noexcept {
+    return (codePoint < 0x80) ? 1
+            : (codePoint < 0x800) ? 2
+            : (codePoint < 0x10000) ? 3
+            : 4;
+}
+
+}  // namespace
+
+
+Result<Solace::unicode::size_type, Error>
+Solace::unicode::utf8ToUtf16(ImmutableMemoryView src, MemoryView dest) noexcept {
+    auto const* data = src.dataAddress();
+    auto* out = dest.dataAddress();
+    const size_t size = src.size();
+    const size_t room = dest.size();
+
+    size_t i = 0;
+    size_t written = 0;
+    while (i < size) {
+#if defined(__SSE2__)
+        // ASCII fast path: widen 16 bytes to 16 code units per iteration.
+        while (i + 16 <= size && written + 32 <= room) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+            if (_mm_movemask_epi8(block) != 0) {
+                break;
+            }
+
+            const __m128i zero = _mm_setzero_si128();
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written), _mm_unpacklo_epi8(block, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written + 16), _mm_unpackhi_epi8(block, zero));
+
+            i += 16;
+            written += 32;
+        }
+
+        if (i >= size) {
+            break;
+        }
+#endif  // __SSE2__
+
+        uint32 codePoint;
+        if (data[i] < 0x80) {
+            codePoint = data[i];
+            i += 1;
+        } else {
+            const auto decoded = decodeUtf8(data, i, size);
+            if (decoded.length == 0) {
+                return Err(Error("InvalidEncoding: malformed UTF-8 sequence"));
+            }
+
+            codePoint = decoded.codePoint;
+            i += decoded.length;
+        }
+
+        const size_t unitBytes = (codePoint >= 0x10000) ? 4 : 2;
+        if (written + unitBytes > room) {
+            return Err(Error("OverflowError: utf8ToUtf16(): destination buffer is too small"));
+        }
+
+        if (codePoint >= 0x10000) {
+            const uint32 offset = codePoint - 0x10000;
+            const uint16 units[2] = {
+                static_cast<uint16>(0xD800 | (offset >> 10)),
+                static_cast<uint16>(0xDC00 | (offset & 0x3FF))
+            };
+            memcpy(out + written, units, sizeof(units));
+        } else {
+            const auto unit = static_cast<uint16>(codePoint);
+            memcpy(out + written, &unit, sizeof(unit));
+        }
+
+        written += unitBytes;
+    }
+
+    return Ok(static_cast<size_type>(written));
+}
+
+
+Result<Solace::unicode::size_type, Error>
+Solace::unicode::utf16ToUtf8(ImmutableMemoryView src, MemoryView dest) noexcept {
+    if (src.size() % 2 != 0) {
+        return Err(Error("InvalidEncoding: UTF-16 input is not a whole number of code units"));
+    }
+
+    auto const* data = src.dataAddress();
+    auto* out = dest.dataAddress();
+    const size_t nbUnits = src.size() / 2;
+    const size_t room = dest.size();
+
+    size_t i = 0;
+    size_t written = 0;
+    while (i < nbUnits) {
+#if defined(__SSE2__)
+        // ASCII fast path: narrow 16 code units to 16 bytes per iteration.
+        while (i + 16 <= nbUnits && written + 16 <= room) {
+            const __m128i lo = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i * 2));
+            const __m128i hi = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i * 2 + 16));
+            const __m128i nonAscii = _mm_and_si128(_mm_or_si128(lo, hi),
+                                                   _mm_set1_epi16(static_cast<int16_t>(0xFF80)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi16(nonAscii, _mm_setzero_si128())) != 0xFFFF) {
+                break;
+            }
+
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written), _mm_packus_epi16(lo, hi));
+
+            i += 16;
+            written += 16;
+        }
+
+        if (i >= nbUnits) {
+            break;
+        }
+#endif  // __SSE2__
+
+        uint16 unit;
+        memcpy(&unit, data + i * 2, sizeof(unit));
+
+        uint32 codePoint = unit;
+        uint32 consumed = 1;
+        if (unit >= 0xD800 && unit <= 0xDBFF) {             // High surrogate: a pair must follow.
+            if (i + 1 >= nbUnits) {
+                return Err(Error("InvalidEncoding: unpaired UTF-16 surrogate"));
+            }
+
+            uint16 low;
+            memcpy(&low, data + (i + 1) * 2, sizeof(low));
+            if (low < 0xDC00 || low > 0xDFFF) {
+                return Err(Error("InvalidEncoding: unpaired UTF-16 surrogate"));
+            }
+
+            codePoint = 0x10000 + ((static_cast<uint32>(unit - 0xD800) << 10) | (low - 0xDC00));
+            consumed = 2;
+        } else if (unit >= 0xDC00 && unit <= 0xDFFF) {      // A low surrogate cannot lead.
+            return Err(Error("InvalidEncoding: unpaired UTF-16 surrogate"));
+        }
+
+        if (written + utf8LengthOf(codePoint) > room) {
+            return Err(Error("OverflowError: utf16ToUtf8(): destination buffer is too small"));
+        }
+
+        written += encodeUtf8(codePoint, out + written);
+        i += consumed;
+    }
+
+    return Ok(static_cast<size_type>(written));
+}
+
+
+Result<Solace::unicode::size_type, Error>
+Solace::unicode::utf8ToUtf32(ImmutableMemoryView src, MemoryView dest) noexcept {
+    auto const* data = src.dataAddress();
+    auto* out = dest.dataAddress();
+    const size_t size = src.size();
+    const size_t room = dest.size();
+
+    size_t i = 0;
+    size_t written = 0;
+    while (i < size) {
+#if defined(__SSE2__)
+        // ASCII fast path: widen 16 bytes to 16 code points per iteration.
+        while (i + 16 <= size && written + 64 <= room) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+            if (_mm_movemask_epi8(block) != 0) {
+                break;
+            }
+
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i lo16 = _mm_unpacklo_epi8(block, zero);
+            const __m128i hi16 = _mm_unpackhi_epi8(block, zero);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written),      _mm_unpacklo_epi16(lo16, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written + 16), _mm_unpackhi_epi16(lo16, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written + 32), _mm_unpacklo_epi16(hi16, zero));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(out + written + 48), _mm_unpackhi_epi16(hi16, zero));
+
+            i += 16;
+            written += 64;
+        }
+
+        if (i >= size) {
+            break;
+        }
+#endif  // __SSE2__
+
+        uint32 codePoint;
+        if (data[i] < 0x80) {
+            codePoint = data[i];
+            i += 1;
+        } else {
+            const auto decoded = decodeUtf8(data, i, size);
+            if (decoded.length == 0) {
+                return Err(Error("InvalidEncoding: malformed UTF-8 sequence"));
+            }
+
+            codePoint = decoded.codePoint;
+            i += decoded.length;
+        }
+
+        if (written + 4 > room) {
+            return Err(Error("OverflowError: utf8ToUtf32(): destination buffer is too small"));
+        }
+
+        memcpy(out + written, &codePoint, sizeof(codePoint));
+        written += 4;
+    }
+
+    return Ok(static_cast<size_type>(written));
+}
+
+
+Result<Solace::unicode::size_type, Error>
+Solace::unicode::utf32ToUtf8(ImmutableMemoryView src, MemoryView dest) noexcept {
+    if (src.size() % 4 != 0) {
+        return Err(Error("InvalidEncoding: UTF-32 input is not a whole number of code points"));
+    }
+
+    auto const* data = src.dataAddress();
+    auto* out = dest.dataAddress();
+    const size_t nbPoints = src.size() / 4;
+    const size_t room = dest.size();
+
+    size_t written = 0;
+    for (size_t i = 0; i < nbPoints; ++i) {
+        uint32 codePoint;
+        memcpy(&codePoint, data + i * 4, sizeof(codePoint));
+
+        if (codePoint > kMaxCodePoint || isSurrogate(codePoint)) {
+            return Err(Error("InvalidEncoding: invalid UTF-32 code point"));
+        }
+
+        if (written + utf8LengthOf(codePoint) > room) {
+            return Err(Error("OverflowError: utf32ToUtf8(): destination buffer is too small"));
+        }
+
+        written += encodeUtf8(codePoint, out + written);
+    }
+
+    return Ok(static_cast<size_type>(written));
+}
@@ -0,0 +1,175 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ *	@file		solace/utf8.cpp
+ *	@brief		Implementation of UTF-8 validation and iteration.
+ ******************************************************************************/
+#include "solace/utf8.hpp"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>  // ASCII fast path of the validator
+#endif
+
+
+using namespace Solace;
+
+
+namespace /* anonymous */ {
+
+constexpr Char::value_type kReplacementChar = 0xFFFD;
+
+constexpr bool isContinuation(byte b) noexcept {
+    return ((b & 0xC0) == 0x80);
+}
+
+/** Validate one multi-byte sequence starting at data[i].
+ * Precondition: data[i] >= 0x80.
+ *
+ * @return Length of the sequence in bytes, or 0 if it is malformed.
+ */
+uint32 validateSequence(byte const* data, size_t i, size_t size) noexcept {
+    const byte lead = data[i];
+
+    if ((lead & 0xE0) == 0xC0) {                            // 2 bytes: U+0080..U+07FF
+        if (lead < 0xC2 ||                                  // C0 / C1 are always overlong
+            i + 1 >= size || !isContinuation(data[i + 1])) {
+            return 0;
+        }
+
+        return 2;
+    }
+
+    if ((lead & 0xF0) == 0xE0) {                            // 3 bytes: U+0800..U+FFFF
+        if (i + 2 >= size || !isContinuation(data[i + 1]) || !isContinuation(data[i + 2])) {
+            return 0;
+        }
+
+        if (lead == 0xE0 && data[i + 1] < 0xA0) {           // Overlong
+            return 0;
+        }
+
+        if (lead == 0xED && data[i + 1] > 0x9F) {           // Surrogate range U+D800..U+DFFF
+            return 0;
+        }
+
+        return 3;
+    }
+
+    if ((lead & 0xF8) == 0xF0) {                            // 4 bytes: U+10000..U+10FFFF
+        if (lead > 0xF4 ||                                  // Above U+10FFFF
+            i + 3 >= size ||
+            !isContinuation(data[i + 1]) || !isContinuation(data[i + 2]) || !isContinuation(data[i + 3])) {
+            return 0;
+        }
+
+        if (lead == 0xF0 && data[i + 1] < 0x90) {           // Overlong
+            return 0;
+        }
+
+        if (lead == 0xF4 && data[i + 1] > 0x8F) {           // Above U+10FFFF
+            return 0;
+        }
+
+        return 4;
+    }
+
+    return 0;                                               // Stray continuation or F8..FF
+}
+
+}  // namespace
+
+
+bool
+Solace::isValidUtf8(StringView text) noexcept {
+    auto const* data = reinterpret_cast<byte const*>(text.data());
+    const size_t size = text.size();
+
+    size_t i = 0;
+    while (i < size) {
+#if defined(__SSE2__)
+        // ASCII fast path: most text is dominated by 7-bit runs, so test
+        // 16 bytes at a time for a set high bit and skip whole blocks of it.
+        while (i + 16 <= size) {
+            const __m128i block = _mm_loadu_si128(reinterpret_cast<__m128i const*>(data + i));
+            if (_mm_movemask_epi8(block) != 0) {
+                break;
+            }
+
+            i += 16;
+        }
+
+        if (i >= size) {
+            break;
+        }
+#endif  // __SSE2__
+
+        if (data[i] < 0x80) {
+            ++i;
+            continue;
+        }
+
+        const auto sequenceLength = validateSequence(data, i, size);
+        if (sequenceLength == 0) {
+            return false;
+        }
+
+        i += sequenceLength;
+    }
+
+    return true;
+}
+
+
+Char
+Utf8Cursor::next() noexcept {
+    auto const* data = reinterpret_cast<byte const*>(_text.data());
+    const size_t size = _text.size();
+    const size_t i = _offset;
+
+    const byte lead = data[i];
+    if (lead < 0x80) {
+        _offset += 1;
+
+        return Char(static_cast<Char::value_type>(lead));
+    }
+
+    const auto sequenceLength = validateSequence(data, i, size);
+    switch (sequenceLength) {
+    case 2:
+        _offset += 2;
+
+        return Char((static_cast<Char::value_type>(lead & 0x1F) << 6)
+                    | (data[i + 1] & 0x3F));
+    case 3:
+        _offset += 3;
+
+        return Char((static_cast<Char::value_type>(lead & 0x0F) << 12)
+                    | (static_cast<Char::value_type>(data[i + 1] & 0x3F) << 6)
+                    | (data[i + 2] & 0x3F));
+    case 4:
+        _offset += 4;
+
+        return Char((static_cast<Char::value_type>(lead & 0x07) << 18)
+                    | (static_cast<Char::value_type>(data[i + 1] & 0x3F) << 12)
+                    | (static_cast<Char::value_type>(data[i + 2] & 0x3F) << 6)
+                    | (data[i + 3] & 0x3F));
+    default:
+        // Malformed sequence: emit a replacement character and resync on the next byte.
+        _offset += 1;
+
+        return Char(kReplacementChar);
+    }
+}
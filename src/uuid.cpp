@@ -20,13 +20,16 @@
 
 #include "solace/uuid.hpp"
 #include "solace/exception.hpp"
-#include "solace/base16.hpp"
+#include "solace/byteBuffer.hpp"
 
 
 #include <cstring>  // memcmp (should review)
 #include <cstdlib>  // rand
 #include <ctime>    // time
 
+#include <fcntl.h>
+#include <unistd.h>
+
 
 using namespace Solace;
 
@@ -36,15 +39,143 @@ constexpr UUID::size_type UUID::StaticSize;
 constexpr UUID::size_type UUID::StringSize;
 
 
+namespace {
+
+/**
+ * A buffered system CSPRNG: /dev/urandom is read a page at a time and ids
+ * are carved out of the pool, so the per-id cost is a memcpy rather than a
+ * syscall. Falls back to rand() if the entropy device cannot be opened.
+ */
+class RandomPool {
+public:
+
+    ~RandomPool() {
+        if (_fd >= 0) {
+            ::close(_fd);
+        }
+    }
+
+    RandomPool() noexcept :
+        _fd(::open("/dev/urandom", O_RDONLY | O_CLOEXEC)),
+        _available(0)
+    {}
+
+    void fill(byte* dest, size_t len) noexcept {
+        while (len > 0) {
+            if (_available == 0 && !refill()) {
+                for (size_t i = 0; i < len; ++i) {
+                    dest[i] = static_cast<byte>(rand() % 255);
+                }
+
+                return;
+            }
+
+            const auto take = (len < _available) ? len : _available;
+            memcpy(dest, _pool + (sizeof(_pool) - _available), take);
+            _available -= take;
+            dest += take;
+            len -= take;
+        }
+    }
+
+private:
+
+    bool refill() noexcept {
+        if (_fd < 0) {
+            return false;
+        }
+
+        size_t got = 0;
+        while (got < sizeof(_pool)) {
+            const auto r = ::read(_fd, _pool + got, sizeof(_pool) - got);
+            if (r <= 0) {
+                return false;
+            }
+
+            got += static_cast<size_t>(r);
+        }
+
+        _available = sizeof(_pool);
+
+        return true;
+    }
+
+    int     _fd;
+    size_t  _available;
+    byte    _pool[4096];
+};
+
+
+RandomPool& randomPool() noexcept {
+    static RandomPool pool;
+
+    return pool;
+}
+
+}  // namespace
+
+
 UUID UUID::random() noexcept {
     return UUID();
 }
 
 
-UUID::UUID() noexcept {
-    for (auto& b : _bytes) {
-        b = static_cast<byte>(rand() % 255);
+void UUID::randomize(ArrayView<UUID> dest) noexcept {
+    auto& pool = randomPool();
+
+    for (auto& id : dest) {
+        pool.fill(id._bytes, StaticSize);
+
+        // Stamp version 4 and the RFC 4122 variant:
+        id._bytes[6] = static_cast<byte>((id._bytes[6] & 0x0F) | 0x40);
+        id._bytes[8] = static_cast<byte>((id._bytes[8] & 0x3F) | 0x80);
+    }
+}
+
+
+UUID UUID::timeOrdered() noexcept {
+    // Millisecond timestamp and tiebreak counter of the last id minted:
+    static uint64 lastMillis = 0;
+    static uint16 counter = 0;
+
+    timespec now;
+    clock_gettime(CLOCK_REALTIME, &now);
+    auto millis = static_cast<uint64>(now.tv_sec) * 1000 + static_cast<uint64>(now.tv_nsec) / 1000000;
+
+    if (millis > lastMillis) {
+        lastMillis = millis;
+        counter = 0;
+    } else {
+        // Same millisecond - or a clock step backwards - so take the next
+        // counter value; on counter exhaustion borrow a millisecond to keep
+        // the sequence strictly increasing.
+        if (++counter >= 0x1000) {
+            counter = 0;
+            ++lastMillis;
+        }
+        millis = lastMillis;
     }
+
+    UUID result;    // Random tail bytes come from the default constructor.
+
+    result._bytes[0] = static_cast<byte>(millis >> 40);
+    result._bytes[1] = static_cast<byte>(millis >> 32);
+    result._bytes[2] = static_cast<byte>(millis >> 24);
+    result._bytes[3] = static_cast<byte>(millis >> 16);
+    result._bytes[4] = static_cast<byte>(millis >> 8);
+    result._bytes[5] = static_cast<byte>(millis);
+    result._bytes[6] = static_cast<byte>(0x70 | ((counter >> 8) & 0x0F));
+    result._bytes[7] = static_cast<byte>(counter);
+
+    return result;
+}
+
+
+UUID::UUID() noexcept {
+    randomPool().fill(_bytes, StaticSize);
+
+    _bytes[6] = static_cast<byte>((_bytes[6] & 0x0F) | 0x40);
+    _bytes[8] = static_cast<byte>((_bytes[8] & 0x3F) | 0x80);
 }
 
 
@@ -138,32 +269,77 @@ MemoryView UUID::view() noexcept {
 }
 
 
+// Offset of every hex pair in the canonical 8-4-4-4-12 layout:
+static const byte kHexPairOffset[UUID::StaticSize] = {
+    0, 2, 4, 6, 9, 11, 14, 16, 19, 21, 24, 26, 28, 30, 32, 34
+};
+
+static const char kHexDigits[] = "0123456789abcdef";
+
+
+namespace {
+
+/** Hex digit values, with 0xFF poisoning every character not in the alphabet. */
+struct HexTable {
+    HexTable() noexcept {
+        memset(value, 0xFF, sizeof(value));
+
+        for (int i = 0; i < 10; ++i) {
+            value['0' + i] = static_cast<byte>(i);
+        }
+        for (int i = 0; i < 6; ++i) {
+            value['a' + i] = static_cast<byte>(10 + i);
+            value['A' + i] = static_cast<byte>(10 + i);
+        }
+    }
+
+    byte value[256];
+};
+
+
+const HexTable kHexTable;
+
+
+void formatCanonical(const byte* bytes, char* dest) {
+    for (UUID::size_type i = 0; i < UUID::StaticSize; ++i) {
+        const auto offset = kHexPairOffset[i];
+        dest[offset] = kHexDigits[bytes[i] >> 4];
+        dest[offset + 1] = kHexDigits[bytes[i] & 0x0F];
+    }
+
+    dest[8] = dest[13] = dest[18] = dest[23] = '-';
+}
+
+}  // namespace
+
+
 String UUID::toString() const {
     char buffer[StringSize];
-
-    WriteBuffer dest(wrapMemory(buffer));
-    Base16Encoder encoder(dest);
-
-    auto dataView = view();
-    // 123e4567-e89b-12d3-a456-426655440000
-    // 8-4-4-4-12
-    encoder.encode(dataView.slice(0,   4));
-    dest.write('-');
-    encoder.encode(dataView.slice(4,   6));
-    dest.write('-');
-    encoder.encode(dataView.slice(6,   8));
-    dest.write('-');
-    encoder.encode(dataView.slice(8,  10));
-    dest.write('-');
-    encoder.encode(dataView.slice(10, 16));
+    formatCanonical(_bytes, buffer);
 
     return String(buffer, StringSize);
 }
 
 
-// Here we are stealing a function from base16.cpp
-Result<byte, Error>
-charToBin(byte c);
+ByteBuffer& UUID::format(ByteBuffer& dest) const {
+    char buffer[StringSize];
+    formatCanonical(_bytes, buffer);
+
+    return dest.write(wrapMemory(buffer, StringSize));
+}
+
+
+Result<StringView, Error>
+UUID::formatInto(MemoryView dest) const noexcept {
+    if (dest.size() < StringSize) {
+        return Err(Error("UUID::formatInto: destination is too small"));
+    }
+
+    auto* text = dest.dataAs<char>();
+    formatCanonical(_bytes, text);
+
+    return Ok(StringView{text, StringSize});
+}
 
 
 Result<UUID, Error>
@@ -172,22 +348,26 @@ UUID::parse(StringView const& str) {
         return Err(Error("Not enough data"));
     }
 
-    byte data[StaticSize];
-    byte* dest = data;
     const char* src = str.data();
-    for (size_type i = 0; i < StringSize; ++i) {
-        if (src[i] != '-') {
-            auto high = charToBin(src[i]);
-            auto low =  charToBin(src[i + 1]);
-
-            if (!high)
-                return Err(Error(high.moveError()));
-            if (!low)
-                return Err(Error(low.moveError()));
-
-            *(dest++) = static_cast<byte>(high.unwrap() << 4) + static_cast<byte>(low.unwrap());
-            i += 1;
-        }
+    if (src[8] != '-' || src[13] != '-' || src[18] != '-' || src[23] != '-') {
+        return Err(Error("Invalid UUID format"));
+    }
+
+    // The layout is fixed, so every pair is read from its known offset and
+    // validity is checked once at the end off the accumulated poison bits:
+    byte data[StaticSize];
+    byte poison = 0;
+    for (size_type i = 0; i < StaticSize; ++i) {
+        const auto offset = kHexPairOffset[i];
+        const auto high = kHexTable.value[static_cast<byte>(src[offset])];
+        const auto low = kHexTable.value[static_cast<byte>(src[offset + 1])];
+
+        poison |= static_cast<byte>(high | low);
+        data[i] = static_cast<byte>((high << 4) | low);
+    }
+
+    if (poison & 0x80) {
+        return Err(Error("Invalid UUID format"));
     }
 
     return Ok(UUID(wrapMemory(data)));
@@ -24,6 +24,7 @@
 
 #include "solace/libsolace_config.hpp"		// Defines compile time version
 
+#include <algorithm>    // std::min/max
 #include <regex>
 
 
@@ -48,17 +49,21 @@ Version Solace::getBuildVersion() {
 }
 
 
-bool Version::operator > (const Version& rhv) const {
-    if (majorNumber > rhv.majorNumber) {
-        return true;
-    } else if (majorNumber < rhv.majorNumber) {
-        return false;
-    } else {
-        if (minorNumber > rhv.minorNumber) return true;
-        else if (minorNumber < rhv.minorNumber) return false;
-        else
-            return patchNumber > rhv.patchNumber;
+bool Version::operator > (const Version& rhv) const noexcept {
+    // The common case of in-range numeric versions orders as one integer:
+    if (SOLACE_LIKELY(isPackable() && rhv.isPackable())) {
+        return packed() > rhv.packed();
     }
+
+    if (majorNumber != rhv.majorNumber) {
+        return majorNumber > rhv.majorNumber;
+    }
+
+    if (minorNumber != rhv.minorNumber) {
+        return minorNumber > rhv.minorNumber;
+    }
+
+    return patchNumber > rhv.patchNumber;
 }
 
 
@@ -103,3 +108,111 @@ Version::parse(const Solace::StringView& str) {
 
     return Err(Error("Invalid format"));
 }
+
+
+Result<VersionRange, Error>
+VersionRange::parse(StringView const& value) {
+    uint64 lower = 0;
+    uint64 upper = ~uint64(0);
+
+    const char* p = value.begin();
+    const char* const end = value.end();
+
+    bool anyClause = false;
+    while (p != end) {
+        if (*p == ' ' || *p == '\t') {
+            ++p;
+            continue;
+        }
+
+        // Comparator, defaulting to exact match:
+        enum class Op { Ge, Gt, Le, Lt, Eq };
+        Op op = Op::Eq;
+        if (*p == '>') {
+            ++p;
+            if (p != end && *p == '=') {
+                op = Op::Ge;
+                ++p;
+            } else {
+                op = Op::Gt;
+            }
+        } else if (*p == '<') {
+            ++p;
+            if (p != end && *p == '=') {
+                op = Op::Le;
+                ++p;
+            } else {
+                op = Op::Lt;
+            }
+        } else if (*p == '=') {
+            ++p;
+        }
+
+        while (p != end && (*p == ' ' || *p == '\t')) {
+            ++p;
+        }
+
+        // Numeric version with missing components read as zero:
+        uint64 parts[3] = {0, 0, 0};
+        int part = 0;
+        bool hasDigits = false;
+        while (p != end) {
+            const char c = *p;
+            if (c >= '0' && c <= '9') {
+                parts[part] = parts[part] * 10 + static_cast<uint64>(c - '0');
+                if (parts[part] > 0xFFFFFFFF) {
+                    return Err(Error("Version component out of range"));
+                }
+                hasDigits = true;
+                ++p;
+            } else if (c == '.') {
+                if (!hasDigits || part == 2) {
+                    return Err(Error("Invalid version range format"));
+                }
+                ++part;
+                hasDigits = false;
+                ++p;
+            } else {
+                break;
+            }
+        }
+
+        if (!hasDigits) {
+            return Err(Error("Invalid version range format"));
+        }
+
+        if (parts[0] > 0xFFFF || parts[1] > 0xFFFF) {
+            return Err(Error("Version component out of range"));
+        }
+
+        // Intersect the clause into the packed bounds, both inclusive:
+        const auto packed = Version::pack(parts[0], parts[1], parts[2]);
+        switch (op) {
+        case Op::Ge: lower = std::max(lower, packed);       break;
+        case Op::Gt: lower = std::max(lower, packed + 1);   break;
+        case Op::Le: upper = std::min(upper, packed);       break;
+        case Op::Lt:
+            if (packed == 0) {
+                return Err(Error("Empty version range"));
+            }
+            upper = std::min(upper, packed - 1);
+            break;
+        case Op::Eq:
+            lower = std::max(lower, packed);
+            upper = std::min(upper, packed);
+            break;
+        }
+
+        anyClause = true;
+    }
+
+    if (!anyClause) {
+        return Err(Error("Invalid version range format"));
+    }
+
+    if (lower > upper) {
+        return Err(Error("Empty version range"));
+    }
+
+    return Ok(VersionRange(lower, upper));
+}
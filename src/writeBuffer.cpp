@@ -80,7 +80,11 @@ WriteBuffer::write(void const* data, size_type count) {
     }
 
     if (remaining() < count) {
-        return Err(Error("OverflowError: write(dest, size): destination buffer is too small"));
+        if (!_onOverflow) {
+            return Err(Error("OverflowError: write(dest, size): destination buffer is too small"));
+        }
+
+        return spill(reinterpret_cast<byte const*>(data), count);
     }
 
     auto const pos = position();
@@ -91,6 +95,48 @@ WriteBuffer::write(void const* data, size_type count) {
 }
 
 
+Result<void, Error>
+WriteBuffer::spill(byte const* data, size_type count) {
+    for (;;) {
+        auto const chunk = (remaining() < count) ? remaining() : count;
+        if (chunk != 0) {
+            memmove(_storage.view().dataAddress(_position), data, chunk);
+            _position += chunk;
+            data += chunk;
+            count -= chunk;
+        }
+
+        if (count == 0) {
+            return Ok();
+        }
+
+        auto next = _onOverflow(count);
+        if (next.isNone() || next.get().size() == 0) {
+            return Err(Error("OverflowError: write(dest, size): destination buffer is too small"));
+        }
+
+        // Retire the filled buffer into the chain and continue into the fresh one:
+        _chained += _position;
+        _chain.push_back(Chunk{std::move(_storage), _position});
+        _storage = next.move();
+        _position = 0;
+        _limit = _storage.size();
+    }
+}
+
+
+WriteBuffer const&
+WriteBuffer::forEachChunk(std::function<void(ImmutableMemoryView)> const& f) const {
+    for (auto const& chunk : _chain) {
+        f(chunk.storage.view().slice(0, chunk.written));
+    }
+
+    f(viewWritten());
+
+    return *this;
+}
+
+
 Result<void, Error>
 WriteBuffer::writeLE(uint16 value) {
     constexpr auto valueSize = sizeof(value);
@@ -201,3 +247,111 @@ WriteBuffer::writeBE(uint64 value) {
 
     return write(&result, valueSize);
 }
+
+
+namespace /* anonymous */ {
+
+/** Copy count elements from src to dst reversing the byte order of each.
+ * A plain loop over byteSwap() that compilers unroll and vectorize.
+ */
+template<typename T>
+void byteSwapInto(T* dst, T const* src, WriteBuffer::size_type count) noexcept {
+    for (WriteBuffer::size_type i = 0; i < count; ++i) {
+        dst[i] = byteSwap(src[i]);
+    }
+}
+
+/** Largest number of elements converted per stack scratch block when encoding
+ * into the opposite byte order. */
+constexpr WriteBuffer::size_type kSwabBlockSize = 64;
+
+}  // namespace
+
+
+template<typename T>
+Result<void, Error>
+WriteBuffer::writeSwabbed(T const* src, size_type count) {
+    if (remaining() < count * sizeof(T)) {
+        if (!_onOverflow) {
+            return Err(Error("OverflowError: write(src, count): no space left in the buffer"));
+        }
+
+        // Convert block-wise as below, but let each block spill into the chain:
+        T block[kSwabBlockSize];
+        while (count != 0) {
+            const auto blockCount = (count < kSwabBlockSize) ? count : kSwabBlockSize;
+            byteSwapInto(block, src, blockCount);
+
+            auto written = write(block, blockCount * sizeof(T));
+            if (!written) {
+                return written;
+            }
+
+            src += blockCount;
+            count -= blockCount;
+        }
+
+        return Ok();
+    }
+
+    // Convert via a small stack block so that arbitrary batch sizes need no allocation.
+    T block[kSwabBlockSize];
+    while (count != 0) {
+        const auto blockCount = (count < kSwabBlockSize) ? count : kSwabBlockSize;
+        byteSwapInto(block, src, blockCount);
+
+        memcpy(_storage.view().dataAddress(_position), block, blockCount * sizeof(T));
+        _position += blockCount * sizeof(T);
+
+        src += blockCount;
+        count -= blockCount;
+    }
+
+    return Ok();
+}
+
+
+Result<void, Error>
+WriteBuffer::writeLE(uint16 const* src, size_type count) {
+    return isBigendian() ? writeSwabbed(src, count) : write(src, count * sizeof(uint16));
+}
+
+Result<void, Error>
+WriteBuffer::writeLE(uint32 const* src, size_type count) {
+    return isBigendian() ? writeSwabbed(src, count) : write(src, count * sizeof(uint32));
+}
+
+Result<void, Error>
+WriteBuffer::writeLE(uint64 const* src, size_type count) {
+    return isBigendian() ? writeSwabbed(src, count) : write(src, count * sizeof(uint64));
+}
+
+Result<void, Error>
+WriteBuffer::writeBE(uint16 const* src, size_type count) {
+    return isBigendian() ? write(src, count * sizeof(uint16)) : writeSwabbed(src, count);
+}
+
+Result<void, Error>
+WriteBuffer::writeBE(uint32 const* src, size_type count) {
+    return isBigendian() ? write(src, count * sizeof(uint32)) : writeSwabbed(src, count);
+}
+
+Result<void, Error>
+WriteBuffer::writeBE(uint64 const* src, size_type count) {
+    return isBigendian() ? write(src, count * sizeof(uint64)) : writeSwabbed(src, count);
+}
+
+
+Result<void, Error>
+WriteBuffer::writeVarint(uint64 value) {
+    byte encoded[10];  // A 64-bit varint spans at most 10 encoded bytes.
+
+    size_type count = 0;
+    do {
+        const byte low = value & 0x7Fu;
+        value >>= 7;
+        encoded[count++] = (value != 0) ? (low | 0x80u) : low;
+    } while (value != 0);
+
+    return write(encoded, count);
+}
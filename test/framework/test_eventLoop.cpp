@@ -0,0 +1,133 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/framework/test_eventLoop.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/framework/eventLoop.hpp>  // Class being tested
+
+#include <solace/io/pipe.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <thread>
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+using namespace Solace;
+using namespace Solace::IO;
+using namespace Solace::Framework;
+
+
+class TestEventLoop: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestEventLoop);
+        CPPUNIT_TEST(testEventsTimersAndPostsDispatch);
+        CPPUNIT_TEST(testIdleHandler);
+        CPPUNIT_TEST(testPostBeforeRun);
+        CPPUNIT_TEST(testRunTwiceFails);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEventsTimersAndPostsDispatch() {
+        EventLoop loop(Selector::createEPoll(32), {1, 100});
+
+        Pipe pipe;
+        loop.selector().add(&pipe.getReadEnd(), Selector::Events::Read);
+
+        int marker = 0;
+        loop.timers().schedule(5, &marker);
+
+        int nbFdEvents = 0;
+        int nbTimerEvents = 0;
+        int nbPosted = 0;
+
+        std::thread producer([&loop, &pipe, &nbPosted]() {
+            byte message[] = "ping";
+            pipe.write(wrapMemory(message)).unwrap();
+
+            loop.post(EventLoop::Task([&nbPosted]() { nbPosted += 1; }));
+        });
+
+        const auto result = loop.run(EventLoop::EventHandler([&](Selector::Event const& event) {
+            if (event.fd == loop.timers().getSelectId()) {
+                CPPUNIT_ASSERT(event.data == &marker);
+                nbTimerEvents += 1;
+            } else {
+                byte rcv[16];
+                auto view = wrapMemory(rcv);
+                pipe.read(view).unwrap();
+                nbFdEvents += 1;
+            }
+
+            if (nbTimerEvents > 0 && nbFdEvents > 0) {
+                loop.stop();
+            }
+        }));
+
+        producer.join();
+        CPPUNIT_ASSERT(result.isOk());
+        CPPUNIT_ASSERT_EQUAL(1, nbFdEvents);
+        CPPUNIT_ASSERT_EQUAL(1, nbTimerEvents);
+        CPPUNIT_ASSERT_EQUAL(1, nbPosted);
+        CPPUNIT_ASSERT(!loop.isRunning());
+    }
+
+    void testIdleHandler() {
+        EventLoop loop(Selector::createPoll(8), {10, 5});
+
+        int nbIdle = 0;
+        loop.setIdleHandler(EventLoop::Task([&loop, &nbIdle]() {
+            nbIdle += 1;
+            if (nbIdle >= 3) {
+                loop.stop();
+            }
+        }));
+
+        CPPUNIT_ASSERT(loop.run(EventLoop::EventHandler([](Selector::Event const&) {})).isOk());
+        CPPUNIT_ASSERT_EQUAL(3, nbIdle);
+    }
+
+    void testPostBeforeRun() {
+        EventLoop loop(Selector::createPoll(8));
+
+        // Posting to a stopped loop queues for the next run:
+        bool ran = false;
+        loop.post(EventLoop::Task([&ran]() { ran = true; }));
+        loop.post(EventLoop::Task([&loop]() { loop.stop(); }));
+
+        CPPUNIT_ASSERT(loop.run(EventLoop::EventHandler([](Selector::Event const&) {})).isOk());
+        CPPUNIT_ASSERT(ran);
+    }
+
+    void testRunTwiceFails() {
+        EventLoop loop(Selector::createPoll(8));
+
+        loop.post(EventLoop::Task([&loop]() {
+            // From the loop thread the loop reports itself running:
+            CPPUNIT_ASSERT(loop.isRunning());
+            CPPUNIT_ASSERT(loop.run(EventLoop::EventHandler([](Selector::Event const&) {})).isError());
+            loop.stop();
+        }));
+
+        CPPUNIT_ASSERT(loop.run(EventLoop::EventHandler([](Selector::Event const&) {})).isOk());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestEventLoop);
+
+#endif  // SOLACE_PLATFORM_LINUX
@@ -0,0 +1,143 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/framework/test_initGraph.cpp
+ * @author: soultaker
+ *
+*******************************************************************************/
+#include <solace/framework/initGraph.hpp>  // Class being tested
+
+#include <atomic>
+#include <vector>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+using namespace Solace::Framework;
+
+
+namespace {
+
+Result<void, Error> ok() {
+    return Ok();
+}
+
+}  // namespace
+
+
+class TestInitGraph: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestInitGraph);
+        CPPUNIT_TEST(testLazyStart);
+        CPPUNIT_TEST(testStartAllPhaseOrder);
+        CPPUNIT_TEST(testStartAllThroughThreadPool);
+        CPPUNIT_TEST(testFailureStopsBringUp);
+        CPPUNIT_TEST(testDependencyCycle);
+        CPPUNIT_TEST(testUnknownDependency);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testLazyStart() {
+        std::vector<int> order;
+
+        InitGraph graph;
+        graph.add("storage",            [&order] { order.push_back(1); return ok(); })
+             .add("metrics",            [&order] { order.push_back(2); return ok(); })
+             .add("rpc", {"storage"},   [&order] { order.push_back(3); return ok(); });
+
+        // Only the closure of 'rpc' comes up; 'metrics' is not touched:
+        CPPUNIT_ASSERT(graph.start("rpc").isOk());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(2), order.size());
+        CPPUNIT_ASSERT_EQUAL(1, order[0]);
+        CPPUNIT_ASSERT_EQUAL(3, order[1]);
+
+        CPPUNIT_ASSERT(graph.isStarted("storage"));
+        CPPUNIT_ASSERT(graph.isStarted("rpc"));
+        CPPUNIT_ASSERT(!graph.isStarted("metrics"));
+
+        // A later startAll() finishes the rest without re-running anything:
+        CPPUNIT_ASSERT(graph.startAll().isOk());
+        CPPUNIT_ASSERT_EQUAL(std::size_t(3), order.size());
+        CPPUNIT_ASSERT_EQUAL(2, order[2]);
+    }
+
+    void testStartAllPhaseOrder() {
+        std::vector<int> order;
+
+        InitGraph graph;
+        graph.add("top", {"left", "right"},  [&order] { order.push_back(4); return ok(); });
+        graph.add("left", {"base"},          [&order] { order.push_back(2); return ok(); });
+        graph.add("right", {"base"},         [&order] { order.push_back(3); return ok(); });
+        graph.add("base",                    [&order] { order.push_back(1); return ok(); });
+
+        CPPUNIT_ASSERT(graph.startAll().isOk());
+
+        CPPUNIT_ASSERT_EQUAL(std::size_t(4), order.size());
+        CPPUNIT_ASSERT_EQUAL(1, order.front());
+        CPPUNIT_ASSERT_EQUAL(4, order.back());
+    }
+
+    void testStartAllThroughThreadPool() {
+        std::atomic<int> count{0};
+
+        InitGraph graph;
+        graph.add("base",                   [&count] { ++count; return ok(); });
+        graph.add("left", {"base"},         [&count] { ++count; return ok(); });
+        graph.add("right", {"base"},        [&count] { ++count; return ok(); });
+        graph.add("top", {"left", "right"}, [&count] { ++count; return ok(); });
+
+        {
+            ThreadPoolExecutor pool(2);
+            CPPUNIT_ASSERT(graph.startAll(pool).isOk());
+        }
+
+        CPPUNIT_ASSERT_EQUAL(4, count.load());
+        CPPUNIT_ASSERT(graph.isStarted("top"));
+    }
+
+    void testFailureStopsBringUp() {
+        InitGraph graph;
+        graph.add("flaky",              [] () -> Result<void, Error> { return Err(Error("boom")); });
+        graph.add("above", {"flaky"},   ok);
+
+        CPPUNIT_ASSERT(graph.start("above").isError());
+
+        // A failed action leaves its subsystem un-started:
+        CPPUNIT_ASSERT(!graph.isStarted("flaky"));
+        CPPUNIT_ASSERT(!graph.isStarted("above"));
+    }
+
+    void testDependencyCycle() {
+        InitGraph graph;
+        graph.add("ying", {"yang"}, ok);
+        graph.add("yang", {"ying"}, ok);
+
+        CPPUNIT_ASSERT(graph.start("ying").isError());
+        CPPUNIT_ASSERT(graph.startAll().isError());
+    }
+
+    void testUnknownDependency() {
+        InitGraph graph;
+        graph.add("hopeful", {"missing"}, ok);
+
+        CPPUNIT_ASSERT(graph.start("hopeful").isError());
+        CPPUNIT_ASSERT(graph.startAll().isError());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestInitGraph);
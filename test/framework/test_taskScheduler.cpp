@@ -0,0 +1,146 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/framework/test_taskScheduler.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/framework/taskScheduler.hpp>  // Class being tested
+#include <solace/framework/initGraph.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <chrono>
+#include <stdexcept>
+#include <thread>
+
+
+using namespace Solace;
+using namespace Solace::Framework;
+
+
+class TestTaskScheduler: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestTaskScheduler);
+        CPPUNIT_TEST(testSubmitCompletesFuture);
+        CPPUNIT_TEST(testSubmitBeforeStartRunsInline);
+        CPPUNIT_TEST(testNoSpawnAfterInit);
+        CPPUNIT_TEST(testThrowingTaskFailsFuture);
+        CPPUNIT_TEST(testNestedSubmissionsAndStealing);
+        CPPUNIT_TEST(testInitGraphService);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+
+    static void waitFor(std::atomic<int>& value, int expected) {
+        for (int i = 0; i < 50000 && value.load() != expected; ++i) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+
+        CPPUNIT_ASSERT_EQUAL(expected, value.load());
+    }
+
+public:
+
+    void testSubmitCompletesFuture() {
+        TaskScheduler scheduler(2);
+        CPPUNIT_ASSERT(scheduler.start().isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(2), scheduler.workerCount());
+
+        std::atomic<int> got {0};
+        scheduler.submit([]() { return 21 * 2; })
+                .then([&got](int value) { got.store(value); });
+        waitFor(got, 42);
+
+        // A void-returning task completes a Future<void>:
+        std::atomic<int> ran {0};
+        scheduler.submit([&ran]() { ran.store(5); });
+        waitFor(ran, 5);
+    }
+
+    void testSubmitBeforeStartRunsInline() {
+        TaskScheduler scheduler(2);
+        CPPUNIT_ASSERT(!scheduler.isStarted());
+
+        std::atomic<int> got {0};
+        scheduler.submit([]() { return 7; })
+                .then([&got](int value) { got.store(value); });
+
+        // No workers yet, so the task ran on this thread and is already done:
+        CPPUNIT_ASSERT_EQUAL(7, got.load());
+    }
+
+    void testNoSpawnAfterInit() {
+        TaskScheduler scheduler(1);
+        CPPUNIT_ASSERT(scheduler.start().isOk());
+        CPPUNIT_ASSERT(scheduler.isStarted());
+        CPPUNIT_ASSERT(scheduler.start().isError());
+    }
+
+    void testThrowingTaskFailsFuture() {
+        TaskScheduler scheduler(2);
+        CPPUNIT_ASSERT(scheduler.start().isOk());
+
+        std::atomic<int> failed {0};
+        scheduler.submit([]() -> int { throw std::runtime_error("boom"); })
+                .onError([&failed](Error&& ) -> int {
+                    failed.store(1);
+                    return 0;
+                });
+        waitFor(failed, 1);
+    }
+
+    void testNestedSubmissionsAndStealing() {
+        TaskScheduler scheduler(4);
+        CPPUNIT_ASSERT(scheduler.start().isOk());
+
+        // A few tasks each fan out many nested ones: the children land on
+        // their parents' deques and the idle workers steal them over.
+        const int nbRoots = 8;
+        const int fanout = 64;
+
+        std::atomic<int> count {0};
+        for (int i = 0; i < nbRoots; ++i) {
+            scheduler.schedule(TaskScheduler::Task([&scheduler, &count]() {
+                for (int j = 0; j < fanout; ++j) {
+                    scheduler.schedule(TaskScheduler::Task([&count]() {
+                        count.fetch_add(1);
+                    }));
+                }
+            }));
+        }
+
+        waitFor(count, nbRoots * fanout);
+    }
+
+    void testInitGraphService() {
+        TaskScheduler scheduler(2);
+
+        InitGraph graph;
+        graph.add(StringView("scheduler"), [&scheduler]() { return scheduler.start(); });
+
+        CPPUNIT_ASSERT(graph.startAll().isOk());
+        CPPUNIT_ASSERT(scheduler.isStarted());
+
+        std::atomic<int> got {0};
+        scheduler.submit([]() { return 3; })
+                .then([&got](int value) { got.store(value); });
+        waitFor(got, 3);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestTaskScheduler);
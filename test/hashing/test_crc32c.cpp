@@ -0,0 +1,97 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/hashing/test_crc32c.cpp
+ * @author: soultaker
+ *
+*******************************************************************************/
+#include <solace/hashing/crc32c.hpp>  // Class being tested
+
+#include <cstring>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+using namespace Solace::hashing;
+
+
+class TestHashingCrc32c: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestHashingCrc32c);
+        CPPUNIT_TEST(testAlgorithmName);
+        CPPUNIT_TEST(checkTestVectors);
+        CPPUNIT_TEST(checkAccumulation);
+        CPPUNIT_TEST(checkLongBlock);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testAlgorithmName() {
+        Crc32c crc;
+
+        CPPUNIT_ASSERT_EQUAL(String("CRC32C"), crc.getAlgorithm());
+        CPPUNIT_ASSERT_EQUAL(static_cast<Crc32c::size_type>(32 / 8), crc.getDigestLength());
+    }
+
+    void checkTestVectors() {
+        // The standard check value plus the RFC 3720 vectors:
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0xe3069283), crc32c(wrapMemory("123456789", 9)));
+
+        byte block[32];
+
+        memset(block, 0, sizeof(block));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0x8a9136aa), crc32c(wrapMemory(block)));
+
+        memset(block, 0xff, sizeof(block));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0x62a8ab43), crc32c(wrapMemory(block)));
+
+        for (size_t i = 0; i < sizeof(block); ++i) {
+            block[i] = static_cast<byte>(i);
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0x46dd794e), crc32c(wrapMemory(block)));
+    }
+
+    void checkAccumulation() {
+        char message[] = "123456789";
+        auto const whole = crc32c(wrapMemory(message, 9));
+
+        // The one-shot chains through its crc argument:
+        auto const head = crc32c(wrapMemory(message, 4));
+        CPPUNIT_ASSERT_EQUAL(whole, crc32c(wrapMemory(message + 4, 5), head));
+
+        // ... and the stateful object accumulates across update() calls:
+        Crc32c crc;
+        crc.update(wrapMemory(message, 4));
+        crc.update(wrapMemory(message + 4, 5));
+        CPPUNIT_ASSERT_EQUAL(MessageDigest({0xe3, 0x06, 0x92, 0x83}), crc.digest());
+    }
+
+    void checkLongBlock() {
+        // Long enough to engage the interleaved-stream hardware path; the
+        // chained two-piece value must agree with the one-shot:
+        byte block[40000];
+        for (size_t i = 0; i < sizeof(block); ++i) {
+            block[i] = static_cast<byte>(i * 31 + 7);
+        }
+
+        auto const whole = crc32c(wrapMemory(block));
+        auto const head = crc32c(wrapMemory(block, 11111));
+        CPPUNIT_ASSERT_EQUAL(whole, crc32c(wrapMemory(block + 11111, sizeof(block) - 11111), head));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestHashingCrc32c);
@@ -0,0 +1,107 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/hashing/test_hmac.cpp
+ * @author: soultaker
+ *
+*******************************************************************************/
+#include <solace/hashing/hmac.hpp>  // Class being tested
+
+#include <solace/hashing/sha2.hpp>
+#include <solace/hashing/md5.hpp>
+
+#include <cstring>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+using namespace Solace::hashing;
+
+
+class TestHashingHmac: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestHashingHmac);
+        CPPUNIT_TEST(hmacSha256TestVectors);
+        CPPUNIT_TEST(hmacSha256LongKey);
+        CPPUNIT_TEST(hmacMd5TestVector);
+        CPPUNIT_TEST(engineIsReusable);
+        CPPUNIT_TEST(constantTimeComparison);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void hmacSha256TestVectors() {
+        // RFC 4231, test cases 1 and 2:
+        byte key1[20];
+        memset(key1, 0x0b, sizeof(key1));
+
+        Hmac<Sha256> mac1(wrapMemory(key1));
+        CPPUNIT_ASSERT_EQUAL(MessageDigest({ 0xb0, 0x34, 0x4c, 0x61, 0xd8, 0xdb, 0x38, 0x53,
+                                             0x5c, 0xa8, 0xaf, 0xce, 0xaf, 0x0b, 0xf1, 0x2b,
+                                             0x88, 0x1d, 0xc2, 0x00, 0xc9, 0x83, 0x3d, 0xa7,
+                                             0x26, 0xe9, 0x37, 0x6c, 0x2e, 0x32, 0xcf, 0xf7 }),
+                             mac1.mac(wrapMemory("Hi There", 8)));
+
+        Hmac<Sha256> mac2(wrapMemory("Jefe", 4));
+        CPPUNIT_ASSERT_EQUAL(MessageDigest({ 0x5b, 0xdc, 0xc1, 0x46, 0xbf, 0x60, 0x75, 0x4e,
+                                             0x6a, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xc7,
+                                             0x5a, 0x00, 0x3f, 0x08, 0x9d, 0x27, 0x39, 0x83,
+                                             0x9d, 0xec, 0x58, 0xb9, 0x64, 0xec, 0x38, 0x43 }),
+                             mac2.mac(wrapMemory("what do ya want for nothing?", 28)));
+    }
+
+    void hmacSha256LongKey() {
+        // RFC 4231, test case 6 - a key longer than the block gets hashed first:
+        byte key[131];
+        memset(key, 0xaa, sizeof(key));
+
+        Hmac<Sha256> mac(wrapMemory(key));
+        CPPUNIT_ASSERT_EQUAL(MessageDigest({ 0x60, 0xe4, 0x31, 0x59, 0x1e, 0xe0, 0xb6, 0x7f,
+                                             0x0d, 0x8a, 0x26, 0xaa, 0xcb, 0xf5, 0xb7, 0x7f,
+                                             0x8e, 0x0b, 0xc6, 0x21, 0x37, 0x28, 0xc5, 0x14,
+                                             0x05, 0x46, 0x04, 0x0f, 0x0e, 0xe3, 0x7f, 0x54 }),
+                             mac.mac(wrapMemory("Test Using Larger Than Block-Size Key - Hash Key First", 54)));
+    }
+
+    void hmacMd5TestVector() {
+        // RFC 2202, test case 2 - the template works over any of the algorithms:
+        Hmac<MD5> mac(wrapMemory("Jefe", 4));
+        CPPUNIT_ASSERT_EQUAL(MessageDigest({ 0x75, 0x0c, 0x78, 0x3e, 0x6a, 0xb0, 0xb5, 0x03,
+                                             0xea, 0xa8, 0x6e, 0x31, 0x0a, 0x5d, 0xb7, 0x38 }),
+                             mac.mac(wrapMemory("what do ya want for nothing?", 28)));
+    }
+
+    void engineIsReusable() {
+        // The key schedule survives mac() - each message sees a fresh clone:
+        Hmac<Sha256> mac(wrapMemory("Jefe", 4));
+
+        auto const first = mac.mac(wrapMemory("abc", 3));
+        mac.mac(wrapMemory("something else entirely", 23));
+
+        CPPUNIT_ASSERT_EQUAL(first, mac.mac(wrapMemory("abc", 3)));
+    }
+
+    void constantTimeComparison() {
+        MessageDigest const tag({0xde, 0xad, 0xbe, 0xef});
+
+        CPPUNIT_ASSERT(tag.isEqual(MessageDigest({0xde, 0xad, 0xbe, 0xef})));
+        CPPUNIT_ASSERT(!tag.isEqual(MessageDigest({0xde, 0xad, 0xbe, 0xee})));
+        CPPUNIT_ASSERT(!tag.isEqual(MessageDigest({0xde, 0xad, 0xbe})));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestHashingHmac);
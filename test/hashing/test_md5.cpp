@@ -39,6 +39,7 @@ class TestHashingMD5: public CppUnit::TestFixture  {
         CPPUNIT_TEST(hashAlphabet);
         CPPUNIT_TEST(hashAlphanum);
         CPPUNIT_TEST(hashNumbers);
+        CPPUNIT_TEST(hashMisalignedInput);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -128,6 +129,30 @@ public:
                                                  0xAC, 0x49, 0xDA, 0x2E, 0x21, 0x07, 0xB6, 0x7A }),
                              hash.digest());
     }
+
+    void hashMisalignedInput() {
+        // The block loader takes whole words regardless of input alignment:
+        // the digest must not depend on where the message sits in memory or
+        // how it is chunked across update() calls.
+        alignas(8) byte storage[256 + 8];
+        for (size_t i = 0; i < sizeof(storage); ++i) {
+            storage[i] = static_cast<byte>(i * 31 + 7);
+        }
+
+        for (size_t misalign = 1; misalign < 8; ++misalign) {
+            const byte* message = storage + misalign;
+
+            MD5 oneShot;
+            oneShot.update(wrapMemory(message, 256));
+
+            MD5 chunked;
+            chunked.update(wrapMemory(message, 65));
+            chunked.update(wrapMemory(message + 65, 63));
+            chunked.update(wrapMemory(message + 128, 128));
+
+            CPPUNIT_ASSERT_EQUAL(oneShot.digest(), chunked.digest());
+        }
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestHashingMD5);
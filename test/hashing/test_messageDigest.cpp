@@ -0,0 +1,107 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/hashing/test_messageDigest.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/hashing/messageDigest.hpp>  // Class being tested
+
+#include <solace/base64.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+
+
+using namespace Solace;
+using namespace Solace::hashing;
+
+
+class TestMessageDigest : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestMessageDigest);
+        CPPUNIT_TEST(testToString);
+        CPPUNIT_TEST(testFormatIntoView);
+        CPPUNIT_TEST(testFormatIntoWriteBuffer);
+        CPPUNIT_TEST(testFormatBase64);
+        CPPUNIT_TEST(testFormatIntoTooSmallDest);
+    CPPUNIT_TEST_SUITE_END();
+
+    // MD5("abc"), a convenient known digest:
+    static MessageDigest knownDigest() {
+        return MessageDigest({ 0x90, 0x01, 0x50, 0x98, 0x3C, 0xD2, 0x4F, 0xB0,
+                               0xD6, 0x96, 0x3F, 0x7D, 0x28, 0xE1, 0x7F, 0x72 });
+    }
+
+public:
+
+    void testToString() {
+        CPPUNIT_ASSERT_EQUAL(String("900150983cd24fb0d6963f7d28e17f72"),
+                             knownDigest().toString());
+    }
+
+    void testFormatIntoView() {
+        const auto digest = knownDigest();
+
+        char buffer[64];
+        auto written = digest.formatInto(wrapMemory(buffer));
+        CPPUNIT_ASSERT(written.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MessageDigest::size_type>(32), written.unwrap());
+        CPPUNIT_ASSERT_EQUAL(0, memcmp(buffer, "900150983cd24fb0d6963f7d28e17f72", 32));
+    }
+
+    void testFormatIntoWriteBuffer() {
+        const auto digest = knownDigest();
+
+        char storage[64];
+        WriteBuffer dest(wrapMemory(storage));
+
+        // formatInto appends at the buffer's position, like any other write:
+        char prefix[] = "md5:";
+        CPPUNIT_ASSERT(dest.write(wrapMemory(prefix, 4)).isOk());
+
+        auto written = digest.formatInto(dest);
+        CPPUNIT_ASSERT(written.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(36), dest.position());
+        CPPUNIT_ASSERT_EQUAL(0, memcmp(storage, "md5:900150983cd24fb0d6963f7d28e17f72", 36));
+    }
+
+    void testFormatBase64() {
+        const auto digest = knownDigest();
+
+        char buffer[64];
+        auto written = digest.formatInto(wrapMemory(buffer), MessageDigest::Encoding::Base64);
+        CPPUNIT_ASSERT(written.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MessageDigest::size_type>(Base64Encoder::encodedSize(16)),
+                             written.unwrap());
+        CPPUNIT_ASSERT_EQUAL(0, memcmp(buffer, "kAFQmDzST7DWlj99KOF/cg==", 24));
+    }
+
+    void testFormatIntoTooSmallDest() {
+        const auto digest = knownDigest();
+
+        char tiny[8];
+        CPPUNIT_ASSERT(digest.formatInto(wrapMemory(tiny)).isError());
+
+        // A failed format must not advance the destination buffer:
+        WriteBuffer dest(wrapMemory(tiny));
+        CPPUNIT_ASSERT(digest.formatInto(dest).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(0), dest.position());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestMessageDigest);
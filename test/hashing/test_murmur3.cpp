@@ -21,6 +21,9 @@
 *******************************************************************************/
 #include <solace/hashing/murmur3.hpp>  // Class being tested
 
+#include <solace/exception.hpp>
+#include <cstring>
+
 #include <cppunit/extensions/HelperMacros.h>
 
 
@@ -46,6 +49,9 @@ class TestHashingMurmur3: public CppUnit::TestFixture  {
         CPPUNIT_TEST(hashAlphanum128);
         CPPUNIT_TEST(hashNumbers32);
         CPPUNIT_TEST(hashNumbers128);
+        CPPUNIT_TEST(constexprHash32);
+        CPPUNIT_TEST(oneShotHash128);
+        CPPUNIT_TEST(batchHash128);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -152,6 +158,47 @@ public:
                                             0xab, 0xf5, 0xd5, 0xa2, 0x27, 0xca, 0x4f, 0x77}),
                              Murmur3_128(0).update(wrapMemory(message, sizeof(message) - 1)).digest());
     }
+
+    void oneShotHash128() {
+        char message[] = "The quick brown fox jumps over the lazy dog";
+        auto const view = wrapMemory(message, sizeof(message) - 1);
+
+        // The one-shot form produces the same value as the stateful hasher:
+        auto const hash = murmur3_128(view, 31337);
+        auto const digest = Murmur3_128(31337).update(view).digest();
+        CPPUNIT_ASSERT(memcmp(&hash, digest.view().dataAddress(), sizeof(hash)) == 0);
+
+        CPPUNIT_ASSERT(murmur3_128(view, 31337) == hash);
+        CPPUNIT_ASSERT(murmur3_128(view, 31338) != hash);
+    }
+
+    void batchHash128() {
+        ImmutableMemoryView keys[] = {
+            wrapMemory("a", 1),
+            wrapMemory("abc", 3),
+            wrapMemory("message digest", 14)
+        };
+
+        Hash128 hashes[3];
+        murmur3_128(arrayView(keys), arrayView(hashes), 7);
+
+        for (size_t i = 0; i < 3; ++i) {
+            CPPUNIT_ASSERT(hashes[i] == murmur3_128(keys[i], 7));
+        }
+
+        // A destination shorter than the key list is rejected:
+        CPPUNIT_ASSERT_THROW(murmur3_128(arrayView(keys), ArrayView<Hash128>(hashes, 2), 7),
+                             IllegalArgumentException);
+    }
+
+    void constexprHash32() {
+        // Evaluated at compile time and matching the Murmur3_32 vectors above:
+        static_assert(murmur3_32(StringView("")) == 0x00000000, "murmur3_32('')");
+        static_assert(murmur3_32(StringView("a")) == 0x3c2569b2, "murmur3_32('a')");
+        static_assert(murmur3_32(StringView("abc")) == 0xb3dd93fa, "murmur3_32('abc')");
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0x638f4169), murmur3_32(StringView("message digest")));
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestHashingMurmur3);
@@ -36,6 +36,7 @@ class TestHashingSHA1: public CppUnit::TestFixture  {
         CPPUNIT_TEST(hashAx1000);
         CPPUNIT_TEST(hashABC);
         CPPUNIT_TEST(hashMessageDigest);
+        CPPUNIT_TEST(hashMisalignedInput);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -105,6 +106,30 @@ public:
                              hash.digest());
     }
 
+    void hashMisalignedInput() {
+        // The block loader takes whole words regardless of input alignment:
+        // the digest must not depend on where the message sits in memory or
+        // how it is chunked across update() calls.
+        alignas(8) byte storage[256 + 8];
+        for (size_t i = 0; i < sizeof(storage); ++i) {
+            storage[i] = static_cast<byte>(i * 31 + 7);
+        }
+
+        for (size_t misalign = 1; misalign < 8; ++misalign) {
+            const byte* message = storage + misalign;
+
+            Sha1 oneShot;
+            oneShot.update(wrapMemory(message, 256));
+
+            Sha1 chunked;
+            chunked.update(wrapMemory(message, 65));
+            chunked.update(wrapMemory(message + 65, 63));
+            chunked.update(wrapMemory(message + 128, 128));
+
+            CPPUNIT_ASSERT_EQUAL(oneShot.digest(), chunked.digest());
+        }
+    }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestHashingSHA1);
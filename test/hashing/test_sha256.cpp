@@ -21,6 +21,7 @@
 *******************************************************************************/
 #include <solace/hashing/sha2.hpp>  // Class being tested
 
+#include <solace/io/platformFilesystem.hpp>
 #include <cppunit/extensions/HelperMacros.h>
 
 
@@ -36,6 +37,9 @@ class TestHashingSHA256: public CppUnit::TestFixture  {
         CPPUNIT_TEST(hashSingleLetter);
         CPPUNIT_TEST(hashABC);
         CPPUNIT_TEST(hashMessageDigest);
+        CPPUNIT_TEST(hashGather);
+        CPPUNIT_TEST(hashFromFile);
+        CPPUNIT_TEST(hashBatch);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -100,6 +104,75 @@ public:
                              hash.digest());
     }
 
+    void hashGather() {
+        char message[] = "abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq";
+
+        Sha256 reference;
+        reference.update(wrapMemory(message, sizeof(message) - 1));
+
+        // The same message, scattered over three views:
+        ImmutableMemoryView parts[] = {
+            wrapMemory(message, 5),
+            wrapMemory(message + 5, 17),
+            wrapMemory(message + 22, sizeof(message) - 1 - 22)
+        };
+
+        Sha256 hash;
+        hash.update(arrayView(parts));
+
+        CPPUNIT_ASSERT_EQUAL(reference.digest(), hash.digest());
+    }
+
+    void hashBatch() {
+        // Eleven messages: one full vector group of eight plus a scalar tail,
+        // with lengths that leave different lanes different numbers of blocks.
+        byte storage[11][300];
+        ImmutableMemoryView messages[11];
+        for (size_t m = 0; m < 11; ++m) {
+            const size_t len = m * 27;
+            for (size_t i = 0; i < len; ++i) {
+                storage[m][i] = static_cast<byte>(m * 31 + i);
+            }
+            messages[m] = wrapMemory(storage[m], len);
+        }
+
+        auto const digests = sha256Batch(arrayView(messages));
+        CPPUNIT_ASSERT_EQUAL(static_cast<Array<MessageDigest>::size_type>(11), digests.size());
+
+        for (size_t m = 0; m < 11; ++m) {
+            Sha256 reference;
+            reference.update(messages[m]);
+            CPPUNIT_ASSERT_EQUAL(reference.digest(), digests[m]);
+        }
+    }
+
+    void hashFromFile() {
+        // Enough data to span several digest blocks and land a partial tail:
+        byte message[16 * 1024 + 137];
+        for (size_t i = 0; i < sizeof(message); ++i) {
+            message[i] = static_cast<byte>(i * 2654435761u >> 13);
+        }
+
+        IO::PlatformFilesystem fs;
+        auto file = fs.createTemp();
+        file->write(wrapMemory(message));
+
+        Sha256 reference;
+        reference.update(wrapMemory(message));
+
+        Sha256 hash;
+        hash.updateFrom(*file, 0, sizeof(message));
+        CPPUNIT_ASSERT_EQUAL(reference.digest(), hash.digest());
+
+        // A sub-range from an offset that is not page aligned:
+        Sha256 rangeReference;
+        rangeReference.update(wrapMemory(message + 4097, 8000));
+
+        Sha256 rangeHash;
+        rangeHash.updateFrom(*file, 4097, 8000);
+        CPPUNIT_ASSERT_EQUAL(rangeReference.digest(), rangeHash.digest());
+    }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestHashingSHA256);
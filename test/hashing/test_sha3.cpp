@@ -0,0 +1,138 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/hashing/test_sha3.cpp
+ * @author: soultaker
+ *
+*******************************************************************************/
+#include <solace/hashing/sha3.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+
+#include <cstring>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+using namespace Solace::hashing;
+
+
+class TestHashingSHA3: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestHashingSHA3);
+        CPPUNIT_TEST(testAlgorithmName);
+        CPPUNIT_TEST(hashEmptyMessage);
+        CPPUNIT_TEST(hashABC);
+        CPPUNIT_TEST(hashMultiBlockMessage);
+        CPPUNIT_TEST(shakeEmptyMessage);
+        CPPUNIT_TEST(shakeStreamedReads);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testAlgorithmName() {
+        Sha3 hash;
+
+        CPPUNIT_ASSERT_EQUAL(String("SHA3-256"), hash.getAlgorithm());
+        CPPUNIT_ASSERT_EQUAL(static_cast<Sha3::size_type>(256 / 8), hash.getDigestLength());
+    }
+
+    void hashEmptyMessage() {
+        Sha3 hash;
+
+        CPPUNIT_ASSERT_EQUAL(MessageDigest({ 0xa7, 0xff, 0xc6, 0xf8, 0xbf, 0x1e, 0xd7, 0x66,
+                                             0x51, 0xc1, 0x47, 0x56, 0xa0, 0x61, 0xd6, 0x62,
+                                             0xf5, 0x80, 0xff, 0x4d, 0xe4, 0x3b, 0x49, 0xfa,
+                                             0x82, 0xd8, 0x0a, 0x4b, 0x80, 0xf8, 0x43, 0x4a }),
+                             hash.digest());
+    }
+
+    void hashABC() {
+        Sha3 hash;
+
+        char message[] = "abc";
+        hash.update(wrapMemory(message, sizeof(message) - 1));
+
+        CPPUNIT_ASSERT_EQUAL(MessageDigest({ 0x3a, 0x98, 0x5d, 0xa7, 0x4f, 0xe2, 0x25, 0xb2,
+                                             0x04, 0x5c, 0x17, 0x2d, 0x6b, 0xd3, 0x90, 0xbd,
+                                             0x85, 0x5f, 0x08, 0x6e, 0x3e, 0x9d, 0x52, 0x5b,
+                                             0x46, 0xbf, 0xe2, 0x45, 0x11, 0x43, 0x15, 0x32 }),
+                             hash.digest());
+    }
+
+    void hashMultiBlockMessage() {
+        // Longer than the 136-byte rate, and chunked at an awkward offset:
+        byte message[500];
+        for (size_t i = 0; i < sizeof(message); ++i) {
+            message[i] = static_cast<byte>(i * 7 + 1);
+        }
+
+        Sha3 whole;
+        whole.update(wrapMemory(message));
+
+        Sha3 chunked;
+        chunked.update(wrapMemory(message, 137));
+        chunked.update(wrapMemory(message + 137, sizeof(message) - 137));
+
+        CPPUNIT_ASSERT_EQUAL(whole.digest(), chunked.digest());
+    }
+
+    void shakeEmptyMessage() {
+        byte out[32];
+
+        Shake128 xof128;
+        xof128.read(wrapMemory(out));
+        CPPUNIT_ASSERT_EQUAL(MessageDigest({ 0x7f, 0x9c, 0x2b, 0xa4, 0xe8, 0x8f, 0x82, 0x7d,
+                                             0x61, 0x60, 0x45, 0x50, 0x76, 0x05, 0x85, 0x3e,
+                                             0xd7, 0x3b, 0x80, 0x93, 0xf6, 0xef, 0xbc, 0x88,
+                                             0xeb, 0x1a, 0x6e, 0xac, 0xfa, 0x66, 0xef, 0x26 }),
+                             MessageDigest(wrapMemory(out)));
+
+        Shake256 xof256;
+        xof256.read(wrapMemory(out));
+        CPPUNIT_ASSERT_EQUAL(MessageDigest({ 0x46, 0xb9, 0xdd, 0x2b, 0x0b, 0xa8, 0x8d, 0x13,
+                                             0x23, 0x3b, 0x3f, 0xeb, 0x74, 0x3e, 0xeb, 0x24,
+                                             0x3f, 0xcd, 0x52, 0xea, 0x62, 0xb8, 0x1b, 0x82,
+                                             0xb5, 0x0c, 0x27, 0x64, 0x6e, 0xd5, 0x76, 0x2f }),
+                             MessageDigest(wrapMemory(out)));
+    }
+
+    void shakeStreamedReads() {
+        // Output squeezed in pieces is the same stream as one big read,
+        // across the 168-byte rate boundary:
+        char seed[] = "per-session key seed";
+        byte whole[400];
+        byte pieces[400];
+
+        Shake128 a;
+        a.update(wrapMemory(seed, sizeof(seed) - 1));
+        a.read(wrapMemory(whole));
+
+        Shake128 b;
+        b.update(wrapMemory(seed, sizeof(seed) - 1));
+        b.read(wrapMemory(pieces, 100));
+        b.read(wrapMemory(pieces + 100, 68));
+        b.read(wrapMemory(pieces + 168, 232));
+
+        CPPUNIT_ASSERT(memcmp(whole, pieces, sizeof(whole)) == 0);
+
+        // The message is sealed by the first read:
+        CPPUNIT_ASSERT_THROW(b.update(wrapMemory(seed, 1)), Exception);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestHashingSHA3);
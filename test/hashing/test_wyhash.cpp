@@ -0,0 +1,90 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/hashing/test_wyhash.cpp
+ * @author: soultaker
+ *
+*******************************************************************************/
+#include <solace/hashing/wyhash.hpp>  // Class being tested
+
+#include <cstring>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+using namespace Solace::hashing;
+
+
+class TestHashingWyhash: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestHashingWyhash);
+        CPPUNIT_TEST(testAlgorithmName);
+        CPPUNIT_TEST(hashTestVectors);
+        CPPUNIT_TEST(hashMatchesOneShot);
+        CPPUNIT_TEST(hashLongMessage);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testAlgorithmName() {
+        Wyhash64 hash;
+
+        CPPUNIT_ASSERT_EQUAL(String("WYHASH-64"), hash.getAlgorithm());
+    }
+
+    void hashTestVectors() {
+        // The reference vectors of wyhash final version 3:
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0x42bc986dc5eec4d3),
+                             wyhash64(wrapMemory("", 0), 0));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0x84508dc903c31551),
+                             wyhash64(wrapMemory("a", 1), 1));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0x0bc54887cfc9ecb1),
+                             wyhash64(wrapMemory("abc", 3), 2));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0x6e2ff3298208a67c),
+                             wyhash64(wrapMemory("message digest", 14), 3));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0x9a64e42e897195b9),
+                             wyhash64(wrapMemory("abcdefghijklmnopqrstuvwxyz", 26), 4));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0x9199383239c32554),
+                             wyhash64(wrapMemory("ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789",
+                                                 62), 5));
+    }
+
+    void hashMatchesOneShot() {
+        char message[] = "message digest";
+        auto const view = wrapMemory(message, sizeof(message) - 1);
+
+        Wyhash64 hash(3);
+        CPPUNIT_ASSERT_EQUAL(static_cast<Wyhash64::size_type>(64 / 8), hash.getDigestLength());
+
+        auto const digest = hash.update(view).digest();
+
+        uint64 oneShot = wyhash64(view, 3);
+        uint64 fromDigest;
+        getUint64_LE(fromDigest, digest.view().dataAddress(), 0);
+        CPPUNIT_ASSERT_EQUAL(oneShot, fromDigest);
+    }
+
+    void hashLongMessage() {
+        // Long enough to take the 48-byte striped path several times over:
+        char message[] = "12345678901234567890123456789012345678901234567890"
+                         "123456789012345678901234567890";
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0x7c1ccf6bba30f5a5),
+                             wyhash64(wrapMemory(message, sizeof(message) - 1), 6));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestHashingWyhash);
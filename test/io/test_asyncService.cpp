@@ -0,0 +1,143 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_asyncService.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/asyncService.hpp>  // Class being tested
+
+#include <solace/io/pipe.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <fcntl.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestAsyncService : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestAsyncService);
+        CPPUNIT_TEST(testReadCompletesOnData);
+        CPPUNIT_TEST(testWriteThenRead);
+        CPPUNIT_TEST(testBatchOfReadsDrainedInOneWakeup);
+        CPPUNIT_TEST(testEndOfStreamCompletesWithZero);
+    CPPUNIT_TEST_SUITE_END();
+
+    static void makeNonblocking(File& file) {
+        const auto fd = file.getSelectId();
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+    }
+
+public:
+
+    void testReadCompletesOnData() {
+        Pipe channel;
+        makeNonblocking(channel.getReadEnd());
+
+        AsyncService service(Selector::createPoll(4));
+
+        byte mem[16];
+        MemoryView::size_type got = 0;
+        service.asyncRead(channel.getReadEnd(), wrapMemory(mem))
+                .then([&got](MemoryView::size_type count) { got = count; });
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), service.outstanding());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), service.poll(0));  // Nothing to read yet.
+
+        char payload[] = "ping";
+        channel.write(wrapMemory(payload, 4));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), service.poll(1000));
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(4), got);
+        CPPUNIT_ASSERT_EQUAL(0, memcmp(mem, payload, 4));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(0), service.outstanding());
+    }
+
+    void testWriteThenRead() {
+        Pipe channel;
+        makeNonblocking(channel.getReadEnd());
+        makeNonblocking(channel.getWriteEnd());
+
+        AsyncService service(Selector::createPoll(4));
+
+        char payload[] = "pong!";
+        bool wrote = false;
+        service.asyncWrite(channel.getWriteEnd(), wrapMemory(payload, 5))
+                .then([&wrote](MemoryView::size_type count) { wrote = (count == 5); });
+
+        byte mem[16];
+        MemoryView::size_type got = 0;
+        service.asyncRead(channel.getReadEnd(), wrapMemory(mem))
+                .then([&got](MemoryView::size_type count) { got = count; });
+
+        // One round flushes the write, the next delivers the read:
+        for (int round = 0; round < 4 && service.outstanding() > 0; ++round) {
+            service.poll(1000);
+        }
+
+        CPPUNIT_ASSERT(wrote);
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(5), got);
+        CPPUNIT_ASSERT_EQUAL(0, memcmp(mem, payload, 5));
+    }
+
+    void testBatchOfReadsDrainedInOneWakeup() {
+        Pipe channel;
+        makeNonblocking(channel.getReadEnd());
+
+        AsyncService service(Selector::createPoll(4));
+
+        byte first[4];
+        byte second[4];
+        uint32 completions = 0;
+        service.asyncRead(channel.getReadEnd(), wrapMemory(first))
+                .then([&completions](MemoryView::size_type) { ++completions; });
+        service.asyncRead(channel.getReadEnd(), wrapMemory(second))
+                .then([&completions](MemoryView::size_type) { ++completions; });
+
+        char payload[] = "aaaabbbb";
+        channel.write(wrapMemory(payload, 8));
+
+        // Both queued reads complete off a single readiness event:
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(2), service.poll(1000));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(2), completions);
+        CPPUNIT_ASSERT_EQUAL(0, memcmp(first, "aaaa", 4));
+        CPPUNIT_ASSERT_EQUAL(0, memcmp(second, "bbbb", 4));
+    }
+
+    void testEndOfStreamCompletesWithZero() {
+        Pipe channel;
+        makeNonblocking(channel.getReadEnd());
+
+        AsyncService service(Selector::createPoll(4));
+
+        byte mem[16];
+        MemoryView::size_type got = 99;
+        service.asyncRead(channel.getReadEnd(), wrapMemory(mem))
+                .then([&got](MemoryView::size_type count) { got = count; });
+
+        channel.getWriteEnd().close();
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), service.poll(1000));
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0), got);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestAsyncService);
@@ -0,0 +1,231 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_bufferedWriter.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/bufferedWriter.hpp>  // Class being tested
+
+#include <solace/io/platformFilesystem.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestBufferedWriter : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestBufferedWriter);
+        CPPUNIT_TEST(testRecordsCoalesceAndBarrierCompletes);
+        CPPUNIT_TEST(testBytesAppearInAcceptanceOrder);
+        CPPUNIT_TEST(testOversizedRecordGoesThrough);
+        CPPUNIT_TEST(testTimedFlushOfPartialBuffer);
+        CPPUNIT_TEST(testDurableBarrierViaSyncService);
+        CPPUNIT_TEST(testStoppedWriterRejectsWork);
+    CPPUNIT_TEST_SUITE_END();
+
+    static void waitFor(std::atomic<int>& counter, int expected) {
+        for (int spin = 0; spin < 400 && counter.load() < expected; ++spin) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+public:
+
+    void testRecordsCoalesceAndBarrierCompletes() {
+        PlatformFilesystem fs;
+        auto path = Path::parse("/tmp/solace_test_bufferedWriter1.dat").unwrap();
+        auto file = fs.create(path);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        {
+            BufferedWriter writer(*file, allocator, 64 * 1024);
+
+            char record[200];
+            for (int i = 0; i < 2000; ++i) {
+                memset(record, 'a' + (i % 26), sizeof(record));
+                CPPUNIT_ASSERT(writer.write(wrapMemory(record)).isOk());
+            }
+
+            std::atomic<int> completed(0);
+            writer.barrier().then([&completed]() { ++completed; });
+
+            waitFor(completed, 1);
+            CPPUNIT_ASSERT_EQUAL(1, completed.load());
+
+            // The barrier covers every record accepted before it:
+            CPPUNIT_ASSERT_EQUAL(static_cast<File::size_type>(2000 * 200),
+                                 file->seek(0, File::Seek::End));
+        }
+
+        fs.unlink(path);
+    }
+
+
+    void testBytesAppearInAcceptanceOrder() {
+        PlatformFilesystem fs;
+        auto path = Path::parse("/tmp/solace_test_bufferedWriter2.dat").unwrap();
+        auto file = fs.create(path);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        {
+            BufferedWriter writer(*file, allocator, 4096);
+
+            byte seq[256];
+            for (int i = 0; i < 256; ++i) {
+                seq[i] = static_cast<byte>(i);
+            }
+            for (int rep = 0; rep < 64; ++rep) {
+                CPPUNIT_ASSERT(writer.write(wrapMemory(seq)).isOk());
+            }
+        }  // Destruction stops the writer, flushing everything accepted.
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<File::size_type>(64 * 256), file->seek(0, File::Seek::End));
+
+        byte check[256];
+        auto view = wrapMemory(check);
+        CPPUNIT_ASSERT_EQUAL(static_cast<IOObject::size_type>(256),
+                             file->readAt(63 * 256, view).unwrap());
+        for (int i = 0; i < 256; ++i) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(i), check[i]);
+        }
+
+        fs.unlink(path);
+    }
+
+
+    void testOversizedRecordGoesThrough() {
+        PlatformFilesystem fs;
+        auto path = Path::parse("/tmp/solace_test_bufferedWriter3.dat").unwrap();
+        auto file = fs.create(path);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        {
+            // A record bigger than a staging buffer is staged in pieces:
+            BufferedWriter writer(*file, allocator, 1024);
+
+            byte big[10000];
+            for (size_t i = 0; i < sizeof(big); ++i) {
+                big[i] = static_cast<byte>(i % 251);
+            }
+            CPPUNIT_ASSERT(writer.write(wrapMemory(big)).isOk());
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<File::size_type>(10000), file->seek(0, File::Seek::End));
+
+        byte check[10000];
+        auto view = wrapMemory(check);
+        CPPUNIT_ASSERT_EQUAL(static_cast<IOObject::size_type>(10000),
+                             file->readAt(0, view).unwrap());
+        for (size_t i = 0; i < sizeof(check); ++i) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(i % 251), check[i]);
+        }
+
+        fs.unlink(path);
+    }
+
+
+    void testTimedFlushOfPartialBuffer() {
+        PlatformFilesystem fs;
+        auto path = Path::parse("/tmp/solace_test_bufferedWriter4.dat").unwrap();
+        auto file = fs.create(path);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        BufferedWriter::Options options;
+        options.flushIntervalMs = 5;
+
+        BufferedWriter writer(*file, allocator, 64 * 1024, options);
+
+        char msg[] = "trickle";
+        CPPUNIT_ASSERT(writer.write(wrapMemory(msg, 7)).isOk());
+
+        // Far below the watermark and no barrier - the timer must flush it:
+        bool flushed = false;
+        for (int spin = 0; spin < 400; ++spin) {
+            if (file->seek(0, File::Seek::End) == 7) {
+                flushed = true;
+                break;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+        CPPUNIT_ASSERT(flushed);
+
+        writer.stop();
+        fs.unlink(path);
+    }
+
+
+    void testDurableBarrierViaSyncService() {
+        PlatformFilesystem fs;
+        auto path = Path::parse("/tmp/solace_test_bufferedWriter5.dat").unwrap();
+        auto file = fs.create(path);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+        SyncService syncer;
+
+        BufferedWriter::Options options;
+        options.syncService = &syncer;
+
+        BufferedWriter writer(*file, allocator, 4096, options);
+
+        char msg[] = "durable";
+        CPPUNIT_ASSERT(writer.write(wrapMemory(msg, 7)).isOk());
+
+        std::atomic<int> completed(0);
+        writer.barrier().then([&completed]() { ++completed; });
+
+        waitFor(completed, 1);
+        CPPUNIT_ASSERT_EQUAL(1, completed.load());
+
+        writer.stop();
+        fs.unlink(path);
+    }
+
+
+    void testStoppedWriterRejectsWork() {
+        PlatformFilesystem fs;
+        auto path = Path::parse("/tmp/solace_test_bufferedWriter6.dat").unwrap();
+        auto file = fs.create(path);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        BufferedWriter writer(*file, allocator, 4096);
+        writer.stop();
+
+        char msg[] = "x";
+        CPPUNIT_ASSERT(writer.write(wrapMemory(msg, 1)).isError());
+
+        // Rejection happens synchronously on the calling thread:
+        std::atomic<int> rejected(0);
+        writer.barrier().onError([&rejected](Error&&) { ++rejected; });
+        CPPUNIT_ASSERT_EQUAL(1, rejected.load());
+
+        fs.unlink(path);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestBufferedWriter);
@@ -0,0 +1,120 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_connectionArena.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/connectionArena.hpp>  // Class being tested
+
+#include <solace/io/pipe.hpp>
+#include <solace/io/selector.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestConnectionArena: public CppUnit::TestFixture {
+
+    CPPUNIT_TEST_SUITE(TestConnectionArena);
+        CPPUNIT_TEST(testMessageCycle);
+        CPPUNIT_TEST(testResetReusesStorage);
+        CPPUNIT_TEST(testSelectorDrivenConnection);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testMessageCycle() {
+        MemoryManager manager(64 * 1024);
+
+        {
+            ConnectionArena arena(manager, 4096);
+            CPPUNIT_ASSERT_EQUAL(static_cast<ConnectionArena::size_type>(4096), arena.capacity());
+            CPPUNIT_ASSERT_EQUAL(static_cast<ConnectionArena::size_type>(0), arena.size());
+
+            // Receive storage, a parse pass over it and a response, all one region:
+            auto recvStorage = arena.allocate(128);
+            recvStorage.view().fill(0);
+            recvStorage.view().dataAddress()[0] = 42;
+
+            auto reader = arena.parse(recvStorage.view());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(42), reader.get().unwrap());
+
+            auto writer = arena.response(256);
+            CPPUNIT_ASSERT(writer.write(recvStorage.view().slice(0, 16)).isOk());
+            CPPUNIT_ASSERT(arena.size() >= 128 + 256);
+
+            arena.messageComplete();
+            CPPUNIT_ASSERT_EQUAL(static_cast<ConnectionArena::size_type>(0), arena.size());
+        }
+
+        // Destroying the arena returns its region to the manager wholesale:
+        CPPUNIT_ASSERT(manager.empty());
+    }
+
+    void testResetReusesStorage() {
+        MemoryManager manager(64 * 1024);
+        ConnectionArena arena(manager, 1024);
+
+        // After messageComplete() the next message lands on the same warm bytes:
+        auto first = arena.allocate(64);
+        auto* firstAddress = first.view().dataAddress();
+
+        arena.messageComplete();
+
+        auto second = arena.allocate(64);
+        CPPUNIT_ASSERT_EQUAL(firstAddress, second.view().dataAddress());
+    }
+
+    void testSelectorDrivenConnection() {
+        MemoryManager manager(64 * 1024);
+
+        // One connection object carrying its arena, reachable via Event::data:
+        struct Connection {
+            Pipe            channel;
+            ConnectionArena arena;
+        };
+
+        Connection conn{Pipe(), ConnectionArena(manager, 4096)};
+
+        auto selector = Selector::createPoll(2);
+        selector.add(conn.channel.getReadEnd().getSelectId(), Selector::Events::Read, &conn);
+
+        byte message[] = "ping";
+        conn.channel.write(wrapMemory(message));
+
+        for (auto event : selector.poll(1000)) {
+            auto* connection = static_cast<Connection*>(event.data);
+            CPPUNIT_ASSERT(connection == &conn);
+
+            auto storage = connection->arena.allocate(sizeof(message));
+            auto view = storage.view();
+            connection->channel.read(view);
+
+            auto reader = connection->arena.parse(view);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>('p'), reader.get().unwrap());
+
+            connection->arena.messageComplete();
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<ConnectionArena::size_type>(0), conn.arena.size());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestConnectionArena);
@@ -0,0 +1,173 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_directoryReader.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/directoryReader.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <cstdio>
+#include <mutex>
+#include <set>
+#include <string>
+
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+class TestDirectoryReader : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestDirectoryReader);
+        CPPUNIT_TEST(testOpeningMissingDirectoryThrows);
+        CPPUNIT_TEST(testBulkEnumeration);
+        CPPUNIT_TEST(testResumeAcrossSmallEntryBatches);
+        CPPUNIT_TEST(testSerialWalk);
+        CPPUNIT_TEST(testParallelWalk);
+    CPPUNIT_TEST_SUITE_END();
+
+    static constexpr int kFileCount = 100;
+
+    std::string _root;
+
+public:
+
+    void setUp() override {
+        char name[] = "/tmp/solace_dirreader_XXXXXX";
+        CPPUNIT_ASSERT(mkdtemp(name) != nullptr);
+        _root = name;
+
+        for (int i = 0; i < kFileCount; ++i) {
+            char path[256];
+            snprintf(path, sizeof(path), "%s/file-%03d", _root.c_str(), i);
+            ::close(::open(path, O_CREAT | O_WRONLY, 0644));
+        }
+
+        CPPUNIT_ASSERT_EQUAL(0, mkdir((_root + "/sub").c_str(), 0755));
+        ::close(::open((_root + "/sub/nested").c_str(), O_CREAT | O_WRONLY, 0644));
+    }
+
+    void tearDown() override {
+        auto const command = "rm -rf " + _root;
+        CPPUNIT_ASSERT_EQUAL(0, system(command.c_str()));
+    }
+
+    void testOpeningMissingDirectoryThrows() {
+        CPPUNIT_ASSERT_THROW(DirectoryReader(Path::parse("/no/such/directory").unwrap()),
+                             IOException);
+    }
+
+    void testBulkEnumeration() {
+        DirectoryReader reader(Path::parse(_root.c_str()).unwrap());
+
+        byte arenaStorage[16 * 1024];
+        auto arena = wrapMemory(arenaStorage, sizeof(arenaStorage));
+        DirectoryReader::Entry entries[256];
+
+        std::set<std::string> names;
+        int filesSeen = 0;
+        int directoriesSeen = 0;
+
+        for (;;) {
+            auto const count = reader.read(arena, arrayView(entries));
+            if (count == 0) {
+                break;
+            }
+
+            for (DirectoryReader::size_type i = 0; i < count; ++i) {
+                names.emplace(entries[i].name.data(), entries[i].name.size());
+                if (entries[i].type == DirectoryReader::Type::File) { filesSeen += 1; }
+                if (entries[i].type == DirectoryReader::Type::Directory) { directoriesSeen += 1; }
+            }
+        }
+
+        // "." and ".." are filtered out:
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(kFileCount + 1), names.size());
+        CPPUNIT_ASSERT_EQUAL(kFileCount, filesSeen);
+        CPPUNIT_ASSERT_EQUAL(1, directoriesSeen);
+        CPPUNIT_ASSERT(names.count("file-000") == 1);
+        CPPUNIT_ASSERT(names.count("sub") == 1);
+    }
+
+    void testResumeAcrossSmallEntryBatches() {
+        DirectoryReader reader(Path::parse(_root.c_str()).unwrap());
+
+        byte arenaStorage[16 * 1024];
+        auto arena = wrapMemory(arenaStorage, sizeof(arenaStorage));
+
+        // An entries array far smaller than a directory-full forces the
+        // reader to park its cursor mid-batch and resume on the next call:
+        DirectoryReader::Entry entries[7];
+
+        std::set<std::string> names;
+        for (;;) {
+            auto const count = reader.read(arena, arrayView(entries));
+            if (count == 0) {
+                break;
+            }
+
+            for (DirectoryReader::size_type i = 0; i < count; ++i) {
+                names.emplace(entries[i].name.data(), entries[i].name.size());
+            }
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(kFileCount + 1), names.size());
+    }
+
+    void testSerialWalk() {
+        std::atomic<int> visited(0);
+
+        DirectoryReader::walk(Path::parse(_root.c_str()).unwrap(),
+            [&visited](Path const&, DirectoryReader::Entry const&) {
+                visited += 1;
+            });
+
+        CPPUNIT_ASSERT_EQUAL(kFileCount + 2, visited.load());  // files + sub + nested
+    }
+
+    void testParallelWalk() {
+        std::mutex guard;
+        std::set<std::string> seen;
+
+        DirectoryReader::walk(Path::parse(_root.c_str()).unwrap(),
+            [&](Path const& directory, DirectoryReader::Entry const& entry) {
+                std::lock_guard<std::mutex> lock(guard);
+                auto const dir = directory.toString();
+                seen.emplace(std::string(dir.c_str()) + "/"
+                             + std::string(entry.name.data(), entry.name.size()));
+            },
+            4);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(kFileCount + 2), seen.size());
+        CPPUNIT_ASSERT(seen.count(_root + "/sub/nested") == 1);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestDirectoryReader);
+
+#endif  // SOLACE_PLATFORM_LINUX
@@ -0,0 +1,99 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_eventFd.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/eventFd.hpp>  // Class being tested
+
+#include <solace/io/selector.hpp>
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <thread>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+class TestEventFd : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestEventFd);
+        CPPUNIT_TEST(testTakeOnQuietEventReturnsZero);
+        CPPUNIT_TEST(testEventModeClearsWholeCount);
+        CPPUNIT_TEST(testSemaphoreModeConsumesOnePerTake);
+        CPPUNIT_TEST(testWakeupThroughSelector);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testTakeOnQuietEventReturnsZero() {
+        auto event = EventFd::create();
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), event.take());
+    }
+
+    void testEventModeClearsWholeCount() {
+        auto event = EventFd::create();
+
+        event.notify();
+        event.notify();
+        event.notify(5);
+
+        // One take drains everything posted since the last one:
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(7), event.take());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), event.take());
+    }
+
+    void testSemaphoreModeConsumesOnePerTake() {
+        auto workItems = EventFd::create(EventFd::Mode::Semaphore);
+
+        workItems.notify(3);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), workItems.take());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), workItems.take());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), workItems.take());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), workItems.take());
+    }
+
+    void testWakeupThroughSelector() {
+        auto event = EventFd::create();
+
+        auto selector = Selector::createEPoll(2);
+        selector.add(&event, Selector::Events::Read);
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(0), selector.poll(0).size());
+
+        // A notify from another thread makes the fd readable:
+        std::thread poster([&event]() {
+            event.notify();
+        });
+
+        CPPUNIT_ASSERT(selector.poll(1000).size() > 0);
+        poster.join();
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), event.take());
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(0), selector.poll(0).size());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestEventFd);
+
+#endif  // SOLACE_PLATFORM_LINUX
@@ -0,0 +1,161 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_flushPolicy.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/flushPolicy.hpp>  // Class being tested
+#include <solace/memoryManager.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+class TestFlushPolicy : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestFlushPolicy);
+        CPPUNIT_TEST(testMessageWatermark);
+        CPPUNIT_TEST(testByteWatermark);
+        CPPUNIT_TEST(testDeadlineFlushesLoneMessage);
+        CPPUNIT_TEST(testExplicitFlushDisarmsDeadline);
+        CPPUNIT_TEST(testZeroDelayNeverSchedules);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+
+    MemoryManager   _allocator {4096};
+
+public:
+
+    void testMessageWatermark() {
+        TimerWheel timers(100);
+        WriteBuffer egress(_allocator.create(1024));
+
+        int flushes = 0;
+        FlushPolicy policy(egress, timers, FlushPolicy::Options{512, 4, 1000},
+                           FlushPolicy::FlushHandler([&]() { ++flushes; egress.clear(); }));
+
+        byte payload[16] = {0};
+        for (int i = 0; i < 3; ++i) {
+            egress.write(wrapMemory(payload));
+            policy.onMessage();
+        }
+        CPPUNIT_ASSERT_EQUAL(0, flushes);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(3), policy.batched());
+
+        egress.write(wrapMemory(payload));
+        policy.onMessage();
+        CPPUNIT_ASSERT_EQUAL(1, flushes);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), policy.batched());
+        CPPUNIT_ASSERT(timers.empty());  // The flush cancelled the deadline.
+    }
+
+
+    void testByteWatermark() {
+        TimerWheel timers(100);
+        WriteBuffer egress(_allocator.create(1024));
+
+        int flushes = 0;
+        FlushPolicy policy(egress, timers, FlushPolicy::Options{32, 64, 1000},
+                           FlushPolicy::FlushHandler([&]() { ++flushes; egress.clear(); }));
+
+        byte payload[16] = {0};
+        egress.write(wrapMemory(payload));
+        policy.onMessage();
+        CPPUNIT_ASSERT_EQUAL(0, flushes);
+
+        egress.write(wrapMemory(payload));  // 32 bytes staged - the byte trigger trips.
+        policy.onMessage();
+        CPPUNIT_ASSERT_EQUAL(1, flushes);
+    }
+
+
+    void testDeadlineFlushesLoneMessage() {
+        TimerWheel timers(100);
+        WriteBuffer egress(_allocator.create(1024));
+
+        int flushes = 0;
+        FlushPolicy policy(egress, timers, FlushPolicy::Options{512, 64, 500},
+                           FlushPolicy::FlushHandler([&]() { ++flushes; egress.clear(); }));
+
+        byte payload[16] = {0};
+        egress.write(wrapMemory(payload));
+        policy.onMessage();
+        CPPUNIT_ASSERT_EQUAL(0, flushes);
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(1), timers.size());
+
+        // Virtual time passes the deadline; the loop routes the event back:
+        timers.advance(600);
+        Selector::Event expired[4] = {};
+        const auto count = timers.expire(arrayView(expired));
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(1), count);
+        static_cast<FlushPolicy*>(expired[0].data)->expired();
+
+        CPPUNIT_ASSERT_EQUAL(1, flushes);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), policy.batched());
+    }
+
+
+    void testExplicitFlushDisarmsDeadline() {
+        TimerWheel timers(100);
+        WriteBuffer egress(_allocator.create(1024));
+
+        int flushes = 0;
+        FlushPolicy policy(egress, timers, FlushPolicy::Options{512, 64, 500},
+                           FlushPolicy::FlushHandler([&]() { ++flushes; egress.clear(); }));
+
+        byte payload[16] = {0};
+        egress.write(wrapMemory(payload));
+        policy.onMessage();
+
+        policy.flush();
+        CPPUNIT_ASSERT_EQUAL(1, flushes);
+        CPPUNIT_ASSERT(timers.empty());
+
+        // Nothing batched - a second flush is a no-op:
+        policy.flush();
+        CPPUNIT_ASSERT_EQUAL(1, flushes);
+    }
+
+
+    void testZeroDelayNeverSchedules() {
+        TimerWheel timers(100);
+        WriteBuffer egress(_allocator.create(1024));
+
+        int flushes = 0;
+        FlushPolicy policy(egress, timers, FlushPolicy::Options{512, 2, 0},
+                           FlushPolicy::FlushHandler([&]() { ++flushes; egress.clear(); }));
+
+        byte payload[16] = {0};
+        egress.write(wrapMemory(payload));
+        policy.onMessage();
+        CPPUNIT_ASSERT(timers.empty());
+
+        egress.write(wrapMemory(payload));
+        policy.onMessage();
+        CPPUNIT_ASSERT_EQUAL(1, flushes);
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFlushPolicy);
+#endif  // SOLACE_PLATFORM_LINUX
@@ -0,0 +1,141 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_futexCell.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/futexCell.hpp>  // Class being tested
+
+#include <solace/io/sharedMemory.hpp>
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+class TestFutexCell : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestFutexCell);
+        CPPUNIT_TEST(testPlacementValidation);
+        CPPUNIT_TEST(testAtomicAccessors);
+        CPPUNIT_TEST(testWaitTimesOut);
+        CPPUNIT_TEST(testWaitOnStaleValueReturnsImmediately);
+        CPPUNIT_TEST(testCrossProcessWake);
+        CPPUNIT_TEST(testWakeAllRousesEverySleeper);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testPlacementValidation() {
+        auto region = SharedMemory::createAnon(4096, SharedMemory::Access::Shared);
+
+        CPPUNIT_ASSERT_NO_THROW(FutexCell::at(region.view()));
+        CPPUNIT_ASSERT_THROW(FutexCell::at(region.view().slice(1, 5)), IllegalArgumentException);
+        CPPUNIT_ASSERT_THROW(FutexCell::at(region.view().slice(0, 2)), IllegalArgumentException);
+    }
+
+    void testAtomicAccessors() {
+        auto region = SharedMemory::createAnon(4096, SharedMemory::Access::Shared);
+        auto& cell = FutexCell::at(region.view());
+
+        cell.initialize(3);
+        CPPUNIT_ASSERT_EQUAL(static_cast<FutexCell::value_type>(3), cell.load());
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<FutexCell::value_type>(3), cell.exchange(5));
+        CPPUNIT_ASSERT_EQUAL(static_cast<FutexCell::value_type>(5), cell.fetchAdd(2));
+        CPPUNIT_ASSERT_EQUAL(static_cast<FutexCell::value_type>(7), cell.load());
+    }
+
+    void testWaitTimesOut() {
+        auto region = SharedMemory::createAnon(4096, SharedMemory::Access::Shared);
+        auto& cell = FutexCell::at(region.view());
+        cell.initialize(0);
+
+        CPPUNIT_ASSERT_EQUAL(false, cell.wait(0, 50));
+    }
+
+    void testWaitOnStaleValueReturnsImmediately() {
+        auto region = SharedMemory::createAnon(4096, SharedMemory::Access::Shared);
+        auto& cell = FutexCell::at(region.view());
+        cell.initialize(1);
+
+        // The caller expects 0 but the cell already moved on - no sleep:
+        CPPUNIT_ASSERT_EQUAL(true, cell.wait(0, 5000));
+    }
+
+    void testCrossProcessWake() {
+        auto region = SharedMemory::createAnon(4096, SharedMemory::Access::Shared);
+        auto& cell = FutexCell::at(region.view());
+        cell.initialize(0);
+
+        auto childPid = fork();
+        CPPUNIT_ASSERT(childPid >= 0);
+
+        if (childPid == 0) {  // Child: sleep until the parent publishes
+            auto& childCell = FutexCell::at(region.view());
+            auto const changed = childCell.wait(0, 5000);
+            _exit((changed && childCell.load() == 7) ? 0 : 1);
+        }
+
+        usleep(50 * 1000);  // Give the child time to get into the wait
+        cell.store(7);
+        cell.wakeOne();
+
+        int status = 0;
+        waitpid(childPid, &status, 0);
+        CPPUNIT_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+
+    void testWakeAllRousesEverySleeper() {
+        auto region = SharedMemory::createAnon(4096, SharedMemory::Access::Shared);
+        auto& cell = FutexCell::at(region.view());
+        cell.initialize(0);
+
+        pid_t sleepers[3];
+        for (auto& pid : sleepers) {
+            pid = fork();
+            CPPUNIT_ASSERT(pid >= 0);
+
+            if (pid == 0) {
+                auto& childCell = FutexCell::at(region.view());
+                _exit(childCell.wait(0, 5000) ? 0 : 1);
+            }
+        }
+
+        usleep(100 * 1000);
+        cell.store(1);
+        cell.wakeAll();
+
+        for (auto pid : sleepers) {
+            int status = 0;
+            waitpid(pid, &status, 0);
+            CPPUNIT_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+        }
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFutexCell);
+
+#endif  // SOLACE_PLATFORM_LINUX
@@ -0,0 +1,161 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_futureTimeouts.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/futureTimeouts.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <memory>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+class TestFutureTimeouts : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestFutureTimeouts);
+        CPPUNIT_TEST(testTimeoutFiresOnError);
+        CPPUNIT_TEST(testCompletionBeatsDeadline);
+        CPPUNIT_TEST(testSourceErrorPassesThrough);
+        CPPUNIT_TEST(testVoidFuture);
+        CPPUNIT_TEST(testTimeoutReleasesChain);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    // All tests run on virtual time: TimerWheel::advance() plays the clock,
+    // so nothing here sleeps.
+
+    void testTimeoutFiresOnError() {
+        TimerWheel timers(100);
+        FutureTimeouts timeouts(timers);
+
+        Promise<int> promise;
+        int got = 0;
+        int failed = 0;
+        timeouts.within(promise.getFuture(), 1000)
+            .then([&got](int value) { got = value; })
+            .onError([&failed](Error&& ) { failed = 1; });
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<FutureTimeouts::size_type>(1), timeouts.size());
+
+        timers.advance(900);
+        CPPUNIT_ASSERT_EQUAL(static_cast<FutureTimeouts::size_type>(0), timeouts.expire());
+        CPPUNIT_ASSERT_EQUAL(0, failed);
+
+        timers.advance(200);
+        CPPUNIT_ASSERT_EQUAL(static_cast<FutureTimeouts::size_type>(1), timeouts.expire());
+        CPPUNIT_ASSERT_EQUAL(1, failed);
+        CPPUNIT_ASSERT(timeouts.empty());
+
+        // Late completion of the source is ignored:
+        promise.setValue(42);
+        CPPUNIT_ASSERT_EQUAL(0, got);
+    }
+
+
+    void testCompletionBeatsDeadline() {
+        TimerWheel timers(100);
+        FutureTimeouts timeouts(timers);
+
+        Promise<int> promise;
+        int got = 0;
+        int failed = 0;
+        timeouts.within(promise.getFuture(), 1000)
+            .then([&got](int value) { got = value; })
+            .onError([&failed](Error&& ) { failed = 1; });
+
+        promise.setValue(7);
+        CPPUNIT_ASSERT_EQUAL(7, got);
+
+        // The deadline entry stays, inert, until the wheel reclaims it:
+        CPPUNIT_ASSERT_EQUAL(static_cast<FutureTimeouts::size_type>(1), timeouts.size());
+        timers.advance(2000);
+        CPPUNIT_ASSERT_EQUAL(static_cast<FutureTimeouts::size_type>(1), timeouts.expire());
+        CPPUNIT_ASSERT_EQUAL(0, failed);
+        CPPUNIT_ASSERT(timeouts.empty());
+    }
+
+
+    void testSourceErrorPassesThrough() {
+        TimerWheel timers(100);
+        FutureTimeouts timeouts(timers);
+
+        Promise<int> promise;
+        int failed = 0;
+        timeouts.within(promise.getFuture(), 1000)
+            .onError([&failed](Error&& ) -> int { failed = 1; return 0; });
+
+        promise.setError(Error("rpc failed"));
+        CPPUNIT_ASSERT_EQUAL(1, failed);
+    }
+
+
+    void testVoidFuture() {
+        TimerWheel timers(100);
+        FutureTimeouts timeouts(timers);
+
+        Promise<void> completing;
+        int done = 0;
+        timeouts.within(completing.getFuture(), 500).then([&done]() { done = 1; });
+        completing.setValue();
+        CPPUNIT_ASSERT_EQUAL(1, done);
+
+        Promise<void> expiring;
+        int failed = 0;
+        timeouts.within(expiring.getFuture(), 500)
+            .onError([&failed](Error&& ) { failed = 1; });
+
+        timers.advance(600);
+        timeouts.expire();
+        CPPUNIT_ASSERT_EQUAL(1, failed);
+        CPPUNIT_ASSERT(timeouts.empty());
+    }
+
+
+    void testTimeoutReleasesChain() {
+        TimerWheel timers(100);
+        FutureTimeouts timeouts(timers);
+
+        // The handler's captures stand in for the wrapped chain's storage:
+        auto watched = std::make_shared<int>(0);
+        std::weak_ptr<int> watch = watched;
+
+        Promise<int> promise;  // Never completed.
+        timeouts.within(promise.getFuture(), 300)
+            .onError([watched](Error&& ) -> int { return 0; });
+        watched.reset();
+
+        CPPUNIT_ASSERT(!watch.expired());
+        timers.advance(400);
+        timeouts.expire();
+
+        // The deadline freed the whole timed-out chain even though the
+        // source promise is still pending:
+        CPPUNIT_ASSERT(watch.expired());
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFutureTimeouts);
+#endif  // SOLACE_PLATFORM_LINUX
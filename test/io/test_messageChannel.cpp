@@ -0,0 +1,177 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_messageChannel.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/messageChannel.hpp>  // Class being tested
+
+#include <solace/io/pipe.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <thread>
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestMessageChannel : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestMessageChannel);
+        CPPUNIT_TEST(testBoundariesPreserved);
+        CPPUNIT_TEST(testBothDirections);
+        CPPUNIT_TEST(testOversizedMessageRejected);
+        CPPUNIT_TEST(testBatchOverflowAutoFlushes);
+        CPPUNIT_TEST(testClosedPeerSurfacesAsError);
+    CPPUNIT_TEST_SUITE_END();
+
+    /** An in-process bridge: two pipes, each side reading one and writing the other. */
+    struct Bridge {
+        Pipe ab;
+        Pipe ba;
+        Duplex sideA;
+        Duplex sideB;
+
+        Bridge() :
+            sideA(::dup(ba.getReadEnd().getSelectId()), ::dup(ab.getWriteEnd().getSelectId())),
+            sideB(::dup(ab.getReadEnd().getSelectId()), ::dup(ba.getWriteEnd().getSelectId()))
+        {}
+    };
+
+public:
+
+    void testBoundariesPreserved() {
+        Bridge bridge;
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        MessageChannel a(bridge.sideA, allocator, 4096);
+        MessageChannel b(bridge.sideB, allocator, 4096);
+
+        char first[] = "hello";
+        char third[] = "third message with some more bytes in it";
+        CPPUNIT_ASSERT(a.sendMessage(wrapMemory(first, 5)).isOk());
+        CPPUNIT_ASSERT(a.sendMessage(ImmutableMemoryView()).isOk());
+        CPPUNIT_ASSERT(a.sendMessage(wrapMemory(third, strlen(third))).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(3), a.pendingMessages());
+
+        // One flush pushes the whole batch through the channel:
+        CPPUNIT_ASSERT(a.flushMessages().isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), a.pendingMessages());
+
+        auto received = b.receiveMessage();
+        CPPUNIT_ASSERT(received.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MessageChannel::size_type>(5), received.unwrap().size());
+        CPPUNIT_ASSERT(memcmp(received.unwrap().dataAddress(), "hello", 5) == 0);
+
+        // The empty message survives as a message, not as nothing:
+        auto empty = b.receiveMessage();
+        CPPUNIT_ASSERT(empty.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MessageChannel::size_type>(0), empty.unwrap().size());
+
+        auto last = b.receiveMessage();
+        CPPUNIT_ASSERT(last.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MessageChannel::size_type>(strlen(third)), last.unwrap().size());
+        CPPUNIT_ASSERT(memcmp(last.unwrap().dataAddress(), third, strlen(third)) == 0);
+    }
+
+
+    void testBothDirections() {
+        Bridge bridge;
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        MessageChannel a(bridge.sideA, allocator, 1024);
+        MessageChannel b(bridge.sideB, allocator, 1024);
+
+        char request[] = "ping";
+        CPPUNIT_ASSERT(a.sendMessage(wrapMemory(request, 4)).isOk());
+        CPPUNIT_ASSERT(a.flushMessages().isOk());
+
+        auto received = b.receiveMessage();
+        CPPUNIT_ASSERT(received.isOk());
+        CPPUNIT_ASSERT(memcmp(received.unwrap().dataAddress(), "ping", 4) == 0);
+
+        char reply[] = "pong";
+        CPPUNIT_ASSERT(b.sendMessage(wrapMemory(reply, 4)).isOk());
+        CPPUNIT_ASSERT(b.flushMessages().isOk());
+
+        auto response = a.receiveMessage();
+        CPPUNIT_ASSERT(response.isOk());
+        CPPUNIT_ASSERT(memcmp(response.unwrap().dataAddress(), "pong", 4) == 0);
+    }
+
+
+    void testOversizedMessageRejected() {
+        Bridge bridge;
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        MessageChannel a(bridge.sideA, allocator, 256);
+
+        byte big[512];
+        CPPUNIT_ASSERT(a.sendMessage(wrapMemory(big)).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), a.pendingMessages());
+    }
+
+
+    void testBatchOverflowAutoFlushes() {
+        Bridge bridge;
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        MessageChannel a(bridge.sideA, allocator, 4096);
+        MessageChannel b(bridge.sideB, allocator, 4096);
+
+        // More than one batch worth of traffic; a reader drains concurrently
+        // so the auto-flush never blocks on a full pipe:
+        std::thread drain([&b]() {
+            for (int i = 0; i < 100; ++i) {
+                auto message = b.receiveMessage();
+                CPPUNIT_ASSERT(message.isOk());
+                CPPUNIT_ASSERT_EQUAL(static_cast<MessageChannel::size_type>(1000),
+                                     message.unwrap().size());
+            }
+        });
+
+        byte payload[1000];
+        memset(payload, 0x5A, sizeof(payload));
+        for (int i = 0; i < 100; ++i) {
+            CPPUNIT_ASSERT(a.sendMessage(wrapMemory(payload)).isOk());
+        }
+        CPPUNIT_ASSERT(a.flushMessages().isOk());
+
+        drain.join();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), b.stats().framesCorrupted);
+    }
+
+
+    void testClosedPeerSurfacesAsError() {
+        Bridge bridge;
+        MemoryManager allocator(4 * 1024 * 1024);
+
+        MessageChannel b(bridge.sideB, allocator, 256);
+
+        // Close every write end feeding side B:
+        bridge.sideA.getWriteEnd().close();
+        bridge.ab.getWriteEnd().close();
+
+        CPPUNIT_ASSERT(b.receiveMessage().isError());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestMessageChannel);
@@ -32,6 +32,8 @@
 #include <signal.h>
 #include <sys/time.h>
 #include <memory.h>
+#include <string>
+#include <sys/stat.h>
 
 
 using namespace Solace;
@@ -43,10 +45,14 @@ class TestPlatformFs : public CppUnit::TestFixture  {
     CPPUNIT_TEST_SUITE(TestPlatformFs);
         CPPUNIT_TEST(testCreation);
         CPPUNIT_TEST(testCreationAndRemoval);
+        CPPUNIT_TEST(testStringViewOpenAndCreate);
         CPPUNIT_TEST(testGetExecPath);
         CPPUNIT_TEST(testThereIsADirectory);
         CPPUNIT_TEST(testWorkingDirectory);
         CPPUNIT_TEST(testTemp);
+        CPPUNIT_TEST(testDirectoryRelativeOpen);
+        CPPUNIT_TEST(testDirectoryCacheInvalidation);
+        CPPUNIT_TEST(testTreeOperations);
     CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -174,6 +180,48 @@ public:
         CPPUNIT_ASSERT(!fs.exists(filename));
     }
 
+    void testStringViewOpenAndCreate() {
+        // The segment-naming hot loop: UUID straight into a stack buffer,
+        // the resulting view straight into the syscall - no Path, no String.
+        const auto fileUID = UUID::random();
+
+        char nameStore[5 + UUID::StringSize];
+        memcpy(nameStore, "test-", 5);
+        const auto uuidText = fileUID.formatInto(wrapMemory(nameStore + 5, UUID::StringSize));
+        CPPUNIT_ASSERT(uuidText.isOk());
+        const StringView filename(nameStore, sizeof(nameStore));
+
+        auto fs = PlatformFilesystem();
+        const auto cleanupPath = Path::parse(filename).unwrap();
+        if (fs.exists(cleanupPath)) {
+            fs.unlink(cleanupPath);
+        }
+
+        const auto& fileUIDBytes = fileUID.view();
+        {
+            auto f = fs.create(filename);
+            CPPUNIT_ASSERT(fs.exists(cleanupPath));
+            CPPUNIT_ASSERT(f.write(fileUIDBytes).isOk());
+        }
+
+        // Creating an existing file fails the same way the Path overload does:
+        CPPUNIT_ASSERT_THROW(auto f = fs.create(filename), IOException);
+
+        {
+            auto f = fs.open(filename);
+
+            WriteBuffer readBuffer(_memoryManager.create(fileUIDBytes.size()));
+            const auto read = f.read(readBuffer);
+            CPPUNIT_ASSERT(read.isOk());
+            CPPUNIT_ASSERT_EQUAL(fileUIDBytes.size(), static_cast<MemoryView::size_type>(read.unwrap()));
+            readBuffer.flip();
+            CPPUNIT_ASSERT(fileUIDBytes == readBuffer.viewRemaining());
+        }
+
+        CPPUNIT_ASSERT(fs.unlink(cleanupPath));
+        CPPUNIT_ASSERT(!fs.exists(cleanupPath));
+    }
+
     void testGetExecPath() {
         auto fs = PlatformFilesystem();
 
@@ -232,6 +280,112 @@ public:
             CPPUNIT_ASSERT(fileUIDBytes == readBuffer.viewRemaining());
         }
     }
+
+    void testDirectoryRelativeOpen() {
+        const auto fileUID = UUID::random();
+        const auto filename = String::join("-", {"test", fileUID.toString()});
+        const auto& fileUIDBytes = fileUID.view();
+
+        auto fs = PlatformFilesystem();
+        PlatformFilesystem::Directory dir(fs.getWorkingDirectory());
+
+        {
+            auto f = dir.create(filename.view());
+
+            const auto written = f.write(fileUIDBytes);
+            CPPUNIT_ASSERT(written.isOk());
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), dir.cachedCount());
+
+        {  // Re-opening by name is a cache hit and reads from the start:
+            auto f = dir.open(filename.view());
+
+            WriteBuffer readBuffer(_memoryManager.create(fileUIDBytes.size()));
+            const auto read = f.read(readBuffer);
+            CPPUNIT_ASSERT(read.isOk());
+            readBuffer.flip();
+
+            CPPUNIT_ASSERT(fileUIDBytes == readBuffer.viewRemaining());
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), dir.cachedCount());
+
+        {  // Exclusive creation of an existing file is an error:
+            CPPUNIT_ASSERT_THROW(dir.create(filename.view()), IOException);
+        }
+
+        {  // So is opening a file that is not there:
+            CPPUNIT_ASSERT_THROW(dir.open(StringView("does-not-exist")), IOException);
+        }
+
+        CPPUNIT_ASSERT(fs.unlink(Path::parse(filename.view()).unwrap()));
+    }
+
+    void testDirectoryCacheInvalidation() {
+        const auto fileUID = UUID::random();
+        const auto filename = String::join("-", {"test", fileUID.toString()});
+
+        auto fs = PlatformFilesystem();
+        // A cache of one descriptor: the second create evicts the first.
+        PlatformFilesystem::Directory dir(fs.getWorkingDirectory(), 1);
+
+        const auto otherName = String::join("-", {filename, "b"});
+        { auto f = dir.create(filename.view()); (void) f; }
+        { auto f = dir.create(otherName.view()); (void) f; }
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), dir.cachedCount());
+
+        // invalidate() retires cached descriptors without closing handed-out files:
+        dir.invalidate();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), dir.cachedCount());
+
+        // Opens after invalidation fall back to openat() and repopulate the cache:
+        { auto f = dir.open(filename.view()); (void) f; }
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), dir.cachedCount());
+
+        CPPUNIT_ASSERT(fs.unlink(Path::parse(filename.view()).unwrap()));
+        CPPUNIT_ASSERT(fs.unlink(Path::parse(otherName.view()).unwrap()));
+    }
+
+    void testTreeOperations() {
+        const auto dirUID = UUID::random();
+        const auto rootName = String::join("-", {"test-tree", dirUID.toString()});
+        const std::string base(rootName.c_str());
+
+        CPPUNIT_ASSERT_EQUAL(0, ::mkdir(base.c_str(), 0700));
+        CPPUNIT_ASSERT_EQUAL(0, ::mkdir((base + "/sub").c_str(), 0700));
+        CPPUNIT_ASSERT_EQUAL(0, ::mkdir((base + "/sub/deep").c_str(), 0700));
+
+        auto fs = PlatformFilesystem();
+        for (auto name : {"/one.log", "/keep.dat", "/sub/two.log", "/sub/deep/three.log"}) {
+            auto f = fs.create(StringView((base + name).c_str()));
+            (void) f;
+        }
+
+        // Retention pass: drop the logs, keep the data, two workers:
+        const auto root = Path::parse(rootName.view()).unwrap();
+        auto applied = fs.applyTree(root,
+                [](Path const&, DirectoryReader::Entry const& entry) {
+                    return entry.name.endsWith(".log")
+                            ? PlatformFilesystem::TreeOp::Remove
+                            : PlatformFilesystem::TreeOp::Keep;
+                }, 2);
+
+        CPPUNIT_ASSERT(applied.isOk());
+        const auto summary = applied.unwrap();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(3), summary.entriesRemoved);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), summary.entriesKept);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), summary.failures);
+        CPPUNIT_ASSERT(fs.exists(Path::parse(StringView((base + "/keep.dat").c_str())).unwrap()));
+
+        // Full removal takes the survivors, the directories and the root:
+        auto removed = fs.removeTree(root, 2);
+        CPPUNIT_ASSERT(removed.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), removed.unwrap().entriesRemoved);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(3), removed.unwrap().directoriesRemoved);
+        CPPUNIT_ASSERT(!fs.exists(root));
+
+        // A root that is gone is an error, not a zero summary:
+        CPPUNIT_ASSERT(fs.removeTree(root).isError());
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestPlatformFs);
@@ -27,6 +27,9 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <chrono>
+#include <thread>
+
 
 using namespace Solace;
 using namespace Solace::IO;
@@ -42,6 +45,12 @@ class TestEPollSelector : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testRemoval);
         CPPUNIT_TEST(testRemovalOfNotAddedItem);
         CPPUNIT_TEST(testReadPolling);
+        CPPUNIT_TEST(testDataPointerStableAcrossChurn);
+        CPPUNIT_TEST(testEdgeTriggeredPolling);
+        CPPUNIT_TEST(testOneShotRearming);
+        CPPUNIT_TEST(testPollInto);
+        CPPUNIT_TEST(testSpinWindowHybrid);
+        CPPUNIT_TEST(testCreateBestCalibrates);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -58,7 +67,7 @@ public:
         CPPUNIT_ASSERT_EQUAL(static_cast<uint>(1), i.size());
 
         auto ev = *i;
-//        CPPUNIT_ASSERT_EQUAL(static_cast<void*>(&p.getWriteEnd()), ev.data);
+        CPPUNIT_ASSERT_EQUAL(static_cast<void*>(static_cast<ISelectable*>(&p.getWriteEnd())), ev.data);
         CPPUNIT_ASSERT_EQUAL(p.getWriteEnd().getSelectId(), ev.fd);
     }
 
@@ -82,7 +91,7 @@ public:
         CPPUNIT_ASSERT(i != i.end());
 
         auto ev = *i;
-//        CPPUNIT_ASSERT_EQUAL(static_cast<void*>(&p.getReadEnd()), ev.data);
+        CPPUNIT_ASSERT_EQUAL(static_cast<void*>(static_cast<ISelectable*>(&p.getReadEnd())), ev.data);
         CPPUNIT_ASSERT_EQUAL(p.getReadEnd().getSelectId(), ev.fd);
 
         char buff[100];
@@ -100,6 +109,82 @@ public:
     }
 
 
+    void testDataPointerStableAcrossChurn() {
+        // The kernel holds a pointer to the registration entry, so the
+        // entry must not move when other registrations come and go:
+        Pipe pipes[8];
+        int tags[8];
+
+        auto s = Selector::createEPoll(4);
+        for (int k = 0; k < 8; ++k) {
+            s.add(pipes[k].getWriteEnd().getSelectId(), Selector::Write, &tags[k]);
+        }
+
+        // Churn: removing early registrations must not shift the rest.
+        s.remove(pipes[0].getWriteEnd().getSelectId());
+        s.remove(pipes[3].getWriteEnd().getSelectId());
+
+        int seen = 0;
+        for (auto ev : s.poll(100)) {
+            CPPUNIT_ASSERT(ev.data != nullptr);
+            const auto tagIndex = static_cast<int*>(ev.data) - tags;
+            CPPUNIT_ASSERT(tagIndex >= 0 && tagIndex < 8);
+            CPPUNIT_ASSERT(tagIndex != 0 && tagIndex != 3);
+            CPPUNIT_ASSERT_EQUAL(pipes[tagIndex].getWriteEnd().getSelectId(), ev.fd);
+            ++seen;
+        }
+
+        CPPUNIT_ASSERT(seen > 0);
+    }
+
+
+    void testEdgeTriggeredPolling() {
+        Pipe p;
+
+        auto s = Selector::createEPoll(1);
+        s.add(&p.getReadEnd(), Selector::Read | Selector::EdgeTriggered);
+
+        char msg[] = "message";
+        CPPUNIT_ASSERT(p.write(wrapMemory(msg)).isOk());
+
+        auto i = s.poll(1);
+        CPPUNIT_ASSERT(i != i.end());
+
+        // The data is still in the pipe but no new edge occured - no wake up:
+        i = s.poll(1);
+        CPPUNIT_ASSERT(i == i.end());
+
+        // A new write is a new edge:
+        CPPUNIT_ASSERT(p.write(wrapMemory(msg)).isOk());
+        i = s.poll(1);
+        CPPUNIT_ASSERT(i != i.end());
+    }
+
+
+    void testOneShotRearming() {
+        Pipe p;
+
+        auto s = Selector::createEPoll(1);
+        s.add(&p.getReadEnd(), Selector::Read | Selector::OneShot);
+
+        char msg[] = "message";
+        CPPUNIT_ASSERT(p.write(wrapMemory(msg)).isOk());
+
+        auto i = s.poll(1);
+        CPPUNIT_ASSERT(i != i.end());
+
+        // The registration is disarmed after the event even though data remains:
+        i = s.poll(1);
+        CPPUNIT_ASSERT(i == i.end());
+
+        // Re-adding the same fd re-arms it:
+        s.add(&p.getReadEnd(), Selector::Read | Selector::OneShot);
+        i = s.poll(1);
+        CPPUNIT_ASSERT(i != i.end());
+        CPPUNIT_ASSERT_EQUAL(p.getReadEnd().getSelectId(), (*i).fd);
+    }
+
+
     void testEmptyPolling() {
         Selector s = Selector::createEPoll(3);
 
@@ -133,6 +218,84 @@ public:
         }
     }
 
+    void testPollInto() {
+        Pipe p;
+
+        auto s = Selector::createEPoll(5);
+        s.add(&p.getReadEnd(), Selector::Read);
+        s.add(&p.getWriteEnd(), Selector::Write);
+
+        char msg[] = "message";
+        CPPUNIT_ASSERT(p.write(wrapMemory(msg)).isOk());
+
+        // Both ends are ready and reported by a single bulk call:
+        Selector::Event events[4];
+        const auto nbReady = s.pollInto(arrayView(events), 1);
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(2), nbReady);
+
+        // A buffer smaller then the ready set truncates the batch:
+        Selector::Event single[1];
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(1), s.pollInto(arrayView(single), 1));
+
+        // An empty buffer reports nothing:
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(0),
+                             s.pollInto(ArrayView<Selector::Event>(), 1));
+    }
+
+
+    void testSpinWindowHybrid() {
+        Pipe p;
+
+        auto s = Selector::createEPoll(5);
+        s.add(&p.getReadEnd(), Selector::Read);
+        s.setSpinWindow(500);
+
+        // Data arriving within the spin window is caught by a non-blocking probe:
+        std::thread writer([&p]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            char msg[] = "x";
+            p.write(wrapMemory(msg, 1));
+        });
+        Selector::Event events[2];
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(1), s.pollInto(arrayView(events), 1000));
+        writer.join();
+
+        char buff[8];
+        auto dest = wrapMemory(buff);
+        p.read(dest);
+
+        // A quiet window parks in the kernel and honours the caller's timeout:
+        auto quiet = s.poll(1);
+        CPPUNIT_ASSERT(quiet == quiet.end());
+
+        // msec == 0 stays strictly non-blocking regardless of the window:
+        auto probe = s.poll(0);
+        CPPUNIT_ASSERT(probe == probe.end());
+    }
+
+    void testCreateBestCalibrates() {
+        // Whatever backend the kernel grants, the selector must arrive
+        // working and with a calibrated spin window in the sane range:
+        auto s = Selector::createBest(8);
+        CPPUNIT_ASSERT(s.spinWindow() >= 1);
+        CPPUNIT_ASSERT(s.spinWindow() <= 100);
+
+        Pipe p;
+        s.add(&p.getReadEnd(), Selector::Read);
+
+        char msg[] = "x";
+        p.write(wrapMemory(msg, 1));
+
+        Selector::Event events[2];
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(1), s.pollInto(arrayView(events), 1000));
+        CPPUNIT_ASSERT_EQUAL(p.getReadEnd().getSelectId(), events[0].fd);
+
+        // Re-calibration on demand reports a plausible wakeup cost:
+        const auto measured = s.calibrateWakeupLatency();
+        CPPUNIT_ASSERT(measured >= 0);
+    }
+
+
     void testRemovalOfNotAddedItem() {
         Pipe p;
 
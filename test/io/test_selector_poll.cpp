@@ -27,6 +27,9 @@
 
 #include <cppunit/extensions/HelperMacros.h>
 
+#include <chrono>
+#include <thread>
+
 
 using namespace Solace;
 using namespace Solace::IO;
@@ -40,6 +43,8 @@ class TestPollSelector : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testRemoval);
         CPPUNIT_TEST(testRemovalOfNotAddedItem);
         CPPUNIT_TEST(testReadPolling);
+        CPPUNIT_TEST(testStatsTrackReadiness);
+        CPPUNIT_TEST(testSpinWindowHybrid);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -95,6 +100,31 @@ public:
     }
 
 
+    void testStatsTrackReadiness() {
+        Pipe p;
+
+        auto s = Selector::createPoll(5);
+        s.add(&p.getWriteEnd(), Selector::Write);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), s.stats().polls);
+
+        s.poll(1);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), s.stats().polls);
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(1), s.stats().lastReadyCount);
+        CPPUNIT_ASSERT(s.stats().lastWaitNanos >= 0);
+
+        s.remove(&p.getWriteEnd());
+        s.poll(1);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(2), s.stats().polls);
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(0), s.stats().lastReadyCount);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), s.stats().eventsReported);
+
+        // From the second poll on there is a dispatch phase and a loop average:
+        CPPUNIT_ASSERT(s.stats().lastDispatchNanos >= 0);
+        CPPUNIT_ASSERT(s.stats().loopEwmaNanos > 0);
+    }
+
+
     void testEmptyPolling() {
         auto s = Selector::createPoll(3);
 
@@ -116,7 +146,7 @@ public:
             CPPUNIT_ASSERT(i != i.end());
 
             auto ev = *i;
-//            CPPUNIT_ASSERT_EQUAL(static_cast<void*>(&p.getWriteEnd()), ev.data);
+            CPPUNIT_ASSERT_EQUAL(static_cast<void*>(static_cast<ISelectable*>(&p.getWriteEnd())), ev.data);
             CPPUNIT_ASSERT_EQUAL(p.getWriteEnd().getSelectId(), ev.fd);
         }
 
@@ -136,6 +166,39 @@ public:
         CPPUNIT_ASSERT_NO_THROW(s.remove(&p.getWriteEnd()));
     }
 
+    void testSpinWindowHybrid() {
+        Pipe p;
+
+        auto s = Selector::createPoll(5);
+        s.add(&p.getReadEnd(), Selector::Read);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), s.spinWindow());
+        s.setSpinWindow(500);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(500), s.spinWindow());
+
+        // Data arriving within the spin window is picked up by a probe:
+        std::thread writer([&p]() {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+            char msg[] = "x";
+            p.write(wrapMemory(msg, 1));
+        });
+        auto i = s.poll(1000);
+        CPPUNIT_ASSERT(i != i.end());
+        writer.join();
+
+        char buff[8];
+        auto dest = wrapMemory(buff);
+        p.read(dest);
+
+        // A quiet window still honours the caller's timeout:
+        auto quiet = s.poll(1);
+        CPPUNIT_ASSERT(quiet == quiet.end());
+
+        // And msec == 0 stays strictly non-blocking:
+        auto probe = s.poll(0);
+        CPPUNIT_ASSERT(probe == probe.end());
+    }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestPollSelector);
@@ -0,0 +1,178 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_selector_replay.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/selector.hpp>  // Class being tested
+
+#include <solace/io/traceRing.hpp>
+#include <solace/io/pipe.hpp>
+#include <solace/io/sharedMemory.hpp>
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestSelectorReplay : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSelectorReplay);
+        CPPUNIT_TEST(testRecordingIsTransparent);
+        CPPUNIT_TEST(testReplayReproducesBatches);
+        CPPUNIT_TEST(testReplayRebindsData);
+        CPPUNIT_TEST(testExhaustedTraceReportsNoEvents);
+        CPPUNIT_TEST(testReplayOfEmptyRegionThrows);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testRecordingIsTransparent() {
+        auto region = SharedMemory::createAnon(TraceRing::bufferSizeFor(64), SharedMemory::Access::Shared);
+        auto ring = TraceRing::create(std::move(region), 64);
+
+        Pipe p;
+        auto s = Selector::createRecording(Selector::createPoll(5), std::move(ring));
+        s.add(&p.getReadEnd(), Selector::Read);
+
+        // Events flow through the decorator exactly as from the wrapped backend:
+        auto i = s.poll(1);
+        CPPUNIT_ASSERT(i == i.end());
+
+        char msg[] = "message";
+        CPPUNIT_ASSERT(p.write(wrapMemory(msg)).isOk());
+
+        i = s.poll(10);
+        CPPUNIT_ASSERT(i != i.end());
+
+        auto ev = *i;
+        CPPUNIT_ASSERT_EQUAL(p.getReadEnd().getSelectId(), ev.fd);
+        CPPUNIT_ASSERT(ev.isSet(Selector::Read));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(2), s.stats().polls);
+    }
+
+
+    void testReplayReproducesBatches() {
+        auto region = SharedMemory::createAnon(TraceRing::bufferSizeFor(64), SharedMemory::Access::Shared);
+        auto* regionAddr = region.view().dataAddress();
+        const auto regionSize = region.size();
+
+        Pipe p;
+        const auto readFd = p.getReadEnd().getSelectId();
+
+        {   // Record: one empty batch, then one with the readable pipe end.
+            auto ring = TraceRing::create(MemoryBuffer(wrapMemory(regionAddr, regionSize)), 64);
+            auto s = Selector::createRecording(Selector::createPoll(5), std::move(ring));
+            s.add(&p.getReadEnd(), Selector::Read);
+
+            auto i = s.poll(1);
+            CPPUNIT_ASSERT(i == i.end());
+
+            char msg[] = "message";
+            CPPUNIT_ASSERT(p.write(wrapMemory(msg)).isOk());
+
+            i = s.poll(10);
+            CPPUNIT_ASSERT(i != i.end());
+        }
+
+        // Replay against the same mapping, fast-forward:
+        auto replay = Selector::createReplay(MemoryBuffer(wrapMemory(regionAddr, regionSize)),
+                                             Selector::ReplayTiming::FastForward);
+
+        auto i = replay.poll(-1);
+        CPPUNIT_ASSERT(i == i.end());
+
+        i = replay.poll(-1);
+        CPPUNIT_ASSERT(i != i.end());
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(1), i.size());
+
+        auto ev = *i;
+        CPPUNIT_ASSERT_EQUAL(readFd, ev.fd);
+        CPPUNIT_ASSERT(ev.isSet(Selector::Read));
+    }
+
+
+    void testReplayRebindsData() {
+        auto region = SharedMemory::createAnon(TraceRing::bufferSizeFor(64), SharedMemory::Access::Shared);
+        auto* regionAddr = region.view().dataAddress();
+        const auto regionSize = region.size();
+
+        Pipe p;
+        const auto readFd = p.getReadEnd().getSelectId();
+
+        {
+            auto ring = TraceRing::create(MemoryBuffer(wrapMemory(regionAddr, regionSize)), 64);
+            auto s = Selector::createRecording(Selector::createPoll(5), std::move(ring));
+            s.add(&p.getReadEnd(), Selector::Read);
+
+            char msg[] = "message";
+            CPPUNIT_ASSERT(p.write(wrapMemory(msg)).isOk());
+
+            auto i = s.poll(10);
+            CPPUNIT_ASSERT(i != i.end());
+        }
+
+        auto replay = Selector::createReplay(MemoryBuffer(wrapMemory(regionAddr, regionSize)),
+                                             Selector::ReplayTiming::FastForward);
+
+        // The replaying process attaches its own state to the recorded fd:
+        int marker = 42;
+        replay.add(readFd, Selector::Read, &marker);
+
+        auto i = replay.poll(-1);
+        CPPUNIT_ASSERT(i != i.end());
+        CPPUNIT_ASSERT_EQUAL(static_cast<void*>(&marker), (*i).data);
+    }
+
+
+    void testExhaustedTraceReportsNoEvents() {
+        auto region = SharedMemory::createAnon(TraceRing::bufferSizeFor(64), SharedMemory::Access::Shared);
+        auto* regionAddr = region.view().dataAddress();
+        const auto regionSize = region.size();
+
+        {
+            auto ring = TraceRing::create(MemoryBuffer(wrapMemory(regionAddr, regionSize)), 64);
+            auto s = Selector::createRecording(Selector::createPoll(5), std::move(ring));
+            s.poll(1);
+        }
+
+        auto replay = Selector::createReplay(MemoryBuffer(wrapMemory(regionAddr, regionSize)),
+                                             Selector::ReplayTiming::FastForward);
+
+        auto i = replay.poll(0);
+        CPPUNIT_ASSERT(i == i.end());
+
+        // Past the end of the trace - empty forever, never blocking:
+        i = replay.poll(-1);
+        CPPUNIT_ASSERT(i == i.end());
+        i = replay.poll(-1);
+        CPPUNIT_ASSERT(i == i.end());
+    }
+
+
+    void testReplayOfEmptyRegionThrows() {
+        auto junk = SharedMemory::createAnon(256, SharedMemory::Access::Shared);
+
+        CPPUNIT_ASSERT_THROW(Selector::createReplay(std::move(junk)), IllegalArgumentException);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSelectorReplay);
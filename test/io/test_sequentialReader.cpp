@@ -0,0 +1,148 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_sequentialReader.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/sequentialReader.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>    // std::min
+#include <stdlib.h>     // mkstemp
+#include <unistd.h>     // write, unlink
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestSequentialReader : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSequentialReader);
+        CPPUNIT_TEST(testScanDeliversWholeFile);
+        CPPUNIT_TEST(testPreviousChunkSurvivesNextRead);
+        CPPUNIT_TEST(testEmptyFile);
+        CPPUNIT_TEST(testBadChunkSizeThrows);
+    CPPUNIT_TEST_SUITE_END();
+
+    /** Fill a fresh temp file with a position-derived byte pattern. */
+    static File makePatternFile(char* pathTemplate, size_t nbBytes) {
+        const int fd = mkstemp(pathTemplate);
+        CPPUNIT_ASSERT(fd >= 0);
+
+        byte block[4096];
+        size_t written = 0;
+        while (written < nbBytes) {
+            const size_t n = std::min(sizeof(block), nbBytes - written);
+            for (size_t i = 0; i < n; ++i) {
+                block[i] = patternAt(written + i);
+            }
+            CPPUNIT_ASSERT_EQUAL(static_cast<ssize_t>(n), ::write(fd, block, n));
+            written += n;
+        }
+
+        return File::fromFd(fd);
+    }
+
+    static byte patternAt(size_t i) {
+        return static_cast<byte>(i * 131 + 5);
+    }
+
+public:
+
+    void testScanDeliversWholeFile() {
+        char path[] = "/tmp/solace-seqreader-XXXXXX";
+        const size_t total = 300 * 1000 + 37;   // Deliberately not a chunk multiple.
+        auto file = makePatternFile(path, total);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+        SequentialReader reader(file, allocator, 64 * 1024);
+
+        size_t seen = 0;
+        for (;;) {
+            const auto view = reader.next();
+            if (view.empty()) {
+                break;
+            }
+
+            for (size_t i = 0; i < view.size(); ++i) {
+                CPPUNIT_ASSERT_EQUAL(patternAt(seen + i), view.dataAddress()[i]);
+            }
+            seen += view.size();
+        }
+
+        CPPUNIT_ASSERT_EQUAL(total, seen);
+
+        // Exhausted readers stay at end of file:
+        CPPUNIT_ASSERT(reader.next().empty());
+
+        ::unlink(path);
+    }
+
+
+    void testPreviousChunkSurvivesNextRead() {
+        char path[] = "/tmp/solace-seqreader-XXXXXX";
+        auto file = makePatternFile(path, 3 * 8192);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+        SequentialReader reader(file, allocator, 8192);
+
+        const auto first = reader.next();
+        CPPUNIT_ASSERT_EQUAL(static_cast<ImmutableMemoryView::size_type>(8192), first.size());
+
+        // Fetching the next chunk lands in the other buffer:
+        const auto second = reader.next();
+        CPPUNIT_ASSERT(first.dataAddress() != second.dataAddress());
+
+        // ... so the first view still holds its bytes:
+        for (size_t i = 0; i < first.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(patternAt(i), first.dataAddress()[i]);
+        }
+
+        ::unlink(path);
+    }
+
+
+    void testEmptyFile() {
+        char path[] = "/tmp/solace-seqreader-XXXXXX";
+        auto file = makePatternFile(path, 0);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+        SequentialReader reader(file, allocator, 4096);
+
+        CPPUNIT_ASSERT(reader.next().empty());
+        CPPUNIT_ASSERT(reader.next().empty());
+
+        ::unlink(path);
+    }
+
+
+    void testBadChunkSizeThrows() {
+        char path[] = "/tmp/solace-seqreader-XXXXXX";
+        auto file = makePatternFile(path, 64);
+
+        MemoryManager allocator(4 * 1024 * 1024);
+        CPPUNIT_ASSERT_THROW(SequentialReader(file, allocator, 0), IllegalArgumentException);
+
+        ::unlink(path);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSequentialReader);
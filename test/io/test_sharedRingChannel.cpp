@@ -0,0 +1,197 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_sharedRingChannel.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/sharedRingChannel.hpp>  // Class being tested
+
+#include <solace/io/sharedMemory.hpp>
+#include <solace/io/selector.hpp>
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <sys/wait.h>
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestSharedRingChannel : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSharedRingChannel);
+        CPPUNIT_TEST(testBadGeometryThrows);
+        CPPUNIT_TEST(testReserveCommitAcquireRelease);
+        CPPUNIT_TEST(testRingFillsUp);
+        CPPUNIT_TEST(testOverCommitThrows);
+        CPPUNIT_TEST(testAttachSeesFormattedRing);
+        CPPUNIT_TEST(testCrossProcessHopWithDoorbell);
+    CPPUNIT_TEST_SUITE_END();
+
+    static SharedRingChannel makeChannel(uint32 slotCount, uint32 slotSize, bool withDoorbell = false) {
+        auto region = SharedMemory::createAnon(SharedRingChannel::bufferSizeFor(slotCount, slotSize),
+                                               SharedMemory::Access::Shared);
+
+        return SharedRingChannel::create(std::move(region), slotCount, slotSize, withDoorbell);
+    }
+
+public:
+
+    void testBadGeometryThrows() {
+        auto region = SharedMemory::createAnon(SharedRingChannel::bufferSizeFor(8, 64),
+                                               SharedMemory::Access::Shared);
+
+        CPPUNIT_ASSERT_THROW(SharedRingChannel::create(std::move(region), 7, 64),
+                             IllegalArgumentException);
+
+        auto tiny = SharedMemory::createAnon(64, SharedMemory::Access::Shared);
+        CPPUNIT_ASSERT_THROW(SharedRingChannel::create(std::move(tiny), 8, 64),
+                             IllegalArgumentException);
+    }
+
+    void testReserveCommitAcquireRelease() {
+        auto channel = makeChannel(8, 64);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(8), channel.capacity());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(64), channel.slotSize());
+        CPPUNIT_ASSERT(channel.empty());
+
+        MemoryView slots[4];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(4),
+                             channel.reserve(arrayView(slots)));
+        memcpy(slots[0].dataAddress(), "aaa", 3);
+        memcpy(slots[1].dataAddress(), "bbb", 3);
+        channel.commit(2);
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(2), channel.size());
+
+        MemoryView messages[4];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(2),
+                             channel.acquire(arrayView(messages)));
+        CPPUNIT_ASSERT(memcmp(messages[0].dataAddress(), "aaa", 3) == 0);
+        CPPUNIT_ASSERT(memcmp(messages[1].dataAddress(), "bbb", 3) == 0);
+
+        channel.release(2);
+        CPPUNIT_ASSERT(channel.empty());
+    }
+
+    void testRingFillsUp() {
+        auto channel = makeChannel(8, 64);
+
+        MemoryView slots[16];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(8),
+                             channel.reserve(arrayView(slots)));
+        channel.commit(8);
+
+        // No free slots until the consumer releases some:
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(0),
+                             channel.reserve(arrayView(slots)));
+
+        MemoryView messages[16];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(8),
+                             channel.acquire(arrayView(messages)));
+        channel.release(3);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(3),
+                             channel.reserve(arrayView(slots)));
+    }
+
+    void testOverCommitThrows() {
+        auto channel = makeChannel(8, 64);
+
+        MemoryView slots[2];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(2),
+                             channel.reserve(arrayView(slots)));
+
+        CPPUNIT_ASSERT_THROW(channel.commit(3), IllegalArgumentException);
+        CPPUNIT_ASSERT_THROW(channel.release(1), IllegalArgumentException);
+    }
+
+    void testAttachSeesFormattedRing() {
+        auto region = SharedMemory::createAnon(SharedRingChannel::bufferSizeFor(8, 128),
+                                               SharedMemory::Access::Shared);
+        // A second, independent mapping of the same region is what another
+        // process would hold; a moved-out view of this one is close enough:
+        auto view = region.view();
+
+        auto producer = SharedRingChannel::create(std::move(region), 8, 128, false);
+
+        auto consumer = SharedRingChannel::attach(MemoryBuffer(view));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(8), consumer.capacity());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(128), consumer.slotSize());
+
+        MemoryView slots[1];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(1),
+                             producer.reserve(arrayView(slots)));
+        memcpy(slots[0].dataAddress(), "ping", 4);
+        producer.commit(1);
+
+        MemoryView messages[1];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(1),
+                             consumer.acquire(arrayView(messages)));
+        CPPUNIT_ASSERT(memcmp(messages[0].dataAddress(), "ping", 4) == 0);
+        consumer.release(1);
+
+        CPPUNIT_ASSERT_THROW(SharedRingChannel::attach(SharedMemory::createAnon(4096,
+                                                                SharedMemory::Access::Shared)),
+                             IllegalArgumentException);
+    }
+
+    void testCrossProcessHopWithDoorbell() {
+        auto channel = makeChannel(64, 64, true);
+        CPPUNIT_ASSERT(channel.getSelectId() != ISelectable::InvalidFd);
+
+        auto childPid = fork();
+        CPPUNIT_ASSERT(childPid >= 0);
+
+        if (childPid == 0) {  // Child: produce a handful of messages
+            MemoryView slots[8];
+            if (channel.reserve(arrayView(slots)) != 8) {
+                _exit(1);
+            }
+
+            for (int i = 0; i < 5; ++i) {
+                snprintf(reinterpret_cast<char*>(slots[i].dataAddress()), 64, "msg-%d", i);
+            }
+            channel.commit(5);
+            _exit(0);
+        }
+
+        auto selector = Selector::createEPoll(2);
+        selector.add(&channel, Selector::Events::Read);
+        CPPUNIT_ASSERT(selector.poll(5000).size() > 0);
+        channel.drainDoorbell();
+
+        MemoryView messages[16];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedRingChannel::size_type>(5),
+                             channel.acquire(arrayView(messages)));
+        for (int i = 0; i < 5; ++i) {
+            char expected[16];
+            snprintf(expected, sizeof(expected), "msg-%d", i);
+            CPPUNIT_ASSERT(strcmp(reinterpret_cast<char*>(messages[i].dataAddress()), expected) == 0);
+        }
+        channel.release(5);
+
+        int status = 0;
+        waitpid(childPid, &status, 0);
+        CPPUNIT_ASSERT(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSharedRingChannel);
@@ -0,0 +1,93 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_signalFd.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/signalFd.hpp>  // Class being tested
+
+#include <solace/io/selector.hpp>
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <csignal>
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+class TestSignalFd : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSignalFd);
+        CPPUNIT_TEST(testTakeOnQuietFdReturnsNone);
+        CPPUNIT_TEST(testSignalDeliveredThroughSelector);
+        CPPUNIT_TEST(testBatchedDrain);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testTakeOnQuietFdReturnsNone() {
+        auto signalFd = SignalFd::create({SIGUSR1});
+
+        CPPUNIT_ASSERT(signalFd.take().isNone());
+
+        SignalFd::SignalInfo pending[4];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SignalFd::size_type>(0), signalFd.read(arrayView(pending)));
+    }
+
+    void testSignalDeliveredThroughSelector() {
+        auto signalFd = SignalFd::create({SIGUSR1});
+
+        auto selector = Selector::createEPoll(2);
+        selector.add(&signalFd, Selector::Events::Read);
+        CPPUNIT_ASSERT_EQUAL(static_cast<Selector::size_type>(0), selector.poll(0).size());
+
+        kill(getpid(), SIGUSR1);
+        CPPUNIT_ASSERT(selector.poll(1000).size() > 0);
+
+        auto delivered = signalFd.take();
+        CPPUNIT_ASSERT(delivered.isSome());
+        CPPUNIT_ASSERT_EQUAL(static_cast<int32>(SIGUSR1), delivered.get().signal);
+        CPPUNIT_ASSERT_EQUAL(static_cast<int32>(getpid()), delivered.get().senderPid);
+
+        CPPUNIT_ASSERT(signalFd.take().isNone());
+    }
+
+    void testBatchedDrain() {
+        auto signalFd = SignalFd::create({SIGUSR1, SIGUSR2});
+
+        kill(getpid(), SIGUSR1);
+        kill(getpid(), SIGUSR2);
+        usleep(10 * 1000);
+
+        SignalFd::SignalInfo pending[8];
+        CPPUNIT_ASSERT_EQUAL(static_cast<SignalFd::size_type>(2), signalFd.read(arrayView(pending)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<int32>(SIGUSR1), pending[0].signal);
+        CPPUNIT_ASSERT_EQUAL(static_cast<int32>(SIGUSR2), pending[1].signal);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<SignalFd::size_type>(0), signalFd.read(arrayView(pending)));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSignalFd);
+
+#endif  // SOLACE_PLATFORM_LINUX
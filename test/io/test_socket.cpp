@@ -0,0 +1,268 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_socket.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/socket.hpp>  // Class being tested
+
+#include <solace/io/selector.hpp>
+#include <solace/exception.hpp>
+#include <solace/memoryManager.hpp>
+
+#include <vector>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <unistd.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestSocket : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSocket);
+        CPPUNIT_TEST(testTcpConnectAcceptRoundtrip);
+        CPPUNIT_TEST(testAcceptOnIdleListenerReturnsNone);
+        CPPUNIT_TEST(testAcceptBatchDrainsBacklog);
+        CPPUNIT_TEST(testAcceptBatchHonoursSlabCapacity);
+        CPPUNIT_TEST(testSocketOptions);
+        CPPUNIT_TEST(testUdpSendToReceive);
+        CPPUNIT_TEST(testUdpBatchedTransfer);
+        CPPUNIT_TEST(testUdpReceiveManyWouldBlock);
+        CPPUNIT_TEST(testUnixConnectAccept);
+        CPPUNIT_TEST(testInvalidAddressThrows);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testTcpConnectAcceptRoundtrip() {
+        auto acceptor = TcpAcceptor::bind(StringView("127.0.0.1"), 0);
+        const auto port = acceptor.boundPort();
+        CPPUNIT_ASSERT(port != 0);
+
+        auto client = TcpSocket::create();
+        bool connected = client.connect(StringView("127.0.0.1"), port);
+
+        auto selector = Selector::createEPoll(4);
+        if (!connected) {
+            selector.add(&client, Selector::Events::Write);
+            CPPUNIT_ASSERT(selector.poll(1000).size() > 0);
+            connected = client.finishConnect();
+            selector.remove(client.getSelectId());
+        }
+        CPPUNIT_ASSERT(connected);
+
+        auto served = acceptor.accept();
+        CPPUNIT_ASSERT(served.isSome());
+
+        char message[] = "hello";
+        CPPUNIT_ASSERT(client.write(wrapMemory(message, sizeof(message))).isOk());
+
+        selector.add(&served.get(), Selector::Events::Read);
+        CPPUNIT_ASSERT(selector.poll(1000).size() > 0);
+
+        char rx[16] = {0};
+        auto buffer = wrapMemory(rx, sizeof(rx));
+        auto bytesRead = served.get().read(buffer);
+        CPPUNIT_ASSERT(bytesRead.isOk());
+        CPPUNIT_ASSERT_EQUAL(sizeof(message), bytesRead.unwrap());
+        CPPUNIT_ASSERT(strcmp(rx, message) == 0);
+    }
+
+    void testAcceptOnIdleListenerReturnsNone() {
+        auto acceptor = TcpAcceptor::bind(StringView("127.0.0.1"), 0);
+
+        CPPUNIT_ASSERT(acceptor.accept().isNone());
+    }
+
+    void testAcceptBatchDrainsBacklog() {
+        MemoryManager allocator(4096);
+        AcceptSlab slab(allocator, 32);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(32), slab.capacity());
+
+        auto acceptor = TcpAcceptor::bind(StringView("127.0.0.1"), 0);
+        const auto port = acceptor.boundPort();
+
+        // Idle listener: empty batch, no exception.
+        CPPUNIT_ASSERT_EQUAL(static_cast<ArrayView<int>::size_type>(0),
+                             acceptor.acceptBatch(slab.slots()).size());
+
+        std::vector<TcpSocket> clients;
+        for (int i = 0; i < 10; ++i) {
+            auto client = TcpSocket::create();
+            client.connect(StringView("127.0.0.1"), port);
+            clients.push_back(std::move(client));
+        }
+        usleep(100000);
+
+        // One call takes the whole burst:
+        const auto batch = acceptor.acceptBatch(slab.slots());
+        CPPUNIT_ASSERT_EQUAL(static_cast<ArrayView<int>::size_type>(10), batch.size());
+        for (const auto fd : batch) {
+            CPPUNIT_ASSERT(fd >= 0);
+            close(fd);
+        }
+    }
+
+    void testAcceptBatchHonoursSlabCapacity() {
+        MemoryManager allocator(4096);
+        AcceptSlab slab(allocator, 4);
+
+        auto acceptor = TcpAcceptor::bind(StringView("127.0.0.1"), 0);
+        const auto port = acceptor.boundPort();
+
+        std::vector<TcpSocket> clients;
+        for (int i = 0; i < 6; ++i) {
+            auto client = TcpSocket::create();
+            client.connect(StringView("127.0.0.1"), port);
+            clients.push_back(std::move(client));
+        }
+        usleep(100000);
+
+        // Slab fills first; the remainder comes on the next call.
+        const auto first = acceptor.acceptBatch(slab.slots());
+        CPPUNIT_ASSERT_EQUAL(static_cast<ArrayView<int>::size_type>(4), first.size());
+        for (const auto fd : first) close(fd);
+
+        const auto rest = acceptor.acceptBatch(slab.slots());
+        CPPUNIT_ASSERT_EQUAL(static_cast<ArrayView<int>::size_type>(2), rest.size());
+        for (const auto fd : rest) close(fd);
+    }
+
+    void testSocketOptions() {
+        auto sock = TcpSocket::create();
+
+        sock.setNoDelay(true);
+
+        sock.setSendBufferSize(64 * 1024);
+        CPPUNIT_ASSERT(sock.getSendBufferSize() >= 64 * 1024);
+
+        sock.setReceiveBufferSize(64 * 1024);
+        CPPUNIT_ASSERT(sock.getReceiveBufferSize() >= 64 * 1024);
+    }
+
+    void testUdpSendToReceive() {
+        auto receiver = UdpSocket::create();
+        receiver.bind(StringView("127.0.0.1"), 0);
+        const auto port = receiver.boundPort();
+        CPPUNIT_ASSERT(port != 0);
+
+        auto sender = UdpSocket::create();
+        char message[] = "datagram";
+        auto sent = sender.sendTo(StringView("127.0.0.1"), port, wrapMemory(message, sizeof(message)));
+        CPPUNIT_ASSERT(sent.isOk());
+
+        auto selector = Selector::createEPoll(2);
+        selector.add(&receiver, Selector::Events::Read);
+        CPPUNIT_ASSERT(selector.poll(1000).size() > 0);
+
+        char rx[32] = {0};
+        auto buffer = wrapMemory(rx, sizeof(rx));
+        auto bytesRead = receiver.read(buffer);
+        CPPUNIT_ASSERT(bytesRead.isOk());
+        CPPUNIT_ASSERT_EQUAL(sizeof(message), bytesRead.unwrap());
+    }
+
+    void testUdpBatchedTransfer() {
+        auto receiver = UdpSocket::create();
+        receiver.bind(StringView("127.0.0.1"), 0);
+
+        auto sender = UdpSocket::create();
+        sender.connect(StringView("127.0.0.1"), receiver.boundPort());
+
+        char m1[] = "one";
+        char m2[] = "twotwo";
+        char m3[] = "three-three";
+        ImmutableMemoryView messages[] = {
+            wrapMemory(m1, sizeof(m1) - 1),
+            wrapMemory(m2, sizeof(m2) - 1),
+            wrapMemory(m3, sizeof(m3) - 1)
+        };
+        CPPUNIT_ASSERT_EQUAL(static_cast<UdpSocket::size_type>(3), sender.sendMany(arrayView(messages)));
+
+        auto selector = Selector::createEPoll(2);
+        selector.add(&receiver, Selector::Events::Read);
+        CPPUNIT_ASSERT(selector.poll(1000).size() > 0);
+
+        char a[32], b[32], c[32];
+        MemoryView buffers[] = {
+            wrapMemory(a, sizeof(a)),
+            wrapMemory(b, sizeof(b)),
+            wrapMemory(c, sizeof(c))
+        };
+        const auto received = receiver.receiveMany(arrayView(buffers));
+        CPPUNIT_ASSERT_EQUAL(static_cast<UdpSocket::size_type>(3), received);
+
+        // Views must be trimmed to the size of each datagram:
+        CPPUNIT_ASSERT_EQUAL(sizeof(m1) - 1, buffers[0].size());
+        CPPUNIT_ASSERT_EQUAL(sizeof(m2) - 1, buffers[1].size());
+        CPPUNIT_ASSERT_EQUAL(sizeof(m3) - 1, buffers[2].size());
+        CPPUNIT_ASSERT(memcmp(buffers[0].dataAddress(), m1, buffers[0].size()) == 0);
+    }
+
+    void testUdpReceiveManyWouldBlock() {
+        auto receiver = UdpSocket::create();
+        receiver.bind(StringView("127.0.0.1"), 0);
+
+        char rx[16];
+        MemoryView buffers[] = { wrapMemory(rx, sizeof(rx)) };
+        CPPUNIT_ASSERT_EQUAL(static_cast<UdpSocket::size_type>(0), receiver.receiveMany(arrayView(buffers)));
+    }
+
+    void testUnixConnectAccept() {
+        const char* path = "/tmp/solace_test_socket.sock";
+
+        auto acceptor = UnixAcceptor::bind(StringView(path));
+        CPPUNIT_ASSERT(acceptor.accept().isNone());
+
+        auto client = UnixSocket::create();
+        bool connected = client.connect(StringView(path));
+        if (!connected) {
+            connected = client.finishConnect();
+        }
+        CPPUNIT_ASSERT(connected);
+
+        auto served = acceptor.accept();
+        CPPUNIT_ASSERT(served.isSome());
+
+        char message[] = "unix";
+        CPPUNIT_ASSERT(client.write(wrapMemory(message, sizeof(message))).isOk());
+
+        auto selector = Selector::createEPoll(2);
+        selector.add(&served.get(), Selector::Events::Read);
+        CPPUNIT_ASSERT(selector.poll(1000).size() > 0);
+
+        char rx[16] = {0};
+        auto buffer = wrapMemory(rx, sizeof(rx));
+        CPPUNIT_ASSERT(served.get().read(buffer).isOk());
+
+        ::unlink(path);
+    }
+
+    void testInvalidAddressThrows() {
+        auto sock = TcpSocket::create();
+
+        CPPUNIT_ASSERT_THROW(sock.connect(StringView("not-an-address"), 80),
+                             IllegalArgumentException);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSocket);
@@ -0,0 +1,109 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_syncService.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/syncService.hpp>  // Class being tested
+
+#include <solace/io/platformFilesystem.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestSyncService : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSyncService);
+        CPPUNIT_TEST(testCoalescedSyncsAllComplete);
+        CPPUNIT_TEST(testSyncOfClosedFileFailsTheFuture);
+        CPPUNIT_TEST(testRequestsAfterStopAreRejected);
+    CPPUNIT_TEST_SUITE_END();
+
+    static void waitFor(std::atomic<int>& counter, int expected) {
+        for (int spin = 0; spin < 400 && counter.load() < expected; ++spin) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+        }
+    }
+
+public:
+
+    void testCoalescedSyncsAllComplete() {
+        PlatformFilesystem fs;
+        auto path = Path::parse("/tmp/solace_test_syncService.dat").unwrap();
+        auto file = fs.create(path);
+
+        char payload[] = "journal entry";
+        file->write(wrapMemory(payload, sizeof(payload)));
+
+        SyncService service;
+
+        std::atomic<int> completed(0);
+        for (int i = 0; i < 8; ++i) {
+            service.sync(*file).then([&completed]() { ++completed; });
+        }
+        service.sync(*file, true).then([&completed]() { ++completed; });
+
+        waitFor(completed, 9);
+        CPPUNIT_ASSERT_EQUAL(9, completed.load());
+
+        fs.unlink(path);
+    }
+
+    void testSyncOfClosedFileFailsTheFuture() {
+        PlatformFilesystem fs;
+        auto path = Path::parse("/tmp/solace_test_syncService2.dat").unwrap();
+        auto file = fs.create(path);
+        file->close();
+
+        SyncService service;
+
+        std::atomic<int> failed(0);
+        service.sync(*file).onError([&failed](Error&&) { ++failed; });
+
+        waitFor(failed, 1);
+        CPPUNIT_ASSERT_EQUAL(1, failed.load());
+
+        fs.unlink(path);
+    }
+
+    void testRequestsAfterStopAreRejected() {
+        PlatformFilesystem fs;
+        auto path = Path::parse("/tmp/solace_test_syncService3.dat").unwrap();
+        auto file = fs.create(path);
+
+        SyncService service;
+        service.stop();
+
+        std::atomic<int> rejected(0);
+        service.sync(*file).onError([&rejected](Error&&) { ++rejected; });
+
+        // Rejection happens synchronously on the calling thread:
+        CPPUNIT_ASSERT_EQUAL(1, rejected.load());
+
+        fs.unlink(path);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSyncService);
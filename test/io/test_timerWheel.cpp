@@ -0,0 +1,157 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_timerWheel.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/timerWheel.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <thread>
+#include <chrono>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+class TestTimerWheel : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestTimerWheel);
+        CPPUNIT_TEST(testExpirationThroughSelector);
+        CPPUNIT_TEST(testCancel);
+        CPPUNIT_TEST(testStaleHandleCancel);
+        CPPUNIT_TEST(testTruncatedDrain);
+        CPPUNIT_TEST(testVirtualAdvance);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testExpirationThroughSelector() {
+        TimerWheel timers(5);
+
+        auto s = Selector::createEPoll(2);
+        s.add(&timers, Selector::Read);
+
+        CPPUNIT_ASSERT(timers.empty());
+        timers.schedule(20, this);
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(1), timers.size());
+
+        Selector::Event expired[4];
+        TimerWheel::size_type total = 0;
+        for (int spin = 0; spin < 100 && total == 0; ++spin) {
+            auto i = s.poll(100);
+            if (i != i.end()) {
+                CPPUNIT_ASSERT_EQUAL(timers.getSelectId(), (*i).fd);
+                total += timers.expire(arrayView(expired));
+            }
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(1), total);
+        CPPUNIT_ASSERT_EQUAL(static_cast<void*>(this), expired[0].data);
+        CPPUNIT_ASSERT(expired[0].isSet(Selector::Events::Read));
+        CPPUNIT_ASSERT(timers.empty());
+    }
+
+
+    void testCancel() {
+        TimerWheel timers(5);
+
+        int cancelled = 0;
+        int delivered = 0;
+        const auto id = timers.schedule(30, &cancelled);
+        timers.schedule(30, &delivered);
+
+        CPPUNIT_ASSERT(timers.cancel(id));
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(1), timers.size());
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(80));
+
+        Selector::Event expired[4];
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(1), timers.expire(arrayView(expired)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<void*>(&delivered), expired[0].data);
+    }
+
+
+    void testStaleHandleCancel() {
+        TimerWheel timers(5);
+
+        const auto id = timers.schedule(10, this);
+        CPPUNIT_ASSERT(timers.cancel(id));
+        CPPUNIT_ASSERT(!timers.cancel(id));
+
+        // The node is recycled for a new timer - the old handle must stay dead:
+        const auto recycled = timers.schedule(10, this);
+        CPPUNIT_ASSERT(!timers.cancel(id));
+        CPPUNIT_ASSERT(timers.cancel(recycled));
+    }
+
+
+    void testTruncatedDrain() {
+        TimerWheel timers(1);
+
+        for (int i = 0; i < 10; ++i) {
+            timers.schedule(3, this);
+        }
+
+        std::this_thread::sleep_for(std::chrono::milliseconds(30));
+
+        // A small buffer drains the backlog across several calls:
+        Selector::Event expired[4];
+        TimerWheel::size_type total = 0;
+        TimerWheel::size_type n = 0;
+        while ((n = timers.expire(arrayView(expired))) != 0) {
+            CPPUNIT_ASSERT(n <= 4);
+            total += n;
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(10), total);
+        CPPUNIT_ASSERT(timers.empty());
+    }
+
+
+    void testVirtualAdvance() {
+        // A coarse tick keeps real elapsed time from interfering below.
+        TimerWheel timers(100);
+
+        int early = 0;
+        int late = 0;
+        timers.schedule(500, &early);
+        timers.schedule(1000, &late);
+
+        // No wall-clock time passes - the test clock drives the wheel:
+        timers.advance(499);
+        Selector::Event expired[4];
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(0), timers.expire(arrayView(expired)));
+
+        timers.advance(101);
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(1), timers.expire(arrayView(expired)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<void*>(&early), expired[0].data);
+
+        timers.advance(500);
+        CPPUNIT_ASSERT_EQUAL(static_cast<TimerWheel::size_type>(1), timers.expire(arrayView(expired)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<void*>(&late), expired[0].data);
+        CPPUNIT_ASSERT(timers.empty());
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestTimerWheel);
+#endif  // SOLACE_PLATFORM_LINUX
@@ -0,0 +1,138 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_traceRing.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/traceRing.hpp>  // Class being tested
+
+#include <solace/io/sharedMemory.hpp>
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestTraceRing : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestTraceRing);
+        CPPUNIT_TEST(testBadGeometryThrows);
+        CPPUNIT_TEST(testRecordAndReadBack);
+        CPPUNIT_TEST(testOverwriteKeepsNewest);
+        CPPUNIT_TEST(testAttachSeesRecordedEvents);
+    CPPUNIT_TEST_SUITE_END();
+
+    static TraceRing makeRing(uint32 eventCount) {
+        auto region = SharedMemory::createAnon(TraceRing::bufferSizeFor(eventCount),
+                                               SharedMemory::Access::Shared);
+
+        return TraceRing::create(std::move(region), eventCount);
+    }
+
+public:
+
+    void testBadGeometryThrows() {
+        auto region = SharedMemory::createAnon(TraceRing::bufferSizeFor(8),
+                                               SharedMemory::Access::Shared);
+
+        CPPUNIT_ASSERT_THROW(TraceRing::create(std::move(region), 7),
+                             IllegalArgumentException);
+
+        auto tiny = SharedMemory::createAnon(64, SharedMemory::Access::Shared);
+        CPPUNIT_ASSERT_THROW(TraceRing::create(std::move(tiny), 8),
+                             IllegalArgumentException);
+
+        auto blank = SharedMemory::createAnon(TraceRing::bufferSizeFor(8),
+                                              SharedMemory::Access::Shared);
+        CPPUNIT_ASSERT_THROW(TraceRing::attach(std::move(blank)),
+                             IllegalArgumentException);
+    }
+
+    void testRecordAndReadBack() {
+        auto ring = makeRing(8);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(8), ring.capacity());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), ring.recorded());
+
+        ring.record(1, 10, 100);
+        ring.record(2, 20, 200);
+        ring.record(3, 30, 300);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(3), ring.recorded());
+
+        TraceRing::Event events[8];
+        CPPUNIT_ASSERT_EQUAL(static_cast<TraceRing::size_type>(3),
+                             ring.readBack(arrayView(events)));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), events[0].id);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(10), events[0].arg0);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(100), events[0].arg1);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(3), events[2].id);
+        CPPUNIT_ASSERT(events[0].timestamp <= events[1].timestamp);
+        CPPUNIT_ASSERT(events[1].timestamp <= events[2].timestamp);
+    }
+
+    void testOverwriteKeepsNewest() {
+        auto ring = makeRing(4);
+
+        for (uint64 i = 0; i < 11; ++i) {
+            ring.record(i);
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(11), ring.recorded());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(4), ring.capacity());
+
+        TraceRing::Event events[8];
+        CPPUNIT_ASSERT_EQUAL(static_cast<TraceRing::size_type>(4),
+                             ring.readBack(arrayView(events)));
+
+        for (uint64 i = 0; i < 4; ++i) {
+            CPPUNIT_ASSERT_EQUAL(7 + i, events[i].id);
+        }
+
+        // A smaller destination gets only the very newest events:
+        TraceRing::Event last[2];
+        CPPUNIT_ASSERT_EQUAL(static_cast<TraceRing::size_type>(2),
+                             ring.readBack(arrayView(last)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(9), last[0].id);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(10), last[1].id);
+    }
+
+    void testAttachSeesRecordedEvents() {
+        auto region = SharedMemory::createAnon(TraceRing::bufferSizeFor(8),
+                                               SharedMemory::Access::Shared);
+        auto* base = region.view().dataAddress();
+        auto const regionSize = region.size();
+
+        auto ring = TraceRing::create(std::move(region), 8);
+        ring.record(42, 4242);
+        ring.record(43, 4343);
+
+        // Re-view the same mapping the way a post-mortem reader would:
+        auto reader = TraceRing::attach(MemoryBuffer(wrapMemory(base, regionSize)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(2), reader.recorded());
+
+        TraceRing::Event events[8];
+        CPPUNIT_ASSERT_EQUAL(static_cast<TraceRing::size_type>(2),
+                             reader.readBack(arrayView(events)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(42), events[0].id);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(4343), events[1].arg0);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestTraceRing);
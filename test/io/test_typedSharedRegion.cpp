@@ -0,0 +1,130 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/io/test_typedSharedRegion.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/io/typedSharedRegion.hpp>  // Class being tested
+
+#include <solace/io/sharedMemory.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+
+#ifdef SOLACE_PLATFORM_LINUX
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+namespace {
+
+struct StateRow {
+    uint64 key;
+    uint64 hits;
+    double weight;
+};
+
+const StringView kStateSchema("StateRow{u64 key; u64 hits; f64 weight}");
+
+}  // namespace
+
+
+class TestTypedSharedRegion: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestTypedSharedRegion);
+        CPPUNIT_TEST(testFormatGivesInPlaceTypedView);
+        CPPUNIT_TEST(testAttachValidatesContract);
+        CPPUNIT_TEST(testAttachRejectsGarbage);
+        CPPUNIT_TEST(testFormatRejectsTinyRegions);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+
+    alignas(StateRow) byte _storage[4096];
+
+    /** A fresh non-owning buffer over the fixture bytes, standing in for a re-mapping. */
+    MemoryBuffer remap() {
+        return MemoryBuffer(wrapMemory(_storage));
+    }
+
+public:
+
+    void setUp() override {
+        wrapMemory(_storage).fill(0);
+    }
+
+    void testFormatGivesInPlaceTypedView() {
+        auto mapping = SharedMemory::createAnon(64 * 1024, SharedMemory::Access::Shared);
+        auto* base = mapping.view().dataAddress();
+
+        auto formatted = TypedSharedRegion<StateRow>::format(std::move(mapping), kStateSchema, 3);
+        CPPUNIT_ASSERT(formatted.isOk());
+
+        auto region = formatted.moveResult();
+        const auto expected =
+                (64 * 1024 - TypedSharedRegion<StateRow>::kDataOffset) / sizeof(StateRow);
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(expected), region.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(3), region.layoutVersion());
+
+        auto rows = region.view();
+        rows[0].key = 42;
+        rows[expected - 1].weight = 2.5;
+
+        // The view aliases the mapping - nothing was copied out:
+        CPPUNIT_ASSERT(reinterpret_cast<byte*>(rows.begin())
+                        == base + TypedSharedRegion<StateRow>::kDataOffset);
+    }
+
+    void testAttachValidatesContract() {
+        {
+            auto region = TypedSharedRegion<StateRow>::format(remap(), kStateSchema, 3)
+                    .moveResult();
+            region.view()[1].key = 99;
+        }
+
+        // A matching consumer reads what the producer wrote, in place:
+        auto attached = TypedSharedRegion<StateRow>::attach(remap(), kStateSchema, 3);
+        CPPUNIT_ASSERT(attached.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(99), attached.unwrap().view()[1].key);
+
+        // Wrong layout version, wrong schema, wrong element type - refused:
+        CPPUNIT_ASSERT(TypedSharedRegion<StateRow>::attach(remap(), kStateSchema, 4).isError());
+        CPPUNIT_ASSERT(TypedSharedRegion<StateRow>::attach(
+                remap(), StringView("StateRow{u64 key; u32 hits}"), 3).isError());
+
+        struct OtherRow { uint64 key; };
+        CPPUNIT_ASSERT(TypedSharedRegion<OtherRow>::attach(remap(), kStateSchema, 3).isError());
+    }
+
+    void testAttachRejectsGarbage() {
+        // Zeroed, never-formatted memory has no magic:
+        CPPUNIT_ASSERT(TypedSharedRegion<StateRow>::attach(remap(), kStateSchema, 3).isError());
+
+        byte crumb[8];
+        CPPUNIT_ASSERT(TypedSharedRegion<StateRow>::attach(
+                MemoryBuffer(wrapMemory(crumb)), kStateSchema, 3).isError());
+    }
+
+    void testFormatRejectsTinyRegions() {
+        byte tiny[sizeof(TypedSharedRegion<StateRow>::RegionHeader)];
+        CPPUNIT_ASSERT(TypedSharedRegion<StateRow>::format(
+                MemoryBuffer(wrapMemory(tiny)), kStateSchema, 1).isError());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestTypedSharedRegion);
+
+#endif  // SOLACE_PLATFORM_LINUX
@@ -0,0 +1,122 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/process/test_affinity.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/process/affinity.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <sched.h>
+
+
+using namespace Solace;
+using namespace Solace::Process;
+
+
+class TestProcessAffinity: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestProcessAffinity);
+        CPPUNIT_TEST(testCpuSetBasics);
+        CPPUNIT_TEST(testSetAndGetAffinity);
+        CPPUNIT_TEST(testEmptyAffinityRejected);
+        CPPUNIT_TEST(testBadPriorityRejected);
+        CPPUNIT_TEST(testTopologyDiscovery);
+        CPPUNIT_TEST(testTopologyNodeSets);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testCpuSetBasics() {
+        CpuSet cpus;
+        CPPUNIT_ASSERT(cpus.isEmpty());
+
+        cpus.set(0).set(2);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(2), cpus.count());
+        CPPUNIT_ASSERT(cpus.isSet(0));
+        CPPUNIT_ASSERT(!cpus.isSet(1));
+        CPPUNIT_ASSERT(cpus.isSet(2));
+
+        cpus.unset(2);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), cpus.count());
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), CpuSet::single(5).count());
+        CPPUNIT_ASSERT(CpuSet::single(5).isSet(5));
+    }
+
+    void testSetAndGetAffinity() {
+        const auto original = getThreadAffinity();
+        CPPUNIT_ASSERT(!original.isEmpty());
+
+        // Pin to the first allowed CPU and read the mask back:
+        uint32 first = 0;
+        while (!original.isSet(first)) {
+            ++first;
+        }
+
+        setThreadAffinity(CpuSet::single(first));
+        const auto pinned = getThreadAffinity();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), pinned.count());
+        CPPUNIT_ASSERT(pinned.isSet(first));
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(first), sched_getcpu());
+
+        // Restore for the rest of the suite:
+        setThreadAffinity(original);
+    }
+
+    void testEmptyAffinityRejected() {
+        CpuSet nothing;
+
+        CPPUNIT_ASSERT_THROW(setThreadAffinity(nothing), IllegalArgumentException);
+    }
+
+    void testBadPriorityRejected() {
+        CPPUNIT_ASSERT_THROW(setRealtimePriority(0), IllegalArgumentException);
+        CPPUNIT_ASSERT_THROW(setRealtimePriority(100), IllegalArgumentException);
+        // Valid priorities need CAP_SYS_NICE, so success can not be asserted here.
+    }
+
+    void testTopologyDiscovery() {
+        const auto topology = Topology::discover();
+
+        CPPUNIT_ASSERT(topology.cpuCount() > 0);
+        CPPUNIT_ASSERT(topology.nodeCount() > 0);
+
+        for (const auto& cpu : topology.cpus()) {
+            CPPUNIT_ASSERT(cpu.node < topology.nodeCount());
+
+            const auto sharers = topology.cpusSharingCacheWith(cpu.id);
+            CPPUNIT_ASSERT(sharers.isSet(cpu.id));
+        }
+    }
+
+    void testTopologyNodeSets() {
+        const auto topology = Topology::discover();
+
+        uint32 total = 0;
+        for (uint32 node = 0; node < topology.nodeCount(); ++node) {
+            total += topology.cpusOnNode(node).count();
+        }
+
+        CPPUNIT_ASSERT_EQUAL(topology.cpuCount(), total);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestProcessAffinity);
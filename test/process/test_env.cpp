@@ -41,6 +41,8 @@ class TestProcessEnv: public CppUnit::TestFixture  {
         CPPUNIT_TEST(testSetEmptyString);
         CPPUNIT_TEST(testUnset);
         CPPUNIT_TEST(testIteration);
+        CPPUNIT_TEST(testSnapshot);
+        CPPUNIT_TEST(testSnapshotIsImmutable);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -148,6 +150,59 @@ public:
 
         CPPUNIT_ASSERT_NO_THROW(env.unset(name));
     }
+
+
+    void testSnapshot() {
+        const auto uid = UUID::random();
+        const auto name = String::join("-", {"test", "env", uid.toString()});
+
+        auto env = Env();
+        CPPUNIT_ASSERT_NO_THROW(env.set(name, uid.toString()));
+
+        const auto snapshot = env.snapshot();
+
+        CPPUNIT_ASSERT(!snapshot.empty());
+        CPPUNIT_ASSERT(snapshot.size() <= env.size());
+
+        const auto value = snapshot.get(name.view());
+        CPPUNIT_ASSERT(value.isSome());
+        CPPUNIT_ASSERT(value.get().equals(uid.toString().view()));
+
+        CPPUNIT_ASSERT(snapshot.get("test-env-no-such-variable").isNone());
+
+        // Iteration covers the captured variables, our entry included:
+        bool found = false;
+        Env::size_type iSize = 0;
+        snapshot.forEach([&found, &name](StringView varName, StringView) {
+            if (varName.equals(name.view())) {
+                found = true;
+            }
+        });
+        snapshot.forEach([&iSize](StringView, StringView) { ++iSize; });
+
+        CPPUNIT_ASSERT_EQUAL(true, found);
+        CPPUNIT_ASSERT_EQUAL(snapshot.size(), iSize);
+
+        CPPUNIT_ASSERT_NO_THROW(env.unset(name));
+    }
+
+
+    void testSnapshotIsImmutable() {
+        const auto uid = UUID::random();
+        const auto name = String::join("-", {"test", "env", uid.toString()});
+
+        auto env = Env();
+        CPPUNIT_ASSERT_NO_THROW(env.set(name, "before"));
+
+        const auto snapshot = env.snapshot();
+
+        // Mutations after the capture are not observed by the snapshot:
+        CPPUNIT_ASSERT_NO_THROW(env.set(name, "after"));
+        CPPUNIT_ASSERT(snapshot.get(name.view()).get().equals("before"));
+
+        CPPUNIT_ASSERT_NO_THROW(env.unset(name));
+        CPPUNIT_ASSERT(snapshot.get(name.view()).isSome());
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestProcessEnv);
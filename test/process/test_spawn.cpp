@@ -0,0 +1,136 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/process/test_spawn.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/process/spawn.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+#include <solace/io/selector.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <signal.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+using namespace Solace::Process;
+
+
+class TestProcessSpawn: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestProcessSpawn);
+        CPPUNIT_TEST(testSpawnAndWait);
+        CPPUNIT_TEST(testExitCodeIsReported);
+        CPPUNIT_TEST(testStdOutPipe);
+        CPPUNIT_TEST(testSignalTermination);
+        CPPUNIT_TEST(testOnExitFuture);
+        CPPUNIT_TEST(testSelectablePidfd);
+        CPPUNIT_TEST(testSpawnMissingProgramThrows);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testSpawnAndWait() {
+        auto child = Spawner("/bin/true").spawn();
+        CPPUNIT_ASSERT(child.pid() > 0);
+
+        const auto status = child.wait();
+        CPPUNIT_ASSERT(status.isSuccess());
+
+        // wait() after the child is reaped returns the same status:
+        CPPUNIT_ASSERT(child.wait().isSuccess());
+    }
+
+    void testExitCodeIsReported() {
+        auto child = Spawner("/bin/sh")
+                .arg("-c")
+                .arg("exit 42")
+                .spawn();
+
+        const auto status = child.wait();
+        CPPUNIT_ASSERT(status.exited);
+        CPPUNIT_ASSERT_EQUAL(42, status.value);
+        CPPUNIT_ASSERT(!status.isSuccess());
+    }
+
+    void testStdOutPipe() {
+        Pipe out;
+        auto child = Spawner("/bin/echo")
+                .arg("hello")
+                .stdOut(out)
+                .spawn();
+
+        CPPUNIT_ASSERT(child.wait().isSuccess());
+
+        byte mem[32];
+        auto view = wrapMemory(mem);
+        const auto read = out.read(view);
+        CPPUNIT_ASSERT(read.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(6), read.unwrap());
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>('h'), mem[0]);
+    }
+
+    void testSignalTermination() {
+        auto child = Spawner("/bin/sleep").arg("30").spawn();
+        child.sendSignal(SIGTERM);
+
+        const auto status = child.wait();
+        CPPUNIT_ASSERT(!status.exited);
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(SIGTERM), status.value);
+    }
+
+    void testOnExitFuture() {
+        auto child = Spawner("/bin/true").spawn();
+
+        bool resolved = false;
+        child.onExit().then([&resolved](ExitStatus&& status) {
+            resolved = status.isSuccess();
+        });
+
+        child.wait();
+        CPPUNIT_ASSERT(resolved);
+    }
+
+    void testSelectablePidfd() {
+        auto child = Spawner("/bin/true").spawn();
+        if (child.getSelectId() == ISelectable::InvalidFd) {
+            child.wait();  // Kernel has no pidfd_open - nothing more to check.
+            return;
+        }
+
+        auto selector = Selector::createPoll(2);
+        selector.add(&child, Selector::Events::Read);
+
+        auto events = selector.poll(5000);
+        CPPUNIT_ASSERT(events.size() > 0);
+
+        const auto status = child.tryReap();
+        CPPUNIT_ASSERT(!status.isNone());
+        CPPUNIT_ASSERT(status.get().isSuccess());
+    }
+
+    void testSpawnMissingProgramThrows() {
+        Spawner launcher("/no/such/binary");
+
+        CPPUNIT_ASSERT_THROW(launcher.spawn(), IOException);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestProcessSpawn);
@@ -45,12 +45,18 @@ class TestArray : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testNonPods);
         CPPUNIT_TEST(testInitializerList);
         CPPUNIT_TEST(testFromNativeConvertion);
+        CPPUNIT_TEST(testGeneratorConstruction);
+        CPPUNIT_TEST(testMemoryManagerBackedStorage);
+        CPPUNIT_TEST(testArenaBackedStorage);
+        CPPUNIT_TEST(testUninitializedConstruction);
         CPPUNIT_TEST(testMoveAssignment);
+        CPPUNIT_TEST(testRvalueIndexMovesOut);
 
         CPPUNIT_TEST(testEquals);
         CPPUNIT_TEST(testIndexOf);
         CPPUNIT_TEST(testContains);
         CPPUNIT_TEST(testExtend);
+        CPPUNIT_TEST(testSlice);
 
         // ForEach methods
         CPPUNIT_TEST(testForEach_byValue);
@@ -407,6 +413,103 @@ public:
 		}
 	}
 
+    void testGeneratorConstruction() {
+        {
+            const Array<int> array(5, [](Array<int>::size_type i) { return static_cast<int>(2 * i); });
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<Array<int>::size_type>(5), array.size());
+            for (auto i = ZERO, end = array.size(); i < end; ++i) {
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(2 * i), array[i]);
+            }
+        }
+
+        {   // Elements are built in place: one instance per element, no extra copies left behind
+            const Array<NonPodStruct> array(4, [](Array<NonPodStruct>::size_type i) {
+                return NonPodStruct(static_cast<int>(i), "~generated~");
+            });
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<Array<NonPodStruct>::size_type>(4), array.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<Array<NonPodStruct>::size_type>(NonPodStruct::TotalCount),
+                                 array.size());
+            for (auto i = ZERO, end = array.size(); i < end; ++i) {
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(i), array[i].iValue);
+            }
+        }
+        CPPUNIT_ASSERT_EQUAL(0, NonPodStruct::TotalCount);
+
+        {   // Zero size is fine and the generator is never called
+            const Array<int> empty(0, [](Array<int>::size_type) { return 3; });
+
+            CPPUNIT_ASSERT(empty.empty());
+        }
+    }
+
+    void testMemoryManagerBackedStorage() {
+        MemoryManager manager(4096);
+        const auto sizeBefore = manager.size();
+
+        {
+            Array<int> array(static_cast<Array<int>::size_type>(16), manager);
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<Array<int>::size_type>(16), array.size());
+            CPPUNIT_ASSERT(manager.size() > sizeBefore);
+
+            array[3] = 991;
+            CPPUNIT_ASSERT_EQUAL(991, array[3]);
+        }
+
+        // Storage is returned to the manager when the array is destroyed
+        CPPUNIT_ASSERT_EQUAL(sizeBefore, manager.size());
+    }
+
+    void testArenaBackedStorage() {
+        MemoryManager manager(8192);
+        auto arena = manager.createArena(4096);
+        const auto offsetBefore = arena.size();
+
+        {
+            Array<uint32> array(static_cast<Array<uint32>::size_type>(8), arena);
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<Array<uint32>::size_type>(8), array.size());
+            CPPUNIT_ASSERT(arena.size() >= offsetBefore + 8 * sizeof(uint32));
+
+            array[0] = 42;
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(42), array[0]);
+        }
+
+        // Deallocation is a no-op: memory is reclaimed only when the arena is reset
+        CPPUNIT_ASSERT(arena.size() >= offsetBefore + 8 * sizeof(uint32));
+        arena.reset();
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryArena::size_type>(0), arena.size());
+    }
+
+    void testUninitializedConstruction() {
+        // The factory must produce a fully usable array of the right size;
+        // element contents are unspecified until written, so the test only
+        // writes-then-reads.
+        auto array = Array<byte>::uninitialized(static_cast<Array<byte>::size_type>(1024));
+        CPPUNIT_ASSERT_EQUAL(static_cast<Array<byte>::size_type>(1024), array.size());
+
+        for (Array<byte>::size_type i = 0; i < array.size(); ++i) {
+            array[i] = static_cast<byte>(i & 0xFF);
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(255), array[255]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0), array[256]);
+
+        // Manager-backed storage is accounted and returned like any other:
+        MemoryManager manager(4096);
+        const auto sizeBefore = manager.size();
+        {
+            auto staged = Array<uint32>::uninitialized(static_cast<Array<uint32>::size_type>(16), manager);
+            CPPUNIT_ASSERT_EQUAL(static_cast<Array<uint32>::size_type>(16), staged.size());
+            CPPUNIT_ASSERT(manager.size() > sizeBefore);
+
+            staged[7] = 991;
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(991), staged[7]);
+        }
+        CPPUNIT_ASSERT_EQUAL(sizeBefore, manager.size());
+    }
+
     template <typename T>
     Array<T> moveArray(std::initializer_list<T> list) {
         return {list};
@@ -469,6 +572,17 @@ public:
 		}
 	}
 
+    void testRvalueIndexMovesOut() {
+        // Indexing a temporary array moves the element out instead of copying:
+        const String extracted = moveArray<String>({"first", "second", "third"})[1];
+        CPPUNIT_ASSERT_EQUAL(String("second"), extracted);
+
+        // The lvalue overloads still observe in place:
+        auto array = moveArray<String>({"a", "b"});
+        CPPUNIT_ASSERT_EQUAL(String("a"), array[0]);
+        CPPUNIT_ASSERT_EQUAL(String("a"), array[0]);
+    }
+
 	void testEquals() {
 		{
 			const Array<int> array = {1, 2, 3};
@@ -621,6 +735,35 @@ public:
         // TODO(abbyssoul): Implementation
     }
 
+    void testSlice() {
+        const Array<int> array = {0, 10, 20, 30, 40, 50};
+
+        {  // A slice is an independent copy:
+            auto copy = array.slice(1, 4);
+            CPPUNIT_ASSERT_EQUAL(static_cast<Array<int>::size_type>(3), copy.size());
+            CPPUNIT_ASSERT_EQUAL(10, copy[0]);
+            CPPUNIT_ASSERT_EQUAL(30, copy[2]);
+            CPPUNIT_ASSERT(copy.data() != array.data());
+
+            copy[0] = -1;
+            CPPUNIT_ASSERT_EQUAL(10, array[1]);
+        }
+
+        {  // Full-range materialization is the point, so to == size() is Ok:
+            auto copy = array.slice(0, array.size());
+            CPPUNIT_ASSERT(copy == array);
+        }
+
+        {  // Empty slice of an empty range:
+            CPPUNIT_ASSERT(array.slice(2, 2).empty());
+        }
+
+        {  // Out-of-range bounds are not Ok:
+            CPPUNIT_ASSERT_THROW(array.slice(1, array.size() + 1), IndexOutOfRangeException);
+            CPPUNIT_ASSERT_THROW(array.slice(4, 2), IndexOutOfRangeException);
+        }
+    }
+
 /*
     void testFill() {
         {
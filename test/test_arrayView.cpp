@@ -91,6 +91,8 @@ class TestArrayView :
 
         CPPUNIT_TEST(testIndexOf);
         CPPUNIT_TEST(testContains);
+        CPPUNIT_TEST(testCopyTo);
+        CPPUNIT_TEST(testCopyToOverlapping);
         CPPUNIT_TEST(testFillWithConstValue);
         CPPUNIT_TEST(testFillWithGenerator);
         CPPUNIT_TEST(testFillWithConstExplosiveValue);
@@ -799,6 +801,62 @@ public:
         }
     }
 
+    void testCopyTo() {
+        int src[16];
+        generateTestArray(src, [](size_t i) { return static_cast<int>(i)*3 - 5; });
+
+        int dst[16];
+        auto source = arrayView(src);
+        auto dest = arrayView(dst);
+
+        source.copyTo(dest);
+        for (ArrayView<int>::size_type i = 0; i < source.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(src[i], dst[i]);
+        }
+
+        {  // Copying into a view that is too small is not Ok:
+            int tiny[4];
+            auto tinyDest = arrayView(tiny);
+            CPPUNIT_ASSERT_THROW(source.copyTo(tinyDest), IndexOutOfRangeException);
+        }
+
+        {  // An empty view copies into anything, trivially:
+            ArrayView<int>().copyTo(dest);
+            CPPUNIT_ASSERT_EQUAL(src[0], dst[0]);
+        }
+    }
+
+    void testCopyToOverlapping() {
+        int buffer[16];
+        auto whole = arrayView(buffer);
+
+        {  // Shift left - source ahead of destination:
+            whole.fill([](ArrayView<int>::size_type i) { return static_cast<int>(i); });
+            arrayView(buffer + 4, buffer + 16).copyTo(arrayView(buffer, buffer + 12));
+            for (ArrayView<int>::size_type i = 0; i < 12; ++i) {
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(i) + 4, buffer[i]);
+            }
+        }
+
+        {  // Shift right - destination ahead of source:
+            whole.fill([](ArrayView<int>::size_type i) { return static_cast<int>(i); });
+            arrayView(buffer, buffer + 12).copyTo(arrayView(buffer + 4, buffer + 16));
+            for (ArrayView<int>::size_type i = 4; i < 16; ++i) {
+                CPPUNIT_ASSERT_EQUAL(static_cast<int>(i) - 4, buffer[i]);
+            }
+        }
+
+        {  // Non-trivially-copyable elements take the element-wise path, overlap included:
+            std::string words[6] = {"a", "b", "c", "d", "e", "f"};
+            arrayView(words, words + 4).copyTo(arrayView(words + 2, words + 6));
+
+            CPPUNIT_ASSERT_EQUAL(std::string("a"), words[2]);
+            CPPUNIT_ASSERT_EQUAL(std::string("b"), words[3]);
+            CPPUNIT_ASSERT_EQUAL(std::string("c"), words[4]);
+            CPPUNIT_ASSERT_EQUAL(std::string("d"), words[5]);
+        }
+    }
+
     void testFillWithConstValue() {
         int src[24];
         auto array = arrayView(src);
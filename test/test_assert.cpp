@@ -0,0 +1,84 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_assert.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/assert.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+#include <solace/io/traceRing.hpp>
+#include <solace/memoryManager.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+class TestAssert : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestAssert);
+        CPPUNIT_TEST(testAssertThrowsByDefault);
+        CPPUNIT_TEST(testViolationCounters);
+        CPPUNIT_TEST(testTraceSink);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testAssertThrowsByDefault() {
+        // This suite is built without SOLACE_ASSERT_COUNT_VIOLATIONS, so
+        // violations throw and the counters stay untouched by them:
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(3), assertIndexInRange(3, 0, 10));
+        CPPUNIT_ASSERT_THROW(assertIndexInRange(10, 0, 10), IndexOutOfRangeException);
+    }
+
+    void testViolationCounters() {
+        // The cold halves of the counting mode are always linked in, so
+        // their bookkeeping is testable without rebuilding under the flag:
+        const auto before = assertViolations();
+
+        noteIndexOutOfRange(12, 0, 10);
+        noteIndexOutOfRange(99, 0, 10);
+        noteNullPointer();
+
+        const auto after = assertViolations();
+        CPPUNIT_ASSERT_EQUAL(before.indexViolations + 2, after.indexViolations);
+        CPPUNIT_ASSERT_EQUAL(before.nullViolations + 1, after.nullViolations);
+    }
+
+    void testTraceSink() {
+        MemoryManager manager(64 * 1024);
+        auto ring = IO::TraceRing::create(manager.create(IO::TraceRing::bufferSizeFor(64)), 64);
+
+        setAssertTraceSink(&ring);
+        noteIndexOutOfRange(100, 0, 10);
+        setAssertTraceSink(nullptr);
+
+        // Detached: counted but no longer traced.
+        noteIndexOutOfRange(100, 0, 10);
+
+        IO::TraceRing::Event events[8];
+        const auto n = ring.readBack(arrayView(events));
+        CPPUNIT_ASSERT_EQUAL(static_cast<IO::TraceRing::size_type>(1), n);
+        CPPUNIT_ASSERT_EQUAL(AssertTraceEvents::kIndexOutOfRange, events[0].id);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(100), events[0].arg0);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(10), events[0].arg1);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestAssert);
@@ -39,6 +39,11 @@ class TestBase16: public CppUnit::TestFixture  {
         CPPUNIT_TEST(decodingInvalidInputThrows);
         CPPUNIT_TEST(decodingInputOfUnEvenSizeThrows);
         CPPUNIT_TEST(decodingIntoSmallerBufferErrors);
+        CPPUNIT_TEST(testStreamDecodingSplitPair);
+
+        CPPUNIT_TEST(testBulkEncode);
+        CPPUNIT_TEST(testBulkDecode);
+        CPPUNIT_TEST(testBulkDecodeRejectsInvalidInput);
 
         CPPUNIT_TEST(testBasicEncodingIterator);
         CPPUNIT_TEST(testDecodingIterator);
@@ -246,6 +251,67 @@ public:
 
         CPPUNIT_ASSERT(v.encode(wrapMemory("666F6F626172", 12)).isError());
     }
+
+    void testStreamDecodingSplitPair() {
+        byte buffer[6];
+        WriteBuffer dest(wrapMemory(buffer));
+        Base16StreamDecoder v(dest);
+
+        // The digits of one byte arrive in different chunks:
+        CPPUNIT_ASSERT(v.encode(wrapMemory("666", 3)).isOk());
+        CPPUNIT_ASSERT(v.encode(wrapMemory("F6F626172", 9)).isOk());
+
+        const char* expected = "foobar";
+        CPPUNIT_ASSERT_EQUAL(wrapMemory(expected, 6), dest.viewWritten().viewImmutableShallow());
+
+        CPPUNIT_ASSERT(v.encode(wrapMemory("zz", 2)).isError());
+    }
+
+    void testBulkEncode() {
+        byte buffer[80];
+
+        // Length past the 16-byte block boundary exercises both the unrolled loop and the tail:
+        auto const message = wrapMemory("This is test message we want to encode", 38);
+        auto const result = base16Encode(message, wrapMemory(buffer));
+
+        CPPUNIT_ASSERT(result.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(76), result.unwrap());
+        CPPUNIT_ASSERT_EQUAL(wrapMemory("546869732069732074657374206d6573736167652077652077616e7420746f20656e636f6465",
+                                        76),
+                             wrapMemory(buffer, 76).viewImmutableShallow());
+
+        // Destination too small:
+        CPPUNIT_ASSERT(base16Encode(message, wrapMemory(buffer, 75)).isError());
+    }
+
+    void testBulkDecode() {
+        byte buffer[40];
+
+        auto const encodedText =
+                wrapMemory("546869732069732074657374206D6573736167652077652077616E7420746F20656E636F6465", 76);
+        auto const result = base16Decode(encodedText, wrapMemory(buffer));
+
+        CPPUNIT_ASSERT(result.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(38), result.unwrap());
+        CPPUNIT_ASSERT_EQUAL(wrapMemory("This is test message we want to encode", 38),
+                             wrapMemory(buffer, 38).viewImmutableShallow());
+
+        // Destination too small:
+        CPPUNIT_ASSERT(base16Decode(encodedText, wrapMemory(buffer, 37)).isError());
+    }
+
+    void testBulkDecodeRejectsInvalidInput() {
+        byte buffer[40];
+
+        // Uneven length:
+        CPPUNIT_ASSERT(base16Decode(wrapMemory("666F6F626172", 11), wrapMemory(buffer)).isError());
+
+        // Character outside of the alphabet, inside a full 16-character block:
+        CPPUNIT_ASSERT(base16Decode(wrapMemory("666F6F62617266g66F6F62617266F6", 30), wrapMemory(buffer)).isError());
+
+        // ... and in the tail:
+        CPPUNIT_ASSERT(base16Decode(wrapMemory("66zz", 4), wrapMemory(buffer)).isError());
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestBase16);
@@ -45,6 +45,13 @@ class TestBase64: public CppUnit::TestFixture  {
 
         CPPUNIT_TEST(testUnicodeCharactersEncoding);
         CPPUNIT_TEST(testUnicodeCharactersDecoding);
+
+        CPPUNIT_TEST(testStreamEncodingChunked);
+        CPPUNIT_TEST(testStreamEncodingMatchesWholeView);
+        CPPUNIT_TEST(testStreamDecodingChunked);
+        CPPUNIT_TEST(testStreamDecoderRejectsInvalidInput);
+        CPPUNIT_TEST(testStreamDecoderWhitespaceModes);
+        CPPUNIT_TEST(testStreamDecoderWrappedFeed);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -247,6 +254,133 @@ public:
 
         CPPUNIT_ASSERT_EQUAL(wrapMemory(expectedMsg, strlen(expectedMsg)), dest.viewWritten().viewImmutableShallow());
     }
+
+    void testStreamEncodingChunked() {
+        byte buffer[64];
+        WriteBuffer dest(wrapMemory(buffer));
+        Base64StreamEncoder encoder(dest);
+
+        // Feed "foobar" one byte at a time - group boundaries land mid-chunk:
+        const char* srcMem = "foobar";
+        for (size_t i = 0; i < strlen(srcMem); ++i) {
+            CPPUNIT_ASSERT(encoder.encode(wrapMemory(srcMem + i, 1)).isOk());
+        }
+        CPPUNIT_ASSERT(encoder.finalize().isOk());
+
+        const char* expected = "Zm9vYmFy";
+        CPPUNIT_ASSERT_EQUAL(wrapMemory(expected, strlen(expected)), dest.viewWritten().viewImmutableShallow());
+
+        // The encoder is reusable after finalize(); padding comes out right too:
+        CPPUNIT_ASSERT(encoder.encode(wrapMemory("fo", 2)).isOk());
+        CPPUNIT_ASSERT(encoder.finalize().isOk());
+
+        const char* expected2 = "Zm9vYmFyZm8=";
+        CPPUNIT_ASSERT_EQUAL(wrapMemory(expected2, strlen(expected2)), dest.viewWritten().viewImmutableShallow());
+    }
+
+    void testStreamEncodingMatchesWholeView() {
+        // A message long enough to push the bulk path through the SIMD kernels:
+        byte message[331];
+        for (size_t i = 0; i < sizeof(message); ++i) {
+            message[i] = static_cast<byte>(i * 31 + 7);
+        }
+
+        byte refBuffer[512];
+        WriteBuffer refDest(wrapMemory(refBuffer));
+        Base64Encoder reference(refDest);
+        CPPUNIT_ASSERT(reference.encode(wrapMemory(message)).isOk());
+
+        byte buffer[512];
+        WriteBuffer dest(wrapMemory(buffer));
+        Base64StreamEncoder encoder(dest);
+        CPPUNIT_ASSERT(encoder.encode(wrapMemory(message, 100)).isOk());
+        CPPUNIT_ASSERT(encoder.encode(wrapMemory(message + 100, 231)).isOk());
+        CPPUNIT_ASSERT(encoder.finalize().isOk());
+
+        CPPUNIT_ASSERT_EQUAL(refDest.viewWritten().viewImmutableShallow(),
+                             dest.viewWritten().viewImmutableShallow());
+    }
+
+    void testStreamDecodingChunked() {
+        byte buffer[30];
+        WriteBuffer dest(wrapMemory(buffer));
+        Base64StreamDecoder decoder(dest);
+
+        // Split mid-group and right through the padding:
+        CPPUNIT_ASSERT(decoder.encode(wrapMemory("Zm9vYm", 6)).isOk());
+        CPPUNIT_ASSERT(decoder.encode(wrapMemory("E=", 2)).isOk());
+        CPPUNIT_ASSERT(decoder.finalize().isOk());
+
+        const char* expected = "fooba";
+        CPPUNIT_ASSERT_EQUAL(wrapMemory(expected, strlen(expected)), dest.viewWritten().viewImmutableShallow());
+    }
+
+    void testStreamDecoderRejectsInvalidInput() {
+        byte buffer[30];
+        WriteBuffer dest(wrapMemory(buffer));
+        Base64StreamDecoder decoder(dest);
+
+        CPPUNIT_ASSERT(decoder.encode(wrapMemory("Zm#v", 4)).isError());
+    }
+
+    void testStreamDecoderWhitespaceModes() {
+        byte buffer[30];
+
+        {  // By default whitespace is rejected like any other stray character:
+            WriteBuffer dest(wrapMemory(buffer));
+            Base64StreamDecoder decoder(dest);
+            CPPUNIT_ASSERT(decoder.encode(wrapMemory("Zm9v\nYmFy", 9)).isError());
+        }
+
+        {  // Skip mode ignores spaces, tabs and line breaks wherever they land:
+            WriteBuffer dest(wrapMemory(buffer));
+            Base64StreamDecoder decoder(dest, Base64StreamDecoder::Whitespace::Skip);
+            CPPUNIT_ASSERT(decoder.encode(wrapMemory(" Zm\t9v\r\nYmFy\n", 13)).isOk());
+            CPPUNIT_ASSERT(decoder.finalize().isOk());
+
+            const char* expected = "foobar";
+            CPPUNIT_ASSERT_EQUAL(wrapMemory(expected, strlen(expected)), dest.viewWritten().viewImmutableShallow());
+        }
+
+        {  // Anything that is not whitespace still fails the call:
+            WriteBuffer dest(wrapMemory(buffer));
+            Base64StreamDecoder decoder(dest, Base64StreamDecoder::Whitespace::Skip);
+            CPPUNIT_ASSERT(decoder.encode(wrapMemory("Zm#v", 4)).isError());
+        }
+    }
+
+    void testStreamDecoderWrappedFeed() {
+        // A message long enough to push the bulk path through the SIMD kernels:
+        byte message[331];
+        for (size_t i = 0; i < sizeof(message); ++i) {
+            message[i] = static_cast<byte>(i * 31 + 7);
+        }
+
+        byte encBuffer[512];
+        WriteBuffer encDest(wrapMemory(encBuffer));
+        Base64Encoder encoder(encDest);
+        CPPUNIT_ASSERT(encoder.encode(wrapMemory(message)).isOk());
+        auto const encoded = encDest.viewWritten().viewImmutableShallow();
+
+        // Wrap the encoding at 76 columns, MIME-style:
+        byte wrapped[512 + 16];
+        size_t wrappedLen = 0;
+        for (size_t i = 0; i < encoded.size(); ++i) {
+            wrapped[wrappedLen++] = encoded[i];
+            if ((i + 1) % 76 == 0) {
+                wrapped[wrappedLen++] = '\r';
+                wrapped[wrappedLen++] = '\n';
+            }
+        }
+
+        byte buffer[512];
+        WriteBuffer dest(wrapMemory(buffer));
+        Base64StreamDecoder decoder(dest, Base64StreamDecoder::Whitespace::Skip);
+        CPPUNIT_ASSERT(decoder.encode(wrapMemory(wrapped, wrappedLen)).isOk());
+        CPPUNIT_ASSERT(decoder.finalize().isOk());
+
+        CPPUNIT_ASSERT_EQUAL(wrapMemory(message).viewImmutableShallow(), dest.viewWritten().viewImmutableShallow());
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestBase64);
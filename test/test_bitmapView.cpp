@@ -0,0 +1,162 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_bitmapView.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/bitmapView.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <bitset>
+#include <random>
+
+
+using namespace Solace;
+
+
+class TestBitmapView : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestBitmapView);
+        CPPUNIT_TEST(testSetTestClear);
+        CPPUNIT_TEST(testCountAndFill);
+        CPPUNIT_TEST(testFindFirstSet);
+        CPPUNIT_TEST(testForEachSet);
+        CPPUNIT_TEST(testBulkCombinersAgainstBitset);
+        CPPUNIT_TEST(testSizeMismatchThrows);
+        CPPUNIT_TEST(testOutOfRangeBitThrows);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testSetTestClear() {
+        // Odd byte count: the last word of the view is partial.
+        byte storage[13] = {};
+        BitmapView bm(wrapMemory(storage));
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(104), bm.size());
+
+        bm.set(0);
+        bm.set(63);
+        bm.set(64);
+        bm.set(103);
+        CPPUNIT_ASSERT(bm.test(0) && bm.test(63) && bm.test(64) && bm.test(103));
+        CPPUNIT_ASSERT(!bm.test(1) && !bm.test(65));
+
+        bm.clear(63);
+        CPPUNIT_ASSERT(!bm.test(63));
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(3), bm.count());
+    }
+
+    void testCountAndFill() {
+        byte storage[16] = {};
+        BitmapView bm(wrapMemory(storage));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(0), bm.count());
+
+        bm.setAll();
+        CPPUNIT_ASSERT_EQUAL(bm.size(), bm.count());
+
+        bm.clearAll();
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(0), bm.count());
+    }
+
+    void testFindFirstSet() {
+        byte storage[13] = {};
+        BitmapView bm(wrapMemory(storage));
+
+        CPPUNIT_ASSERT(bm.findFirstSet().isNone());
+
+        bm.set(0);
+        bm.set(64);
+        bm.set(103);
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(0), bm.findFirstSet().get());
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(64), bm.findFirstSet(1).get());
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(64), bm.findFirstSet(64).get());
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(103), bm.findFirstSet(65).get());
+        CPPUNIT_ASSERT(bm.findFirstSet(104).isNone());
+    }
+
+    void testForEachSet() {
+        byte storage[13] = {};
+        BitmapView bm(wrapMemory(storage));
+
+        bm.set(3);
+        bm.set(64);
+        bm.set(100);
+
+        BitmapView::size_type seen[3];
+        int nbSeen = 0;
+        bm.forEachSet([&seen, &nbSeen](BitmapView::size_type i) { seen[nbSeen++] = i; });
+
+        CPPUNIT_ASSERT_EQUAL(3, nbSeen);
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(3), seen[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(64), seen[1]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(100), seen[2]);
+    }
+
+    void testBulkCombinersAgainstBitset() {
+        constexpr int N = 512;
+        byte a[N / 8] = {};
+        byte b[N / 8] = {};
+        BitmapView va(wrapMemory(a));
+        BitmapView vb(wrapMemory(b));
+        std::bitset<N> ra;
+        std::bitset<N> rb;
+
+        std::mt19937_64 rng(2016);
+        for (int i = 0; i < N; ++i) {
+            if (rng() & 1) { va.set(i); ra.set(i); }
+            if (rng() & 1) { vb.set(i); rb.set(i); }
+        }
+
+        va.andWith(vb);
+        ra &= rb;
+        for (int i = 0; i < N; ++i) {
+            CPPUNIT_ASSERT_EQUAL(ra.test(i), va.test(i));
+        }
+
+        va.orWith(vb);
+        ra |= rb;
+        va.xorWith(vb);
+        ra ^= rb;
+        for (int i = 0; i < N; ++i) {
+            CPPUNIT_ASSERT_EQUAL(ra.test(i), va.test(i));
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<BitmapView::size_type>(ra.count()), va.count());
+    }
+
+    void testSizeMismatchThrows() {
+        byte big[16] = {};
+        byte small[4] = {};
+        BitmapView vbig(wrapMemory(big));
+        BitmapView vsmall(wrapMemory(small));
+
+        CPPUNIT_ASSERT_THROW(vbig.andWith(vsmall), IllegalArgumentException);
+    }
+
+    void testOutOfRangeBitThrows() {
+        byte storage[4] = {};
+        BitmapView bm(wrapMemory(storage));
+
+        CPPUNIT_ASSERT_THROW(bm.test(32), IndexOutOfRangeException);
+        CPPUNIT_ASSERT_THROW(bm.set(32), IndexOutOfRangeException);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestBitmapView);
@@ -43,6 +43,9 @@ class TestByteBuffer :
         CPPUNIT_TEST(readLittleEndian);
         CPPUNIT_TEST(writeBigEndian);
         CPPUNIT_TEST(writeLittleEndian);
+
+        CPPUNIT_TEST(testNamedMarks);
+        CPPUNIT_TEST(testConsumedWatermark);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -261,6 +264,66 @@ public:
 
     }
 
+    void testNamedMarks() {
+        byte bytes[16];
+        ByteBuffer buffer(wrapMemory(bytes));
+
+        CPPUNIT_ASSERT(buffer.advance(4).isOk());
+        buffer.mark("header");
+        CPPUNIT_ASSERT_EQUAL(static_cast<ByteBuffer::size_type>(4),
+                             buffer.markPosition("header").get());
+
+        // Read ahead, then resume from the checkpoint:
+        CPPUNIT_ASSERT(buffer.advance(6).isOk());
+        CPPUNIT_ASSERT(buffer.restore("header").isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<ByteBuffer::size_type>(4), buffer.position());
+
+        // Re-marking under the same name moves the mark:
+        CPPUNIT_ASSERT(buffer.advance(2).isOk());
+        buffer.mark("header");
+        CPPUNIT_ASSERT_EQUAL(static_cast<ByteBuffer::size_type>(6),
+                             buffer.markPosition("header").get());
+
+        CPPUNIT_ASSERT(buffer.restore("noSuchMark").isError());
+        CPPUNIT_ASSERT(buffer.markPosition("noSuchMark").isNone());
+
+        CPPUNIT_ASSERT(buffer.dropMark("header"));
+        CPPUNIT_ASSERT(!buffer.dropMark("header"));
+        CPPUNIT_ASSERT(buffer.restore("header").isError());
+
+        // clear() drops marks:
+        buffer.mark("m");
+        buffer.clear();
+        CPPUNIT_ASSERT(buffer.restore("m").isError());
+    }
+
+    void testConsumedWatermark() {
+        byte bytes[16];
+        ByteBuffer buffer(wrapMemory(bytes));
+
+        // A complete message is consumed; a partial one only read ahead:
+        CPPUNIT_ASSERT(buffer.advance(8).isOk());
+        CPPUNIT_ASSERT(buffer.consume(8).isOk());
+        CPPUNIT_ASSERT(buffer.advance(4).isOk());
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<ByteBuffer::size_type>(8), buffer.consumed());
+        CPPUNIT_ASSERT_EQUAL(static_cast<ByteBuffer::size_type>(4), buffer.unconsumed());
+        CPPUNIT_ASSERT_EQUAL(static_cast<ByteBuffer::size_type>(4), buffer.viewUnconsumed().size());
+
+        // The watermark cannot pass the read position:
+        CPPUNIT_ASSERT(buffer.consume(5).isError());
+        CPPUNIT_ASSERT(buffer.consume(4).isOk());
+
+        // A mark below the watermark cannot be restored:
+        CPPUNIT_ASSERT(buffer.position(2).isOk());
+        buffer.mark("stale");
+        CPPUNIT_ASSERT(buffer.position(12).isOk());
+        CPPUNIT_ASSERT(buffer.restore("stale").isError());
+
+        buffer.clear();
+        CPPUNIT_ASSERT_EQUAL(static_cast<ByteBuffer::size_type>(0), buffer.consumed());
+    }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestByteBuffer);
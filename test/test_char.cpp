@@ -23,6 +23,7 @@
 #include <solace/char.hpp>  // Class being tested.
 
 #include <string.h>
+#include <ctype.h>
 #include <cppunit/extensions/HelperMacros.h>
 
 using namespace Solace;
@@ -34,6 +35,7 @@ class TestChar : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testConstruction);
         CPPUNIT_TEST(testAssignment);
         CPPUNIT_TEST(testEquality);
+        CPPUNIT_TEST(testClassification);
 	CPPUNIT_TEST_SUITE_END();
 
 
@@ -97,6 +99,32 @@ public:
 		CPPUNIT_ASSERT(!a.equals(b));
 	}
 
+    void testClassification() {
+        // The class table matches <cctype> C-locale semantics for every byte:
+        for (int c = 0; c < 256; ++c) {
+            const Char ch{static_cast<byte>(c)};
+
+            CPPUNIT_ASSERT_EQUAL(isdigit(c) != 0,   ch.isDigit());
+            CPPUNIT_ASSERT_EQUAL(isxdigit(c) != 0,  ch.isXDigit());
+            CPPUNIT_ASSERT_EQUAL(isalpha(c) != 0,   ch.isLetter());
+            CPPUNIT_ASSERT_EQUAL(isalnum(c) != 0,   ch.isLetterOrDigit());
+            CPPUNIT_ASSERT_EQUAL(isupper(c) != 0,   ch.isUpperCase());
+            CPPUNIT_ASSERT_EQUAL(islower(c) != 0,   ch.isLowerCase());
+            CPPUNIT_ASSERT_EQUAL(isspace(c) != 0,   ch.isWhitespace());
+            CPPUNIT_ASSERT_EQUAL(iscntrl(c) != 0,   ch.isCntrl());
+            CPPUNIT_ASSERT_EQUAL(isgraph(c) != 0,   ch.isGraphical());
+            CPPUNIT_ASSERT_EQUAL(isprint(c) != 0,   ch.isPrintable());
+            CPPUNIT_ASSERT_EQUAL(ispunct(c) != 0,   ch.isPunctuation());
+            CPPUNIT_ASSERT_EQUAL(isalnum(c) != 0 || c == '_', ch.isSymbol());
+            CPPUNIT_ASSERT_EQUAL(isalpha(c) != 0 || c == '_', ch.isFirstSymbol());
+        }
+
+        // Class bits combine for multi-class tests in a single load:
+        CPPUNIT_ASSERT(Char::categoryOf('7') & (Char::Digit | Char::Whitespace));
+        CPPUNIT_ASSERT(Char::categoryOf(' ') & (Char::Digit | Char::Whitespace));
+        CPPUNIT_ASSERT(!(Char::categoryOf('x') & (Char::Digit | Char::Whitespace)));
+    }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestChar);
@@ -0,0 +1,81 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_checked.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/checked.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <limits>
+
+
+using namespace Solace;
+
+
+class TestChecked : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestChecked);
+        CPPUNIT_TEST(testCheckedAdd);
+        CPPUNIT_TEST(testCheckedSub);
+        CPPUNIT_TEST(testCheckedMul);
+        CPPUNIT_TEST(testNarrow);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testCheckedAdd() {
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(3), checkedAdd<uint32>(1, 2).get());
+
+        const auto top = std::numeric_limits<uint32>::max();
+        CPPUNIT_ASSERT_EQUAL(top, checkedAdd<uint32>(top, 0).get());
+        CPPUNIT_ASSERT(checkedAdd<uint32>(top, 1).isNone());
+
+        // Signed overflow is a failure, not UB:
+        CPPUNIT_ASSERT(checkedAdd<int32>(std::numeric_limits<int32>::max(), 1).isNone());
+        CPPUNIT_ASSERT(checkedAdd<int32>(std::numeric_limits<int32>::min(), -1).isNone());
+    }
+
+    void testCheckedSub() {
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(2), checkedSub<uint64>(7, 5).get());
+
+        // Unsigned underflow:
+        CPPUNIT_ASSERT(checkedSub<uint64>(5, 7).isNone());
+
+        // The same operands fit a signed type just fine:
+        CPPUNIT_ASSERT_EQUAL(static_cast<int64>(-2), checkedSub<int64>(5, 7).get());
+    }
+
+    void testCheckedMul() {
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(6), checkedMul<uint32>(2, 3).get());
+        CPPUNIT_ASSERT(checkedMul<uint32>(1u << 16, 1u << 16).isNone());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1) << 32,
+                             checkedMul<uint64>(1ull << 16, 1ull << 16).get());
+    }
+
+    void testNarrow() {
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(65535), narrow<uint16>(static_cast<uint64>(65535)).get());
+        CPPUNIT_ASSERT(narrow<uint16>(static_cast<uint64>(65536)).isNone());
+
+        // Sign changes count as loss too:
+        CPPUNIT_ASSERT(narrow<uint32>(static_cast<int64>(-1)).isNone());
+        CPPUNIT_ASSERT_EQUAL(static_cast<int32>(3), narrow<int32>(static_cast<uint64>(3)).get());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestChecked);
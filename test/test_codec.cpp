@@ -0,0 +1,138 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_codec.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/codec.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+class TestCodec : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestCodec);
+        CPPUNIT_TEST(testRoundTrip);
+        CPPUNIT_TEST(testWireLayout);
+        CPPUNIT_TEST(testDecodeUnderflow);
+        CPPUNIT_TEST(testEncodeOverflow);
+        CPPUNIT_TEST(testSignedVarint);
+    CPPUNIT_TEST_SUITE_END();
+
+    // A frame header as a gateway would describe it: mixed endianness,
+    // a varint length, and a fixed field after the varint.
+    using FrameHeader = Codec<FixedBE<uint16>, FixedBE<uint32>, Varint<uint64>, FixedLE<uint16>>;
+
+public:
+
+    void testRoundTrip() {
+        static_assert(FrameHeader::fixedPrefixSize() == 6, "Leading fixed run is kind + stream id");
+
+        byte mem[32];
+        WriteBuffer writer(wrapMemory(mem));
+        CPPUNIT_ASSERT(FrameHeader::encode(writer, 0x0102, 0x03040506u, 300, 0xAABB).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(10), writer.position());
+
+        ReadBuffer reader(wrapMemory(mem, 10));
+        uint16 kind = 0;
+        uint32 stream = 0;
+        uint64 length = 0;
+        uint16 tail = 0;
+        CPPUNIT_ASSERT(FrameHeader::decode(reader, kind, stream, length, tail).isOk());
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(0x0102), kind);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0x03040506), stream);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(300), length);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(0xAABB), tail);
+        CPPUNIT_ASSERT(!reader.hasRemaining());
+    }
+
+    void testWireLayout() {
+        byte mem[32];
+        WriteBuffer writer(wrapMemory(mem));
+        CPPUNIT_ASSERT(FrameHeader::encode(writer, 0x0102, 0x03040506u, 300, 0xAABB).isOk());
+
+        // Big-endian prefix, byte for byte:
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x01), mem[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x02), mem[1]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x03), mem[2]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x06), mem[5]);
+        // Varint 300 encodes as AC 02:
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0xAC), mem[6]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x02), mem[7]);
+        // Little-endian trailer:
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0xBB), mem[8]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0xAA), mem[9]);
+    }
+
+    void testDecodeUnderflow() {
+        byte mem[32];
+        WriteBuffer writer(wrapMemory(mem));
+        CPPUNIT_ASSERT(FrameHeader::encode(writer, 1, 2, 3, 4).isOk());
+
+        uint16 kind;
+        uint32 stream;
+        uint64 length;
+        uint16 tail;
+
+        // Shorter than the fixed prefix: fails without consuming the run.
+        ReadBuffer tiny(wrapMemory(mem, 3));
+        CPPUNIT_ASSERT(FrameHeader::decode(tiny, kind, stream, length, tail).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<ReadBuffer::size_type>(0), tiny.position());
+
+        // Cut off inside the trailing field:
+        ReadBuffer cut(wrapMemory(mem, 8));
+        CPPUNIT_ASSERT(FrameHeader::decode(cut, kind, stream, length, tail).isError());
+    }
+
+    void testEncodeOverflow() {
+        byte small[4];
+        WriteBuffer tight(wrapMemory(small));
+        CPPUNIT_ASSERT(FrameHeader::encode(tight, 1, 2, 3, 4).isError());
+
+        // With an overflow handler installed the same encode spills and succeeds:
+        byte a[4];
+        byte b[32];
+        WriteBuffer spilly(wrapMemory(a));
+        spilly.onOverflow([&b](WriteBuffer::size_type) -> Optional<MemoryBuffer> {
+            return MemoryBuffer(wrapMemory(b));
+        });
+        CPPUNIT_ASSERT(FrameHeader::encode(spilly, 0x0102, 0x03040506u, 300, 0xAABB).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(10), spilly.totalWritten());
+    }
+
+    void testSignedVarint() {
+        using Message = Codec<Varint<int64>, FixedLE<uint8>>;
+
+        byte mem[16];
+        WriteBuffer writer(wrapMemory(mem));
+        CPPUNIT_ASSERT(Message::encode(writer, -1, 7).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x01), mem[0]);  // Zig-zag keeps -1 one byte
+
+        ReadBuffer reader(wrapMemory(mem, 2));
+        int64 value = 0;
+        uint8 trailer = 0;
+        CPPUNIT_ASSERT(Message::decode(reader, value, trailer).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<int64>(-1), value);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint8>(7), trailer);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCodec);
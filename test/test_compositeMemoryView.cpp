@@ -0,0 +1,115 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_compositeMemoryView.cpp
+*******************************************************************************/
+#include <solace/compositeMemoryView.hpp>  // Class being tested
+
+#include <solace/io/file.hpp>
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <unistd.h>
+
+using namespace Solace;
+using namespace Solace::IO;
+
+
+class TestCompositeMemoryView: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestCompositeMemoryView);
+        CPPUNIT_TEST(testEmpty);
+        CPPUNIT_TEST(testAppend);
+        CPPUNIT_TEST(testAppendOverCapacityThrows);
+        CPPUNIT_TEST(testVectoredWrite);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmpty() {
+        CompositeMemoryView v;
+
+        CPPUNIT_ASSERT(v.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), v.count());
+        CPPUNIT_ASSERT_EQUAL(static_cast<CompositeMemoryView::size_type>(0), v.size());
+    }
+
+    void testAppend() {
+        byte header[4] = {'H', 'D', 'R', '|'};
+        const char payload[] = "payload";
+
+        byte storage[16];
+        WriteBuffer trailer(wrapMemory(storage));
+        CPPUNIT_ASSERT(trailer.write(wrapMemory("!TRL", 4)).isOk());
+
+        CompositeMemoryView v;
+        v.append(wrapMemory(header))
+         .append(wrapMemory(payload, strlen(payload)))
+         .append(trailer);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(3), v.count());
+        CPPUNIT_ASSERT_EQUAL(static_cast<CompositeMemoryView::size_type>(4 + strlen(payload) + 4), v.size());
+        CPPUNIT_ASSERT(!v.empty());
+
+        CPPUNIT_ASSERT(v.segment(0) == wrapMemory(header));
+        CPPUNIT_ASSERT(v.segment(2) == trailer.viewWritten());
+        CPPUNIT_ASSERT_THROW(v.segment(3), IndexOutOfRangeException);
+    }
+
+    void testAppendOverCapacityThrows() {
+        byte block[1] = {0};
+
+        CompositeMemoryView v;
+        for (uint32 i = 0; i < CompositeMemoryView::MaxSegments; ++i) {
+            v.append(wrapMemory(block));
+        }
+
+        CPPUNIT_ASSERT_EQUAL(CompositeMemoryView::MaxSegments, v.count());
+        CPPUNIT_ASSERT_THROW(v.append(wrapMemory(block)), IndexOutOfRangeException);
+    }
+
+    void testVectoredWrite() {
+        byte header[4] = {'H', 'D', 'R', '|'};
+        const char payload[] = "payload-bytes";
+
+        CompositeMemoryView v;
+        v.append(wrapMemory(header))
+         .append(wrapMemory(payload, strlen(payload)));
+
+        int pipeFds[2];
+        CPPUNIT_ASSERT(pipe(pipeFds) == 0);
+
+        auto out = File::fromFd(pipeFds[1]);
+        const auto written = out.write(v);
+        CPPUNIT_ASSERT(written.isOk());
+        CPPUNIT_ASSERT_EQUAL(v.size(), static_cast<CompositeMemoryView::size_type>(written.unwrap()));
+        out.close();
+
+        byte readBack[32];
+        auto in = File::fromFd(pipeFds[0]);
+        auto readBuffer = wrapMemory(readBack);
+        const auto bytesRead = in.read(readBuffer);
+        CPPUNIT_ASSERT(bytesRead.isOk());
+        CPPUNIT_ASSERT_EQUAL(v.size(), static_cast<CompositeMemoryView::size_type>(bytesRead.unwrap()));
+        CPPUNIT_ASSERT(memcmp(readBack, "HDR|payload-bytes", v.size()) == 0);
+        in.close();
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCompositeMemoryView);
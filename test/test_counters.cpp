@@ -0,0 +1,137 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_counters.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/counters.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <thread>
+#include <vector>
+
+
+using namespace Solace;
+
+
+class TestCounters: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestCounters);
+        CPPUNIT_TEST(testCounterSingleThread);
+        CPPUNIT_TEST(testCounterAcrossThreads);
+        CPPUNIT_TEST(testHistogramBuckets);
+        CPPUNIT_TEST(testHistogramQuantile);
+        CPPUNIT_TEST(testHistogramAcrossThreads);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testCounterSingleThread() {
+        StatsCounter counter;
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), counter.value());
+
+        counter.add();
+        counter.add(41);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(42), counter.value());
+    }
+
+    void testCounterAcrossThreads() {
+        StatsCounter counter;
+
+        const uint32 nbThreads = 4;
+        const uint32 perThread = 100000;
+
+        std::vector<std::thread> workers;
+        for (uint32 t = 0; t < nbThreads; ++t) {
+            workers.emplace_back([&counter]() {
+                for (uint32 i = 0; i < perThread; ++i) {
+                    counter.add();
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        // Shards lose nothing, whatever the interleaving:
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(nbThreads) * perThread, counter.value());
+    }
+
+    void testHistogramBuckets() {
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), StatsHistogram::bucketOf(0));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), StatsHistogram::bucketOf(1));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), StatsHistogram::bucketOf(2));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), StatsHistogram::bucketOf(3));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(10), StatsHistogram::bucketOf(1024));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(63), StatsHistogram::bucketOf(~static_cast<uint64>(0)));
+
+        StatsHistogram histogram;
+        histogram.record(0);
+        histogram.record(1);
+        histogram.record(100);
+        histogram.record(100);
+
+        const auto snapshot = histogram.snapshot();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(4), snapshot.count);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(201), snapshot.sum);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(2), snapshot.buckets[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(2), snapshot.buckets[6]);
+    }
+
+    void testHistogramQuantile() {
+        StatsHistogram histogram;
+
+        // Nothing recorded: the quantile degrades to zero, not UB.
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), histogram.snapshot().quantile(0.99));
+
+        // 99 fast requests and one disaster:
+        for (int i = 0; i < 99; ++i) {
+            histogram.record(100);      // bucket 6: [64, 128)
+        }
+        histogram.record(1000000);      // bucket 19
+
+        const auto snapshot = histogram.snapshot();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(127), snapshot.quantile(0.5));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>((1u << 20) - 1), snapshot.quantile(0.999));
+    }
+
+    void testHistogramAcrossThreads() {
+        StatsHistogram histogram;
+
+        const uint32 nbThreads = 4;
+        const uint32 perThread = 10000;
+
+        std::vector<std::thread> workers;
+        for (uint32 t = 0; t < nbThreads; ++t) {
+            workers.emplace_back([&histogram, t]() {
+                for (uint32 i = 0; i < perThread; ++i) {
+                    histogram.record(t + 1);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        const auto snapshot = histogram.snapshot();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(nbThreads) * perThread, snapshot.count);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(perThread) * (1 + 2 + 3 + 4), snapshot.sum);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCounters);
@@ -0,0 +1,73 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_cpuFeatures.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/cpuFeatures.hpp>  // Module being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+class TestCpuFeatures: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestCpuFeatures);
+        CPPUNIT_TEST(testDetectionIsStable);
+        CPPUNIT_TEST(testFeatureImplications);
+        CPPUNIT_TEST(testArchitectureExclusivity);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testDetectionIsStable() {
+        // Detection runs once; every call sees the same table.
+        CPPUNIT_ASSERT(&cpuFeatures() == &cpuFeatures());
+    }
+
+    void testFeatureImplications() {
+        const auto& features = cpuFeatures();
+
+        // No real CPU has a wider extension without the narrower ones:
+        if (features.avx512bw) {
+            CPPUNIT_ASSERT(features.avx2);
+        }
+        if (features.avx2) {
+            CPPUNIT_ASSERT(features.avx);
+        }
+        if (features.avx) {
+            CPPUNIT_ASSERT(features.sse42);
+        }
+        if (features.sse42) {
+            CPPUNIT_ASSERT(features.sse41);
+            CPPUNIT_ASSERT(features.ssse3);
+        }
+    }
+
+    void testArchitectureExclusivity() {
+        const auto& features = cpuFeatures();
+
+        // One process runs on one architecture:
+        if (features.neon || features.crc32 || features.sha2 || features.aes) {
+            CPPUNIT_ASSERT(!features.ssse3 && !features.avx2 && !features.sha);
+        }
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestCpuFeatures);
@@ -0,0 +1,120 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_delegate.cpp
+ * @author: soultaker
+ *
+*******************************************************************************/
+#include <solace/delegate.hpp>  // Class being tested
+
+#include <memory>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+namespace {
+
+int addOne(int x) {
+    return x + 1;
+}
+
+struct Widget {
+    int base;
+
+    int add(int x) { return base + x; }
+    int addConst(int x) const { return base + x + 100; }
+};
+
+}  // namespace
+
+
+class TestDelegate: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestDelegate);
+        CPPUNIT_TEST(testInplaceFreeFunction);
+        CPPUNIT_TEST(testInplaceMemberPairs);
+        CPPUNIT_TEST(testInplaceMoveOnlyCapture);
+        CPPUNIT_TEST(testInplaceMoveSemantics);
+        CPPUNIT_TEST(testInplaceReassignment);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testInplaceFreeFunction() {
+        inplace_delegate<int(int)> bound(addOne);
+        CPPUNIT_ASSERT_EQUAL(2, bound(1));
+
+        // Compile-time binding dispatches without reading the store:
+        auto direct = inplace_delegate<int(int)>::from<&addOne>();
+        CPPUNIT_ASSERT(static_cast<bool>(direct));
+        CPPUNIT_ASSERT_EQUAL(3, direct(2));
+    }
+
+    void testInplaceMemberPairs() {
+        Widget w{10};
+
+        inplace_delegate<int(int)> method(&w, &Widget::add);
+        CPPUNIT_ASSERT_EQUAL(15, method(5));
+
+        inplace_delegate<int(int)> constMethod(static_cast<Widget const*>(&w), &Widget::addConst);
+        CPPUNIT_ASSERT_EQUAL(115, constMethod(5));
+
+        auto direct = inplace_delegate<int(int)>::from<Widget, &Widget::add>(&w);
+        CPPUNIT_ASSERT_EQUAL(17, direct(7));
+    }
+
+    void testInplaceMoveOnlyCapture() {
+        auto payload = std::make_unique<int>(41);
+
+        // The capture lives in the delegate's own storage - never the heap:
+        inplace_delegate<int(int)> d([q = std::move(payload)](int x) { return *q + x; });
+        CPPUNIT_ASSERT_EQUAL(42, d(1));
+    }
+
+    void testInplaceMoveSemantics() {
+        auto payload = std::make_unique<int>(40);
+        inplace_delegate<int(int)> a([q = std::move(payload)](int x) { return *q + x; });
+
+        auto b = std::move(a);
+        CPPUNIT_ASSERT(!a);
+        CPPUNIT_ASSERT_EQUAL(42, b(2));
+
+        a = std::move(b);
+        CPPUNIT_ASSERT(!b);
+        CPPUNIT_ASSERT_EQUAL(43, a(3));
+
+        a.reset();
+        CPPUNIT_ASSERT(a == nullptr);
+    }
+
+    void testInplaceReassignment() {
+        int counter = 0;
+
+        inplace_delegate<void()> d([&counter] { ++counter; });
+        d();
+        d();
+
+        d = [&counter] { counter += 10; };
+        d();
+
+        CPPUNIT_ASSERT_EQUAL(12, counter);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestDelegate);
@@ -0,0 +1,206 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_encoderPipeline.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/encoderPipeline.hpp>  // Class being tested
+
+#include <solace/base64.hpp>
+#include <solace/framing.hpp>
+#include <solace/lz4.hpp>
+#include <solace/memoryManager.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <vector>
+
+
+using namespace Solace;
+
+
+class TestEncoderPipeline : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestEncoderPipeline);
+        CPPUNIT_TEST(testEmptyPipelinePassthrough);
+        CPPUNIT_TEST(testSingleStageChunking);
+        CPPUNIT_TEST(testThreeStageRoundtrip);
+        CPPUNIT_TEST(testEmptyInput);
+        CPPUNIT_TEST(testEncodedSizeIsAnUpperBound);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+
+    static std::vector<byte> makePayload(size_t size) {
+        std::vector<byte> payload(size);
+        for (size_t i = 0; i < size; ++i) {
+            // Mildly compressible but not degenerate:
+            payload[i] = static_cast<byte>((i / 7) ^ (i & 0x3F));
+        }
+
+        return payload;
+    }
+
+public:
+
+    void testEmptyPipelinePassthrough() {
+        MemoryManager manager(4096);
+        const auto payload = makePayload(100);
+
+        byte wire[256];
+        WriteBuffer dest(wrapMemory(wire));
+        EncoderPipeline pipeline(dest, manager);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<EncoderPipeline::size_type>(0), pipeline.nbStages());
+
+        auto src = wrapMemory(payload.data(), payload.size());
+        CPPUNIT_ASSERT_EQUAL(payload.size(),
+                             static_cast<size_t>(pipeline.encodedSize(src)));
+        CPPUNIT_ASSERT(pipeline.encode(src).isOk());
+        CPPUNIT_ASSERT_EQUAL(payload.size(), static_cast<size_t>(dest.position()));
+        CPPUNIT_ASSERT(memcmp(wire, payload.data(), payload.size()) == 0);
+    }
+
+    void testSingleStageChunking() {
+        MemoryManager manager(64 * 1024);
+        const auto payload = makePayload(250);
+
+        EncoderPipeline::Options options;
+        options.chunkSize = 96;  // 250 bytes -> 2 full chunks + 58-byte tail
+
+        byte wire[1024];
+        WriteBuffer dest(wrapMemory(wire));
+        EncoderPipeline pipeline(dest, manager, options);
+        pipeline.then<FrameEncoder>();
+
+        auto src = wrapMemory(payload.data(), payload.size());
+        CPPUNIT_ASSERT(pipeline.encode(src).isOk());
+
+        // Each chunk is one frame on the wire:
+        CPPUNIT_ASSERT_EQUAL(payload.size() + 3 * Framing::kOverhead,
+                             static_cast<size_t>(dest.position()));
+
+        ReadBuffer in(wrapMemory(static_cast<const byte*>(wire), dest.position()));
+        FrameDecoder decoder;
+        byte recovered[128];
+        auto recoveredView = wrapMemory(recovered);
+
+        size_t offset = 0;
+        for (int frame = 0; frame < 3; ++frame) {
+            auto r = decoder.decode(in, recoveredView);
+            CPPUNIT_ASSERT(r.isOk() && r.unwrap().isSome());
+
+            const auto len = static_cast<size_t>(r.unwrap().get());
+            CPPUNIT_ASSERT(memcmp(recovered, payload.data() + offset, len) == 0);
+            offset += len;
+        }
+        CPPUNIT_ASSERT_EQUAL(payload.size(), offset);
+    }
+
+    void testThreeStageRoundtrip() {
+        MemoryManager manager(512 * 1024);
+        const auto payload = makePayload(1000);
+
+        EncoderPipeline::Options options;
+        options.chunkSize = 48 * 5;  // Several rounds; a multiple of 3 for base64
+
+        std::vector<byte> wire(16 * 1024);
+        WriteBuffer dest(wrapMemory(wire.data(), wire.size()));
+        EncoderPipeline pipeline(dest, manager, options);
+        pipeline.then<Lz4Encoder>()
+                .then<Base64Encoder>()
+                .then<FrameEncoder>();
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<EncoderPipeline::size_type>(3), pipeline.nbStages());
+        CPPUNIT_ASSERT(pipeline.encode(wrapMemory(payload.data(), payload.size())).isOk());
+
+        // Walk the units back: frames hold base64 text holding lz4 frames.
+        ReadBuffer in(wrapMemory(static_cast<const byte*>(wire.data()), dest.position()));
+        FrameDecoder frames;
+        byte framePayload[4096];
+        auto framePayloadView = wrapMemory(framePayload);
+
+        std::vector<byte> recovered(2 * payload.size());
+        WriteBuffer plain(wrapMemory(recovered.data(), recovered.size()));
+        Lz4Decoder unpack(plain);
+
+        for (;;) {
+            auto r = frames.decode(in, framePayloadView);
+            CPPUNIT_ASSERT(r.isOk());
+            if (r.unwrap().isNone()) {
+                break;
+            }
+
+            byte lz4Data[4096];
+            WriteBuffer packed(wrapMemory(lz4Data));
+            Base64StreamDecoder untext(packed);
+            CPPUNIT_ASSERT(untext.encode(wrapMemory(framePayload, r.unwrap().get())).isOk());
+            CPPUNIT_ASSERT(untext.finalize().isOk());
+
+            CPPUNIT_ASSERT(unpack.encode(packed.viewWritten()).isOk());
+        }
+
+        CPPUNIT_ASSERT_EQUAL(payload.size(), static_cast<size_t>(plain.position()));
+        CPPUNIT_ASSERT(memcmp(recovered.data(), payload.data(), payload.size()) == 0);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), frames.stats().framesCorrupted);
+    }
+
+    void testEmptyInput() {
+        MemoryManager manager(4096);
+
+        byte wire[64];
+        WriteBuffer dest(wrapMemory(wire));
+        EncoderPipeline pipeline(dest, manager);
+        pipeline.then<FrameEncoder>();
+
+        // An empty source still makes one round - the frame for it decodes:
+        CPPUNIT_ASSERT(pipeline.encode(ImmutableMemoryView{}).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(Framing::kOverhead),
+                             static_cast<size_t>(dest.position()));
+
+        ReadBuffer in(wrapMemory(static_cast<const byte*>(wire), dest.position()));
+        FrameDecoder decoder;
+        byte recovered[16];
+        auto r = decoder.decode(in, wrapMemory(recovered));
+        CPPUNIT_ASSERT(r.isOk() && r.unwrap().isSome());
+        CPPUNIT_ASSERT_EQUAL(static_cast<FrameDecoder::size_type>(0), r.unwrap().get());
+    }
+
+    void testEncodedSizeIsAnUpperBound() {
+        MemoryManager manager(512 * 1024);
+        const auto payload = makePayload(777);
+
+        EncoderPipeline::Options options;
+        options.chunkSize = 48 * 2;
+
+        std::vector<byte> wire(16 * 1024);
+        WriteBuffer dest(wrapMemory(wire.data(), wire.size()));
+        EncoderPipeline pipeline(dest, manager, options);
+        pipeline.then<Lz4Encoder>()
+                .then<Base64Encoder>()
+                .then<FrameEncoder>();
+
+        auto src = wrapMemory(payload.data(), payload.size());
+        const auto bound = pipeline.encodedSize(src);
+
+        CPPUNIT_ASSERT(pipeline.encode(src).isOk());
+        CPPUNIT_ASSERT(dest.position() <= bound);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestEncoderPipeline);
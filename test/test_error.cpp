@@ -0,0 +1,133 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_error.cpp
+ * @author: soultaker
+ *
+*******************************************************************************/
+#include <solace/error.hpp>  // Class being tested
+#include <solace/result.hpp>
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+namespace {
+
+class TestErrorDomain :
+        public ErrorDomain {
+public:
+
+    StringView name() const noexcept override {
+        return "test";
+    }
+
+    StringView message(int code) const noexcept override {
+        return (code == 1)
+                ? StringView{"queue full"}
+                : StringView{"unknown"};
+    }
+};
+
+const TestErrorDomain kTestDomain;
+
+}  // namespace
+
+
+class TestError: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestError);
+        CPPUNIT_TEST(testErrorCodeDefaults);
+        CPPUNIT_TEST(testErrorCodeDomain);
+        CPPUNIT_TEST(testSystemDomain);
+        CPPUNIT_TEST(testSystemMessagePerThread);
+        CPPUNIT_TEST(testErrorCodeAsResultError);
+        CPPUNIT_TEST(testConversionToError);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testErrorCodeDefaults() {
+        ErrorCode none;
+
+        CPPUNIT_ASSERT(!none);
+        CPPUNIT_ASSERT_EQUAL(0, none.value());
+        CPPUNIT_ASSERT(none.toString().empty());
+    }
+
+    void testErrorCodeDomain() {
+        ErrorCode err(kTestDomain, 1);
+
+        CPPUNIT_ASSERT(static_cast<bool>(err));
+        CPPUNIT_ASSERT_EQUAL(1, err.value());
+        CPPUNIT_ASSERT(err.toString().equals("queue full"));
+        CPPUNIT_ASSERT(err.domain()->name().equals("test"));
+
+        CPPUNIT_ASSERT(err == ErrorCode(kTestDomain, 1));
+        CPPUNIT_ASSERT(err != ErrorCode(kTestDomain, 2));
+    }
+
+    void testSystemDomain() {
+        auto const err = systemError(EAGAIN);
+
+        CPPUNIT_ASSERT_EQUAL(EAGAIN, err.value());
+        CPPUNIT_ASSERT(err.domain() == &systemErrorDomain());
+        CPPUNIT_ASSERT(err.toString().equals(strerror(EAGAIN)));
+
+        // The same code in a different domain is a different error:
+        CPPUNIT_ASSERT(err != ErrorCode(kTestDomain, EAGAIN));
+    }
+
+    void testSystemMessagePerThread() {
+        // Messages render into a per-thread buffer: another thread rendering
+        // a different code must not clobber this thread's text.
+        auto const mine = systemError(EAGAIN).toString();
+
+        bool otherRendered = false;
+        std::thread other([&otherRendered]() {
+            otherRendered = systemError(ENOENT).toString().equals(strerror(ENOENT));
+        });
+        other.join();
+
+        CPPUNIT_ASSERT(otherRendered);
+        CPPUNIT_ASSERT(mine.equals(strerror(EAGAIN)));
+    }
+
+    void testErrorCodeAsResultError() {
+        auto wouldBlock = []() -> Result<int, ErrorCode> {
+            return Err(systemError(EAGAIN));
+        };
+
+        auto const r = wouldBlock();
+        CPPUNIT_ASSERT(r.isError());
+        CPPUNIT_ASSERT(r.getError() == systemError(EAGAIN));
+    }
+
+    void testConversionToError() {
+        auto const heavy = ErrorCode(kTestDomain, 1).toError();
+
+        CPPUNIT_ASSERT_EQUAL(1, heavy.value());
+        CPPUNIT_ASSERT(heavy.toString().equals("queue full"));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestError);
@@ -0,0 +1,138 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_executor.cpp
+ * @author: soultaker
+ *******************************************************************************/
+#include <solace/executor.hpp>  // Class being tested
+#include <solace/future.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <thread>
+
+using namespace Solace;
+
+
+class TestExecutor: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestExecutor);
+        CPPUNIT_TEST(testInlineExecutorRunsSynchronously);
+        CPPUNIT_TEST(testPoolRunsAllSubmittedTasks);
+        CPPUNIT_TEST(testThenViaPoolRunsOffCompletionThread);
+        CPPUNIT_TEST(testThenViaInlineExecutor);
+        CPPUNIT_TEST(testChainingThroughExecutor);
+        CPPUNIT_TEST(testErrorPropagatesThroughExecutor);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testInlineExecutorRunsSynchronously() {
+        InlineExecutor executor;
+
+        bool ran = false;
+        executor.submit([&ran]() { ran = true; });
+
+        CPPUNIT_ASSERT(ran);
+    }
+
+    void testPoolRunsAllSubmittedTasks() {
+        std::atomic<int> count{0};
+
+        {
+            ThreadPoolExecutor pool(3);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(3), pool.workerCount());
+
+            for (int i = 0; i < 5000; ++i) {
+                pool.submit([&count]() { count.fetch_add(1); });
+            }
+        }  // Destructor drains the queues
+
+        CPPUNIT_ASSERT_EQUAL(5000, count.load());
+    }
+
+    void testThenViaPoolRunsOffCompletionThread() {
+        ThreadPoolExecutor pool(2);
+
+        Promise<int> promise;
+        auto future = promise.getFuture();
+
+        std::atomic<bool> done{false};
+        std::thread::id continuationThread;
+        future.then(pool, [&](int x) {
+            CPPUNIT_ASSERT_EQUAL(120, x);
+            continuationThread = std::this_thread::get_id();
+            done.store(true);
+        });
+
+        promise.setValue(120);
+        while (!done.load()) {
+            std::this_thread::yield();
+        }
+
+        CPPUNIT_ASSERT(continuationThread != std::this_thread::get_id());
+    }
+
+    void testThenViaInlineExecutor() {
+        InlineExecutor executor;
+
+        Promise<int> promise;
+        auto future = promise.getFuture();
+
+        int got = 0;
+        future.then(executor, [&got](int x) { got = x; });
+
+        promise.setValue(42);
+        CPPUNIT_ASSERT_EQUAL(42, got);
+    }
+
+    void testChainingThroughExecutor() {
+        ThreadPoolExecutor pool(2);
+
+        Promise<void> promise;
+        auto future = promise.getFuture();
+
+        std::atomic<int> result{0};
+        future.then(pool, []() { return 10; })
+              .then(pool, [&result](int x) { result.store(x + 1); });
+
+        promise.setValue();
+        while (result.load() != 11) {
+            std::this_thread::yield();
+        }
+    }
+
+    void testErrorPropagatesThroughExecutor() {
+        ThreadPoolExecutor pool(2);
+
+        Promise<int> promise;
+        auto future = promise.getFuture();
+
+        std::atomic<bool> errorSeen{false};
+        future.then(pool, [](int x) { return x; })
+              .onError([&errorSeen](Error&&) { errorSeen.store(true); return -1; });
+
+        promise.setError(Error("test"));
+        while (!errorSeen.load()) {
+            std::this_thread::yield();
+        }
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestExecutor);
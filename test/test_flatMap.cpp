@@ -0,0 +1,143 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_flatMap.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/flatMap.hpp>  // Class being tested
+
+#include <solace/string.hpp>
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <memory>
+
+using namespace Solace;
+
+
+class TestFlatMap: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestFlatMap);
+        CPPUNIT_TEST(testPutFindRemove);
+        CPPUNIT_TEST(testKeysStaySorted);
+        CPPUNIT_TEST(testBinaryProbeCapacity);
+        CPPUNIT_TEST(testPutIntoFullMapThrows);
+        CPPUNIT_TEST(testHeterogeneousLookup);
+        CPPUNIT_TEST(testNonTrivialValues);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testPutFindRemove() {
+        FlatMap<int, int, 8> map;
+        CPPUNIT_ASSERT(map.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<FlatMap<int, int, 8>::size_type>(8), map.capacity());
+
+        map.put(3, 30);
+        map.put(1, 10);
+        map.put(2, 20);
+        CPPUNIT_ASSERT_EQUAL(static_cast<FlatMap<int, int, 8>::size_type>(3), map.size());
+        CPPUNIT_ASSERT_EQUAL(10, *map.find(1));
+        CPPUNIT_ASSERT_EQUAL(30, *map.find(3));
+        CPPUNIT_ASSERT(map.find(4) == nullptr);
+
+        // Replacement keeps the size:
+        map.put(2, 200);
+        CPPUNIT_ASSERT_EQUAL(static_cast<FlatMap<int, int, 8>::size_type>(3), map.size());
+        CPPUNIT_ASSERT_EQUAL(200, *map.find(2));
+
+        CPPUNIT_ASSERT(map.remove(2));
+        CPPUNIT_ASSERT(!map.remove(2));
+        CPPUNIT_ASSERT(map.find(2) == nullptr);
+        CPPUNIT_ASSERT_EQUAL(30, *map.find(3));
+    }
+
+
+    void testKeysStaySorted() {
+        FlatMap<int, int, 8> map{{5, 50}, {1, 10}, {3, 30}};
+
+        int last = 0;
+        map.forEach([&last](int const& key, int const& ) {
+            CPPUNIT_ASSERT(last < key);
+            last = key;
+        });
+        CPPUNIT_ASSERT_EQUAL(5, last);
+    }
+
+
+    void testBinaryProbeCapacity() {
+        static_assert(FlatMap<int, int, 8>::kLinearProbe, "Small maps probe linearly");
+        static_assert(!FlatMap<int, int, 64>::kLinearProbe, "Larger maps binary search");
+
+        FlatMap<int, int, 64> map;
+        for (int i = 63; i >= 0; --i) {
+            map.put(i * 2, i);
+        }
+
+        CPPUNIT_ASSERT(map.full());
+        for (int i = 0; i < 64; ++i) {
+            CPPUNIT_ASSERT_EQUAL(i, *map.find(i * 2));
+            CPPUNIT_ASSERT(map.find(i * 2 + 1) == nullptr);
+        }
+    }
+
+
+    void testPutIntoFullMapThrows() {
+        FlatMap<int, int, 2> map{{1, 10}, {2, 20}};
+
+        CPPUNIT_ASSERT_THROW(map.put(3, 30), IndexOutOfRangeException);
+
+        // Replacing an existing key is still fine:
+        map.put(1, 100);
+        CPPUNIT_ASSERT_EQUAL(100, *map.find(1));
+    }
+
+
+    void testHeterogeneousLookup() {
+        FlatMap<String, int, 8> headers;
+        headers.put(String("content-type"), 1);
+        headers.put(String("content-length"), 2);
+        headers.put(String("host"), 3);
+
+        // A StringView probe orders against String keys without allocating:
+        CPPUNIT_ASSERT_EQUAL(3, *headers.find(StringView("host")));
+        CPPUNIT_ASSERT_EQUAL(2, *headers.find(StringView("content-length")));
+        CPPUNIT_ASSERT(headers.find(StringView("cookie")) == nullptr);
+        CPPUNIT_ASSERT(headers.contains(StringView("content-type")));
+    }
+
+
+    void testNonTrivialValues() {
+        FlatMap<int, std::shared_ptr<int>, 8> map{{1, std::make_shared<int>(10)},
+                                                  {2, std::make_shared<int>(20)}};
+
+        auto copy = map;
+        CPPUNIT_ASSERT_EQUAL(10, **copy.find(1));
+
+        auto moved = std::move(copy);
+        CPPUNIT_ASSERT(copy.empty());
+        CPPUNIT_ASSERT_EQUAL(20, **moved.find(2));
+
+        moved.clear();
+        CPPUNIT_ASSERT(moved.empty());
+        CPPUNIT_ASSERT_EQUAL(10, **map.find(1));  // the original is untouched
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFlatMap);
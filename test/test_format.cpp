@@ -0,0 +1,99 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_format.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/format.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+class TestFormat : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestFormat);
+        CPPUNIT_TEST(testMixedArgumentTypes);
+        CPPUNIT_TEST(testIntegerExtremes);
+        CPPUNIT_TEST(testEscapedBraces);
+        CPPUNIT_TEST(testNoPlaceholders);
+        CPPUNIT_TEST(testArgumentCountMismatchThrows);
+        CPPUNIT_TEST(testMalformedFormatThrows);
+        CPPUNIT_TEST(testCompileTimeArgCount);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+
+    byte _storage[512];
+
+    template<typename... Args>
+    String render(StringView fmt, Args&&... args) {
+        StringBuilder sb(wrapMemory(_storage));
+
+        return format(sb, fmt, std::forward<Args>(args)...).toString();
+    }
+
+public:
+
+    void testMixedArgumentTypes() {
+        CPPUNIT_ASSERT_EQUAL(String("host=node-7 port=8080 load=0.25 up=true grade=A"),
+                             render("host={} port={} load={} up={} grade={}",
+                                    StringView("node-7"), uint16(8080), 0.25, true, 'A'));
+    }
+
+    void testIntegerExtremes() {
+        CPPUNIT_ASSERT_EQUAL(String("-9223372036854775808 18446744073709551615"),
+                             render("{} {}",
+                                    std::numeric_limits<int64>::min(),
+                                    std::numeric_limits<uint64>::max()));
+    }
+
+    void testEscapedBraces() {
+        CPPUNIT_ASSERT_EQUAL(String("{json: 1} done"),
+                             render("{{json: {}}} done", 1));
+    }
+
+    void testNoPlaceholders() {
+        CPPUNIT_ASSERT_EQUAL(String("plain text"), render("plain text"));
+    }
+
+    void testArgumentCountMismatchThrows() {
+        CPPUNIT_ASSERT_THROW(render("{} and {}", 1), IllegalArgumentException);
+        CPPUNIT_ASSERT_THROW(render("only {}", 1, 2), IllegalArgumentException);
+    }
+
+    void testMalformedFormatThrows() {
+        CPPUNIT_ASSERT_THROW(render("stray } here"), IllegalArgumentException);
+        CPPUNIT_ASSERT_THROW(render("open { here", 1), IllegalArgumentException);
+        CPPUNIT_ASSERT_THROW(render("trailing {"), IllegalArgumentException);
+    }
+
+    void testCompileTimeArgCount() {
+        SOLACE_ASSERT_FORMAT("a={} b={}", 2);
+        SOLACE_ASSERT_FORMAT("{{literal}} only", 0);
+
+        static_assert(details::formatArgCount("bad {x}") == -1, "rejected");
+        static_assert(details::formatArgCount("bad }") == -1, "rejected");
+        static_assert(details::formatArgCount("{}{}{}") == 3, "counted");
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFormat);
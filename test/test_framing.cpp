@@ -0,0 +1,188 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_framing.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/framing.hpp>  // Class being tested
+
+#include <solace/writeBuffer.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+
+using namespace Solace;
+
+
+class TestFraming : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestFraming);
+        CPPUNIT_TEST(testRoundtrip);
+        CPPUNIT_TEST(testIncrementalDecoding);
+        CPPUNIT_TEST(testResyncAfterCorruption);
+        CPPUNIT_TEST(testGarbagePrefixSkipped);
+        CPPUNIT_TEST(testInsaneLengthDropped);
+        CPPUNIT_TEST(testDestinationTooSmall);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+
+    std::vector<byte> encodeAll(std::vector<std::string> const& messages) {
+        std::vector<byte> wire(1 << 16);
+        auto wireView = wrapMemory(wire.data(), wire.size());
+        WriteBuffer out(wireView);
+        FrameEncoder encoder(out);
+
+        for (auto const& m : messages) {
+            CPPUNIT_ASSERT(encoder.encode(wrapMemory(m.data(), m.size())).isOk());
+        }
+
+        wire.resize(out.position());
+        return wire;
+    }
+
+public:
+
+    void testRoundtrip() {
+        const std::vector<std::string> messages = {"hello", "", std::string(3000, 'x')};
+        const auto wire = encodeAll(messages);
+
+        size_t expectedLen = 0;
+        for (auto const& m : messages) {
+            expectedLen += m.size() + Framing::kOverhead;
+        }
+        CPPUNIT_ASSERT_EQUAL(expectedLen, wire.size());
+
+        ReadBuffer in(wrapMemory(static_cast<const byte*>(wire.data()), wire.size()));
+        FrameDecoder decoder;
+        byte payload[4096];
+        auto payloadView = wrapMemory(payload);
+
+        for (auto const& m : messages) {
+            auto r = decoder.decode(in, payloadView);
+            CPPUNIT_ASSERT(r.isOk());
+            CPPUNIT_ASSERT(r.unwrap().isSome());
+            CPPUNIT_ASSERT_EQUAL(m.size(), static_cast<size_t>(r.unwrap().get()));
+            CPPUNIT_ASSERT(memcmp(payload, m.data(), m.size()) == 0);
+        }
+
+        auto r = decoder.decode(in, payloadView);
+        CPPUNIT_ASSERT(r.isOk() && r.unwrap().isNone());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(3), decoder.stats().framesDecoded);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), decoder.stats().bytesSkipped);
+    }
+
+    void testIncrementalDecoding() {
+        const std::string msg = "short read torture";
+        const auto wire = encodeAll({msg});
+
+        FrameDecoder decoder;
+        byte payload[64];
+        auto payloadView = wrapMemory(payload);
+
+        // Every proper prefix of the frame must yield "need more bytes":
+        for (size_t n = 0; n < wire.size(); ++n) {
+            ReadBuffer in(wrapMemory(static_cast<const byte*>(wire.data()), n));
+            auto r = decoder.decode(in, payloadView);
+            CPPUNIT_ASSERT(r.isOk() && r.unwrap().isNone());
+            CPPUNIT_ASSERT_EQUAL(static_cast<ReadBuffer::size_type>(0), in.position());
+        }
+
+        ReadBuffer in(wrapMemory(static_cast<const byte*>(wire.data()), wire.size()));
+        auto r = decoder.decode(in, payloadView);
+        CPPUNIT_ASSERT(r.isOk());
+        CPPUNIT_ASSERT_EQUAL(msg.size(), static_cast<size_t>(r.unwrap().get()));
+    }
+
+    void testResyncAfterCorruption() {
+        auto wire = encodeAll({"first message", "second message"});
+
+        // Flip a payload byte of the first frame - its checksum now fails:
+        wire[Framing::kHeaderSize + 3] ^= 0xFF;
+
+        ReadBuffer in(wrapMemory(static_cast<const byte*>(wire.data()), wire.size()));
+        FrameDecoder decoder;
+        byte payload[64];
+        auto payloadView = wrapMemory(payload);
+
+        const std::string survivor = "second message";
+        auto r = decoder.decode(in, payloadView);
+        CPPUNIT_ASSERT(r.isOk());
+        CPPUNIT_ASSERT(r.unwrap().isSome());
+        CPPUNIT_ASSERT_EQUAL(survivor.size(), static_cast<size_t>(r.unwrap().get()));
+        CPPUNIT_ASSERT(memcmp(payload, survivor.data(), survivor.size()) == 0);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), decoder.stats().framesCorrupted);
+        CPPUNIT_ASSERT(decoder.stats().bytesSkipped > 0);
+    }
+
+    void testGarbagePrefixSkipped() {
+        const std::string msg = "payload";
+        const auto frame = encodeAll({msg});
+
+        // Garbage before the frame, with a false marker byte in the middle:
+        std::vector<byte> wire = {0x00, 0xFF, 0xA5, 0x42, 0x07};
+        const auto garbageLen = wire.size();
+        wire.insert(wire.end(), frame.begin(), frame.end());
+
+        ReadBuffer in(wrapMemory(static_cast<const byte*>(wire.data()), wire.size()));
+        FrameDecoder decoder;
+        byte payload[64];
+        auto payloadView = wrapMemory(payload);
+
+        auto r = decoder.decode(in, payloadView);
+        CPPUNIT_ASSERT(r.isOk());
+        CPPUNIT_ASSERT_EQUAL(msg.size(), static_cast<size_t>(r.unwrap().get()));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(garbageLen), decoder.stats().bytesSkipped);
+    }
+
+    void testInsaneLengthDropped() {
+        // A well-marked header declaring 4GiB of payload must be dropped as
+        // corrupt rather than waited for:
+        byte bogus[16] = {0xA5, 0x5A, 0xFF, 0xFF, 0xFF, 0xFF, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+
+        ReadBuffer in(wrapMemory(static_cast<const byte*>(bogus), sizeof(bogus)));
+        FrameDecoder decoder(1024);
+        byte payload[64];
+        auto payloadView = wrapMemory(payload);
+
+        auto r = decoder.decode(in, payloadView);
+        CPPUNIT_ASSERT(r.isOk() && r.unwrap().isNone());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), decoder.stats().framesCorrupted);
+    }
+
+    void testDestinationTooSmall() {
+        const auto wire = encodeAll({"this will not fit"});
+
+        ReadBuffer in(wrapMemory(static_cast<const byte*>(wire.data()), wire.size()));
+        FrameDecoder decoder;
+        byte tiny[4];
+        auto tinyView = wrapMemory(tiny);
+
+        auto r = decoder.decode(in, tinyView);
+        CPPUNIT_ASSERT(r.isError());
+
+        // The frame stays in the buffer for a retry with adequate storage:
+        CPPUNIT_ASSERT_EQUAL(static_cast<ReadBuffer::size_type>(0), in.position());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestFraming);
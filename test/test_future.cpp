@@ -108,7 +108,21 @@ class TestFuture : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testCollectIntegralWhenOneFailure);
         CPPUNIT_TEST(testCollectVoidWhenOneFailure);
 
+        CPPUNIT_TEST(testWhenAllIntegralSuccess);
+        CPPUNIT_TEST(testWhenAllVoidSuccess);
+        CPPUNIT_TEST(testWhenAllFirstErrorWins);
+        CPPUNIT_TEST(testWhenAllEmpty);
+
+        CPPUNIT_TEST(testWhenAnyFirstValueWins);
+        CPPUNIT_TEST(testWhenAnyAllFailures);
+
         CPPUNIT_TEST(testThenFiredDeletesClosure);
+        CPPUNIT_TEST(testThenWithLargeClosure);
+        CPPUNIT_TEST(testCorePool);
+
+        CPPUNIT_TEST(testDeadlineInheritedByContinuations);
+        CPPUNIT_TEST(testExpiredDeadlineShedsStage);
+        CPPUNIT_TEST(testDeadlineExpiryBetweenStages);
 
         CPPUNIT_TEST(readyFuture);
 
@@ -1265,6 +1279,132 @@ public:
         CPPUNIT_ASSERT(futureArrayErrored);
     }
 
+    void testWhenAllIntegralSuccess() {
+        Promise<int> promises[3];
+        Future<int> futures[] = {
+            promises[0].getFuture(),
+            promises[1].getFuture(),
+            promises[2].getFuture()
+        };
+
+        bool allReady = false;
+        whenAll(ArrayView<Future<int>>(futures, 3))
+            .then([&allReady](Array<int>&& values) {
+                CPPUNIT_ASSERT_EQUAL(static_cast<Array<int>::size_type>(3), values.size());
+                CPPUNIT_ASSERT_EQUAL(10, values[0]);
+                CPPUNIT_ASSERT_EQUAL(20, values[1]);
+                CPPUNIT_ASSERT_EQUAL(30, values[2]);
+
+                allReady = true;
+            });
+
+        // Completion order must not affect result order
+        promises[2].setValue(30);
+        promises[0].setValue(10);
+        CPPUNIT_ASSERT(!allReady);
+
+        promises[1].setValue(20);
+        CPPUNIT_ASSERT(allReady);
+    }
+
+    void testWhenAllVoidSuccess() {
+        Promise<void> promises[2];
+        Future<void> futures[] = {
+            promises[0].getFuture(),
+            promises[1].getFuture()
+        };
+
+        bool allReady = false;
+        whenAll(ArrayView<Future<void>>(futures, 2))
+            .then([&allReady]() {
+                allReady = true;
+            });
+
+        promises[0].setValue();
+        CPPUNIT_ASSERT(!allReady);
+
+        promises[1].setValue();
+        CPPUNIT_ASSERT(allReady);
+    }
+
+    void testWhenAllFirstErrorWins() {
+        Promise<int> promises[2];
+        Future<int> futures[] = {
+            promises[0].getFuture(),
+            promises[1].getFuture()
+        };
+
+        bool errored = false;
+        whenAll(ArrayView<Future<int>>(futures, 2))
+            .onError([&errored](Error&& ) {
+                errored = true;
+
+                return Array<int>();
+            });
+
+        promises[0].setError(Error("failed", 321));
+        CPPUNIT_ASSERT(!errored);  // Composite completes only when all futures have
+
+        promises[1].setValue(5);
+        CPPUNIT_ASSERT(errored);
+    }
+
+    void testWhenAllEmpty() {
+        bool allReady = false;
+        whenAll(ArrayView<Future<int>>())
+            .then([&allReady](Array<int>&& values) {
+                CPPUNIT_ASSERT(values.empty());
+                allReady = true;
+            });
+
+        CPPUNIT_ASSERT(allReady);
+    }
+
+    void testWhenAnyFirstValueWins() {
+        Promise<int> promises[3];
+        Future<int> futures[] = {
+            promises[0].getFuture(),
+            promises[1].getFuture(),
+            promises[2].getFuture()
+        };
+
+        int got = 0;
+        whenAny(ArrayView<Future<int>>(futures, 3))
+            .then([&got](int value) {
+                got = value;
+            });
+
+        promises[1].setValue(77);
+        CPPUNIT_ASSERT_EQUAL(77, got);
+
+        // Later results are ignored
+        promises[0].setValue(1);
+        promises[2].setError(Error("late", 321));
+        CPPUNIT_ASSERT_EQUAL(77, got);
+    }
+
+    void testWhenAnyAllFailures() {
+        Promise<int> promises[2];
+        Future<int> futures[] = {
+            promises[0].getFuture(),
+            promises[1].getFuture()
+        };
+
+        bool errored = false;
+        whenAny(ArrayView<Future<int>>(futures, 2))
+            .onError([&errored](Error&& ) {
+                errored = true;
+
+                return -1;
+            });
+
+        promises[0].setError(Error("a", 321));
+        CPPUNIT_ASSERT(!errored);  // An error only surfaces when no future can succeed
+
+        promises[1].setError(Error("b", 321));
+        CPPUNIT_ASSERT(errored);
+    }
+
     void testThenFiredDeletesClosure() {
         Promise<int> p;
         auto f = p.getFuture();
@@ -1280,6 +1420,135 @@ public:
     }
 
 
+    void testThenWithLargeClosure() {
+        // A closure too big for the core's inline callback storage takes the heap path
+        char filler[128];
+        for (size_t i = 0; i < sizeof(filler); ++i) {
+            filler[i] = static_cast<char>(i);
+        }
+
+        Promise<int> p;
+        auto f = p.getFuture();
+
+        int result = 0;
+        f.then([&result, filler](int x) {
+            result = x + filler[3];
+        });
+
+        p.setValue(10);
+        CPPUNIT_ASSERT_EQUAL(13, result);
+    }
+
+    void testCorePool() {
+        MemoryManager manager(1024 * 1024);
+        auto pool = manager.createPool(futureCoreSize<int>(), 32);
+        setFutureCorePool<int>(&pool);
+
+        // Every core - including the ones then() chains create - lives in the pool:
+        {
+            Promise<int> p;
+            auto f = p.getFuture();
+            CPPUNIT_ASSERT(pool.size() >= 1);
+
+            int observed = 0;
+            auto chained = f.then([](int x) { return x + 1; });
+            chained.then([&observed](int x) { observed = x; });
+
+            p.setValue(41);
+            CPPUNIT_ASSERT_EQUAL(42, observed);
+        }
+
+        // Dropping the chain returns every core to the pool:
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), pool.size());
+
+        // Completion on another thread releases into the pool safely:
+        {
+            Promise<int> p;
+            auto f = p.getFuture();
+
+            int got = 0;
+            f.then([&got](int x) { got = x; });
+
+            std::thread poster([&p]() { p.setValue(7); });
+            poster.join();
+
+            CPPUNIT_ASSERT_EQUAL(7, got);
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), pool.size());
+
+        // Reverting to the heap stops drawing from the pool:
+        setFutureCorePool<int>(nullptr);
+        {
+            Promise<int> p;
+            auto f = p.getFuture();
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), pool.size());
+            p.setValue(3);
+        }
+    }
+
+    void testDeadlineInheritedByContinuations() {
+        Promise<int> p;
+        p.setDeadline(Deadline::in(Timestamp::NanosInSecond));
+
+        auto f = p.getFuture();
+        CPPUNIT_ASSERT(f.deadline().isSet());
+        const auto expiry = f.deadline().expiryNanos;
+
+        // Every stage carries the same deadline and can query the budget left:
+        auto chained = f.then([](int x) { return x + 1; })
+                        .then([](int x) { return x * 2; });
+        CPPUNIT_ASSERT_EQUAL(expiry, chained.deadline().expiryNanos);
+        CPPUNIT_ASSERT(chained.deadline().remainingNanos() > 0);
+
+        int observed = 0;
+        chained.then([&observed](int x) { observed = x; });
+        p.setValue(20);
+        CPPUNIT_ASSERT_EQUAL(42, observed);
+
+        // A chain without a deadline is unset and never expires:
+        Promise<int> plain;
+        CPPUNIT_ASSERT(!plain.getFuture().deadline().isSet());
+    }
+
+    void testExpiredDeadlineShedsStage() {
+        Promise<int> p;
+        p.setDeadline(Deadline{1});  // A monotonic instant long past.
+
+        bool thenFired = false;
+        bool futureErrored = false;
+        p.getFuture()
+            .then([&thenFired](int) { thenFired = true; return 0; })
+            .onError([&futureErrored](Error&&) { futureErrored = true; return 0; });
+
+        // The value arrives after expiry: the continuation must not run.
+        p.setValue(5);
+        CPPUNIT_ASSERT(!thenFired);
+        CPPUNIT_ASSERT(futureErrored);
+    }
+
+    void testDeadlineExpiryBetweenStages() {
+        Promise<int> p;
+        p.setDeadline(Deadline::in(20 * 1000000));  // 20ms budget.
+
+        bool firstFired = false;
+        auto mid = p.getFuture().then([&firstFired](int x) { firstFired = true; return x; });
+
+        // The first stage completes within budget...
+        p.setValue(1);
+        CPPUNIT_ASSERT(firstFired);
+
+        // ...but a stage attached after expiry is dropped at the boundary:
+        std::this_thread::sleep_for(std::chrono::milliseconds(40));
+
+        bool secondFired = false;
+        bool futureErrored = false;
+        mid.then([&secondFired](int) { secondFired = true; return 0; })
+           .onError([&futureErrored](Error&&) { futureErrored = true; return 0; });
+
+        CPPUNIT_ASSERT(!secondFired);
+        CPPUNIT_ASSERT(futureErrored);
+    }
+
     void readyFuture() {
         bool thenFired = false;
         bool futureErrored = false;
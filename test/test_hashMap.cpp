@@ -0,0 +1,206 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_hashMap.cpp
+ * @author: soultaker
+ *******************************************************************************/
+#include <solace/hashMap.hpp>  // Class being tested
+
+#include <solace/string.hpp>
+#include <solace/path.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace Solace;
+
+
+class TestHashMap: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestHashMap);
+        CPPUNIT_TEST(testEmpty);
+        CPPUNIT_TEST(testPutFindRemove);
+        CPPUNIT_TEST(testOverwrite);
+        CPPUNIT_TEST(testGrowth);
+        CPPUNIT_TEST(testTombstoneReuse);
+        CPPUNIT_TEST(testHeterogeneousStringViewLookup);
+        CPPUNIT_TEST(testSeededHashProtocol);
+        CPPUNIT_TEST(testCopyAndMove);
+        CPPUNIT_TEST(testForEach);
+    CPPUNIT_TEST_SUITE_END();
+
+    using SizeType = HashMap<uint32, uint32>::size_type;
+
+public:
+
+    void testEmpty() {
+        HashMap<uint32, uint32> m;
+
+        CPPUNIT_ASSERT(m.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<SizeType>(0), m.size());
+        CPPUNIT_ASSERT(m.find(313u) == nullptr);
+        CPPUNIT_ASSERT(!m.contains(313u));
+        CPPUNIT_ASSERT(!m.remove(313u));
+    }
+
+    void testPutFindRemove() {
+        HashMap<uint32, uint32> m;
+
+        m.put(1u, 10u);
+        m.put(2u, 20u);
+        m.put(3u, 30u);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<SizeType>(3), m.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(20), *m.find(2u));
+        CPPUNIT_ASSERT(m.find(4u) == nullptr);
+
+        CPPUNIT_ASSERT(m.remove(2u));
+        CPPUNIT_ASSERT(!m.remove(2u));
+        CPPUNIT_ASSERT_EQUAL(static_cast<SizeType>(2), m.size());
+        CPPUNIT_ASSERT(m.find(2u) == nullptr);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(30), *m.find(3u));
+
+        m.clear();
+        CPPUNIT_ASSERT(m.empty());
+        CPPUNIT_ASSERT(m.find(1u) == nullptr);
+    }
+
+    void testOverwrite() {
+        HashMap<uint32, uint32> m;
+
+        m.put(5u, 1u);
+        m.put(5u, 2u);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<SizeType>(1), m.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(2), *m.find(5u));
+    }
+
+    void testGrowth() {
+        HashMap<uint32, uint64> m;
+
+        const uint32 count = 10000;
+        for (uint32 i = 0; i < count; ++i) {
+            m.put(i, static_cast<uint64>(i) * 3);
+        }
+
+        CPPUNIT_ASSERT_EQUAL(count, m.size());
+        for (uint32 i = 0; i < count; ++i) {
+            auto* v = m.find(i);
+            CPPUNIT_ASSERT(v != nullptr);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(i) * 3, *v);
+        }
+        CPPUNIT_ASSERT(m.find(count) == nullptr);
+
+        // A map constructed with the expected size never rehashes while filling up
+        HashMap<uint32, uint32> reserved(static_cast<SizeType>(1000));
+        const auto cap = reserved.capacity();
+        for (uint32 i = 0; i < 1000; ++i) {
+            reserved.put(i, i);
+        }
+        CPPUNIT_ASSERT_EQUAL(cap, reserved.capacity());
+    }
+
+    void testTombstoneReuse() {
+        HashMap<uint32, uint32> m;
+
+        for (uint32 i = 0; i < 1000; ++i) {
+            m.put(i, i);
+        }
+        for (uint32 i = 0; i < 1000; i += 2) {
+            CPPUNIT_ASSERT(m.remove(i));
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<SizeType>(500), m.size());
+
+        for (uint32 i = 0; i < 1000; i += 2) {
+            m.put(i, i + 1);
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<SizeType>(1000), m.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(5), *m.find(4u));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(5), *m.find(5u));
+    }
+
+    void testHeterogeneousStringViewLookup() {
+        HashMap<String, int> symbols;
+
+        symbols.put(String("alpha"), 1);
+        symbols.put(String("beta"), 2);
+        symbols.put(String("gamma"), 3);
+
+        // Probing with a StringView constructs no String
+        auto* v = symbols.find(StringView("beta"));
+        CPPUNIT_ASSERT(v != nullptr);
+        CPPUNIT_ASSERT_EQUAL(2, *v);
+
+        CPPUNIT_ASSERT(symbols.contains(StringView("gamma")));
+        CPPUNIT_ASSERT(!symbols.contains(StringView("delta")));
+
+        CPPUNIT_ASSERT(symbols.remove(StringView("alpha")));
+        CPPUNIT_ASSERT_EQUAL(static_cast<HashMap<String, int>::size_type>(2), symbols.size());
+    }
+
+    void testSeededHashProtocol() {
+        // The process seed is random but fixed for the process lifetime:
+        CPPUNIT_ASSERT_EQUAL(hashSeed(), hashSeed());
+
+        // hashOf routes string keys through the seeded overload, and String
+        // keys agree with the StringView probes used against them:
+        const StringView probe("flood-me");
+        CPPUNIT_ASSERT_EQUAL(probe.hashCode(hashSeed()), hashOf(probe));
+        CPPUNIT_ASSERT_EQUAL(hashOf(probe), hashOf(String("flood-me")));
+
+        // Types offering only the plain hashCode() keep their stable hash:
+        const Path p = Path::parse("/var/run/solace").unwrap();
+        CPPUNIT_ASSERT_EQUAL(p.hashCode(), hashOf(p));
+    }
+
+    void testCopyAndMove() {
+        HashMap<uint32, uint32> a;
+        for (uint32 i = 0; i < 100; ++i) {
+            a.put(i, i + 1);
+        }
+
+        HashMap<uint32, uint32> copy(a);
+        CPPUNIT_ASSERT_EQUAL(a.size(), copy.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(51), *copy.find(50u));
+
+        HashMap<uint32, uint32> moved(std::move(a));
+        CPPUNIT_ASSERT(a.empty());
+        CPPUNIT_ASSERT_EQUAL(copy.size(), moved.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), *moved.find(0u));
+
+        a = moved;
+        CPPUNIT_ASSERT_EQUAL(moved.size(), a.size());
+    }
+
+    void testForEach() {
+        HashMap<uint32, uint32> m;
+        m.put(1u, 2u);
+        m.put(3u, 4u);
+        m.put(5u, 6u);
+
+        uint32 keySum = 0;
+        uint32 valueSum = 0;
+        m.forEach([&keySum, &valueSum](uint32 key, uint32 value) {
+            keySum += key;
+            valueSum += value;
+        });
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(9), keySum);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(12), valueSum);
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestHashMap);
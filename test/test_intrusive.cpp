@@ -0,0 +1,224 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_intrusive.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/intrusive.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+namespace {
+
+struct Connection {
+    int                 fd {-1};
+    IntrusiveListHook   idleHook;
+    IntrusiveHashHook   registryHook;
+};
+
+using IdleQueue = IntrusiveList<Connection, &Connection::idleHook>;
+using Registry = IntrusiveHashtable<Connection, int, &Connection::fd, &Connection::registryHook, 16>;
+
+}  // namespace
+
+
+class TestIntrusive : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestIntrusive);
+        CPPUNIT_TEST(testEmptyList);
+        CPPUNIT_TEST(testListOrderAndIteration);
+        CPPUNIT_TEST(testLruMoveToBack);
+        CPPUNIT_TEST(testEraseAndSelfUnlink);
+        CPPUNIT_TEST(testListMove);
+        CPPUNIT_TEST(testHashtableInsertFindErase);
+        CPPUNIT_TEST(testHashtableChaining);
+        CPPUNIT_TEST(testObjectInListAndTableAtOnce);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmptyList() {
+        IdleQueue queue;
+
+        CPPUNIT_ASSERT(queue.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<IdleQueue::size_type>(0), queue.size());
+        CPPUNIT_ASSERT(queue.front() == nullptr);
+        CPPUNIT_ASSERT(queue.back() == nullptr);
+        CPPUNIT_ASSERT(queue.popFront() == nullptr);
+    }
+
+    void testListOrderAndIteration() {
+        Connection conns[3];
+        conns[0].fd = 10;
+        conns[1].fd = 11;
+        conns[2].fd = 12;
+
+        IdleQueue queue;
+        queue.pushBack(conns[0]);
+        queue.pushBack(conns[1]);
+        queue.pushFront(conns[2]);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<IdleQueue::size_type>(3), queue.size());
+        CPPUNIT_ASSERT_EQUAL(12, queue.front()->fd);
+        CPPUNIT_ASSERT_EQUAL(11, queue.back()->fd);
+
+        int expected[] = {12, 10, 11};
+        int i = 0;
+        for (auto& c : queue) {
+            CPPUNIT_ASSERT_EQUAL(expected[i++], c.fd);
+        }
+        CPPUNIT_ASSERT_EQUAL(3, i);
+    }
+
+    void testLruMoveToBack() {
+        Connection conns[3];
+        conns[0].fd = 1;
+        conns[1].fd = 2;
+        conns[2].fd = 3;
+
+        IdleQueue queue;
+        queue.pushBack(conns[0]);
+        queue.pushBack(conns[1]);
+        queue.pushBack(conns[2]);
+
+        // Activity on the oldest connection saves it from expiry:
+        queue.moveToBack(conns[0]);
+        CPPUNIT_ASSERT_EQUAL(2, queue.front()->fd);
+        CPPUNIT_ASSERT_EQUAL(1, queue.back()->fd);
+        CPPUNIT_ASSERT_EQUAL(static_cast<IdleQueue::size_type>(3), queue.size());
+
+        // Expiry drains from the front in recency order:
+        CPPUNIT_ASSERT_EQUAL(2, queue.popFront()->fd);
+        CPPUNIT_ASSERT_EQUAL(3, queue.popFront()->fd);
+        CPPUNIT_ASSERT_EQUAL(1, queue.popFront()->fd);
+        CPPUNIT_ASSERT(queue.empty());
+    }
+
+    void testEraseAndSelfUnlink() {
+        IdleQueue queue;
+
+        Connection a, b;
+        queue.pushBack(a);
+        queue.pushBack(b);
+
+        queue.erase(a);
+        CPPUNIT_ASSERT(!a.idleHook.isLinked());
+        CPPUNIT_ASSERT_EQUAL(static_cast<IdleQueue::size_type>(1), queue.size());
+
+        // Erasing an unlinked object is harmless:
+        queue.erase(a);
+        CPPUNIT_ASSERT_EQUAL(static_cast<IdleQueue::size_type>(1), queue.size());
+
+        // A linked object destroyed in place unlinks itself from the chain:
+        {
+            Connection ephemeral;
+            queue.pushBack(ephemeral);
+        }
+        CPPUNIT_ASSERT_EQUAL(&b, queue.front());
+        CPPUNIT_ASSERT_EQUAL(&b, queue.back());
+    }
+
+    void testListMove() {
+        Connection a, b;
+
+        IdleQueue queue;
+        queue.pushBack(a);
+        queue.pushBack(b);
+
+        IdleQueue other(std::move(queue));
+        CPPUNIT_ASSERT(queue.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<IdleQueue::size_type>(2), other.size());
+        CPPUNIT_ASSERT_EQUAL(&a, other.front());
+        CPPUNIT_ASSERT_EQUAL(&b, other.back());
+    }
+
+    void testHashtableInsertFindErase() {
+        Registry registry;
+        CPPUNIT_ASSERT(registry.empty());
+
+        Connection a, b;
+        a.fd = 5;
+        b.fd = 7;
+
+        registry.insert(a);
+        registry.insert(b);
+        CPPUNIT_ASSERT_EQUAL(static_cast<Registry::size_type>(2), registry.size());
+
+        CPPUNIT_ASSERT_EQUAL(&a, registry.find(5));
+        CPPUNIT_ASSERT_EQUAL(&b, registry.find(7));
+        CPPUNIT_ASSERT(registry.find(6) == nullptr);
+
+        CPPUNIT_ASSERT(registry.erase(a));
+        CPPUNIT_ASSERT(registry.find(5) == nullptr);
+        CPPUNIT_ASSERT(!registry.erase(a));
+        CPPUNIT_ASSERT_EQUAL(static_cast<Registry::size_type>(1), registry.size());
+    }
+
+    void testHashtableChaining() {
+        // Far more entries than buckets: every chain is exercised.
+        Registry registry;
+
+        Connection conns[64];
+        for (int i = 0; i < 64; ++i) {
+            conns[i].fd = i;
+            registry.insert(conns[i]);
+        }
+
+        for (int i = 0; i < 64; ++i) {
+            CPPUNIT_ASSERT_EQUAL(&conns[i], registry.find(i));
+        }
+
+        // Unlinking from the middle of a chain keeps the rest reachable:
+        for (int i = 0; i < 64; i += 2) {
+            CPPUNIT_ASSERT(registry.erase(conns[i]));
+        }
+        for (int i = 0; i < 64; ++i) {
+            if (i % 2 == 0) {
+                CPPUNIT_ASSERT(registry.find(i) == nullptr);
+            } else {
+                CPPUNIT_ASSERT_EQUAL(&conns[i], registry.find(i));
+            }
+        }
+
+        registry.clear();
+        CPPUNIT_ASSERT(registry.empty());
+        CPPUNIT_ASSERT(registry.find(1) == nullptr);
+    }
+
+    void testObjectInListAndTableAtOnce() {
+        IdleQueue queue;
+        Registry registry;
+
+        Connection conn;
+        conn.fd = 42;
+
+        queue.pushBack(conn);
+        registry.insert(conn);
+
+        CPPUNIT_ASSERT_EQUAL(&conn, queue.front());
+        CPPUNIT_ASSERT_EQUAL(&conn, registry.find(42));
+
+        queue.erase(conn);
+        CPPUNIT_ASSERT_EQUAL(&conn, registry.find(42));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestIntrusive);
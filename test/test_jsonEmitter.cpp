@@ -0,0 +1,205 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_jsonEmitter.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/jsonEmitter.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cmath>
+#include <string>
+
+
+using namespace Solace;
+
+
+class TestJsonEmitter : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestJsonEmitter);
+        CPPUNIT_TEST(testFlatObject);
+        CPPUNIT_TEST(testNestedScopes);
+        CPPUNIT_TEST(testEscaping);
+        CPPUNIT_TEST(testScalarValues);
+        CPPUNIT_TEST(testMultipleDocuments);
+        CPPUNIT_TEST(testStructuralMisuse);
+        CPPUNIT_TEST(testBufferOverrunLatches);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+
+    byte _storage[4096];
+
+    std::string written(WriteBuffer const& out) const {
+        const auto view = out.viewWritten();
+
+        return std::string(view.dataAs<const char>(), view.size());
+    }
+
+public:
+
+    void testFlatObject() {
+        auto storageView = wrapMemory(_storage);
+        WriteBuffer out(storageView);
+        JsonEmitter json(out);
+
+        {
+            auto doc = json.object();
+            json.field("name", "edge-42")
+                .field("rss", uint64(1724416))
+                .field("healthy", true)
+                .nullField("parent");
+        }
+
+        CPPUNIT_ASSERT(json.finish().isOk());
+        CPPUNIT_ASSERT_EQUAL(
+                std::string("{\"name\":\"edge-42\",\"rss\":1724416,\"healthy\":true,\"parent\":null}"),
+                written(out));
+    }
+
+    void testNestedScopes() {
+        auto storageView = wrapMemory(_storage);
+        WriteBuffer out(storageView);
+        JsonEmitter json(out);
+
+        {
+            auto doc = json.object();
+            json.field("node", "a1");
+            {
+                auto samples = json.array("samples");
+                json.value(1).value(2).value(3);
+            }
+            {
+                auto meta = json.object("meta");
+                json.field("zone", "eu-1");
+            }
+        }
+
+        CPPUNIT_ASSERT(json.finish().isOk());
+        CPPUNIT_ASSERT_EQUAL(
+                std::string("{\"node\":\"a1\",\"samples\":[1,2,3],\"meta\":{\"zone\":\"eu-1\"}}"),
+                written(out));
+    }
+
+    void testEscaping() {
+        auto storageView = wrapMemory(_storage);
+        WriteBuffer out(storageView);
+        JsonEmitter json(out);
+
+        // Long enough to exercise the bulk scan, with escapables scattered
+        // inside and at block boundaries:
+        json.value("plain text that needs no escaping at all, long past one block"
+                   "\" quote \\ slash \n newline \t tab \x01 control"
+                   " and a clean utf-8 tail: \xC3\xA9\xC3\xA0");
+
+        CPPUNIT_ASSERT(json.finish().isOk());
+        CPPUNIT_ASSERT_EQUAL(
+                std::string("\"plain text that needs no escaping at all, long past one block"
+                            "\\\" quote \\\\ slash \\n newline \\t tab \\u0001 control"
+                            " and a clean utf-8 tail: \xC3\xA9\xC3\xA0\""),
+                written(out));
+    }
+
+    void testScalarValues() {
+        auto storageView = wrapMemory(_storage);
+        WriteBuffer out(storageView);
+        JsonEmitter json(out);
+
+        {
+            auto doc = json.array();
+            json.value(int64(-9007199254740993))
+                .value(uint64(18446744073709551615ULL))
+                .value(0)
+                .value(3.5)
+                .value(false)
+                .nullValue()
+                .value(float64(NAN));   // Non-finite floats degrade to null
+        }
+
+        CPPUNIT_ASSERT(json.finish().isOk());
+        CPPUNIT_ASSERT_EQUAL(
+                std::string("[-9007199254740993,18446744073709551615,0,3.5,false,null,null]"),
+                written(out));
+    }
+
+    void testMultipleDocuments() {
+        auto storageView = wrapMemory(_storage);
+        WriteBuffer out(storageView);
+        JsonEmitter json(out);
+
+        {
+            auto doc = json.object();
+            json.field("seq", 1);
+        }
+        {
+            auto doc = json.object();
+            json.field("seq", 2);
+        }
+
+        CPPUNIT_ASSERT(json.finish().isOk());
+        CPPUNIT_ASSERT_EQUAL(std::string("{\"seq\":1}\n{\"seq\":2}"), written(out));
+    }
+
+    void testStructuralMisuse() {
+        {   // A value inside an object without a key:
+            auto storageView = wrapMemory(_storage);
+            WriteBuffer out(storageView);
+            JsonEmitter json(out);
+
+            json.beginObject();
+            json.value(42);
+            json.endObject();
+            CPPUNIT_ASSERT(json.finish().isError());
+        }
+
+        {   // Closing an array as an object:
+            auto storageView = wrapMemory(_storage);
+            WriteBuffer out(storageView);
+            JsonEmitter json(out);
+
+            json.beginArray();
+            json.endObject();
+            CPPUNIT_ASSERT(json.finish().isError());
+        }
+
+        {   // A scope left open:
+            auto storageView = wrapMemory(_storage);
+            WriteBuffer out(storageView);
+            JsonEmitter json(out);
+
+            json.beginObject();
+            CPPUNIT_ASSERT(json.finish().isError());
+        }
+    }
+
+    void testBufferOverrunLatches() {
+        byte tiny[8];
+        auto tinyView = wrapMemory(tiny);
+        WriteBuffer out(tinyView);
+        JsonEmitter json(out);
+
+        {
+            auto doc = json.object();
+            json.field("much too long for eight bytes", "value");
+        }
+
+        CPPUNIT_ASSERT(json.finish().isError());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestJsonEmitter);
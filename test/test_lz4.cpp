@@ -0,0 +1,175 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_lz4.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/lz4.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+
+using namespace Solace;
+
+
+class TestLz4 : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestLz4);
+        CPPUNIT_TEST(testCompressibleRoundtrip);
+        CPPUNIT_TEST(testIncompressibleStoredRoundtrip);
+        CPPUNIT_TEST(testTinyInputs);
+        CPPUNIT_TEST(testDictionaryMode);
+        CPPUNIT_TEST(testChunkedStream);
+        CPPUNIT_TEST(testMalformedInputRejected);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+
+    std::vector<byte> compress(ImmutableMemoryView input, ImmutableMemoryView dict) {
+        std::vector<byte> packed(Lz4Encoder::maxEncodedSize(static_cast<uint32>(input.size())));
+        auto packedView = wrapMemory(packed.data(), packed.size());
+        WriteBuffer dest(packedView);
+
+        Lz4Encoder encoder(dest, dict);
+        CPPUNIT_ASSERT(encoder.encode(input).isOk());
+
+        packed.resize(dest.position());
+        return packed;
+    }
+
+    std::vector<byte> decompress(ImmutableMemoryView packed, ImmutableMemoryView dict, size_t rawSize) {
+        std::vector<byte> out(rawSize + 1);
+        auto outView = wrapMemory(out.data(), out.size());
+        WriteBuffer dest(outView);
+
+        Lz4Decoder decoder(dest, dict);
+        CPPUNIT_ASSERT_EQUAL(static_cast<Lz4Decoder::size_type>(rawSize), decoder.encodedSize(packed));
+        CPPUNIT_ASSERT(decoder.encode(packed).isOk());
+        CPPUNIT_ASSERT_EQUAL(rawSize, static_cast<size_t>(dest.position()));
+
+        out.resize(rawSize);
+        return out;
+    }
+
+    void assertRoundtrip(ImmutableMemoryView input, ImmutableMemoryView dict) {
+        const auto packed = compress(input, dict);
+        const auto out = decompress(wrapMemory(packed.data(), packed.size()), dict, input.size());
+
+        CPPUNIT_ASSERT(memcmp(out.data(), input.dataAddress(), input.size()) == 0);
+    }
+
+public:
+
+    void testCompressibleRoundtrip() {
+        std::string msg;
+        for (int i = 0; i < 200; ++i) {
+            msg += "metric{host=\"node-7\",cpu=93} 1234567 ";
+        }
+
+        auto input = wrapMemory(reinterpret_cast<byte*>(&msg[0]), msg.size());
+        const auto packed = compress(input, ImmutableMemoryView());
+
+        // Repetitive telemetry must shrink dramatically:
+        CPPUNIT_ASSERT(packed.size() < msg.size() / 4);
+
+        assertRoundtrip(input, ImmutableMemoryView());
+    }
+
+    void testIncompressibleStoredRoundtrip() {
+        std::mt19937_64 rng(2016);
+        std::vector<byte> data(10000);
+        for (auto& b : data) {
+            b = static_cast<byte>(rng());
+        }
+
+        auto input = wrapMemory(data.data(), data.size());
+        const auto packed = compress(input, ImmutableMemoryView());
+
+        // Random bytes are stored verbatim plus the frame header:
+        CPPUNIT_ASSERT_EQUAL(data.size() + 8, packed.size());
+
+        assertRoundtrip(input, ImmutableMemoryView());
+    }
+
+    void testTinyInputs() {
+        for (size_t n : {size_t(0), size_t(1), size_t(5), size_t(13)}) {
+            std::vector<byte> data(n, 0x41);
+
+            assertRoundtrip(wrapMemory(data.data(), n), ImmutableMemoryView());
+        }
+    }
+
+    void testDictionaryMode() {
+        std::string dict = "{\"service\":\"ingest\",\"level\":\"info\",\"message\":\"connection accepted\"}";
+        std::string small = "{\"service\":\"ingest\",\"level\":\"info\",\"message\":\"connection accepted\",\"port\":8080}";
+
+        auto dictView = wrapMemory(reinterpret_cast<byte*>(&dict[0]), dict.size());
+        auto input = wrapMemory(reinterpret_cast<byte*>(&small[0]), small.size());
+
+        const auto plain = compress(input, ImmutableMemoryView());
+        const auto primed = compress(input, dictView);
+
+        // The boilerplate is in the dictionary, so the primed frame carries
+        // only the novelty:
+        CPPUNIT_ASSERT(primed.size() < plain.size());
+
+        assertRoundtrip(input, dictView);
+    }
+
+    void testChunkedStream() {
+        std::string c1(1000, 'a');
+        std::string c2 = "and now for something completely different";
+        std::string c3(500, 'z');
+
+        std::vector<byte> packed(1 << 14);
+        auto packedView = wrapMemory(packed.data(), packed.size());
+        WriteBuffer dest(packedView);
+
+        Lz4Encoder encoder(dest);
+        CPPUNIT_ASSERT(encoder.encode(wrapMemory(reinterpret_cast<byte*>(&c1[0]), c1.size())).isOk());
+        CPPUNIT_ASSERT(encoder.encode(wrapMemory(reinterpret_cast<byte*>(&c2[0]), c2.size())).isOk());
+        CPPUNIT_ASSERT(encoder.encode(wrapMemory(reinterpret_cast<byte*>(&c3[0]), c3.size())).isOk());
+
+        const std::string joined = c1 + c2 + c3;
+        const auto out = decompress(wrapMemory(packed.data(), dest.position()),
+                                    ImmutableMemoryView(), joined.size());
+
+        CPPUNIT_ASSERT(memcmp(out.data(), joined.data(), joined.size()) == 0);
+    }
+
+    void testMalformedInputRejected() {
+        std::vector<byte> out(1024);
+        auto outView = wrapMemory(out.data(), out.size());
+        WriteBuffer dest(outView);
+        Lz4Decoder decoder(dest);
+
+        // Truncated header:
+        byte junk[3] = {1, 2, 3};
+        CPPUNIT_ASSERT(decoder.encode(wrapMemory(junk, sizeof(junk))).isError());
+
+        // Header promising more payload than the view holds:
+        byte frame[12] = {16, 0, 0, 0, 100, 0, 0, 0, 1, 2, 3, 4};
+        CPPUNIT_ASSERT(decoder.encode(wrapMemory(frame, sizeof(frame))).isError());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestLz4);
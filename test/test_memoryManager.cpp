@@ -27,6 +27,8 @@
 
 
 #include <unistd.h>
+#include <thread>
+#include <vector>
 
 
 using namespace Solace;
@@ -40,7 +42,18 @@ class TestMemoryManager: public CppUnit::TestFixture  {
         CPPUNIT_TEST(testNativePageCount);
         CPPUNIT_TEST(testAllocation);
         CPPUNIT_TEST(testAllocationBeyondCapacity);
+        CPPUNIT_TEST(testAlignedAllocation);
         CPPUNIT_TEST(testAllocationLocking);
+        CPPUNIT_TEST(testArenaAllocation);
+        CPPUNIT_TEST(testPoolAllocation);
+        CPPUNIT_TEST(testPoolAllocator);
+        CPPUNIT_TEST(testPoolCache);
+        CPPUNIT_TEST(testPagedPoolShrink);
+        CPPUNIT_TEST(testHugePageAllocation);
+        CPPUNIT_TEST(testPrefaultAndPinning);
+        CPPUNIT_TEST(testResize);
+        CPPUNIT_TEST(testAccounting);
+        CPPUNIT_TEST(testAccountingAcrossThreads);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -99,6 +112,30 @@ public:
         CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0), test.size());
     }
 
+    void testAlignedAllocation() {
+        MemoryManager test(64 * 1024);
+
+        {
+            auto memBlock = test.createAligned(5000);   // Default 4KB alignment
+            CPPUNIT_ASSERT_EQUAL(static_cast<uintptr_t>(0),
+                                 reinterpret_cast<uintptr_t>(memBlock.view().dataAddress()) % 4096);
+
+            // The segment is rounded up to a whole multiple of the alignment:
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(8192), memBlock.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(8192), test.size());
+
+            auto smallBlock = test.createAligned(512, 512);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uintptr_t>(0),
+                                 reinterpret_cast<uintptr_t>(smallBlock.view().dataAddress()) % 512);
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(512), smallBlock.size());
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0), test.size());
+
+        // Alignment must be a power of two:
+        CPPUNIT_ASSERT_THROW(auto memBlock = test.createAligned(4096, 3000), IllegalArgumentException);
+    }
+
     void testAllocationBeyondCapacity() {
         MemoryManager test(128);
         CPPUNIT_ASSERT_THROW(auto memBlock = test.create(2048), OverflowException);
@@ -142,6 +179,355 @@ public:
 
         CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0), test.size());
     }
+
+    void testArenaAllocation() {
+        MemoryManager manager(4096);
+
+        {
+            auto arena = manager.createArena(1024);
+
+            // The whole region is accounted against the manager up front:
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryManager::size_type>(1024), manager.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryArena::size_type>(1024), arena.capacity());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryArena::size_type>(0), arena.size());
+
+            {
+                auto bufferA = arena.create(128);
+                auto bufferB = arena.create(16);
+
+                CPPUNIT_ASSERT_EQUAL(static_cast<MemoryBuffer::size_type>(128), bufferA.size());
+                CPPUNIT_ASSERT(bufferA.view().dataAddress() != bufferB.view().dataAddress());
+            }
+
+            // Disposing individual arena buffers is a no-op:
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryManager::size_type>(1024), manager.size());
+
+            arena.reset();
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryArena::size_type>(0), arena.size());
+
+            // A reset arena has its full region to hand out again:
+            auto bufferC = arena.create(1024);
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryBuffer::size_type>(1024), bufferC.size());
+            CPPUNIT_ASSERT_THROW(arena.create(1), OverflowException);
+        }
+
+        // Destroying the arena returns its region to the manager wholesale:
+        CPPUNIT_ASSERT(manager.empty());
+    }
+
+
+    void testPoolAllocation() {
+        MemoryManager manager(4096);
+
+        {
+            auto pool = manager.createPool(48, 16);
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryPool::size_type>(48), pool.blockSize());
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(16), pool.capacity());
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), pool.size());
+
+            {
+                auto bufferA = pool.create();
+                auto bufferB = pool.create();
+
+                CPPUNIT_ASSERT_EQUAL(static_cast<MemoryBuffer::size_type>(48), bufferA.size());
+                CPPUNIT_ASSERT(bufferA.view().dataAddress() != bufferB.view().dataAddress());
+                CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(2), pool.size());
+            }
+
+            // Disposing of a pool buffer returns its block for reuse:
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), pool.size());
+
+            std::vector<MemoryBuffer> all;
+            for (uint32 i = 0; i < pool.capacity(); ++i) {
+                all.push_back(pool.create());
+            }
+
+            CPPUNIT_ASSERT_THROW(pool.create(), OverflowException);
+        }
+
+        // Destroying the pool returns its region to the manager wholesale:
+        CPPUNIT_ASSERT(manager.empty());
+    }
+
+
+    void testPoolAllocator() {
+        MemoryManager manager(4096);
+        auto pool = manager.createPool(64, 8);
+
+        // Raw block acquisition pairs with releaseBlock():
+        auto* block = pool.acquireBlock();
+        CPPUNIT_ASSERT(block != nullptr);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), pool.size());
+        pool.releaseBlock(block);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), pool.size());
+
+        // allocate_shared places object and control block in one pool block:
+        {
+            auto sp = std::allocate_shared<int64>(PoolAllocator<int64>(pool), 42);
+            CPPUNIT_ASSERT_EQUAL(static_cast<int64>(42), *sp);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), pool.size());
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), pool.size());
+
+        // An allocation bigger than a block is refused up front:
+        PoolAllocator<byte> bytes(pool);
+        CPPUNIT_ASSERT_THROW(bytes.allocate(65), IndexOutOfRangeException);
+    }
+
+
+    void testPoolCache() {
+        MemoryManager manager(8192);
+        auto pool = manager.createPool(32, 64);
+
+        {
+            MemoryPoolCache cache(pool, 16);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), cache.cached());
+
+            {
+                auto buffer = cache.create();
+                CPPUNIT_ASSERT_EQUAL(static_cast<MemoryBuffer::size_type>(32), buffer.size());
+
+                // The first allocation pulls half a magazine from the pool in one burst:
+                CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(7), cache.cached());
+                CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(8), pool.size());
+            }
+
+            // Disposing a cached buffer lands in the magazine, not the shared freelist:
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(8), cache.cached());
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(8), pool.size());
+        }
+
+        // Destroying the cache flushes its magazine back to the pool:
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), pool.size());
+    }
+
+
+    void testPagedPoolShrink() {
+        MemoryManager manager(32 * 1024 * 1024);
+        auto pool = manager.createPagedPool(100, 8);
+
+        // Blocks are rounded up to whole pages so none of them share one:
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryPool::size_type>(0),
+                             pool.blockSize() % manager.getPageSize());
+
+        {
+            std::vector<MemoryBuffer> all;
+            for (uint32 i = 0; i < pool.capacity(); ++i) {
+                all.push_back(pool.create());
+                all.back().view().fill(0xAB);
+            }
+
+            // Keep the even blocks, free the odd ones - checkerboard fragmentation:
+            std::vector<MemoryBuffer> held;
+            for (size_t i = 0; i < all.size(); i += 2) {
+                held.push_back(std::move(all[i]));
+            }
+            all.clear();
+
+            const auto stats = pool.fragmentation();
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(4), stats.freeBlocks);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(4), stats.freeSpans);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), stats.largestFreeSpan);
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryPool::size_type>(4 * pool.blockSize()),
+                                 stats.reclaimableBytes);
+
+            CPPUNIT_ASSERT_EQUAL(stats.reclaimableBytes, pool.shrink());
+
+            // Live blocks are not touched by the shrink:
+            for (auto& buffer : held) {
+                const auto view = buffer.view();
+                for (MemoryView::size_type i = 0; i < view.size(); ++i) {
+                    CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0xAB), view.dataAddress()[i]);
+                }
+            }
+
+            // The re-threaded freelist refills front-to-back:
+            auto bufferA = pool.create();
+            auto bufferB = pool.create();
+            CPPUNIT_ASSERT(bufferA.view().dataAddress() < bufferB.view().dataAddress());
+        }
+
+        // Fully quiescent: one span covering the whole pool, releasable in full:
+        const auto finalStats = pool.fragmentation();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(8), finalStats.freeBlocks);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), finalStats.freeSpans);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(8), finalStats.largestFreeSpan);
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryPool::size_type>(8 * pool.blockSize()), pool.shrink());
+
+        // ... and the pool remains fully usable afterwards:
+        auto buffer = pool.create();
+        buffer.view().fill(0x11);
+    }
+
+
+    void testHugePageAllocation() {
+#ifdef SOLACE_PLATFORM_LINUX
+        MemoryManager::Options options;
+        options.useHugePages = true;
+
+        MemoryManager manager(16 * 1024 * 1024, options);
+
+        {
+            // Allocations round up to whole 2MB pages:
+            auto buffer = manager.create(3 * 1024 * 1024);
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryBuffer::size_type>(4 * 1024 * 1024), buffer.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryManager::size_type>(4 * 1024 * 1024), manager.size());
+
+            // The mapping is actually usable end to end:
+            buffer.view().dataAddress()[0] = 42;
+            buffer.view().dataAddress()[buffer.size() - 1] = 42;
+        }
+
+        CPPUNIT_ASSERT(manager.empty());
+#endif
+    }
+
+
+    void testPrefaultAndPinning() {
+        MemoryManager::Options options;
+        options.prefault = true;
+        options.lockMemory = true;
+
+        MemoryManager manager(8 * 1024 * 1024, options);
+
+        {   // Prefaulted buffers behave like any other; the touch pass must
+            // not leak outside the allocation or corrupt its content:
+            auto buffer = manager.create(3 * 4096 + 17);
+            buffer.view().fill(42);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(42), buffer.view()[0]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(42), buffer.view()[buffer.size() - 1]);
+        }
+
+        {   // The aligned path prefaults too:
+            auto aligned = manager.createAligned(64 * 1024, 4096);
+            aligned.view().fill(3);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(3), aligned.view()[aligned.size() - 1]);
+        }
+
+        // Pinning is best effort, so disposal must balance the books even
+        // when mlock was refused by RLIMIT_MEMLOCK:
+        CPPUNIT_ASSERT(manager.empty());
+    }
+
+
+    void testResize() {
+        MemoryManager manager(4096);
+
+        {   // Heap buffers grow by reallocation, preserving content:
+            auto buffer = manager.create(64);
+            buffer.view().dataAddress()[63] = 42;
+
+            manager.resize(buffer, 256);
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryBuffer::size_type>(256), buffer.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(42), buffer.view().dataAddress()[63]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryManager::size_type>(256), manager.size());
+        }
+
+        CPPUNIT_ASSERT(manager.empty());
+
+        {   // The arena's most recent allocation grows in place, bytes unmoved:
+            auto arena = manager.createArena(1024);
+            auto buffer = arena.create(64);
+            auto* const address = buffer.view().dataAddress();
+
+            arena.resize(buffer, 256);
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryBuffer::size_type>(256), buffer.size());
+            CPPUNIT_ASSERT(address == buffer.view().dataAddress());
+
+            // An older allocation falls back to allocate-and-copy:
+            auto other = arena.create(16);
+            buffer.view().dataAddress()[0] = 42;
+            arena.resize(buffer, 300);
+            CPPUNIT_ASSERT(address != buffer.view().dataAddress());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(42), buffer.view().dataAddress()[0]);
+
+            CPPUNIT_ASSERT_THROW(arena.resize(other, 4096), OverflowException);
+        }
+    }
+
+
+    void testAccounting() {
+        MemoryManager::Options options;
+        options.trackAllocations = true;
+
+        MemoryManager manager(1024 * 1024, options);
+
+        static const auto parserTag = MemoryManager::registerTag("test.parser");
+        static const auto codecTag = MemoryManager::registerTag("test.codec");
+        CPPUNIT_ASSERT(parserTag != codecTag);
+
+        // Registering the same name again yields the same id:
+        CPPUNIT_ASSERT_EQUAL(parserTag, MemoryManager::registerTag("test.parser"));
+
+        const auto before = manager.accounting();
+        {
+            auto bufferA = manager.create(1000, parserTag);
+            auto bufferB = manager.create(500, parserTag);
+            auto bufferC = manager.create(200, codecTag);
+
+            const auto snapshot = manager.accounting();
+            CPPUNIT_ASSERT_EQUAL(before.tags[parserTag].outstandingBlocks + 2,
+                                 snapshot.tags[parserTag].outstandingBlocks);
+            CPPUNIT_ASSERT(snapshot.tags[parserTag].outstandingBytes
+                           >= before.tags[parserTag].outstandingBytes + 1500);
+            CPPUNIT_ASSERT_EQUAL(before.tags[codecTag].outstandingBlocks + 1,
+                                 snapshot.tags[codecTag].outstandingBlocks);
+            CPPUNIT_ASSERT_EQUAL(manager.size(), snapshot.currentSize);
+            CPPUNIT_ASSERT(snapshot.peakSize >= snapshot.currentSize);
+        }
+
+        // Disposal drives the ledger back down; lifetime totals stay:
+        const auto after = manager.accounting();
+        CPPUNIT_ASSERT_EQUAL(before.tags[parserTag].outstandingBytes, after.tags[parserTag].outstandingBytes);
+        CPPUNIT_ASSERT_EQUAL(before.tags[parserTag].outstandingBlocks, after.tags[parserTag].outstandingBlocks);
+        CPPUNIT_ASSERT_EQUAL(before.tags[codecTag].outstandingBytes, after.tags[codecTag].outstandingBytes);
+        CPPUNIT_ASSERT_EQUAL(before.tags[parserTag].totalAllocations + 2, after.tags[parserTag].totalAllocations);
+        CPPUNIT_ASSERT_EQUAL(before.totalAllocations + 3, after.totalAllocations);
+        CPPUNIT_ASSERT(manager.empty());
+        CPPUNIT_ASSERT(after.peakSize >= 1700);
+
+        // A 1000 byte allocation lands in bucket 10 (512 < size <= 1024):
+        CPPUNIT_ASSERT(after.sizeHistogram[10] >= before.sizeHistogram[10] + 1);
+    }
+
+
+    void testAccountingAcrossThreads() {
+        MemoryManager::Options options;
+        options.trackAllocations = true;
+
+        MemoryManager manager(1024 * 1024, options);
+        static const auto tag = MemoryManager::registerTag("test.threaded");
+
+        const auto before = manager.accounting();
+
+        // Allocate on this thread, dispose on another - the ledger must balance:
+        {
+            auto buffer = manager.create(4096, tag);
+            std::thread worker([captured = std::move(buffer)]() mutable {
+            });
+            worker.join();
+        }
+
+        // Alloc/free churn from several threads at once:
+        std::vector<std::thread> workers;
+        for (int t = 0; t < 4; ++t) {
+            workers.emplace_back([&manager]() {
+                for (int i = 0; i < 1000; ++i) {
+                    auto buffer = manager.create(128, tag);
+                }
+            });
+        }
+        for (auto& worker : workers) {
+            worker.join();
+        }
+
+        const auto after = manager.accounting();
+        CPPUNIT_ASSERT_EQUAL(before.tags[tag].outstandingBytes, after.tags[tag].outstandingBytes);
+        CPPUNIT_ASSERT_EQUAL(before.tags[tag].outstandingBlocks, after.tags[tag].outstandingBlocks);
+        CPPUNIT_ASSERT_EQUAL(before.tags[tag].totalAllocations + 1 + 4 * 1000, after.tags[tag].totalAllocations);
+        CPPUNIT_ASSERT(manager.empty());
+    }
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestMemoryManager);
@@ -33,6 +33,7 @@ class TestMemoryView: public CppUnit::TestFixture  {
     CPPUNIT_TEST_SUITE(TestMemoryView);
         CPPUNIT_TEST(testConstruction);
         CPPUNIT_TEST(testFill);
+        CPPUNIT_TEST(testFindFirstOf);
         CPPUNIT_TEST(testRead);
         CPPUNIT_TEST(testWrite);
         CPPUNIT_TEST(testWrapping);
@@ -41,6 +42,8 @@ class TestMemoryView: public CppUnit::TestFixture  {
         CPPUNIT_TEST(testSlice);
         CPPUNIT_TEST(testZeroSizedSlice);
         CPPUNIT_TEST(testPlacementConstruct);
+        CPPUNIT_TEST(testAlignment);
+        CPPUNIT_TEST(testAlignedSliceFor);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -165,6 +168,20 @@ public:
         }
     }
 
+
+    void testFindFirstOf() {
+        byte bytes[64] = {0};
+        bytes[10] = 0x7E;
+        bytes[40] = 0x7E;
+
+        const auto buffer = wrapMemory(bytes, sizeof(bytes));
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(10), buffer.findFirstOf(0x7E).get());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(40), buffer.findFirstOf(0x7E, 11).get());
+        CPPUNIT_ASSERT(buffer.findFirstOf(0x7E, 41).isNone());
+        CPPUNIT_ASSERT(buffer.findFirstOf(0x99).isNone());
+        CPPUNIT_ASSERT(ImmutableMemoryView().findFirstOf(0x7E).isNone());
+    }
+
     void testRead() {
         byte b1[128], b2[24];
         MemoryView buffer = wrapMemory(b1);
@@ -402,6 +419,59 @@ public:
         }
     }
 
+
+    void testAlignment() {
+        alignas(64) byte storage[128] = {};
+
+        CPPUNIT_ASSERT(wrapMemory(storage).alignment() >= 64);
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(1),
+                             wrapMemory(storage + 1, 16).alignment());
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(2),
+                             wrapMemory(storage + 2, 16).alignment());
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0),
+                             ImmutableMemoryView().alignment());
+    }
+
+
+    void testAlignedSliceFor() {
+        alignas(64) byte storage[128] = {};
+
+        {   // A misaligned view decomposes into scalar head, aligned body, scalar tail
+            auto view = wrapMemory(storage + 3, 64 + 10);
+            auto split = view.alignedSliceFor<uint64>();
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(5), split.head.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(64), split.body.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(5), split.tail.size());
+            CPPUNIT_ASSERT(split.body.alignment() >= alignof(uint64));
+
+            // The slices are adjacent and cover the view exactly:
+            CPPUNIT_ASSERT(split.head.dataAddress() == view.dataAddress());
+            CPPUNIT_ASSERT(split.body.dataAddress() == split.head.dataAddress() + split.head.size());
+            CPPUNIT_ASSERT(split.tail.dataAddress() == split.body.dataAddress() + split.body.size());
+
+            // The mutable decomposition hands out writable slices:
+            split.body.fill(0xAB);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0xAB), storage[8]);
+        }
+
+        {   // An aligned view is all body
+            auto split = wrapMemory(storage, 64).alignedSliceFor<uint32>();
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0), split.head.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(64), split.body.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0), split.tail.size());
+        }
+
+        {   // A view too small to reach alignment is all head
+            auto const tiny = wrapMemory(storage + 1, 3).viewImmutableShallow();
+            auto split = tiny.alignedSliceFor<uint64>();
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(3), split.head.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0), split.body.size());
+            CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0), split.tail.size());
+        }
+    }
+
 };
 
 
@@ -0,0 +1,196 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_mpmcQueue.cpp
+ * @author: soultaker
+ *******************************************************************************/
+#include <solace/mpmcQueue.hpp>  // Class being tested
+
+#include <solace/memoryManager.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+using namespace Solace;
+
+
+class TestMpmcQueue: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestMpmcQueue);
+        CPPUNIT_TEST(testConstruction);
+        CPPUNIT_TEST(testFifoOrder);
+        CPPUNIT_TEST(testMoveOnlyPayload);
+        CPPUNIT_TEST(testConcurrentProducersConsumers);
+        CPPUNIT_TEST(testSpscFifoOrder);
+        CPPUNIT_TEST(testSpscStreaming);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testConstruction() {
+        CPPUNIT_ASSERT_THROW(MpmcQueue<int>(6), IllegalArgumentException);
+        CPPUNIT_ASSERT_THROW(MpmcQueue<int>(0), IllegalArgumentException);
+        CPPUNIT_ASSERT_THROW(SpscQueue<int>(100), IllegalArgumentException);
+
+        MpmcQueue<int> q(16);
+        CPPUNIT_ASSERT_EQUAL(static_cast<MpmcQueue<int>::size_type>(16), q.capacity());
+        CPPUNIT_ASSERT(q.empty());
+    }
+
+    void testFifoOrder() {
+        MpmcQueue<int> q(8);
+
+        int out = 0;
+        CPPUNIT_ASSERT(!q.tryDequeue(out));
+
+        for (int i = 0; i < 8; ++i) {
+            CPPUNIT_ASSERT(q.tryEnqueue(i));
+        }
+        CPPUNIT_ASSERT(!q.tryEnqueue(99));
+        CPPUNIT_ASSERT_EQUAL(static_cast<MpmcQueue<int>::size_type>(8), q.size());
+
+        for (int i = 0; i < 8; ++i) {
+            CPPUNIT_ASSERT(q.tryDequeue(out));
+            CPPUNIT_ASSERT_EQUAL(i, out);
+        }
+        CPPUNIT_ASSERT(!q.tryDequeue(out));
+        CPPUNIT_ASSERT(q.empty());
+    }
+
+    void testMoveOnlyPayload() {
+        MemoryManager manager(4096);
+        MpmcQueue<MemoryBuffer> q(4);
+
+        CPPUNIT_ASSERT(q.tryEnqueue(manager.create(64)));
+        CPPUNIT_ASSERT(q.tryEnqueue(manager.create(128)));
+
+        MemoryBuffer buffer;
+        CPPUNIT_ASSERT(q.tryDequeue(buffer));
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(64), buffer.size());
+
+        // Elements still queued at destruction are disposed of properly
+    }
+
+    void testConcurrentProducersConsumers() {
+        MpmcQueue<uint64> q(256);
+
+        const int nbProducers = 3;
+        const int nbConsumers = 3;
+        const int perProducer = 20000;
+
+        std::atomic<uint64> consumedSum{0};
+        std::atomic<int> consumedCount{0};
+        std::atomic<bool> producersDone{false};
+
+        std::vector<std::thread> workers;
+        for (int p = 0; p < nbProducers; ++p) {
+            workers.emplace_back([&q, p]() {
+                for (int i = 0; i < perProducer; ++i) {
+                    const auto value = static_cast<uint64>(p) * perProducer + i + 1;
+                    while (!q.tryEnqueue(value)) {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (int c = 0; c < nbConsumers; ++c) {
+            workers.emplace_back([&]() {
+                uint64 value;
+                for (;;) {
+                    if (q.tryDequeue(value)) {
+                        consumedSum += value;
+                        consumedCount += 1;
+                    } else if (producersDone.load()) {
+                        if (!q.tryDequeue(value)) {
+                            return;
+                        }
+                        consumedSum += value;
+                        consumedCount += 1;
+                    } else {
+                        std::this_thread::yield();
+                    }
+                }
+            });
+        }
+
+        for (int p = 0; p < nbProducers; ++p) {
+            workers[p].join();
+        }
+        producersDone.store(true);
+        for (int c = 0; c < nbConsumers; ++c) {
+            workers[nbProducers + c].join();
+        }
+
+        const uint64 total = static_cast<uint64>(nbProducers) * perProducer;
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(total), consumedCount.load());
+        CPPUNIT_ASSERT_EQUAL(total * (total + 1) / 2, consumedSum.load());
+    }
+
+    void testSpscFifoOrder() {
+        SpscQueue<int> q(4);
+
+        int out = 0;
+        CPPUNIT_ASSERT(!q.tryDequeue(out));
+
+        CPPUNIT_ASSERT(q.tryEnqueue(1));
+        CPPUNIT_ASSERT(q.tryEnqueue(2));
+        CPPUNIT_ASSERT(q.tryEnqueue(3));
+        CPPUNIT_ASSERT(q.tryEnqueue(4));
+        CPPUNIT_ASSERT(!q.tryEnqueue(5));
+
+        CPPUNIT_ASSERT(q.tryDequeue(out));
+        CPPUNIT_ASSERT_EQUAL(1, out);
+        CPPUNIT_ASSERT(q.tryEnqueue(5));
+
+        for (int expected = 2; expected <= 5; ++expected) {
+            CPPUNIT_ASSERT(q.tryDequeue(out));
+            CPPUNIT_ASSERT_EQUAL(expected, out);
+        }
+        CPPUNIT_ASSERT(q.empty());
+    }
+
+    void testSpscStreaming() {
+        SpscQueue<int> q(64);
+        const int total = 100000;
+
+        std::thread producer([&q]() {
+            for (int i = 0; i < total; ++i) {
+                while (!q.tryEnqueue(i)) {
+                    std::this_thread::yield();
+                }
+            }
+        });
+
+        int expected = 0;
+        while (expected < total) {
+            int value;
+            if (q.tryDequeue(value)) {
+                CPPUNIT_ASSERT_EQUAL(expected, value);
+                expected += 1;
+            }
+        }
+
+        producer.join();
+        CPPUNIT_ASSERT(q.empty());
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestMpmcQueue);
@@ -47,6 +47,7 @@ class TestOptional : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testEquals);
 
         CPPUNIT_TEST(testEmpty);
+        CPPUNIT_TEST(testCompactViewSpecialization);
         CPPUNIT_TEST(testString);
         CPPUNIT_TEST(testGetRaises);
         CPPUNIT_TEST(testOrElse);
@@ -56,6 +57,7 @@ class TestOptional : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testMoveOnlyResult);
         CPPUNIT_TEST(testMoveOnlyMapper);
         CPPUNIT_TEST(testMoveOnlyMove);
+        CPPUNIT_TEST(testRvalueGetMovesOut);
 
     CPPUNIT_TEST_SUITE_END();
 
@@ -290,6 +292,33 @@ public:
     }
 
 
+    void testCompactViewSpecialization() {
+        // View and pointer payloads borrow their null state for 'none',
+        // so the optional is exactly the size of its payload:
+        static_assert(sizeof(Optional<StringView>) == sizeof(StringView),
+                      "Optional<StringView> must not carry a separate flag");
+        static_assert(sizeof(Optional<int*>) == sizeof(int*),
+                      "Optional<T*> must not carry a separate flag");
+
+        Optional<StringView> empty;
+        CPPUNIT_ASSERT(empty.isNone());
+        CPPUNIT_ASSERT_THROW(empty.get(), Exception);
+
+        Optional<StringView> v(StringView("hello"));
+        CPPUNIT_ASSERT(v.isSome());
+        CPPUNIT_ASSERT(v.get().equals("hello"));
+        CPPUNIT_ASSERT(v.map([](StringView s) { return s.size(); }).get() == 3);
+
+        v = none;
+        CPPUNIT_ASSERT(v.isNone());
+        CPPUNIT_ASSERT(v.orElse(StringView("fallback")).equals("fallback"));
+
+        int x = 5;
+        Optional<int*> p(&x);
+        CPPUNIT_ASSERT(p.isSome());
+        CPPUNIT_ASSERT_EQUAL(5, *p.get());
+    }
+
     void testEmpty() {
         auto v1 = Optional<int>{};
 
@@ -470,6 +499,17 @@ public:
         CPPUNIT_ASSERT_EQUAL(732, r.get().x_);
         CPPUNIT_ASSERT_EQUAL(732, r.orElse(MoveOnlyType(-9876)).x_);
     }
+
+    void testRvalueGetMovesOut() {
+        // get() on a temporary moves a move-only payload out:
+        auto p = []() { return Optional<MoveOnlyType>(in_place, 42); } ().get();
+        CPPUNIT_ASSERT_EQUAL(42, p.x_);
+
+        // The lvalue overloads still observe in place:
+        auto r = Optional<MoveOnlyType>(in_place, 7);
+        CPPUNIT_ASSERT_EQUAL(7, r.get().x_);
+        CPPUNIT_ASSERT_EQUAL(7, r.get().x_);
+    }
 };
 
 
@@ -0,0 +1,85 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_panic.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/panic.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+class TestPanic : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestPanic);
+        CPPUNIT_TEST(testReasonsAreStatic);
+        CPPUNIT_TEST(testCheckIndexInRange);
+        CPPUNIT_TEST(testCheckNotNull);
+        CPPUNIT_TEST(testCheckState);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testReasonsAreStatic() {
+        // The descriptors must be usable as identity - the error value
+        // carries a pointer to them, not a copy:
+        const PanicError a(panics::IndexOutOfRange);
+        const PanicError b(panics::IndexOutOfRange, "somewhere");
+        const PanicError c(panics::OutOfMemory);
+
+        CPPUNIT_ASSERT(a == b);
+        CPPUNIT_ASSERT(!(a == c));
+        CPPUNIT_ASSERT(a.reason == &panics::IndexOutOfRange);
+    }
+
+    void testCheckIndexInRange() {
+        CPPUNIT_ASSERT(checkIndexInRange(3, 0, 10).isOk());
+        CPPUNIT_ASSERT(checkIndexInRange(0, 0, 10).isOk());
+
+        const auto past = checkIndexInRange(10, 0, 10);
+        CPPUNIT_ASSERT(past.isError());
+        CPPUNIT_ASSERT(past.getError().reason == &panics::IndexOutOfRange);
+
+        CPPUNIT_ASSERT(checkIndexInRange(1, 2, 10).isError());
+    }
+
+    void testCheckNotNull() {
+        int value = 42;
+        auto present = checkNotNull(&value);
+        CPPUNIT_ASSERT(present.isOk());
+        CPPUNIT_ASSERT_EQUAL(&value, present.unwrap());
+
+        int* nothing = nullptr;
+        auto absent = checkNotNull(nothing);
+        CPPUNIT_ASSERT(absent.isError());
+        CPPUNIT_ASSERT(absent.getError().reason == &panics::NullPointer);
+    }
+
+    void testCheckState() {
+        CPPUNIT_ASSERT(checkState(true).isOk());
+
+        const auto bad = checkState(false, "socket already closed");
+        CPPUNIT_ASSERT(bad.isError());
+        CPPUNIT_ASSERT(bad.getError().reason == &panics::InvalidState);
+        CPPUNIT_ASSERT(bad.getError().detail != nullptr);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPanic);
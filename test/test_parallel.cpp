@@ -0,0 +1,130 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_parallel.cpp
+ * @author: soultaker
+ *******************************************************************************/
+#include <solace/parallel.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <atomic>
+#include <numeric>
+#include <random>
+#include <vector>
+
+using namespace Solace;
+
+
+class TestParallel: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestParallel);
+        CPPUNIT_TEST(testForEachParallel);
+        CPPUNIT_TEST(testMapParallel);
+        CPPUNIT_TEST(testReduceParallel);
+        CPPUNIT_TEST(testSortParallel);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testForEachParallel() {
+        std::vector<int> data(10007, 1);
+        auto view = arryaView(data.data(), data.size());
+
+        std::atomic<int> sum{0};
+        forEachParallel(view, [&sum](int x) { sum += x; }, 4);
+        CPPUNIT_ASSERT_EQUAL(static_cast<int>(data.size()), sum.load());
+
+        // Mutation through the view is visible to the caller
+        forEachParallel(view, [](int& x) { x *= 3; });
+        CPPUNIT_ASSERT_EQUAL(3, data.front());
+        CPPUNIT_ASSERT_EQUAL(3, data.back());
+
+        // An empty view never invokes the function
+        forEachParallel(ArrayView<int>(), [](int&) { CPPUNIT_FAIL("Should not be called"); }, 8);
+    }
+
+    void testMapParallel() {
+        std::vector<int> src(5001);
+        std::iota(src.begin(), src.end(), 0);
+        std::vector<int> dest(src.size());
+
+        mapParallel(arryaView(src.data(), src.size()),
+                    arryaView(dest.data(), dest.size()),
+                    [](int x) { return 2 * x; },
+                    3);
+
+        for (size_t i = 0; i < dest.size(); ++i) {
+            CPPUNIT_ASSERT_EQUAL(2 * src[i], dest[i]);
+        }
+
+        // Source and destination of different sizes is a usage error
+        CPPUNIT_ASSERT_THROW(mapParallel(arryaView(src.data(), src.size()),
+                                         arryaView(dest.data(), dest.size() - 1),
+                                         [](int x) { return x; }),
+                             IllegalArgumentException);
+    }
+
+    void testReduceParallel() {
+        std::vector<int> data(12345);
+        std::iota(data.begin(), data.end(), 0);
+        auto view = arryaView(data.data(), data.size());
+
+        const int64 n = static_cast<int64>(data.size());
+        const int64 expected = 100 + (n - 1) * n / 2;
+
+        // The result must not depend on the number of workers
+        for (uint32 nbWorkers : {0, 1, 2, 3, 7, 64}) {
+            const auto result = reduceParallel(view, static_cast<int64>(100),
+                                               [](int64 acc, int64 x) { return acc + x; },
+                                               nbWorkers);
+            CPPUNIT_ASSERT_EQUAL(expected, result);
+        }
+
+        // An empty view reduces to the initial value
+        const auto empty = reduceParallel(ArrayView<int>(), static_cast<int64>(42),
+                                          [](int64 acc, int64 x) { return acc + x; });
+        CPPUNIT_ASSERT_EQUAL(static_cast<int64>(42), empty);
+    }
+
+    void testSortParallel() {
+        std::mt19937 rnd(7);
+
+        for (size_t count : {0ul, 1ul, 17ul, 1000ul, 64237ul}) {
+            std::vector<int> data(count);
+            for (auto& x : data) {
+                x = static_cast<int>(rnd());
+            }
+
+            sortParallel(arryaView(data.data(), data.size()), 5);
+            CPPUNIT_ASSERT(std::is_sorted(data.begin(), data.end()));
+        }
+
+        // With a custom comparator
+        std::vector<int> data(5000);
+        for (auto& x : data) {
+            x = static_cast<int>(rnd());
+        }
+
+        sortParallel(arryaView(data.data(), data.size()), std::greater<int>(), 3);
+        CPPUNIT_ASSERT(std::is_sorted(data.begin(), data.end(), std::greater<int>()));
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestParallel);
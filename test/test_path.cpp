@@ -22,6 +22,7 @@
 *******************************************************************************/
 #include <solace/path.hpp>			// Class being tested
 #include <solace/exception.hpp>     // Checked expcetions
+#include <solace/writeBuffer.hpp>
 
 #include "mockTypes.hpp"
 #include <cppunit/extensions/HelperMacros.h>
@@ -46,6 +47,7 @@ class TestPath : public CppUnit::TestFixture  {
 
         CPPUNIT_TEST(testNormalize);
         CPPUNIT_TEST(testGetParent);
+        CPPUNIT_TEST(testGetParentView);
         CPPUNIT_TEST(testComponents);
         CPPUNIT_TEST(testSubpath);
         CPPUNIT_TEST(testJoin);
@@ -61,6 +63,8 @@ class TestPath : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testLast);
 
         CPPUNIT_TEST(testToString);
+        CPPUNIT_TEST(testToStringIntoBuffer);
+        CPPUNIT_TEST(testHashCode);
         CPPUNIT_TEST(testParsing);
         CPPUNIT_TEST(testParsing_and_ToString_are_consistent);
     CPPUNIT_TEST_SUITE_END();
@@ -262,6 +266,21 @@ public:
         }
     }
 
+    void testGetParentView() {
+        // Same decomposition as getParent(), with no Path constructed:
+        CPPUNIT_ASSERT_EQUAL(StringView("/usr/local/bin"),
+                             Path::parse("/usr/local/bin/tool").unwrap().getParentView());
+        CPPUNIT_ASSERT_EQUAL(StringView("1/2/3/4"), Path({"1", "2", "3", "4", "file"}).getParentView());
+
+        // The parent of a first-level path is the root itself:
+        CPPUNIT_ASSERT_EQUAL(Path::Delimiter, Path({"", "file"}).getParentView());
+
+        // Paths with no parent view as themselves, like getParent():
+        CPPUNIT_ASSERT_EQUAL(Path::Delimiter, Path({""}).getParentView());
+        CPPUNIT_ASSERT_EQUAL(StringView("file"), Path("file").getParentView());
+        CPPUNIT_ASSERT_EQUAL(StringView(), Path().getParentView());
+    }
+
     void testBasename() {
         CPPUNIT_ASSERT_EQUAL(StringView(), Path().getBasename());
         CPPUNIT_ASSERT_EQUAL(Path::Delimiter, Path({""}).getBasename());
@@ -432,6 +451,50 @@ public:
     }
 
 
+    void testToStringIntoBuffer() {
+        const Path p({"", "etc", "something", "1"});
+
+        byte data[64];
+        WriteBuffer dest(wrapMemory(data));
+        CPPUNIT_ASSERT(p.toString(dest).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(16), dest.position());
+        CPPUNIT_ASSERT(memcmp(data, "/etc/something/1", 16) == 0);
+
+        WriteBuffer custom(wrapMemory(data));
+        CPPUNIT_ASSERT(p.toString(custom, "|:").isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(19), custom.position());
+        CPPUNIT_ASSERT(memcmp(data, "|:etc|:something|:1", 19) == 0);
+
+        // The root path renders as the bare delimiter:
+        WriteBuffer rootDest(wrapMemory(data));
+        CPPUNIT_ASSERT(Path("").toString(rootDest).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(1), rootDest.position());
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>('/'), data[0]);
+
+        // A destination too small errors with nothing written:
+        byte tiny[4];
+        WriteBuffer small(wrapMemory(tiny));
+        CPPUNIT_ASSERT(p.toString(small).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(0), small.position());
+    }
+
+
+    void testHashCode() {
+        const Path p({"", "etc", "config.json"});
+
+        // Memoized values are stable across calls:
+        CPPUNIT_ASSERT_EQUAL(p.toString(), p.toString());
+        CPPUNIT_ASSERT_EQUAL(p.hashCode(), p.hashCode());
+
+        // ... and a custom-delimiter rendering does not disturb the cache:
+        CPPUNIT_ASSERT_EQUAL(String("|:etc|:config.json"), p.toString("|:"));
+        CPPUNIT_ASSERT_EQUAL(String("/etc/config.json"), p.toString());
+
+        CPPUNIT_ASSERT_EQUAL(Path({"", "etc", "config.json"}).hashCode(), p.hashCode());
+        CPPUNIT_ASSERT(Path({"", "etc"}).hashCode() != p.hashCode());
+    }
+
+
     /**
      * Test implementation and contract of parsable
      */
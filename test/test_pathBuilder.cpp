@@ -0,0 +1,129 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_pathBuilder.cpp
+ * @author: soultaker
+ *
+*******************************************************************************/
+#include <solace/pathBuilder.hpp>  // Class being tested
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+class TestPathBuilder: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestPathBuilder);
+        CPPUNIT_TEST(testEmpty);
+        CPPUNIT_TEST(testAppend);
+        CPPUNIT_TEST(testRemoveLast);
+        CPPUNIT_TEST(testSeededFromPath);
+        CPPUNIT_TEST(testToPath);
+        CPPUNIT_TEST(testComponentAccess);
+        CPPUNIT_TEST(testClear);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmpty() {
+        PathBuilder builder;
+
+        CPPUNIT_ASSERT(builder.empty());
+        CPPUNIT_ASSERT(!builder.isAbsolute());
+        CPPUNIT_ASSERT_EQUAL(static_cast<PathBuilder::size_type>(0), builder.size());
+        CPPUNIT_ASSERT_EQUAL(String::Empty, builder.toString());
+    }
+
+    void testAppend() {
+        PathBuilder builder;
+        builder.append("").append("etc").append(String("config.json"));
+
+        CPPUNIT_ASSERT(builder.isAbsolute());
+        CPPUNIT_ASSERT_EQUAL(static_cast<PathBuilder::size_type>(3), builder.size());
+        CPPUNIT_ASSERT_EQUAL(String("/etc/config.json"), builder.toString());
+    }
+
+    void testRemoveLast() {
+        PathBuilder builder;
+        builder.append("").append("etc").append("config.json");
+
+        builder.removeLast();
+        CPPUNIT_ASSERT_EQUAL(String("/etc"), builder.toString());
+
+        builder.removeLast();
+        CPPUNIT_ASSERT_EQUAL(String("/"), builder.toString());
+
+        builder.removeLast();
+        CPPUNIT_ASSERT(builder.empty());
+
+        // Removing from an empty builder is a no-op:
+        builder.removeLast();
+        CPPUNIT_ASSERT(builder.empty());
+    }
+
+    void testSeededFromPath() {
+        PathBuilder builder(Path({"home", "user"}));
+
+        CPPUNIT_ASSERT(!builder.isAbsolute());
+        CPPUNIT_ASSERT_EQUAL(String("home/user"), builder.toString());
+
+        // A walker descends and backs up without touching the base:
+        builder.append("docs");
+        CPPUNIT_ASSERT_EQUAL(String("home/user/docs"), builder.toString());
+
+        builder.removeLast();
+        builder.append("music");
+        CPPUNIT_ASSERT_EQUAL(String("home/user/music"), builder.toString());
+    }
+
+    void testToPath() {
+        PathBuilder builder;
+        builder.append("").append("etc").append("config.json");
+
+        auto const path = builder.toPath();
+        CPPUNIT_ASSERT_EQUAL(Path({"", "etc", "config.json"}), path);
+        CPPUNIT_ASSERT_EQUAL(builder.toString(), path.toString());
+    }
+
+    void testComponentAccess() {
+        PathBuilder builder;
+        builder.append("one").append("two").append("three");
+
+        CPPUNIT_ASSERT_EQUAL(StringView("two"), builder.getComponent(1));
+        CPPUNIT_ASSERT_EQUAL(StringView("three"), builder.last());
+
+        CPPUNIT_ASSERT_THROW(builder.getComponent(3), IndexOutOfRangeException);
+    }
+
+    void testClear() {
+        PathBuilder builder;
+        builder.append("one").append("two");
+
+        builder.clear();
+        CPPUNIT_ASSERT(builder.empty());
+        CPPUNIT_ASSERT_EQUAL(StringView(), builder.last());
+
+        // The builder is reusable after a clear:
+        builder.append("fresh");
+        CPPUNIT_ASSERT_EQUAL(String("fresh"), builder.toString());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPathBuilder);
@@ -0,0 +1,184 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_persistentMap.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/persistentMap.hpp>  // Class being tested
+
+#include <solace/atomicShared.hpp>
+#include <solace/string.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <map>
+#include <random>
+#include <thread>
+
+
+using namespace Solace;
+
+
+class TestPersistentMap : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestPersistentMap);
+        CPPUNIT_TEST(testEmpty);
+        CPPUNIT_TEST(testSetFindRemove);
+        CPPUNIT_TEST(testOldVersionsUnchanged);
+        CPPUNIT_TEST(testRandomizedAgainstStdMap);
+        CPPUNIT_TEST(testStringKeys);
+        CPPUNIT_TEST(testAtomicSharedPublication);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmpty() {
+        PersistentMap<uint64, int> m;
+
+        CPPUNIT_ASSERT(m.empty());
+        CPPUNIT_ASSERT(m.find(uint64(3)) == nullptr);
+        CPPUNIT_ASSERT(m.remove(uint64(3)).empty());
+    }
+
+    void testSetFindRemove() {
+        PersistentMap<uint64, int> m;
+        for (uint64 i = 0; i < 500; ++i) {
+            m = m.set(i, static_cast<int>(i * 2));
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<PersistentMap<uint64, int>::size_type>(500), m.size());
+        for (uint64 i = 0; i < 500; ++i) {
+            auto* p = m.find(i);
+            CPPUNIT_ASSERT(p != nullptr);
+            CPPUNIT_ASSERT_EQUAL(static_cast<int>(i * 2), *p);
+        }
+
+        // Rebinding replaces, not grows:
+        m = m.set(7, -7);
+        CPPUNIT_ASSERT_EQUAL(static_cast<PersistentMap<uint64, int>::size_type>(500), m.size());
+        CPPUNIT_ASSERT_EQUAL(-7, *m.find(uint64(7)));
+
+        m = m.remove(uint64(7));
+        CPPUNIT_ASSERT(m.find(uint64(7)) == nullptr);
+        CPPUNIT_ASSERT_EQUAL(static_cast<PersistentMap<uint64, int>::size_type>(499), m.size());
+    }
+
+    void testOldVersionsUnchanged() {
+        PersistentMap<uint64, int> m;
+        for (uint64 i = 0; i < 100; ++i) {
+            m = m.set(i, static_cast<int>(i));
+        }
+
+        const auto old = m;
+        for (uint64 i = 0; i < 100; ++i) {
+            m = m.set(i, -static_cast<int>(i));
+        }
+        m = m.remove(uint64(50));
+
+        for (uint64 i = 0; i < 100; ++i) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<int>(i), *old.find(i));
+        }
+        CPPUNIT_ASSERT_EQUAL(-42, *m.find(uint64(42)));
+        CPPUNIT_ASSERT(m.find(uint64(50)) == nullptr);
+
+        // Entries never rebound are the same objects in both versions:
+        CPPUNIT_ASSERT_EQUAL(old.find(uint64(60)), old.find(uint64(60)));
+    }
+
+    void testRandomizedAgainstStdMap() {
+        PersistentMap<uint64, uint64> m;
+        std::map<uint64, uint64> reference;
+
+        std::mt19937_64 rng(2016);
+        for (int i = 0; i < 10000; ++i) {
+            const uint64 key = rng() % 1000;
+            if (rng() % 4 == 0) {
+                m = m.remove(key);
+                reference.erase(key);
+            } else {
+                const uint64 value = rng();
+                m = m.set(key, value);
+                reference[key] = value;
+            }
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<PersistentMap<uint64, uint64>::size_type>(reference.size()),
+                             m.size());
+        for (auto const& kv : reference) {
+            auto* p = m.find(kv.first);
+            CPPUNIT_ASSERT(p != nullptr);
+            CPPUNIT_ASSERT_EQUAL(kv.second, *p);
+        }
+
+        uint32 visited = 0;
+        m.forEach([&reference, &visited](uint64 key, uint64 value) {
+            ++visited;
+            CPPUNIT_ASSERT_EQUAL(reference.at(key), value);
+        });
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(reference.size()), visited);
+    }
+
+    void testStringKeys() {
+        PersistentMap<String, int> m;
+        m = m.set(String("endpoint"), 1);
+        m = m.set(String("timeout"), 2);
+
+        CPPUNIT_ASSERT_EQUAL(1, *m.find(String("endpoint")));
+        CPPUNIT_ASSERT_EQUAL(2, *m.find(String("timeout")));
+        CPPUNIT_ASSERT(m.find(String("retries")) == nullptr);
+    }
+
+    void testAtomicSharedPublication() {
+        AtomicShared<PersistentMap<uint64, uint64>> config;
+        {
+            PersistentMap<uint64, uint64> initial;
+            for (uint64 i = 0; i < 32; ++i) {
+                initial = initial.set(i, i);
+            }
+            config.store(std::move(initial));
+        }
+
+        std::thread writer([&config] {
+            for (uint64 gen = 1; gen <= 100; ++gen) {
+                auto snapshot = config.load();
+                auto next = *snapshot;
+                for (uint64 i = 0; i < 32; ++i) {
+                    next = next.set(i, i + gen * 1000);
+                }
+                config.store(std::move(next));
+            }
+        });
+
+        std::thread reader([&config] {
+            for (int r = 0; r < 1000; ++r) {
+                auto snapshot = config.load();
+                // Every key within one snapshot belongs to the same generation:
+                auto* first = snapshot->find(uint64(0));
+                auto* last = snapshot->find(uint64(31));
+                CPPUNIT_ASSERT(first != nullptr && last != nullptr);
+                CPPUNIT_ASSERT_EQUAL(*first, *last - 31);
+            }
+        });
+
+        writer.join();
+        reader.join();
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(5 + 100000), *config.load()->find(uint64(5)));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPersistentMap);
@@ -0,0 +1,126 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_persistentVector.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/persistentVector.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <vector>
+
+
+using namespace Solace;
+
+
+class TestPersistentVector : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestPersistentVector);
+        CPPUNIT_TEST(testEmpty);
+        CPPUNIT_TEST(testAppendAcrossNodeBoundaries);
+        CPPUNIT_TEST(testOldVersionsUnchanged);
+        CPPUNIT_TEST(testSetSharesUntouchedStorage);
+        CPPUNIT_TEST(testForEachVisitsInOrder);
+        CPPUNIT_TEST(testOutOfRangeThrows);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmpty() {
+        PersistentVector<int> v;
+
+        CPPUNIT_ASSERT(v.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<PersistentVector<int>::size_type>(0), v.size());
+    }
+
+    void testAppendAcrossNodeBoundaries() {
+        PersistentVector<int> v;
+
+        // Enough elements to force two root overflows (32 and 1024):
+        const int N = 33 * 40;
+        for (int i = 0; i < N; ++i) {
+            v = v.append(i);
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<PersistentVector<int>::size_type>(N), v.size());
+        for (int i = 0; i < N; ++i) {
+            CPPUNIT_ASSERT_EQUAL(i, v[i]);
+        }
+    }
+
+    void testOldVersionsUnchanged() {
+        PersistentVector<int> v;
+        std::vector<PersistentVector<int>> versions;
+
+        for (int i = 0; i < 200; ++i) {
+            versions.push_back(v);
+            v = v.append(i);
+        }
+
+        for (int n = 0; n < 200; ++n) {
+            CPPUNIT_ASSERT_EQUAL(static_cast<PersistentVector<int>::size_type>(n),
+                                 versions[n].size());
+            for (int i = 0; i < n; ++i) {
+                CPPUNIT_ASSERT_EQUAL(i, versions[n][i]);
+            }
+        }
+    }
+
+    void testSetSharesUntouchedStorage() {
+        PersistentVector<int> v;
+        for (int i = 0; i < 100; ++i) {
+            v = v.append(i);
+        }
+
+        const auto v2 = v.set(42, -1);
+
+        CPPUNIT_ASSERT_EQUAL(-1, v2[42]);
+        CPPUNIT_ASSERT_EQUAL(42, v[42]);
+        CPPUNIT_ASSERT_EQUAL(v.size(), v2.size());
+
+        // Untouched leaves are the same objects, not copies:
+        CPPUNIT_ASSERT_EQUAL(&v[70], &v2[70]);
+    }
+
+    void testForEachVisitsInOrder() {
+        PersistentVector<int> v;
+        for (int i = 0; i < 150; ++i) {
+            v = v.append(i);
+        }
+
+        int expected = 0;
+        v.forEach([&expected](int x) {
+            CPPUNIT_ASSERT_EQUAL(expected, x);
+            ++expected;
+        });
+        CPPUNIT_ASSERT_EQUAL(150, expected);
+    }
+
+    void testOutOfRangeThrows() {
+        PersistentVector<int> v;
+        CPPUNIT_ASSERT_THROW(v[0], IndexOutOfRangeException);
+
+        v = v.append(3);
+        CPPUNIT_ASSERT_THROW(v[1], IndexOutOfRangeException);
+        CPPUNIT_ASSERT_THROW(v.set(1, 5), IndexOutOfRangeException);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPersistentVector);
@@ -0,0 +1,142 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_radixSort.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/radixSort.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+using namespace Solace;
+
+
+class TestRadixSort : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestRadixSort);
+        CPPUNIT_TEST(testEmptyAndSmallInputs);
+        CPPUNIT_TEST(testUnsigned64Keys);
+        CPPUNIT_TEST(testSignedKeysWithNegatives);
+        CPPUNIT_TEST(testClusteredKeysSkipPasses);
+        CPPUNIT_TEST(testIndexSortIsStableAndLeavesKeys);
+        CPPUNIT_TEST(testUndersizedScratchThrows);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmptyAndSmallInputs() {
+        std::vector<uint64> empty;
+        CPPUNIT_ASSERT_NO_THROW(radixSort(ArrayView<uint64>(empty.data(), 0)));
+
+        std::vector<int64> small = {5, -3, 9, -3, 0, 100, -100};
+        auto expected = small;
+        std::sort(expected.begin(), expected.end());
+
+        radixSort(ArrayView<int64>(small.data(), static_cast<uint32>(small.size())));
+        CPPUNIT_ASSERT(small == expected);
+    }
+
+    void testUnsigned64Keys() {
+        std::mt19937_64 rng(2016);
+        std::vector<uint64> v(100000);
+        for (auto& x : v) {
+            x = rng();
+        }
+
+        auto expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        radixSort(ArrayView<uint64>(v.data(), static_cast<uint32>(v.size())), 4);
+        CPPUNIT_ASSERT(v == expected);
+    }
+
+    void testSignedKeysWithNegatives() {
+        std::mt19937_64 rng(7);
+        std::vector<int32> v(50000);
+        for (auto& x : v) {
+            x = static_cast<int32>(rng());
+        }
+
+        auto expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        std::vector<int32> scratch(v.size());
+        radixSort(ArrayView<int32>(v.data(), static_cast<uint32>(v.size())),
+                  ArrayView<int32>(scratch.data(), static_cast<uint32>(scratch.size())));
+        CPPUNIT_ASSERT(v == expected);
+    }
+
+    void testClusteredKeysSkipPasses() {
+        // 64-bit keys that fit in two bytes: six of the eight passes are degenerate.
+        std::mt19937_64 rng(99);
+        std::vector<uint64> v(20000);
+        for (auto& x : v) {
+            x = rng() & 0xFFFFu;
+        }
+
+        auto expected = v;
+        std::sort(expected.begin(), expected.end());
+
+        radixSort(ArrayView<uint64>(v.data(), static_cast<uint32>(v.size())), 2);
+        CPPUNIT_ASSERT(v == expected);
+    }
+
+    void testIndexSortIsStableAndLeavesKeys() {
+        const uint32 n = 30000;
+        std::mt19937_64 rng(5);
+
+        std::vector<uint64> keys(n);
+        for (auto& k : keys) {
+            k = rng() % 100;  // Plenty of ties to probe stability.
+        }
+        const auto keysCopy = keys;
+
+        std::vector<uint32> index(n);
+        for (uint32 i = 0; i < n; ++i) {
+            index[i] = i;
+        }
+
+        radixSortIndex(ArrayView<uint64>(keys.data(), n), ArrayView<uint32>(index.data(), n), 3);
+
+        CPPUNIT_ASSERT(keys == keysCopy);
+        for (uint32 i = 1; i < n; ++i) {
+            CPPUNIT_ASSERT(keys[index[i - 1]] <= keys[index[i]]);
+            if (keys[index[i - 1]] == keys[index[i]]) {
+                CPPUNIT_ASSERT(index[i - 1] < index[i]);
+            }
+        }
+    }
+
+    void testUndersizedScratchThrows() {
+        std::vector<uint64> v(5000);
+        std::vector<uint64> scratch(10);
+
+        CPPUNIT_ASSERT_THROW(
+                radixSort(ArrayView<uint64>(v.data(), static_cast<uint32>(v.size())),
+                          ArrayView<uint64>(scratch.data(), static_cast<uint32>(scratch.size()))),
+                IllegalArgumentException);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestRadixSort);
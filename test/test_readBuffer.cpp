@@ -40,9 +40,18 @@ class TestReadBuffer: public CppUnit::TestFixture  {
 
         CPPUNIT_TEST(testReadIntoBuffer);
         CPPUNIT_TEST(testReadFromOffset);
+        CPPUNIT_TEST(testReadIntoUninitialized);
+        CPPUNIT_TEST(testPeekDoesNotAdvance);
+        CPPUNIT_TEST(testExtractAt);
+
+        CPPUNIT_TEST(testSubReader);
+        CPPUNIT_TEST(testReadStringView);
+        CPPUNIT_TEST(testReadArrayView);
 
         CPPUNIT_TEST(readBigEndian);
         CPPUNIT_TEST(readLittleEndian);
+        CPPUNIT_TEST(readBatch);
+        CPPUNIT_TEST(readVarint);
     CPPUNIT_TEST_SUITE_END();
 
 protected:
@@ -169,6 +178,70 @@ public:
         CPPUNIT_ASSERT(buffer.read(destView, testSize).isError());
     }
 
+    void testSubReader() {
+        byte const srcBytes[] = {'h', 'd', 'r', 1, 0, 2, 0, 3, 0, 't', 'l'};
+
+        ReadBuffer buffer(wrapMemory(srcBytes));
+
+        // A sub-reader over the nested [u16 x 3] window:
+        auto sub = buffer.subReader(3, 6);
+        CPPUNIT_ASSERT(sub.isOk());
+
+        auto nested = sub.moveResult();
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(6), nested.limit());
+
+        uint16 value;
+        CPPUNIT_ASSERT(nested.readLE(value).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(1), value);
+        CPPUNIT_ASSERT(nested.readLE(value).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(2), value);
+
+        // The parent has not moved:
+        CPPUNIT_ASSERT_EQUAL(ZERO, buffer.position());
+
+        // One combined check covers offset and length together:
+        CPPUNIT_ASSERT(buffer.subReader(sizeof(srcBytes), 0).isOk());
+        CPPUNIT_ASSERT(buffer.subReader(sizeof(srcBytes) + 1, 0).isError());
+        CPPUNIT_ASSERT(buffer.subReader(3, sizeof(srcBytes)).isError());
+        CPPUNIT_ASSERT(buffer.subReader(3, static_cast<size_type>(-1)).isError());
+    }
+
+    void testReadStringView() {
+        byte const srcBytes[] = {'n', 'a', 'm', 'e', '!', 'x'};
+
+        ReadBuffer buffer(wrapMemory(srcBytes));
+
+        auto name = buffer.readStringView(4);
+        CPPUNIT_ASSERT(name.isOk());
+        CPPUNIT_ASSERT(name.unwrap() == StringView("name"));
+
+        // Zero-copy: the view aliases the buffer's own storage.
+        CPPUNIT_ASSERT(name.unwrap().data() == reinterpret_cast<const char*>(srcBytes));
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(4), buffer.position());
+
+        CPPUNIT_ASSERT(buffer.readStringView(3).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(4), buffer.position());
+    }
+
+    void testReadArrayView() {
+        uint16 const values[] = {10, 20, 30, 40};
+
+        ReadBuffer buffer(wrapMemory(values));
+
+        auto view = buffer.readArrayView<uint16>(3);
+        CPPUNIT_ASSERT(view.isOk());
+
+        auto arr = view.unwrap();
+        CPPUNIT_ASSERT_EQUAL(static_cast<decltype(arr)::size_type>(3), arr.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(10), arr[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(30), arr[2]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(6), buffer.position());
+
+        // Only one u16 left - a request for two must not advance:
+        CPPUNIT_ASSERT(buffer.readArrayView<uint16>(2).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(6), buffer.position());
+    }
+
     void testReadFromOffset() {
         byte const srcBytes[] = {'a', 'b', 'c', 0, 'd', 'f', 'g'};
         constexpr size_type testSize = sizeof(srcBytes);
@@ -195,6 +268,67 @@ public:
         CPPUNIT_ASSERT(buffer.read(testSize + 3, destView, 2).isError());
     }
 
+    void testReadIntoUninitialized() {
+        byte const srcBytes[] = {'a', 'b', 'c', 0, 'd', 'f', 'g'};
+
+        ReadBuffer buffer(wrapMemory(srcBytes));
+
+        // The destination view is a temporary over raw scratch storage -
+        // no lvalue MemoryView and no zero-fill required:
+        byte scratch[4];
+        CPPUNIT_ASSERT(buffer.readInto(wrapMemory(scratch)).isOk());
+        CPPUNIT_ASSERT_EQUAL(srcBytes[0], scratch[0]);
+        CPPUNIT_ASSERT_EQUAL(srcBytes[3], scratch[3]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(4), buffer.position());
+
+        CPPUNIT_ASSERT(buffer.readInto(wrapMemory(scratch), 2).isOk());
+        CPPUNIT_ASSERT_EQUAL(srcBytes[4], scratch[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(6), buffer.position());
+
+        CPPUNIT_ASSERT(buffer.readInto(wrapMemory(scratch)).isError());
+    }
+
+    void testPeekDoesNotAdvance() {
+        byte const srcBytes[] = {'a', 'b', 'c', 0, 'd', 'f', 'g'};
+
+        ReadBuffer buffer(wrapMemory(srcBytes));
+        CPPUNIT_ASSERT(buffer.advance(2).isOk());
+
+        byte scratch[3];
+        CPPUNIT_ASSERT(buffer.peek(wrapMemory(scratch)).isOk());
+        CPPUNIT_ASSERT_EQUAL(srcBytes[2], scratch[0]);
+        CPPUNIT_ASSERT_EQUAL(srcBytes[4], scratch[2]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(2), buffer.position());
+
+        CPPUNIT_ASSERT(buffer.peek(wrapMemory(scratch), 2).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(2), buffer.position());
+
+        // Peeking past the limit fails and still does not move:
+        byte big[16];
+        CPPUNIT_ASSERT(buffer.peek(wrapMemory(big)).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(2), buffer.position());
+    }
+
+    void testExtractAt() {
+        byte const wire[] = {0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08};
+
+        ReadBuffer buffer(wrapMemory(wire));
+        CPPUNIT_ASSERT(buffer.advance(3).isOk());
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(0x0201), buffer.extractAtLE<uint16>(0).unwrap());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(0x0102), buffer.extractAtBE<uint16>(0).unwrap());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0x08070605), buffer.extractAtLE<uint32>(4).unwrap());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint8>(0x08), buffer.extractAt<uint8>(7).unwrap());
+
+        // Whatever was extracted, the position is untouched:
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(3), buffer.position());
+
+        // Fields crossing the limit error out:
+        CPPUNIT_ASSERT(buffer.extractAtLE<uint32>(5).isError());
+        CPPUNIT_ASSERT(buffer.extractAt<uint8>(8).isError());
+        CPPUNIT_ASSERT(buffer.extractAtBE<uint32>(4).isOk());
+    }
+
 
     void readBigEndian() {
         byte const bytes[] =   {0x84, 0x2d, 0xa3, 0x80,
@@ -263,6 +397,83 @@ public:
         }
     }
 
+
+    void readBatch() {
+        byte const bytes[] =   {0x84, 0x2d, 0xa3, 0x80,
+                                0xe3, 0x42, 0x6d, 0xff};
+
+        {   // Array decode
+            uint16 result[4];
+            CPPUNIT_ASSERT(ReadBuffer(wrapMemory(bytes)).readBE(result, 4).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(0x842d), result[0]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(0x6dff), result[3]);
+
+            CPPUNIT_ASSERT(ReadBuffer(wrapMemory(bytes)).readLE(result, 4).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(0x2d84), result[0]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(0xff6d), result[3]);
+
+            // Decoding more elements than the buffer holds must fail
+            CPPUNIT_ASSERT(ReadBuffer(wrapMemory(bytes)).readBE(result, 5).isError());
+        }
+
+        {   // Struct-of-fields decode
+            uint16 a;
+            uint32 b;
+            uint8 c;
+
+            ReadBuffer buffer(wrapMemory(bytes));
+            CPPUNIT_ASSERT(buffer.readBE(a, b, c).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint16>(0x842d), a);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0xa380e342), b);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint8>(0x6d), c);
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(7), buffer.position());
+
+            // Not enough data for the whole layout: no field is decoded
+            uint32 x;
+            uint64 y;
+            CPPUNIT_ASSERT(buffer.readBE(x, y).isError());
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(7), buffer.position());
+        }
+    }
+
+
+    void readVarint() {
+        {   // Multi-byte value: 300 is encoded as AC 02
+            byte const bytes[] = {0xAC, 0x02};
+
+            uint64 result;
+            ReadBuffer buffer(wrapMemory(bytes));
+            CPPUNIT_ASSERT(buffer.readVarint(result).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(300), result);
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(2), buffer.position());
+        }
+
+        {   // Zig-zag signed decode: 1 on the wire is -1
+            byte const bytes[] = {0x01};
+
+            int64 result;
+            CPPUNIT_ASSERT(ReadBuffer(wrapMemory(bytes)).readVarint(result).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<int64>(-1), result);
+        }
+
+        {   // A truncated varint is an error and consumes nothing
+            byte const bytes[] = {0x80, 0x80, 0x80};
+
+            uint64 result;
+            ReadBuffer buffer(wrapMemory(bytes));
+            CPPUNIT_ASSERT(buffer.readVarint(result).isError());
+            CPPUNIT_ASSERT_EQUAL(ZERO, buffer.position());
+        }
+
+        {   // An unterminated varint of more than 10 bytes is malformed
+            byte const bytes[] = {0x80, 0x80, 0x80, 0x80, 0x80, 0x80,
+                                  0x80, 0x80, 0x80, 0x80, 0x80, 0x80};
+
+            uint64 result;
+            CPPUNIT_ASSERT(ReadBuffer(wrapMemory(bytes)).readVarint(result).isError());
+        }
+    }
+
 };
 
 const TestReadBuffer::size_type TestReadBuffer::ZERO = 0;
@@ -0,0 +1,142 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_recordCursor.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/recordCursor.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <string>
+#include <vector>
+
+
+using namespace Solace;
+
+
+class TestRecordCursor: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestRecordCursor);
+        CPPUNIT_TEST(testLines);
+        CPPUNIT_TEST(testEmptyRecordsAndTail);
+        CPPUNIT_TEST(testCustomDelimiter);
+        CPPUNIT_TEST(testNoCopying);
+        CPPUNIT_TEST(testForEachRecordSerial);
+        CPPUNIT_TEST(testForEachRecordParallel);
+    CPPUNIT_TEST_SUITE_END();
+
+    static ImmutableMemoryView viewOf(const std::string& text) {
+        return wrapMemory(const_cast<char*>(text.data()), text.size());
+    }
+
+    static std::vector<std::string> collect(ImmutableMemoryView data, byte delimiter = '\n') {
+        std::vector<std::string> records;
+
+        RecordCursor cursor(data, delimiter);
+        while (cursor.hasNext()) {
+            const auto record = cursor.next();
+            records.emplace_back(record.data(), record.size());
+        }
+
+        return records;
+    }
+
+public:
+
+    void testLines() {
+        const std::string text = "one\ntwo\nthree\n";
+        const auto records = collect(viewOf(text));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), records.size());
+        CPPUNIT_ASSERT_EQUAL(std::string("one"),   records[0]);
+        CPPUNIT_ASSERT_EQUAL(std::string("two"),   records[1]);
+        CPPUNIT_ASSERT_EQUAL(std::string("three"), records[2]);
+
+        CPPUNIT_ASSERT(collect(ImmutableMemoryView()).empty());
+    }
+
+    void testEmptyRecordsAndTail() {
+        // Consecutive delimiters yield empty records, the unterminated tail is yielded too:
+        const std::string text = "a\n\nb";
+        const auto records = collect(viewOf(text));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), records.size());
+        CPPUNIT_ASSERT_EQUAL(std::string("a"), records[0]);
+        CPPUNIT_ASSERT_EQUAL(std::string(""),  records[1]);
+        CPPUNIT_ASSERT_EQUAL(std::string("b"), records[2]);
+
+        // A sole delimiter is one empty record, not two:
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), collect(viewOf("\n")).size());
+    }
+
+    void testCustomDelimiter() {
+        const std::string text = "id\x1fname\x1fvalue";
+        const auto records = collect(viewOf(text), '\x1f');
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), records.size());
+        CPPUNIT_ASSERT_EQUAL(std::string("name"), records[1]);
+    }
+
+    void testNoCopying() {
+        // Records are views into the scanned bytes, not copies:
+        const std::string text = "head\ntail";
+
+        RecordCursor cursor(viewOf(text));
+        const auto head = cursor.next();
+        CPPUNIT_ASSERT_EQUAL(text.data(), head.data());
+        CPPUNIT_ASSERT_EQUAL(static_cast<RecordCursor::size_type>(5), cursor.offset());
+
+        const auto tail = cursor.next();
+        CPPUNIT_ASSERT_EQUAL(text.data() + 5, tail.data());
+        CPPUNIT_ASSERT(!cursor.hasNext());
+    }
+
+    void testForEachRecordSerial() {
+        const std::string text = "1\n22\n333\n";
+
+        size_t total = 0;
+        forEachRecord(viewOf(text), [&total](StringView record) {
+            total += record.size();
+        }, '\n', 1);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(6), total);
+    }
+
+    void testForEachRecordParallel() {
+        // Every record must be seen whole, exactly once, regardless of the cuts:
+        std::string text;
+        const size_t nbRecords = 10000;
+        for (size_t i = 0; i < nbRecords; ++i) {
+            text += std::to_string(i);
+            text += '\n';
+        }
+
+        std::atomic<size_t> count{0};
+        std::atomic<size_t> checksum{0};
+        forEachRecord(viewOf(text), [&count, &checksum](StringView record) {
+            count += 1;
+            checksum += std::stoul(std::string(record.data(), record.size()));
+        }, '\n', 4);
+
+        CPPUNIT_ASSERT_EQUAL(nbRecords, count.load());
+        CPPUNIT_ASSERT_EQUAL(nbRecords * (nbRecords - 1) / 2, checksum.load());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestRecordCursor);
@@ -47,6 +47,10 @@ class TestResult : public CppUnit::TestFixture  {
         CPPUNIT_TEST(getErrorOnOkThrows);
 
         CPPUNIT_TEST(testVoidResult);
+        CPPUNIT_TEST(testUnwrapUnsafe);
+        CPPUNIT_TEST(testTryMacro);
+        CPPUNIT_TEST(testCollect);
+        CPPUNIT_TEST(testTraverse);
         CPPUNIT_TEST(testThen);
         CPPUNIT_TEST(testThenArgumentIgnored);
         CPPUNIT_TEST(testThenChaining);
@@ -55,6 +59,7 @@ class TestResult : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testTypeConvertion);
         CPPUNIT_TEST(testMapError);
         CPPUNIT_TEST(testMoveOnlyObjects);
+        CPPUNIT_TEST(testRvalueUnwrapMovesOut);
         CPPUNIT_TEST(testThenMovesObjects);
 
     CPPUNIT_TEST_SUITE_END();
@@ -369,6 +374,115 @@ public:
         CPPUNIT_ASSERT_EQUAL(-5, derivedErr.getError());
     }
 
+    void testUnwrapUnsafe() {
+        Result<int, Error> r = Ok(42);
+
+        // Unchecked access after the caller has branched on isOk():
+        CPPUNIT_ASSERT(r.isOk());
+        CPPUNIT_ASSERT_EQUAL(42, r.unwrapUnsafe());
+
+        r.unwrapUnsafe() = 7;
+        CPPUNIT_ASSERT_EQUAL(7, r.unwrap());
+
+        Result<int, Error> const cr = Ok(3);
+        CPPUNIT_ASSERT_EQUAL(3, cr.unwrapUnsafe());
+    }
+
+    static Result<int, Error> half(int v) {
+        if (v % 2 != 0) {
+            return Err(Error("odd"));
+        }
+
+        return Ok(v / 2);
+    }
+
+    static Result<int, Error> quarter(int v) {
+        SOLACE_TRY(h, half(v));
+        SOLACE_TRY(q, half(h));
+
+        return Ok(q);
+    }
+
+    static Result<void, Error> checkQuarters(int v, int& out) {
+        SOLACE_TRY_VOID(half(v));
+
+        out = quarter(v).unwrap();
+
+        return Ok();
+    }
+
+    void testTryMacro() {
+        CPPUNIT_ASSERT_EQUAL(3, quarter(12).unwrap());
+
+        // The first failing call propagates its error up the whole chain:
+        CPPUNIT_ASSERT(quarter(13).isError());
+        CPPUNIT_ASSERT(quarter(6).isError());
+
+        int out = 0;
+        CPPUNIT_ASSERT(checkQuarters(16, out).isOk());
+        CPPUNIT_ASSERT_EQUAL(4, out);
+        CPPUNIT_ASSERT(checkQuarters(7, out).isError());
+
+        // The Ok value is moved out, not copied:
+        auto nocopies = []() -> Result<MoveOnlyType, Error> {
+            SOLACE_TRY(value, Result<MoveOnlyType, Error>(Ok(MoveOnlyType(98))));
+
+            return Ok(std::move(value));
+        };
+
+        CPPUNIT_ASSERT_EQUAL(98, nocopies().unwrap().x_);
+    }
+
+    void testCollect() {
+        int values[] = {1, 2, 3, 4, 5};
+
+        auto const doubled = collect(arrayView(values), [](int v) -> Result<int, Error> {
+            return Ok(v * 2);
+        });
+
+        CPPUNIT_ASSERT(doubled.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<Array<int>::size_type>(5), doubled.unwrap().size());
+        CPPUNIT_ASSERT_EQUAL(10, doubled.unwrap()[4]);
+
+        // The first error short-circuits the rest of the batch:
+        int calls = 0;
+        auto const failed = collect(arrayView(values), [&calls](int v) -> Result<int, Error> {
+            ++calls;
+            if (v == 3) {
+                return Err(Error("three is right out"));
+            }
+
+            return Ok(v);
+        });
+
+        CPPUNIT_ASSERT(failed.isError());
+        CPPUNIT_ASSERT_EQUAL(3, calls);
+    }
+
+    void testTraverse() {
+        int values[] = {1, 2, 3, 4, 5};
+
+        int sum = 0;
+        auto const checked = traverse(arrayView(values), [&sum](int v) -> Result<void, Error> {
+            sum += v;
+
+            return Ok();
+        });
+
+        CPPUNIT_ASSERT(checked.isOk());
+        CPPUNIT_ASSERT_EQUAL(15, sum);
+
+        auto const bad = traverse(arrayView(values), [](int v) -> Result<void, Error> {
+            if (v > 2) {
+                return Err(Error("too big"));
+            }
+
+            return Ok();
+        });
+
+        CPPUNIT_ASSERT(bad.isError());
+    }
+
     void testThen() {
         auto f = [](bool isOk) -> Result<int, const char*> {
             if (isOk)
@@ -545,6 +659,30 @@ public:
         }
     }
 
+    void testRvalueUnwrapMovesOut() {
+        {   // unwrap() on a temporary moves a move-only value out:
+            auto owned = [] () -> Result<MoveOnlyType, SimpleType> {
+                return Ok(MoveOnlyType(321));
+            } ().unwrap();
+
+            CPPUNIT_ASSERT_EQUAL(321, owned.x_);
+        }
+
+        {   // The lvalue overloads still observe in place:
+            Result<MoveOnlyType, SimpleType> res = Ok(MoveOnlyType(5));
+            CPPUNIT_ASSERT_EQUAL(5, res.unwrap().x_);
+            CPPUNIT_ASSERT_EQUAL(5, res.unwrap().x_);
+        }
+
+        {   // getError() on a temporary moves the error out:
+            auto error = [] () -> Result<int, MoveOnlyType> {
+                return Err(MoveOnlyType(77));
+            } ().getError();
+
+            CPPUNIT_ASSERT_EQUAL(77, error.x_);
+        }
+    }
+
     void testThenMovesObjects() {
         Result<MoveOnlyType, SimpleType> res = Ok<MoveOnlyType>({112});
 
@@ -0,0 +1,171 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_ringBuffer.cpp
+*******************************************************************************/
+#include <solace/ringBuffer.hpp>  // Class being tested
+
+#include <solace/memoryManager.hpp>
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <thread>
+
+using namespace Solace;
+
+
+class TestRingBuffer: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestRingBuffer);
+        CPPUNIT_TEST(testConstruction);
+        CPPUNIT_TEST(testWrapAround);
+        CPPUNIT_TEST(testZeroCopyViews);
+        CPPUNIT_TEST(testStreamingBetweenThreads);
+    CPPUNIT_TEST_SUITE_END();
+
+protected:
+
+    MemoryManager _memoryManager{4096};
+
+public:
+
+    void testConstruction() {
+        // The storage size must be a power of two
+        CPPUNIT_ASSERT_THROW(RingBuffer(_memoryManager.create(100)), IllegalArgumentException);
+
+        RingBuffer ring(_memoryManager.create(16));
+        CPPUNIT_ASSERT_EQUAL(static_cast<RingBuffer::size_type>(16), ring.capacity());
+        CPPUNIT_ASSERT_EQUAL(static_cast<RingBuffer::size_type>(16), ring.remaining());
+        CPPUNIT_ASSERT(ring.empty());
+        CPPUNIT_ASSERT(!ring.full());
+    }
+
+    void testWrapAround() {
+        RingBuffer ring(_memoryManager.create(16));
+
+        byte src[10];
+        for (size_t i = 0; i < sizeof(src); ++i) {
+            src[i] = static_cast<byte>(i);
+        }
+
+        CPPUNIT_ASSERT(ring.write(wrapMemory(src)).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<RingBuffer::size_type>(10), ring.size());
+
+        byte dst[16];
+        auto destView = wrapMemory(dst, 6);
+        CPPUNIT_ASSERT(ring.read(destView).isOk());
+        CPPUNIT_ASSERT(memcmp(dst, src, 6) == 0);
+
+        // This write wraps around the end of the storage with no compaction
+        CPPUNIT_ASSERT(ring.write(wrapMemory(src)).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<RingBuffer::size_type>(14), ring.size());
+
+        // Only 2 bytes of space are left
+        CPPUNIT_ASSERT(ring.write(wrapMemory(src, 3)).isError());
+        CPPUNIT_ASSERT(ring.write(wrapMemory(src, 2)).isOk());
+        CPPUNIT_ASSERT(ring.full());
+
+        auto fullView = wrapMemory(dst);
+        CPPUNIT_ASSERT(ring.read(fullView, 16).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(6), dst[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(9), dst[3]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0), dst[4]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(9), dst[13]);
+        CPPUNIT_ASSERT(ring.empty());
+
+        // No more data to read
+        CPPUNIT_ASSERT(ring.read(fullView, 1).isError());
+    }
+
+    void testZeroCopyViews() {
+        RingBuffer ring(_memoryManager.create(8));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(0), ring.viewReadable().size());
+
+        auto writable = ring.viewWritable();
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(8), writable.size());
+        memcpy(writable.dataAddress(), "abcdef", 6);
+        CPPUNIT_ASSERT(ring.commitWrite(6).isOk());
+        CPPUNIT_ASSERT(ring.commitWrite(3).isError());
+
+        auto readable = ring.viewReadable();
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(6), readable.size());
+        CPPUNIT_ASSERT(memcmp(readable.dataAddress(), "abcdef", 6) == 0);
+        CPPUNIT_ASSERT(ring.commitRead(4).isOk());
+
+        // The writable run stops at the wrap point...
+        writable = ring.viewWritable();
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(2), writable.size());
+        memcpy(writable.dataAddress(), "gh", 2);
+        CPPUNIT_ASSERT(ring.commitWrite(2).isOk());
+
+        // ...and the next call returns the wrapped remainder
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(4), ring.viewWritable().size());
+
+        readable = ring.viewReadable();
+        CPPUNIT_ASSERT_EQUAL(static_cast<MemoryView::size_type>(4), readable.size());
+        CPPUNIT_ASSERT(memcmp(readable.dataAddress(), "efgh", 4) == 0);
+        CPPUNIT_ASSERT(ring.commitRead(4).isOk());
+        CPPUNIT_ASSERT(ring.commitRead(1).isError());
+    }
+
+    void testStreamingBetweenThreads() {
+        RingBuffer ring(_memoryManager.create(256));
+        constexpr long kTotal = 100000;
+
+        std::thread producer([&ring] {
+            byte block[64];
+            long produced = 0;
+            while (produced < kTotal) {
+                const long n = (kTotal - produced < 64) ? (kTotal - produced) : 64;
+                for (long i = 0; i < n; ++i) {
+                    block[i] = static_cast<byte>((produced + i) & 0xFF);
+                }
+
+                while (ring.write(wrapMemory(block, n)).isError()) {
+                    std::this_thread::yield();
+                }
+                produced += n;
+            }
+        });
+
+        long consumed = 0;
+        bool inOrder = true;
+        while (consumed < kTotal) {
+            const auto readable = ring.viewReadable();
+            if (readable.empty()) {
+                std::this_thread::yield();
+                continue;
+            }
+
+            for (MemoryView::size_type i = 0; i < readable.size(); ++i) {
+                inOrder = inOrder && (readable[i] == static_cast<byte>((consumed + i) & 0xFF));
+            }
+
+            consumed += readable.size();
+            CPPUNIT_ASSERT(ring.commitRead(readable.size()).isOk());
+        }
+
+        producer.join();
+        CPPUNIT_ASSERT(inOrder);
+        CPPUNIT_ASSERT(ring.empty());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestRingBuffer);
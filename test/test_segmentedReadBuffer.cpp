@@ -0,0 +1,150 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_segmentedReadBuffer.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/segmentedReadBuffer.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+class TestSegmentedReadBuffer : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSegmentedReadBuffer);
+        CPPUNIT_TEST(testEmptyBuffer);
+        CPPUNIT_TEST(testAppendGrowsLimit);
+        CPPUNIT_TEST(testReadWithinSegment);
+        CPPUNIT_TEST(testReadAcrossBoundary);
+        CPPUNIT_TEST(testEndianReadsAcrossBoundary);
+        CPPUNIT_TEST(testPositionAndRewind);
+        CPPUNIT_TEST(testReadPastEndFails);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmptyBuffer() {
+        SegmentedReadBuffer buffer;
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<SegmentedReadBuffer::size_type>(0), buffer.limit());
+        CPPUNIT_ASSERT(!buffer.hasRemaining());
+        CPPUNIT_ASSERT(buffer.get().isError());
+    }
+
+    void testAppendGrowsLimit() {
+        byte a[3] = {1, 2, 3};
+        byte b[2] = {4, 5};
+
+        SegmentedReadBuffer buffer;
+        buffer.append(wrapMemory(a, sizeof(a)))
+                .append(ImmutableMemoryView())  // Empty segments are skipped
+                .append(wrapMemory(b, sizeof(b)));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<SegmentedReadBuffer::size_type>(2), buffer.segmentCount());
+        CPPUNIT_ASSERT_EQUAL(static_cast<SegmentedReadBuffer::size_type>(5), buffer.limit());
+    }
+
+    void testReadWithinSegment() {
+        byte data[4] = {10, 20, 30, 40};
+
+        SegmentedReadBuffer buffer;
+        buffer.append(wrapMemory(data, sizeof(data)));
+
+        byte pair[2];
+        auto dest = wrapMemory(pair, sizeof(pair));
+        CPPUNIT_ASSERT(buffer.read(dest).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(10), pair[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(20), pair[1]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<SegmentedReadBuffer::size_type>(2), buffer.position());
+    }
+
+    void testReadAcrossBoundary() {
+        byte first[3] = {1, 2, 3};
+        byte second[3] = {4, 5, 6};
+
+        SegmentedReadBuffer buffer;
+        buffer.append(wrapMemory(first, sizeof(first)))
+                .append(wrapMemory(second, sizeof(second)));
+
+        CPPUNIT_ASSERT(buffer.advance(2).isOk());
+
+        byte gathered[3];
+        auto dest = wrapMemory(gathered, sizeof(gathered));
+        CPPUNIT_ASSERT(buffer.read(dest).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(3), gathered[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(4), gathered[1]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(5), gathered[2]);
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<SegmentedReadBuffer::size_type>(1), buffer.remaining());
+        CPPUNIT_ASSERT(buffer.get().unwrap() == 6);
+    }
+
+    void testEndianReadsAcrossBoundary() {
+        // 0xDEADBEEF little-endian, split 1 + 3 across two segments:
+        byte first[1] = {0xEF};
+        byte second[3] = {0xBE, 0xAD, 0xDE};
+
+        SegmentedReadBuffer buffer;
+        buffer.append(wrapMemory(first, sizeof(first)))
+                .append(wrapMemory(second, sizeof(second)));
+
+        uint32 value = 0;
+        CPPUNIT_ASSERT(buffer.readLE(value).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0xDEADBEEF), value);
+
+        buffer.rewind();
+        CPPUNIT_ASSERT(buffer.readBE(value).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0xEFBEADDE), value);
+    }
+
+    void testPositionAndRewind() {
+        byte first[2] = {1, 2};
+        byte second[2] = {3, 4};
+
+        SegmentedReadBuffer buffer;
+        buffer.append(wrapMemory(first, sizeof(first)))
+                .append(wrapMemory(second, sizeof(second)));
+
+        CPPUNIT_ASSERT(buffer.position(3).isOk());
+        CPPUNIT_ASSERT(buffer.get().unwrap() == 4);
+        CPPUNIT_ASSERT(!buffer.hasRemaining());
+
+        buffer.rewind();
+        CPPUNIT_ASSERT_EQUAL(static_cast<SegmentedReadBuffer::size_type>(0), buffer.position());
+        CPPUNIT_ASSERT(buffer.get().unwrap() == 1);
+
+        CPPUNIT_ASSERT(buffer.position(5).isError());
+    }
+
+    void testReadPastEndFails() {
+        byte data[3] = {1, 2, 3};
+
+        SegmentedReadBuffer buffer;
+        buffer.append(wrapMemory(data, sizeof(data)));
+
+        uint32 value;
+        CPPUNIT_ASSERT(buffer.readLE(value).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<SegmentedReadBuffer::size_type>(0), buffer.position());
+
+        CPPUNIT_ASSERT(buffer.advance(4).isError());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSegmentedReadBuffer);
@@ -0,0 +1,111 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_seqlock.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/seqlock.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+
+using namespace Solace;
+
+
+namespace {
+
+/** A stand-in for the feed-state snapshot: a few hundred bytes with an
+ * invariant between fields that a torn read would break. */
+struct Snapshot {
+    uint64 bid;
+    uint64 ask;        // Writer keeps ask == bid + 1 at all times.
+    uint64 stamp;
+    byte   padding[232];
+};
+
+}  // namespace
+
+
+class TestSeqLock : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSeqLock);
+        CPPUNIT_TEST(testStoreAndLoad);
+        CPPUNIT_TEST(testVersionCountsWrites);
+        CPPUNIT_TEST(testNoTornReadsUnderContention);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testStoreAndLoad() {
+        SeqLock<Snapshot> shared(Snapshot{1, 2, 0, {}});
+
+        auto first = shared.load();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(1), first.bid);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(2), first.ask);
+
+        shared.store(Snapshot{10, 11, 1, {}});
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(10), shared.load().bid);
+    }
+
+    void testVersionCountsWrites() {
+        SeqLock<Snapshot> shared;
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), shared.version());
+
+        shared.store(Snapshot{1, 2, 0, {}});
+        shared.store(Snapshot{2, 3, 1, {}});
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(2), shared.version());
+    }
+
+    void testNoTornReadsUnderContention() {
+        SeqLock<Snapshot> shared(Snapshot{0, 1, 0, {}});
+
+        std::atomic<bool> stop {false};
+        std::atomic<uint64> tornReads {0};
+
+        std::vector<std::thread> readers;
+        for (int r = 0; r < 4; ++r) {
+            readers.emplace_back([&shared, &stop, &tornReads]() {
+                while (!stop.load(std::memory_order_relaxed)) {
+                    auto const seen = shared.load();
+                    if (seen.ask != seen.bid + 1) {
+                        tornReads.fetch_add(1, std::memory_order_relaxed);
+                    }
+                }
+            });
+        }
+
+        constexpr uint64 kWrites = 200000;
+        for (uint64 i = 1; i <= kWrites; ++i) {
+            shared.store(Snapshot{i, i + 1, i, {}});
+        }
+
+        stop = true;
+        for (auto& reader : readers) {
+            reader.join();
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), tornReads.load());
+        CPPUNIT_ASSERT_EQUAL(kWrites, shared.version());
+        CPPUNIT_ASSERT_EQUAL(kWrites, shared.load().bid);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSeqLock);
@@ -0,0 +1,147 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_sharedBuffer.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/sharedBuffer.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <thread>
+#include <vector>
+
+
+using namespace Solace;
+
+
+class TestSharedBuffer : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSharedBuffer);
+        CPPUNIT_TEST(testCopyOfDetachesFromSource);
+        CPPUNIT_TEST(testSharingBumpsCountNotBytes);
+        CPPUNIT_TEST(testSliceKeepsBufferAlive);
+        CPPUNIT_TEST(testMoveTransfersOwnership);
+        CPPUNIT_TEST(testEmptyHandles);
+        CPPUNIT_TEST(testConcurrentFanOut);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testCopyOfDetachesFromSource() {
+        byte payload[64];
+        for (size_t i = 0; i < sizeof(payload); ++i) {
+            payload[i] = static_cast<byte>(i);
+        }
+
+        auto buf = SharedBuffer::copyOf(wrapMemory(static_cast<const byte*>(payload), sizeof(payload)));
+
+        // Clobber the source - the shared copy must be unaffected:
+        memset(payload, 0xFF, sizeof(payload));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedBuffer::size_type>(64), buf.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(42), buf.view().dataAddress()[42]);
+    }
+
+    void testSharingBumpsCountNotBytes() {
+        byte payload[32] = {};
+        auto buf = SharedBuffer::copyOf(wrapMemory(static_cast<const byte*>(payload), sizeof(payload)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), buf.shareCount());
+
+        {
+            auto fanOut1 = buf;
+            auto fanOut2 = buf;
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(3), buf.shareCount());
+
+            // Same bytes, not copies:
+            CPPUNIT_ASSERT(fanOut1.view().dataAddress() == buf.view().dataAddress());
+            CPPUNIT_ASSERT(fanOut2.view().dataAddress() == buf.view().dataAddress());
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), buf.shareCount());
+    }
+
+    void testSliceKeepsBufferAlive() {
+        SharedBuffer slice;
+        {
+            byte payload[128];
+            for (size_t i = 0; i < sizeof(payload); ++i) {
+                payload[i] = static_cast<byte>(i);
+            }
+
+            auto whole = SharedBuffer::copyOf(
+                    wrapMemory(static_cast<const byte*>(payload), sizeof(payload)));
+            slice = whole.slice(100, 110);
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(2), whole.shareCount());
+        }
+
+        // The whole buffer handle is gone; the slice still owns the bytes:
+        CPPUNIT_ASSERT_EQUAL(static_cast<SharedBuffer::size_type>(10), slice.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(105), slice.view().dataAddress()[5]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), slice.shareCount());
+    }
+
+    void testMoveTransfersOwnership() {
+        byte payload[16] = {};
+        auto buf = SharedBuffer::copyOf(wrapMemory(static_cast<const byte*>(payload), sizeof(payload)));
+
+        auto moved = std::move(buf);
+
+        CPPUNIT_ASSERT(static_cast<bool>(moved));
+        CPPUNIT_ASSERT(!static_cast<bool>(buf));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), moved.shareCount());
+    }
+
+    void testEmptyHandles() {
+        SharedBuffer empty;
+
+        CPPUNIT_ASSERT(!static_cast<bool>(empty));
+        CPPUNIT_ASSERT(empty.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), empty.shareCount());
+
+        CPPUNIT_ASSERT(SharedBuffer::copyOf(ImmutableMemoryView()).empty());
+    }
+
+    void testConcurrentFanOut() {
+        byte payload[1024];
+        for (size_t i = 0; i < sizeof(payload); ++i) {
+            payload[i] = static_cast<byte>(i * 7);
+        }
+        auto shared = SharedBuffer::copyOf(
+                wrapMemory(static_cast<const byte*>(payload), sizeof(payload)));
+
+        std::vector<std::thread> consumers;
+        for (int t = 0; t < 4; ++t) {
+            consumers.emplace_back([&shared, t] {
+                for (int i = 0; i < 10000; ++i) {
+                    auto local = shared.slice(t * 64, t * 64 + 32);
+                    CPPUNIT_ASSERT_EQUAL(static_cast<byte>(t * 64 * 7),
+                                         local.view().dataAddress()[0]);
+                }
+            });
+        }
+
+        for (auto& c : consumers) {
+            c.join();
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(1), shared.shareCount());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSharedBuffer);
@@ -0,0 +1,137 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_soaArray.cpp
+ * @author: soultaker
+ *******************************************************************************/
+#include <solace/soaArray.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace Solace;
+
+
+class TestSoaArray: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSoaArray);
+        CPPUNIT_TEST(testEmpty);
+        CPPUNIT_TEST(testRecordAccess);
+        CPPUNIT_TEST(testColumnsAreContiguousAndAligned);
+        CPPUNIT_TEST(testIteration);
+        CPPUNIT_TEST(testMove);
+        CPPUNIT_TEST(testMemoryManagerBackedStorage);
+    CPPUNIT_TEST_SUITE_END();
+
+    using Quotes = SoaArray<uint64, float32, uint32>;
+
+public:
+
+    void testEmpty() {
+        Quotes empty;
+
+        CPPUNIT_ASSERT(empty.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<Quotes::size_type>(0), empty.size());
+
+        for (auto record : empty) {
+            (void)record;
+            CPPUNIT_FAIL("Iteration over an empty collection");
+        }
+    }
+
+    void testRecordAccess() {
+        Quotes quotes(static_cast<Quotes::size_type>(100));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<Quotes::size_type>(100), quotes.size());
+
+        // Records are zero-initialized
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(0), std::get<0>(quotes[0]));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(0), std::get<2>(quotes[99]));
+
+        quotes[5] = std::make_tuple(static_cast<uint64>(123456), 99.5f, static_cast<uint32>(200));
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(123456), std::get<0>(quotes[5]));
+        CPPUNIT_ASSERT_EQUAL(99.5f, std::get<1>(quotes[5]));
+
+        // Writes through a column are visible through the record view
+        quotes.column<1>()[6] = 1.5f;
+        CPPUNIT_ASSERT_EQUAL(1.5f, std::get<1>(quotes[6]));
+
+        CPPUNIT_ASSERT_THROW(quotes[quotes.size()], IndexOutOfRangeException);
+    }
+
+    void testColumnsAreContiguousAndAligned() {
+        Quotes quotes(static_cast<Quotes::size_type>(64));
+
+        auto prices = quotes.column<1>();
+        CPPUNIT_ASSERT_EQUAL(static_cast<ArrayView<float32>::size_type>(64), prices.size());
+        CPPUNIT_ASSERT(&prices[1] == &prices[0] + 1);
+
+        // A column following a narrower one still starts on its natural alignment
+        SoaArray<byte, uint64> odd(static_cast<SoaArray<byte, uint64>::size_type>(3));
+        auto wide = odd.column<1>();
+        CPPUNIT_ASSERT_EQUAL(static_cast<uintptr_t>(0),
+                             reinterpret_cast<uintptr_t>(&wide[0]) % alignof(uint64));
+    }
+
+    void testIteration() {
+        Quotes quotes(static_cast<Quotes::size_type>(10));
+
+        uint64 stamp = 0;
+        for (auto record : quotes) {
+            std::get<0>(record) = stamp++;
+        }
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(7), std::get<0>(quotes[7]));
+
+        uint64 total = 0;
+        const Quotes& constQuotes = quotes;
+        constQuotes.forEach([&total](uint64 ts, float32, uint32) { total += ts; });
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(9 * 10 / 2), total);
+    }
+
+    void testMove() {
+        Quotes a(static_cast<Quotes::size_type>(8));
+        a[3] = std::make_tuple(static_cast<uint64>(11), 1.0f, static_cast<uint32>(2));
+
+        Quotes b(std::move(a));
+        CPPUNIT_ASSERT_EQUAL(static_cast<Quotes::size_type>(8), b.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(11), std::get<0>(b[3]));
+        CPPUNIT_ASSERT(a.empty());
+
+        Quotes c;
+        c = std::move(b);
+        CPPUNIT_ASSERT_EQUAL(static_cast<uint64>(11), std::get<0>(c[3]));
+    }
+
+    void testMemoryManagerBackedStorage() {
+        MemoryManager manager(16384);
+        const auto sizeBefore = manager.size();
+
+        {
+            Quotes quotes(static_cast<Quotes::size_type>(64), manager);
+
+            CPPUNIT_ASSERT(manager.size() >= sizeBefore + Quotes::requiredStorage(64));
+
+            quotes[0] = std::make_tuple(static_cast<uint64>(1), 2.0f, static_cast<uint32>(3));
+            CPPUNIT_ASSERT_EQUAL(static_cast<uint32>(3), std::get<2>(quotes[0]));
+        }
+
+        CPPUNIT_ASSERT_EQUAL(sizeBefore, manager.size());
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSoaArray);
@@ -0,0 +1,135 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_sortedView.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/sortedView.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+
+using namespace Solace;
+
+
+class TestSortedView : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestSortedView);
+        CPPUNIT_TEST(testEmptyView);
+        CPPUNIT_TEST(testLowerBoundAgreesWithStd);
+        CPPUNIT_TEST(testFindAndContains);
+        CPPUNIT_TEST(testEytzingerAgreesWithStd);
+        CPPUNIT_TEST(testEytzingerUndersizedDestThrows);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmptyView() {
+        auto sv = sortedView(ArrayView<int>());
+
+        CPPUNIT_ASSERT(sv.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<SortedView<int>::size_type>(0), sv.lowerBound(42));
+        CPPUNIT_ASSERT(!sv.contains(42));
+        CPPUNIT_ASSERT(sv.find(42) == nullptr);
+    }
+
+    void testLowerBoundAgreesWithStd() {
+        std::mt19937_64 rng(2016);
+
+        for (uint32 n : {1u, 2u, 3u, 7u, 100u, 4096u, 50001u}) {
+            std::vector<uint64> v(n);
+            for (auto& x : v) {
+                x = rng() % (2 * n + 10);
+            }
+            std::sort(v.begin(), v.end());
+
+            auto sv = sortedView(ArrayView<uint64>(v.data(), n));
+            for (int probe = 0; probe < 500; ++probe) {
+                const uint64 key = rng() % (2 * n + 20);
+                const auto expected = static_cast<SortedView<uint64>::size_type>(
+                        std::lower_bound(v.begin(), v.end(), key) - v.begin());
+
+                CPPUNIT_ASSERT_EQUAL(expected, sv.lowerBound(key));
+            }
+        }
+    }
+
+    void testFindAndContains() {
+        std::vector<int64> v = {-30, -7, -7, 0, 4, 4, 4, 19};
+        auto sv = sortedView(ArrayView<int64>(v.data(), static_cast<uint32>(v.size())));
+
+        CPPUNIT_ASSERT(sv.contains(-7));
+        CPPUNIT_ASSERT(!sv.contains(5));
+
+        // find() lands on the first of equals:
+        const auto* found = sv.find(4);
+        CPPUNIT_ASSERT(found != nullptr);
+        CPPUNIT_ASSERT_EQUAL(static_cast<ptrdiff_t>(4), found - v.data());
+
+        CPPUNIT_ASSERT(sv.find(100) == nullptr);
+        CPPUNIT_ASSERT(sv.find(-100) == nullptr);
+    }
+
+    void testEytzingerAgreesWithStd() {
+        std::mt19937_64 rng(7);
+
+        for (uint32 n : {0u, 1u, 2u, 15u, 16u, 1000u, 65535u}) {
+            std::vector<int64> v(n);
+            for (auto& x : v) {
+                x = static_cast<int64>(rng() % (2 * n + 10)) - static_cast<int64>(n);
+            }
+            std::sort(v.begin(), v.end());
+
+            std::vector<int64> slab(n);
+            auto ev = EytzingerView<int64>::build(ArrayView<int64>(v.data(), n),
+                                                  ArrayView<int64>(slab.data(), n));
+            CPPUNIT_ASSERT_EQUAL(n, ev.size());
+
+            for (int probe = 0; probe < 500; ++probe) {
+                const int64 key = static_cast<int64>(rng() % (2 * n + 20)) - static_cast<int64>(n) - 5;
+                const auto it = std::lower_bound(v.begin(), v.end(), key);
+                const auto* found = ev.lowerBound(key);
+
+                if (it == v.end()) {
+                    CPPUNIT_ASSERT(found == nullptr);
+                } else {
+                    CPPUNIT_ASSERT(found != nullptr);
+                    CPPUNIT_ASSERT_EQUAL(*it, *found);
+                }
+
+                CPPUNIT_ASSERT_EQUAL(std::binary_search(v.begin(), v.end(), key), ev.contains(key));
+            }
+        }
+    }
+
+    void testEytzingerUndersizedDestThrows() {
+        std::vector<int> v(10);
+        std::vector<int> dest(5);
+
+        CPPUNIT_ASSERT_THROW(
+                EytzingerView<int>::build(ArrayView<int>(v.data(), 10), ArrayView<int>(dest.data(), 5)),
+                IllegalArgumentException);
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestSortedView);
@@ -0,0 +1,148 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_staticVector.cpp
+ * @author: soultaker
+ *******************************************************************************/
+#include <solace/staticVector.hpp>  // Class being tested
+
+#include <solace/exception.hpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include "mockTypes.hpp"
+
+using namespace Solace;
+
+
+class TestStaticVector: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestStaticVector);
+        CPPUNIT_TEST(testEmpty);
+        CPPUNIT_TEST(testPushBackAndAccess);
+        CPPUNIT_TEST(testCapacityIsEnforced);
+        CPPUNIT_TEST(testElementLifetime);
+        CPPUNIT_TEST(testCopyAndMove);
+        CPPUNIT_TEST(testView);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmpty() {
+        StaticVector<int, 8> v;
+
+        CPPUNIT_ASSERT(v.empty());
+        CPPUNIT_ASSERT(!v.full());
+        CPPUNIT_ASSERT_EQUAL(static_cast<StaticVector<int, 8>::size_type>(0), v.size());
+        CPPUNIT_ASSERT_EQUAL(static_cast<StaticVector<int, 8>::size_type>(8), v.capacity());
+
+        CPPUNIT_ASSERT_THROW(v.popBack(), IndexOutOfRangeException);
+        CPPUNIT_ASSERT_THROW(v[0], IndexOutOfRangeException);
+    }
+
+    void testPushBackAndAccess() {
+        StaticVector<int, 8> v;
+
+        for (int i = 0; i < 5; ++i) {
+            v.pushBack(2 * i);
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<StaticVector<int, 8>::size_type>(5), v.size());
+        CPPUNIT_ASSERT_EQUAL(0, v.front());
+        CPPUNIT_ASSERT_EQUAL(8, v.back());
+        CPPUNIT_ASSERT_EQUAL(6, v[3]);
+        CPPUNIT_ASSERT(v.contains(4));
+        CPPUNIT_ASSERT(!v.contains(5));
+
+        v.popBack();
+        CPPUNIT_ASSERT_EQUAL(6, v.back());
+
+        int sum = 0;
+        for (auto x : v) {
+            sum += x;
+        }
+        CPPUNIT_ASSERT_EQUAL(0 + 2 + 4 + 6, sum);
+
+        CPPUNIT_ASSERT_THROW(v[v.size()], IndexOutOfRangeException);
+    }
+
+    void testCapacityIsEnforced() {
+        StaticVector<int, 3> v{1, 2, 3};
+
+        CPPUNIT_ASSERT(v.full());
+        CPPUNIT_ASSERT_THROW(v.pushBack(4), IndexOutOfRangeException);
+
+        using Overfull = StaticVector<int, 2>;
+        CPPUNIT_ASSERT_THROW(Overfull({1, 2, 3}), IndexOutOfRangeException);
+    }
+
+    void testElementLifetime() {
+        const auto countBefore = SimpleType::InstanceCount;
+        {
+            StaticVector<SimpleType, 4> v;
+            v.emplaceBack(1, 0, 0);
+            v.emplaceBack(2, 0, 0);
+            v.emplaceBack(3, 0, 0);
+
+            CPPUNIT_ASSERT_EQUAL(countBefore + 3, SimpleType::InstanceCount);
+
+            v.popBack();
+            CPPUNIT_ASSERT_EQUAL(countBefore + 2, SimpleType::InstanceCount);
+
+            v.clear();
+            CPPUNIT_ASSERT_EQUAL(countBefore, SimpleType::InstanceCount);
+            CPPUNIT_ASSERT(v.empty());
+        }
+        CPPUNIT_ASSERT_EQUAL(countBefore, SimpleType::InstanceCount);
+    }
+
+    void testCopyAndMove() {
+        StaticVector<SimpleType, 4> v;
+        v.emplaceBack(1, 0, 0);
+        v.emplaceBack(2, 0, 0);
+
+        StaticVector<SimpleType, 4> copy(v);
+        CPPUNIT_ASSERT_EQUAL(v.size(), copy.size());
+        CPPUNIT_ASSERT_EQUAL(2, copy[1].x);
+
+        StaticVector<SimpleType, 4> moved(std::move(v));
+        CPPUNIT_ASSERT(v.empty());
+        CPPUNIT_ASSERT_EQUAL(copy.size(), moved.size());
+        CPPUNIT_ASSERT_EQUAL(1, moved[0].x);
+
+        v = moved;
+        CPPUNIT_ASSERT(moved == v);
+
+        swap(v, copy);
+        CPPUNIT_ASSERT(moved == copy);
+    }
+
+    void testView() {
+        StaticVector<int, 8> v{10, 20, 30};
+
+        auto view = v.view();
+        CPPUNIT_ASSERT_EQUAL(static_cast<ArrayView<int>::size_type>(3), view.size());
+
+        view[0] = 11;
+        CPPUNIT_ASSERT_EQUAL(11, v[0]);
+
+        const auto& constV = v;
+        auto constView = constV.view();
+        CPPUNIT_ASSERT_EQUAL(11, constView[0]);
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestStaticVector);
@@ -20,6 +20,7 @@
  *
  ******************************************************************************/
 #include <solace/string.hpp>  // Class being tested
+#include <solace/writeBuffer.hpp>
 #include <solace/exception.hpp>
 
 #include <cppunit/extensions/HelperMacros.h>
@@ -42,7 +43,10 @@ class TestString : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testIndexOf);
         CPPUNIT_TEST(testLastIndexOf);
         CPPUNIT_TEST(testConcat);
-        CPPUNIT_TEST(testSubstring);
+        CPPUNIT_TEST(testVariadicConcat);
+        CPPUNIT_TEST(testJoinViews);
+        CPPUNIT_TEST(testSubstring);
+        CPPUNIT_TEST(testViewFamily);
         CPPUNIT_TEST(testTrim);
         CPPUNIT_TEST(testToLowerCase);
         CPPUNIT_TEST(testToUpperCase);
@@ -337,6 +341,54 @@ public:
         CPPUNIT_ASSERT_EQUAL(target, hello.concat(", world!"));
 	}
 
+    /**
+     * @see Solace::concat
+     */
+    void testVariadicConcat() {
+        const String hello("Hello");
+        const String target("Hello, world!");
+
+        // Mixed fragment types fuse in a single pass:
+        CPPUNIT_ASSERT_EQUAL(target, concat(hello, StringView(", "), "world!"));
+
+        // A fused chain matches the equivalent concat() chain:
+        CPPUNIT_ASSERT_EQUAL(hello.concat(", ").concat("world!"), concat(hello, ", ", "world!"));
+
+        CPPUNIT_ASSERT_EQUAL(String("x"), concat("", String::Empty, StringView("x"), ""));
+        CPPUNIT_ASSERT_EQUAL(String::Empty, concat("", ""));
+
+        // Results past the small-string threshold spill to the heap intact:
+        const String quarter("0123456789012345");
+        const auto spilled = concat(quarter, quarter, quarter, quarter);
+        CPPUNIT_ASSERT_EQUAL(static_cast<String::size_type>(64), spilled.length());
+        CPPUNIT_ASSERT(spilled.startsWith(quarter));
+        CPPUNIT_ASSERT(spilled.endsWith(quarter));
+    }
+
+    /**
+     * @see String::join
+     */
+    void testJoinViews() {
+        StringView fields[] = {StringView("id"), StringView("name"), StringView("email")};
+
+        CPPUNIT_ASSERT_EQUAL(String("id,name,email"), String::join(StringView(","), arrayView(fields)));
+        CPPUNIT_ASSERT_EQUAL(String("id"), String::join(StringView(","), ArrayView<StringView>(fields, 1)));
+        CPPUNIT_ASSERT_EQUAL(String::Empty, String::join(StringView(","), ArrayView<StringView>()));
+
+        // The WriteBuffer variant emits the same bytes, no String materialized:
+        byte store[32];
+        WriteBuffer dest(wrapMemory(store));
+        CPPUNIT_ASSERT(String::join(dest, StringView(","), arrayView(fields)).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(13), dest.position());
+        CPPUNIT_ASSERT(memcmp(store, "id,name,email", 13) == 0);
+
+        // A destination too small for the whole row fails without writing:
+        byte tiny[4];
+        WriteBuffer small(wrapMemory(tiny));
+        CPPUNIT_ASSERT(String::join(small, StringView(","), arrayView(fields)).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(0), small.position());
+    }
+
     /**
      * @see String::substring
      */
@@ -353,6 +405,39 @@ public:
                              source.substring(source.indexOf("Good").get(), 1042));
 	}
 
+    /**
+     * @see String::substringView
+     * @see String::splitView
+     */
+    void testViewFamily() {
+        const String source("boo:and:foo");
+
+        {   // A substring view aliases the source bytes - no copy:
+            const auto mid = source.substringView(4, 3);
+            CPPUNIT_ASSERT(mid.equals("and"));
+            CPPUNIT_ASSERT(mid.data() == source.c_str() + 4);
+
+            CPPUNIT_ASSERT(source.substringView(8).equals("foo"));
+        }
+
+        {   // Split to views: only the array is allocated, never the text.
+            const auto result = source.splitView(':');
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<array_size_t>(3), result.size());
+            CPPUNIT_ASSERT(result[0].equals("boo"));
+            CPPUNIT_ASSERT(result[1].equals("and"));
+            CPPUNIT_ASSERT(result[2].equals("foo"));
+            CPPUNIT_ASSERT(result[1].data() == source.c_str() + 4);
+        }
+
+        {   // The string-delimiter flavour, unlike split(), is not a RegExp:
+            const auto result = source.splitView(StringView(":"));
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<array_size_t>(3), result.size());
+            CPPUNIT_ASSERT(result[1].equals("and"));
+        }
+    }
+
 	/**
      * @see String::trim
      */
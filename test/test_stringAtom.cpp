@@ -0,0 +1,85 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ *	@file		test/test_stringAtom.cpp
+ ******************************************************************************/
+#include <solace/stringAtom.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+using namespace Solace;
+
+class TestStringAtom : public CppUnit::TestFixture  {
+
+CPPUNIT_TEST_SUITE(TestStringAtom);
+        CPPUNIT_TEST(testEmptyAtom);
+        CPPUNIT_TEST(testInterningIsIdempotent);
+        CPPUNIT_TEST(testDistinctStringsGetDistinctAtoms);
+        CPPUNIT_TEST(testViewRoundTrip);
+        CPPUNIT_TEST(testHashCodeMatchesString);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testEmptyAtom() {
+        StringAtom def;
+        CPPUNIT_ASSERT(def.empty());
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringAtom::id_type>(0), def.id());
+        CPPUNIT_ASSERT(def == StringAtom::intern(StringView()));
+        CPPUNIT_ASSERT(def.view().empty());
+    }
+
+    void testInterningIsIdempotent() {
+        const auto a = StringAtom::intern(StringView("some-channel-name"));
+        const auto b = StringAtom::intern(StringView("some-channel-name"));
+        const auto c = StringAtom::intern(String("some-channel-name"));
+
+        CPPUNIT_ASSERT(a == b);
+        CPPUNIT_ASSERT(a == c);
+        CPPUNIT_ASSERT_EQUAL(a.id(), b.id());
+    }
+
+    void testDistinctStringsGetDistinctAtoms() {
+        const auto a = StringAtom::intern(StringView("metric.requests"));
+        const auto b = StringAtom::intern(StringView("metric.responses"));
+
+        CPPUNIT_ASSERT(a != b);
+    }
+
+    void testViewRoundTrip() {
+        const auto atom = StringAtom::intern(StringView("round-trip-me"));
+
+        CPPUNIT_ASSERT_EQUAL(StringView("round-trip-me"), atom.view());
+
+        // Views are stable: interning more strings must not invalidate them.
+        const auto dataBefore = atom.view().data();
+        for (int i = 0; i < 2000; ++i) {
+            StringAtom::intern(String::valueOf(i).view());
+        }
+        CPPUNIT_ASSERT_EQUAL(dataBefore, atom.view().data());
+    }
+
+    void testHashCodeMatchesString() {
+        const StringView value("hash-me-once");
+        const auto atom = StringAtom::intern(value);
+
+        CPPUNIT_ASSERT_EQUAL(value.hashCode(), atom.hashCode());
+    }
+
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestStringAtom);
@@ -37,6 +37,9 @@ class TestStringBuilder: public CppUnit::TestFixture  {
         CPPUNIT_TEST(testConstruction);
         CPPUNIT_TEST(testNullString);
         CPPUNIT_TEST(testToString);
+        CPPUNIT_TEST(testTakeString);
+        CPPUNIT_TEST(testGrowth);
+        CPPUNIT_TEST(testNumericAppend);
     CPPUNIT_TEST_SUITE_END();
 
 private:
@@ -120,6 +123,83 @@ public:
         CPPUNIT_ASSERT_EQUAL(String(someConstString), str);
     }
 
+    void testTakeString() {
+        const StringView longContent("content long enough to spill out of the in-place string storage");
+
+        // Owned storage with spare room transfers into the string - same bytes:
+        {
+            StringBuilder builder(_memoryManager, 128);
+            builder.append(longContent);
+
+            const void* contentAddress = builder.view().data();
+            const auto str = builder.takeString();
+
+            CPPUNIT_ASSERT_EQUAL(String(longContent), str);
+            CPPUNIT_ASSERT(static_cast<const void*>(str.c_str()) == contentAddress);
+
+            // The builder is left empty and re-grows on the next append:
+            CPPUNIT_ASSERT(builder.empty());
+            builder.append("once more");
+            CPPUNIT_ASSERT_EQUAL(String("once more"), builder.takeString());
+        }
+
+        // Non-owned storage is copied, never adopted:
+        {
+            byte stack[128];
+            StringBuilder builder(wrapMemory(stack));
+            builder.append(longContent);
+
+            const auto str = builder.takeString();
+            CPPUNIT_ASSERT_EQUAL(String(longContent), str);
+            CPPUNIT_ASSERT(static_cast<const void*>(str.c_str()) != static_cast<const void*>(stack));
+        }
+
+        // An empty builder yields the empty string:
+        CPPUNIT_ASSERT_EQUAL(String::Empty, StringBuilder(_memoryManager, 16).takeString());
+    }
+
+    /**
+     * Test growable builder storage management
+     * @see StringBuilder::reserve
+     */
+    void testGrowth() {
+        StringBuilder sb(_memoryManager, 8);
+
+        for (int i = 0; i < 16; ++i) {
+            sb.append(StringView("0123456789"));
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringBuilder::size_type>(160), sb.length());
+        CPPUNIT_ASSERT(sb.capacity() >= 160);
+        CPPUNIT_ASSERT(sb.toString().startsWith(String("01234567890123456789")));
+
+        sb.reserve(512);
+        CPPUNIT_ASSERT(sb.capacity() >= 512);
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringBuilder::size_type>(160), sb.length());
+
+        // A fixed-storage builder must not silently grow
+        StringBuilder fixed(_memoryManager.create(4));
+        CPPUNIT_ASSERT_THROW(fixed.reserve(64), Exception);
+    }
+
+    /**
+     * Test direct numeric value formatting
+     * @see StringBuilder::append
+     */
+    void testNumericAppend() {
+        StringBuilder sb(_memoryManager, 16);
+
+        sb.append(static_cast<int64>(-42))
+          .append(':')
+          .append(static_cast<uint64>(18446744073709551615ULL))
+          .append(':')
+          .append(static_cast<int64>(0))
+          .append(':')
+          .append(static_cast<float64>(0.25));
+
+        CPPUNIT_ASSERT_EQUAL(String("-42:18446744073709551615:0:0.25"), sb.toString());
+    }
+
 };
 
 const char* TestStringBuilder::someConstString = "Some static string";
@@ -26,6 +26,7 @@
 
 
 #include <cstring>
+#include <vector>
 
 using namespace Solace;
 
@@ -39,17 +40,23 @@ CPPUNIT_TEST_SUITE(TestStringView);
         CPPUNIT_TEST(testAssignment);
         CPPUNIT_TEST(testAssignmentFromCstring);
         CPPUNIT_TEST(testEquality);
+        CPPUNIT_TEST(testComparisonFastPaths);
         CPPUNIT_TEST(testLength);
         CPPUNIT_TEST(testContains);
         CPPUNIT_TEST(testIndexOf);
         CPPUNIT_TEST(testLastIndexOf);
         CPPUNIT_TEST(testSubstring);
         CPPUNIT_TEST(testTrim);
+        CPPUNIT_TEST(testCaseConversion);
         CPPUNIT_TEST(testStartsWith);
         CPPUNIT_TEST(testEndsWith);
+        CPPUNIT_TEST(testSpanOfClass);
         CPPUNIT_TEST(testHashCode);
+        CPPUNIT_TEST(testSeededHashCode);
         CPPUNIT_TEST(testSplitByChar);
         CPPUNIT_TEST(testSplitByStringToken);
+        CPPUNIT_TEST(testSplitByCharCallback);
+        CPPUNIT_TEST(testSplitByStringTokenCallback);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -143,6 +150,44 @@ public:
         CPPUNIT_ASSERT(value3 == value1);
     }
 
+    /**
+     * Equality and ordering decide most cases inline on length and a prefix
+     * word; make sure values that survive those pre-checks still compare by
+     * their full contents.
+     */
+    void testComparisonFastPaths() {
+        // Same length, same first 8 bytes, difference only past the prefix word:
+        StringView longA("/api/v2/orders/123");
+        StringView longB("/api/v2/orders/124");
+        StringView longC("/api/v2/orders/123");
+
+        CPPUNIT_ASSERT(!longA.equals(longB));
+        CPPUNIT_ASSERT(longA.equals(longC));
+        CPPUNIT_ASSERT(longA.compareTo(longB) < 0);
+        CPPUNIT_ASSERT(longB.compareTo(longA) > 0);
+        CPPUNIT_ASSERT_EQUAL(0, longA.compareTo(longC));
+
+        // Views under a word long still compare correctly:
+        CPPUNIT_ASSERT(StringView("cat").equals("cat"));
+        CPPUNIT_ASSERT(!StringView("cat").equals("car"));
+        CPPUNIT_ASSERT(StringView("cat").compareTo("car") > 0);
+
+        // One a strict prefix of the other orders by length:
+        CPPUNIT_ASSERT(StringView("/api").compareTo("/api/v2") < 0);
+        CPPUNIT_ASSERT(StringView("/api/v2").compareTo("/api") > 0);
+
+        // Empty views:
+        CPPUNIT_ASSERT(StringView().equals(StringView()));
+        CPPUNIT_ASSERT_EQUAL(0, StringView().compareTo(StringView()));
+        CPPUNIT_ASSERT(StringView().compareTo("a") < 0);
+        CPPUNIT_ASSERT(StringView("a").compareTo(StringView()) > 0);
+
+        // Ordering is by unsigned byte value, a-la memcmp:
+        const char high[] = {static_cast<char>(0xE2), '\0'};
+        CPPUNIT_ASSERT(StringView("a").compareTo(high) < 0);
+        CPPUNIT_ASSERT(StringView(high).compareTo("a") > 0);
+    }
+
     /**
      * @see StringView::length
      */
@@ -180,6 +225,30 @@ public:
                        .endsWith("Some very long statement that can't possibly"));
     }
 
+    /**
+     * @see StringView::spanOfClass
+     */
+    void testSpanOfClass() {
+        const StringView text("  count_1 = 0x1Faf42;");
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(2), text.spanOfWhitespace());
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(5), text.spanOfLetters(2));
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(7), text.spanOfClass(Char::Symbol, 2));
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(1), text.spanOfDigits(8));
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(6), text.spanOfXDigits(14));
+
+        // No run starts on a non-matching character:
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(0), text.spanOfDigits());
+
+        // ... nor at or past the end of the view:
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(0), text.spanOfDigits(text.size()));
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(0), StringView().spanOfLetters());
+
+        // Class masks combine so mixed runs are consumed in one call:
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(5),
+                             StringView("\t \n42x").spanOfClass(Char::Whitespace | Char::Digit));
+    }
+
     /**
      * @see StringView::substring
      */
@@ -230,6 +299,30 @@ public:
 
         // Trim End
         CPPUNIT_ASSERT(StringView("Hello, world!  ").trim().equals("Hello, world!"));
+
+        // Long whitespace runs exercising the bulk scan
+        CPPUNIT_ASSERT(StringView("                     Hello                     ").trim().equals("Hello"));
+    }
+
+
+    /**
+     * @see StringView::toLowerCase
+     * @see StringView::toUpperCase
+     */
+    void testCaseConversion() {
+        char buffer[64];
+
+        const StringView src("Content-Type: Application/JSON");
+        CPPUNIT_ASSERT(src.toLowerCase(wrapMemory(buffer, sizeof(buffer)))
+                       .equals("content-type: application/json"));
+
+        // Conversion may run in-place over the destination of a previous one:
+        CPPUNIT_ASSERT(StringView(buffer, src.size()).toUpperCase(wrapMemory(buffer, sizeof(buffer)))
+                       .equals("CONTENT-TYPE: APPLICATION/JSON"));
+
+        // A destination too small for the string is an error:
+        char tiny[4];
+        CPPUNIT_ASSERT_THROW(src.toLowerCase(wrapMemory(tiny, sizeof(tiny))), OverflowException);
     }
 
 
@@ -312,6 +405,32 @@ public:
 
         CPPUNIT_ASSERT(StringView("Hello otu there").hashCode() !=
                        StringView("Hello out there").hashCode());
+
+        // Hashing of literals happens entirely at compile time:
+        static_assert(StringView("Hello").hashCode() != StringView("olleH").hashCode(),
+                      "hashCode is usable in a constant expression");
+    }
+
+    void testSeededHashCode() {
+        // Equal strings agree under a shared seed; the seed matters:
+        CPPUNIT_ASSERT_EQUAL(StringView("request-key").hashCode(42),
+                             StringView("request-key").hashCode(42));
+        CPPUNIT_ASSERT(StringView("request-key").hashCode(42) !=
+                       StringView("request-key").hashCode(43));
+        CPPUNIT_ASSERT(StringView("request-key").hashCode(42) !=
+                       StringView("another-key").hashCode(42));
+
+        // Every 8-byte lane and the tail feed the hash:
+        CPPUNIT_ASSERT(StringView("0123456789abcdef").hashCode(1) !=
+                       StringView("0123456789abcdeg").hashCode(1));
+        CPPUNIT_ASSERT(StringView("0123456789abcdef0").hashCode(1) !=
+                       StringView("0123456789abcdef1").hashCode(1));
+        CPPUNIT_ASSERT(StringView("").hashCode(5) !=
+                       StringView("x").hashCode(5));
+
+        // Still a constant expression when the seed is one:
+        static_assert(StringView("Hello").hashCode(9) != StringView("olleH").hashCode(9),
+                      "seeded hashCode is usable in a constant expression");
     }
 
     void testSplitByChar() {
@@ -370,6 +489,65 @@ public:
 
     }
 
+    void testSplitByCharCallback() {
+        {   // Normal split
+            std::vector<StringView> tokens;
+            StringView("boo:and:foo").split(':', [&tokens](StringView token) {
+                tokens.push_back(token);
+            });
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), tokens.size());
+            CPPUNIT_ASSERT_EQUAL(StringView("boo"), tokens[0]);
+            CPPUNIT_ASSERT_EQUAL(StringView("and"), tokens[1]);
+            CPPUNIT_ASSERT_EQUAL(StringView("foo"), tokens[2]);
+        }
+
+        {   // Empty tokens are preserved, matching the Array returning overload
+            std::vector<StringView> tokens;
+            StringView("boo::foo:").split(':', [&tokens](StringView token) {
+                tokens.push_back(token);
+            });
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), tokens.size());
+            CPPUNIT_ASSERT_EQUAL(StringView("boo"), tokens[0]);
+            CPPUNIT_ASSERT_EQUAL(StringView(),      tokens[1]);
+            CPPUNIT_ASSERT_EQUAL(StringView("foo"), tokens[2]);
+            CPPUNIT_ASSERT_EQUAL(StringView(),      tokens[3]);
+        }
+
+        {   // Splitting an empty string yields a single empty token
+            size_t count = 0;
+            StringView().split('x', [&count](StringView token) {
+                CPPUNIT_ASSERT(token.empty());
+                ++count;
+            });
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), count);
+        }
+    }
+
+    void testSplitByStringTokenCallback() {
+        std::vector<StringView> tokens;
+        StringView("1::2::3").split(StringView("::"), [&tokens](StringView token) {
+            tokens.push_back(token);
+        });
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(3), tokens.size());
+        CPPUNIT_ASSERT_EQUAL(StringView("1"), tokens[0]);
+        CPPUNIT_ASSERT_EQUAL(StringView("2"), tokens[1]);
+        CPPUNIT_ASSERT_EQUAL(StringView("3"), tokens[2]);
+
+        {   // No splitting token in the string
+            size_t count = 0;
+            StringView("boo").split(StringView("other"), [&count](StringView token) {
+                CPPUNIT_ASSERT_EQUAL(StringView("boo"), token);
+                ++count;
+            });
+
+            CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(1), count);
+        }
+    }
+
     void testSplitByStringToken() {
         // Splitting empty string gives you 1 item in a collection - empty string
         CPPUNIT_ASSERT_EQUAL(static_cast<array_size_t>(1),
@@ -0,0 +1,113 @@
+/*
+*  Copyright 2016 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_timestamp.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/timestamp.hpp>  // Class being tested
+
+#include <solace/writeBuffer.hpp>
+#include <solace/stringBuilder.hpp>
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+
+
+using namespace Solace;
+
+
+class TestTimestamp : public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestTimestamp);
+        CPPUNIT_TEST(testArithmetic);
+        CPPUNIT_TEST(testClocksAdvance);
+        CPPUNIT_TEST(testFastClockTracksRealtime);
+        CPPUNIT_TEST(testIso8601KnownValue);
+        CPPUNIT_TEST(testIso8601Overflow);
+        CPPUNIT_TEST(testIso8601StringBuilder);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testArithmetic() {
+        const Timestamp a{3 * Timestamp::NanosInSecond + 250};
+        CPPUNIT_ASSERT_EQUAL(static_cast<int64>(3), a.seconds());
+        CPPUNIT_ASSERT_EQUAL(static_cast<int64>(250), a.nanosOfSecond());
+
+        const auto b = a + 1000;
+        CPPUNIT_ASSERT(a < b);
+        CPPUNIT_ASSERT_EQUAL(static_cast<int64>(1000), b - a);
+    }
+
+    void testClocksAdvance() {
+        const auto first = Clock::monotonic();
+        const auto second = Clock::monotonic();
+        CPPUNIT_ASSERT(first <= second);
+
+        CPPUNIT_ASSERT(Clock::realtime().nanos > 0);
+    }
+
+    void testFastClockTracksRealtime() {
+        Clock::recalibrate();
+
+        const auto fast = Clock::now();
+        const auto real = Clock::realtime();
+
+        // The extrapolated reading stays within a generous 50ms of the
+        // real clock even on a loaded box:
+        const auto drift = real - fast;
+        CPPUNIT_ASSERT(drift > -50 * 1000000 && drift < 50 * 1000000);
+    }
+
+    void testIso8601KnownValue() {
+        // 2016-06-20T07:31:56.123456789 UTC:
+        const Timestamp moment{1466407916 * Timestamp::NanosInSecond + 123456789};
+
+        byte mem[64];
+        WriteBuffer dest(wrapMemory(mem));
+        CPPUNIT_ASSERT(moment.formatIso8601(dest).isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(Timestamp::Iso8601Size), dest.position());
+
+        const char* expected = "2016-06-20T07:31:56.123456789Z";
+        CPPUNIT_ASSERT_EQUAL(0, memcmp(expected, mem, Timestamp::Iso8601Size));
+
+        // Epoch itself:
+        WriteBuffer epochDest(wrapMemory(mem));
+        CPPUNIT_ASSERT(Timestamp{0}.formatIso8601(epochDest).isOk());
+        CPPUNIT_ASSERT_EQUAL(0, memcmp("1970-01-01T00:00:00.000000000Z", mem, Timestamp::Iso8601Size));
+    }
+
+    void testIso8601Overflow() {
+        byte mem[8];
+        WriteBuffer tight(wrapMemory(mem));
+
+        CPPUNIT_ASSERT(Timestamp{0}.formatIso8601(tight).isError());
+    }
+
+    void testIso8601StringBuilder() {
+        byte mem[64];
+        StringBuilder dest(wrapMemory(mem));
+
+        const Timestamp moment{1466407916 * Timestamp::NanosInSecond};
+        moment.formatIso8601(dest);
+
+        CPPUNIT_ASSERT(dest.toString().equals("2016-06-20T07:31:56.000000000Z"));
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestTimestamp);
@@ -0,0 +1,153 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_unicode.cpp
+ * @author: soultaker
+*******************************************************************************/
+#include <solace/unicode.hpp>  // Module being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+#include <cstring>
+#include <string>
+
+
+using namespace Solace;
+using namespace Solace::unicode;
+
+
+class TestUnicode: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestUnicode);
+        CPPUNIT_TEST(testUtf16RoundTrip);
+        CPPUNIT_TEST(testUtf32RoundTrip);
+        CPPUNIT_TEST(testAsciiBulkPath);
+        CPPUNIT_TEST(testMalformedInputFailsTheCall);
+        CPPUNIT_TEST(testDestinationTooSmall);
+    CPPUNIT_TEST_SUITE_END();
+
+    // ASCII + 2-, 3- and 4-byte sequences: "Hello, (c) <CJK> <emoji>!"
+    static constexpr const char* kMixed = "Hello, \xC2\xA9 \xE4\xB8\xAD\xE6\x96\x87 \xF0\x9F\x98\x80!";
+
+    static ImmutableMemoryView viewOf(const char* text) {
+        return wrapMemory(const_cast<char*>(text), strlen(text));
+    }
+
+public:
+
+    void testUtf16RoundTrip() {
+        byte utf16[128];
+        auto encoded = utf8ToUtf16(viewOf(kMixed), wrapMemory(utf16));
+        CPPUNIT_ASSERT(encoded.isOk());
+
+        // Verify against the compiler-produced encoding, surrogate pair and all:
+        const char16_t* reference = u"Hello, © 中文 \U0001F600!";
+        size_t nbUnits = 0;
+        while (reference[nbUnits]) { ++nbUnits; }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(nbUnits * 2), encoded.unwrap());
+        CPPUNIT_ASSERT(memcmp(utf16, reference, encoded.unwrap()) == 0);
+
+        byte utf8[128];
+        auto decoded = utf16ToUtf8(wrapMemory(utf16, encoded.unwrap()), wrapMemory(utf8));
+        CPPUNIT_ASSERT(decoded.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(strlen(kMixed)), decoded.unwrap());
+        CPPUNIT_ASSERT(memcmp(utf8, kMixed, decoded.unwrap()) == 0);
+
+        // Empty input is a zero-length success:
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(0),
+                             utf8ToUtf16(ImmutableMemoryView(), wrapMemory(utf16)).unwrap());
+    }
+
+    void testUtf32RoundTrip() {
+        byte utf32[256];
+        auto encoded = utf8ToUtf32(viewOf(kMixed), wrapMemory(utf32));
+        CPPUNIT_ASSERT(encoded.isOk());
+
+        const char32_t* reference = U"Hello, © 中文 \U0001F600!";
+        size_t nbPoints = 0;
+        while (reference[nbPoints]) { ++nbPoints; }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(nbPoints * 4), encoded.unwrap());
+        CPPUNIT_ASSERT(memcmp(utf32, reference, encoded.unwrap()) == 0);
+
+        byte utf8[128];
+        auto decoded = utf32ToUtf8(wrapMemory(utf32, encoded.unwrap()), wrapMemory(utf8));
+        CPPUNIT_ASSERT(decoded.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(strlen(kMixed)), decoded.unwrap());
+        CPPUNIT_ASSERT(memcmp(utf8, kMixed, decoded.unwrap()) == 0);
+    }
+
+    void testAsciiBulkPath() {
+        // A run long enough to take the vectorised path, with a multi-byte tail:
+        std::string ascii(1000, 'x');
+        ascii += "\xC3\xA9";
+
+        byte utf16[2048];
+        auto encoded = utf8ToUtf16(wrapMemory(&ascii[0], ascii.size()), wrapMemory(utf16));
+        CPPUNIT_ASSERT(encoded.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(1001 * 2), encoded.unwrap());
+
+        byte utf8[2048];
+        auto decoded = utf16ToUtf8(wrapMemory(utf16, encoded.unwrap()), wrapMemory(utf8));
+        CPPUNIT_ASSERT(decoded.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_type>(ascii.size()), decoded.unwrap());
+        CPPUNIT_ASSERT(memcmp(utf8, ascii.data(), ascii.size()) == 0);
+    }
+
+    void testMalformedInputFailsTheCall() {
+        byte dest[64];
+
+        // Fused validation: malformed input errors, no replacement characters.
+        char overlong[] = "ab\xC0\xAF";
+        CPPUNIT_ASSERT(utf8ToUtf16(wrapMemory(overlong, 4), wrapMemory(dest)).isError());
+        CPPUNIT_ASSERT(utf8ToUtf32(wrapMemory(overlong, 4), wrapMemory(dest)).isError());
+
+        char truncated[] = "abc\xE2\x82";
+        CPPUNIT_ASSERT(utf8ToUtf16(wrapMemory(truncated, 5), wrapMemory(dest)).isError());
+
+        byte loneHigh[2] = { 0x00, 0xD8 };      // U+D800 in native little-endian
+        CPPUNIT_ASSERT(utf16ToUtf8(wrapMemory(loneHigh), wrapMemory(dest)).isError());
+
+        byte loneLow[2] = { 0x00, 0xDC };       // Low surrogate cannot lead
+        CPPUNIT_ASSERT(utf16ToUtf8(wrapMemory(loneLow), wrapMemory(dest)).isError());
+
+        byte oddInput[3] = { 'a', 0, 'b' };     // Not a whole number of units
+        CPPUNIT_ASSERT(utf16ToUtf8(wrapMemory(oddInput), wrapMemory(dest)).isError());
+
+        uint32 outOfRange = 0x110000;
+        CPPUNIT_ASSERT(utf32ToUtf8(wrapMemory(&outOfRange, 4), wrapMemory(dest)).isError());
+
+        uint32 surrogate = 0xD800;
+        CPPUNIT_ASSERT(utf32ToUtf8(wrapMemory(&surrogate, 4), wrapMemory(dest)).isError());
+    }
+
+    void testDestinationTooSmall() {
+        byte tiny[4];
+
+        CPPUNIT_ASSERT(utf8ToUtf16(viewOf(kMixed), wrapMemory(tiny)).isError());
+        CPPUNIT_ASSERT(utf8ToUtf32(viewOf(kMixed), wrapMemory(tiny)).isError());
+
+        // The worst-case helpers always provide enough room:
+        const auto nbBytes = static_cast<size_type>(strlen(kMixed));
+        byte dest16[utf16CapacityFor(64)];
+        CPPUNIT_ASSERT(utf16CapacityFor(nbBytes) <= sizeof(dest16));
+        CPPUNIT_ASSERT(utf8ToUtf16(viewOf(kMixed), wrapMemory(dest16)).isOk());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestUnicode);
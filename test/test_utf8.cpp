@@ -0,0 +1,87 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace Unit Test Suit
+ * @file: test/test_utf8.cpp
+ * @brief: Unit tests of UTF-8 validation and code point iteration
+ *******************************************************************************/
+#include <solace/utf8.hpp>  // Class being tested
+
+#include <cppunit/extensions/HelperMacros.h>
+
+
+using namespace Solace;
+
+
+class TestUtf8: public CppUnit::TestFixture  {
+
+    CPPUNIT_TEST_SUITE(TestUtf8);
+        CPPUNIT_TEST(testValidInput);
+        CPPUNIT_TEST(testMalformedInput);
+        CPPUNIT_TEST(testCursorDecoding);
+        CPPUNIT_TEST(testCursorResyncOnMalformedInput);
+    CPPUNIT_TEST_SUITE_END();
+
+public:
+
+    void testValidInput() {
+        CPPUNIT_ASSERT(isValidUtf8(StringView("")));
+        CPPUNIT_ASSERT(isValidUtf8(StringView("Hello there")));
+
+        // Long enough an ASCII run to take the bulk scan path:
+        CPPUNIT_ASSERT(isValidUtf8(StringView("0123456789012345678901234567890123456789")));
+
+        CPPUNIT_ASSERT(isValidUtf8(StringView("\xC3\xA9t\xC3\xA9")));       // 2-byte sequences
+        CPPUNIT_ASSERT(isValidUtf8(StringView("\xE2\x82\xAC" "42")));       // 3-byte sequence
+        CPPUNIT_ASSERT(isValidUtf8(StringView("\xF0\x9F\x98\x80")));        // 4-byte sequence
+    }
+
+    void testMalformedInput() {
+        CPPUNIT_ASSERT(!isValidUtf8(StringView("\xC0\xAF")));               // Overlong 2-byte '/'
+        CPPUNIT_ASSERT(!isValidUtf8(StringView("\xE0\x80\xAF")));           // Overlong 3-byte
+        CPPUNIT_ASSERT(!isValidUtf8(StringView("\xF0\x80\x80\xAF")));       // Overlong 4-byte
+        CPPUNIT_ASSERT(!isValidUtf8(StringView("\xED\xA0\x80")));           // Surrogate U+D800
+        CPPUNIT_ASSERT(!isValidUtf8(StringView("\xF4\x90\x80\x80")));       // Above U+10FFFF
+        CPPUNIT_ASSERT(!isValidUtf8(StringView("\x80")));                   // Stray continuation
+        CPPUNIT_ASSERT(!isValidUtf8(StringView("abc\xC3")));                // Truncated sequence
+        CPPUNIT_ASSERT(!isValidUtf8(StringView("0123456789012345\xC3")));   // Truncated past the bulk scan
+    }
+
+    void testCursorDecoding() {
+        Utf8Cursor cursor(StringView("a\xC3\xA9\xE2\x82\xAC\xF0\x9F\x98\x80"));
+        const Char::value_type expected[] = {0x61, 0xE9, 0x20AC, 0x1F600};
+
+        size_t i = 0;
+        while (cursor.hasNext()) {
+            CPPUNIT_ASSERT(i < 4);
+            CPPUNIT_ASSERT_EQUAL(expected[i], cursor.next().getValue());
+            ++i;
+        }
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<size_t>(4), i);
+        CPPUNIT_ASSERT_EQUAL(static_cast<Utf8Cursor::size_type>(10), cursor.offset());
+    }
+
+    void testCursorResyncOnMalformedInput() {
+        Utf8Cursor cursor(StringView("\xFFz"));
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<Char::value_type>(0xFFFD), cursor.next().getValue());
+        CPPUNIT_ASSERT_EQUAL(static_cast<Char::value_type>('z'), cursor.next().getValue());
+        CPPUNIT_ASSERT(!cursor.hasNext());
+    }
+};
+
+CPPUNIT_TEST_SUITE_REGISTRATION(TestUtf8);
@@ -22,6 +22,7 @@
 *******************************************************************************/
 #include <solace/uuid.hpp>			// Class being tested
 #include <solace/array.hpp>
+#include <solace/byteBuffer.hpp>
 #include <solace/exception.hpp>
 
 
@@ -38,12 +39,16 @@ class TestUUID : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testStaticConstraints);
         CPPUNIT_TEST(testConstruction);
         CPPUNIT_TEST(testRandom);
+        CPPUNIT_TEST(testRandomize);
+        CPPUNIT_TEST(testTimeOrdered);
 
         CPPUNIT_TEST(testComparable);
         CPPUNIT_TEST(testIterable);
 
         CPPUNIT_TEST(testFormattable);
         CPPUNIT_TEST(testParsable);
+        CPPUNIT_TEST(testFormatToBuffer);
+        CPPUNIT_TEST(testFormatInto);
 
         CPPUNIT_TEST(testParsing_and_ToString_are_consistent);
         CPPUNIT_TEST(testContainerReq);
@@ -77,6 +82,68 @@ public:
         }
     }
 
+    void testRandomize() {
+        UUID ids[RandomSampleSize];
+        UUID::randomize(arrayView(ids));
+
+        for (uint i = 0; i < RandomSampleSize; ++i) {
+            // Version 4, RFC 4122 variant:
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x40), static_cast<byte>(ids[i][6] & 0xF0));
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x80), static_cast<byte>(ids[i][8] & 0xC0));
+
+            for (uint j = i + 1; j < RandomSampleSize; ++j) {
+                CPPUNIT_ASSERT(ids[i] != ids[j]);
+            }
+        }
+    }
+
+    void testTimeOrdered() {
+        UUID ids[RandomSampleSize];
+        for (auto& id : ids) {
+            id = UUID::timeOrdered();
+        }
+
+        for (uint i = 0; i < RandomSampleSize; ++i) {
+            // Version 7, RFC 4122 variant:
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x70), static_cast<byte>(ids[i][6] & 0xF0));
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x80), static_cast<byte>(ids[i][8] & 0xC0));
+        }
+
+        // Ids minted by one process sort by creation order:
+        for (uint i = 1; i < RandomSampleSize; ++i) {
+            CPPUNIT_ASSERT(ids[i - 1] < ids[i]);
+        }
+    }
+
+    void testFormatToBuffer() {
+        const UUID id({0x12, 0x3e, 0x45, 0x67, 0xe8, 0x9b, 0x12, 0xd3,
+                       0xa4, 0x56, 0x42, 0x66, 0x55, 0x44, 0x0, 0x0});
+
+        byte store[UUID::StringSize];
+        ByteBuffer buffer(wrapMemory(store));
+
+        id.format(buffer);
+        CPPUNIT_ASSERT_EQUAL(static_cast<ByteBuffer::size_type>(UUID::StringSize), buffer.position());
+        CPPUNIT_ASSERT_EQUAL(id.toString(),
+                             String(reinterpret_cast<const char*>(store), UUID::StringSize));
+    }
+
+    void testFormatInto() {
+        const UUID id({0x12, 0x3e, 0x45, 0x67, 0xe8, 0x9b, 0x12, 0xd3,
+                       0xa4, 0x56, 0x42, 0x66, 0x55, 0x44, 0x0, 0x0});
+
+        char store[UUID::StringSize];
+        const auto formatted = id.formatInto(wrapMemory(store));
+        CPPUNIT_ASSERT(formatted.isOk());
+        CPPUNIT_ASSERT_EQUAL(static_cast<StringView::size_type>(UUID::StringSize),
+                             formatted.unwrap().size());
+        CPPUNIT_ASSERT(id.toString().view().equals(formatted.unwrap()));
+
+        // A destination too small for the canonical form is an error:
+        char tiny[UUID::StringSize - 1];
+        CPPUNIT_ASSERT(id.formatInto(wrapMemory(tiny)).isError());
+    }
+
     void testConstruction() {
 
         // Random UUID using default constructor
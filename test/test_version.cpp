@@ -40,6 +40,11 @@ class TestVersion : public CppUnit::TestFixture  {
         CPPUNIT_TEST(testParsing);
         CPPUNIT_TEST(testParsing_and_ToString_are_consistent);
         CPPUNIT_TEST(testContainerReq);
+        CPPUNIT_TEST(testPackedEncoding);
+        CPPUNIT_TEST(testPackedParsing);
+        CPPUNIT_TEST(testRangeParsing);
+        CPPUNIT_TEST(testRangeMembership);
+        CPPUNIT_TEST(testRangeBatchSweep);
 	CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -321,6 +326,116 @@ public:
 
     }
 
+    /**
+     * Test that the packed 64-bit encoding orders like the versions it encodes
+     */
+    void testPackedEncoding() {
+        const Version a(1, 2, 3);
+        const Version b(1, 2, 4);
+        const Version c(2, 0, 0);
+
+        CPPUNIT_ASSERT(a.isPackable());
+        CPPUNIT_ASSERT(a.packed() < b.packed());
+        CPPUNIT_ASSERT(b.packed() < c.packed());
+        CPPUNIT_ASSERT((b > a) == (b.packed() > a.packed()));
+
+        // A pre-release version does not fit the packed encoding:
+        CPPUNIT_ASSERT_EQUAL(false, Version(1, 2, 3, "rc.1").isPackable());
+
+        const auto restored = Version::fromPacked(Version::pack(3, 14, 159));
+        CPPUNIT_ASSERT_EQUAL(Version(3, 14, 159), restored);
+    }
+
+    /**
+     * Test compile-time parsing of version literals
+     */
+    void testPackedParsing() {
+        static_assert(Version::parsePacked("1.2.3") == Version::pack(1, 2, 3),
+                      "Literal versions must parse at compile time");
+        static_assert(Version::parsePacked("1.2") == 0, "Too few components");
+        static_assert(Version::parsePacked("1.2.3.4") == 0, "Too many components");
+        static_assert(Version::parsePacked("1.2.3-rc1") == 0, "Pre-release tags don't pack");
+
+        const auto parsed = Version::parse("7.8.9");
+        CPPUNIT_ASSERT(parsed.isOk());
+        CPPUNIT_ASSERT_EQUAL(Version::parsePacked("7.8.9"), parsed.unwrap().packed());
+    }
+
+    /**
+     * Test compilation of range strings into packed bounds
+     */
+    void testRangeParsing() {
+        CPPUNIT_ASSERT(VersionRange::parse(">=1.4 <2.0").isOk());
+        CPPUNIT_ASSERT(VersionRange::parse(">1.2.3 <=1.5").isOk());
+        CPPUNIT_ASSERT(VersionRange::parse("= 1.2.3").isOk());
+        CPPUNIT_ASSERT(VersionRange::parse("1.2.3").isOk());
+
+        CPPUNIT_ASSERT(VersionRange::parse("").isError());
+        CPPUNIT_ASSERT(VersionRange::parse(">=").isError());
+        CPPUNIT_ASSERT(VersionRange::parse("banana").isError());
+        CPPUNIT_ASSERT(VersionRange::parse("1.2.3.4").isError());
+        CPPUNIT_ASSERT(VersionRange::parse(">=2.0 <1.0").isError());     // A contradiction
+        CPPUNIT_ASSERT(VersionRange::parse("99999999999").isError());    // Does not fit the packed fields
+    }
+
+    /**
+     * Test range membership against the compiled bounds
+     */
+    void testRangeMembership() {
+        const auto range = VersionRange::parse(">=1.4 <2.0").unwrap();
+
+        CPPUNIT_ASSERT(range.contains(Version(1, 4, 0)));
+        CPPUNIT_ASSERT(range.contains(Version(1, 9, 125)));
+        CPPUNIT_ASSERT(!range.contains(Version(1, 3, 99)));
+        CPPUNIT_ASSERT(!range.contains(Version(2, 0, 0)));
+
+        // Bounds behave per comparator:
+        const auto strict = VersionRange::parse(">1.2.3 <=1.5").unwrap();
+        CPPUNIT_ASSERT(!strict.contains(Version(1, 2, 3)));
+        CPPUNIT_ASSERT(strict.contains(Version(1, 2, 4)));
+        CPPUNIT_ASSERT(strict.contains(Version(1, 5, 0)));
+        CPPUNIT_ASSERT(!strict.contains(Version(1, 5, 1)));
+
+        // Pre-release versions never match a range:
+        CPPUNIT_ASSERT(!range.contains(Version(1, 5, 0, "rc.1")));
+
+        // The packed overload is the handshake fast path:
+        CPPUNIT_ASSERT(range.contains(Version::pack(1, 4, 0)));
+        CPPUNIT_ASSERT(!range.contains(Version::pack(2, 0, 0)));
+
+        // A default range is unbounded:
+        CPPUNIT_ASSERT(VersionRange().contains(Version(999, 0, 0)));
+    }
+
+    /**
+     * Test membership sweeps over a batch of peer versions
+     */
+    void testRangeBatchSweep() {
+        const auto range = VersionRange::parse(">=1.4 <2.0").unwrap();
+
+        Version peers[] = {
+            Version(1, 3, 0),
+            Version(1, 4, 0),
+            Version(1, 9, 9),
+            Version(2, 0, 0),
+            Version(1, 5, 0),
+        };
+
+        CPPUNIT_ASSERT_EQUAL(static_cast<VersionRange::size_type>(3), range.count(arrayView(peers)));
+
+        VersionRange::size_type matches[8] = {0};
+        CPPUNIT_ASSERT_EQUAL(static_cast<VersionRange::size_type>(3),
+                             range.selectInto(arrayView(peers), arrayView(matches)));
+        CPPUNIT_ASSERT_EQUAL(static_cast<VersionRange::size_type>(1), matches[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<VersionRange::size_type>(2), matches[1]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<VersionRange::size_type>(4), matches[2]);
+
+        // A truncated output buffer still reports the full member count:
+        VersionRange::size_type tiny[2] = {0};
+        CPPUNIT_ASSERT_EQUAL(static_cast<VersionRange::size_type>(3),
+                             range.selectInto(arrayView(peers), arrayView(tiny)));
+    }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestVersion);
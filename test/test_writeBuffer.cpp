@@ -37,6 +37,11 @@ class TestWriteBuffer :
 
         CPPUNIT_TEST(writeBigEndian);
         CPPUNIT_TEST(writeLittleEndian);
+        CPPUNIT_TEST(writeBatch);
+        CPPUNIT_TEST(writeVarint);
+
+        CPPUNIT_TEST(overflowHandlerChains);
+        CPPUNIT_TEST(overflowHandlerDeclines);
     CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -160,6 +165,150 @@ public:
         }
     }
 
+
+    void writeBatch() {
+        byte bytes[8];
+
+        {   // Array encode
+            uint16 const values[] = {0x842d, 0xa380, 0xe342, 0x6dff};
+
+            CPPUNIT_ASSERT(WriteBuffer(wrapMemory(bytes)).writeBE(values, 4).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x84), bytes[0]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x2d), bytes[1]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0xff), bytes[7]);
+
+            CPPUNIT_ASSERT(WriteBuffer(wrapMemory(bytes)).writeLE(values, 4).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x2d), bytes[0]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x84), bytes[1]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x6d), bytes[7]);
+
+            // Encoding more elements than the buffer can hold must fail
+            CPPUNIT_ASSERT(WriteBuffer(wrapMemory(bytes)).writeBE(values, 5).isError());
+        }
+
+        {   // Struct-of-fields encode
+            WriteBuffer buffer(wrapMemory(bytes));
+            CPPUNIT_ASSERT(buffer.writeBE(static_cast<uint16>(0x842d),
+                                          static_cast<uint32>(0xa380e342),
+                                          static_cast<uint8>(0x6d)).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(7), buffer.position());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x84), bytes[0]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x2d), bytes[1]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0xa3), bytes[2]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x42), bytes[5]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x6d), bytes[6]);
+
+            // Not enough space for the whole layout: no field is written
+            CPPUNIT_ASSERT(buffer.writeBE(static_cast<uint32>(1), static_cast<uint32>(2)).isError());
+            CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(7), buffer.position());
+        }
+    }
+
+
+    void writeVarint() {
+        byte bytes[10];
+
+        {   // Single byte values
+            WriteBuffer buffer(wrapMemory(bytes));
+            CPPUNIT_ASSERT(buffer.writeVarint(static_cast<uint64>(1)).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(1), buffer.position());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x01), bytes[0]);
+        }
+
+        {   // Multi-byte value: 300 is encoded as AC 02
+            WriteBuffer buffer(wrapMemory(bytes));
+            CPPUNIT_ASSERT(buffer.writeVarint(static_cast<uint64>(300)).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(2), buffer.position());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0xAC), bytes[0]);
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x02), bytes[1]);
+        }
+
+        {   // Zig-zag signed encoding keeps small negatives short
+            WriteBuffer buffer(wrapMemory(bytes));
+            CPPUNIT_ASSERT(buffer.writeVarint(static_cast<int64>(-1)).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x01), bytes[0]);
+
+            buffer.rewind();
+            CPPUNIT_ASSERT(buffer.writeVarint(static_cast<int64>(1)).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0x02), bytes[0]);
+        }
+
+        {   // The largest value takes 10 bytes and must fit whole or not at all
+            WriteBuffer buffer(wrapMemory(bytes));
+            CPPUNIT_ASSERT(buffer.writeVarint(~static_cast<uint64>(0)).isOk());
+            CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(10), buffer.position());
+
+            WriteBuffer small(wrapMemory(bytes, 4));
+            CPPUNIT_ASSERT(small.writeVarint(~static_cast<uint64>(0)).isError());
+            CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(0), small.position());
+        }
+    }
+
+    void overflowHandlerChains() {
+        byte first[8];
+        byte second[8];
+        byte third[16];
+
+        WriteBuffer buffer(wrapMemory(first));
+        int handlerCalls = 0;
+        buffer.onOverflow([&](WriteBuffer::size_type) -> Optional<MemoryBuffer> {
+            ++handlerCalls;
+            return (handlerCalls == 1)
+                    ? MemoryBuffer(wrapMemory(second))
+                    : MemoryBuffer(wrapMemory(third));
+        });
+
+        // Two writes fill the first buffer, the third spills into the second:
+        CPPUNIT_ASSERT(buffer.write(static_cast<uint32>(1)).isOk());
+        CPPUNIT_ASSERT(buffer.write(static_cast<uint32>(2)).isOk());
+        CPPUNIT_ASSERT(buffer.write(static_cast<uint32>(3)).isOk());
+        CPPUNIT_ASSERT_EQUAL(1, handlerCalls);
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(12), buffer.totalWritten());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(2), buffer.chunkCount());
+
+        // A write larger than the remaining space splits across buffers:
+        byte blob[12] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10, 11};
+        CPPUNIT_ASSERT(buffer.write(wrapMemory(blob)).isOk());
+        CPPUNIT_ASSERT_EQUAL(2, handlerCalls);
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(24), buffer.totalWritten());
+
+        WriteBuffer::size_type gathered = 0;
+        WriteBuffer::size_type chunks = 0;
+        buffer.forEachChunk([&](ImmutableMemoryView view) {
+            gathered += view.size();
+            chunks += 1;
+        });
+        CPPUNIT_ASSERT_EQUAL(buffer.totalWritten(), gathered);
+        CPPUNIT_ASSERT_EQUAL(buffer.chunkCount(), chunks);
+
+        // The spilled bytes landed contiguously across the boundary:
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(0), second[4]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(3), second[7]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(4), third[0]);
+        CPPUNIT_ASSERT_EQUAL(static_cast<byte>(11), third[7]);
+
+        // clear() releases the chain:
+        buffer.clear();
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(0), buffer.totalWritten());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(1), buffer.chunkCount());
+    }
+
+    void overflowHandlerDeclines() {
+        byte mem[4];
+
+        WriteBuffer buffer(wrapMemory(mem));
+        buffer.onOverflow([](WriteBuffer::size_type) -> Optional<MemoryBuffer> {
+            return none;
+        });
+
+        CPPUNIT_ASSERT(buffer.write(static_cast<uint64>(1)).isError());
+
+        // Without a handler nothing changes: overruns still fail cleanly.
+        WriteBuffer plain(wrapMemory(mem));
+        CPPUNIT_ASSERT(plain.write(static_cast<uint64>(1)).isError());
+        CPPUNIT_ASSERT_EQUAL(static_cast<WriteBuffer::size_type>(0), plain.position());
+    }
+
 };
 
 CPPUNIT_TEST_SUITE_REGISTRATION(TestWriteBuffer);
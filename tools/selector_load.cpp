@@ -0,0 +1,321 @@
+/*
+*  Copyright 2018 Ivan Ryabov
+*
+*  Licensed under the Apache License, Version 2.0 (the "License");
+*  you may not use this file except in compliance with the License.
+*  You may obtain a copy of the License at
+*
+*      http://www.apache.org/licenses/LICENSE-2.0
+*
+*  Unless required by applicable law or agreed to in writing, software
+*  distributed under the License is distributed on an "AS IS" BASIS,
+*  WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+*  See the License for the specific language governing permissions and
+*  limitations under the License.
+*/
+/*******************************************************************************
+ * libSolace tools: selector load benchmark
+ * @file: tools/selector_load.cpp
+ *
+ * Drives every Selector backend over a synthetic connection population - N
+ * socketpairs registered for reading, of which a configurable fraction is
+ * made active per round by a writer thread - and reports wakeup latency
+ * percentiles plus sustained events/s per backend. These are the numbers
+ * behind the createBest() backend ordering and capacity planning, kept
+ * in-tree so backend changes get measured against the same load shape.
+ *
+ * To reproduce the 50k-connections / 1%-active service profile:
+ *
+ *   ulimit -n 110000   # the tool opens two fds per connection
+ *   selector_load --connections 50000 --active 1 --batch 256
+*******************************************************************************/
+#include <solace/io/selector.hpp>
+#include <solace/exception.hpp>
+#include <solace/cli/parser.hpp>
+#include <solace/version.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/socket.h>
+
+
+using namespace Solace;
+using namespace Solace::IO;
+
+using BenchClock = std::chrono::steady_clock;
+
+
+namespace {
+
+struct Config {
+    uint32 connections {1000};      //!< Number of registered connections.
+    uint32 activePercent {1};       //!< Percent of connections written per round.
+    uint32 batchSize {64};          //!< Event batch capacity per pollInto() call.
+    uint32 rounds {500};            //!< Measured rounds per backend.
+};
+
+
+/** One synthetic connection: the read end is registered with the selector,
+ * the write end belongs to the load-generating thread. */
+struct Connection {
+    int readFd;
+    int writeFd;
+};
+
+
+/** What one backend did under the configured load. */
+struct Report {
+    bool    available {false};
+    int64   p50 {0};                //!< Wakeup latency percentiles, nanoseconds.
+    int64   p90 {0};
+    int64   p99 {0};
+    int64   worst {0};
+    float64 eventsPerSecond {0};
+};
+
+
+int64 nowNanos() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+            BenchClock::now().time_since_epoch()).count();
+}
+
+
+std::vector<Connection> openConnections(uint32 count) {
+    std::vector<Connection> connections;
+    connections.reserve(count);
+
+    for (uint32 i = 0; i < count; ++i) {
+        int fds[2];
+        if (socketpair(AF_UNIX, SOCK_STREAM, 0, fds) != 0) {
+            raise<IOException>(errno, "socketpair");
+        }
+
+        // Non-blocking read ends: ready fds are drained until EAGAIN, so a
+        // level-triggered backend never re-reports a connection as a new event.
+        fcntl(fds[0], F_SETFL, fcntl(fds[0], F_GETFL, 0) | O_NONBLOCK);
+
+        connections.push_back(Connection{fds[0], fds[1]});
+    }
+
+    return connections;
+}
+
+
+void closeConnections(std::vector<Connection> const& connections) {
+    for (auto const& connection : connections) {
+        close(connection.readFd);
+        close(connection.writeFd);
+    }
+}
+
+
+int64 percentileOf(std::vector<int64> const& sorted, uint32 percent) {
+    if (sorted.empty()) {
+        return 0;
+    }
+
+    const auto index = (sorted.size() * percent) / 100;
+    return sorted[(index < sorted.size()) ? index : sorted.size() - 1];
+}
+
+
+/**
+ * Run the configured load against one selector.
+ *
+ * A writer thread paces the rounds: it waits for the poller to enter a round,
+ * gives it a moment to park in the kernel, timestamps, and writes one byte to
+ * each of the round's active connections - rotating which connections are
+ * active so the backend cannot settle on a hot subset. The polling thread
+ * records the write-to-return time of the first wakeup of each round and
+ * drains the batch; events/s is measured over drain time only, so it reflects
+ * dispatch cost rather than the pacing gaps.
+ */
+Report runBackend(Selector&& selector, std::vector<Connection> const& connections, Config const& config) {
+    for (auto const& connection : connections) {
+        selector.add(connection.readFd, Selector::Read, nullptr);
+    }
+
+    const auto nbConnections = static_cast<uint32>(connections.size());
+    const uint32 activeCount = std::max<uint32>(1, (nbConnections * config.activePercent) / 100);
+
+    std::atomic<uint32> roundEntered {0};
+    std::atomic<int64> writeStamp {0};
+
+    std::thread writer([&connections, &config, &roundEntered, &writeStamp, nbConnections, activeCount]() {
+        const byte token = 1;
+
+        for (uint32 r = 0; r < config.rounds; ++r) {
+            while (roundEntered.load(std::memory_order_acquire) <= r) {
+                std::this_thread::yield();
+            }
+
+            // Let the poller park in the kernel so the measurement covers a
+            // real wakeup, not an already-pending batch:
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+            writeStamp.store(nowNanos(), std::memory_order_release);
+            for (uint32 i = 0; i < activeCount; ++i) {
+                const auto& connection = connections[(r + i * (nbConnections / activeCount)) % nbConnections];
+                if (write(connection.writeFd, &token, 1) != 1) {
+                    return;  // Peer gone; the poller will notice via Hup.
+                }
+            }
+        }
+    });
+
+    std::vector<Selector::Event> batch(config.batchSize);
+    auto batchView = ArrayView<Selector::Event>(batch.data(), config.batchSize);
+
+    std::vector<int64> wakeupLatencies;
+    wakeupLatencies.reserve(config.rounds);
+
+    uint64 eventsTotal = 0;
+    int64 drainNanos = 0;
+    byte drainBuffer[64];
+
+    for (uint32 r = 0; r < config.rounds; ++r) {
+        roundEntered.store(r + 1, std::memory_order_release);
+
+        uint32 remaining = activeCount;
+        int64 roundWake = 0;
+
+        while (remaining > 0) {
+            const auto nbReady = selector.pollInto(batchView, -1);
+            const auto returned = nowNanos();
+
+            if (roundWake == 0) {
+                roundWake = returned;
+                wakeupLatencies.push_back(returned - writeStamp.load(std::memory_order_acquire));
+            }
+
+            for (Selector::size_type i = 0; i < nbReady; ++i) {
+                while (read(batch[i].fd, drainBuffer, sizeof(drainBuffer)) > 0) {
+                }
+            }
+
+            eventsTotal += nbReady;
+            remaining -= (nbReady < remaining) ? nbReady : remaining;
+        }
+
+        drainNanos += nowNanos() - roundWake;
+    }
+
+    writer.join();
+
+    std::sort(wakeupLatencies.begin(), wakeupLatencies.end());
+
+    Report report;
+    report.available = true;
+    report.p50 = percentileOf(wakeupLatencies, 50);
+    report.p90 = percentileOf(wakeupLatencies, 90);
+    report.p99 = percentileOf(wakeupLatencies, 99);
+    report.worst = wakeupLatencies.empty() ? 0 : wakeupLatencies.back();
+    report.eventsPerSecond = (drainNanos > 0)
+            ? static_cast<float64>(eventsTotal) * 1e9 / static_cast<float64>(drainNanos)
+            : 0;
+
+    return report;
+}
+
+
+void printReport(const char* backend, Report const& report) {
+    std::cout << std::left << std::setw(8) << backend << std::right;
+
+    if (!report.available) {
+        std::cout << "  unavailable on this kernel" << std::endl;
+        return;
+    }
+
+    std::cout << std::fixed << std::setprecision(1)
+              << std::setw(10) << static_cast<float64>(report.p50) / 1000.0
+              << std::setw(10) << static_cast<float64>(report.p90) / 1000.0
+              << std::setw(10) << static_cast<float64>(report.p99) / 1000.0
+              << std::setw(10) << static_cast<float64>(report.worst) / 1000.0
+              << std::setw(14) << std::setprecision(0) << report.eventsPerSecond
+              << std::endl;
+}
+
+}  // namespace
+
+
+int main(int argc, const char **argv) {
+    Config config;
+    StringView backendFilter("all");
+
+    const auto parseResult = cli::Parser("Selector backend load benchmark", {
+                          cli::Parser::printHelp(),
+                          cli::Parser::printVersion("selector_load", getBuildVersion()),
+                          {{"c", "connections"},    "Number of connections to register",        &config.connections},
+                          {{"a", "active"},         "Percent of connections active per round",  &config.activePercent},
+                          {{"b", "batch"},          "Event batch size per poll",                &config.batchSize},
+                          {{"r", "rounds"},         "Number of measured rounds",                &config.rounds},
+                          {{"backend"},             "Backend to drive: poll|epoll|uring|best|all", &backendFilter}
+                        })
+            .parse(argc, argv);
+
+    if (!parseResult) {
+        std::cerr << parseResult.getError().toString() << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    if (config.connections == 0 || config.rounds == 0 || config.batchSize == 0) {
+        std::cerr << "connections, rounds and batch must all be positive" << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    if (config.activePercent > 100) {
+        std::cerr << "active is a percentage of connections: 0..100" << std::endl;
+
+        return EXIT_FAILURE;
+    }
+
+    const auto connections = openConnections(config.connections);
+
+    std::cout << config.connections << " connections, "
+              << config.activePercent << "% active per round, batches of "
+              << config.batchSize << ", " << config.rounds << " rounds" << std::endl
+              << std::endl
+              << std::left << std::setw(8) << "backend" << std::right
+              << std::setw(10) << "p50us" << std::setw(10) << "p90us"
+              << std::setw(10) << "p99us" << std::setw(10) << "maxus"
+              << std::setw(14) << "events/s" << std::endl;
+
+    const struct {
+        const char* name;
+        Selector (*create)(Selector::size_type);
+    } backends[] = {
+        {"poll",    Selector::createPoll},
+        {"epoll",   Selector::createEPoll},
+        {"uring",   Selector::createIOUring},
+        {"best",    Selector::createBest},
+    };
+
+    for (auto const& backend : backends) {
+        if (!backendFilter.equals("all") && !backendFilter.equals(backend.name)) {
+            continue;
+        }
+
+        Report report;
+        try {
+            report = runBackend(backend.create(config.batchSize), connections, config);
+        } catch (Exception const&) {
+            // Backend not supported by this kernel - worth a line, not an abort.
+        }
+
+        printReport(backend.name, report);
+    }
+
+    closeConnections(connections);
+
+    return EXIT_SUCCESS;
+}